@@ -72,15 +72,41 @@ static void set_ooo_mgr_road_block(IMB_MGR *mgr)
         MB_MGR_CMAC_OOO *aes_cmac_ooo = mgr->aes_cmac_ooo;
         MB_MGR_ZUC_OOO *zuc_eea3_ooo = mgr->zuc_eea3_ooo;
         MB_MGR_ZUC_OOO *zuc_eia3_ooo = mgr->zuc_eia3_ooo;
+        MB_MGR_ZUC_EEA3_EIA3_OOO *zuc_eea3_eia3_ooo = mgr->zuc_eea3_eia3_ooo;
+        MB_MGR_AES_OOO *aes128_cfb_ooo = mgr->aes128_cfb_ooo;
+        MB_MGR_AES_OOO *aes256_cfb_ooo = mgr->aes256_cfb_ooo;
+        MB_MGR_CCM_CTR_MAC_OOO *aes128_ccm_ctr_mac_ooo =
+                mgr->aes128_ccm_ctr_mac_ooo;
+        MB_MGR_CCM_CTR_MAC_OOO *aes256_ccm_ctr_mac_ooo =
+                mgr->aes256_ccm_ctr_mac_ooo;
+        MB_MGR_DOCSIS_CRC32_OOO *docsis128_crc32_x4_ooo =
+                mgr->docsis128_crc32_x4_ooo;
+        MB_MGR_DOCSIS_CRC32_OOO *docsis256_crc32_x4_ooo =
+                mgr->docsis256_crc32_x4_ooo;
+        MB_MGR_SGL_OOO *aes128_cbc_sgl_ooo = mgr->aes128_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes192_cbc_sgl_ooo = mgr->aes192_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes256_cbc_sgl_ooo = mgr->aes256_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes128_ccm_sgl_ooo = mgr->aes128_ccm_sgl_ooo;
+        MB_MGR_SGL_OOO *aes256_ccm_sgl_ooo = mgr->aes256_ccm_sgl_ooo;
 
         aes128_ooo->road_block = IMB_OOO_ROAD_BLOCK;
         aes192_ooo->road_block = IMB_OOO_ROAD_BLOCK;
         aes256_ooo->road_block = IMB_OOO_ROAD_BLOCK;
+        aes128_cfb_ooo->road_block = IMB_OOO_ROAD_BLOCK;
+        aes256_cfb_ooo->road_block = IMB_OOO_ROAD_BLOCK;
 
         docsis128_sec_ooo->road_block = IMB_OOO_ROAD_BLOCK;
         docsis128_crc32_sec_ooo->road_block = IMB_OOO_ROAD_BLOCK;
         docsis256_sec_ooo->road_block = IMB_OOO_ROAD_BLOCK;
         docsis256_crc32_sec_ooo->road_block = IMB_OOO_ROAD_BLOCK;
+        docsis128_crc32_x4_ooo->road_block = IMB_OOO_ROAD_BLOCK;
+        docsis256_crc32_x4_ooo->road_block = IMB_OOO_ROAD_BLOCK;
+
+        aes128_cbc_sgl_ooo->road_block = IMB_OOO_ROAD_BLOCK;
+        aes192_cbc_sgl_ooo->road_block = IMB_OOO_ROAD_BLOCK;
+        aes256_cbc_sgl_ooo->road_block = IMB_OOO_ROAD_BLOCK;
+        aes128_ccm_sgl_ooo->road_block = IMB_OOO_ROAD_BLOCK;
+        aes256_ccm_sgl_ooo->road_block = IMB_OOO_ROAD_BLOCK;
 
         des_enc_ooo->road_block = IMB_OOO_ROAD_BLOCK;
         des_dec_ooo->road_block = IMB_OOO_ROAD_BLOCK;
@@ -98,10 +124,13 @@ static void set_ooo_mgr_road_block(IMB_MGR *mgr)
 
         aes_xcbc_ooo->road_block = IMB_OOO_ROAD_BLOCK;
         aes_ccm_ooo->road_block = IMB_OOO_ROAD_BLOCK;
+        aes128_ccm_ctr_mac_ooo->road_block = IMB_OOO_ROAD_BLOCK;
+        aes256_ccm_ctr_mac_ooo->road_block = IMB_OOO_ROAD_BLOCK;
         aes_cmac_ooo->road_block = IMB_OOO_ROAD_BLOCK;
 
         zuc_eea3_ooo->road_block = IMB_OOO_ROAD_BLOCK;
         zuc_eia3_ooo->road_block = IMB_OOO_ROAD_BLOCK;
+        zuc_eea3_eia3_ooo->road_block = IMB_OOO_ROAD_BLOCK;
 }
 
 static void *
@@ -243,6 +272,47 @@ IMB_MGR *alloc_mb_mgr(uint64_t flags)
         ptr->zuc_eia3_ooo = alloc_aligned_mem(sizeof(MB_MGR_ZUC_OOO));
         if (ptr->zuc_eia3_ooo == NULL)
                 goto exit_fail;
+        ptr->zuc_eea3_eia3_ooo =
+                alloc_aligned_mem(sizeof(MB_MGR_ZUC_EEA3_EIA3_OOO));
+        if (ptr->zuc_eea3_eia3_ooo == NULL)
+                goto exit_fail;
+        ptr->aes128_cfb_ooo = alloc_aligned_mem(sizeof(MB_MGR_AES_OOO));
+        if (ptr->aes128_cfb_ooo == NULL)
+                goto exit_fail;
+        ptr->aes256_cfb_ooo = alloc_aligned_mem(sizeof(MB_MGR_AES_OOO));
+        if (ptr->aes256_cfb_ooo == NULL)
+                goto exit_fail;
+        ptr->aes128_ccm_ctr_mac_ooo =
+                alloc_aligned_mem(sizeof(MB_MGR_CCM_CTR_MAC_OOO));
+        if (ptr->aes128_ccm_ctr_mac_ooo == NULL)
+                goto exit_fail;
+        ptr->aes256_ccm_ctr_mac_ooo =
+                alloc_aligned_mem(sizeof(MB_MGR_CCM_CTR_MAC_OOO));
+        if (ptr->aes256_ccm_ctr_mac_ooo == NULL)
+                goto exit_fail;
+        ptr->docsis128_crc32_x4_ooo =
+                alloc_aligned_mem(sizeof(MB_MGR_DOCSIS_CRC32_OOO));
+        if (ptr->docsis128_crc32_x4_ooo == NULL)
+                goto exit_fail;
+        ptr->docsis256_crc32_x4_ooo =
+                alloc_aligned_mem(sizeof(MB_MGR_DOCSIS_CRC32_OOO));
+        if (ptr->docsis256_crc32_x4_ooo == NULL)
+                goto exit_fail;
+        ptr->aes128_cbc_sgl_ooo = alloc_aligned_mem(sizeof(MB_MGR_SGL_OOO));
+        if (ptr->aes128_cbc_sgl_ooo == NULL)
+                goto exit_fail;
+        ptr->aes192_cbc_sgl_ooo = alloc_aligned_mem(sizeof(MB_MGR_SGL_OOO));
+        if (ptr->aes192_cbc_sgl_ooo == NULL)
+                goto exit_fail;
+        ptr->aes256_cbc_sgl_ooo = alloc_aligned_mem(sizeof(MB_MGR_SGL_OOO));
+        if (ptr->aes256_cbc_sgl_ooo == NULL)
+                goto exit_fail;
+        ptr->aes128_ccm_sgl_ooo = alloc_aligned_mem(sizeof(MB_MGR_SGL_OOO));
+        if (ptr->aes128_ccm_sgl_ooo == NULL)
+                goto exit_fail;
+        ptr->aes256_ccm_sgl_ooo = alloc_aligned_mem(sizeof(MB_MGR_SGL_OOO));
+        if (ptr->aes256_ccm_sgl_ooo == NULL)
+                goto exit_fail;
 
         set_ooo_mgr_road_block(ptr);
 
@@ -274,6 +344,18 @@ exit_fail:
         free_mem(ptr->aes_ccm_ooo);
         free_mem(ptr->aes_cmac_ooo);
         free_mem(ptr->zuc_eia3_ooo);
+        free_mem(ptr->zuc_eea3_eia3_ooo);
+        free_mem(ptr->aes128_cfb_ooo);
+        free_mem(ptr->aes256_cfb_ooo);
+        free_mem(ptr->aes128_ccm_ctr_mac_ooo);
+        free_mem(ptr->aes256_ccm_ctr_mac_ooo);
+        free_mem(ptr->docsis128_crc32_x4_ooo);
+        free_mem(ptr->docsis256_crc32_x4_ooo);
+        free_mem(ptr->aes128_cbc_sgl_ooo);
+        free_mem(ptr->aes192_cbc_sgl_ooo);
+        free_mem(ptr->aes256_cbc_sgl_ooo);
+        free_mem(ptr->aes128_ccm_sgl_ooo);
+        free_mem(ptr->aes256_ccm_sgl_ooo);
         free(ptr);
 
         return NULL;
@@ -316,8 +398,41 @@ void free_mb_mgr(IMB_MGR *ptr)
                 free_mem(ptr->aes_ccm_ooo);
                 free_mem(ptr->aes_cmac_ooo);
                 free_mem(ptr->zuc_eia3_ooo);
+                free_mem(ptr->zuc_eea3_eia3_ooo);
+                free_mem(ptr->aes128_cfb_ooo);
+                free_mem(ptr->aes256_cfb_ooo);
+                free_mem(ptr->aes128_ccm_ctr_mac_ooo);
+                free_mem(ptr->aes256_ccm_ctr_mac_ooo);
+                free_mem(ptr->docsis128_crc32_x4_ooo);
+                free_mem(ptr->docsis256_crc32_x4_ooo);
+                free_mem(ptr->aes128_cbc_sgl_ooo);
+                free_mem(ptr->aes192_cbc_sgl_ooo);
+                free_mem(ptr->aes256_cbc_sgl_ooo);
+                free_mem(ptr->aes128_ccm_sgl_ooo);
+                free_mem(ptr->aes256_ccm_sgl_ooo);
         }
 
         /* Free IMB_MGR */
         free_mem(ptr);
 }
+
+/**
+ * @brief Sets job completion callback of multi-buffer manager
+ *
+ * Once set, submit_job and flush_job pass completed jobs to the callback
+ * in batches, instead of returning them.
+ *
+ * @param state pointer to initialized multi-buffer manager
+ * @param cb completion callback, NULL to return jobs as before
+ * @param cb_arg argument passed to the callback
+ */
+void imb_set_completion_cb(IMB_MGR *state, imb_completion_cb_t cb,
+                           void *cb_arg)
+{
+#ifdef SAFE_PARAM
+        if (state == NULL)
+                return;
+#endif
+        state->completion_cb = cb;
+        state->completion_cb_arg = cb_arg;
+}
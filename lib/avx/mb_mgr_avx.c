@@ -37,6 +37,7 @@
 #include "include/zuc_internal.h"
 #include "include/snow3g.h"
 #include "include/gcm.h"
+#include "include/crc.h"
 
 #include "save_xmms.h"
 #include "asm.h"
@@ -56,6 +57,19 @@ IMB_JOB *submit_job_aes256_enc_avx(MB_MGR_AES_OOO *state,
                                         IMB_JOB *job);
 IMB_JOB *flush_job_aes256_enc_avx(MB_MGR_AES_OOO *state);
 
+IMB_JOB *submit_job_aes128_cfb_enc_avx(MB_MGR_AES_OOO *state,
+                                      IMB_JOB *job);
+IMB_JOB *flush_job_aes128_cfb_enc_avx(MB_MGR_AES_OOO *state);
+
+IMB_JOB *submit_job_aes256_cfb_enc_avx(MB_MGR_AES_OOO *state,
+                                      IMB_JOB *job);
+IMB_JOB *flush_job_aes256_cfb_enc_avx(MB_MGR_AES_OOO *state);
+
+void aes_cfb_dec_128_by8_avx(const void *in, const uint8_t *IV,
+                             const void *keys, void *out, uint64_t len_bytes);
+void aes_cfb_dec_256_by8_avx(const void *in, const uint8_t *IV,
+                             const void *keys, void *out, uint64_t len_bytes);
+
 IMB_JOB *submit_job_aes_xcbc_avx(MB_MGR_AES_XCBC_OOO *state,
                                       IMB_JOB *job);
 IMB_JOB *flush_job_aes_xcbc_avx(MB_MGR_AES_XCBC_OOO *state);
@@ -72,6 +86,34 @@ IMB_JOB *submit_job_zuc_eia3_avx(MB_MGR_ZUC_OOO *state,
                                         IMB_JOB *job);
 IMB_JOB *flush_job_zuc_eia3_avx(MB_MGR_ZUC_OOO *state);
 
+IMB_JOB *submit_job_zuc_eea3_eia3_avx(MB_MGR_ZUC_EEA3_EIA3_OOO *state,
+                                      IMB_JOB *job);
+IMB_JOB *flush_job_zuc_eea3_eia3_avx(MB_MGR_ZUC_EEA3_EIA3_OOO *state);
+
+IMB_JOB *submit_job_des_cbc_enc_avx(MB_MGR_DES_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_des_cbc_enc_avx(MB_MGR_DES_OOO *state);
+
+IMB_JOB *submit_job_des_cbc_dec_avx(MB_MGR_DES_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_des_cbc_dec_avx(MB_MGR_DES_OOO *state);
+
+IMB_JOB *submit_job_3des_cbc_enc_avx(MB_MGR_DES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_3des_cbc_enc_avx(MB_MGR_DES_OOO *state);
+
+IMB_JOB *submit_job_3des_cbc_dec_avx(MB_MGR_DES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_3des_cbc_dec_avx(MB_MGR_DES_OOO *state);
+
+IMB_JOB *submit_job_docsis_des_enc_avx(MB_MGR_DES_OOO *state,
+                                       IMB_JOB *job);
+IMB_JOB *flush_job_docsis_des_enc_avx(MB_MGR_DES_OOO *state);
+
+IMB_JOB *submit_job_docsis_des_dec_avx(MB_MGR_DES_OOO *state,
+                                       IMB_JOB *job);
+IMB_JOB *flush_job_docsis_des_dec_avx(MB_MGR_DES_OOO *state);
+
 uint32_t hec_32_avx(const uint8_t *in);
 uint64_t hec_64_avx(const uint8_t *in);
 
@@ -87,6 +129,10 @@ uint64_t hec_64_avx(const uint8_t *in);
 #define SUBMIT_JOB_AES256_ENC submit_job_aes256_enc_avx
 #define SUBMIT_JOB_AES256_DEC submit_job_aes256_dec_avx
 #define FLUSH_JOB_AES256_ENC  flush_job_aes256_enc_avx
+#define SUBMIT_JOB_AES128_CFB_ENC submit_job_aes128_cfb_enc_avx
+#define FLUSH_JOB_AES128_CFB_ENC  flush_job_aes128_cfb_enc_avx
+#define SUBMIT_JOB_AES256_CFB_ENC submit_job_aes256_cfb_enc_avx
+#define FLUSH_JOB_AES256_CFB_ENC  flush_job_aes256_cfb_enc_avx
 #define SUBMIT_JOB_AES_ECB_128_ENC submit_job_aes_ecb_128_enc_avx
 #define SUBMIT_JOB_AES_ECB_128_DEC submit_job_aes_ecb_128_dec_avx
 #define SUBMIT_JOB_AES_ECB_192_ENC submit_job_aes_ecb_192_enc_avx
@@ -101,10 +147,16 @@ uint64_t hec_64_avx(const uint8_t *in);
 #define FLUSH_JOB_ZUC_EEA3    flush_job_zuc_eea3_avx
 #define SUBMIT_JOB_ZUC_EIA3   submit_job_zuc_eia3_avx
 #define FLUSH_JOB_ZUC_EIA3    flush_job_zuc_eia3_avx
+#define SUBMIT_JOB_ZUC_EEA3_EIA3 submit_job_zuc_eea3_eia3_avx
+#define FLUSH_JOB_ZUC_EEA3_EIA3  flush_job_zuc_eea3_eia3_avx
+
+#define SNOW3G_F8_F9_1_BUFFER snow3g_f8_f9_1_buffer_avx
 
 #define AES_CBC_DEC_128       aes_cbc_dec_128_avx
 #define AES_CBC_DEC_192       aes_cbc_dec_192_avx
 #define AES_CBC_DEC_256       aes_cbc_dec_256_avx
+#define AES_CFB_DEC_128       aes_cfb_dec_128_by8_avx
+#define AES_CFB_DEC_256       aes_cfb_dec_256_by8_avx
 
 #define AES_CNTR_128       aes_cntr_128_avx
 #define AES_CNTR_192       aes_cntr_192_avx
@@ -120,6 +172,15 @@ uint64_t hec_64_avx(const uint8_t *in);
 #define AES_ECB_DEC_192       aes_ecb_dec_192_avx
 #define AES_ECB_DEC_256       aes_ecb_dec_256_avx
 
+#define SHA1_BLOCK_UPDATE     sha1_block_avx
+#define SHA256_BLOCK_UPDATE   sha256_block_avx
+#define SHA512_BLOCK_UPDATE   sha512_block_avx
+
+#define AES_XTS_128_ENC       aes_xts_128_enc_avx
+#define AES_XTS_128_DEC       aes_xts_128_dec_avx
+#define AES_XTS_256_ENC       aes_xts_256_enc_avx
+#define AES_XTS_256_DEC       aes_xts_256_dec_avx
+
 #define SUBMIT_JOB_PON_ENC        submit_job_pon_enc_avx
 #define SUBMIT_JOB_PON_DEC        submit_job_pon_dec_avx
 #define SUBMIT_JOB_PON_ENC_NO_CTR submit_job_pon_enc_no_ctr_avx
@@ -147,10 +208,29 @@ uint64_t hec_64_avx(const uint8_t *in);
 #define SUBMIT_JOB_AES_XCBC   submit_job_aes_xcbc_avx
 #define FLUSH_JOB_AES_XCBC    flush_job_aes_xcbc_avx
 
+#define SUBMIT_JOB_DES_CBC_ENC submit_job_des_cbc_enc_avx
+#define FLUSH_JOB_DES_CBC_ENC  flush_job_des_cbc_enc_avx
+
+#define SUBMIT_JOB_DES_CBC_DEC submit_job_des_cbc_dec_avx
+#define FLUSH_JOB_DES_CBC_DEC  flush_job_des_cbc_dec_avx
+
+#define SUBMIT_JOB_3DES_CBC_ENC submit_job_3des_cbc_enc_avx
+#define FLUSH_JOB_3DES_CBC_ENC  flush_job_3des_cbc_enc_avx
+
+#define SUBMIT_JOB_3DES_CBC_DEC submit_job_3des_cbc_dec_avx
+#define FLUSH_JOB_3DES_CBC_DEC  flush_job_3des_cbc_dec_avx
+
+#define SUBMIT_JOB_DOCSIS_DES_ENC submit_job_docsis_des_enc_avx
+#define FLUSH_JOB_DOCSIS_DES_ENC  flush_job_docsis_des_enc_avx
+
+#define SUBMIT_JOB_DOCSIS_DES_DEC submit_job_docsis_des_dec_avx
+#define FLUSH_JOB_DOCSIS_DES_DEC  flush_job_docsis_des_dec_avx
+
 #define SUBMIT_JOB_AES128_DEC submit_job_aes128_dec_avx
 #define SUBMIT_JOB_AES192_DEC submit_job_aes192_dec_avx
 #define SUBMIT_JOB_AES256_DEC submit_job_aes256_dec_avx
 #define QUEUE_SIZE queue_size_avx
+#define CLEAR_SCRATCH clear_scratch_avx
 
 #define SUBMIT_JOB_AES_ENC SUBMIT_JOB_AES_ENC_AVX
 #define FLUSH_JOB_AES_ENC  FLUSH_JOB_AES_ENC_AVX
@@ -203,6 +283,30 @@ IMB_JOB *submit_job_aes256_ccm_auth_avx(MB_MGR_CCM_OOO *state,
 
 IMB_JOB *flush_job_aes256_ccm_auth_avx(MB_MGR_CCM_OOO *state);
 
+IMB_JOB *submit_job_aes128_ccm_ctr_mac_avx(MB_MGR_CCM_CTR_MAC_OOO *state,
+                                           IMB_JOB *job);
+
+IMB_JOB *flush_job_aes128_ccm_ctr_mac_avx(MB_MGR_CCM_CTR_MAC_OOO *state);
+
+IMB_JOB *submit_job_aes256_ccm_ctr_mac_avx(MB_MGR_CCM_CTR_MAC_OOO *state,
+                                           IMB_JOB *job);
+
+IMB_JOB *flush_job_aes256_ccm_ctr_mac_avx(MB_MGR_CCM_CTR_MAC_OOO *state);
+
+IMB_JOB *submit_job_docsis128_crc32_x4_avx(MB_MGR_DOCSIS_CRC32_OOO *state,
+                                           IMB_JOB *job);
+
+IMB_JOB *flush_job_docsis128_crc32_x4_avx(MB_MGR_DOCSIS_CRC32_OOO *state);
+
+IMB_JOB *submit_job_docsis256_crc32_x4_avx(MB_MGR_DOCSIS_CRC32_OOO *state,
+                                           IMB_JOB *job);
+
+IMB_JOB *flush_job_docsis256_crc32_x4_avx(MB_MGR_DOCSIS_CRC32_OOO *state);
+
+IMB_JOB *docsis128_crc32_dec_avx(IMB_JOB *job);
+
+IMB_JOB *docsis256_crc32_dec_avx(IMB_JOB *job);
+
 void aes_cmac_256_subkey_gen_avx(const void *key_exp,
                                  void *key1, void *key2);
 
@@ -239,8 +343,14 @@ void aes_cmac_256_subkey_gen_avx(const void *key_exp,
 #define AES_CFB_256_ONE    aes_cfb_256_one_avx
 
 void aes128_cbc_mac_x8(AES_ARGS *args, uint64_t len);
+void aes256_cbc_mac_x8(AES_ARGS *args, uint64_t len);
 
 #define AES128_CBC_MAC     aes128_cbc_mac_x8
+#define AES256_CBC_MAC     aes256_cbc_mac_x8
+
+#define AES_CBC_ENC_128_X  aes_cbc_enc_128_x8
+#define AES_CBC_ENC_192_X  aes_cbc_enc_192_x8
+#define AES_CBC_ENC_256_X  aes_cbc_enc_256_x8
 
 #define FLUSH_JOB_AES128_CCM_AUTH     flush_job_aes128_ccm_auth_avx
 #define SUBMIT_JOB_AES128_CCM_AUTH    submit_job_aes128_ccm_auth_avx
@@ -248,6 +358,19 @@ void aes128_cbc_mac_x8(AES_ARGS *args, uint64_t len);
 #define FLUSH_JOB_AES256_CCM_AUTH     flush_job_aes256_ccm_auth_avx
 #define SUBMIT_JOB_AES256_CCM_AUTH    submit_job_aes256_ccm_auth_avx
 
+#define FLUSH_JOB_AES128_CCM_CTR_MAC  flush_job_aes128_ccm_ctr_mac_avx
+#define SUBMIT_JOB_AES128_CCM_CTR_MAC submit_job_aes128_ccm_ctr_mac_avx
+
+#define FLUSH_JOB_AES256_CCM_CTR_MAC  flush_job_aes256_ccm_ctr_mac_avx
+#define SUBMIT_JOB_AES256_CCM_CTR_MAC submit_job_aes256_ccm_ctr_mac_avx
+
+#define SUBMIT_JOB_DOCSIS128_CRC32_X4 submit_job_docsis128_crc32_x4_avx
+#define FLUSH_JOB_DOCSIS128_CRC32_X4  flush_job_docsis128_crc32_x4_avx
+#define SUBMIT_JOB_DOCSIS256_CRC32_X4 submit_job_docsis256_crc32_x4_avx
+#define FLUSH_JOB_DOCSIS256_CRC32_X4  flush_job_docsis256_crc32_x4_avx
+#define DOCSIS128_CRC32_DEC           docsis128_crc32_dec_avx
+#define DOCSIS256_CRC32_DEC           docsis256_crc32_dec_avx
+
 #define FLUSH_JOB_AES128_CMAC_AUTH    flush_job_aes128_cmac_auth_avx
 #define SUBMIT_JOB_AES128_CMAC_AUTH   submit_job_aes128_cmac_auth_avx
 
@@ -443,6 +566,8 @@ init_mb_mgr_avx(IMB_MGR *state)
         MB_MGR_AES_OOO *aes128_ooo = state->aes128_ooo;
         MB_MGR_AES_OOO *aes192_ooo = state->aes192_ooo;
         MB_MGR_AES_OOO *aes256_ooo = state->aes256_ooo;
+        MB_MGR_AES_OOO *aes128_cfb_ooo = state->aes128_cfb_ooo;
+        MB_MGR_AES_OOO *aes256_cfb_ooo = state->aes256_cfb_ooo;
         MB_MGR_DOCSIS_AES_OOO *docsis128_sec_ooo = state->docsis128_sec_ooo;
         MB_MGR_DOCSIS_AES_OOO *docsis128_crc32_sec_ooo =
                                                 state->docsis128_crc32_sec_ooo;
@@ -457,9 +582,30 @@ init_mb_mgr_avx(IMB_MGR *state)
         MB_MGR_HMAC_MD5_OOO *hmac_md5_ooo = state->hmac_md5_ooo;
         MB_MGR_AES_XCBC_OOO *aes_xcbc_ooo = state->aes_xcbc_ooo;
         MB_MGR_CCM_OOO *aes_ccm_ooo = state->aes_ccm_ooo;
+        MB_MGR_CCM_CTR_MAC_OOO *aes128_ccm_ctr_mac_ooo =
+                state->aes128_ccm_ctr_mac_ooo;
+        MB_MGR_CCM_CTR_MAC_OOO *aes256_ccm_ctr_mac_ooo =
+                state->aes256_ccm_ctr_mac_ooo;
+        MB_MGR_DOCSIS_CRC32_OOO *docsis128_crc32_x4_ooo =
+                state->docsis128_crc32_x4_ooo;
+        MB_MGR_DOCSIS_CRC32_OOO *docsis256_crc32_x4_ooo =
+                state->docsis256_crc32_x4_ooo;
         MB_MGR_CMAC_OOO *aes_cmac_ooo = state->aes_cmac_ooo;
+        MB_MGR_DES_OOO *des_enc_ooo = state->des_enc_ooo;
+        MB_MGR_DES_OOO *des_dec_ooo = state->des_dec_ooo;
+        MB_MGR_DES_OOO *des3_enc_ooo = state->des3_enc_ooo;
+        MB_MGR_DES_OOO *des3_dec_ooo = state->des3_dec_ooo;
+        MB_MGR_DES_OOO *docsis_des_enc_ooo = state->docsis_des_enc_ooo;
+        MB_MGR_DES_OOO *docsis_des_dec_ooo = state->docsis_des_dec_ooo;
         MB_MGR_ZUC_OOO *zuc_eea3_ooo = state->zuc_eea3_ooo;
         MB_MGR_ZUC_OOO *zuc_eia3_ooo = state->zuc_eia3_ooo;
+        MB_MGR_ZUC_EEA3_EIA3_OOO *zuc_eea3_eia3_ooo =
+                state->zuc_eea3_eia3_ooo;
+        MB_MGR_SGL_OOO *aes128_cbc_sgl_ooo = state->aes128_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes192_cbc_sgl_ooo = state->aes192_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes256_cbc_sgl_ooo = state->aes256_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes128_ccm_sgl_ooo = state->aes128_ccm_sgl_ooo;
+        MB_MGR_SGL_OOO *aes256_ccm_sgl_ooo = state->aes256_ccm_sgl_ooo;
 
 
         state->features = cpu_feature_adjust(state->flags,
@@ -498,6 +644,17 @@ init_mb_mgr_avx(IMB_MGR *state)
         aes256_ooo->unused_lanes = 0xF76543210;
         aes256_ooo->num_lanes_inuse = 0;
 
+        /* AES-CFB encryption uses 8 lanes */
+        memset(aes128_cfb_ooo->job_in_lane, 0,
+               sizeof(aes128_cfb_ooo->job_in_lane));
+        aes128_cfb_ooo->unused_lanes = 0xF76543210;
+        aes128_cfb_ooo->num_lanes_inuse = 0;
+
+        memset(aes256_cfb_ooo->job_in_lane, 0,
+               sizeof(aes256_cfb_ooo->job_in_lane));
+        aes256_cfb_ooo->unused_lanes = 0xF76543210;
+        aes256_cfb_ooo->num_lanes_inuse = 0;
+
         /* DOCSIS SEC BPI (AES CBC + AES CFB for partial block)
          * uses same settings as AES CBC.
          */
@@ -537,6 +694,61 @@ init_mb_mgr_avx(IMB_MGR *state)
         docsis256_crc32_sec_ooo->unused_lanes = 0xF76543210;
         docsis256_crc32_sec_ooo->num_lanes_inuse = 0;
 
+        /* DES, 3DES and DOCSIS DES (DES CBC + DES CFB for partial block) */
+        /* - separate DES OOO for encryption */
+        for (j = 0; j < AVX_NUM_DES_LANES; j++) {
+                des_enc_ooo->lens[j] = 0;
+                des_enc_ooo->job_in_lane[j] = NULL;
+        }
+        des_enc_ooo->unused_lanes = 0xF3210;
+        des_enc_ooo->num_lanes_inuse = 0;
+        memset(&des_enc_ooo->args, 0, sizeof(des_enc_ooo->args));
+
+        /* - separate DES OOO for decryption */
+        for (j = 0; j < AVX_NUM_DES_LANES; j++) {
+                des_dec_ooo->lens[j] = 0;
+                des_dec_ooo->job_in_lane[j] = NULL;
+        }
+        des_dec_ooo->unused_lanes = 0xF3210;
+        des_dec_ooo->num_lanes_inuse = 0;
+        memset(&des_dec_ooo->args, 0, sizeof(des_dec_ooo->args));
+
+        /* - separate 3DES OOO for encryption */
+        for (j = 0; j < AVX_NUM_DES_LANES; j++) {
+                des3_enc_ooo->lens[j] = 0;
+                des3_enc_ooo->job_in_lane[j] = NULL;
+        }
+        des3_enc_ooo->unused_lanes = 0xF3210;
+        des3_enc_ooo->num_lanes_inuse = 0;
+        memset(&des3_enc_ooo->args, 0, sizeof(des3_enc_ooo->args));
+
+        /* - separate 3DES OOO for decryption */
+        for (j = 0; j < AVX_NUM_DES_LANES; j++) {
+                des3_dec_ooo->lens[j] = 0;
+                des3_dec_ooo->job_in_lane[j] = NULL;
+        }
+        des3_dec_ooo->unused_lanes = 0xF3210;
+        des3_dec_ooo->num_lanes_inuse = 0;
+        memset(&des3_dec_ooo->args, 0, sizeof(des3_dec_ooo->args));
+
+        /* - separate DOCSIS DES OOO for encryption */
+        for (j = 0; j < AVX_NUM_DES_LANES; j++) {
+                docsis_des_enc_ooo->lens[j] = 0;
+                docsis_des_enc_ooo->job_in_lane[j] = NULL;
+        }
+        docsis_des_enc_ooo->unused_lanes = 0xF3210;
+        docsis_des_enc_ooo->num_lanes_inuse = 0;
+        memset(&docsis_des_enc_ooo->args, 0, sizeof(docsis_des_enc_ooo->args));
+
+        /* - separate DOCSIS DES OOO for decryption */
+        for (j = 0; j < AVX_NUM_DES_LANES; j++) {
+                docsis_des_dec_ooo->lens[j] = 0;
+                docsis_des_dec_ooo->job_in_lane[j] = NULL;
+        }
+        docsis_des_dec_ooo->unused_lanes = 0xF3210;
+        docsis_des_dec_ooo->num_lanes_inuse = 0;
+        memset(&docsis_des_dec_ooo->args, 0, sizeof(docsis_des_dec_ooo->args));
+
         /* Init ZUC out-of-order fields */
         memset(zuc_eea3_ooo->lens, 0xFF,
                sizeof(zuc_eea3_ooo->lens));
@@ -552,6 +764,17 @@ init_mb_mgr_avx(IMB_MGR *state)
         zuc_eia3_ooo->unused_lanes = 0xFF03020100;
         zuc_eia3_ooo->num_lanes_inuse = 0;
 
+        memset(zuc_eea3_eia3_ooo->lens, 0xFF,
+               sizeof(zuc_eea3_eia3_ooo->lens));
+        memset(zuc_eea3_eia3_ooo->auth_lens, 0xFF,
+               sizeof(zuc_eea3_eia3_ooo->auth_lens));
+        memset(zuc_eea3_eia3_ooo->job_in_lane, 0,
+               sizeof(zuc_eea3_eia3_ooo->job_in_lane));
+        zuc_eea3_eia3_ooo->unused_lanes = 0xF10;
+        zuc_eea3_eia3_ooo->num_lanes_inuse = 0;
+        zuc_eea3_eia3_ooo->auth_after_cipher = 0;
+        zuc_eea3_eia3_ooo->cipher_lag = 0;
+
         /* Init HMAC/SHA1 out-of-order fields */
         hmac_sha_1_ooo->lens[0] = 0;
         hmac_sha_1_ooo->lens[1] = 0;
@@ -763,6 +986,36 @@ init_mb_mgr_avx(IMB_MGR *state)
         aes_ccm_ooo->unused_lanes = 0xF76543210;
         aes_ccm_ooo->num_lanes_inuse = 0;
 
+        /* Init AES-CCM stitched (CTR + CBC-MAC) out-of-order fields */
+        memset(aes128_ccm_ctr_mac_ooo->lens, 0xFF,
+               sizeof(aes128_ccm_ctr_mac_ooo->lens));
+        memset(aes128_ccm_ctr_mac_ooo->job_in_lane, 0,
+               sizeof(aes128_ccm_ctr_mac_ooo->job_in_lane));
+        aes128_ccm_ctr_mac_ooo->unused_lanes = 0xF3210;
+        aes128_ccm_ctr_mac_ooo->num_lanes_inuse = 0;
+
+        memset(aes256_ccm_ctr_mac_ooo->lens, 0xFF,
+               sizeof(aes256_ccm_ctr_mac_ooo->lens));
+        memset(aes256_ccm_ctr_mac_ooo->job_in_lane, 0,
+               sizeof(aes256_ccm_ctr_mac_ooo->job_in_lane));
+        aes256_ccm_ctr_mac_ooo->unused_lanes = 0xF3210;
+        aes256_ccm_ctr_mac_ooo->num_lanes_inuse = 0;
+
+        /* Init DOCSIS SEC BPI + CRC32 stitched out-of-order fields */
+        memset(docsis128_crc32_x4_ooo->lens, 0xFF,
+               sizeof(docsis128_crc32_x4_ooo->lens));
+        memset(docsis128_crc32_x4_ooo->job_in_lane, 0,
+               sizeof(docsis128_crc32_x4_ooo->job_in_lane));
+        docsis128_crc32_x4_ooo->unused_lanes = 0xF3210;
+        docsis128_crc32_x4_ooo->num_lanes_inuse = 0;
+
+        memset(docsis256_crc32_x4_ooo->lens, 0xFF,
+               sizeof(docsis256_crc32_x4_ooo->lens));
+        memset(docsis256_crc32_x4_ooo->job_in_lane, 0,
+               sizeof(docsis256_crc32_x4_ooo->job_in_lane));
+        docsis256_crc32_x4_ooo->unused_lanes = 0xF3210;
+        docsis256_crc32_x4_ooo->num_lanes_inuse = 0;
+
         /* Init AES-CMAC auth out-of-order fields */
         for (j = 0; j < 8; j++) {
                 aes_cmac_ooo->init_done[j] = 0;
@@ -772,9 +1025,42 @@ init_mb_mgr_avx(IMB_MGR *state)
         aes_cmac_ooo->unused_lanes = 0xF76543210;
         aes_cmac_ooo->num_lanes_inuse = 0;
 
+        /* Init SGL AES-CBC encrypt and AES-CCM out-of-order fields */
+        memset(aes128_cbc_sgl_ooo->job_in_lane, 0,
+               sizeof(aes128_cbc_sgl_ooo->job_in_lane));
+        aes128_cbc_sgl_ooo->unused_lanes = 0xF76543210;
+        aes128_cbc_sgl_ooo->num_lanes = 8;
+        aes128_cbc_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes192_cbc_sgl_ooo->job_in_lane, 0,
+               sizeof(aes192_cbc_sgl_ooo->job_in_lane));
+        aes192_cbc_sgl_ooo->unused_lanes = 0xF76543210;
+        aes192_cbc_sgl_ooo->num_lanes = 8;
+        aes192_cbc_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes256_cbc_sgl_ooo->job_in_lane, 0,
+               sizeof(aes256_cbc_sgl_ooo->job_in_lane));
+        aes256_cbc_sgl_ooo->unused_lanes = 0xF76543210;
+        aes256_cbc_sgl_ooo->num_lanes = 8;
+        aes256_cbc_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes128_ccm_sgl_ooo->job_in_lane, 0,
+               sizeof(aes128_ccm_sgl_ooo->job_in_lane));
+        aes128_ccm_sgl_ooo->unused_lanes = 0xF76543210;
+        aes128_ccm_sgl_ooo->num_lanes = 8;
+        aes128_ccm_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes256_ccm_sgl_ooo->job_in_lane, 0,
+               sizeof(aes256_ccm_sgl_ooo->job_in_lane));
+        aes256_ccm_sgl_ooo->unused_lanes = 0xF76543210;
+        aes256_ccm_sgl_ooo->num_lanes = 8;
+        aes256_ccm_sgl_ooo->num_lanes_inuse = 0;
+
         /* Init "in order" components */
         state->next_job = 0;
         state->earliest_job = -1;
+        state->completion_cb = NULL;
+        state->completion_cb_arg = NULL;
 
         /* set AVX handlers */
         state->get_next_job        = get_next_job_avx;
@@ -783,6 +1069,7 @@ init_mb_mgr_avx(IMB_MGR *state)
         state->get_completed_job   = get_completed_job_avx;
         state->flush_job           = flush_job_avx;
         state->queue_size          = queue_size_avx;
+        state->clear_scratch       = clear_scratch_avx;
         state->keyexp_128          = aes_keyexp_128_avx;
         state->keyexp_192          = aes_keyexp_192_avx;
         state->keyexp_256          = aes_keyexp_256_avx;
@@ -802,6 +1089,19 @@ init_mb_mgr_avx(IMB_MGR *state)
         state->sha512              = sha512_avx;
         state->md5_one_block       = md5_one_block_avx;
         state->aes128_cfb_one      = aes_cfb_128_one_avx;
+        state->aes128_xts_enc      = aes_xts_128_enc_avx;
+        state->aes128_xts_dec      = aes_xts_128_dec_avx;
+        state->aes256_xts_enc      = aes_xts_256_enc_avx;
+        state->aes256_xts_dec      = aes_xts_256_dec_avx;
+        state->aes128_ecb_enc      = aes_ecb_128_enc_avx;
+        state->aes128_ecb_dec      = aes_ecb_128_dec_avx;
+        state->aes192_ecb_enc      = aes_ecb_192_enc_avx;
+        state->aes192_ecb_dec      = aes_ecb_192_dec_avx;
+        state->aes256_ecb_enc      = aes_ecb_256_enc_avx;
+        state->aes256_ecb_dec      = aes_ecb_256_dec_avx;
+        state->keyexp_128_n        = aes_keyexp_128_n_avx;
+        state->keyexp_192_n        = aes_keyexp_192_n_avx;
+        state->keyexp_256_n        = aes_keyexp_256_n_avx;
 
         state->eea3_1_buffer       = zuc_eea3_1_buffer_avx;
         state->eea3_4_buffer       = zuc_eea3_4_buffer_avx;
@@ -863,6 +1163,36 @@ init_mb_mgr_avx(IMB_MGR *state)
         state->gcm128_pre          = aes_gcm_pre_128_avx_gen2;
         state->gcm192_pre          = aes_gcm_pre_192_avx_gen2;
         state->gcm256_pre          = aes_gcm_pre_256_avx_gen2;
+        state->gcm128_pre_n        = aes_gcm_pre_128_n_avx_gen2;
+        state->gcm192_pre_n        = aes_gcm_pre_192_n_avx_gen2;
+        state->gcm256_pre_n        = aes_gcm_pre_256_n_avx_gen2;
+        state->gcm128_enc_n        = aes_gcm_enc_128_n_avx_gen2;
+        state->gcm192_enc_n        = aes_gcm_enc_192_n_avx_gen2;
+        state->gcm256_enc_n        = aes_gcm_enc_256_n_avx_gen2;
+        state->gcm128_dec_n        = aes_gcm_dec_128_n_avx_gen2;
+        state->gcm192_dec_n        = aes_gcm_dec_192_n_avx_gen2;
+        state->gcm256_dec_n        = aes_gcm_dec_256_n_avx_gen2;
+        state->gcm128_pre_compact = aes_gcm_pre_compact_128_avx_gen2;
+        state->gcm192_pre_compact = aes_gcm_pre_compact_192_avx_gen2;
+        state->gcm256_pre_compact = aes_gcm_pre_compact_256_avx_gen2;
+        state->gcm128_expand_compact =
+                aes_gcm_expand_compact_128_avx_gen2;
+        state->gcm192_expand_compact =
+                aes_gcm_expand_compact_192_avx_gen2;
+        state->gcm256_expand_compact =
+                aes_gcm_expand_compact_256_avx_gen2;
+        state->gcm128_enc_compact =
+                aes_gcm_enc_compact_128_avx_gen2;
+        state->gcm192_enc_compact =
+                aes_gcm_enc_compact_192_avx_gen2;
+        state->gcm256_enc_compact =
+                aes_gcm_enc_compact_256_avx_gen2;
+        state->gcm128_dec_compact =
+                aes_gcm_dec_compact_128_avx_gen2;
+        state->gcm192_dec_compact =
+                aes_gcm_dec_compact_192_avx_gen2;
+        state->gcm256_dec_compact =
+                aes_gcm_dec_compact_256_avx_gen2;
         state->ghash               = ghash_avx_gen2;
 
         state->gmac128_init        = imb_aes_gmac_init_128_avx_gen2;
@@ -877,6 +1207,17 @@ init_mb_mgr_avx(IMB_MGR *state)
 
         state->hec_32              = hec_32_avx;
         state->hec_64              = hec_64_avx;
+
+        state->crc32_ethernet_fcs = crc32_ethernet_fcs_avx;
+        state->crc32_sctp         = crc32_sctp_avx;
+        state->crc16_x25          = crc16_x25_avx;
+        state->crc24_lte_a        = crc24_lte_a_avx;
+        state->crc24_lte_b        = crc24_lte_b_avx;
+        state->crc16_fp_data      = crc16_fp_data_avx;
+        state->crc11_fp_header    = crc11_fp_header_avx;
+        state->crc7_fp_header     = crc7_fp_header_avx;
+        state->crc10_iuup_data    = crc10_iuup_data_avx;
+        state->crc6_iuup_header   = crc6_iuup_header_avx;
 }
 
 #include "mb_mgr_code.h"
@@ -0,0 +1,75 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*-----------------------------------------------------------------------
+ * Combined ZUC EEA3 + EIA3 out-of-order manager (4 lanes, AVX)
+ *-----------------------------------------------------------------------*/
+
+#include "include/zuc_internal.h"
+
+#define SUBMIT_JOB_ZUC_EEA3_EIA3 submit_job_zuc_eea3_eia3_avx
+#define FLUSH_JOB_ZUC_EEA3_EIA3 flush_job_zuc_eea3_eia3_avx
+
+static inline void
+zuc_init_4_avx(ZucState4_t *state, const void * const pKey[4],
+               const void * const pIv[4])
+{
+        DECLARE_ALIGNED(ZucKey4_t keys, 64);
+        DECLARE_ALIGNED(ZucIv4_t ivs, 64);
+
+        keys.pKey1 = pKey[0];
+        keys.pKey2 = pKey[1];
+        keys.pKey3 = pKey[2];
+        keys.pKey4 = pKey[3];
+
+        ivs.pIv1 = pIv[0];
+        ivs.pIv2 = pIv[1];
+        ivs.pIv3 = pIv[2];
+        ivs.pIv4 = pIv[3];
+
+        asm_ZucInitialization_4_avx(&keys, &ivs, state);
+}
+
+static inline void
+zuc_keygen64b_4_avx(ZucState4_t *state, uint32_t *pKeyStr[4])
+{
+        asm_ZucGenKeystream64B_4_avx(state, pKeyStr[0], pKeyStr[1],
+                                     pKeyStr[2], pKeyStr[3]);
+}
+
+#define ZUC_EEA3_EIA3_NUM_LANES 4
+#define ZUC_STATE_N             ZucState4_t
+#define ZUC_INIT_N              zuc_init_4_avx
+#define ZUC_KEYGEN64B_N         zuc_keygen64b_4_avx
+#define ZUC_KEYGEN64B           asm_ZucGenKeystream64B_avx
+#define ZUC_KEYGEN8B            asm_ZucGenKeystream8B_avx
+#define ZUC_KEYGEN              asm_ZucGenKeystream_avx
+#define ZUC_XOR_KEYSTREAM64B    asm_XorKeyStream64B_avx
+#define EIA3_ROUND64B           asm_Eia3Round64BAVX
+#define EIA3_REMAINDER          asm_Eia3RemainderAVX
+
+#include "include/zuc_eea3_eia3_common.h"
@@ -0,0 +1,39 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#define AES_KEYEXP_128_N        aes_keyexp_128_n_avx2
+#define AES_KEYEXP_192_N        aes_keyexp_192_n_avx2
+#define AES_KEYEXP_256_N        aes_keyexp_256_n_avx2
+#define AES_GCM_PRE_128_N       aes_gcm_pre_128_n_avx_gen4
+#define AES_GCM_PRE_192_N       aes_gcm_pre_192_n_avx_gen4
+#define AES_GCM_PRE_256_N       aes_gcm_pre_256_n_avx_gen4
+#define GCM_PRECOMP_128         aes_gcm_precomp_128_avx_gen4
+#define GCM_PRECOMP_192         aes_gcm_precomp_192_avx_gen4
+#define GCM_PRECOMP_256         aes_gcm_precomp_256_avx_gen4
+#define CLEAR_SCRATCH_SIMD_REGS clear_scratch_ymms
+
+#include "include/aes_keyexp_n_common.h"
@@ -43,6 +43,7 @@
 #define SNOW3G_F8_8_BUFFER_MULTIKEY snow3g_f8_8_buffer_multikey_avx2
 #define SNOW3G_F8_N_BUFFER_MULTIKEY snow3g_f8_n_buffer_multikey_avx2
 #define SNOW3G_F9_1_BUFFER snow3g_f9_1_buffer_avx2
+#define SNOW3G_F8_F9_1_BUFFER snow3g_f8_f9_1_buffer_avx2
 #define SNOW3G_INIT_KEY_SCHED snow3g_init_key_sched_avx2
 #define SNOW3G_KEY_SCHED_SIZE snow3g_key_sched_size_avx2
 
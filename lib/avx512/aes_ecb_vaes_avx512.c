@@ -0,0 +1,216 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+
+/*
+ * VAES AES-ECB full block routines, 16 blocks (4 x zmm) per iteration.
+ * Module needs to be compiled with VAES enabled (OPT_VAES in Makefile).
+ */
+
+#include <stdint.h>
+#ifdef LINUX
+#include <x86intrin.h>
+#else
+#include <intrin.h>
+#endif
+
+#include "intel-ipsec-mb.h"
+#include "include/asm.h"
+
+#define AES_ECB_128_ENC         aes_ecb_128_enc_vaes_avx512
+#define AES_ECB_128_DEC         aes_ecb_128_dec_vaes_avx512
+#define AES_ECB_192_ENC         aes_ecb_192_enc_vaes_avx512
+#define AES_ECB_192_DEC         aes_ecb_192_dec_vaes_avx512
+#define AES_ECB_256_ENC         aes_ecb_256_enc_vaes_avx512
+#define AES_ECB_256_DEC         aes_ecb_256_dec_vaes_avx512
+#define AES_ECB_ENC_128         aes_ecb_enc_128_vaes_avx512
+#define AES_ECB_DEC_128         aes_ecb_dec_128_vaes_avx512
+#define AES_ECB_ENC_192         aes_ecb_enc_192_vaes_avx512
+#define AES_ECB_DEC_192         aes_ecb_dec_192_vaes_avx512
+#define AES_ECB_ENC_256         aes_ecb_enc_256_vaes_avx512
+#define AES_ECB_DEC_256         aes_ecb_dec_256_vaes_avx512
+#define SAVE_XMMS               save_xmms_avx
+#define RESTORE_XMMS            restore_xmms_avx
+#define CLEAR_SCRATCH_SIMD_REGS clear_scratch_zmms
+
+/**
+ * @brief Broadcasts round key <r> to all 4 lanes
+ *
+ * Round keys are loaded from the key schedule at each round,
+ * so no copy of them is kept on the stack.
+ */
+__forceinline
+__m512i
+aes_ecb_vaes_key(const void *keys, const unsigned r)
+{
+        return _mm512_broadcast_i32x4(_mm_loadu_si128(&((const __m128i *)
+                                                         keys)[r]));
+}
+
+/**
+ * @brief AES round on 4 blocks (one zmm register)
+ */
+__forceinline
+__m512i
+aes_ecb_vaes_round(const __m512i b, const __m512i k, const int dec)
+{
+        return dec ? _mm512_aesdec_epi128(b, k) : _mm512_aesenc_epi128(b, k);
+}
+
+/**
+ * @brief AES last round on 4 blocks (one zmm register)
+ */
+__forceinline
+__m512i
+aes_ecb_vaes_last(const __m512i b, const __m512i k, const int dec)
+{
+        return dec ? _mm512_aesdeclast_epi128(b, k) :
+                _mm512_aesenclast_epi128(b, k);
+}
+
+/**
+ * @brief All AES rounds on 4 blocks (one zmm register)
+ */
+__forceinline
+__m512i
+aes_ecb_vaes_x4(__m512i b, const void *keys, const unsigned nrounds,
+                const int dec)
+{
+        unsigned r;
+
+        b = _mm512_xor_si512(b, aes_ecb_vaes_key(keys, 0));
+        for (r = 1; r < nrounds; r++)
+                b = aes_ecb_vaes_round(b, aes_ecb_vaes_key(keys, r), dec);
+
+        return aes_ecb_vaes_last(b, aes_ecb_vaes_key(keys, nrounds), dec);
+}
+
+/**
+ * @brief Encrypts/decrypts full blocks, 16 at a time,
+ *        then 4 at a time and 1 to 3 remaining blocks with masked load/store
+ */
+__forceinline
+void
+aes_ecb_vaes(const void *in, const void *keys, void *out, uint64_t len,
+             const unsigned nrounds, const int dec)
+{
+        const uint8_t *src = (const uint8_t *) in;
+        uint8_t *dst = (uint8_t *) out;
+        __m512i k;
+        unsigned r;
+
+        for (; len >= (16 * AES_BLOCK_SIZE); len -= (16 * AES_BLOCK_SIZE)) {
+                __m512i b0 = _mm512_loadu_si512(src);
+                __m512i b1 = _mm512_loadu_si512(src + 64);
+                __m512i b2 = _mm512_loadu_si512(src + 128);
+                __m512i b3 = _mm512_loadu_si512(src + 192);
+
+                k = aes_ecb_vaes_key(keys, 0);
+                b0 = _mm512_xor_si512(b0, k);
+                b1 = _mm512_xor_si512(b1, k);
+                b2 = _mm512_xor_si512(b2, k);
+                b3 = _mm512_xor_si512(b3, k);
+                for (r = 1; r < nrounds; r++) {
+                        k = aes_ecb_vaes_key(keys, r);
+                        b0 = aes_ecb_vaes_round(b0, k, dec);
+                        b1 = aes_ecb_vaes_round(b1, k, dec);
+                        b2 = aes_ecb_vaes_round(b2, k, dec);
+                        b3 = aes_ecb_vaes_round(b3, k, dec);
+                }
+                k = aes_ecb_vaes_key(keys, nrounds);
+                _mm512_storeu_si512(dst, aes_ecb_vaes_last(b0, k, dec));
+                _mm512_storeu_si512(dst + 64, aes_ecb_vaes_last(b1, k, dec));
+                _mm512_storeu_si512(dst + 128,
+                                    aes_ecb_vaes_last(b2, k, dec));
+                _mm512_storeu_si512(dst + 192,
+                                    aes_ecb_vaes_last(b3, k, dec));
+                src += 16 * AES_BLOCK_SIZE;
+                dst += 16 * AES_BLOCK_SIZE;
+        }
+
+        for (; len >= (4 * AES_BLOCK_SIZE); len -= (4 * AES_BLOCK_SIZE)) {
+                _mm512_storeu_si512(dst,
+                                    aes_ecb_vaes_x4(_mm512_loadu_si512(src),
+                                                    keys, nrounds, dec));
+                src += 4 * AES_BLOCK_SIZE;
+                dst += 4 * AES_BLOCK_SIZE;
+        }
+
+        if (len != 0) {
+                /* 1 to 3 blocks left, 2 x 64-bit words per block */
+                const __mmask8 mask = (__mmask8) ((1 << (len / 8)) - 1);
+                const __m512i b = _mm512_maskz_loadu_epi64(mask, src);
+
+                _mm512_mask_storeu_epi64(dst, mask,
+                                         aes_ecb_vaes_x4(b, keys, nrounds,
+                                                         dec));
+        }
+}
+
+void
+aes_ecb_enc_128_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_vaes(in, keys, out, len_bytes, 10, 0);
+}
+
+void
+aes_ecb_enc_192_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_vaes(in, keys, out, len_bytes, 12, 0);
+}
+
+void
+aes_ecb_enc_256_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_vaes(in, keys, out, len_bytes, 14, 0);
+}
+
+void
+aes_ecb_dec_128_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_vaes(in, keys, out, len_bytes, 10, 1);
+}
+
+void
+aes_ecb_dec_192_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_vaes(in, keys, out, len_bytes, 12, 1);
+}
+
+void
+aes_ecb_dec_256_vaes_avx512(const void *in, const void *keys,
+                            void *out, uint64_t len_bytes)
+{
+        aes_ecb_vaes(in, keys, out, len_bytes, 14, 1);
+}
+
+#include "include/aes_ecb_common.h"
@@ -0,0 +1,44 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+
+/* Module needs to be compiled with VPCLMULQDQ enabled (OPT_VAES in Makefile) */
+
+#define CRC32_ETHERNET_FCS crc32_ethernet_fcs_vaes_avx512
+#define CRC32_SCTP         crc32_sctp_vaes_avx512
+#define CRC16_X25          crc16_x25_vaes_avx512
+#define CRC24_LTE_A        crc24_lte_a_vaes_avx512
+#define CRC24_LTE_B        crc24_lte_b_vaes_avx512
+#define CRC16_FP_DATA      crc16_fp_data_vaes_avx512
+#define CRC11_FP_HEADER    crc11_fp_header_vaes_avx512
+#define CRC7_FP_HEADER     crc7_fp_header_vaes_avx512
+#define CRC10_IUUP_DATA    crc10_iuup_data_vaes_avx512
+#define CRC6_IUUP_HEADER   crc6_iuup_header_vaes_avx512
+#define ETHERNET_FCS       ethernet_fcs_avx512
+#define CRC_FOLD_ZMM
+
+#include "include/crc_common.h"
@@ -38,6 +38,7 @@
 #include "include/zuc_internal.h"
 #include "include/snow3g.h"
 #include "include/gcm.h"
+#include "include/crc.h"
 
 #include "save_xmms.h"
 #include "asm.h"
@@ -58,6 +59,19 @@ IMB_JOB *submit_job_aes256_enc_avx(MB_MGR_AES_OOO *state,
                                         IMB_JOB *job);
 IMB_JOB *flush_job_aes256_enc_avx(MB_MGR_AES_OOO *state);
 
+IMB_JOB *submit_job_aes128_cfb_enc_avx(MB_MGR_AES_OOO *state,
+                                      IMB_JOB *job);
+IMB_JOB *flush_job_aes128_cfb_enc_avx(MB_MGR_AES_OOO *state);
+
+IMB_JOB *submit_job_aes256_cfb_enc_avx(MB_MGR_AES_OOO *state,
+                                      IMB_JOB *job);
+IMB_JOB *flush_job_aes256_cfb_enc_avx(MB_MGR_AES_OOO *state);
+
+void aes_cfb_dec_128_by8_avx(const void *in, const uint8_t *IV,
+                             const void *keys, void *out, uint64_t len_bytes);
+void aes_cfb_dec_256_by8_avx(const void *in, const uint8_t *IV,
+                             const void *keys, void *out, uint64_t len_bytes);
+
 IMB_JOB *submit_job_aes_xcbc_avx(MB_MGR_AES_XCBC_OOO *state,
                                       IMB_JOB *job);
 IMB_JOB *flush_job_aes_xcbc_avx(MB_MGR_AES_XCBC_OOO *state);
@@ -121,6 +135,14 @@ IMB_JOB *submit_job_zuc_eia3_gfni_avx512(MB_MGR_ZUC_OOO *state,
                                               IMB_JOB *job);
 IMB_JOB *flush_job_zuc_eia3_gfni_avx512(MB_MGR_ZUC_OOO *state);
 
+IMB_JOB *submit_job_zuc_eea3_eia3_no_gfni_avx512(MB_MGR_ZUC_EEA3_EIA3_OOO *state,
+                                                 IMB_JOB *job);
+IMB_JOB *flush_job_zuc_eea3_eia3_no_gfni_avx512(MB_MGR_ZUC_EEA3_EIA3_OOO *state);
+
+IMB_JOB *submit_job_zuc_eea3_eia3_gfni_avx512(MB_MGR_ZUC_EEA3_EIA3_OOO *state,
+                                              IMB_JOB *job);
+IMB_JOB *flush_job_zuc_eea3_eia3_gfni_avx512(MB_MGR_ZUC_EEA3_EIA3_OOO *state);
+
 IMB_JOB *aes_cntr_ccm_128_vaes_avx512(IMB_JOB *job);
 
 IMB_JOB *aes_cntr_ccm_256_vaes_avx512(IMB_JOB *job);
@@ -144,13 +166,17 @@ uint64_t hec_64_avx(const uint8_t *in);
 #define SUBMIT_JOB_AES256_ENC submit_job_aes256_enc_avx512
 #define SUBMIT_JOB_AES256_DEC submit_job_aes256_dec_avx512
 #define FLUSH_JOB_AES256_ENC  flush_job_aes256_enc_avx512
-
-#define SUBMIT_JOB_AES_ECB_128_ENC submit_job_aes_ecb_128_enc_avx
-#define SUBMIT_JOB_AES_ECB_128_DEC submit_job_aes_ecb_128_dec_avx
-#define SUBMIT_JOB_AES_ECB_192_ENC submit_job_aes_ecb_192_enc_avx
-#define SUBMIT_JOB_AES_ECB_192_DEC submit_job_aes_ecb_192_dec_avx
-#define SUBMIT_JOB_AES_ECB_256_ENC submit_job_aes_ecb_256_enc_avx
-#define SUBMIT_JOB_AES_ECB_256_DEC submit_job_aes_ecb_256_dec_avx
+#define SUBMIT_JOB_AES128_CFB_ENC submit_job_aes128_cfb_enc_avx
+#define FLUSH_JOB_AES128_CFB_ENC  flush_job_aes128_cfb_enc_avx
+#define SUBMIT_JOB_AES256_CFB_ENC submit_job_aes256_cfb_enc_avx
+#define FLUSH_JOB_AES256_CFB_ENC  flush_job_aes256_cfb_enc_avx
+
+#define SUBMIT_JOB_AES_ECB_128_ENC submit_job_aes_ecb_128_enc_avx512
+#define SUBMIT_JOB_AES_ECB_128_DEC submit_job_aes_ecb_128_dec_avx512
+#define SUBMIT_JOB_AES_ECB_192_ENC submit_job_aes_ecb_192_enc_avx512
+#define SUBMIT_JOB_AES_ECB_192_DEC submit_job_aes_ecb_192_dec_avx512
+#define SUBMIT_JOB_AES_ECB_256_ENC submit_job_aes_ecb_256_enc_avx512
+#define SUBMIT_JOB_AES_ECB_256_DEC submit_job_aes_ecb_256_dec_avx512
 
 #define SUBMIT_JOB_AES_CNTR   submit_job_aes_cntr_avx512
 #define SUBMIT_JOB_AES_CNTR_BIT   submit_job_aes_cntr_bit_avx512
@@ -159,10 +185,16 @@ uint64_t hec_64_avx(const uint8_t *in);
 #define FLUSH_JOB_ZUC_EEA3    flush_job_zuc_eea3_avx512
 #define SUBMIT_JOB_ZUC_EIA3   submit_job_zuc_eia3_avx512
 #define FLUSH_JOB_ZUC_EIA3    flush_job_zuc_eia3_avx512
+#define SUBMIT_JOB_ZUC_EEA3_EIA3 submit_job_zuc_eea3_eia3_avx512
+#define FLUSH_JOB_ZUC_EEA3_EIA3  flush_job_zuc_eea3_eia3_avx512
+
+#define SNOW3G_F8_F9_1_BUFFER snow3g_f8_f9_1_buffer_avx2
 
 #define AES_CBC_DEC_128       aes_cbc_dec_128_avx512
 #define AES_CBC_DEC_192       aes_cbc_dec_192_avx512
 #define AES_CBC_DEC_256       aes_cbc_dec_256_avx512
+#define AES_CFB_DEC_128       aes_cfb_dec_128_avx512
+#define AES_CFB_DEC_256       aes_cfb_dec_256_avx512
 
 #define AES_CNTR_128       aes_cntr_128_avx
 #define AES_CNTR_192       aes_cntr_192_avx
@@ -171,17 +203,26 @@ uint64_t hec_64_avx(const uint8_t *in);
 #define AES_CNTR_CCM_128   aes_cntr_ccm_128_avx512
 #define AES_CNTR_CCM_256   aes_cntr_ccm_256_avx512
 
-#define AES_ECB_ENC_128       aes_ecb_enc_128_avx
-#define AES_ECB_ENC_192       aes_ecb_enc_192_avx
-#define AES_ECB_ENC_256       aes_ecb_enc_256_avx
-#define AES_ECB_DEC_128       aes_ecb_dec_128_avx
-#define AES_ECB_DEC_192       aes_ecb_dec_192_avx
-#define AES_ECB_DEC_256       aes_ecb_dec_256_avx
+#define AES_ECB_ENC_128       aes_ecb_enc_128_avx512
+#define AES_ECB_ENC_192       aes_ecb_enc_192_avx512
+#define AES_ECB_ENC_256       aes_ecb_enc_256_avx512
+#define AES_ECB_DEC_128       aes_ecb_dec_128_avx512
+#define AES_ECB_DEC_192       aes_ecb_dec_192_avx512
+#define AES_ECB_DEC_256       aes_ecb_dec_256_avx512
+
+#define SHA1_BLOCK_UPDATE     sha1_block_avx
+#define SHA256_BLOCK_UPDATE   sha256_block_avx
+#define SHA512_BLOCK_UPDATE   sha512_block_avx
 
-#define SUBMIT_JOB_PON_ENC        submit_job_pon_enc_avx
-#define SUBMIT_JOB_PON_DEC        submit_job_pon_dec_avx
-#define SUBMIT_JOB_PON_ENC_NO_CTR submit_job_pon_enc_no_ctr_avx
-#define SUBMIT_JOB_PON_DEC_NO_CTR submit_job_pon_dec_no_ctr_avx
+#define AES_XTS_128_ENC       aes_xts_128_enc_fn
+#define AES_XTS_128_DEC       aes_xts_128_dec_fn
+#define AES_XTS_256_ENC       aes_xts_256_enc_fn
+#define AES_XTS_256_DEC       aes_xts_256_dec_fn
+
+#define SUBMIT_JOB_PON_ENC        submit_job_pon_enc_avx512
+#define SUBMIT_JOB_PON_DEC        submit_job_pon_dec_avx512
+#define SUBMIT_JOB_PON_ENC_NO_CTR submit_job_pon_enc_no_ctr_avx512
+#define SUBMIT_JOB_PON_DEC_NO_CTR submit_job_pon_dec_no_ctr_avx512
 
 #define SUBMIT_JOB_AES_XCBC   submit_job_aes_xcbc_avx
 #define FLUSH_JOB_AES_XCBC    flush_job_aes_xcbc_avx
@@ -339,6 +380,7 @@ SUBMIT_JOB_DOCSIS_SEC_CRC_DEC(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job,
 #define SUBMIT_JOB         submit_job_avx512
 #define FLUSH_JOB          flush_job_avx512
 #define QUEUE_SIZE         queue_size_avx512
+#define CLEAR_SCRATCH      clear_scratch_avx512
 #define SUBMIT_JOB_NOCHECK submit_job_nocheck_avx512
 #define GET_NEXT_JOB       get_next_job_avx512
 #define GET_COMPLETED_JOB  get_completed_job_avx512
@@ -353,6 +395,12 @@ SUBMIT_JOB_DOCSIS_SEC_CRC_DEC(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job,
 #define AES_CFB_128_ONE    aes_cfb_128_one_avx512
 #define AES_CFB_256_ONE    aes_cfb_256_one_avx512
 
+#define AES_CBC_ENC_128_X  aes_cbc_enc_128_x_avx512
+#define AES_CBC_ENC_192_X  aes_cbc_enc_192_x_avx512
+#define AES_CBC_ENC_256_X  aes_cbc_enc_256_x_avx512
+#define AES128_CBC_MAC     aes128_cbc_mac_x_avx512
+#define AES256_CBC_MAC     aes256_cbc_mac_x_avx512
+
 #define FLUSH_JOB_AES128_CCM_AUTH     flush_job_aes128_ccm_auth_avx512
 #define SUBMIT_JOB_AES128_CCM_AUTH    submit_job_aes128_ccm_auth_avx512
 
@@ -641,6 +689,80 @@ static void
                            const void *keys, void *out,
                            uint64_t len_bytes) = aes_cbc_dec_256_avx;
 
+static void
+(*aes_cfb_dec_128_avx512) (const void *in, const uint8_t *IV,
+                           const void *keys, void *out,
+                           uint64_t len_bytes) = aes_cfb_dec_128_by8_avx;
+static void
+(*aes_cfb_dec_256_avx512) (const void *in, const uint8_t *IV,
+                           const void *keys, void *out,
+                           uint64_t len_bytes) = aes_cfb_dec_256_by8_avx;
+
+static aes_xts_t aes_xts_128_enc_fn = aes_xts_128_enc_avx512;
+static aes_xts_t aes_xts_128_dec_fn = aes_xts_128_dec_avx512;
+static aes_xts_t aes_xts_256_enc_fn = aes_xts_256_enc_avx512;
+static aes_xts_t aes_xts_256_dec_fn = aes_xts_256_dec_avx512;
+
+static void
+(*aes_ecb_enc_128_avx512) (const void *in, const void *keys,
+                           void *out,
+                           uint64_t len_bytes) = aes_ecb_enc_128_avx;
+static void
+(*aes_ecb_enc_192_avx512) (const void *in, const void *keys,
+                           void *out,
+                           uint64_t len_bytes) = aes_ecb_enc_192_avx;
+static void
+(*aes_ecb_enc_256_avx512) (const void *in, const void *keys,
+                           void *out,
+                           uint64_t len_bytes) = aes_ecb_enc_256_avx;
+static void
+(*aes_ecb_dec_128_avx512) (const void *in, const void *keys,
+                           void *out,
+                           uint64_t len_bytes) = aes_ecb_dec_128_avx;
+static void
+(*aes_ecb_dec_192_avx512) (const void *in, const void *keys,
+                           void *out,
+                           uint64_t len_bytes) = aes_ecb_dec_192_avx;
+static void
+(*aes_ecb_dec_256_avx512) (const void *in, const void *keys,
+                           void *out,
+                           uint64_t len_bytes) = aes_ecb_dec_256_avx;
+
+void aes128_cbc_mac_x8(AES_ARGS *args, uint64_t len);
+void aes256_cbc_mac_x8(AES_ARGS *args, uint64_t len);
+void aes_cbc_enc_128_vaes_avx512(AES_ARGS *args, uint64_t len);
+void aes_cbc_enc_192_vaes_avx512(AES_ARGS *args, uint64_t len);
+void aes_cbc_enc_256_vaes_avx512(AES_ARGS *args, uint64_t len);
+void aes128_cbc_mac_vaes_avx512(AES_ARGS *args, uint64_t len);
+void aes256_cbc_mac_vaes_avx512(AES_ARGS *args, uint64_t len);
+
+static void
+(*aes_cbc_enc_128_x_avx512) (AES_ARGS *args,
+                             uint64_t len) = aes_cbc_enc_128_x8;
+static void
+(*aes_cbc_enc_192_x_avx512) (AES_ARGS *args,
+                             uint64_t len) = aes_cbc_enc_192_x8;
+static void
+(*aes_cbc_enc_256_x_avx512) (AES_ARGS *args,
+                             uint64_t len) = aes_cbc_enc_256_x8;
+static void
+(*aes128_cbc_mac_x_avx512) (AES_ARGS *args,
+                            uint64_t len) = aes128_cbc_mac_x8;
+static void
+(*aes256_cbc_mac_x_avx512) (AES_ARGS *args,
+                            uint64_t len) = aes256_cbc_mac_x8;
+
+static IMB_JOB *
+(*submit_job_pon_enc_avx512)(IMB_JOB *job) = submit_job_pon_enc_avx;
+static IMB_JOB *
+(*submit_job_pon_dec_avx512)(IMB_JOB *job) = submit_job_pon_dec_avx;
+static IMB_JOB *
+(*submit_job_pon_enc_no_ctr_avx512)(IMB_JOB *job) =
+        submit_job_pon_enc_no_ctr_avx;
+static IMB_JOB *
+(*submit_job_pon_dec_no_ctr_avx512)(IMB_JOB *job) =
+        submit_job_pon_dec_no_ctr_avx;
+
 static IMB_JOB *
 (*submit_job_aes128_cmac_auth_avx512)
         (MB_MGR_CMAC_OOO *state,
@@ -701,6 +823,15 @@ static IMB_JOB *
 (*flush_job_zuc_eia3_avx512)
         (MB_MGR_ZUC_OOO *state) = flush_job_zuc_eia3_no_gfni_avx512;
 
+static IMB_JOB *
+(*submit_job_zuc_eea3_eia3_avx512)
+        (MB_MGR_ZUC_EEA3_EIA3_OOO *state, IMB_JOB *job) =
+                        submit_job_zuc_eea3_eia3_no_gfni_avx512;
+
+static IMB_JOB *
+(*flush_job_zuc_eea3_eia3_avx512)
+        (MB_MGR_ZUC_EEA3_EIA3_OOO *state) = flush_job_zuc_eea3_eia3_no_gfni_avx512;
+
 /* ====================================================================== */
 
 __forceinline
@@ -868,6 +999,8 @@ init_mb_mgr_avx512(IMB_MGR *state)
         MB_MGR_AES_OOO *aes128_ooo = state->aes128_ooo;
         MB_MGR_AES_OOO *aes192_ooo = state->aes192_ooo;
         MB_MGR_AES_OOO *aes256_ooo = state->aes256_ooo;
+        MB_MGR_AES_OOO *aes128_cfb_ooo = state->aes128_cfb_ooo;
+        MB_MGR_AES_OOO *aes256_cfb_ooo = state->aes256_cfb_ooo;
         MB_MGR_DOCSIS_AES_OOO *docsis128_sec_ooo = state->docsis128_sec_ooo;
         MB_MGR_DOCSIS_AES_OOO *docsis128_crc32_sec_ooo =
                                                 state->docsis128_crc32_sec_ooo;
@@ -891,6 +1024,15 @@ init_mb_mgr_avx512(IMB_MGR *state)
         MB_MGR_CMAC_OOO *aes_cmac_ooo = state->aes_cmac_ooo;
         MB_MGR_ZUC_OOO *zuc_eea3_ooo = state->zuc_eea3_ooo;
         MB_MGR_ZUC_OOO *zuc_eia3_ooo = state->zuc_eia3_ooo;
+        MB_MGR_ZUC_EEA3_EIA3_OOO *zuc_eea3_eia3_ooo =
+                state->zuc_eea3_eia3_ooo;
+        MB_MGR_SGL_OOO *aes128_cbc_sgl_ooo = state->aes128_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes192_cbc_sgl_ooo = state->aes192_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes256_cbc_sgl_ooo = state->aes256_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes128_ccm_sgl_ooo = state->aes128_ccm_sgl_ooo;
+        MB_MGR_SGL_OOO *aes256_ccm_sgl_ooo = state->aes256_ccm_sgl_ooo;
+        uint64_t sgl_unused_lanes = 0xF76543210;
+        uint64_t sgl_num_lanes = 8;
 
         state->features = cpu_feature_adjust(state->flags,
                                              cpu_feature_detect());
@@ -904,6 +1046,18 @@ init_mb_mgr_avx512(IMB_MGR *state)
                 aes_cbc_dec_128_avx512 = aes_cbc_dec_128_vaes_avx512;
                 aes_cbc_dec_192_avx512 = aes_cbc_dec_192_vaes_avx512;
                 aes_cbc_dec_256_avx512 = aes_cbc_dec_256_vaes_avx512;
+                aes_ecb_enc_128_avx512 = aes_ecb_enc_128_vaes_avx512;
+                aes_ecb_enc_192_avx512 = aes_ecb_enc_192_vaes_avx512;
+                aes_ecb_enc_256_avx512 = aes_ecb_enc_256_vaes_avx512;
+                aes_ecb_dec_128_avx512 = aes_ecb_dec_128_vaes_avx512;
+                aes_ecb_dec_192_avx512 = aes_ecb_dec_192_vaes_avx512;
+                aes_ecb_dec_256_avx512 = aes_ecb_dec_256_vaes_avx512;
+                aes_cfb_dec_128_avx512 = aes_cfb_dec_128_vaes_avx512;
+                aes_cfb_dec_256_avx512 = aes_cfb_dec_256_vaes_avx512;
+                aes_xts_128_enc_fn = aes_xts_128_enc_vaes_avx512;
+                aes_xts_128_dec_fn = aes_xts_128_dec_vaes_avx512;
+                aes_xts_256_enc_fn = aes_xts_256_enc_vaes_avx512;
+                aes_xts_256_dec_fn = aes_xts_256_dec_vaes_avx512;
                 submit_job_aes128_enc_avx512 =
                         submit_job_aes128_enc_vaes_avx512;
                 flush_job_aes128_enc_avx512 =
@@ -955,6 +1109,20 @@ init_mb_mgr_avx512(IMB_MGR *state)
                 flush_job_zuc_eea3_avx512 = flush_job_zuc_eea3_gfni_avx512;
                 submit_job_zuc_eia3_avx512 = submit_job_zuc_eia3_gfni_avx512;
                 flush_job_zuc_eia3_avx512 = flush_job_zuc_eia3_gfni_avx512;
+                submit_job_zuc_eea3_eia3_avx512 =
+                        submit_job_zuc_eea3_eia3_gfni_avx512;
+                flush_job_zuc_eea3_eia3_avx512 =
+                        flush_job_zuc_eea3_eia3_gfni_avx512;
+        }
+
+        if ((state->features & (IMB_FEATURE_VAES | IMB_FEATURE_VPCLMULQDQ)) ==
+            (IMB_FEATURE_VAES | IMB_FEATURE_VPCLMULQDQ)) {
+                submit_job_pon_enc_avx512 = submit_job_pon_enc_vaes_avx512;
+                submit_job_pon_dec_avx512 = submit_job_pon_dec_vaes_avx512;
+                submit_job_pon_enc_no_ctr_avx512 =
+                        submit_job_pon_enc_no_ctr_vaes_avx512;
+                submit_job_pon_dec_no_ctr_avx512 =
+                        submit_job_pon_dec_no_ctr_vaes_avx512;
         }
 
         /* Init AES out-of-order fields */
@@ -1010,6 +1178,17 @@ init_mb_mgr_avx512(IMB_MGR *state)
                 aes256_ooo->num_lanes_inuse = 0;
         }
 
+        /* AES-CFB encryption uses 8 lanes */
+        memset(aes128_cfb_ooo->job_in_lane, 0,
+               sizeof(aes128_cfb_ooo->job_in_lane));
+        aes128_cfb_ooo->unused_lanes = 0xF76543210;
+        aes128_cfb_ooo->num_lanes_inuse = 0;
+
+        memset(aes256_cfb_ooo->job_in_lane, 0,
+               sizeof(aes256_cfb_ooo->job_in_lane));
+        aes256_cfb_ooo->unused_lanes = 0xF76543210;
+        aes256_cfb_ooo->num_lanes_inuse = 0;
+
 
         /* DOCSIS SEC BPI (AES CBC + AES CFB for partial block)
          * uses same settings as AES CBC.
@@ -1160,6 +1339,17 @@ init_mb_mgr_avx512(IMB_MGR *state)
         zuc_eia3_ooo->unused_lanes = 0xFEDCBA9876543210;
         zuc_eia3_ooo->num_lanes_inuse = 0;
 
+        memset(zuc_eea3_eia3_ooo->lens, 0xFF,
+               sizeof(zuc_eea3_eia3_ooo->lens));
+        memset(zuc_eea3_eia3_ooo->auth_lens, 0xFF,
+               sizeof(zuc_eea3_eia3_ooo->auth_lens));
+        memset(zuc_eea3_eia3_ooo->job_in_lane, 0,
+               sizeof(zuc_eea3_eia3_ooo->job_in_lane));
+        zuc_eea3_eia3_ooo->unused_lanes = 0xF76543210;
+        zuc_eea3_eia3_ooo->num_lanes_inuse = 0;
+        zuc_eea3_eia3_ooo->auth_after_cipher = 0;
+        zuc_eea3_eia3_ooo->cipher_lag = 0;
+
 
         /* Init HMAC/SHA1 out-of-order fields */
         hmac_sha_1_ooo->lens[0] = 0;
@@ -1440,9 +1630,52 @@ init_mb_mgr_avx512(IMB_MGR *state)
                 aes_cmac_ooo->num_lanes_inuse = 0;
         }
 
+        /* Init SGL AES-CBC encrypt and AES-CCM out-of-order fields */
+        if (vaes_support) {
+                aes_cbc_enc_128_x_avx512 = aes_cbc_enc_128_vaes_avx512;
+                aes_cbc_enc_192_x_avx512 = aes_cbc_enc_192_vaes_avx512;
+                aes_cbc_enc_256_x_avx512 = aes_cbc_enc_256_vaes_avx512;
+                aes128_cbc_mac_x_avx512 = aes128_cbc_mac_vaes_avx512;
+                aes256_cbc_mac_x_avx512 = aes256_cbc_mac_vaes_avx512;
+                sgl_unused_lanes = 0xFEDCBA9876543210;
+                sgl_num_lanes = 16;
+        }
+
+        memset(aes128_cbc_sgl_ooo->job_in_lane, 0,
+               sizeof(aes128_cbc_sgl_ooo->job_in_lane));
+        aes128_cbc_sgl_ooo->unused_lanes = sgl_unused_lanes;
+        aes128_cbc_sgl_ooo->num_lanes = sgl_num_lanes;
+        aes128_cbc_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes192_cbc_sgl_ooo->job_in_lane, 0,
+               sizeof(aes192_cbc_sgl_ooo->job_in_lane));
+        aes192_cbc_sgl_ooo->unused_lanes = sgl_unused_lanes;
+        aes192_cbc_sgl_ooo->num_lanes = sgl_num_lanes;
+        aes192_cbc_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes256_cbc_sgl_ooo->job_in_lane, 0,
+               sizeof(aes256_cbc_sgl_ooo->job_in_lane));
+        aes256_cbc_sgl_ooo->unused_lanes = sgl_unused_lanes;
+        aes256_cbc_sgl_ooo->num_lanes = sgl_num_lanes;
+        aes256_cbc_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes128_ccm_sgl_ooo->job_in_lane, 0,
+               sizeof(aes128_ccm_sgl_ooo->job_in_lane));
+        aes128_ccm_sgl_ooo->unused_lanes = sgl_unused_lanes;
+        aes128_ccm_sgl_ooo->num_lanes = sgl_num_lanes;
+        aes128_ccm_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes256_ccm_sgl_ooo->job_in_lane, 0,
+               sizeof(aes256_ccm_sgl_ooo->job_in_lane));
+        aes256_ccm_sgl_ooo->unused_lanes = sgl_unused_lanes;
+        aes256_ccm_sgl_ooo->num_lanes = sgl_num_lanes;
+        aes256_ccm_sgl_ooo->num_lanes_inuse = 0;
+
         /* Init "in order" components */
         state->next_job = 0;
         state->earliest_job = -1;
+        state->completion_cb = NULL;
+        state->completion_cb_arg = NULL;
 
         /* set handlers */
         state->get_next_job        = get_next_job_avx512;
@@ -1451,6 +1684,7 @@ init_mb_mgr_avx512(IMB_MGR *state)
         state->get_completed_job   = get_completed_job_avx512;
         state->flush_job           = flush_job_avx512;
         state->queue_size          = queue_size_avx512;
+        state->clear_scratch       = clear_scratch_avx512;
         state->keyexp_128          = aes_keyexp_128_avx512;
         state->keyexp_192          = aes_keyexp_192_avx512;
         state->keyexp_256          = aes_keyexp_256_avx512;
@@ -1470,6 +1704,19 @@ init_mb_mgr_avx512(IMB_MGR *state)
         state->sha512              = sha512_avx512;
         state->md5_one_block       = md5_one_block_avx512;
         state->aes128_cfb_one      = aes_cfb_128_one_avx512;
+        state->aes128_xts_enc      = aes_xts_128_enc_fn;
+        state->aes128_xts_dec      = aes_xts_128_dec_fn;
+        state->aes256_xts_enc      = aes_xts_256_enc_fn;
+        state->aes256_xts_dec      = aes_xts_256_dec_fn;
+        state->aes128_ecb_enc      = aes_ecb_128_enc_avx512;
+        state->aes128_ecb_dec      = aes_ecb_128_dec_avx512;
+        state->aes192_ecb_enc      = aes_ecb_192_enc_avx512;
+        state->aes192_ecb_dec      = aes_ecb_192_dec_avx512;
+        state->aes256_ecb_enc      = aes_ecb_256_enc_avx512;
+        state->aes256_ecb_dec      = aes_ecb_256_dec_avx512;
+        state->keyexp_128_n        = aes_keyexp_128_n_avx512;
+        state->keyexp_192_n        = aes_keyexp_192_n_avx512;
+        state->keyexp_256_n        = aes_keyexp_256_n_avx512;
 
         state->eea3_1_buffer       = zuc_eea3_1_buffer_avx512;
         state->eea3_4_buffer       = zuc_eea3_4_buffer_avx;
@@ -1511,9 +1758,40 @@ init_mb_mgr_avx512(IMB_MGR *state)
         state->hec_32              = hec_32_avx;
         state->hec_64              = hec_64_avx;
 
+        state->crc32_ethernet_fcs = crc32_ethernet_fcs_avx512;
+        state->crc32_sctp         = crc32_sctp_avx512;
+        state->crc16_x25          = crc16_x25_avx512;
+        state->crc24_lte_a        = crc24_lte_a_avx512;
+        state->crc24_lte_b        = crc24_lte_b_avx512;
+        state->crc16_fp_data      = crc16_fp_data_avx512;
+        state->crc11_fp_header    = crc11_fp_header_avx512;
+        state->crc7_fp_header     = crc7_fp_header_avx512;
+        state->crc10_iuup_data    = crc10_iuup_data_avx512;
+        state->crc6_iuup_header   = crc6_iuup_header_avx512;
+
+        if ((state->features & IMB_FEATURE_VPCLMULQDQ) ==
+            IMB_FEATURE_VPCLMULQDQ) {
+                state->crc32_ethernet_fcs = crc32_ethernet_fcs_vaes_avx512;
+                state->crc32_sctp         = crc32_sctp_vaes_avx512;
+                state->crc16_x25          = crc16_x25_vaes_avx512;
+                state->crc24_lte_a        = crc24_lte_a_vaes_avx512;
+                state->crc24_lte_b        = crc24_lte_b_vaes_avx512;
+                state->crc16_fp_data      = crc16_fp_data_vaes_avx512;
+                state->crc11_fp_header    = crc11_fp_header_vaes_avx512;
+                state->crc7_fp_header     = crc7_fp_header_vaes_avx512;
+                state->crc10_iuup_data    = crc10_iuup_data_vaes_avx512;
+                state->crc6_iuup_header   = crc6_iuup_header_vaes_avx512;
+        }
+
         if ((state->features & IMB_FEATURE_VAES) == IMB_FEATURE_VAES) {
                 submit_job_aes_cntr_avx512 = vaes_submit_cntr_avx512;
                 submit_job_aes_cntr_bit_avx512 = vaes_submit_cntr_bit_avx512;
+                state->aes128_ecb_enc = aes_ecb_128_enc_vaes_avx512;
+                state->aes128_ecb_dec = aes_ecb_128_dec_vaes_avx512;
+                state->aes192_ecb_enc = aes_ecb_192_enc_vaes_avx512;
+                state->aes192_ecb_dec = aes_ecb_192_dec_vaes_avx512;
+                state->aes256_ecb_enc = aes_ecb_256_enc_vaes_avx512;
+                state->aes256_ecb_dec = aes_ecb_256_dec_vaes_avx512;
         }
 
         if ((state->features & (IMB_FEATURE_VAES | IMB_FEATURE_VPCLMULQDQ)) ==
@@ -1554,6 +1832,15 @@ init_mb_mgr_avx512(IMB_MGR *state)
                 state->gcm128_pre          = aes_gcm_pre_128_vaes_avx512;
                 state->gcm192_pre          = aes_gcm_pre_192_vaes_avx512;
                 state->gcm256_pre          = aes_gcm_pre_256_vaes_avx512;
+                state->gcm128_pre_n        = aes_gcm_pre_128_n_vaes_avx512;
+                state->gcm192_pre_n        = aes_gcm_pre_192_n_vaes_avx512;
+                state->gcm256_pre_n        = aes_gcm_pre_256_n_vaes_avx512;
+                state->gcm128_enc_n        = aes_gcm_enc_128_n_avx512;
+                state->gcm192_enc_n        = aes_gcm_enc_192_n_avx512;
+                state->gcm256_enc_n        = aes_gcm_enc_256_n_avx512;
+                state->gcm128_dec_n        = aes_gcm_dec_128_n_avx512;
+                state->gcm192_dec_n        = aes_gcm_dec_192_n_avx512;
+                state->gcm256_dec_n        = aes_gcm_dec_256_n_avx512;
                 state->ghash               = ghash_vaes_avx512;
 
                 submit_job_aes_gcm_enc_avx512 = vaes_submit_gcm_enc_avx512;
@@ -1599,6 +1886,15 @@ init_mb_mgr_avx512(IMB_MGR *state)
                 state->gcm128_pre          = aes_gcm_pre_128_avx512;
                 state->gcm192_pre          = aes_gcm_pre_192_avx512;
                 state->gcm256_pre          = aes_gcm_pre_256_avx512;
+                state->gcm128_pre_n        = aes_gcm_pre_128_n_avx512;
+                state->gcm192_pre_n        = aes_gcm_pre_192_n_avx512;
+                state->gcm256_pre_n        = aes_gcm_pre_256_n_avx512;
+                state->gcm128_enc_n        = aes_gcm_enc_128_n_avx512;
+                state->gcm192_enc_n        = aes_gcm_enc_192_n_avx512;
+                state->gcm256_enc_n        = aes_gcm_enc_256_n_avx512;
+                state->gcm128_dec_n        = aes_gcm_dec_128_n_avx512;
+                state->gcm192_dec_n        = aes_gcm_dec_192_n_avx512;
+                state->gcm256_dec_n        = aes_gcm_dec_256_n_avx512;
                 state->ghash               = ghash_avx512;
 
                 state->gmac128_init        = imb_aes_gmac_init_128_avx512;
@@ -1611,6 +1907,23 @@ init_mb_mgr_avx512(IMB_MGR *state)
                 state->gmac192_finalize    = imb_aes_gmac_finalize_192_avx512;
                 state->gmac256_finalize    = imb_aes_gmac_finalize_256_avx512;
         }
+
+        /*
+         * Compact GCM key data holds 8 hash key powers only,
+         * it runs on the AVX512 (non-VAES) kernels on all CPUs
+         */
+        state->gcm128_pre_compact = aes_gcm_pre_compact_128_avx512;
+        state->gcm192_pre_compact = aes_gcm_pre_compact_192_avx512;
+        state->gcm256_pre_compact = aes_gcm_pre_compact_256_avx512;
+        state->gcm128_expand_compact = aes_gcm_expand_compact_128_avx512;
+        state->gcm192_expand_compact = aes_gcm_expand_compact_192_avx512;
+        state->gcm256_expand_compact = aes_gcm_expand_compact_256_avx512;
+        state->gcm128_enc_compact = aes_gcm_enc_compact_128_avx512;
+        state->gcm192_enc_compact = aes_gcm_enc_compact_192_avx512;
+        state->gcm256_enc_compact = aes_gcm_enc_compact_256_avx512;
+        state->gcm128_dec_compact = aes_gcm_dec_compact_128_avx512;
+        state->gcm192_dec_compact = aes_gcm_dec_compact_192_avx512;
+        state->gcm256_dec_compact = aes_gcm_dec_compact_256_avx512;
 }
 
 #include "mb_mgr_code.h"
@@ -0,0 +1,401 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * VAES/VPCLMULQDQ stitched PON algorithm: AES128-CTR, CRC32 and BIP.
+ * Order of operations:
+ * - encrypt: HEC update (XGEM header), CRC32 (Ethernet FCS), AES-CTR and BIP
+ * - decrypt: BIP, AES-CTR and CRC32 (Ethernet FCS)
+ * The message is processed 256 bytes (16 blocks in 4 zmm) at a time,
+ * then 64 bytes at a time, with AES-CTR, CRC folding and BIP done
+ * on the same registers.
+ * Module needs to be compiled with VAES and VPCLMULQDQ enabled
+ * (OPT_VAES in Makefile).
+ */
+
+#define CRC_FOLD_ZMM
+#define CRC_FOLD_ONLY
+#include "include/crc_common.h"
+#include "include/asm.h"
+#include "include/clear_regs_mem.h"
+#include "include/wireless_common.h"
+
+#define PON_AES_ROUNDS 10
+
+/* 64-bit increments of 4 counter blocks */
+static const DECLARE_ALIGNED(uint64_t pon_ctr_inc[8], 64) = {
+        0, 0, 1, 0, 2, 0, 3, 0
+};
+
+/**
+ * @brief HEC update of the XGEM header (polynomial 0x53900000)
+ *
+ * @param hdr XGEM header in LE format
+ *
+ * @return XGEM header with updated HEC and parity bit, in LE format
+ */
+__forceinline
+uint64_t
+pon_hec_64(uint64_t hdr)
+{
+        const __m128i k3_q = _mm_set_epi64x(0x46b927ec, 0x7cc00000);
+        const __m128i p_res = _mm_set_epi64x(0, 0x53900000);
+        __m128i x, t;
+        uint64_t v;
+
+        /* 51 bits of the header without HEC, shifted left by 32 bits */
+        x = _mm_slli_si128(_mm_cvtsi64_si128((long long) (hdr >> 13)), 4);
+        hdr &= ~UINT64_C(0x1fff);
+
+        /* 128 to 64 bit reduction */
+        t = _mm_xor_si128(_mm_clmulepi64_si128(x, k3_q, 0x01), x);
+        t = _mm_clmulepi64_si128(t, k3_q, 0x01);
+        x = _mm_and_si128(_mm_xor_si128(t, x), _mm_set_epi64x(0, -1));
+
+        /* 64 to 32 bit reduction */
+        t = _mm_clmulepi64_si128(_mm_srli_si128(x, 4), k3_q, 0x10);
+        t = _mm_srli_si128(_mm_xor_si128(t, x), 4);
+        x = _mm_xor_si128(_mm_clmulepi64_si128(t, p_res, 0x00), x);
+
+        /* 12-bit CRC above the parity bit (bit 0) */
+        v = ((uint64_t) (uint32_t) _mm_cvtsi128_si32(x) >> 19) | hdr;
+
+        return v | (uint64_t) (_mm_popcnt_u64(v) & 1);
+}
+
+/**
+ * @brief Prepares 4 big endian counter blocks, from counter + 4 * i
+ *
+ * @param ctr 128-bit counter, in LE format
+ * @param i   index of the 4 blocks
+ */
+__forceinline
+__m512i
+pon_vaes_ctr_blocks(const __m128i ctr, const unsigned i)
+{
+        const __m512i base = _mm512_broadcast_i32x4(ctr);
+        const __m512i inc = _mm512_add_epi64(_mm512_load_si512(pon_ctr_inc),
+                                             _mm512_maskz_set1_epi64(0x55,
+                                                                     4 * i));
+        __m512i z = _mm512_add_epi64(base, inc);
+        /* carry from the low into the high 64 bits */
+        const __mmask8 carry =
+                _mm512_cmplt_epu64_mask(z, base) & 0x55;
+
+        z = _mm512_mask_add_epi64(z, (__mmask8) (carry << 1), z,
+                                  _mm512_set1_epi64(1));
+
+        return _mm512_shuffle_epi8(z, _mm512_broadcast_i32x4(
+                                           _mm_load_si128((const __m128i *)
+                                                          crc_bswap_tab)));
+}
+
+/**
+ * @brief Adds n to 128-bit counter in LE format
+ */
+__forceinline
+__m128i
+pon_vaes_ctr_add(const __m128i ctr, const uint64_t n)
+{
+        const __m128i x = _mm_add_epi64(ctr, _mm_cvtsi64_si128((long long) n));
+
+        if ((uint64_t) _mm_cvtsi128_si64(x) < n)
+                return _mm_add_epi64(x, _mm_set_epi64x(1, 0));
+
+        return x;
+}
+
+/**
+ * @brief Broadcasts round key <r> to all 4 lanes
+ */
+__forceinline
+__m512i
+pon_vaes_key(const void *keys, const unsigned r)
+{
+        return _mm512_broadcast_i32x4(_mm_loadu_si128(&((const __m128i *)
+                                                         keys)[r]));
+}
+
+/**
+ * @brief AES-CTR and BIP on n (1 to 4) x 64 bytes
+ *
+ * @param in   input text
+ * @param out  output text
+ * @param n    number of 64 byte blocks
+ * @param mask bytes to process in the last 64 byte block
+ * @param keys expanded AES-128 keys (NULL for no cipher)
+ * @param ctr  128-bit counter, in LE format (updated)
+ * @param bip  BIP state (updated)
+ * @param pt   plaintext of the processed blocks, for CRC
+ * @param enc  encrypt (1) or decrypt (0) direction
+ */
+__forceinline
+void
+pon_vaes_x16(const uint8_t *in, uint8_t *out, const unsigned n,
+             const __mmask64 mask, const void *keys, __m128i *ctr,
+             __m512i *bip, __m512i *pt, const int enc)
+{
+        __m512i t[4], c[4], k;
+        unsigned i, r;
+
+        for (i = 0; i < n; i++)
+                t[i] = _mm512_maskz_loadu_epi8(i == (n - 1) ? mask :
+                                               (__mmask64) -1, in + i * 64);
+
+        if (keys != NULL) {
+                for (i = 0; i < n; i++)
+                        c[i] = pon_vaes_ctr_blocks(*ctr, i);
+                *ctr = pon_vaes_ctr_add(*ctr, 4 * n);
+
+                k = pon_vaes_key(keys, 0);
+                for (i = 0; i < n; i++)
+                        c[i] = _mm512_xor_si512(c[i], k);
+                for (r = 1; r < PON_AES_ROUNDS; r++) {
+                        k = pon_vaes_key(keys, r);
+                        for (i = 0; i < n; i++)
+                                c[i] = _mm512_aesenc_epi128(c[i], k);
+                }
+                k = pon_vaes_key(keys, PON_AES_ROUNDS);
+                for (i = 0; i < n; i++)
+                        c[i] = _mm512_xor_si512(_mm512_aesenclast_epi128(c[i],
+                                                                         k),
+                                                t[i]);
+                /* keep bytes outside the message out of BIP */
+                c[n - 1] = _mm512_maskz_mov_epi8(mask, c[n - 1]);
+        } else {
+                for (i = 0; i < n; i++)
+                        c[i] = t[i];
+        }
+
+        for (i = 0; i < n; i++) {
+                _mm512_mask_storeu_epi8(out + i * 64,
+                                        i == (n - 1) ? mask : (__mmask64) -1,
+                                        c[i]);
+                /* BIP on cipher text, CRC on plain text */
+                *bip = _mm512_xor_si512(*bip, enc ? c[i] : t[i]);
+                pt[i] = enc ? t[i] : c[i];
+        }
+}
+
+/**
+ * @brief AES-CTR and BIP on the rest of the message
+ */
+__forceinline
+void
+pon_vaes_rest(const uint8_t *in, uint8_t *out, uint64_t len,
+              const void *keys, __m128i *ctr, __m512i *bip, const int enc)
+{
+        __m512i pt[4];
+
+        for (; len >= 256; len -= 256, in += 256, out += 256)
+                pon_vaes_x16(in, out, 4, (__mmask64) -1, keys, ctr, bip, pt,
+                             enc);
+
+        for (; len >= 64; len -= 64, in += 64, out += 64)
+                pon_vaes_x16(in, out, 1, (__mmask64) -1, keys, ctr, bip, pt,
+                             enc);
+
+        if (len != 0)
+                pon_vaes_x16(in, out, 1, (((__mmask64) 1) << len) - 1, keys,
+                             ctr, bip, pt, enc);
+}
+
+/**
+ * @brief PON stitched algorithm of AES128-CTR, CRC32 and BIP
+ *
+ * @param job job with PON cipher and hash
+ * @param enc encrypt (1) or decrypt (0) direction
+ * @param ctr AES-CTR (1) or no cipher (0)
+ *
+ * @return completed job
+ */
+__forceinline
+IMB_JOB *
+pon_vaes_avx512(IMB_JOB *job, const int enc, const int ctr)
+{
+        const struct crc32_fold_const *c = &crc32_ethernet_fcs_const;
+        uint8_t *hdr_ptr = (uint8_t *) (uintptr_t) job->src +
+                job->hash_start_src_offset_in_bytes;
+        uint8_t *in = (uint8_t *) (uintptr_t) job->src +
+                job->cipher_start_src_offset_in_bytes;
+        uint8_t *out = (uint8_t *) job->dst;
+        const void *keys = ctr ? job->enc_keys : NULL;
+        uint64_t hdr, pli, len, crc_len, n = 0;
+        __m128i counter = _mm_setzero_si128();
+        __m128i x;
+        __m512i bip, z[4], pt[4];
+        uint32_t *tag = (uint32_t *) job->auth_tag_output;
+        uint32_t fcs;
+
+        /* XGEM header (with HEC update on encrypt) starts BIP */
+        memcpy(&hdr, hdr_ptr, sizeof(hdr));
+        if (enc) {
+                hdr = BSWAP64(pon_hec_64(BSWAP64(hdr)));
+                memcpy(hdr_ptr, &hdr, sizeof(hdr));
+        }
+        bip = _mm512_zextsi128_si512(_mm_cvtsi64_si128((long long) hdr));
+
+        /* PLI = 14 most significant bits, payload includes 4 bytes of FCS */
+        pli = BSWAP64(hdr) >> 50;
+        crc_len = (pli > 4) ? (pli - 4) : 0;
+
+        if (ctr) {
+                len = job->msg_len_to_cipher_in_bytes;
+                counter = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)
+                                                           job->iv),
+                                           _mm_load_si128((const __m128i *)
+                                                          crc_bswap_tab));
+        } else {
+                len = job->msg_len_to_hash_in_bytes - 8;
+        }
+        if (crc_len > len)
+                crc_len = len;
+
+        /* stitched AES-CTR, CRC and BIP on full 64 byte blocks of FCS data */
+        if (crc_len >= 256) {
+                const __m512i k16 = _mm512_broadcast_i32x4(
+                        _mm_loadu_si128((const __m128i *) c->fold_16x128));
+
+                pon_vaes_x16(in, out, 4, (__mmask64) -1, keys, &counter,
+                             &bip, z, enc);
+                z[0] = _mm512_xor_si512(z[0], _mm512_zextsi128_si512(
+                                                _mm_cvtsi32_si128(-1)));
+                for (n = 256; (crc_len - n) >= 256; n += 256) {
+                        pon_vaes_x16(in + n, out + n, 4, (__mmask64) -1, keys,
+                                     &counter, &bip, pt, enc);
+                        z[0] = _mm512_xor_si512(crc_fold_zmm(z[0], k16, 1),
+                                                pt[0]);
+                        z[1] = _mm512_xor_si512(crc_fold_zmm(z[1], k16, 1),
+                                                pt[1]);
+                        z[2] = _mm512_xor_si512(crc_fold_zmm(z[2], k16, 1),
+                                                pt[2]);
+                        z[3] = _mm512_xor_si512(crc_fold_zmm(z[3], k16, 1),
+                                                pt[3]);
+                }
+        } else if (crc_len >= 64) {
+                pon_vaes_x16(in, out, 1, (__mmask64) -1, keys, &counter,
+                             &bip, z, enc);
+                z[0] = _mm512_xor_si512(z[0], _mm512_zextsi128_si512(
+                                                _mm_cvtsi32_si128(-1)));
+                n = 64;
+        }
+
+        if (n != 0) {
+                const __m512i k4 = _mm512_broadcast_i32x4(
+                        _mm_loadu_si128((const __m128i *) c->fold_4x128));
+                const __m128i k1 =
+                        _mm_load_si128((const __m128i *) c->fold_1x128);
+
+                if (n >= 256) {
+                        z[0] = _mm512_xor_si512(crc_fold_zmm(z[0], k4, 1),
+                                                z[1]);
+                        z[0] = _mm512_xor_si512(crc_fold_zmm(z[0], k4, 1),
+                                                z[2]);
+                        z[0] = _mm512_xor_si512(crc_fold_zmm(z[0], k4, 1),
+                                                z[3]);
+                }
+                for (; (crc_len - n) >= 64; n += 64) {
+                        pon_vaes_x16(in + n, out + n, 1, (__mmask64) -1, keys,
+                                     &counter, &bip, pt, enc);
+                        z[0] = _mm512_xor_si512(crc_fold_zmm(z[0], k4, 1),
+                                                pt[0]);
+                }
+
+                x = _mm512_castsi512_si128(z[0]);
+                x = _mm_xor_si128(crc_refl_fold(x, k1),
+                                  _mm512_extracti32x4_epi32(z[0], 1));
+                x = _mm_xor_si128(crc_refl_fold(x, k1),
+                                  _mm512_extracti32x4_epi32(z[0], 2));
+                x = _mm_xor_si128(crc_refl_fold(x, k1),
+                                  _mm512_extracti32x4_epi32(z[0], 3));
+        } else {
+                x = _mm_setzero_si128();
+        }
+
+        /*
+         * Less than 64 bytes of FCS data left:
+         * - encrypt: complete CRC and write FCS back, then cipher the rest
+         * - decrypt: cipher the rest, then complete CRC on the plain text
+         */
+        if (!enc)
+                pon_vaes_rest(in + n, out + n, len - n, keys, &counter, &bip,
+                              enc);
+
+        if (n != 0)
+                fcs = ~crc32_refl_finish(c, x, (enc ? in : out) + n,
+                                         crc_len - n);
+        else
+                fcs = ~crc32_refl_calc(c, 0xffffffff, enc ? in : out,
+                                       crc_len);
+
+        if (enc) {
+                if (pli > 4)
+                        memcpy(in + crc_len, &fcs, sizeof(fcs));
+                pon_vaes_rest(in + n, out + n, len - n, keys, &counter, &bip,
+                              enc);
+        }
+
+        /* BIP = XOR of all 32-bit words */
+        x = _mm_xor_si128(_mm512_castsi512_si128(bip),
+                          _mm512_extracti32x4_epi32(bip, 1));
+        x = _mm_xor_si128(x, _mm512_extracti32x4_epi32(bip, 2));
+        x = _mm_xor_si128(x, _mm512_extracti32x4_epi32(bip, 3));
+        x = _mm_xor_si128(x, _mm_srli_si128(x, 8));
+        x = _mm_xor_si128(x, _mm_srli_si128(x, 4));
+        tag[0] = (uint32_t) _mm_cvtsi128_si32(x);
+        tag[1] = fcs;
+
+#ifdef SAFE_DATA
+        clear_scratch_zmms();
+#endif
+        job->status |= STS_COMPLETED;
+        return job;
+}
+
+IMB_JOB *
+submit_job_pon_enc_vaes_avx512(IMB_JOB *job)
+{
+        return pon_vaes_avx512(job, 1, 1);
+}
+
+IMB_JOB *
+submit_job_pon_dec_vaes_avx512(IMB_JOB *job)
+{
+        return pon_vaes_avx512(job, 0, 1);
+}
+
+IMB_JOB *
+submit_job_pon_enc_no_ctr_vaes_avx512(IMB_JOB *job)
+{
+        return pon_vaes_avx512(job, 1, 0);
+}
+
+IMB_JOB *
+submit_job_pon_dec_no_ctr_vaes_avx512(IMB_JOB *job)
+{
+        return pon_vaes_avx512(job, 0, 0);
+}
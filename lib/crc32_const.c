@@ -0,0 +1,224 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include "include/crc.h"
+
+/*
+ * CRC folding constants (see include/crc.h).
+ * Polynomials are given without the top bit.
+ */
+
+/* CRC32 (Ethernet FCS): polynomial 0x04C11DB7, reflected */
+IMB_DLL_LOCAL const struct crc32_fold_const crc32_ethernet_fcs_const = {
+        {   /* fold_1x128 */
+                0x00000000ccaa009e, 0x00000001751997d0
+        },
+        {   /* fold_4x128 */
+                0x00000001c6e41596, 0x0000000154442bd4
+        },
+        {   /* reduce */
+                0x00000000ccaa009e, 0x0000000163cd6124
+        },
+        {   /* barrett */
+                0x00000001f7011640, 0x00000001db710640
+        },
+        {   /* fold_16x128 */
+                0x00000001322d1430, 0x000000011542778a
+        }
+};
+
+/* CRC32C (Castagnoli): polynomial 0x1EDC6F41, reflected */
+IMB_DLL_LOCAL const struct crc32_fold_const crc32_sctp_const = {
+        {   /* fold_1x128 */
+                0x000000014cd00bd6, 0x00000000f20c0dfe
+        },
+        {   /* fold_4x128 */
+                0x000000009e4addf8, 0x00000000740eef02
+        },
+        {   /* reduce */
+                0x000000014cd00bd6, 0x00000000dd45aab8
+        },
+        {   /* barrett */
+                0x00000000dea713f0, 0x0000000105ec76f0
+        },
+        {   /* fold_16x128 */
+                0x00000000b9e02b86, 0x00000000dcb17aa4
+        }
+};
+
+/* CRC16 CCITT/X.25: polynomial 0x1021, reflected */
+IMB_DLL_LOCAL const struct crc32_fold_const crc16_x25_const = {
+        {   /* fold_1x128 */
+                0x00000000000189ae, 0x0000000000008e10
+        },
+        {   /* fold_4x128 */
+                0x0000000000014ff2, 0x0000000000019a3c
+        },
+        {   /* reduce */
+                0x00000000000189ae, 0x00000000000114aa
+        },
+        {   /* barrett */
+                0x000000011c581910, 0x0000000000010810
+        },
+        {   /* fold_16x128 */
+                0x0000000000019208, 0x0000000000002df8
+        }
+};
+
+/* CRC24A (LTE/5G transport block): polynomial 0x864CFB, non-reflected */
+IMB_DLL_LOCAL const struct crc32_fold_const crc24_lte_a_const = {
+        {   /* fold_1x128 */
+                0x0000000064e4d700, 0x000000002c8c9d00
+        },
+        {   /* fold_4x128 */
+                0x00000000467d2400, 0x000000001f428700
+        },
+        {   /* reduce */
+                0x00000000fd7e0c00, 0x00000000d9fe8c00
+        },
+        {   /* barrett */
+                0x00000001f845fe24, 0x00000001864cfb00
+        },
+        {   /* fold_16x128 */
+                0x00000000a79dfd00, 0x0000000009e45400
+        }
+};
+
+/* CRC24B (LTE/5G code block): polynomial 0x800063, non-reflected */
+IMB_DLL_LOCAL const struct crc32_fold_const crc24_lte_b_const = {
+        {   /* fold_1x128 */
+                0x0000000080140500, 0x0000000042000100
+        },
+        {   /* fold_4x128 */
+                0x00000000a0660100, 0x00000000b5015b00
+        },
+        {   /* reduce */
+                0x0000000009000200, 0x0000000090042100
+        },
+        {   /* barrett */
+                0x00000001ffff83ff, 0x0000000180006300
+        },
+        {   /* fold_16x128 */
+                0x00000000427ce200, 0x00000000f4390500
+        }
+};
+
+/* CRC16 (FP data frame): polynomial 0x8005, non-reflected */
+IMB_DLL_LOCAL const struct crc32_fold_const crc16_fp_data_const = {
+        {   /* fold_1x128 */
+                0x00000000ff830000, 0x00000000f9130000
+        },
+        {   /* fold_4x128 */
+                0x00000000807d0000, 0x00000000f9e30000
+        },
+        {   /* reduce */
+                0x0000000086630000, 0x00000000807b0000
+        },
+        {   /* barrett */
+                0x00000001fffbffe7, 0x0000000180050000
+        },
+        {   /* fold_16x128 */
+                0x000000007f870000, 0x00000000fe630000
+        }
+};
+
+/* CRC11 (FP data frame header): polynomial 0x307, non-reflected */
+IMB_DLL_LOCAL const struct crc32_fold_const crc11_fp_header_const = {
+        {   /* fold_1x128 */
+                0x0000000004c00000, 0x00000000a0800000
+        },
+        {   /* fold_4x128 */
+                0x000000007c000000, 0x0000000051c00000
+        },
+        {   /* reduce */
+                0x00000000e1400000, 0x0000000061000000
+        },
+        {   /* barrett */
+                0x000000017208e3d8, 0x0000000160e00000
+        },
+        {   /* fold_16x128 */
+                0x00000000cda00000, 0x00000000e4e00000
+        }
+};
+
+/* CRC7 (FP control frame header): polynomial 0x45, non-reflected */
+IMB_DLL_LOCAL const struct crc32_fold_const crc7_fp_header_const = {
+        {   /* fold_1x128 */
+                0x000000005e000000, 0x00000000bc000000
+        },
+        {   /* fold_4x128 */
+                0x0000000064000000, 0x00000000c8000000
+        },
+        {   /* reduce */
+                0x000000009e000000, 0x00000000ea000000
+        },
+        {   /* barrett */
+                0x00000001f79d6171, 0x000000018a000000
+        },
+        {   /* fold_16x128 */
+                0x000000008a000000, 0x000000009e000000
+        }
+};
+
+/* CRC10 (IuUP payload): polynomial 0x233, non-reflected */
+IMB_DLL_LOCAL const struct crc32_fold_const crc10_iuup_data_const = {
+        {   /* fold_1x128 */
+                0x00000000fb000000, 0x0000000092c00000
+        },
+        {   /* fold_4x128 */
+                0x00000000dac00000, 0x00000000e8400000
+        },
+        {   /* reduce */
+                0x00000000a8000000, 0x00000000b2400000
+        },
+        {   /* barrett */
+                0x00000001f083a337, 0x000000018cc00000
+        },
+        {   /* fold_16x128 */
+                0x00000000e5000000, 0x00000000fdc00000
+        }
+};
+
+/* CRC6 (IuUP header): polynomial 0x2F, non-reflected */
+IMB_DLL_LOCAL const struct crc32_fold_const crc6_iuup_header_const = {
+        {   /* fold_1x128 */
+                0x0000000068000000, 0x000000001c000000
+        },
+        {   /* fold_4x128 */
+                0x00000000f4000000, 0x00000000a8000000
+        },
+        {   /* reduce */
+                0x0000000034000000, 0x00000000c4000000
+        },
+        {   /* barrett */
+                0x00000001c8af6983, 0x00000001bc000000
+        },
+        {   /* fold_16x128 */
+                0x00000000c4000000, 0x0000000068000000
+        }
+};
+
@@ -0,0 +1,476 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*-----------------------------------------------------------------------
+ * Stitched AES-CCM (CTR + CBC-MAC) out-of-order manager.
+ *
+ * Each lane goes through the following stages:
+ * - B0 and AAD blocks (CBC-MAC only)
+ * - full message blocks (CTR and CBC-MAC in one pass)
+ * - partial message block (CTR in C, CBC-MAC of the padded block)
+ * The multi-lane routine carries the keystream of the next block,
+ * so the counter of the first lane stage is set such that the keystream
+ * is E(ctr1) when the message starts.
+ *
+ * The including file must define:
+ * - SUBMIT_JOB_AES128_CCM_CTR_MAC, FLUSH_JOB_AES128_CCM_CTR_MAC,
+ *   SUBMIT_JOB_AES256_CCM_CTR_MAC, FLUSH_JOB_AES256_CCM_CTR_MAC
+ * - CLEAR_SCRATCH_SIMD_REGS
+ *-----------------------------------------------------------------------*/
+
+#ifndef AES_CCM_CTR_MAC_COMMON_H
+#define AES_CCM_CTR_MAC_COMMON_H
+
+#include <stdint.h>
+#include <string.h>
+#ifdef LINUX
+#include <x86intrin.h>
+#else
+#include <intrin.h>
+#endif
+
+#include "intel-ipsec-mb.h"
+#include "include/ipsec_ooo_mgr.h"
+#include "include/clear_regs_mem.h"
+
+#define CCM_NUM_LANES   4
+#define CCM_BLOCK_SIZE  16
+
+/* Lane stages */
+#define CCM_STAGE_B0_AAD  0
+#define CCM_STAGE_MSG     1
+#define CCM_STAGE_PARTIAL 2
+#define CCM_STAGE_DONE    3
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES128_CCM_CTR_MAC(MB_MGR_CCM_CTR_MAC_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES128_CCM_CTR_MAC(MB_MGR_CCM_CTR_MAC_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES256_CCM_CTR_MAC(MB_MGR_CCM_CTR_MAC_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES256_CCM_CTR_MAC(MB_MGR_CCM_CTR_MAC_OOO *state);
+
+/*
+ * Increments the 32-bit big endian counter in the last 4 bytes of a block
+ */
+__forceinline
+void
+aes_ccm_ctr_inc(imb_uint128_t *ctr)
+{
+        uint8_t *c = (uint8_t *) ctr;
+        uint32_t v = ((uint32_t) c[12] << 24) | ((uint32_t) c[13] << 16) |
+                ((uint32_t) c[14] << 8) | c[15];
+
+        v++;
+        c[12] = (uint8_t) (v >> 24);
+        c[13] = (uint8_t) (v >> 16);
+        c[14] = (uint8_t) (v >> 8);
+        c[15] = (uint8_t) v;
+}
+
+/**
+ * @brief Stitched AES-CTR and AES-CBC-MAC of CCM_NUM_LANES lanes
+ *
+ * Each 16-byte block consumes the keystream computed for the previous one:
+ * - out = in XOR ks
+ * - MAC = AES(MAC XOR in XOR (ks AND dec_mask))
+ * - ks = AES(ctr), ctr = ctr + 1
+ * dec_mask is all 1's for decryption (MAC over the output), 0 otherwise.
+ * Input of all lanes is read before any output is written, so in-place
+ * operation and lanes sharing buffers are supported.
+ *
+ * @param args    lane arguments, pointers are advanced by \a len
+ * @param len     number of bytes to process (multiple of 16)
+ * @param nrounds number of AES rounds
+ */
+__forceinline
+void
+aes_ccm_x4(AES_CCM_ARGS_x4 *args, const uint64_t len, const unsigned nrounds)
+{
+        const uint8_t *in[CCM_NUM_LANES];
+        const __m128i *keys[CCM_NUM_LANES];
+        __m128i mac[CCM_NUM_LANES];
+        __m128i ks[CCM_NUM_LANES];
+        __m128i data[CCM_NUM_LANES];
+        uint64_t off;
+        unsigned i, r;
+
+        for (i = 0; i < CCM_NUM_LANES; i++) {
+                in[i] = args->in[i];
+                keys[i] = (const __m128i *) args->keys[i];
+                mac[i] = _mm_load_si128((const __m128i *) &args->mac[i]);
+                ks[i] = _mm_load_si128((const __m128i *) &args->ks[i]);
+        }
+
+        for (off = 0; off < len; off += CCM_BLOCK_SIZE) {
+                for (i = 0; i < CCM_NUM_LANES; i++)
+                        data[i] = _mm_loadu_si128((const __m128i *)
+                                                  &in[i][off]);
+
+                for (i = 0; i < CCM_NUM_LANES; i++) {
+                        const __m128i mask = _mm_load_si128(
+                                (const __m128i *) &args->dec_mask[i]);
+
+                        mac[i] = _mm_xor_si128(mac[i], data[i]);
+                        mac[i] = _mm_xor_si128(mac[i],
+                                               _mm_and_si128(ks[i], mask));
+                        _mm_storeu_si128((__m128i *) &args->out[i][off],
+                                         _mm_xor_si128(ks[i], data[i]));
+
+                        ks[i] = _mm_load_si128((const __m128i *)
+                                               &args->ctr[i]);
+                        aes_ccm_ctr_inc(&args->ctr[i]);
+                }
+
+                for (i = 0; i < CCM_NUM_LANES; i++) {
+                        const __m128i k = _mm_loadu_si128(&keys[i][0]);
+
+                        mac[i] = _mm_xor_si128(mac[i], k);
+                        ks[i] = _mm_xor_si128(ks[i], k);
+                }
+
+                for (r = 1; r < nrounds; r++)
+                        for (i = 0; i < CCM_NUM_LANES; i++) {
+                                const __m128i k =
+                                        _mm_loadu_si128(&keys[i][r]);
+
+                                mac[i] = _mm_aesenc_si128(mac[i], k);
+                                ks[i] = _mm_aesenc_si128(ks[i], k);
+                        }
+
+                for (i = 0; i < CCM_NUM_LANES; i++) {
+                        const __m128i k = _mm_loadu_si128(&keys[i][nrounds]);
+
+                        mac[i] = _mm_aesenclast_si128(mac[i], k);
+                        ks[i] = _mm_aesenclast_si128(ks[i], k);
+                }
+        }
+
+        for (i = 0; i < CCM_NUM_LANES; i++) {
+                _mm_store_si128((__m128i *) &args->mac[i], mac[i]);
+                _mm_store_si128((__m128i *) &args->ks[i], ks[i]);
+                args->in[i] = in[i] + len;
+                args->out[i] += len;
+        }
+}
+
+/* AES encryption of a single block */
+__forceinline
+__m128i
+aes_ccm_enc_block(const void *in, const void *keys, const unsigned nrounds)
+{
+        const __m128i *k = (const __m128i *) keys;
+        __m128i b = _mm_loadu_si128((const __m128i *) in);
+        unsigned r;
+
+        b = _mm_xor_si128(b, _mm_loadu_si128(&k[0]));
+        for (r = 1; r < nrounds; r++)
+                b = _mm_aesenc_si128(b, _mm_loadu_si128(&k[r]));
+
+        return _mm_aesenclast_si128(b, _mm_loadu_si128(&k[nrounds]));
+}
+
+/*
+ * Prepares B0, AAD blocks and counter blocks of a lane.
+ * Returns length of the B0/AAD stage in bytes.
+ */
+static inline uint32_t
+aes_ccm_init_lane(MB_MGR_CCM_CTR_MAC_OOO *state, const unsigned lane,
+                  const IMB_JOB *job)
+{
+        uint8_t *b0 = &state->init_blocks[lane * 4 * CCM_BLOCK_SIZE];
+        uint8_t *ctr0 = (uint8_t *) &state->ctr0[lane];
+        uint8_t *ctr = (uint8_t *) &state->args.ctr[lane];
+        const uint64_t nonce_len = job->iv_len_in_bytes;
+        const uint64_t aad_len = job->u.CCM.aad_len_in_bytes;
+        uint64_t msg_len = job->msg_len_to_cipher_in_bytes;
+        uint32_t num_blocks = 1;
+        uint32_t c;
+        unsigned i;
+
+        memset(b0, 0, 4 * CCM_BLOCK_SIZE);
+
+        /* B0: flags | nonce | message length */
+        b0[0] = (uint8_t) (((job->auth_tag_output_len_in_bytes - 2) / 2) << 3);
+        b0[0] |= (uint8_t) (14 - nonce_len);
+        memcpy(&b0[1], job->iv, nonce_len);
+        for (i = CCM_BLOCK_SIZE - 1; i > nonce_len; i--) {
+                b0[i] = (uint8_t) msg_len;
+                msg_len >>= 8;
+        }
+
+        /* AAD blocks: AAD length (2 bytes) | AAD | zero padding */
+        if (aad_len != 0) {
+                b0[0] |= 0x40;
+                b0[CCM_BLOCK_SIZE] = (uint8_t) (aad_len >> 8);
+                b0[CCM_BLOCK_SIZE + 1] = (uint8_t) aad_len;
+                memcpy(&b0[CCM_BLOCK_SIZE + 2], job->u.CCM.aad, aad_len);
+                num_blocks += (uint32_t) ((aad_len + 2 + CCM_BLOCK_SIZE - 1) /
+                                          CCM_BLOCK_SIZE);
+        }
+
+        /* ctr0: flags | nonce | 0 (used to encrypt the tag) */
+        memset(ctr0, 0, CCM_BLOCK_SIZE);
+        ctr0[0] = (uint8_t) (14 - nonce_len);
+        memcpy(&ctr0[1], job->iv, nonce_len);
+
+        /*
+         * Keystream is produced one block ahead of the data,
+         * so after num_blocks B0/AAD blocks it has to be E(ctr1).
+         * The 32-bit counter may include nonce bytes (nonce_len > 11),
+         * borrow from them is restored by the time ctr1 is reached.
+         */
+        memcpy(ctr, ctr0, CCM_BLOCK_SIZE);
+        c = ((uint32_t) ctr[12] << 24) | ((uint32_t) ctr[13] << 16) |
+                ((uint32_t) ctr[14] << 8) | ctr[15];
+        c += 2 - num_blocks;
+        ctr[12] = (uint8_t) (c >> 24);
+        ctr[13] = (uint8_t) (c >> 16);
+        ctr[14] = (uint8_t) (c >> 8);
+        ctr[15] = (uint8_t) c;
+
+        return num_blocks * CCM_BLOCK_SIZE;
+}
+
+/* Computes the authentication tag of a lane */
+static inline void
+aes_ccm_final_lane(MB_MGR_CCM_CTR_MAC_OOO *state, const unsigned lane,
+                   IMB_JOB *job, const unsigned nrounds)
+{
+        DECLARE_ALIGNED(uint8_t tag[CCM_BLOCK_SIZE], 16);
+        const __m128i mac =
+                _mm_load_si128((const __m128i *) &state->args.mac[lane]);
+
+        _mm_store_si128((__m128i *) tag,
+                        _mm_xor_si128(aes_ccm_enc_block(&state->ctr0[lane],
+                                                        job->enc_keys,
+                                                        nrounds), mac));
+
+        memcpy(job->auth_tag_output, tag,
+               job->auth_tag_output_len_in_bytes);
+
+#ifdef SAFE_DATA
+        clear_mem(tag, sizeof(tag));
+        clear_mem(&state->args.mac[lane], sizeof(state->args.mac[lane]));
+        clear_mem(&state->args.ks[lane], sizeof(state->args.ks[lane]));
+        clear_mem(&state->args.ctr[lane], sizeof(state->args.ctr[lane]));
+        clear_mem(&state->ctr0[lane], sizeof(state->ctr0[lane]));
+        clear_mem(&state->init_blocks[lane * 4 * CCM_BLOCK_SIZE],
+                  4 * CCM_BLOCK_SIZE);
+#endif
+}
+
+/* Moves a lane to its next stage with data left to process */
+static inline void
+aes_ccm_next_stage(MB_MGR_CCM_CTR_MAC_OOO *state, const unsigned lane,
+                   const unsigned nrounds)
+{
+        IMB_JOB *job = state->job_in_lane[lane];
+        const uint32_t msg_len = (uint32_t) job->msg_len_to_cipher_in_bytes;
+        const uint32_t partial = msg_len & (CCM_BLOCK_SIZE - 1);
+
+        if (state->stage[lane] == CCM_STAGE_B0_AAD) {
+                state->stage[lane] = CCM_STAGE_MSG;
+                state->args.in[lane] = job->src +
+                        job->cipher_start_src_offset_in_bytes;
+                state->args.out[lane] = job->dst;
+                memset(&state->args.dec_mask[lane],
+                       (job->cipher_direction == IMB_DIR_DECRYPT) ? 0xff : 0,
+                       sizeof(state->args.dec_mask[lane]));
+                state->lens[lane] = msg_len - partial;
+                if (state->lens[lane] != 0)
+                        return;
+        }
+
+        if (state->stage[lane] == CCM_STAGE_MSG && partial != 0) {
+                uint8_t *block = &state->init_blocks[lane * 4 *
+                                                     CCM_BLOCK_SIZE];
+                const uint8_t *ks = (const uint8_t *) &state->args.ks[lane];
+                const uint8_t *in = state->args.in[lane];
+                uint8_t *out = state->args.out[lane];
+                unsigned i;
+
+                /* CTR on the last bytes, CBC-MAC over the padded plaintext */
+                memset(block, 0, CCM_BLOCK_SIZE);
+                for (i = 0; i < partial; i++) {
+                        const uint8_t c = in[i];
+
+                        out[i] = c ^ ks[i];
+                        block[i] = (job->cipher_direction ==
+                                    IMB_DIR_DECRYPT) ? out[i] : c;
+                }
+
+                state->stage[lane] = CCM_STAGE_PARTIAL;
+                state->args.in[lane] = block;
+                state->args.out[lane] = block;
+                memset(&state->args.dec_mask[lane], 0,
+                       sizeof(state->args.dec_mask[lane]));
+                state->lens[lane] = CCM_BLOCK_SIZE;
+                return;
+        }
+
+        aes_ccm_final_lane(state, lane, job, nrounds);
+        state->stage[lane] = CCM_STAGE_DONE;
+}
+
+static inline IMB_JOB *
+aes_ccm_return_lane(MB_MGR_CCM_CTR_MAC_OOO *state, const unsigned lane)
+{
+        IMB_JOB *job = state->job_in_lane[lane];
+
+        state->num_lanes_inuse--;
+        state->job_in_lane[lane] = NULL;
+        state->lens[lane] = 0xFFFF;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        job->status |= STS_COMPLETED;
+
+        return job;
+}
+
+/*
+ * Runs the multi-lane routine until one of the jobs is completed.
+ * Lanes with no job are given a copy of a valid lane.
+ */
+static inline IMB_JOB *
+aes_ccm_process_lanes(MB_MGR_CCM_CTR_MAC_OOO *state,
+                      const unsigned nrounds)
+{
+        unsigned i, idx;
+
+        while (1) {
+                uint32_t min_len = UINT32_MAX;
+
+                idx = CCM_NUM_LANES;
+                for (i = 0; i < CCM_NUM_LANES; i++) {
+                        if (state->job_in_lane[i] == NULL)
+                                continue;
+                        if (state->stage[i] == CCM_STAGE_DONE)
+                                return aes_ccm_return_lane(state, i);
+                        if (state->lens[i] < min_len)
+                                min_len = state->lens[i];
+                        idx = i;
+                }
+
+                /* Copy good lane data into empty lanes */
+                for (i = 0; i < CCM_NUM_LANES; i++) {
+                        if (state->job_in_lane[i] != NULL)
+                                continue;
+
+                        state->args.in[i] = state->args.in[idx];
+                        state->args.out[i] = state->args.out[idx];
+                        state->args.keys[i] = state->args.keys[idx];
+                        state->args.mac[i] = state->args.mac[idx];
+                        state->args.ctr[i] = state->args.ctr[idx];
+                        state->args.ks[i] = state->args.ks[idx];
+                        state->args.dec_mask[i] = state->args.dec_mask[idx];
+                }
+
+                aes_ccm_x4(&state->args, min_len, nrounds);
+
+                for (i = 0; i < CCM_NUM_LANES; i++) {
+                        if (state->job_in_lane[i] == NULL)
+                                continue;
+                        state->lens[i] -= min_len;
+                        if (state->lens[i] == 0)
+                                aes_ccm_next_stage(state, i, nrounds);
+                }
+        }
+}
+
+static inline IMB_JOB *
+submit_job_aes_ccm_ctr_mac(MB_MGR_CCM_CTR_MAC_OOO *state, IMB_JOB *job,
+                           const unsigned nrounds)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+        IMB_JOB *ret;
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+
+        state->args.in[lane] = &state->init_blocks[lane * 4 * CCM_BLOCK_SIZE];
+        state->args.out[lane] = &state->init_blocks[lane * 4 * CCM_BLOCK_SIZE];
+        state->args.keys[lane] = job->enc_keys;
+        memset(&state->args.mac[lane], 0, sizeof(state->args.mac[lane]));
+        memset(&state->args.ks[lane], 0, sizeof(state->args.ks[lane]));
+        memset(&state->args.dec_mask[lane], 0,
+               sizeof(state->args.dec_mask[lane]));
+        state->lens[lane] = aes_ccm_init_lane(state, lane, job);
+        state->stage[lane] = CCM_STAGE_B0_AAD;
+
+        if (state->num_lanes_inuse != CCM_NUM_LANES)
+                return NULL;
+
+        ret = aes_ccm_process_lanes(state, nrounds);
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+        return ret;
+}
+
+static inline IMB_JOB *
+flush_job_aes_ccm_ctr_mac(MB_MGR_CCM_CTR_MAC_OOO *state,
+                          const unsigned nrounds)
+{
+        IMB_JOB *ret;
+
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        ret = aes_ccm_process_lanes(state, nrounds);
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+        return ret;
+}
+
+IMB_JOB *
+SUBMIT_JOB_AES128_CCM_CTR_MAC(MB_MGR_CCM_CTR_MAC_OOO *state, IMB_JOB *job)
+{
+        return submit_job_aes_ccm_ctr_mac(state, job, 10);
+}
+
+IMB_JOB *
+FLUSH_JOB_AES128_CCM_CTR_MAC(MB_MGR_CCM_CTR_MAC_OOO *state)
+{
+        return flush_job_aes_ccm_ctr_mac(state, 10);
+}
+
+IMB_JOB *
+SUBMIT_JOB_AES256_CCM_CTR_MAC(MB_MGR_CCM_CTR_MAC_OOO *state, IMB_JOB *job)
+{
+        return submit_job_aes_ccm_ctr_mac(state, job, 14);
+}
+
+IMB_JOB *
+FLUSH_JOB_AES256_CCM_CTR_MAC(MB_MGR_CCM_CTR_MAC_OOO *state)
+{
+        return flush_job_aes_ccm_ctr_mac(state, 14);
+}
+
+#endif /* AES_CCM_CTR_MAC_COMMON_H */
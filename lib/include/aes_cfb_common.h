@@ -0,0 +1,471 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*-----------------------------------------------------------------------
+ * AES-CFB128 (full message) encryption and decryption of complete blocks.
+ *
+ * Encryption is serial within a message, so it is done by an out-of-order
+ * manager that encrypts one block of each lane per iteration of the
+ * multi-lane routine (AES_CFB_NUM_LANES lanes).
+ * Decryption is parallel within a message: 8 blocks are decrypted at a time
+ * (16 with AES_CFB_VAES) and the remaining 1 to 7 blocks in parallel too.
+ * The partial last block (if any) is left to the caller.
+ *
+ * The including file must define:
+ * - AES_CFB_NUM_LANES (up to 16) and SUBMIT_JOB_AES128_CFB_ENC,
+ *   FLUSH_JOB_AES128_CFB_ENC, SUBMIT_JOB_AES256_CFB_ENC,
+ *   FLUSH_JOB_AES256_CFB_ENC, unless the module only decrypts
+ * - AES_CFB_DEC_128, AES_CFB_DEC_256
+ * - CLEAR_SCRATCH_SIMD_REGS
+ * - AES_CFB_VAES, to decrypt 16 blocks at a time in 4 ZMM registers
+ *   first (module compiled with VAES enabled)
+ *-----------------------------------------------------------------------*/
+
+#ifndef AES_CFB_COMMON_H
+#define AES_CFB_COMMON_H
+
+#include <stdint.h>
+#include <string.h>
+#ifdef LINUX
+#include <x86intrin.h>
+#else
+#include <intrin.h>
+#endif
+
+#include "intel-ipsec-mb.h"
+#include "include/ipsec_ooo_mgr.h"
+#include "include/clear_regs_mem.h"
+
+#define AES_CFB_BLOCK 16
+
+#ifdef SUBMIT_JOB_AES128_CFB_ENC
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES128_CFB_ENC(MB_MGR_AES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES128_CFB_ENC(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_AES256_CFB_ENC(MB_MGR_AES_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_AES256_CFB_ENC(MB_MGR_AES_OOO *state);
+#endif
+IMB_DLL_LOCAL void
+AES_CFB_DEC_128(const void *in, const uint8_t *IV, const void *keys,
+                void *out, uint64_t len_bytes);
+IMB_DLL_LOCAL void
+AES_CFB_DEC_256(const void *in, const uint8_t *IV, const void *keys,
+                void *out, uint64_t len_bytes);
+
+#ifdef SUBMIT_JOB_AES128_CFB_ENC
+/**
+ * @brief AES-CFB128 encryption of AES_CFB_NUM_LANES lanes
+ *
+ * For each lane, \a len bytes are encrypted from args->in to args->out.
+ * All plain text blocks of an iteration are loaded before cipher text
+ * is stored, so that lanes sharing a buffer (in place) are safe.
+ *
+ * @param args    lane arguments, pointers are advanced by \a len
+ * @param len     number of bytes to process (multiple of 16)
+ * @param nrounds number of AES rounds
+ */
+__forceinline
+void
+aes_cfb_enc_xn(AES_ARGS *args, const uint64_t len, const unsigned nrounds)
+{
+        const __m128i *keys[AES_CFB_NUM_LANES];
+        __m128i iv[AES_CFB_NUM_LANES];
+        __m128i p[AES_CFB_NUM_LANES];
+        uint64_t off;
+        unsigned i, r;
+
+        for (i = 0; i < AES_CFB_NUM_LANES; i++) {
+                keys[i] = (const __m128i *) args->keys[i];
+                iv[i] = _mm_load_si128((const __m128i *) &args->IV[i]);
+        }
+
+        for (off = 0; off < len; off += AES_CFB_BLOCK) {
+                for (i = 0; i < AES_CFB_NUM_LANES; i++) {
+                        p[i] = _mm_loadu_si128((const __m128i *)
+                                               &args->in[i][off]);
+                        iv[i] = _mm_xor_si128(iv[i],
+                                              _mm_loadu_si128(&keys[i][0]));
+                }
+
+                for (r = 1; r < nrounds; r++)
+                        for (i = 0; i < AES_CFB_NUM_LANES; i++)
+                                iv[i] = _mm_aesenc_si128(
+                                        iv[i], _mm_loadu_si128(&keys[i][r]));
+
+                for (i = 0; i < AES_CFB_NUM_LANES; i++) {
+                        iv[i] = _mm_aesenclast_si128(
+                                iv[i], _mm_loadu_si128(&keys[i][nrounds]));
+                        iv[i] = _mm_xor_si128(iv[i], p[i]);
+                        _mm_storeu_si128((__m128i *) &args->out[i][off],
+                                         iv[i]);
+                }
+        }
+
+        for (i = 0; i < AES_CFB_NUM_LANES; i++) {
+                _mm_store_si128((__m128i *) &args->IV[i], iv[i]);
+                args->in[i] += len;
+                args->out[i] += len;
+        }
+}
+
+/*
+ * Number of bytes of complete blocks left to encrypt in a lane
+ */
+__forceinline
+uint64_t
+aes_cfb_lane_len(const MB_MGR_AES_OOO *state, const unsigned lane)
+{
+        const IMB_JOB *job = state->job_in_lane[lane];
+        const uint8_t *end = job->src + job->cipher_start_src_offset_in_bytes +
+                (job->msg_len_to_cipher_in_bytes &
+                 (~(uint64_t) (AES_CFB_BLOCK - 1)));
+
+        return (uint64_t) (end - state->args.in[lane]);
+}
+
+static inline IMB_JOB *
+aes_cfb_return_lane(MB_MGR_AES_OOO *state, const unsigned lane)
+{
+        IMB_JOB *job = state->job_in_lane[lane];
+
+        state->num_lanes_inuse--;
+        state->job_in_lane[lane] = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        job->status |= STS_COMPLETED_AES;
+
+#ifdef SAFE_DATA
+        clear_mem(&state->args.IV[lane], sizeof(state->args.IV[lane]));
+#endif
+        return job;
+}
+
+/*
+ * Runs the multi-lane routine until one of the jobs is completed.
+ * Lanes with no job are given a copy of a valid lane.
+ */
+static inline IMB_JOB *
+aes_cfb_process_lanes(MB_MGR_AES_OOO *state, const unsigned nrounds)
+{
+        unsigned i, idx;
+
+        while (1) {
+                uint64_t min_len = UINT64_MAX;
+
+                idx = AES_CFB_NUM_LANES;
+                for (i = 0; i < AES_CFB_NUM_LANES; i++) {
+                        uint64_t len;
+
+                        if (state->job_in_lane[i] == NULL)
+                                continue;
+                        len = aes_cfb_lane_len(state, i);
+                        if (len == 0)
+                                return aes_cfb_return_lane(state, i);
+                        if (len < min_len)
+                                min_len = len;
+                        idx = i;
+                }
+
+                /* Copy good lane data into empty lanes */
+                for (i = 0; i < AES_CFB_NUM_LANES; i++) {
+                        if (state->job_in_lane[i] != NULL)
+                                continue;
+
+                        state->args.in[i] = state->args.in[idx];
+                        state->args.out[i] = state->args.out[idx];
+                        state->args.keys[i] = state->args.keys[idx];
+                        state->args.IV[i] = state->args.IV[idx];
+                }
+
+                aes_cfb_enc_xn(&state->args, min_len, nrounds);
+        }
+}
+
+/*
+ * Submits AES-CFB encrypt job with at least one complete block.
+ * The partial last block (if any) is left to the caller.
+ */
+static inline IMB_JOB *
+submit_job_aes_cfb_enc(MB_MGR_AES_OOO *state, IMB_JOB *job,
+                       const unsigned nrounds)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+        IMB_JOB *ret;
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+
+        state->args.in[lane] = job->src + job->cipher_start_src_offset_in_bytes;
+        state->args.out[lane] = job->dst;
+        state->args.keys[lane] = job->enc_keys;
+        memcpy(&state->args.IV[lane], job->iv, AES_CFB_BLOCK);
+
+        if (state->num_lanes_inuse != AES_CFB_NUM_LANES)
+                return NULL;
+
+        ret = aes_cfb_process_lanes(state, nrounds);
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+        return ret;
+}
+
+static inline IMB_JOB *
+flush_job_aes_cfb_enc(MB_MGR_AES_OOO *state, const unsigned nrounds)
+{
+        IMB_JOB *ret;
+
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        ret = aes_cfb_process_lanes(state, nrounds);
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+        return ret;
+}
+
+IMB_JOB *
+SUBMIT_JOB_AES128_CFB_ENC(MB_MGR_AES_OOO *state, IMB_JOB *job)
+{
+        return submit_job_aes_cfb_enc(state, job, 10);
+}
+
+IMB_JOB *
+FLUSH_JOB_AES128_CFB_ENC(MB_MGR_AES_OOO *state)
+{
+        return flush_job_aes_cfb_enc(state, 10);
+}
+
+IMB_JOB *
+SUBMIT_JOB_AES256_CFB_ENC(MB_MGR_AES_OOO *state, IMB_JOB *job)
+{
+        return submit_job_aes_cfb_enc(state, job, 14);
+}
+
+IMB_JOB *
+FLUSH_JOB_AES256_CFB_ENC(MB_MGR_AES_OOO *state)
+{
+        return flush_job_aes_cfb_enc(state, 14);
+}
+#endif /* SUBMIT_JOB_AES128_CFB_ENC */
+
+/**
+ * @brief AES-CFB128 decryption of n blocks in parallel
+ *
+ * Block cipher input is the previous cipher text block (or IV)
+ * followed by (n - 1) cipher text blocks.
+ * All cipher text blocks are loaded before plain text is stored,
+ * so in place operation is safe.
+ *
+ * @param c       cipher text blocks
+ * @param o       plain text blocks
+ * @param k       expanded encryption keys
+ * @param prev    cipher text block preceding \a c (or IV)
+ * @param n       number of blocks (1 to 8, constant)
+ * @param nrounds number of AES rounds
+ * @return last cipher text block
+ */
+__forceinline
+__m128i
+aes_cfb_dec_by_n(const __m128i *c, __m128i *o, const __m128i *k,
+                 const __m128i prev, const unsigned n, const unsigned nrounds)
+{
+        const __m128i key0 = _mm_loadu_si128(&k[0]);
+        __m128i ct[8], b[8];
+        __m128i key_last;
+        unsigned i, r;
+
+        for (i = 0; i < n; i++)
+                ct[i] = _mm_loadu_si128(&c[i]);
+
+        b[0] = _mm_xor_si128(prev, key0);
+        for (i = 1; i < n; i++)
+                b[i] = _mm_xor_si128(ct[i - 1], key0);
+
+        for (r = 1; r < nrounds; r++) {
+                const __m128i key = _mm_loadu_si128(&k[r]);
+
+                for (i = 0; i < n; i++)
+                        b[i] = _mm_aesenc_si128(b[i], key);
+        }
+
+        key_last = _mm_loadu_si128(&k[nrounds]);
+        for (i = 0; i < n; i++) {
+                b[i] = _mm_aesenclast_si128(b[i], key_last);
+                _mm_storeu_si128(&o[i], _mm_xor_si128(b[i], ct[i]));
+        }
+
+        return ct[n - 1];
+}
+
+#ifdef AES_CFB_VAES
+/**
+ * @brief AES-CFB128 decryption, 16 blocks at a time (4 blocks per ZMM)
+ *
+ * Block cipher input is built with VALIGNQ from the loaded cipher text
+ * and the previous cipher text block (or IV) kept in 128-bit lane 3.
+ *
+ * @param c          cipher text blocks
+ * @param o          plain text blocks
+ * @param k          expanded encryption keys
+ * @param prev       cipher text block preceding \a c (or IV) on input and
+ *                   last processed cipher text block on output
+ * @param num_blocks number of blocks available
+ * @param nrounds    number of AES rounds
+ * @return number of blocks processed (multiple of 16)
+ */
+__forceinline
+uint64_t
+aes_cfb_dec_by16_vaes(const __m128i *c, __m128i *o, const __m128i *k,
+                      __m128i *prev, const uint64_t num_blocks,
+                      const unsigned nrounds)
+{
+        __m512i last, key, ct[4], b[4];
+        uint64_t n;
+        unsigned i, r;
+
+        if (num_blocks < 16)
+                return 0;
+
+        last = _mm512_broadcast_i32x4(*prev);
+
+        for (n = 0; (n + 16) <= num_blocks; n += 16) {
+                key = _mm512_broadcast_i32x4(_mm_loadu_si128(&k[0]));
+                for (i = 0; i < 4; i++)
+                        ct[i] = _mm512_loadu_si512(&c[n + (4 * i)]);
+
+                b[0] = _mm512_xor_si512(_mm512_alignr_epi64(ct[0], last, 6),
+                                        key);
+                for (i = 1; i < 4; i++)
+                        b[i] = _mm512_xor_si512(
+                                _mm512_alignr_epi64(ct[i], ct[i - 1], 6),
+                                key);
+
+                for (r = 1; r < nrounds; r++) {
+                        key = _mm512_broadcast_i32x4(_mm_loadu_si128(&k[r]));
+                        for (i = 0; i < 4; i++)
+                                b[i] = _mm512_aesenc_epi128(b[i], key);
+                }
+
+                key = _mm512_broadcast_i32x4(_mm_loadu_si128(&k[nrounds]));
+                for (i = 0; i < 4; i++) {
+                        b[i] = _mm512_aesenclast_epi128(b[i], key);
+                        _mm512_storeu_si512(&o[n + (4 * i)],
+                                            _mm512_xor_si512(b[i], ct[i]));
+                }
+                last = ct[3];
+        }
+
+        *prev = _mm512_extracti32x4_epi32(last, 3);
+        return n;
+}
+#endif /* AES_CFB_VAES */
+
+/**
+ * @brief AES-CFB128 decryption of complete blocks
+ *
+ * Blocks are decrypted 16 at a time with VAES (AES_CFB_VAES),
+ * then 8 at a time. The 1 to 7 remaining blocks are decrypted
+ * in parallel as well, with the block count known at compile time
+ * so that blocks are kept in registers.
+ *
+ * @param in      cipher text
+ * @param iv      initialization vector
+ * @param keys    expanded encryption keys
+ * @param out     plain text
+ * @param len     number of bytes to decrypt (multiple of 16)
+ * @param nrounds number of AES rounds
+ */
+__forceinline
+void
+aes_cfb_dec(const void *in, const uint8_t *iv, const void *keys,
+            void *out, const uint64_t len, const unsigned nrounds)
+{
+        const __m128i *k = (const __m128i *) keys;
+        const __m128i *c = (const __m128i *) in;
+        __m128i *o = (__m128i *) out;
+        const uint64_t num_blocks = len / AES_CFB_BLOCK;
+        __m128i prev = _mm_loadu_si128((const __m128i *) iv);
+        uint64_t n;
+
+#ifdef AES_CFB_VAES
+        n = aes_cfb_dec_by16_vaes(c, o, k, &prev, num_blocks, nrounds);
+#else
+        n = 0;
+#endif
+        for (; (n + 8) <= num_blocks; n += 8)
+                prev = aes_cfb_dec_by_n(&c[n], &o[n], k, prev, 8, nrounds);
+
+        switch (num_blocks - n) {
+        case 7:
+                (void) aes_cfb_dec_by_n(&c[n], &o[n], k, prev, 7, nrounds);
+                break;
+        case 6:
+                (void) aes_cfb_dec_by_n(&c[n], &o[n], k, prev, 6, nrounds);
+                break;
+        case 5:
+                (void) aes_cfb_dec_by_n(&c[n], &o[n], k, prev, 5, nrounds);
+                break;
+        case 4:
+                (void) aes_cfb_dec_by_n(&c[n], &o[n], k, prev, 4, nrounds);
+                break;
+        case 3:
+                (void) aes_cfb_dec_by_n(&c[n], &o[n], k, prev, 3, nrounds);
+                break;
+        case 2:
+                (void) aes_cfb_dec_by_n(&c[n], &o[n], k, prev, 2, nrounds);
+                break;
+        case 1:
+                (void) aes_cfb_dec_by_n(&c[n], &o[n], k, prev, 1, nrounds);
+                break;
+        default:
+                break;
+        }
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+}
+
+void
+AES_CFB_DEC_128(const void *in, const uint8_t *IV, const void *keys,
+                void *out, uint64_t len_bytes)
+{
+        aes_cfb_dec(in, IV, keys, out, len_bytes, 10);
+}
+
+void
+AES_CFB_DEC_256(const void *in, const uint8_t *IV, const void *keys,
+                void *out, uint64_t len_bytes)
+{
+        aes_cfb_dec(in, IV, keys, out, len_bytes, 14);
+}
+
+#endif /* AES_CFB_COMMON_H */
@@ -0,0 +1,661 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*-----------------------------------------------------------------------
+ * Stitched DOCSIS SEC BPI (AES-CBC) + CRC32 (Ethernet FCS).
+ *
+ * Encryption is done by a 4-lane out-of-order manager. Each iteration
+ * of the multi-lane routine encrypts one block per lane and folds
+ * 16 bytes of the lane's plaintext into its CRC (PCLMULQDQ), so the CRC
+ * is computed in the shadow of the serial CBC chain.
+ * Each lane goes through the following stages:
+ * - CRC of the bytes ahead of the cipher text (in C, on submission)
+ * - CBC + CRC, CRC data is read at or ahead of the cipher pointer,
+ *   as cipher text is written in place
+ * - CRC tail (in C), the CRC value is written to the source buffer
+ * - CBC of the blocks holding the CRC value (if any)
+ * The partial last block (CFB) is left to the caller.
+ *
+ * Decryption is single buffer: 4 blocks are decrypted in parallel and
+ * the CRC is folded over the plain text that is already decrypted.
+ *
+ * The including file must define:
+ * - SUBMIT_JOB_DOCSIS128_CRC32_X4, FLUSH_JOB_DOCSIS128_CRC32_X4,
+ *   SUBMIT_JOB_DOCSIS256_CRC32_X4, FLUSH_JOB_DOCSIS256_CRC32_X4
+ * - DOCSIS128_CRC32_DEC, DOCSIS256_CRC32_DEC
+ * - CLEAR_SCRATCH_SIMD_REGS
+ *-----------------------------------------------------------------------*/
+
+#ifndef AES_DOCSIS_CRC32_COMMON_H
+#define AES_DOCSIS_CRC32_COMMON_H
+
+#include <stdint.h>
+#include <string.h>
+#ifdef LINUX
+#include <x86intrin.h>
+#else
+#include <intrin.h>
+#endif
+
+#include "intel-ipsec-mb.h"
+#include "include/ipsec_ooo_mgr.h"
+#include "include/clear_regs_mem.h"
+
+#define DOCSIS_CRC32_NUM_LANES 4
+#define DOCSIS_CRC32_BLOCK     16
+
+/* Lane stages */
+#define DOCSIS_CRC32_STAGE_STITCH 0
+#define DOCSIS_CRC32_STAGE_CBC    1
+#define DOCSIS_CRC32_STAGE_DONE   2
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_DOCSIS128_CRC32_X4(MB_MGR_DOCSIS_CRC32_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_DOCSIS128_CRC32_X4(MB_MGR_DOCSIS_CRC32_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_DOCSIS256_CRC32_X4(MB_MGR_DOCSIS_CRC32_OOO *state, IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_DOCSIS256_CRC32_X4(MB_MGR_DOCSIS_CRC32_OOO *state);
+IMB_DLL_LOCAL IMB_JOB *DOCSIS128_CRC32_DEC(IMB_JOB *job);
+IMB_DLL_LOCAL IMB_JOB *DOCSIS256_CRC32_DEC(IMB_JOB *job);
+
+/*
+ * CRC32 folding constants (reflected polynomial 0x04C11DB7):
+ * - x^(128+32) and x^(128-32) mod P (fold by 128 bits)
+ * - x^64 mod P (fold 96 to 64 bits)
+ * - P' and P (Barrett reduction)
+ */
+static const DECLARE_ALIGNED(uint64_t docsis_crc_fold[2], 16) = {
+        0x00000001751997d0, 0x00000000ccaa009e
+};
+static const DECLARE_ALIGNED(uint64_t docsis_crc_fold64[2], 16) = {
+        0x0000000163cd6124, 0x0000000000000000
+};
+static const DECLARE_ALIGNED(uint64_t docsis_crc_poly[2], 16) = {
+        0x00000001db710641, 0x00000001f7011641
+};
+
+/* CRC32 of 4-bit values, for the bytes following the last 16-byte chunk */
+static const uint32_t docsis_crc_nibble[16] = {
+        0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+        0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+        0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+        0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+};
+
+/**
+ * @brief Folds CRC accumulator by 128 bits and adds next 16 bytes
+ */
+__forceinline
+__m128i
+docsis_crc_fold16(const __m128i crc, const __m128i data, const __m128i k)
+{
+        const __m128i lo = _mm_clmulepi64_si128(crc, k, 0x00);
+        const __m128i hi = _mm_clmulepi64_si128(crc, k, 0x11);
+
+        return _mm_xor_si128(_mm_xor_si128(lo, hi), data);
+}
+
+/**
+ * @brief Reduces 128-bit CRC accumulator to 32-bit CRC state
+ */
+__forceinline
+uint32_t
+docsis_crc_reduce(__m128i crc)
+{
+        const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+        const __m128i k = _mm_load_si128((const __m128i *) docsis_crc_fold);
+        const __m128i k64 =
+                _mm_load_si128((const __m128i *) docsis_crc_fold64);
+        const __m128i poly = _mm_load_si128((const __m128i *) docsis_crc_poly);
+        __m128i t;
+
+        /* 128 to 64 bits */
+        t = _mm_clmulepi64_si128(crc, k, 0x10);
+        crc = _mm_xor_si128(_mm_srli_si128(crc, 8), t);
+        t = _mm_srli_si128(crc, 4);
+        crc = _mm_clmulepi64_si128(_mm_and_si128(crc, mask32), k64, 0x00);
+        crc = _mm_xor_si128(crc, t);
+
+        /* Barrett reduction to 32 bits */
+        t = _mm_clmulepi64_si128(_mm_and_si128(crc, mask32), poly, 0x10);
+        t = _mm_clmulepi64_si128(_mm_and_si128(t, mask32), poly, 0x00);
+        crc = _mm_xor_si128(crc, t);
+
+        return (uint32_t) _mm_extract_epi32(crc, 1);
+}
+
+/**
+ * @brief Updates 32-bit CRC state with up to 15 bytes
+ */
+__forceinline
+uint32_t
+docsis_crc_bytes(uint32_t crc, const uint8_t *p, uint64_t len)
+{
+        while (len--) {
+                crc ^= *p++;
+                crc = (crc >> 4) ^ docsis_crc_nibble[crc & 15];
+                crc = (crc >> 4) ^ docsis_crc_nibble[crc & 15];
+        }
+        return crc;
+}
+
+/**
+ * @brief Completes CRC from accumulator and pointer to the next chunk
+ *
+ * @param crc accumulator (first chunk already added)
+ * @param p   next byte to add to CRC
+ * @param end end of CRC data
+ *
+ * @return Ethernet FCS value
+ */
+__forceinline
+uint32_t
+docsis_crc_finish(__m128i crc, const uint8_t *p, const uint8_t *end)
+{
+        const __m128i k = _mm_load_si128((const __m128i *) docsis_crc_fold);
+
+        while ((end - p) >= DOCSIS_CRC32_BLOCK) {
+                crc = docsis_crc_fold16(crc,
+                                        _mm_loadu_si128((const __m128i *) p),
+                                        k);
+                p += DOCSIS_CRC32_BLOCK;
+        }
+
+        return ~docsis_crc_bytes(docsis_crc_reduce(crc), p,
+                                 (uint64_t) (end - p));
+}
+
+/**
+ * @brief Computes Ethernet FCS of a buffer
+ */
+__forceinline
+uint32_t
+docsis_crc32(const uint8_t *p, const uint64_t len)
+{
+        if (len < DOCSIS_CRC32_BLOCK)
+                return ~docsis_crc_bytes(0xffffffff, p, len);
+
+        return docsis_crc_finish(
+                _mm_xor_si128(_mm_loadu_si128((const __m128i *) p),
+                              _mm_cvtsi32_si128(-1)),
+                p + DOCSIS_CRC32_BLOCK, p + len);
+}
+
+/**
+ * @brief Stitched AES-CBC encryption and CRC32 of 4 lanes
+ *
+ * For each lane, \a len bytes are encrypted from args->in to args->out
+ * and \a len bytes from args->crc_in are folded into the lane's CRC.
+ * CRC data is loaded before the cipher text block is stored.
+ *
+ * @param args    lane arguments, pointers are advanced by \a len
+ * @param len     number of bytes to process (multiple of 16)
+ * @param nrounds number of AES rounds
+ */
+__forceinline
+void
+docsis_crc32_cbc_enc_x4(AES_DOCSIS_CRC32_ARGS_x4 *args, const uint32_t len,
+                        const unsigned nrounds)
+{
+        const __m128i k = _mm_load_si128((const __m128i *) docsis_crc_fold);
+        const __m128i *keys[DOCSIS_CRC32_NUM_LANES];
+        __m128i iv[DOCSIS_CRC32_NUM_LANES];
+        __m128i crc[DOCSIS_CRC32_NUM_LANES];
+        __m128i b[DOCSIS_CRC32_NUM_LANES];
+        __m128i c[DOCSIS_CRC32_NUM_LANES];
+        uint32_t off;
+        unsigned i, r;
+
+        for (i = 0; i < DOCSIS_CRC32_NUM_LANES; i++) {
+                keys[i] = (const __m128i *) args->keys[i];
+                iv[i] = _mm_load_si128((const __m128i *) &args->iv[i]);
+                crc[i] = _mm_load_si128((const __m128i *) &args->crc[i]);
+        }
+
+        for (off = 0; off < len; off += DOCSIS_CRC32_BLOCK) {
+                for (i = 0; i < DOCSIS_CRC32_NUM_LANES; i++) {
+                        c[i] = _mm_loadu_si128((const __m128i *)
+                                               &args->crc_in[i][off]);
+                        b[i] = _mm_loadu_si128((const __m128i *)
+                                               &args->in[i][off]);
+                        b[i] = _mm_xor_si128(_mm_xor_si128(b[i], iv[i]),
+                                             _mm_loadu_si128(&keys[i][0]));
+                }
+
+                /* CRC folding runs on other ports than AES rounds */
+                for (i = 0; i < DOCSIS_CRC32_NUM_LANES; i++)
+                        crc[i] = docsis_crc_fold16(crc[i], c[i], k);
+
+                for (r = 1; r < nrounds; r++)
+                        for (i = 0; i < DOCSIS_CRC32_NUM_LANES; i++)
+                                b[i] = _mm_aesenc_si128(
+                                        b[i], _mm_loadu_si128(&keys[i][r]));
+
+                for (i = 0; i < DOCSIS_CRC32_NUM_LANES; i++) {
+                        iv[i] = _mm_aesenclast_si128(
+                                b[i], _mm_loadu_si128(&keys[i][nrounds]));
+                        _mm_storeu_si128((__m128i *) &args->out[i][off],
+                                         iv[i]);
+                }
+        }
+
+        for (i = 0; i < DOCSIS_CRC32_NUM_LANES; i++) {
+                _mm_store_si128((__m128i *) &args->iv[i], iv[i]);
+                _mm_store_si128((__m128i *) &args->crc[i], crc[i]);
+                args->in[i] += len;
+                args->out[i] += len;
+                args->crc_in[i] += len;
+        }
+}
+
+/*
+ * Completes CRC of a lane, writes it to the job and to the source buffer
+ * and sets up CBC of the remaining full blocks (if any).
+ * crc_in points to the next CRC byte and in/out to the next cipher block.
+ */
+static inline void
+docsis_crc32_next_stage(MB_MGR_DOCSIS_CRC32_OOO *state, const unsigned lane)
+{
+        IMB_JOB *job = state->job_in_lane[lane];
+        const uint8_t *cipher_end = job->src +
+                job->cipher_start_src_offset_in_bytes +
+                (job->msg_len_to_cipher_in_bytes &
+                 (~(uint64_t) (DOCSIS_CRC32_BLOCK - 1)));
+
+        if (state->stage[lane] == DOCSIS_CRC32_STAGE_STITCH) {
+                const uint8_t *crc_end = job->src +
+                        job->hash_start_src_offset_in_bytes +
+                        job->msg_len_to_hash_in_bytes;
+                const uint8_t *crc_start = job->src +
+                        job->hash_start_src_offset_in_bytes;
+                uint32_t fcs;
+
+                if (state->args.crc_in[lane] == crc_start)
+                        fcs = docsis_crc32(crc_start,
+                                           job->msg_len_to_hash_in_bytes);
+                else
+                        fcs = docsis_crc_finish(
+                                _mm_load_si128((const __m128i *)
+                                               &state->args.crc[lane]),
+                                state->args.crc_in[lane], crc_end);
+
+                /* CRC value goes to the source buffer, before encryption */
+                memcpy(job->auth_tag_output, &fcs, sizeof(fcs));
+                memcpy((uint8_t *) (uintptr_t) crc_end, &fcs, sizeof(fcs));
+
+                state->stage[lane] = DOCSIS_CRC32_STAGE_CBC;
+                state->args.crc_in[lane] = state->args.in[lane];
+                state->lens[lane] = (uint32_t) (cipher_end -
+                                                state->args.in[lane]);
+                if (state->lens[lane] != 0)
+                        return;
+        }
+
+        state->stage[lane] = DOCSIS_CRC32_STAGE_DONE;
+}
+
+static inline IMB_JOB *
+docsis_crc32_return_lane(MB_MGR_DOCSIS_CRC32_OOO *state, const unsigned lane)
+{
+        IMB_JOB *job = state->job_in_lane[lane];
+
+        state->num_lanes_inuse--;
+        state->job_in_lane[lane] = NULL;
+        state->lens[lane] = 0xFFFFFFFF;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        job->status |= STS_COMPLETED_AES | STS_COMPLETED_HMAC;
+
+#ifdef SAFE_DATA
+        clear_mem(&state->args.iv[lane], sizeof(state->args.iv[lane]));
+        clear_mem(&state->args.crc[lane], sizeof(state->args.crc[lane]));
+#endif
+        return job;
+}
+
+/*
+ * Runs the multi-lane routine until one of the jobs is completed.
+ * Lanes with no job are given a copy of a valid lane.
+ */
+static inline IMB_JOB *
+docsis_crc32_process_lanes(MB_MGR_DOCSIS_CRC32_OOO *state,
+                           const unsigned nrounds)
+{
+        unsigned i, idx;
+
+        while (1) {
+                uint32_t min_len = UINT32_MAX;
+
+                idx = DOCSIS_CRC32_NUM_LANES;
+                for (i = 0; i < DOCSIS_CRC32_NUM_LANES; i++) {
+                        if (state->job_in_lane[i] == NULL)
+                                continue;
+                        if (state->stage[i] == DOCSIS_CRC32_STAGE_DONE)
+                                return docsis_crc32_return_lane(state, i);
+                        if (state->lens[i] < min_len)
+                                min_len = state->lens[i];
+                        idx = i;
+                }
+
+                /* Copy good lane data into empty lanes */
+                for (i = 0; i < DOCSIS_CRC32_NUM_LANES; i++) {
+                        if (state->job_in_lane[i] != NULL)
+                                continue;
+
+                        state->args.in[i] = state->args.in[idx];
+                        state->args.out[i] = state->args.out[idx];
+                        state->args.crc_in[i] = state->args.crc_in[idx];
+                        state->args.keys[i] = state->args.keys[idx];
+                        state->args.iv[i] = state->args.iv[idx];
+                        state->args.crc[i] = state->args.crc[idx];
+                }
+
+                docsis_crc32_cbc_enc_x4(&state->args, min_len, nrounds);
+
+                for (i = 0; i < DOCSIS_CRC32_NUM_LANES; i++) {
+                        if (state->job_in_lane[i] == NULL)
+                                continue;
+                        state->lens[i] -= min_len;
+                        if (state->lens[i] == 0)
+                                docsis_crc32_next_stage(state, i);
+                }
+        }
+}
+
+/*
+ * Submits DOCSIS SEC BPI + CRC32 encrypt job with at least one full
+ * cipher block. The partial last block (if any) is left to the caller.
+ */
+static inline IMB_JOB *
+submit_job_docsis_crc32_x4(MB_MGR_DOCSIS_CRC32_OOO *state, IMB_JOB *job,
+                           const unsigned nrounds)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+        const uint8_t *cipher = job->src +
+                job->cipher_start_src_offset_in_bytes;
+        const uint8_t *cipher_end = cipher +
+                (job->msg_len_to_cipher_in_bytes &
+                 (~(uint64_t) (DOCSIS_CRC32_BLOCK - 1)));
+        const uint8_t *p = job->src + job->hash_start_src_offset_in_bytes;
+        const uint8_t *crc_end = p + job->msg_len_to_hash_in_bytes;
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+
+        state->args.in[lane] = cipher;
+        state->args.out[lane] = job->dst;
+        state->args.keys[lane] = job->enc_keys;
+        memcpy(&state->args.iv[lane], job->iv, DOCSIS_CRC32_BLOCK);
+        state->stage[lane] = DOCSIS_CRC32_STAGE_CBC;
+        state->lens[lane] = (uint32_t) (cipher_end - cipher);
+        state->args.crc_in[lane] = cipher;
+
+        if (job->msg_len_to_hash_in_bytes >= DOCSIS_CRC32_MIN_ETH_PDU_SIZE) {
+                const __m128i k =
+                        _mm_load_si128((const __m128i *) docsis_crc_fold);
+                __m128i crc = _mm_setzero_si128();
+
+                state->stage[lane] = DOCSIS_CRC32_STAGE_STITCH;
+
+                if (job->msg_len_to_hash_in_bytes < DOCSIS_CRC32_BLOCK) {
+                        /* too short to fold, done on the next stage */
+                        state->lens[lane] = 0;
+                } else {
+                        crc = _mm_xor_si128(
+                                _mm_loadu_si128((const __m128i *) p),
+                                _mm_cvtsi32_si128(-1));
+                        p += DOCSIS_CRC32_BLOCK;
+
+                        /* CRC of the bytes ahead of the cipher text */
+                        while (p < cipher &&
+                               (crc_end - p) >= DOCSIS_CRC32_BLOCK) {
+                                crc = docsis_crc_fold16(
+                                        crc,
+                                        _mm_loadu_si128((const __m128i *) p),
+                                        k);
+                                p += DOCSIS_CRC32_BLOCK;
+                        }
+
+                        if (p < cipher || p > crc_end) {
+                                state->lens[lane] = 0;
+                        } else {
+                                /* stop before the chunk holding CRC value */
+                                const uint64_t crc_len =
+                                        (uint64_t) (crc_end - p) &
+                                        (~(uint64_t) (DOCSIS_CRC32_BLOCK - 1));
+
+                                if (crc_len < state->lens[lane])
+                                        state->lens[lane] = (uint32_t) crc_len;
+                        }
+                }
+
+                _mm_store_si128((__m128i *) &state->args.crc[lane], crc);
+                state->args.crc_in[lane] = p;
+
+                if (state->lens[lane] == 0)
+                        docsis_crc32_next_stage(state, lane);
+        }
+
+        if (state->num_lanes_inuse != DOCSIS_CRC32_NUM_LANES)
+                return NULL;
+
+        return docsis_crc32_process_lanes(state, nrounds);
+}
+
+static inline IMB_JOB *
+flush_job_docsis_crc32_x4(MB_MGR_DOCSIS_CRC32_OOO *state,
+                          const unsigned nrounds)
+{
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        return docsis_crc32_process_lanes(state, nrounds);
+}
+
+/**
+ * @brief Decrypts 1 AES block
+ */
+__forceinline
+__m128i
+docsis_aes_dec_block(__m128i b, const __m128i *keys, const unsigned nrounds)
+{
+        unsigned r;
+
+        b = _mm_xor_si128(b, _mm_loadu_si128(&keys[0]));
+        for (r = 1; r < nrounds; r++)
+                b = _mm_aesdec_si128(b, _mm_loadu_si128(&keys[r]));
+        return _mm_aesdeclast_si128(b, _mm_loadu_si128(&keys[nrounds]));
+}
+
+/**
+ * @brief Adds 16-byte chunks to CRC accumulator
+ *
+ * Chunks are added while they end at or below \a limit.
+ * The first chunk (at \a start) initializes the accumulator.
+ *
+ * @param crc   CRC accumulator
+ * @param pp    pointer to the next CRC byte, advanced by the chunks added
+ * @param start start of CRC data
+ * @param limit end of data available for CRC
+ *
+ * @return Updated CRC accumulator
+ */
+__forceinline
+__m128i
+docsis_crc_chunks(__m128i crc, const uint8_t **pp, const uint8_t *start,
+                  const uint8_t *limit)
+{
+        const __m128i k = _mm_load_si128((const __m128i *) docsis_crc_fold);
+        const uint8_t *p = *pp;
+
+        while ((limit - p) >= DOCSIS_CRC32_BLOCK) {
+                const __m128i data = _mm_loadu_si128((const __m128i *) p);
+
+                if (p == start)
+                        crc = _mm_xor_si128(data, _mm_cvtsi32_si128(-1));
+                else
+                        crc = docsis_crc_fold16(crc, data, k);
+                p += DOCSIS_CRC32_BLOCK;
+        }
+
+        *pp = p;
+        return crc;
+}
+
+/*
+ * Stitched AES-CBC decryption and CRC32 of a DOCSIS SEC BPI job
+ * with at least one full cipher block (in place).
+ * The partial last block (if any) has to be decrypted beforehand.
+ */
+static inline IMB_JOB *
+docsis_crc32_dec(IMB_JOB *job, const unsigned nrounds)
+{
+        const __m128i *keys = (const __m128i *) job->dec_keys;
+        const uint8_t *in = job->src + job->cipher_start_src_offset_in_bytes;
+        const uint64_t num_blocks =
+                job->msg_len_to_cipher_in_bytes / DOCSIS_CRC32_BLOCK;
+        const uint8_t *crc_start = job->src +
+                job->hash_start_src_offset_in_bytes;
+        const uint8_t *crc_end = crc_start + job->msg_len_to_hash_in_bytes;
+        const int do_crc = (job->msg_len_to_hash_in_bytes >=
+                            DOCSIS_CRC32_MIN_ETH_PDU_SIZE);
+        const uint8_t *p = crc_start;
+        uint8_t *out = job->dst;
+        __m128i iv = _mm_loadu_si128((const __m128i *) job->iv);
+        __m128i crc = _mm_setzero_si128();
+        uint64_t n;
+
+        for (n = 0; (n + 4) <= num_blocks; n += 4) {
+                const __m128i *c = (const __m128i *) &in[n * 16];
+                const __m128i c0 = _mm_loadu_si128(&c[0]);
+                const __m128i c1 = _mm_loadu_si128(&c[1]);
+                const __m128i c2 = _mm_loadu_si128(&c[2]);
+                const __m128i c3 = _mm_loadu_si128(&c[3]);
+                __m128i b0 = _mm_xor_si128(c0, _mm_loadu_si128(&keys[0]));
+                __m128i b1 = _mm_xor_si128(c1, _mm_loadu_si128(&keys[0]));
+                __m128i b2 = _mm_xor_si128(c2, _mm_loadu_si128(&keys[0]));
+                __m128i b3 = _mm_xor_si128(c3, _mm_loadu_si128(&keys[0]));
+                __m128i *o = (__m128i *) &out[n * 16];
+                unsigned r;
+
+                for (r = 1; r < nrounds; r++) {
+                        const __m128i key = _mm_loadu_si128(&keys[r]);
+
+                        b0 = _mm_aesdec_si128(b0, key);
+                        b1 = _mm_aesdec_si128(b1, key);
+                        b2 = _mm_aesdec_si128(b2, key);
+                        b3 = _mm_aesdec_si128(b3, key);
+                }
+
+                /*
+                 * CRC of the plain text decrypted so far (in place),
+                 * runs on other ports than AES rounds
+                 */
+                if (do_crc)
+                        crc = docsis_crc_chunks(crc, &p, crc_start,
+                                                (crc_end < &in[n * 16]) ?
+                                                crc_end : &in[n * 16]);
+
+                b0 = _mm_aesdeclast_si128(b0, _mm_loadu_si128(&keys[r]));
+                b1 = _mm_aesdeclast_si128(b1, _mm_loadu_si128(&keys[r]));
+                b2 = _mm_aesdeclast_si128(b2, _mm_loadu_si128(&keys[r]));
+                b3 = _mm_aesdeclast_si128(b3, _mm_loadu_si128(&keys[r]));
+                _mm_storeu_si128(&o[0], _mm_xor_si128(b0, iv));
+                _mm_storeu_si128(&o[1], _mm_xor_si128(b1, c0));
+                _mm_storeu_si128(&o[2], _mm_xor_si128(b2, c1));
+                _mm_storeu_si128(&o[3], _mm_xor_si128(b3, c2));
+                iv = c3;
+        }
+
+        for (; n < num_blocks; n++) {
+                const __m128i c =
+                        _mm_loadu_si128((const __m128i *) &in[n * 16]);
+
+                _mm_storeu_si128((__m128i *) &out[n * 16],
+                                 _mm_xor_si128(docsis_aes_dec_block(c, keys,
+                                                                    nrounds),
+                                               iv));
+                iv = c;
+        }
+
+        if (do_crc) {
+                uint32_t fcs;
+
+                if (p == crc_start)
+                        fcs = docsis_crc32(crc_start,
+                                           job->msg_len_to_hash_in_bytes);
+                else
+                        fcs = docsis_crc_finish(crc, p, crc_end);
+                memcpy(job->auth_tag_output, &fcs, sizeof(fcs));
+        }
+
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+        job->status |= STS_COMPLETED_AES | STS_COMPLETED_HMAC;
+        return job;
+}
+
+IMB_JOB *
+SUBMIT_JOB_DOCSIS128_CRC32_X4(MB_MGR_DOCSIS_CRC32_OOO *state, IMB_JOB *job)
+{
+        return submit_job_docsis_crc32_x4(state, job, 10);
+}
+
+IMB_JOB *
+FLUSH_JOB_DOCSIS128_CRC32_X4(MB_MGR_DOCSIS_CRC32_OOO *state)
+{
+        return flush_job_docsis_crc32_x4(state, 10);
+}
+
+IMB_JOB *
+SUBMIT_JOB_DOCSIS256_CRC32_X4(MB_MGR_DOCSIS_CRC32_OOO *state, IMB_JOB *job)
+{
+        return submit_job_docsis_crc32_x4(state, job, 14);
+}
+
+IMB_JOB *
+FLUSH_JOB_DOCSIS256_CRC32_X4(MB_MGR_DOCSIS_CRC32_OOO *state)
+{
+        return flush_job_docsis_crc32_x4(state, 14);
+}
+
+IMB_JOB *
+DOCSIS128_CRC32_DEC(IMB_JOB *job)
+{
+        return docsis_crc32_dec(job, 10);
+}
+
+IMB_JOB *
+DOCSIS256_CRC32_DEC(IMB_JOB *job)
+{
+        return docsis_crc32_dec(job, 14);
+}
+
+#endif /* AES_DOCSIS_CRC32_COMMON_H */
@@ -0,0 +1,131 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/**
+ * AES-ECB direct API with 128, 192 and 256-bit keys.
+ *
+ * Architecture specific files need to define:
+ * - AES_ECB_128_ENC, AES_ECB_128_DEC, AES_ECB_192_ENC, AES_ECB_192_DEC,
+ *   AES_ECB_256_ENC and AES_ECB_256_DEC (API names)
+ * - AES_ECB_ENC_128, AES_ECB_DEC_128, AES_ECB_ENC_192, AES_ECB_DEC_192,
+ *   AES_ECB_ENC_256 and AES_ECB_DEC_256 (full block routines)
+ * - SAVE_XMMS, RESTORE_XMMS and CLEAR_SCRATCH_SIMD_REGS
+ */
+
+#ifndef AES_ECB_COMMON_H
+#define AES_ECB_COMMON_H
+
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+#include "asm.h"
+#include "include/save_xmms.h"
+#include "include/clear_regs_mem.h"
+
+#ifndef AES_BLOCK_SIZE
+#define AES_BLOCK_SIZE 16
+#endif
+
+typedef void (*aes_ecb_blocks_t)(const void *in, const void *keys,
+                                 void *out, uint64_t len_bytes);
+
+/**
+ * @brief Runs full block ECB routine with register save/restore
+ *
+ * Only complete blocks are processed, any trailing bytes are ignored.
+ */
+__forceinline
+void
+aes_ecb_api(const void *in, const void *keys, void *out,
+            const uint64_t len_bytes, const aes_ecb_blocks_t ecb_blocks)
+{
+#ifndef LINUX
+        DECLARE_ALIGNED(imb_uint128_t xmm_save[10], 16);
+#endif
+#ifdef SAFE_PARAM
+        if (in == NULL || keys == NULL || out == NULL)
+                return;
+#endif
+        if (len_bytes < AES_BLOCK_SIZE)
+                return;
+#ifndef LINUX
+        SAVE_XMMS(xmm_save);
+#endif
+        ecb_blocks(in, keys, out, len_bytes & (~(AES_BLOCK_SIZE - 1)));
+#ifdef SAFE_DATA
+        /* Clear sensitive data in registers */
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+#ifndef LINUX
+        RESTORE_XMMS(xmm_save);
+#endif
+}
+
+void
+AES_ECB_128_ENC(const void *in, const void *keys, void *out,
+                const uint64_t len_bytes)
+{
+        aes_ecb_api(in, keys, out, len_bytes, AES_ECB_ENC_128);
+}
+
+void
+AES_ECB_128_DEC(const void *in, const void *keys, void *out,
+                const uint64_t len_bytes)
+{
+        aes_ecb_api(in, keys, out, len_bytes, AES_ECB_DEC_128);
+}
+
+void
+AES_ECB_192_ENC(const void *in, const void *keys, void *out,
+                const uint64_t len_bytes)
+{
+        aes_ecb_api(in, keys, out, len_bytes, AES_ECB_ENC_192);
+}
+
+void
+AES_ECB_192_DEC(const void *in, const void *keys, void *out,
+                const uint64_t len_bytes)
+{
+        aes_ecb_api(in, keys, out, len_bytes, AES_ECB_DEC_192);
+}
+
+void
+AES_ECB_256_ENC(const void *in, const void *keys, void *out,
+                const uint64_t len_bytes)
+{
+        aes_ecb_api(in, keys, out, len_bytes, AES_ECB_ENC_256);
+}
+
+void
+AES_ECB_256_DEC(const void *in, const void *keys, void *out,
+                const uint64_t len_bytes)
+{
+        aes_ecb_api(in, keys, out, len_bytes, AES_ECB_DEC_256);
+}
+
+#endif /* AES_ECB_COMMON_H */
@@ -0,0 +1,347 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/**
+ * Compact GCM key data (round keys and 8 hash key powers).
+ *
+ * Compact key data is consumed directly by the GCM kernels, nothing is
+ * cached per manager:
+ * - AVX2/AVX512: the layout matches full key data of the 8 hash key power
+ *   (gen4/AVX512) kernels, compact key data is passed as is
+ * - SSE/AVX: Karatsuba terms of the hash key powers are derived into
+ *   full key data on the stack, for the duration of the call
+ *
+ * Architecture specific files need to define:
+ * - AES_GCM_PRE_COMPACT_128, AES_GCM_PRE_COMPACT_192 and
+ *   AES_GCM_PRE_COMPACT_256 (API names)
+ * - AES_GCM_EXPAND_COMPACT_128, AES_GCM_EXPAND_COMPACT_192 and
+ *   AES_GCM_EXPAND_COMPACT_256 (API names)
+ * - AES_GCM_ENC_COMPACT_128, AES_GCM_ENC_COMPACT_192,
+ *   AES_GCM_ENC_COMPACT_256, AES_GCM_DEC_COMPACT_128,
+ *   AES_GCM_DEC_COMPACT_192 and AES_GCM_DEC_COMPACT_256 (API names)
+ * - GCM_PRE_128, GCM_PRE_192 and GCM_PRE_256 (full key data preparation)
+ * - GCM_ENC_128, GCM_ENC_192, GCM_ENC_256, GCM_DEC_128, GCM_DEC_192
+ *   and GCM_DEC_256 (8 hash key power encrypt/decrypt kernels)
+ * - one of GCM_KEYS_SSE_AVX or GCM_KEYS_AVX2_AVX512
+ */
+
+#ifndef AES_GCM_COMPACT_COMMON_H
+#define AES_GCM_COMPACT_COMMON_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "intel-ipsec-mb.h"
+#include "include/gcm.h"
+#include "include/clear_regs_mem.h"
+
+#define GCM_COMPACT_HKEYS_SIZE (GCM_ENC_KEY_LEN * GCM_COMPACT_NUM_HKEYS)
+
+/**
+ * @brief Prepares compact key data from a key
+ *
+ * @param key     pointer to key
+ * @param compact pointer to compact key data
+ * @param key_len key size in bytes
+ */
+__forceinline
+void
+gcm_pre_compact(const void *key, struct gcm_key_data_compact *compact,
+                const uint64_t key_len)
+{
+        DECLARE_ALIGNED(struct gcm_key_data key_data, 64);
+
+        if (key_len == GCM_128_KEY_LEN)
+                GCM_PRE_128(key, &key_data);
+        else if (key_len == GCM_192_KEY_LEN)
+                GCM_PRE_192(key, &key_data);
+        else /* GCM_256_KEY_LEN */
+                GCM_PRE_256(key, &key_data);
+
+        memcpy(compact->expanded_keys, key_data.expanded_keys,
+               sizeof(compact->expanded_keys));
+        /* HashKey^8 to HashKey^1 lead the hash keys on all architectures */
+        memcpy(compact->shifted_hkey, &key_data.ghash_keys,
+               GCM_COMPACT_HKEYS_SIZE);
+#ifdef SAFE_DATA
+        clear_mem(&key_data, sizeof(key_data));
+#endif
+}
+
+/**
+ * @brief Derives full key data from compact key data
+ *
+ * @param compact  pointer to compact key data
+ * @param key_data pointer to full key data
+ */
+__forceinline
+void
+gcm_compact_to_key_data(const struct gcm_key_data_compact *compact,
+                        struct gcm_key_data *key_data)
+{
+        memcpy(key_data->expanded_keys, compact->expanded_keys,
+               sizeof(key_data->expanded_keys));
+#if defined(GCM_KEYS_SSE_AVX)
+        {
+                /*
+                 * HashKey^8 to HashKey^1, followed by Karatsuba terms
+                 * (high XOR low 64 bits) of HashKey^1 to HashKey^8
+                 */
+                uint8_t *hkey_k = key_data->ghash_keys.sse_avx.shifted_hkey_k;
+                unsigned i;
+
+                memcpy(key_data->ghash_keys.sse_avx.shifted_hkey,
+                       compact->shifted_hkey, GCM_COMPACT_HKEYS_SIZE);
+                for (i = 0; i < GCM_COMPACT_NUM_HKEYS; i++) {
+                        const unsigned pos =
+                                (GCM_COMPACT_NUM_HKEYS - 1 - i) *
+                                GCM_ENC_KEY_LEN;
+                        uint64_t hkey[2];
+
+                        memcpy(hkey, &compact->shifted_hkey[pos],
+                               sizeof(hkey));
+                        hkey[0] ^= hkey[1];
+                        hkey[1] = hkey[0];
+                        memcpy(&hkey_k[i * GCM_ENC_KEY_LEN], hkey,
+                               sizeof(hkey));
+                }
+        }
+#else /* GCM_KEYS_AVX2_AVX512 */
+        memcpy(key_data->ghash_keys.avx2_avx512.shifted_hkey,
+               compact->shifted_hkey, GCM_COMPACT_HKEYS_SIZE);
+#endif
+}
+
+/**
+ * @brief AES-GCM encrypt/decrypt with compact key data
+ *
+ * @param compact  pointer to compact key data
+ * @param ctx      pointer to context data
+ * @param out      pointer to output buffer
+ * @param in       pointer to input buffer
+ * @param len      message length in bytes
+ * @param iv       pointer to 12 byte IV
+ * @param aad      pointer to AAD
+ * @param aad_len  AAD length in bytes
+ * @param tag      pointer to output tag
+ * @param tag_len  tag length in bytes
+ * @param key_len  key size in bytes
+ * @param encrypt  non-zero to encrypt, zero to decrypt
+ */
+__forceinline
+void
+gcm_compact_enc_dec(const struct gcm_key_data_compact *compact,
+                    struct gcm_context_data *ctx, uint8_t *out,
+                    const uint8_t *in, const uint64_t len,
+                    const uint8_t *iv, const uint8_t *aad,
+                    const uint64_t aad_len, uint8_t *tag,
+                    const uint64_t tag_len, const uint64_t key_len,
+                    const int encrypt)
+{
+#if defined(GCM_KEYS_SSE_AVX)
+        DECLARE_ALIGNED(struct gcm_key_data key_data, 64);
+        const struct gcm_key_data *key = &key_data;
+
+#ifdef SAFE_PARAM
+        if (compact == NULL)
+                return;
+#endif
+        gcm_compact_to_key_data(compact, &key_data);
+#else /* GCM_KEYS_AVX2_AVX512 */
+        /* round keys and HashKey^8 to HashKey^1 are all the kernels use */
+        const struct gcm_key_data *key = (const struct gcm_key_data *) compact;
+#endif
+
+        if (key_len == GCM_128_KEY_LEN) {
+                if (encrypt)
+                        GCM_ENC_128(key, ctx, out, in, len, iv, aad, aad_len,
+                                    tag, tag_len);
+                else
+                        GCM_DEC_128(key, ctx, out, in, len, iv, aad, aad_len,
+                                    tag, tag_len);
+        } else if (key_len == GCM_192_KEY_LEN) {
+                if (encrypt)
+                        GCM_ENC_192(key, ctx, out, in, len, iv, aad, aad_len,
+                                    tag, tag_len);
+                else
+                        GCM_DEC_192(key, ctx, out, in, len, iv, aad, aad_len,
+                                    tag, tag_len);
+        } else { /* GCM_256_KEY_LEN */
+                if (encrypt)
+                        GCM_ENC_256(key, ctx, out, in, len, iv, aad, aad_len,
+                                    tag, tag_len);
+                else
+                        GCM_DEC_256(key, ctx, out, in, len, iv, aad, aad_len,
+                                    tag, tag_len);
+        }
+#if defined(GCM_KEYS_SSE_AVX) && defined(SAFE_DATA)
+        clear_mem(&key_data, sizeof(key_data));
+#endif
+}
+
+void
+AES_GCM_PRE_COMPACT_128(const void *key, struct gcm_key_data_compact *compact)
+{
+#ifdef SAFE_PARAM
+        if (key == NULL || compact == NULL)
+                return;
+#endif
+        gcm_pre_compact(key, compact, GCM_128_KEY_LEN);
+}
+
+void
+AES_GCM_PRE_COMPACT_192(const void *key, struct gcm_key_data_compact *compact)
+{
+#ifdef SAFE_PARAM
+        if (key == NULL || compact == NULL)
+                return;
+#endif
+        gcm_pre_compact(key, compact, GCM_192_KEY_LEN);
+}
+
+void
+AES_GCM_PRE_COMPACT_256(const void *key, struct gcm_key_data_compact *compact)
+{
+#ifdef SAFE_PARAM
+        if (key == NULL || compact == NULL)
+                return;
+#endif
+        gcm_pre_compact(key, compact, GCM_256_KEY_LEN);
+}
+
+void
+AES_GCM_EXPAND_COMPACT_128(const struct gcm_key_data_compact *compact,
+                           struct gcm_key_data *key_data)
+{
+#ifdef SAFE_PARAM
+        if (compact == NULL || key_data == NULL)
+                return;
+#endif
+        gcm_compact_to_key_data(compact, key_data);
+}
+
+void
+AES_GCM_EXPAND_COMPACT_192(const struct gcm_key_data_compact *compact,
+                           struct gcm_key_data *key_data)
+{
+#ifdef SAFE_PARAM
+        if (compact == NULL || key_data == NULL)
+                return;
+#endif
+        gcm_compact_to_key_data(compact, key_data);
+}
+
+void
+AES_GCM_EXPAND_COMPACT_256(const struct gcm_key_data_compact *compact,
+                           struct gcm_key_data *key_data)
+{
+#ifdef SAFE_PARAM
+        if (compact == NULL || key_data == NULL)
+                return;
+#endif
+        gcm_compact_to_key_data(compact, key_data);
+}
+
+void
+AES_GCM_ENC_COMPACT_128(const struct gcm_key_data_compact *key_data,
+                        struct gcm_context_data *context_data,
+                        uint8_t *out, uint8_t const *in, uint64_t len,
+                        const uint8_t *iv, uint8_t const *aad,
+                        uint64_t aad_len, uint8_t *auth_tag,
+                        uint64_t auth_tag_len)
+{
+        gcm_compact_enc_dec(key_data, context_data, out, in, len, iv, aad,
+                            aad_len, auth_tag, auth_tag_len, GCM_128_KEY_LEN,
+                            1);
+}
+
+void
+AES_GCM_ENC_COMPACT_192(const struct gcm_key_data_compact *key_data,
+                        struct gcm_context_data *context_data,
+                        uint8_t *out, uint8_t const *in, uint64_t len,
+                        const uint8_t *iv, uint8_t const *aad,
+                        uint64_t aad_len, uint8_t *auth_tag,
+                        uint64_t auth_tag_len)
+{
+        gcm_compact_enc_dec(key_data, context_data, out, in, len, iv, aad,
+                            aad_len, auth_tag, auth_tag_len, GCM_192_KEY_LEN,
+                            1);
+}
+
+void
+AES_GCM_ENC_COMPACT_256(const struct gcm_key_data_compact *key_data,
+                        struct gcm_context_data *context_data,
+                        uint8_t *out, uint8_t const *in, uint64_t len,
+                        const uint8_t *iv, uint8_t const *aad,
+                        uint64_t aad_len, uint8_t *auth_tag,
+                        uint64_t auth_tag_len)
+{
+        gcm_compact_enc_dec(key_data, context_data, out, in, len, iv, aad,
+                            aad_len, auth_tag, auth_tag_len, GCM_256_KEY_LEN,
+                            1);
+}
+
+void
+AES_GCM_DEC_COMPACT_128(const struct gcm_key_data_compact *key_data,
+                        struct gcm_context_data *context_data,
+                        uint8_t *out, uint8_t const *in, uint64_t len,
+                        const uint8_t *iv, uint8_t const *aad,
+                        uint64_t aad_len, uint8_t *auth_tag,
+                        uint64_t auth_tag_len)
+{
+        gcm_compact_enc_dec(key_data, context_data, out, in, len, iv, aad,
+                            aad_len, auth_tag, auth_tag_len, GCM_128_KEY_LEN,
+                            0);
+}
+
+void
+AES_GCM_DEC_COMPACT_192(const struct gcm_key_data_compact *key_data,
+                        struct gcm_context_data *context_data,
+                        uint8_t *out, uint8_t const *in, uint64_t len,
+                        const uint8_t *iv, uint8_t const *aad,
+                        uint64_t aad_len, uint8_t *auth_tag,
+                        uint64_t auth_tag_len)
+{
+        gcm_compact_enc_dec(key_data, context_data, out, in, len, iv, aad,
+                            aad_len, auth_tag, auth_tag_len, GCM_192_KEY_LEN,
+                            0);
+}
+
+void
+AES_GCM_DEC_COMPACT_256(const struct gcm_key_data_compact *key_data,
+                        struct gcm_context_data *context_data,
+                        uint8_t *out, uint8_t const *in, uint64_t len,
+                        const uint8_t *iv, uint8_t const *aad,
+                        uint64_t aad_len, uint8_t *auth_tag,
+                        uint64_t auth_tag_len)
+{
+        gcm_compact_enc_dec(key_data, context_data, out, in, len, iv, aad,
+                            aad_len, auth_tag, auth_tag_len, GCM_256_KEY_LEN,
+                            0);
+}
+
+#endif /* AES_GCM_COMPACT_COMMON_H */
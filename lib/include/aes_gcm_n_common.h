@@ -0,0 +1,484 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/**
+ * AES-GCM encrypt/decrypt of multiple messages, each with its own key.
+ *
+ * Messages are processed 4 at a time: counter blocks of the 4 messages
+ * are encrypted with interleaved AES rounds and the 4 GHASH computations
+ * (PCLMULQDQ) are independent of each other, which hides the latency
+ * of both instructions. Each message is processed in one call
+ * (12-byte IV), the context data is a working area and holds
+ * the final state on return.
+ *
+ * Architecture specific files need to define:
+ * - AES_GCM_ENC_128_N, AES_GCM_DEC_128_N, AES_GCM_ENC_192_N,
+ *   AES_GCM_DEC_192_N, AES_GCM_ENC_256_N and AES_GCM_DEC_256_N (API names)
+ * - CLEAR_SCRATCH_SIMD_REGS
+ */
+
+#ifndef AES_GCM_N_COMMON_H
+#define AES_GCM_N_COMMON_H
+
+#include <stdint.h>
+#include <string.h>
+#ifdef LINUX
+#include <x86intrin.h>
+#else
+#include <intrin.h>
+#endif
+
+#include "intel-ipsec-mb.h"
+#include "include/gcm.h"
+#include "include/clear_regs_mem.h"
+
+#define AES_GCM_N_LANES 4
+
+/* Reverses byte order of 128-bit block */
+static const DECLARE_ALIGNED(uint8_t gcm_n_bswap_shuf[16], 16) = {
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08,
+        0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00
+};
+
+/* Used to build partial block masks */
+static const uint8_t gcm_n_ones[16] = {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+/* Per message state, blocks kept in reflected (byte swapped) form */
+struct gcm_n_lane {
+        const __m128i *keys;    /* expanded encrypt keys */
+        __m128i hkey;           /* hash key H */
+        __m128i hash;           /* GHASH accumulator */
+        __m128i ctr;            /* counter block */
+        __m128i tag_mask;       /* E(K, J0) in normal byte order */
+        uint64_t num_blocks;    /* number of (partial) message blocks */
+};
+
+/**
+ * @brief GF(2^128) multiplication of reflected blocks (GHASH)
+ */
+__forceinline
+__m128i
+gcm_n_gfmul(const __m128i a, const __m128i b)
+{
+        __m128i lo, hi, mid, t0, t1, t2;
+
+        /* 256-bit carry-less product */
+        lo = _mm_clmulepi64_si128(a, b, 0x00);
+        hi = _mm_clmulepi64_si128(a, b, 0x11);
+        mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10),
+                            _mm_clmulepi64_si128(a, b, 0x01));
+        lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+        hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+        /* shift the product left by 1 bit (reflected representation) */
+        t0 = _mm_srli_epi32(lo, 31);
+        t1 = _mm_srli_epi32(hi, 31);
+        lo = _mm_slli_epi32(lo, 1);
+        hi = _mm_slli_epi32(hi, 1);
+        t2 = _mm_srli_si128(t0, 12);
+        t1 = _mm_slli_si128(t1, 4);
+        t0 = _mm_slli_si128(t0, 4);
+        lo = _mm_or_si128(lo, t0);
+        hi = _mm_or_si128(hi, t1);
+        hi = _mm_or_si128(hi, t2);
+
+        /* reduction modulo x^128 + x^7 + x^2 + x + 1 */
+        t0 = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31),
+                                         _mm_slli_epi32(lo, 30)),
+                           _mm_slli_epi32(lo, 25));
+        t1 = _mm_srli_si128(t0, 4);
+        t0 = _mm_slli_si128(t0, 12);
+        lo = _mm_xor_si128(lo, t0);
+        t2 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1),
+                                         _mm_srli_epi32(lo, 2)),
+                           _mm_srli_epi32(lo, 7));
+        t2 = _mm_xor_si128(t2, t1);
+        lo = _mm_xor_si128(lo, t2);
+
+        return _mm_xor_si128(hi, lo);
+}
+
+/**
+ * @brief Loads up to 16 bytes, zero padded
+ */
+__forceinline
+__m128i
+gcm_n_load(const uint8_t *p, const uint64_t len)
+{
+        DECLARE_ALIGNED(uint8_t buf[16], 16);
+
+        if (len >= 16)
+                return _mm_loadu_si128((const __m128i *) p);
+
+        memset(buf, 0, sizeof(buf));
+        memcpy(buf, p, len);
+        return _mm_load_si128((const __m128i *) buf);
+}
+
+/**
+ * @brief Stores up to 16 bytes
+ */
+__forceinline
+void
+gcm_n_store(uint8_t *p, const __m128i block, const uint64_t len)
+{
+        DECLARE_ALIGNED(uint8_t buf[16], 16);
+
+        if (len >= 16) {
+                _mm_storeu_si128((__m128i *) p, block);
+                return;
+        }
+        _mm_store_si128((__m128i *) buf, block);
+        memcpy(p, buf, len);
+#ifdef SAFE_DATA
+        clear_mem(buf, sizeof(buf));
+#endif
+}
+
+/**
+ * @brief Encrypts one block for each lane with interleaved AES rounds
+ */
+__forceinline
+void
+gcm_n_aes_enc(__m128i blocks[AES_GCM_N_LANES],
+              const struct gcm_n_lane lanes[AES_GCM_N_LANES],
+              const unsigned num_lanes, const unsigned nr)
+{
+        unsigned r, l;
+
+        for (l = 0; l < num_lanes; l++)
+                blocks[l] = _mm_xor_si128(blocks[l],
+                                          _mm_loadu_si128(&lanes[l].keys[0]));
+        for (r = 1; r < nr; r++)
+                for (l = 0; l < num_lanes; l++)
+                        blocks[l] = _mm_aesenc_si128(blocks[l],
+                                        _mm_loadu_si128(&lanes[l].keys[r]));
+        for (l = 0; l < num_lanes; l++)
+                blocks[l] = _mm_aesenclast_si128(blocks[l],
+                                        _mm_loadu_si128(&lanes[l].keys[nr]));
+}
+
+/**
+ * @brief GHASH of data (zero padded to block size) into lane accumulator
+ */
+__forceinline
+void
+gcm_n_ghash(struct gcm_n_lane *lane, const uint8_t *data, const uint64_t len)
+{
+        const __m128i bswap = _mm_load_si128((const __m128i *)
+                                             gcm_n_bswap_shuf);
+        uint64_t offset;
+
+        for (offset = 0; offset < len; offset += 16) {
+                const __m128i block = gcm_n_load(&data[offset],
+                                                 len - offset);
+
+                lane->hash = gcm_n_gfmul(_mm_xor_si128(lane->hash,
+                                         _mm_shuffle_epi8(block, bswap)),
+                                         lane->hkey);
+        }
+}
+
+/**
+ * @brief Processes up to 4 messages
+ */
+__forceinline
+void
+aes_gcm_x4(const struct gcm_key_data * const key_data[],
+           struct gcm_context_data * const ctx[],
+           uint8_t * const out[], const uint8_t * const in[],
+           const uint64_t len[], const uint8_t * const iv[],
+           const uint8_t * const aad[], const uint64_t aad_len[],
+           uint8_t * const tag[], const uint64_t tag_len,
+           const unsigned num_lanes, const unsigned nr, const int enc)
+{
+        const __m128i bswap = _mm_load_si128((const __m128i *)
+                                             gcm_n_bswap_shuf);
+        const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+        struct gcm_n_lane lanes[AES_GCM_N_LANES];
+        __m128i blocks[AES_GCM_N_LANES];
+        uint64_t max_blocks = 0, b;
+        unsigned l;
+
+        /* E(K, 0^128) and E(K, J0) */
+        for (l = 0; l < num_lanes; l++) {
+                DECLARE_ALIGNED(uint8_t j0[16], 16);
+
+                memcpy(j0, iv[l], 12);
+                j0[12] = 0;
+                j0[13] = 0;
+                j0[14] = 0;
+                j0[15] = 1;
+                lanes[l].keys = (const __m128i *) key_data[l]->expanded_keys;
+                lanes[l].ctr = _mm_shuffle_epi8(_mm_load_si128((__m128i *) j0),
+                                                bswap);
+                lanes[l].hash = _mm_setzero_si128();
+                lanes[l].num_blocks = (len[l] + 15) / 16;
+                if (lanes[l].num_blocks > max_blocks)
+                        max_blocks = lanes[l].num_blocks;
+                memcpy(ctx[l]->orig_IV, j0, sizeof(j0));
+                blocks[l] = _mm_setzero_si128();
+        }
+        gcm_n_aes_enc(blocks, lanes, num_lanes, nr);
+        for (l = 0; l < num_lanes; l++) {
+                lanes[l].hkey = _mm_shuffle_epi8(blocks[l], bswap);
+                blocks[l] = _mm_loadu_si128((const __m128i *)
+                                            ctx[l]->orig_IV);
+        }
+        gcm_n_aes_enc(blocks, lanes, num_lanes, nr);
+        for (l = 0; l < num_lanes; l++)
+                lanes[l].tag_mask = blocks[l];
+
+        /* AAD */
+        for (l = 0; l < num_lanes; l++)
+                gcm_n_ghash(&lanes[l], aad[l], aad_len[l]);
+
+        /* message: counter mode with GHASH on the ciphertext */
+        for (b = 0; b < max_blocks; b++) {
+                const uint64_t offset = b * 16;
+
+                for (l = 0; l < num_lanes; l++) {
+                        lanes[l].ctr = _mm_add_epi32(lanes[l].ctr, one);
+                        blocks[l] = _mm_shuffle_epi8(lanes[l].ctr, bswap);
+                }
+                gcm_n_aes_enc(blocks, lanes, num_lanes, nr);
+
+                for (l = 0; l < num_lanes; l++) {
+                        uint64_t remain;
+                        __m128i data, cipher;
+
+                        if (b >= lanes[l].num_blocks)
+                                continue;
+
+                        remain = len[l] - offset;
+                        data = gcm_n_load(&in[l][offset], remain);
+                        if (remain < 16) {
+                                /* clear key stream bytes past the end */
+                                const __m128i mask =
+                                        gcm_n_load(gcm_n_ones, remain);
+
+                                blocks[l] = _mm_and_si128(blocks[l], mask);
+                        }
+                        blocks[l] = _mm_xor_si128(blocks[l], data);
+                        gcm_n_store(&out[l][offset], blocks[l], remain);
+
+                        cipher = enc ? blocks[l] : data;
+                        lanes[l].hash =
+                                gcm_n_gfmul(_mm_xor_si128(lanes[l].hash,
+                                            _mm_shuffle_epi8(cipher, bswap)),
+                                            lanes[l].hkey);
+                }
+        }
+
+        /* lengths block and tag */
+        for (l = 0; l < num_lanes; l++) {
+                const __m128i len_block =
+                        _mm_set_epi64x((long long) (aad_len[l] * 8),
+                                       (long long) (len[l] * 8));
+                DECLARE_ALIGNED(uint8_t t[16], 16);
+                __m128i s;
+
+                lanes[l].hash = gcm_n_gfmul(_mm_xor_si128(lanes[l].hash,
+                                                          len_block),
+                                            lanes[l].hkey);
+                s = _mm_shuffle_epi8(lanes[l].hash, bswap);
+                _mm_store_si128((__m128i *) t,
+                                _mm_xor_si128(s, lanes[l].tag_mask));
+                memcpy(tag[l], t, (size_t) tag_len);
+
+                _mm_storeu_si128((__m128i *) ctx[l]->aad_hash, s);
+                _mm_storeu_si128((__m128i *) ctx[l]->current_counter,
+                                 _mm_shuffle_epi8(lanes[l].ctr, bswap));
+                ctx[l]->aad_length = aad_len[l];
+                ctx[l]->in_length = len[l];
+                ctx[l]->partial_block_length = len[l] % 16;
+                memset(ctx[l]->partial_block_enc_key, 0,
+                       sizeof(ctx[l]->partial_block_enc_key));
+#ifdef SAFE_DATA
+                clear_mem(t, sizeof(t));
+#endif
+        }
+
+#ifdef SAFE_DATA
+        clear_mem(lanes, sizeof(lanes));
+        clear_mem(blocks, sizeof(blocks));
+#endif
+}
+
+#ifdef SAFE_PARAM
+/**
+ * @brief Checks parameters of all messages
+ *
+ * @return 0 - invalid parameters, 1 - parameters are valid
+ */
+static int
+aes_gcm_n_check(const struct gcm_key_data * const key_data[],
+                struct gcm_context_data * const ctx[],
+                uint8_t * const out[], const uint8_t * const in[],
+                const uint64_t len[], const uint8_t * const iv[],
+                const uint8_t * const aad[], const uint64_t aad_len[],
+                uint8_t * const tag[], const uint64_t tag_len,
+                const uint32_t num_msgs)
+{
+        uint32_t i;
+
+        if (key_data == NULL || ctx == NULL || out == NULL || in == NULL ||
+            len == NULL || iv == NULL || aad == NULL || aad_len == NULL ||
+            tag == NULL)
+                return 0;
+        if (tag_len == 0 || tag_len > 16)
+                return 0;
+
+        for (i = 0; i < num_msgs; i++) {
+                if (key_data[i] == NULL || ctx[i] == NULL || iv[i] == NULL ||
+                    tag[i] == NULL)
+                        return 0;
+                if (len[i] != 0 && (in[i] == NULL || out[i] == NULL))
+                        return 0;
+                if (aad_len[i] != 0 && aad[i] == NULL)
+                        return 0;
+        }
+        return 1;
+}
+#endif
+
+/**
+ * @brief Processes any number of messages, 4 at a time
+ */
+__forceinline
+void
+aes_gcm_n(const struct gcm_key_data * const key_data[],
+          struct gcm_context_data * const ctx[],
+          uint8_t * const out[], const uint8_t * const in[],
+          const uint64_t len[], const uint8_t * const iv[],
+          const uint8_t * const aad[], const uint64_t aad_len[],
+          uint8_t * const tag[], const uint64_t tag_len,
+          const uint32_t num_msgs, const unsigned nr, const int enc)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (!aes_gcm_n_check(key_data, ctx, out, in, len, iv, aad, aad_len,
+                             tag, tag_len, num_msgs))
+                return;
+#endif
+        for (i = 0; i < num_msgs; i += AES_GCM_N_LANES) {
+                const unsigned num_lanes =
+                        (num_msgs - i) < AES_GCM_N_LANES ?
+                        (num_msgs - i) : AES_GCM_N_LANES;
+
+                aes_gcm_x4(&key_data[i], &ctx[i], &out[i], &in[i], &len[i],
+                           &iv[i], &aad[i], &aad_len[i], &tag[i], tag_len,
+                           num_lanes, nr, enc);
+        }
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+}
+
+void
+AES_GCM_ENC_128_N(const struct gcm_key_data * const key_data[],
+                  struct gcm_context_data * const ctx[],
+                  uint8_t * const out[], const uint8_t * const in[],
+                  const uint64_t len[], const uint8_t * const iv[],
+                  const uint8_t * const aad[], const uint64_t aad_len[],
+                  uint8_t * const tag[], const uint64_t tag_len,
+                  const uint32_t num_msgs)
+{
+        aes_gcm_n(key_data, ctx, out, in, len, iv, aad, aad_len,
+                  tag, tag_len, num_msgs, 10, 1);
+}
+
+void
+AES_GCM_DEC_128_N(const struct gcm_key_data * const key_data[],
+                  struct gcm_context_data * const ctx[],
+                  uint8_t * const out[], const uint8_t * const in[],
+                  const uint64_t len[], const uint8_t * const iv[],
+                  const uint8_t * const aad[], const uint64_t aad_len[],
+                  uint8_t * const tag[], const uint64_t tag_len,
+                  const uint32_t num_msgs)
+{
+        aes_gcm_n(key_data, ctx, out, in, len, iv, aad, aad_len,
+                  tag, tag_len, num_msgs, 10, 0);
+}
+
+void
+AES_GCM_ENC_192_N(const struct gcm_key_data * const key_data[],
+                  struct gcm_context_data * const ctx[],
+                  uint8_t * const out[], const uint8_t * const in[],
+                  const uint64_t len[], const uint8_t * const iv[],
+                  const uint8_t * const aad[], const uint64_t aad_len[],
+                  uint8_t * const tag[], const uint64_t tag_len,
+                  const uint32_t num_msgs)
+{
+        aes_gcm_n(key_data, ctx, out, in, len, iv, aad, aad_len,
+                  tag, tag_len, num_msgs, 12, 1);
+}
+
+void
+AES_GCM_DEC_192_N(const struct gcm_key_data * const key_data[],
+                  struct gcm_context_data * const ctx[],
+                  uint8_t * const out[], const uint8_t * const in[],
+                  const uint64_t len[], const uint8_t * const iv[],
+                  const uint8_t * const aad[], const uint64_t aad_len[],
+                  uint8_t * const tag[], const uint64_t tag_len,
+                  const uint32_t num_msgs)
+{
+        aes_gcm_n(key_data, ctx, out, in, len, iv, aad, aad_len,
+                  tag, tag_len, num_msgs, 12, 0);
+}
+
+void
+AES_GCM_ENC_256_N(const struct gcm_key_data * const key_data[],
+                  struct gcm_context_data * const ctx[],
+                  uint8_t * const out[], const uint8_t * const in[],
+                  const uint64_t len[], const uint8_t * const iv[],
+                  const uint8_t * const aad[], const uint64_t aad_len[],
+                  uint8_t * const tag[], const uint64_t tag_len,
+                  const uint32_t num_msgs)
+{
+        aes_gcm_n(key_data, ctx, out, in, len, iv, aad, aad_len,
+                  tag, tag_len, num_msgs, 14, 1);
+}
+
+void
+AES_GCM_DEC_256_N(const struct gcm_key_data * const key_data[],
+                  struct gcm_context_data * const ctx[],
+                  uint8_t * const out[], const uint8_t * const in[],
+                  const uint64_t len[], const uint8_t * const iv[],
+                  const uint8_t * const aad[], const uint64_t aad_len[],
+                  uint8_t * const tag[], const uint64_t tag_len,
+                  const uint32_t num_msgs)
+{
+        aes_gcm_n(key_data, ctx, out, in, len, iv, aad, aad_len,
+                  tag, tag_len, num_msgs, 14, 0);
+}
+
+#endif /* AES_GCM_N_COMMON_H */
@@ -0,0 +1,353 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/**
+ * AES key expansion of many keys at a time (128, 192 and 256-bit keys).
+ *
+ * Keys are expanded 4 at a time in a word sliced layout: each XMM register
+ * holds the same key schedule word of 4 different keys. SubWord() of
+ * 4 words is done with a single AESENCLAST, after shuffling the bytes so
+ * that ShiftRows() has no effect, which avoids serial AESKEYGENASSIST
+ * dependencies. Round keys are transposed back to the standard layout
+ * on store.
+ *
+ * Architecture specific files need to define:
+ * - AES_KEYEXP_128_N, AES_KEYEXP_192_N and AES_KEYEXP_256_N (API names)
+ * - AES_GCM_PRE_128_N, AES_GCM_PRE_192_N and AES_GCM_PRE_256_N (API names)
+ *   together with GCM_PRECOMP_128, GCM_PRECOMP_192 and GCM_PRECOMP_256
+ * - CLEAR_SCRATCH_SIMD_REGS
+ * Any of the two API sets can be left undefined.
+ */
+
+#ifndef AES_KEYEXP_N_COMMON_H
+#define AES_KEYEXP_N_COMMON_H
+
+#include <stdint.h>
+#ifdef LINUX
+#include <x86intrin.h>
+#else
+#include <intrin.h>
+#endif
+
+#include "intel-ipsec-mb.h"
+#include "include/gcm.h"
+#include "include/clear_regs_mem.h"
+
+#define AES_KEYEXP_N_LANES 4
+/* 15 round keys of 4 words for AES-256 */
+#define AES_KEYEXP_N_MAX_WORDS (15 * 4)
+
+/*
+ * Byte shuffle applying InvShiftRows() on top of RotWord(), so that
+ * AESENCLAST computes SubWord(RotWord()) of each 32-bit word
+ */
+static const DECLARE_ALIGNED(uint8_t rot_sub_word_shuf[16], 16) = {
+        0x01, 0x0e, 0x0b, 0x04, 0x05, 0x02, 0x0f, 0x08,
+        0x09, 0x06, 0x03, 0x0c, 0x0d, 0x0a, 0x07, 0x00
+};
+
+/*
+ * Byte shuffle applying InvShiftRows(), so that AESENCLAST
+ * computes SubWord() of each 32-bit word
+ */
+static const DECLARE_ALIGNED(uint8_t sub_word_shuf[16], 16) = {
+        0x00, 0x0d, 0x0a, 0x07, 0x04, 0x01, 0x0e, 0x0b,
+        0x08, 0x05, 0x02, 0x0f, 0x0c, 0x09, 0x06, 0x03
+};
+
+static const uint32_t aes_rcon[10] = {
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+};
+
+__forceinline
+void
+transpose_4x4_u32(__m128i *r0, __m128i *r1, __m128i *r2, __m128i *r3)
+{
+        const __m128i t0 = _mm_unpacklo_epi32(*r0, *r1);
+        const __m128i t1 = _mm_unpacklo_epi32(*r2, *r3);
+        const __m128i t2 = _mm_unpackhi_epi32(*r0, *r1);
+        const __m128i t3 = _mm_unpackhi_epi32(*r2, *r3);
+
+        *r0 = _mm_unpacklo_epi64(t0, t1);
+        *r1 = _mm_unpackhi_epi64(t0, t1);
+        *r2 = _mm_unpacklo_epi64(t2, t3);
+        *r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+/**
+ * @brief Expands up to 4 keys
+ *
+ * @param keys      array of 4 pointers to keys (unused lanes can
+ *                  point to any valid key)
+ * @param enc       array of 4 pointers to encrypt key schedules
+ * @param dec       array of 4 pointers to decrypt key schedules or NULL
+ * @param num_lanes number of valid lanes (1 to 4)
+ * @param nk        key size in 32-bit words (4, 6 or 8)
+ */
+__forceinline
+void
+aes_keyexp_x4(const void * const keys[AES_KEYEXP_N_LANES],
+              void * const enc[AES_KEYEXP_N_LANES],
+              void * const *dec, const unsigned num_lanes,
+              const unsigned nk)
+{
+        const unsigned nr = nk + 6;
+        const unsigned num_words = (nr + 1) * 4;
+        const __m128i rot_sub = _mm_load_si128((const __m128i *)
+                                               rot_sub_word_shuf);
+        const __m128i sub = _mm_load_si128((const __m128i *) sub_word_shuf);
+        __m128i w[AES_KEYEXP_N_MAX_WORDS];
+        unsigned i, lane;
+
+        /* load and transpose keys into key schedule words */
+        w[0] = _mm_loadu_si128((const __m128i *) keys[0]);
+        w[1] = _mm_loadu_si128((const __m128i *) keys[1]);
+        w[2] = _mm_loadu_si128((const __m128i *) keys[2]);
+        w[3] = _mm_loadu_si128((const __m128i *) keys[3]);
+        transpose_4x4_u32(&w[0], &w[1], &w[2], &w[3]);
+
+        if (nk == 6) {
+                w[4] = _mm_loadl_epi64((const __m128i *)
+                                       ((const uint8_t *) keys[0] + 16));
+                w[5] = _mm_loadl_epi64((const __m128i *)
+                                       ((const uint8_t *) keys[1] + 16));
+                w[6] = _mm_loadl_epi64((const __m128i *)
+                                       ((const uint8_t *) keys[2] + 16));
+                w[7] = _mm_loadl_epi64((const __m128i *)
+                                       ((const uint8_t *) keys[3] + 16));
+                transpose_4x4_u32(&w[4], &w[5], &w[6], &w[7]);
+        } else if (nk == 8) {
+                w[4] = _mm_loadu_si128((const __m128i *)
+                                       ((const uint8_t *) keys[0] + 16));
+                w[5] = _mm_loadu_si128((const __m128i *)
+                                       ((const uint8_t *) keys[1] + 16));
+                w[6] = _mm_loadu_si128((const __m128i *)
+                                       ((const uint8_t *) keys[2] + 16));
+                w[7] = _mm_loadu_si128((const __m128i *)
+                                       ((const uint8_t *) keys[3] + 16));
+                transpose_4x4_u32(&w[4], &w[5], &w[6], &w[7]);
+        }
+
+        /* FIPS-197 key expansion on 4 keys at a time */
+        for (i = nk; i < num_words; i++) {
+                __m128i t = w[i - 1];
+
+                if ((i % nk) == 0)
+                        t = _mm_aesenclast_si128(_mm_shuffle_epi8(t, rot_sub),
+                                        _mm_set1_epi32(aes_rcon[i / nk - 1]));
+                else if (nk == 8 && (i % nk) == 4)
+                        t = _mm_aesenclast_si128(_mm_shuffle_epi8(t, sub),
+                                                 _mm_setzero_si128());
+
+                w[i] = _mm_xor_si128(w[i - nk], t);
+        }
+
+        /* transpose back into round keys and store */
+        for (i = 0; i <= nr; i++) {
+                __m128i rk[AES_KEYEXP_N_LANES];
+
+                rk[0] = w[i * 4 + 0];
+                rk[1] = w[i * 4 + 1];
+                rk[2] = w[i * 4 + 2];
+                rk[3] = w[i * 4 + 3];
+                transpose_4x4_u32(&rk[0], &rk[1], &rk[2], &rk[3]);
+
+                for (lane = 0; lane < num_lanes; lane++) {
+                        _mm_storeu_si128((__m128i *)
+                                         ((uint8_t *) enc[lane] + i * 16),
+                                         rk[lane]);
+                        if (dec == NULL)
+                                continue;
+                        if (i != 0 && i != nr)
+                                rk[lane] = _mm_aesimc_si128(rk[lane]);
+                        _mm_storeu_si128((__m128i *)
+                                         ((uint8_t *) dec[lane] +
+                                          (nr - i) * 16), rk[lane]);
+                }
+        }
+
+#ifdef SAFE_DATA
+        clear_mem(w, sizeof(w));
+#endif
+}
+
+/**
+ * @brief Expands any number of keys, 4 at a time
+ *
+ * @param keys     array of pointers to keys
+ * @param enc      array of pointers to encrypt key schedules
+ * @param dec      array of pointers to decrypt key schedules or NULL
+ * @param num_keys number of keys
+ * @param nk       key size in 32-bit words (4, 6 or 8)
+ */
+__forceinline
+void
+aes_keyexp_n(const void * const keys[], void * const enc[],
+             void * const dec[], const uint32_t num_keys, const unsigned nk)
+{
+        uint32_t i;
+
+        for (i = 0; i < num_keys; i += AES_KEYEXP_N_LANES) {
+                const void *lane_keys[AES_KEYEXP_N_LANES];
+                void *lane_enc[AES_KEYEXP_N_LANES];
+                void *lane_dec[AES_KEYEXP_N_LANES];
+                const unsigned num_lanes = (num_keys - i) < AES_KEYEXP_N_LANES ?
+                        (num_keys - i) : AES_KEYEXP_N_LANES;
+                unsigned lane;
+
+                for (lane = 0; lane < AES_KEYEXP_N_LANES; lane++) {
+                        /* unused lanes are fed with the first key */
+                        const unsigned idx = lane < num_lanes ? lane : 0;
+
+                        lane_keys[lane] = keys[i + idx];
+                        lane_enc[lane] = enc[i + idx];
+                        lane_dec[lane] = (dec != NULL) ? dec[i + idx] : NULL;
+                }
+                aes_keyexp_x4(lane_keys, lane_enc,
+                              (dec != NULL) ? lane_dec : NULL,
+                              num_lanes, nk);
+        }
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+}
+
+#ifdef SAFE_PARAM
+/**
+ * @brief Checks that all key and key schedule pointers are valid
+ *
+ * @return 0 - one of the pointers is NULL, 1 - all pointers are valid
+ */
+static int
+aes_keyexp_n_check(const void * const keys[], void * const enc[],
+                   const uint32_t num_keys)
+{
+        uint32_t i;
+
+        if (keys == NULL || enc == NULL)
+                return 0;
+
+        for (i = 0; i < num_keys; i++)
+                if (keys[i] == NULL || enc[i] == NULL)
+                        return 0;
+        return 1;
+}
+#endif
+
+#ifdef AES_KEYEXP_128_N
+void
+AES_KEYEXP_128_N(const void * const keys[], void * const enc_exp_keys[],
+                 void * const dec_exp_keys[], const uint32_t num_keys)
+{
+#ifdef SAFE_PARAM
+        if (!aes_keyexp_n_check(keys, enc_exp_keys, num_keys) ||
+            (dec_exp_keys != NULL &&
+             !aes_keyexp_n_check(keys, dec_exp_keys, num_keys)))
+                return;
+#endif
+        aes_keyexp_n(keys, enc_exp_keys, dec_exp_keys, num_keys, 4);
+}
+
+void
+AES_KEYEXP_192_N(const void * const keys[], void * const enc_exp_keys[],
+                 void * const dec_exp_keys[], const uint32_t num_keys)
+{
+#ifdef SAFE_PARAM
+        if (!aes_keyexp_n_check(keys, enc_exp_keys, num_keys) ||
+            (dec_exp_keys != NULL &&
+             !aes_keyexp_n_check(keys, dec_exp_keys, num_keys)))
+                return;
+#endif
+        aes_keyexp_n(keys, enc_exp_keys, dec_exp_keys, num_keys, 6);
+}
+
+void
+AES_KEYEXP_256_N(const void * const keys[], void * const enc_exp_keys[],
+                 void * const dec_exp_keys[], const uint32_t num_keys)
+{
+#ifdef SAFE_PARAM
+        if (!aes_keyexp_n_check(keys, enc_exp_keys, num_keys) ||
+            (dec_exp_keys != NULL &&
+             !aes_keyexp_n_check(keys, dec_exp_keys, num_keys)))
+                return;
+#endif
+        aes_keyexp_n(keys, enc_exp_keys, dec_exp_keys, num_keys, 8);
+}
+#endif /* AES_KEYEXP_128_N */
+
+#ifdef AES_GCM_PRE_128_N
+void
+AES_GCM_PRE_128_N(const void * const keys[],
+                  struct gcm_key_data * const key_data[],
+                  const uint32_t num_keys)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (!aes_keyexp_n_check(keys, (void * const *) key_data, num_keys))
+                return;
+#endif
+        /* expanded_keys is the first field of gcm_key_data */
+        aes_keyexp_n(keys, (void * const *) key_data, NULL, num_keys, 4);
+        for (i = 0; i < num_keys; i++)
+                GCM_PRECOMP_128(key_data[i]);
+}
+
+void
+AES_GCM_PRE_192_N(const void * const keys[],
+                  struct gcm_key_data * const key_data[],
+                  const uint32_t num_keys)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (!aes_keyexp_n_check(keys, (void * const *) key_data, num_keys))
+                return;
+#endif
+        aes_keyexp_n(keys, (void * const *) key_data, NULL, num_keys, 6);
+        for (i = 0; i < num_keys; i++)
+                GCM_PRECOMP_192(key_data[i]);
+}
+
+void
+AES_GCM_PRE_256_N(const void * const keys[],
+                  struct gcm_key_data * const key_data[],
+                  const uint32_t num_keys)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (!aes_keyexp_n_check(keys, (void * const *) key_data, num_keys))
+                return;
+#endif
+        aes_keyexp_n(keys, (void * const *) key_data, NULL, num_keys, 8);
+        for (i = 0; i < num_keys; i++)
+                GCM_PRECOMP_256(key_data[i]);
+}
+#endif /* AES_GCM_PRE_128_N */
+
+#endif /* AES_KEYEXP_N_COMMON_H */
@@ -0,0 +1,570 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/**
+ * AES-XTS (IEEE Std 1619-2007) with 128 and 256-bit keys,
+ * including ciphertext stealing for messages that are not
+ * a multiple of the block size.
+ *
+ * Full blocks are processed 8 at a time, with the tweaks of the next
+ * 8 blocks computed while the AES rounds are running.
+ *
+ * Architecture specific files need to define:
+ * - AES_XTS_128_ENC, AES_XTS_128_DEC, AES_XTS_256_ENC and AES_XTS_256_DEC
+ *   (API names)
+ * - SAVE_XMMS, RESTORE_XMMS and CLEAR_SCRATCH_SIMD_REGS
+ * - NO_AESNI, if AES instructions are to be emulated
+ * - AES_XTS_VAES, to process 16 blocks at a time in 4 ZMM registers
+ *   first (module compiled with VAES enabled)
+ */
+
+#ifndef AES_XTS_COMMON_H
+#define AES_XTS_COMMON_H
+
+#include <string.h>
+#include <stdint.h>
+#ifdef LINUX
+#include <x86intrin.h>
+#else
+#include <intrin.h>
+#endif
+
+#include "intel-ipsec-mb.h"
+#include "include/save_xmms.h"
+#include "include/clear_regs_mem.h"
+#ifdef NO_AESNI
+#include "include/aesni_emu.h"
+#endif
+
+#ifndef AES_BLOCK_SIZE
+#define AES_BLOCK_SIZE 16
+#endif
+
+#define AES_XTS_NUM_BLOCKS 8
+
+#ifdef NO_AESNI
+typedef void (*aes_xts_emu_t)(union xmm_reg *, const union xmm_reg *);
+
+__forceinline
+__m128i
+aes_xts_round_emu(const aes_xts_emu_t round, const __m128i b, const __m128i k)
+{
+        union xmm_reg x, y;
+
+        _mm_storeu_si128((__m128i *) x.byte, b);
+        _mm_storeu_si128((__m128i *) y.byte, k);
+        round(&x, &y);
+        return _mm_loadu_si128((const __m128i *) x.byte);
+}
+#define AES_XTS_ENC(_b, _k)      aes_xts_round_emu(emulate_AESENC, _b, _k)
+#define AES_XTS_ENCLAST(_b, _k)  aes_xts_round_emu(emulate_AESENCLAST, _b, _k)
+#define AES_XTS_DEC(_b, _k)      aes_xts_round_emu(emulate_AESDEC, _b, _k)
+#define AES_XTS_DECLAST(_b, _k)  aes_xts_round_emu(emulate_AESDECLAST, _b, _k)
+#else
+#define AES_XTS_ENC(_b, _k)      _mm_aesenc_si128(_b, _k)
+#define AES_XTS_ENCLAST(_b, _k)  _mm_aesenclast_si128(_b, _k)
+#define AES_XTS_DEC(_b, _k)      _mm_aesdec_si128(_b, _k)
+#define AES_XTS_DECLAST(_b, _k)  _mm_aesdeclast_si128(_b, _k)
+#endif
+
+/**
+ * @brief Multiplies the tweak by x (alpha) in GF(2^128), in a register
+ */
+__forceinline
+__m128i
+aes_xts_mul_x_reg(const __m128i t)
+{
+        /* sign of each 64-bit half, moved to the other half */
+        const __m128i carry =
+                _mm_shuffle_epi32(_mm_srai_epi32(t, 31), 0x5F);
+
+        return _mm_xor_si128(_mm_add_epi64(t, t),
+                             _mm_and_si128(carry,
+                                           _mm_setr_epi32(0x87, 0, 1, 0)));
+}
+
+/**
+ * @brief Encrypts 1 AES block
+ */
+__forceinline
+__m128i
+aes_xts_enc_block(__m128i b, const __m128i *keys, const unsigned nrounds)
+{
+        unsigned r;
+
+        b = _mm_xor_si128(b, _mm_loadu_si128(&keys[0]));
+        for (r = 1; r < nrounds; r++)
+                b = AES_XTS_ENC(b, _mm_loadu_si128(&keys[r]));
+        return AES_XTS_ENCLAST(b, _mm_loadu_si128(&keys[nrounds]));
+}
+
+/**
+ * @brief Decrypts 1 AES block
+ */
+__forceinline
+__m128i
+aes_xts_dec_block(__m128i b, const __m128i *keys, const unsigned nrounds)
+{
+        unsigned r;
+
+        b = _mm_xor_si128(b, _mm_loadu_si128(&keys[0]));
+        for (r = 1; r < nrounds; r++)
+                b = AES_XTS_DEC(b, _mm_loadu_si128(&keys[r]));
+        return AES_XTS_DECLAST(b, _mm_loadu_si128(&keys[nrounds]));
+}
+
+/**
+ * @brief Computes tweak of the first block (IV encrypted with tweak key)
+ */
+__forceinline
+__m128i
+aes_xts_init_tweak(const void *iv, const void *tweak_keys,
+                   const unsigned nrounds)
+{
+        const __m128i t = _mm_loadu_si128((const __m128i *) iv);
+
+        return aes_xts_enc_block(t, (const __m128i *) tweak_keys, nrounds);
+}
+
+/**
+ * @brief Encrypts or decrypts n blocks in parallel
+ *
+ * All input blocks are loaded before output is stored,
+ * so in place operation is supported.
+ *
+ * @param src     input blocks
+ * @param dst     output blocks
+ * @param k       expanded keys (encrypt or decrypt)
+ * @param t       tweak of the first block
+ * @param n       number of blocks (1 to 8, constant)
+ * @param nrounds number of AES rounds
+ * @param enc     1 to encrypt, 0 to decrypt
+ * @return tweak of the block following the last one
+ */
+__forceinline
+__m128i
+aes_xts_by_n(const __m128i *src, __m128i *dst, const __m128i *k, __m128i t,
+             const unsigned n, const unsigned nrounds, const int enc)
+{
+        const __m128i key0 = _mm_loadu_si128(&k[0]);
+        __m128i tw[AES_XTS_NUM_BLOCKS];
+        __m128i b[AES_XTS_NUM_BLOCKS];
+        __m128i key_last;
+        unsigned i, r;
+
+        tw[0] = t;
+        for (i = 1; i < n; i++)
+                tw[i] = aes_xts_mul_x_reg(tw[i - 1]);
+        for (i = 0; i < n; i++)
+                b[i] = _mm_xor_si128(_mm_loadu_si128(&src[i]),
+                                     _mm_xor_si128(tw[i], key0));
+
+        for (r = 1; r < nrounds; r++) {
+                const __m128i key = _mm_loadu_si128(&k[r]);
+
+                for (i = 0; i < n; i++)
+                        b[i] = enc ? AES_XTS_ENC(b[i], key) :
+                                AES_XTS_DEC(b[i], key);
+        }
+
+        key_last = _mm_loadu_si128(&k[nrounds]);
+        for (i = 0; i < n; i++) {
+                b[i] = enc ? AES_XTS_ENCLAST(b[i], key_last) :
+                        AES_XTS_DECLAST(b[i], key_last);
+                _mm_storeu_si128(&dst[i], _mm_xor_si128(b[i], tw[i]));
+        }
+
+        return aes_xts_mul_x_reg(tw[n - 1]);
+}
+
+#ifdef AES_XTS_VAES
+/**
+ * @brief Multiplies each of the 4 tweaks of a ZMM register by x^n
+ * in GF(2^128), n up to 16
+ *
+ * Bits shifted out of a tweak are reduced with shifts
+ * (x^128 = x^7 + x^2 + x + 1), so VPCLMULQDQ is not required.
+ */
+__forceinline
+__m512i
+aes_xts_mul_xn_zmm(const __m512i t, const unsigned n)
+{
+        const __m512i top = _mm512_srlv_epi64(t, _mm512_set1_epi64(64 - n));
+        /* top bits of the low quadwords move to the high quadwords */
+        const __m512i lo_to_hi = _mm512_bslli_epi128(top, 8);
+        /* top bits of the high quadwords are reduced */
+        const __m512i c = _mm512_bsrli_epi128(top, 8);
+        const __m512i red =
+                _mm512_ternarylogic_epi64(_mm512_slli_epi64(c, 7),
+                                          _mm512_slli_epi64(c, 2),
+                                          _mm512_xor_si512(
+                                                  _mm512_slli_epi64(c, 1),
+                                                  c), 0x96);
+
+        return _mm512_ternarylogic_epi64(_mm512_sllv_epi64(
+                                                 t, _mm512_set1_epi64(n)),
+                                         lo_to_hi, red, 0x96);
+}
+
+/**
+ * @brief Encrypts or decrypts blocks 16 at a time (4 blocks per ZMM)
+ *
+ * All input blocks of an iteration are loaded before output is stored,
+ * so in place operation is supported.
+ *
+ * @param src        input blocks
+ * @param dst        output blocks
+ * @param k          expanded keys (encrypt or decrypt)
+ * @param tweak      tweak of the first block on input and tweak of
+ *                   the block following the last processed one on output
+ * @param num_blocks number of blocks available
+ * @param nrounds    number of AES rounds
+ * @param enc        1 to encrypt, 0 to decrypt
+ * @return number of blocks processed (multiple of 16)
+ */
+__forceinline
+uint64_t
+aes_xts_by16_vaes(const __m128i *src, __m128i *dst, const __m128i *k,
+                  __m128i *tweak, const uint64_t num_blocks,
+                  const unsigned nrounds, const int enc)
+{
+        __m512i tw[4], b[4], key;
+        __m128i t1, t2, t3;
+        uint64_t n;
+        unsigned i, r;
+
+        if (num_blocks < 16)
+                return 0;
+
+        /* tweaks of the first 16 blocks */
+        t1 = aes_xts_mul_x_reg(*tweak);
+        t2 = aes_xts_mul_x_reg(t1);
+        t3 = aes_xts_mul_x_reg(t2);
+        tw[0] = _mm512_inserti32x4(_mm512_castsi128_si512(*tweak), t1, 1);
+        tw[0] = _mm512_inserti32x4(tw[0], t2, 2);
+        tw[0] = _mm512_inserti32x4(tw[0], t3, 3);
+        for (i = 1; i < 4; i++)
+                tw[i] = aes_xts_mul_xn_zmm(tw[i - 1], 4);
+
+        for (n = 0; (n + 16) <= num_blocks; n += 16) {
+                key = _mm512_broadcast_i32x4(_mm_loadu_si128(&k[0]));
+                for (i = 0; i < 4; i++)
+                        b[i] = _mm512_ternarylogic_epi64(
+                                _mm512_loadu_si512(&src[n + (4 * i)]),
+                                tw[i], key, 0x96);
+
+                for (r = 1; r < nrounds; r++) {
+                        key = _mm512_broadcast_i32x4(_mm_loadu_si128(&k[r]));
+                        for (i = 0; i < 4; i++)
+                                b[i] = enc ? _mm512_aesenc_epi128(b[i], key) :
+                                        _mm512_aesdec_epi128(b[i], key);
+                }
+
+                key = _mm512_broadcast_i32x4(_mm_loadu_si128(&k[nrounds]));
+                for (i = 0; i < 4; i++) {
+                        b[i] = enc ? _mm512_aesenclast_epi128(b[i], key) :
+                                _mm512_aesdeclast_epi128(b[i], key);
+                        _mm512_storeu_si512(&dst[n + (4 * i)],
+                                            _mm512_xor_si512(b[i], tw[i]));
+                        tw[i] = aes_xts_mul_xn_zmm(tw[i], 16);
+                }
+        }
+
+        *tweak = _mm512_castsi512_si128(tw[0]);
+        return n;
+}
+#endif /* AES_XTS_VAES */
+
+/**
+ * @brief Encrypts or decrypts full blocks
+ *
+ * Blocks are processed 16 at a time with VAES (AES_XTS_VAES),
+ * then 8 at a time. The 1 to 7 remaining blocks
+ * are processed in parallel as well, with the block count known
+ * at compile time so that blocks are kept in registers.
+ *
+ * @param in        input blocks
+ * @param t         tweak of the first block
+ * @param keys      expanded keys (encrypt or decrypt)
+ * @param out       output blocks
+ * @param len_bytes number of bytes to process (multiple of 16, can be 0)
+ * @param nrounds   number of AES rounds
+ * @param enc       1 to encrypt, 0 to decrypt
+ * @return tweak of the block following the last one
+ */
+__forceinline
+__m128i
+aes_xts_blocks(const void *in, __m128i t, const void *keys, void *out,
+               const uint64_t len_bytes, const unsigned nrounds,
+               const int enc)
+{
+        const __m128i *k = (const __m128i *) keys;
+        const __m128i *src = (const __m128i *) in;
+        __m128i *dst = (__m128i *) out;
+        const uint64_t num_blocks = len_bytes / AES_BLOCK_SIZE;
+        uint64_t n;
+
+#ifdef AES_XTS_VAES
+        n = aes_xts_by16_vaes(src, dst, k, &t, num_blocks, nrounds, enc);
+#else
+        n = 0;
+#endif
+        for (; (n + AES_XTS_NUM_BLOCKS) <= num_blocks;
+             n += AES_XTS_NUM_BLOCKS)
+                t = aes_xts_by_n(&src[n], &dst[n], k, t, AES_XTS_NUM_BLOCKS,
+                                 nrounds, enc);
+
+        switch (num_blocks - n) {
+        case 7:
+                t = aes_xts_by_n(&src[n], &dst[n], k, t, 7, nrounds, enc);
+                break;
+        case 6:
+                t = aes_xts_by_n(&src[n], &dst[n], k, t, 6, nrounds, enc);
+                break;
+        case 5:
+                t = aes_xts_by_n(&src[n], &dst[n], k, t, 5, nrounds, enc);
+                break;
+        case 4:
+                t = aes_xts_by_n(&src[n], &dst[n], k, t, 4, nrounds, enc);
+                break;
+        case 3:
+                t = aes_xts_by_n(&src[n], &dst[n], k, t, 3, nrounds, enc);
+                break;
+        case 2:
+                t = aes_xts_by_n(&src[n], &dst[n], k, t, 2, nrounds, enc);
+                break;
+        case 1:
+                t = aes_xts_by_n(&src[n], &dst[n], k, t, 1, nrounds, enc);
+                break;
+        default:
+                break;
+        }
+
+        return t;
+}
+
+/**
+ * @brief Swaps the partial block with the stolen cipher text
+ *
+ * Last partial output block is taken from the start of \a buf and
+ * \a buf gets the last partial input block in its place.
+ * Input is read before output is written so that in place operation
+ * is supported.
+ */
+static inline void
+aes_xts_steal(uint8_t *buf, const uint8_t *in, uint8_t *out,
+              const uint64_t partial)
+{
+        uint64_t i;
+
+        for (i = 0; i < partial; i++) {
+                const uint8_t c = buf[i];
+
+                buf[i] = in[i];
+                out[i] = c;
+        }
+}
+
+__forceinline
+void
+aes_xts_enc(const uint8_t *in, const void *iv, const void *keys,
+            const void *tweak_keys, uint8_t *out, const uint64_t len_bytes,
+            const unsigned nrounds)
+{
+        const uint64_t partial = len_bytes & (AES_BLOCK_SIZE - 1);
+        __m128i t = aes_xts_init_tweak(iv, tweak_keys, nrounds);
+
+        if (partial == 0) {
+                (void) aes_xts_blocks(in, t, keys, out, len_bytes, nrounds, 1);
+        } else {
+                DECLARE_ALIGNED(uint8_t buf[AES_BLOCK_SIZE], 16);
+                /* all full blocks except for the last one */
+                const uint64_t offset =
+                        (len_bytes & (~(AES_BLOCK_SIZE - 1))) -
+                        AES_BLOCK_SIZE;
+
+                t = aes_xts_blocks(in, t, keys, out, offset, nrounds, 1);
+
+                /* CC = last full block encrypted with tweak m - 1 */
+                t = aes_xts_blocks(in + offset, t, keys, buf, AES_BLOCK_SIZE,
+                                   nrounds, 1);
+
+                /* C(m) = head of CC, PP = P(m) | tail of CC */
+                aes_xts_steal(buf, in + offset + AES_BLOCK_SIZE,
+                              out + offset + AES_BLOCK_SIZE, partial);
+
+                /* C(m - 1) = PP encrypted with tweak m */
+                (void) aes_xts_blocks(buf, t, keys, out + offset,
+                                      AES_BLOCK_SIZE, nrounds, 1);
+#ifdef SAFE_DATA
+                clear_mem(buf, sizeof(buf));
+#endif
+        }
+}
+
+__forceinline
+void
+aes_xts_dec(const uint8_t *in, const void *iv, const void *keys,
+            const void *tweak_keys, uint8_t *out, const uint64_t len_bytes,
+            const unsigned nrounds)
+{
+        const uint64_t partial = len_bytes & (AES_BLOCK_SIZE - 1);
+        __m128i t = aes_xts_init_tweak(iv, tweak_keys, nrounds);
+
+        if (partial == 0) {
+                (void) aes_xts_blocks(in, t, keys, out, len_bytes, nrounds, 0);
+        } else {
+                DECLARE_ALIGNED(uint8_t buf[AES_BLOCK_SIZE], 16);
+                /* all full blocks except for the last one */
+                const uint64_t offset =
+                        (len_bytes & (~(AES_BLOCK_SIZE - 1))) -
+                        AES_BLOCK_SIZE;
+
+                t = aes_xts_blocks(in, t, keys, out, offset, nrounds, 0);
+
+                /* PP = last full block decrypted with tweak m, not m - 1 */
+                (void) aes_xts_blocks(in + offset, aes_xts_mul_x_reg(t), keys,
+                                      buf, AES_BLOCK_SIZE, nrounds, 0);
+
+                /* P(m) = head of PP, CC = C(m) | tail of PP */
+                aes_xts_steal(buf, in + offset + AES_BLOCK_SIZE,
+                              out + offset + AES_BLOCK_SIZE, partial);
+
+                /* P(m - 1) = CC decrypted with tweak m - 1 */
+                (void) aes_xts_blocks(buf, t, keys, out + offset,
+                                      AES_BLOCK_SIZE, nrounds, 0);
+#ifdef SAFE_DATA
+                clear_mem(buf, sizeof(buf));
+#endif
+        }
+}
+
+void
+AES_XTS_128_ENC(const void *in, const void *iv, const void *keys,
+                const void *tweak_keys, void *out, const uint64_t len_bytes)
+{
+#ifndef LINUX
+        DECLARE_ALIGNED(imb_uint128_t xmm_save[10], 16);
+#endif
+#ifdef SAFE_PARAM
+        if (in == NULL || iv == NULL || keys == NULL || tweak_keys == NULL ||
+            out == NULL || len_bytes < AES_BLOCK_SIZE)
+                return;
+#endif
+#ifndef LINUX
+        SAVE_XMMS(xmm_save);
+#endif
+        aes_xts_enc(in, iv, keys, tweak_keys, out, len_bytes, 10);
+#ifdef SAFE_DATA
+        /* Clear sensitive data in registers */
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+#ifndef LINUX
+        RESTORE_XMMS(xmm_save);
+#endif
+}
+
+void
+AES_XTS_128_DEC(const void *in, const void *iv, const void *keys,
+                const void *tweak_keys, void *out, const uint64_t len_bytes)
+{
+#ifndef LINUX
+        DECLARE_ALIGNED(imb_uint128_t xmm_save[10], 16);
+#endif
+#ifdef SAFE_PARAM
+        if (in == NULL || iv == NULL || keys == NULL || tweak_keys == NULL ||
+            out == NULL || len_bytes < AES_BLOCK_SIZE)
+                return;
+#endif
+#ifndef LINUX
+        SAVE_XMMS(xmm_save);
+#endif
+        aes_xts_dec(in, iv, keys, tweak_keys, out, len_bytes, 10);
+#ifdef SAFE_DATA
+        /* Clear sensitive data in registers */
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+#ifndef LINUX
+        RESTORE_XMMS(xmm_save);
+#endif
+}
+
+void
+AES_XTS_256_ENC(const void *in, const void *iv, const void *keys,
+                const void *tweak_keys, void *out, const uint64_t len_bytes)
+{
+#ifndef LINUX
+        DECLARE_ALIGNED(imb_uint128_t xmm_save[10], 16);
+#endif
+#ifdef SAFE_PARAM
+        if (in == NULL || iv == NULL || keys == NULL || tweak_keys == NULL ||
+            out == NULL || len_bytes < AES_BLOCK_SIZE)
+                return;
+#endif
+#ifndef LINUX
+        SAVE_XMMS(xmm_save);
+#endif
+        aes_xts_enc(in, iv, keys, tweak_keys, out, len_bytes, 14);
+#ifdef SAFE_DATA
+        /* Clear sensitive data in registers */
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+#ifndef LINUX
+        RESTORE_XMMS(xmm_save);
+#endif
+}
+
+void
+AES_XTS_256_DEC(const void *in, const void *iv, const void *keys,
+                const void *tweak_keys, void *out, const uint64_t len_bytes)
+{
+#ifndef LINUX
+        DECLARE_ALIGNED(imb_uint128_t xmm_save[10], 16);
+#endif
+#ifdef SAFE_PARAM
+        if (in == NULL || iv == NULL || keys == NULL || tweak_keys == NULL ||
+            out == NULL || len_bytes < AES_BLOCK_SIZE)
+                return;
+#endif
+#ifndef LINUX
+        SAVE_XMMS(xmm_save);
+#endif
+        aes_xts_dec(in, iv, keys, tweak_keys, out, len_bytes, 14);
+#ifdef SAFE_DATA
+        /* Clear sensitive data in registers */
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+#ifndef LINUX
+        RESTORE_XMMS(xmm_save);
+#endif
+}
+
+#endif /* AES_XTS_COMMON_H */
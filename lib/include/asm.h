@@ -195,6 +195,19 @@ void aes_ecb_dec_192_avx(const void *in, const void *keys,
 void aes_ecb_dec_128_avx(const void *in, const void *keys,
                          void *out, uint64_t len_bytes);
 
+void aes_ecb_enc_256_vaes_avx512(const void *in, const void *keys,
+                                 void *out, uint64_t len_bytes);
+void aes_ecb_enc_192_vaes_avx512(const void *in, const void *keys,
+                                 void *out, uint64_t len_bytes);
+void aes_ecb_enc_128_vaes_avx512(const void *in, const void *keys,
+                                 void *out, uint64_t len_bytes);
+void aes_ecb_dec_256_vaes_avx512(const void *in, const void *keys,
+                                 void *out, uint64_t len_bytes);
+void aes_ecb_dec_192_vaes_avx512(const void *in, const void *keys,
+                                 void *out, uint64_t len_bytes);
+void aes_ecb_dec_128_vaes_avx512(const void *in, const void *keys,
+                                 void *out, uint64_t len_bytes);
+
 /* AES128-ECBENC */
 void aes128_ecbenc_x3_sse(const void *in, void *keys,
                           void *out1, void *out2, void *out3);
@@ -221,6 +234,41 @@ IMB_JOB *submit_job_pon_dec_no_ctr_sse(IMB_JOB *job);
 
 IMB_JOB *submit_job_pon_enc_no_ctr_sse_no_aesni(IMB_JOB *job);
 IMB_JOB *submit_job_pon_dec_no_ctr_sse_no_aesni(IMB_JOB *job);
+
+IMB_JOB *submit_job_pon_enc_vaes_avx512(IMB_JOB *job);
+IMB_JOB *submit_job_pon_dec_vaes_avx512(IMB_JOB *job);
+IMB_JOB *submit_job_pon_enc_no_ctr_vaes_avx512(IMB_JOB *job);
+IMB_JOB *submit_job_pon_dec_no_ctr_vaes_avx512(IMB_JOB *job);
+
+/* AES-CFB VAES (C) */
+void aes_cfb_dec_128_vaes_avx512(const void *in, const uint8_t *IV,
+                                 const void *keys, void *out,
+                                 uint64_t len_bytes);
+void aes_cfb_dec_256_vaes_avx512(const void *in, const uint8_t *IV,
+                                 const void *keys, void *out,
+                                 uint64_t len_bytes);
+
+/* AES-XTS VAES (C) */
+void aes_xts_128_enc_vaes_avx512(const void *in, const void *iv,
+                                 const void *keys, const void *tweak_keys,
+                                 void *out, const uint64_t len_bytes);
+void aes_xts_128_dec_vaes_avx512(const void *in, const void *iv,
+                                 const void *keys, const void *tweak_keys,
+                                 void *out, const uint64_t len_bytes);
+void aes_xts_256_enc_vaes_avx512(const void *in, const void *iv,
+                                 const void *keys, const void *tweak_keys,
+                                 void *out, const uint64_t len_bytes);
+void aes_xts_256_dec_vaes_avx512(const void *in, const void *iv,
+                                 const void *keys, const void *tweak_keys,
+                                 void *out, const uint64_t len_bytes);
+
+/* SHA one block update (digest in internal state format) */
+void sha1_block_sse(const void *data, void *digest);
+void sha1_block_avx(const void *data, void *digest);
+void sha256_block_sse(const void *data, void *digest);
+void sha256_block_avx(const void *data, void *digest);
+void sha512_block_sse(const void *data, void *digest);
+void sha512_block_avx(const void *data, void *digest);
 #endif /* IMB_ASM_H */
 
 
@@ -0,0 +1,125 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+
+#include "intel-ipsec-mb.h"
+
+/*
+ * Folding constants of a CRC computed on a 32-bit basis.
+ * CRCs narrower than 32 bits use polynomial P * x^(32 - width).
+ *
+ * Each pair below holds constants for folding by D bits:
+ * - non-reflected CRC: x^D mod P (low), x^(D+64) mod P (high)
+ * - reflected CRC:     bit reflected and shifted left by 1
+ *                      x^(D-32) mod P (low), x^(D+32) mod P (high)
+ *
+ * The structure layout is used by the assembly code, don't change it.
+ */
+struct crc32_fold_const {
+        DECLARE_ALIGNED(uint64_t fold_1x128[2], 16); /* D = 128 */
+        uint64_t fold_4x128[2];                      /* D = 512 */
+        uint64_t reduce[2];         /* fold into x^96 and x^64 terms */
+        uint64_t barrett[2];        /* floor(x^64 / P) and P */
+        uint64_t fold_16x128[2];                     /* D = 2048 */
+};
+
+IMB_DLL_LOCAL extern const struct crc32_fold_const crc32_ethernet_fcs_const;
+IMB_DLL_LOCAL extern const struct crc32_fold_const crc32_sctp_const;
+IMB_DLL_LOCAL extern const struct crc32_fold_const crc16_x25_const;
+IMB_DLL_LOCAL extern const struct crc32_fold_const crc24_lte_a_const;
+IMB_DLL_LOCAL extern const struct crc32_fold_const crc24_lte_b_const;
+IMB_DLL_LOCAL extern const struct crc32_fold_const crc16_fp_data_const;
+IMB_DLL_LOCAL extern const struct crc32_fold_const crc11_fp_header_const;
+IMB_DLL_LOCAL extern const struct crc32_fold_const crc7_fp_header_const;
+IMB_DLL_LOCAL extern const struct crc32_fold_const crc10_iuup_data_const;
+IMB_DLL_LOCAL extern const struct crc32_fold_const crc6_iuup_header_const;
+
+/* SSE */
+uint32_t crc32_ethernet_fcs_sse(const void *msg, const uint64_t len);
+uint32_t crc32_sctp_sse(const void *msg, const uint64_t len);
+uint32_t crc16_x25_sse(const void *msg, const uint64_t len);
+uint32_t crc24_lte_a_sse(const void *msg, const uint64_t len);
+uint32_t crc24_lte_b_sse(const void *msg, const uint64_t len);
+uint32_t crc16_fp_data_sse(const void *msg, const uint64_t len);
+uint32_t crc11_fp_header_sse(const void *msg, const uint64_t len);
+uint32_t crc7_fp_header_sse(const void *msg, const uint64_t len);
+uint32_t crc10_iuup_data_sse(const void *msg, const uint64_t len);
+uint32_t crc6_iuup_header_sse(const void *msg, const uint64_t len);
+
+/* SSE without AESNI (PCLMULQDQ emulation) */
+uint32_t crc32_ethernet_fcs_sse_no_aesni(const void *msg, const uint64_t len);
+uint32_t crc32_sctp_sse_no_aesni(const void *msg, const uint64_t len);
+uint32_t crc16_x25_sse_no_aesni(const void *msg, const uint64_t len);
+uint32_t crc24_lte_a_sse_no_aesni(const void *msg, const uint64_t len);
+uint32_t crc24_lte_b_sse_no_aesni(const void *msg, const uint64_t len);
+uint32_t crc16_fp_data_sse_no_aesni(const void *msg, const uint64_t len);
+uint32_t crc11_fp_header_sse_no_aesni(const void *msg, const uint64_t len);
+uint32_t crc7_fp_header_sse_no_aesni(const void *msg, const uint64_t len);
+uint32_t crc10_iuup_data_sse_no_aesni(const void *msg, const uint64_t len);
+uint32_t crc6_iuup_header_sse_no_aesni(const void *msg, const uint64_t len);
+
+/* AVX (also used by AVX2) */
+uint32_t crc32_ethernet_fcs_avx(const void *msg, const uint64_t len);
+uint32_t crc32_sctp_avx(const void *msg, const uint64_t len);
+uint32_t crc16_x25_avx(const void *msg, const uint64_t len);
+uint32_t crc24_lte_a_avx(const void *msg, const uint64_t len);
+uint32_t crc24_lte_b_avx(const void *msg, const uint64_t len);
+uint32_t crc16_fp_data_avx(const void *msg, const uint64_t len);
+uint32_t crc11_fp_header_avx(const void *msg, const uint64_t len);
+uint32_t crc7_fp_header_avx(const void *msg, const uint64_t len);
+uint32_t crc10_iuup_data_avx(const void *msg, const uint64_t len);
+uint32_t crc6_iuup_header_avx(const void *msg, const uint64_t len);
+
+/* AVX512 */
+uint32_t crc32_ethernet_fcs_avx512(const void *msg, const uint64_t len);
+uint32_t crc32_sctp_avx512(const void *msg, const uint64_t len);
+uint32_t crc16_x25_avx512(const void *msg, const uint64_t len);
+uint32_t crc24_lte_a_avx512(const void *msg, const uint64_t len);
+uint32_t crc24_lte_b_avx512(const void *msg, const uint64_t len);
+uint32_t crc16_fp_data_avx512(const void *msg, const uint64_t len);
+uint32_t crc11_fp_header_avx512(const void *msg, const uint64_t len);
+uint32_t crc7_fp_header_avx512(const void *msg, const uint64_t len);
+uint32_t crc10_iuup_data_avx512(const void *msg, const uint64_t len);
+uint32_t crc6_iuup_header_avx512(const void *msg, const uint64_t len);
+
+/* AVX512 with VPCLMULQDQ (zmm folding of large buffers) */
+uint32_t crc32_ethernet_fcs_vaes_avx512(const void *msg, const uint64_t len);
+uint32_t crc32_sctp_vaes_avx512(const void *msg, const uint64_t len);
+uint32_t crc16_x25_vaes_avx512(const void *msg, const uint64_t len);
+uint32_t crc24_lte_a_vaes_avx512(const void *msg, const uint64_t len);
+uint32_t crc24_lte_b_vaes_avx512(const void *msg, const uint64_t len);
+uint32_t crc16_fp_data_vaes_avx512(const void *msg, const uint64_t len);
+uint32_t crc11_fp_header_vaes_avx512(const void *msg, const uint64_t len);
+uint32_t crc7_fp_header_vaes_avx512(const void *msg, const uint64_t len);
+uint32_t crc10_iuup_data_vaes_avx512(const void *msg, const uint64_t len);
+uint32_t crc6_iuup_header_vaes_avx512(const void *msg, const uint64_t len);
+
+#endif /* CRC_H */
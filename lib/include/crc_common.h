@@ -0,0 +1,623 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*-----------------------------------------------------------------------
+ * CRC computation with carry-less multiplication (PCLMULQDQ).
+ *
+ * All CRCs are computed on a 32-bit basis (see include/crc.h).
+ * The message is folded 128 bits at a time into a 128-bit value:
+ * - 4 x 128 bits in parallel for buffers of 64 bytes and more
+ * - 16 x 128 bits in 4 zmm registers for buffers of 256 bytes and more,
+ *   if CRC_FOLD_ZMM is defined (AVX512 with VPCLMULQDQ)
+ * and the result is reduced to 32 bits with Barrett reduction.
+ *
+ * The including file must define:
+ * - CRC32_ETHERNET_FCS, CRC32_SCTP, CRC16_X25, CRC24_LTE_A, CRC24_LTE_B,
+ *   CRC16_FP_DATA, CRC11_FP_HEADER, CRC7_FP_HEADER, CRC10_IUUP_DATA,
+ *   CRC6_IUUP_HEADER (API function names)
+ * - ETHERNET_FCS (Ethernet FCS assembly implementation)
+ * and NO_AESNI if PCLMULQDQ is to be emulated.
+ * With CRC_FOLD_ONLY defined, only the folding helpers are provided.
+ *-----------------------------------------------------------------------*/
+
+#ifndef CRC_COMMON_H
+#define CRC_COMMON_H
+
+#include <stdint.h>
+#include <string.h>
+#ifdef LINUX
+#include <x86intrin.h>
+#else
+#include <intrin.h>
+#endif
+
+#include "intel-ipsec-mb.h"
+#include "include/crc.h"
+#ifdef NO_AESNI
+#include "include/aesni_emu.h"
+#endif
+
+#ifndef CRC_FOLD_ONLY
+uint32_t ETHERNET_FCS(const void *msg, uint64_t len, const void *tag_output);
+#endif
+
+#ifdef NO_AESNI
+__forceinline
+__m128i crc_clmul_emu(const __m128i a, const __m128i b, const uint32_t imm)
+{
+        union xmm_reg x, y;
+
+        _mm_storeu_si128((__m128i *) x.byte, a);
+        _mm_storeu_si128((__m128i *) y.byte, b);
+        emulate_PCLMULQDQ(&x, &y, imm);
+        return _mm_loadu_si128((const __m128i *) x.byte);
+}
+#define CRC_CLMUL(_a, _b, _imm) crc_clmul_emu(_a, _b, _imm)
+#else
+#define CRC_CLMUL(_a, _b, _imm) _mm_clmulepi64_si128(_a, _b, _imm)
+#endif
+
+/* PSHUFB masks for byte shifts: load at (16 - n) shifts left by n bytes,
+ * at (16 + n) shifts right by n bytes */
+static const uint8_t crc_shift_tab[48] = {
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80
+};
+
+/* Byte reflection of 128 bits (non-reflected CRC data load) */
+static const DECLARE_ALIGNED(uint8_t crc_bswap_tab[16], 16) = {
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08,
+        0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00
+};
+
+__forceinline
+__m128i crc_shl_bytes(const __m128i x, const uint64_t n)
+{
+        return _mm_shuffle_epi8(x, _mm_loadu_si128((const __m128i *)
+                                                   &crc_shift_tab[16 - n]));
+}
+
+__forceinline
+__m128i crc_shr_bytes(const __m128i x, const uint64_t n)
+{
+        return _mm_shuffle_epi8(x, _mm_loadu_si128((const __m128i *)
+                                                   &crc_shift_tab[16 + n]));
+}
+
+__forceinline
+__m128i crc_load_bswap(const uint8_t *p)
+{
+        return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) p),
+                                _mm_load_si128((const __m128i *)
+                                               crc_bswap_tab));
+}
+
+__forceinline
+__m128i crc_load_partial(const uint8_t *p, const uint64_t n)
+{
+        DECLARE_ALIGNED(uint8_t buf[16], 16);
+
+        memset(buf, 0, sizeof(buf));
+        memcpy(buf, p, n);
+        return _mm_load_si128((const __m128i *) buf);
+}
+
+/* Non-reflected fold: X * x^D */
+__forceinline
+__m128i crc_fold(const __m128i x, const __m128i k)
+{
+        return _mm_xor_si128(CRC_CLMUL(x, k, 0x00), CRC_CLMUL(x, k, 0x11));
+}
+
+/* Reflected fold: X * x^D */
+__forceinline
+__m128i crc_refl_fold(const __m128i x, const __m128i k)
+{
+        return _mm_xor_si128(CRC_CLMUL(x, k, 0x01), CRC_CLMUL(x, k, 0x10));
+}
+
+#ifdef CRC_FOLD_ZMM
+/* 4 x 128 bits, byte reflected for non-reflected CRC */
+__forceinline
+__m512i crc_load_zmm(const uint8_t *p, const int refl)
+{
+        const __m512i x = _mm512_loadu_si512(p);
+
+        if (refl)
+                return x;
+
+        return _mm512_shuffle_epi8(x, _mm512_broadcast_i32x4(
+                                           _mm_load_si128((const __m128i *)
+                                                          crc_bswap_tab)));
+}
+
+/* Fold of 4 x 128 bits: X * x^D */
+__forceinline
+__m512i crc_fold_zmm(const __m512i x, const __m512i k, const int refl)
+{
+        if (refl)
+                return _mm512_xor_si512(_mm512_clmulepi64_epi128(x, k, 0x01),
+                                        _mm512_clmulepi64_epi128(x, k, 0x10));
+
+        return _mm512_xor_si512(_mm512_clmulepi64_epi128(x, k, 0x00),
+                                _mm512_clmulepi64_epi128(x, k, 0x11));
+}
+
+/**
+ * @brief Folds the message 256 bytes at a time (16 x 128 bits in 4 zmm)
+ *        and then 64 bytes at a time (4 x 128 bits in 1 zmm)
+ *
+ * @param c    folding constants
+ * @param x    4 x 128 bits folded so far, from the 64 bytes before *pp
+ *             (updated)
+ * @param pp   message pointer, at least 192 bytes left (updated)
+ * @param plen message length left, less than 64 on return (updated)
+ * @param refl reflected (1) or non-reflected (0) CRC
+ */
+__forceinline
+void crc_fold_by16(const struct crc32_fold_const *c, __m128i *x,
+                   const uint8_t **pp, uint64_t *plen, const int refl)
+{
+        const __m512i k16 = _mm512_broadcast_i32x4(
+                _mm_loadu_si128((const __m128i *) c->fold_16x128));
+        const __m512i k4 = _mm512_broadcast_i32x4(
+                _mm_loadu_si128((const __m128i *) c->fold_4x128));
+        const uint8_t *p = *pp;
+        uint64_t len = *plen;
+        __m512i z0, z1, z2, z3;
+
+        z0 = _mm512_castsi128_si512(x[0]);
+        z0 = _mm512_inserti32x4(z0, x[1], 1);
+        z0 = _mm512_inserti32x4(z0, x[2], 2);
+        z0 = _mm512_inserti32x4(z0, x[3], 3);
+        z1 = crc_load_zmm(p, refl);
+        z2 = crc_load_zmm(p + 64, refl);
+        z3 = crc_load_zmm(p + 128, refl);
+        p += 192;
+        len -= 192;
+
+        while (len >= 256) {
+                z0 = _mm512_xor_si512(crc_fold_zmm(z0, k16, refl),
+                                      crc_load_zmm(p, refl));
+                z1 = _mm512_xor_si512(crc_fold_zmm(z1, k16, refl),
+                                      crc_load_zmm(p + 64, refl));
+                z2 = _mm512_xor_si512(crc_fold_zmm(z2, k16, refl),
+                                      crc_load_zmm(p + 128, refl));
+                z3 = _mm512_xor_si512(crc_fold_zmm(z3, k16, refl),
+                                      crc_load_zmm(p + 192, refl));
+                p += 256;
+                len -= 256;
+        }
+
+        z0 = _mm512_xor_si512(crc_fold_zmm(z0, k4, refl), z1);
+        z0 = _mm512_xor_si512(crc_fold_zmm(z0, k4, refl), z2);
+        z0 = _mm512_xor_si512(crc_fold_zmm(z0, k4, refl), z3);
+
+        while (len >= 64) {
+                z0 = _mm512_xor_si512(crc_fold_zmm(z0, k4, refl),
+                                      crc_load_zmm(p, refl));
+                p += 64;
+                len -= 64;
+        }
+
+        x[0] = _mm512_castsi512_si128(z0);
+        x[1] = _mm512_extracti32x4_epi32(z0, 1);
+        x[2] = _mm512_extracti32x4_epi32(z0, 2);
+        x[3] = _mm512_extracti32x4_epi32(z0, 3);
+        *pp = p;
+        *plen = len;
+}
+#endif /* CRC_FOLD_ZMM */
+
+/**
+ * @brief Non-reflected CRC on 32-bit basis
+ *
+ * @param c    folding constants
+ * @param init initial CRC value (shifted to the top bits)
+ * @param p    message
+ * @param len  message length in bytes
+ *
+ * @return CRC value (in the top bits), without final XOR
+ */
+__forceinline
+uint32_t crc32_calc(const struct crc32_fold_const *c, const uint32_t init,
+                    const uint8_t *p, uint64_t len)
+{
+        const __m128i k1 = _mm_load_si128((const __m128i *) c->fold_1x128);
+        const __m128i kr = _mm_load_si128((const __m128i *) c->reduce);
+        const __m128i kb = _mm_load_si128((const __m128i *) c->barrett);
+        __m128i x, y;
+
+        if (len == 0)
+                return init;
+
+        if (len < 16) {
+                /* message bytes at the top of the buffer: X = M */
+                x = crc_load_partial(p, len);
+                x = _mm_shuffle_epi8(x, _mm_load_si128((const __m128i *)
+                                                       crc_bswap_tab));
+                x = crc_shr_bytes(x, 16 - len);
+
+                if (len < 4) {
+                        /* CRC = (M * x^32 + init * x^(8 * len)) mod P */
+                        x = _mm_slli_epi64(x, 32);
+                        x = _mm_xor_si128(x, _mm_cvtsi64_si128(
+                                                  (uint64_t) init <<
+                                                  (8 * len)));
+                        goto barrett;
+                }
+                /* init XOR'ed into the first 32 bits of the message */
+                x = _mm_xor_si128(x, crc_shl_bytes(_mm_cvtsi32_si128(init),
+                                                   len - 4));
+                goto reduce;
+        }
+
+        x = _mm_xor_si128(crc_load_bswap(p),
+                          _mm_slli_si128(_mm_cvtsi32_si128(init), 12));
+        p += 16;
+        len -= 16;
+
+        if (len >= 64) {
+                const __m128i k4 =
+                        _mm_load_si128((const __m128i *) c->fold_4x128);
+                __m128i x4[4];
+
+                x4[0] = _mm_xor_si128(crc_fold(x, k1), crc_load_bswap(p));
+                x4[1] = crc_load_bswap(p + 16);
+                x4[2] = crc_load_bswap(p + 32);
+                x4[3] = crc_load_bswap(p + 48);
+                p += 64;
+                len -= 64;
+
+#ifdef CRC_FOLD_ZMM
+                if (len >= 192)
+                        crc_fold_by16(c, x4, &p, &len, 0);
+#endif
+                while (len >= 64) {
+                        x4[0] = _mm_xor_si128(crc_fold(x4[0], k4),
+                                              crc_load_bswap(p));
+                        x4[1] = _mm_xor_si128(crc_fold(x4[1], k4),
+                                              crc_load_bswap(p + 16));
+                        x4[2] = _mm_xor_si128(crc_fold(x4[2], k4),
+                                              crc_load_bswap(p + 32));
+                        x4[3] = _mm_xor_si128(crc_fold(x4[3], k4),
+                                              crc_load_bswap(p + 48));
+                        p += 64;
+                        len -= 64;
+                }
+
+                x = _mm_xor_si128(crc_fold(x4[0], k1), x4[1]);
+                x = _mm_xor_si128(crc_fold(x, k1), x4[2]);
+                x = _mm_xor_si128(crc_fold(x, k1), x4[3]);
+        }
+
+        while (len >= 16) {
+                x = _mm_xor_si128(crc_fold(x, k1), crc_load_bswap(p));
+                p += 16;
+                len -= 16;
+        }
+
+        if (len != 0) {
+                /* X * x^(8 * len) + last bytes of the message */
+                __m128i t = crc_load_bswap(p + len - 16);
+
+                t = crc_shr_bytes(crc_shl_bytes(t, 16 - len), 16 - len);
+                y = crc_shr_bytes(x, 16 - len);
+                x = _mm_xor_si128(crc_shl_bytes(x, len), t);
+                x = _mm_xor_si128(x, crc_fold(y, k1));
+        }
+
+ reduce:
+        /* X * x^32: fold 128 bits into 96 bits and then into 64 bits */
+        y = _mm_slli_si128(_mm_move_epi64(x), 4);
+        x = _mm_xor_si128(CRC_CLMUL(x, kr, 0x01), y);
+        y = _mm_move_epi64(x);
+        x = _mm_xor_si128(CRC_CLMUL(_mm_srli_si128(x, 8), kr, 0x10), y);
+
+ barrett:
+        /* 64 bits into 32 bits */
+        y = CRC_CLMUL(_mm_srli_epi64(x, 32), kb, 0x00);
+        y = CRC_CLMUL(_mm_srli_epi64(y, 32), kb, 0x10);
+        return (uint32_t) _mm_cvtsi128_si32(_mm_xor_si128(x, y));
+}
+
+/**
+ * @brief Reduces reflected 128-bit CRC remainder to 32 bits
+ *
+ * @param c    folding constants
+ * @param x    remainder (message bits from the bottom)
+ * @param bits 128 or 64 (remainder already in the top 64 bits)
+ *
+ * @return CRC value (in the bottom bits), without final XOR
+ */
+__forceinline
+uint32_t crc32_refl_reduce(const struct crc32_fold_const *c, __m128i x,
+                           const int bits)
+{
+        const __m128i kr = _mm_load_si128((const __m128i *) c->reduce);
+        const __m128i kb = _mm_load_si128((const __m128i *) c->barrett);
+        __m128i y;
+
+        if (bits == 128) {
+                /* 128 bits into 64 bits */
+                x = _mm_xor_si128(CRC_CLMUL(x, kr, 0x00),
+                                  _mm_srli_si128(x, 8));
+                x = _mm_xor_si128(CRC_CLMUL(_mm_slli_si128(x, 4), kr, 0x10),
+                                  x);
+        }
+
+        /* 64 bits into 32 bits */
+        x = _mm_and_si128(x, _mm_set_epi32(-1, -1, -1, 0));
+        y = CRC_CLMUL(x, kb, 0x00);
+        y = _mm_and_si128(_mm_xor_si128(y, x), _mm_set_epi32(0, 0, -1, -1));
+        y = CRC_CLMUL(y, kb, 0x10);
+        return (uint32_t) _mm_extract_epi32(_mm_xor_si128(y, x), 2);
+}
+
+/**
+ * @brief Completes reflected CRC on 32-bit basis
+ *
+ * @param c    folding constants
+ * @param x    128 bits folded so far, from the message before p
+ * @param p    rest of the message
+ * @param len  rest of the message length in bytes
+ *
+ * @return CRC value (in the bottom bits), without final XOR
+ */
+__forceinline
+uint32_t crc32_refl_finish(const struct crc32_fold_const *c, __m128i x,
+                           const uint8_t *p, uint64_t len)
+{
+        const __m128i k1 = _mm_load_si128((const __m128i *) c->fold_1x128);
+        __m128i y;
+
+        while (len >= 16) {
+                x = _mm_xor_si128(crc_refl_fold(x, k1),
+                                  _mm_loadu_si128((const __m128i *) p));
+                p += 16;
+                len -= 16;
+        }
+
+        if (len != 0) {
+                /* X * x^(8 * len) + last bytes of the message */
+                __m128i t = _mm_loadu_si128((const __m128i *)
+                                            (p + len - 16));
+
+                t = crc_shl_bytes(crc_shr_bytes(t, 16 - len), 16 - len);
+                y = crc_shl_bytes(x, 16 - len);
+                x = _mm_xor_si128(crc_shr_bytes(x, len), t);
+                x = _mm_xor_si128(x, crc_refl_fold(y, k1));
+        }
+
+        return crc32_refl_reduce(c, x, 128);
+}
+
+/**
+ * @brief Reflected CRC on 32-bit basis
+ *
+ * @param c    folding constants
+ * @param init initial CRC value (in the bottom bits)
+ * @param p    message
+ * @param len  message length in bytes
+ *
+ * @return CRC value (in the bottom bits), without final XOR
+ */
+__forceinline
+uint32_t crc32_refl_calc(const struct crc32_fold_const *c,
+                         const uint32_t init, const uint8_t *p, uint64_t len)
+{
+        const __m128i k1 = _mm_load_si128((const __m128i *) c->fold_1x128);
+        __m128i x;
+
+        if (len == 0)
+                return init;
+
+        if (len < 16) {
+                x = _mm_xor_si128(crc_load_partial(p, len),
+                                  _mm_cvtsi32_si128(init));
+                if (len < 4)
+                        /* message and init in the top 64 bits */
+                        return crc32_refl_reduce(c, crc_shl_bytes(x, 8 - len),
+                                                 64);
+                return crc32_refl_reduce(c, crc_shl_bytes(x, 16 - len), 128);
+        }
+
+        x = _mm_xor_si128(_mm_loadu_si128((const __m128i *) p),
+                          _mm_cvtsi32_si128(init));
+        p += 16;
+        len -= 16;
+
+        if (len >= 64) {
+                const __m128i k4 =
+                        _mm_load_si128((const __m128i *) c->fold_4x128);
+                const __m128i *p128 = (const __m128i *) p;
+                __m128i x4[4];
+
+                x4[0] = _mm_xor_si128(crc_refl_fold(x, k1),
+                                      _mm_loadu_si128(&p128[0]));
+                x4[1] = _mm_loadu_si128(&p128[1]);
+                x4[2] = _mm_loadu_si128(&p128[2]);
+                x4[3] = _mm_loadu_si128(&p128[3]);
+                p += 64;
+                len -= 64;
+
+#ifdef CRC_FOLD_ZMM
+                if (len >= 192)
+                        crc_fold_by16(c, x4, &p, &len, 1);
+#endif
+                while (len >= 64) {
+                        p128 = (const __m128i *) p;
+                        x4[0] = _mm_xor_si128(crc_refl_fold(x4[0], k4),
+                                              _mm_loadu_si128(&p128[0]));
+                        x4[1] = _mm_xor_si128(crc_refl_fold(x4[1], k4),
+                                              _mm_loadu_si128(&p128[1]));
+                        x4[2] = _mm_xor_si128(crc_refl_fold(x4[2], k4),
+                                              _mm_loadu_si128(&p128[2]));
+                        x4[3] = _mm_xor_si128(crc_refl_fold(x4[3], k4),
+                                              _mm_loadu_si128(&p128[3]));
+                        p += 64;
+                        len -= 64;
+                }
+
+                x = _mm_xor_si128(crc_refl_fold(x4[0], k1), x4[1]);
+                x = _mm_xor_si128(crc_refl_fold(x, k1), x4[2]);
+                x = _mm_xor_si128(crc_refl_fold(x, k1), x4[3]);
+        }
+
+        return crc32_refl_finish(c, x, p, len);
+}
+
+#ifndef CRC_FOLD_ONLY
+/* ====================================================================== */
+/* API functions */
+
+uint32_t
+CRC32_ETHERNET_FCS(const void *msg, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (msg == NULL && len != 0)
+                return 0;
+#endif
+        return ETHERNET_FCS(msg, len, NULL);
+}
+
+/* CRC32C (Castagnoli), reflected, init 0xFFFFFFFF, final XOR 0xFFFFFFFF */
+uint32_t
+CRC32_SCTP(const void *msg, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (msg == NULL && len != 0)
+                return 0;
+#endif
+        return ~crc32_refl_calc(&crc32_sctp_const, 0xffffffff,
+                                (const uint8_t *) msg, len);
+}
+
+/* CRC16 CCITT/X.25, reflected, init 0xFFFF, final XOR 0xFFFF */
+uint32_t
+CRC16_X25(const void *msg, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (msg == NULL && len != 0)
+                return 0;
+#endif
+        return (crc32_refl_calc(&crc16_x25_const, 0xffff,
+                                (const uint8_t *) msg, len) ^ 0xffff) &
+                0xffff;
+}
+
+/* CRC24A for LTE/5G transport blocks */
+uint32_t
+CRC24_LTE_A(const void *msg, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (msg == NULL && len != 0)
+                return 0;
+#endif
+        return crc32_calc(&crc24_lte_a_const, 0,
+                          (const uint8_t *) msg, len) >> 8;
+}
+
+/* CRC24B for LTE/5G code blocks */
+uint32_t
+CRC24_LTE_B(const void *msg, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (msg == NULL && len != 0)
+                return 0;
+#endif
+        return crc32_calc(&crc24_lte_b_const, 0,
+                          (const uint8_t *) msg, len) >> 8;
+}
+
+/* CRC16 of Frame Protocol data frames */
+uint32_t
+CRC16_FP_DATA(const void *msg, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (msg == NULL && len != 0)
+                return 0;
+#endif
+        return crc32_calc(&crc16_fp_data_const, 0,
+                          (const uint8_t *) msg, len) >> 16;
+}
+
+/* CRC11 of Frame Protocol data frame headers */
+uint32_t
+CRC11_FP_HEADER(const void *msg, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (msg == NULL && len != 0)
+                return 0;
+#endif
+        return crc32_calc(&crc11_fp_header_const, 0,
+                          (const uint8_t *) msg, len) >> 21;
+}
+
+/* CRC7 of Frame Protocol control frame headers */
+uint32_t
+CRC7_FP_HEADER(const void *msg, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (msg == NULL && len != 0)
+                return 0;
+#endif
+        return crc32_calc(&crc7_fp_header_const, 0,
+                          (const uint8_t *) msg, len) >> 25;
+}
+
+/* CRC10 of IuUP payload */
+uint32_t
+CRC10_IUUP_DATA(const void *msg, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (msg == NULL && len != 0)
+                return 0;
+#endif
+        return crc32_calc(&crc10_iuup_data_const, 0,
+                          (const uint8_t *) msg, len) >> 22;
+}
+
+/* CRC6 of IuUP header */
+uint32_t
+CRC6_IUUP_HEADER(const void *msg, const uint64_t len)
+{
+#ifdef SAFE_PARAM
+        if (msg == NULL && len != 0)
+                return 0;
+#endif
+        return crc32_calc(&crc6_iuup_header_const, 0,
+                          (const uint8_t *) msg, len) >> 26;
+}
+
+#endif /* CRC_FOLD_ONLY */
+
+#endif /* CRC_COMMON_H */
@@ -108,6 +108,19 @@ void docsis_des_enc_basic(const void *input, void *output, const int size,
 void docsis_des_dec_basic(const void *input, void *output, const int size,
                           const uint64_t *ks, const uint64_t *ivec);
 
+/* ========================================================================= */
+/* DES S-box tables with P permutation applied (see des_basic.c)             */
+/* ========================================================================= */
+
+IMB_DLL_LOCAL extern const uint32_t des_sbox0p[64];
+IMB_DLL_LOCAL extern const uint32_t des_sbox1p[64];
+IMB_DLL_LOCAL extern const uint32_t des_sbox2p[64];
+IMB_DLL_LOCAL extern const uint32_t des_sbox3p[64];
+IMB_DLL_LOCAL extern const uint32_t des_sbox4p[64];
+IMB_DLL_LOCAL extern const uint32_t des_sbox5p[64];
+IMB_DLL_LOCAL extern const uint32_t des_sbox6p[64];
+IMB_DLL_LOCAL extern const uint32_t des_sbox7p[64];
+
 /* ========================================================================= */
 /* DES and 3DES inline function for use in mb_mgr_code.h                     */
 /* ========================================================================= */
@@ -310,7 +310,7 @@ SUBMIT_JOB_DOCSIS_SEC_CRC_ENC(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job,
         return SUBMIT_JOB_DOCSIS_SEC_ENC(state, job, key_size);
 }
 
-#ifndef AVX512
+#if !defined(AVX512) && !defined(SUBMIT_JOB_DOCSIS128_CRC32_X4)
 __forceinline
 IMB_JOB *
 SUBMIT_JOB_DOCSIS128_SEC_CRC_ENC(MB_MGR_DOCSIS_AES_OOO *state,
@@ -340,7 +340,7 @@ FLUSH_JOB_DOCSIS_SEC_CRC_ENC(MB_MGR_DOCSIS_AES_OOO *state,
         return FLUSH_JOB_DOCSIS_SEC_ENC(state, key_size);
 }
 
-#ifndef AVX512
+#if !defined(AVX512) && !defined(SUBMIT_JOB_DOCSIS128_CRC32_X4)
 __forceinline
 IMB_JOB *
 FLUSH_JOB_DOCSIS128_SEC_CRC_ENC(MB_MGR_DOCSIS_AES_OOO *state)
@@ -385,7 +385,7 @@ SUBMIT_JOB_DOCSIS_SEC_CRC_DEC(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job,
         return job;
 }
 
-#ifndef AVX512
+#if !defined(AVX512) && !defined(SUBMIT_JOB_DOCSIS128_CRC32_X4)
 __forceinline
 IMB_JOB *
 SUBMIT_JOB_DOCSIS128_SEC_CRC_DEC(MB_MGR_DOCSIS_AES_OOO *state,
@@ -403,6 +403,119 @@ SUBMIT_JOB_DOCSIS256_SEC_CRC_DEC(MB_MGR_DOCSIS_AES_OOO *state,
 }
 #endif
 
+#ifdef SUBMIT_JOB_DOCSIS128_CRC32_X4
+/**
+ * @brief JOB submit helper function for DOCSIS SEC + CRC32 encryption,
+ *        using the stitched AES-CBC + CRC32 out-of-order manager
+ *
+ * @param state OOO manager structure
+ * @param job description of performed crypto operation
+ * @param key_size AES key size in bytes (16 or 32)
+ *
+ * @return Pointer to completed JOB or NULL
+ */
+__forceinline
+IMB_JOB *
+SUBMIT_JOB_DOCSIS_CRC32_X4_ENC(MB_MGR_DOCSIS_CRC32_OOO *state, IMB_JOB *job,
+                               const uint64_t key_size)
+{
+        IMB_JOB *tmp;
+
+        if (job->msg_len_to_cipher_in_bytes < AES_BLOCK_SIZE) {
+                if (job->msg_len_to_hash_in_bytes >=
+                    DOCSIS_CRC32_MIN_ETH_PDU_SIZE) {
+                        const uint8_t *msg = job->src +
+                                job->hash_start_src_offset_in_bytes;
+                        uint32_t *p_crc = (uint32_t *) job->auth_tag_output;
+
+                        (*p_crc) = ETHERNET_FCS(msg,
+                                                job->msg_len_to_hash_in_bytes,
+                                                msg +
+                                                job->msg_len_to_hash_in_bytes);
+                }
+                return DOCSIS_FIRST_BLOCK(job, key_size);
+        }
+
+        if (key_size == 16)
+                tmp = SUBMIT_JOB_DOCSIS128_CRC32_X4(state, job);
+        else /* 32 */
+                tmp = SUBMIT_JOB_DOCSIS256_CRC32_X4(state, job);
+
+        return DOCSIS_LAST_BLOCK(tmp, key_size);
+}
+
+__forceinline
+IMB_JOB *
+SUBMIT_JOB_DOCSIS128_SEC_CRC_ENC(MB_MGR_DOCSIS_CRC32_OOO *state,
+                                 IMB_JOB *job)
+{
+        return SUBMIT_JOB_DOCSIS_CRC32_X4_ENC(state, job, 16);
+}
+
+__forceinline
+IMB_JOB *
+SUBMIT_JOB_DOCSIS256_SEC_CRC_ENC(MB_MGR_DOCSIS_CRC32_OOO *state,
+                                 IMB_JOB *job)
+{
+        return SUBMIT_JOB_DOCSIS_CRC32_X4_ENC(state, job, 32);
+}
+
+__forceinline
+IMB_JOB *
+FLUSH_JOB_DOCSIS128_SEC_CRC_ENC(MB_MGR_DOCSIS_CRC32_OOO *state)
+{
+        return DOCSIS_LAST_BLOCK(FLUSH_JOB_DOCSIS128_CRC32_X4(state), 16);
+}
+
+__forceinline
+IMB_JOB *
+FLUSH_JOB_DOCSIS256_SEC_CRC_ENC(MB_MGR_DOCSIS_CRC32_OOO *state)
+{
+        return DOCSIS_LAST_BLOCK(FLUSH_JOB_DOCSIS256_CRC32_X4(state), 32);
+}
+
+/**
+ * @brief JOB submit helper function for DOCSIS SEC + CRC32 decryption,
+ *        using stitched AES-CBC + CRC32 for jobs with full cipher blocks
+ *
+ * @param state OOO manager structure (not used)
+ * @param job description of performed crypto operation
+ * @param key_size AES key size in bytes (16 or 32)
+ *
+ * @return It always returns value passed in \a job
+ */
+__forceinline
+IMB_JOB *
+SUBMIT_JOB_DOCSIS_CRC32_X4_DEC(MB_MGR_DOCSIS_AES_OOO *state, IMB_JOB *job,
+                               const uint64_t key_size)
+{
+        if (job->msg_len_to_cipher_in_bytes < AES_BLOCK_SIZE)
+                return SUBMIT_JOB_DOCSIS_SEC_CRC_DEC(state, job, key_size);
+
+        DOCSIS_LAST_BLOCK(job, key_size);
+        if (key_size == 16)
+                return DOCSIS128_CRC32_DEC(job);
+        else /* 32 */
+                return DOCSIS256_CRC32_DEC(job);
+}
+
+__forceinline
+IMB_JOB *
+SUBMIT_JOB_DOCSIS128_SEC_CRC_DEC(MB_MGR_DOCSIS_AES_OOO *state,
+                                 IMB_JOB *job)
+{
+        return SUBMIT_JOB_DOCSIS_CRC32_X4_DEC(state, job, 16);
+}
+
+__forceinline
+IMB_JOB *
+SUBMIT_JOB_DOCSIS256_SEC_CRC_DEC(MB_MGR_DOCSIS_AES_OOO *state,
+                                 IMB_JOB *job)
+{
+        return SUBMIT_JOB_DOCSIS_CRC32_X4_DEC(state, job, 32);
+}
+#endif /* SUBMIT_JOB_DOCSIS128_CRC32_X4 */
+
 /* ========================================================================= */
 /* DES, 3DES and DOCSIS DES (DES CBC + DES CFB) */
 /* ========================================================================= */
@@ -177,6 +177,18 @@ IMB_DLL_EXPORT void
 aes_gcm_pre_192_vaes_avx512(const void *key, struct gcm_key_data *key_data);
 IMB_DLL_EXPORT void
 aes_gcm_pre_256_vaes_avx512(const void *key, struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_128_n_vaes_avx512(const void * const keys[],
+                              struct gcm_key_data * const key_data[],
+                              const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_192_n_vaes_avx512(const void * const keys[],
+                              struct gcm_key_data * const key_data[],
+                              const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_256_n_vaes_avx512(const void * const keys[],
+                              struct gcm_key_data * const key_data[],
+                              const uint32_t num_keys);
 
 /*
  * AVX512 GCM API
@@ -324,6 +336,66 @@ IMB_DLL_EXPORT void
 aes_gcm_pre_192_avx512(const void *key, struct gcm_key_data *key_data);
 IMB_DLL_EXPORT void
 aes_gcm_pre_256_avx512(const void *key, struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_128_n_avx512(const void * const keys[],
+                         struct gcm_key_data * const key_data[],
+                         const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_192_n_avx512(const void * const keys[],
+                         struct gcm_key_data * const key_data[],
+                         const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_256_n_avx512(const void * const keys[],
+                         struct gcm_key_data * const key_data[],
+                         const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_enc_128_n_avx512(const struct gcm_key_data * const key_data[],
+                         struct gcm_context_data * const ctx[],
+                         uint8_t * const out[], const uint8_t * const in[],
+                         const uint64_t len[], const uint8_t * const iv[],
+                         const uint8_t * const aad[], const uint64_t aad_len[],
+                         uint8_t * const tag[], const uint64_t tag_len,
+                         const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_128_n_avx512(const struct gcm_key_data * const key_data[],
+                         struct gcm_context_data * const ctx[],
+                         uint8_t * const out[], const uint8_t * const in[],
+                         const uint64_t len[], const uint8_t * const iv[],
+                         const uint8_t * const aad[], const uint64_t aad_len[],
+                         uint8_t * const tag[], const uint64_t tag_len,
+                         const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_enc_192_n_avx512(const struct gcm_key_data * const key_data[],
+                         struct gcm_context_data * const ctx[],
+                         uint8_t * const out[], const uint8_t * const in[],
+                         const uint64_t len[], const uint8_t * const iv[],
+                         const uint8_t * const aad[], const uint64_t aad_len[],
+                         uint8_t * const tag[], const uint64_t tag_len,
+                         const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_192_n_avx512(const struct gcm_key_data * const key_data[],
+                         struct gcm_context_data * const ctx[],
+                         uint8_t * const out[], const uint8_t * const in[],
+                         const uint64_t len[], const uint8_t * const iv[],
+                         const uint8_t * const aad[], const uint64_t aad_len[],
+                         uint8_t * const tag[], const uint64_t tag_len,
+                         const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_enc_256_n_avx512(const struct gcm_key_data * const key_data[],
+                         struct gcm_context_data * const ctx[],
+                         uint8_t * const out[], const uint8_t * const in[],
+                         const uint64_t len[], const uint8_t * const iv[],
+                         const uint8_t * const aad[], const uint64_t aad_len[],
+                         uint8_t * const tag[], const uint64_t tag_len,
+                         const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_256_n_avx512(const struct gcm_key_data * const key_data[],
+                         struct gcm_context_data * const ctx[],
+                         uint8_t * const out[], const uint8_t * const in[],
+                         const uint64_t len[], const uint8_t * const iv[],
+                         const uint8_t * const aad[], const uint64_t aad_len[],
+                         uint8_t * const tag[], const uint64_t tag_len,
+                         const uint32_t num_msgs);
 
 /*
  * AESNI emulation GCM API (based on SSE architecture)
@@ -472,6 +544,217 @@ IMB_DLL_EXPORT void
 aes_gcm_pre_192_sse_no_aesni(const void *key, struct gcm_key_data *key_data);
 IMB_DLL_EXPORT void
 aes_gcm_pre_256_sse_no_aesni(const void *key, struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_128_n_sse_no_aesni(const void * const keys[],
+                               struct gcm_key_data * const key_data[],
+                               const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_192_n_sse_no_aesni(const void * const keys[],
+                               struct gcm_key_data * const key_data[],
+                               const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_256_n_sse_no_aesni(const void * const keys[],
+                               struct gcm_key_data * const key_data[],
+                               const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_enc_128_n_sse_no_aesni(const struct gcm_key_data * const key_data[],
+                               struct gcm_context_data * const ctx[],
+                               uint8_t * const out[],
+                               const uint8_t * const in[],
+                               const uint64_t len[],
+                               const uint8_t * const iv[],
+                               const uint8_t * const aad[],
+                               const uint64_t aad_len[], uint8_t * const tag[],
+                               const uint64_t tag_len,
+                               const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_128_n_sse_no_aesni(const struct gcm_key_data * const key_data[],
+                               struct gcm_context_data * const ctx[],
+                               uint8_t * const out[],
+                               const uint8_t * const in[],
+                               const uint64_t len[],
+                               const uint8_t * const iv[],
+                               const uint8_t * const aad[],
+                               const uint64_t aad_len[], uint8_t * const tag[],
+                               const uint64_t tag_len,
+                               const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_enc_192_n_sse_no_aesni(const struct gcm_key_data * const key_data[],
+                               struct gcm_context_data * const ctx[],
+                               uint8_t * const out[],
+                               const uint8_t * const in[],
+                               const uint64_t len[],
+                               const uint8_t * const iv[],
+                               const uint8_t * const aad[],
+                               const uint64_t aad_len[], uint8_t * const tag[],
+                               const uint64_t tag_len,
+                               const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_192_n_sse_no_aesni(const struct gcm_key_data * const key_data[],
+                               struct gcm_context_data * const ctx[],
+                               uint8_t * const out[],
+                               const uint8_t * const in[],
+                               const uint64_t len[],
+                               const uint8_t * const iv[],
+                               const uint8_t * const aad[],
+                               const uint64_t aad_len[], uint8_t * const tag[],
+                               const uint64_t tag_len,
+                               const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_enc_256_n_sse_no_aesni(const struct gcm_key_data * const key_data[],
+                               struct gcm_context_data * const ctx[],
+                               uint8_t * const out[],
+                               const uint8_t * const in[],
+                               const uint64_t len[],
+                               const uint8_t * const iv[],
+                               const uint8_t * const aad[],
+                               const uint64_t aad_len[], uint8_t * const tag[],
+                               const uint64_t tag_len,
+                               const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_256_n_sse_no_aesni(const struct gcm_key_data * const key_data[],
+                               struct gcm_context_data * const ctx[],
+                               uint8_t * const out[],
+                               const uint8_t * const in[],
+                               const uint64_t len[],
+                               const uint8_t * const iv[],
+                               const uint8_t * const aad[],
+                               const uint64_t aad_len[], uint8_t * const tag[],
+                               const uint64_t tag_len,
+                               const uint32_t num_msgs);
+
+/*
+ * Compact GCM key API (for AVX512 and SSE no-aesni)
+ * - intentionally this is not exposed in intel-ipsec-mb.h
+ * - available through IMB_AESxxx_GCM_PRE/EXPAND/ENC/DEC_COMPACT() macros
+ *   from intel-ipsec-mb.h
+ */
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_128_avx512(const void *key,
+                               struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_192_avx512(const void *key,
+                               struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_256_avx512(const void *key,
+                               struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_128_avx512(const struct gcm_key_data_compact *key,
+                                  struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_192_avx512(const struct gcm_key_data_compact *key,
+                                  struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_256_avx512(const struct gcm_key_data_compact *key,
+                                  struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_128_avx512(const struct gcm_key_data_compact *key,
+                               struct gcm_context_data *context_data,
+                               uint8_t *out, uint8_t const *in, uint64_t len,
+                               const uint8_t *iv, uint8_t const *aad,
+                               uint64_t aad_len, uint8_t *auth_tag,
+                               uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_192_avx512(const struct gcm_key_data_compact *key,
+                               struct gcm_context_data *context_data,
+                               uint8_t *out, uint8_t const *in, uint64_t len,
+                               const uint8_t *iv, uint8_t const *aad,
+                               uint64_t aad_len, uint8_t *auth_tag,
+                               uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_256_avx512(const struct gcm_key_data_compact *key,
+                               struct gcm_context_data *context_data,
+                               uint8_t *out, uint8_t const *in, uint64_t len,
+                               const uint8_t *iv, uint8_t const *aad,
+                               uint64_t aad_len, uint8_t *auth_tag,
+                               uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_128_avx512(const struct gcm_key_data_compact *key,
+                               struct gcm_context_data *context_data,
+                               uint8_t *out, uint8_t const *in, uint64_t len,
+                               const uint8_t *iv, uint8_t const *aad,
+                               uint64_t aad_len, uint8_t *auth_tag,
+                               uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_192_avx512(const struct gcm_key_data_compact *key,
+                               struct gcm_context_data *context_data,
+                               uint8_t *out, uint8_t const *in, uint64_t len,
+                               const uint8_t *iv, uint8_t const *aad,
+                               uint64_t aad_len, uint8_t *auth_tag,
+                               uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_256_avx512(const struct gcm_key_data_compact *key,
+                               struct gcm_context_data *context_data,
+                               uint8_t *out, uint8_t const *in, uint64_t len,
+                               const uint8_t *iv, uint8_t const *aad,
+                               uint64_t aad_len, uint8_t *auth_tag,
+                               uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_128_sse_no_aesni(const void *key,
+                                     struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_192_sse_no_aesni(const void *key,
+                                     struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_256_sse_no_aesni(const void *key,
+                                     struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_128_sse_no_aesni(const struct gcm_key_data_compact *key,
+                                        struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_192_sse_no_aesni(const struct gcm_key_data_compact *key,
+                                        struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_256_sse_no_aesni(const struct gcm_key_data_compact *key,
+                                        struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_128_sse_no_aesni(const struct gcm_key_data_compact *key,
+                                     struct gcm_context_data *context_data,
+                                     uint8_t *out, uint8_t const *in,
+                                     uint64_t len, const uint8_t *iv,
+                                     uint8_t const *aad, uint64_t aad_len,
+                                     uint8_t *auth_tag,
+                                     uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_192_sse_no_aesni(const struct gcm_key_data_compact *key,
+                                     struct gcm_context_data *context_data,
+                                     uint8_t *out, uint8_t const *in,
+                                     uint64_t len, const uint8_t *iv,
+                                     uint8_t const *aad, uint64_t aad_len,
+                                     uint8_t *auth_tag,
+                                     uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_256_sse_no_aesni(const struct gcm_key_data_compact *key,
+                                     struct gcm_context_data *context_data,
+                                     uint8_t *out, uint8_t const *in,
+                                     uint64_t len, const uint8_t *iv,
+                                     uint8_t const *aad, uint64_t aad_len,
+                                     uint8_t *auth_tag,
+                                     uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_128_sse_no_aesni(const struct gcm_key_data_compact *key,
+                                     struct gcm_context_data *context_data,
+                                     uint8_t *out, uint8_t const *in,
+                                     uint64_t len, const uint8_t *iv,
+                                     uint8_t const *aad, uint64_t aad_len,
+                                     uint8_t *auth_tag,
+                                     uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_192_sse_no_aesni(const struct gcm_key_data_compact *key,
+                                     struct gcm_context_data *context_data,
+                                     uint8_t *out, uint8_t const *in,
+                                     uint64_t len, const uint8_t *iv,
+                                     uint8_t const *aad, uint64_t aad_len,
+                                     uint8_t *auth_tag,
+                                     uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_256_sse_no_aesni(const struct gcm_key_data_compact *key,
+                                     struct gcm_context_data *context_data,
+                                     uint8_t *out, uint8_t const *in,
+                                     uint64_t len, const uint8_t *iv,
+                                     uint8_t const *aad, uint64_t aad_len,
+                                     uint8_t *auth_tag,
+                                     uint64_t auth_tag_len);
 
 /*
  * Extra GCM API (for SSE/AVX/AVX2)
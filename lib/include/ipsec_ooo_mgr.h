@@ -54,16 +54,19 @@
 #define AVX2_NUM_SHA256_LANES   8
 #define AVX2_NUM_SHA512_LANES   4
 #define AVX2_NUM_MD5_LANES      16
+#define AVX2_NUM_DES_LANES      8
 
 #define AVX_NUM_SHA1_LANES      4
 #define AVX_NUM_SHA256_LANES    4
 #define AVX_NUM_SHA512_LANES    2
 #define AVX_NUM_MD5_LANES       8
+#define AVX_NUM_DES_LANES       4
 
 #define SSE_NUM_SHA1_LANES   AVX_NUM_SHA1_LANES
 #define SSE_NUM_SHA256_LANES AVX_NUM_SHA256_LANES
 #define SSE_NUM_SHA512_LANES AVX_NUM_SHA512_LANES
 #define SSE_NUM_MD5_LANES    AVX_NUM_MD5_LANES
+#define SSE_NUM_DES_LANES    AVX_NUM_DES_LANES
 
 /*
  * Each row is sized to hold enough lanes for AVX2, AVX1 and SSE use a subset
@@ -193,6 +196,78 @@ typedef struct {
 } MB_MGR_CCM_OOO;
 
 
+typedef struct {
+        const uint8_t *in[4];
+        uint8_t *out[4];
+        const void *keys[4];
+        DECLARE_ALIGNED(imb_uint128_t mac[4], 16);
+        DECLARE_ALIGNED(imb_uint128_t ctr[4], 16);
+        DECLARE_ALIGNED(imb_uint128_t ks[4], 16);
+        DECLARE_ALIGNED(imb_uint128_t dec_mask[4], 16);
+} AES_CCM_ARGS_x4;
+
+/* AES-CCM stitched (CTR + CBC-MAC) out-of-order scheduler structure */
+typedef struct {
+        AES_CCM_ARGS_x4 args;
+        uint32_t lens[4];       /* bytes left in current stage */
+        uint32_t stage[4];      /* B0/AAD, message, partial block */
+        /* each nibble is index (0...3) of an unused lane */
+        uint64_t unused_lanes;
+        IMB_JOB *job_in_lane[4];
+        uint64_t num_lanes_inuse;
+        /* B0, AAD blocks and padded partial block of each lane */
+        DECLARE_ALIGNED(uint8_t init_blocks[4 * (4 * 16)], 64);
+        DECLARE_ALIGNED(imb_uint128_t ctr0[4], 16);
+        uint64_t road_block;
+} MB_MGR_CCM_CTR_MAC_OOO;
+
+typedef struct {
+        const uint8_t *in[4];
+        uint8_t *out[4];
+        const uint8_t *crc_in[4];
+        const void *keys[4];
+        DECLARE_ALIGNED(imb_uint128_t iv[4], 16);
+        DECLARE_ALIGNED(imb_uint128_t crc[4], 16);
+} AES_DOCSIS_CRC32_ARGS_x4;
+
+/* DOCSIS SEC BPI + CRC32 stitched out-of-order scheduler structure */
+typedef struct {
+        AES_DOCSIS_CRC32_ARGS_x4 args;
+        uint32_t lens[4];       /* bytes left in current stage */
+        uint32_t stage[4];      /* CBC + CRC, CBC only, done */
+        /* each nibble is index (0...3) of an unused lane */
+        uint64_t unused_lanes;
+        IMB_JOB *job_in_lane[4];
+        uint64_t num_lanes_inuse;
+        uint64_t road_block;
+} MB_MGR_DOCSIS_CRC32_OOO;
+
+/*
+ * Scatter-gather list (SGL) CBC encrypt / CBC-MAC out-of-order scheduler
+ * structure. Each lane walks the segments of its job with its own cursor.
+ */
+typedef struct {
+        AES_ARGS args;
+        uint64_t lens[16];      /* bytes left in the current chunk */
+        uint64_t remain[16];    /* message bytes after the current chunk */
+        /* segment cursor: next byte of the message */
+        const struct IMB_SGL_IOV *seg[16];
+        uint64_t seg_offset[16];
+        /* position and length of a block gathered across segments */
+        const struct IMB_SGL_IOV *block_seg[16];
+        uint64_t block_offset[16];
+        uint64_t block_len[16];
+        /* B0/AAD blocks (CCM) and gathered block of each lane */
+        DECLARE_ALIGNED(uint8_t blocks[16 * (4 * 16)], 64);
+        /* each nibble is index (0...15) of an unused lane */
+        uint64_t unused_lanes;
+        IMB_JOB *job_in_lane[16];
+        uint64_t num_lanes;
+        uint64_t num_lanes_inuse;
+        uint64_t road_block;
+} MB_MGR_SGL_OOO;
+
+
 /* AES-CMAC out-of-order scheduler structure */
 typedef struct {
         AES_ARGS args; /* need to re-use AES arguments */
@@ -232,6 +307,35 @@ typedef struct {
         uint64_t road_block;
 } MB_MGR_ZUC_OOO;
 
+typedef struct {
+        const uint8_t *in[16];
+        uint8_t *out[16];
+        const uint8_t *keys[16];
+        const uint8_t *iv[16];
+        const uint8_t *auth_in[16];
+        const uint8_t *auth_keys[16];
+        const uint8_t *auth_iv[16];
+        uint32_t *auth_tag[16];
+} ZUC_EEA3_EIA3_ARGS_x16;
+
+/* ZUC EEA3 + EIA3 combined out-of-order scheduler fields */
+typedef struct {
+        ZUC_EEA3_EIA3_ARGS_x16 args;
+        DECLARE_ALIGNED(uint16_t lens[16], 16);      /* cipher, in bytes */
+        DECLARE_ALIGNED(uint16_t auth_lens[16], 16); /* hash, in bits */
+        /* bit mask of lanes authenticating the cipher output
+         * (in-place cipher-then-hash jobs) */
+        uint64_t auth_after_cipher;
+        /* bit mask of lanes ciphering one block behind the authentication
+         * (in-place hash-then-cipher jobs, hash offset < cipher offset) */
+        uint64_t cipher_lag;
+        /* each nibble is index (0...7) of an unused lane */
+        uint64_t unused_lanes;
+        IMB_JOB *job_in_lane[16];
+        uint64_t num_lanes_inuse;
+        uint64_t road_block;
+} MB_MGR_ZUC_EEA3_EIA3_OOO;
+
 /* HMAC-SHA1 and HMAC-SHA256/224 */
 typedef struct {
         /* YMM aligned access to extra_block */
@@ -181,12 +181,249 @@ SUBMIT_JOB_AES_ECB_256_DEC(IMB_JOB *job)
         return job;
 }
 
+/* ========================================================================= */
+/* AES-XTS functions */
+/* ========================================================================= */
+
+/*
+ * For AES-XTS, enc_keys/dec_keys point to an array of 2 pointers:
+ * [0] data key schedule (encrypt or decrypt), [1] tweak key encrypt schedule
+ */
+__forceinline
+IMB_JOB *
+submit_aes_xts_job(IMB_JOB *job)
+{
+        const uint8_t *src = job->src + job->cipher_start_src_offset_in_bytes;
+        const uint64_t len = job->msg_len_to_cipher_in_bytes;
+
+        if (IMB_DIR_ENCRYPT == job->cipher_direction) {
+                const void * const *ks_ptr =
+                        (const void * const *)job->enc_keys;
+
+                if (16 == job->key_len_in_bytes)
+                        AES_XTS_128_ENC(src, job->iv, ks_ptr[0], ks_ptr[1],
+                                        job->dst, len);
+                else /* assume 32 */
+                        AES_XTS_256_ENC(src, job->iv, ks_ptr[0], ks_ptr[1],
+                                        job->dst, len);
+        } else {
+                const void * const *ks_ptr =
+                        (const void * const *)job->dec_keys;
+
+                if (16 == job->key_len_in_bytes)
+                        AES_XTS_128_DEC(src, job->iv, ks_ptr[0], ks_ptr[1],
+                                        job->dst, len);
+                else /* assume 32 */
+                        AES_XTS_256_DEC(src, job->iv, ks_ptr[0], ks_ptr[1],
+                                        job->dst, len);
+        }
+        job->status |= STS_COMPLETED_AES;
+        return job;
+}
+
 /* ========================================================================= */
 /* DOCSIS functions */
 /* ========================================================================= */
 
 #include "include/docsis_common.h"
 
+/* ========================================================================= */
+/* Scatter-gather list job functions */
+/* ========================================================================= */
+
+#include "include/mb_mgr_sgl.h"
+
+/* ========================================================================= */
+/* AES-CFB128 (full message) functions */
+/* ========================================================================= */
+
+/**
+ * @brief Encrypts/decrypts AES-CFB128 message one block at a time
+ *
+ * Used when there is no multi-buffer or by8 implementation available
+ * and for messages shorter than one block.
+ * Decryption goes from the last block to the first one, so that
+ * in place operation doesn't overwrite cipher text blocks used as IV.
+ *
+ * @param job description of performed crypto operation
+ * @return It always returns value passed in \a job
+ */
+__forceinline
+IMB_JOB *
+submit_aes_cfb_job_by_block(IMB_JOB *job)
+{
+        const uint8_t *src = job->src + job->cipher_start_src_offset_in_bytes;
+        uint8_t *dst = job->dst;
+        const uint64_t len = job->msg_len_to_cipher_in_bytes;
+        const uint64_t key_size = job->key_len_in_bytes;
+        uint64_t offset;
+
+        if (job->cipher_direction == IMB_DIR_ENCRYPT) {
+                const void *iv = job->iv;
+
+                for (offset = 0; offset < len; offset += AES_BLOCK_SIZE) {
+                        const uint64_t n = (len - offset) > AES_BLOCK_SIZE ?
+                                AES_BLOCK_SIZE : (len - offset);
+
+                        if (key_size == 16)
+                                AES_CFB_128_ONE(dst + offset, src + offset,
+                                                iv, job->enc_keys, n);
+                        else /* 32 */
+                                AES_CFB_256_ONE(dst + offset, src + offset,
+                                                iv, job->enc_keys, n);
+                        iv = dst + offset;
+                }
+        } else {
+                uint64_t end = len;
+
+                while (end != 0) {
+                        const void *iv;
+
+                        /* offset of the last (possibly partial) block */
+                        offset = (end - 1) & (~(AES_BLOCK_SIZE - 1));
+                        iv = (offset == 0) ? job->iv :
+                                src + offset - AES_BLOCK_SIZE;
+
+                        if (key_size == 16)
+                                AES_CFB_128_ONE(dst + offset, src + offset,
+                                                iv, job->enc_keys,
+                                                end - offset);
+                        else /* 32 */
+                                AES_CFB_256_ONE(dst + offset, src + offset,
+                                                iv, job->enc_keys,
+                                                end - offset);
+                        end = offset;
+                }
+        }
+
+        job->status |= STS_COMPLETED_AES;
+        return job;
+}
+
+#ifdef SUBMIT_JOB_AES128_CFB_ENC
+/**
+ * @brief Encrypts the last partial block of AES-CFB128 message
+ *
+ * Complete blocks have been encrypted by the multi-buffer manager.
+ * IV is the last complete cipher-text block.
+ *
+ * @param job description of performed crypto operation (can be NULL)
+ * @return It always returns value passed in \a job
+ */
+__forceinline
+IMB_JOB *
+aes_cfb_enc_last_block(IMB_JOB *job)
+{
+        uint64_t offset, partial_bytes;
+
+        if (job == NULL)
+                return job;
+
+        partial_bytes = job->msg_len_to_cipher_in_bytes & (AES_BLOCK_SIZE - 1);
+        offset = job->msg_len_to_cipher_in_bytes & (~(AES_BLOCK_SIZE - 1));
+
+        if (!partial_bytes)
+                return job;
+
+        if (job->key_len_in_bytes == 16)
+                AES_CFB_128_ONE(job->dst + offset,
+                                job->src + job->cipher_start_src_offset_in_bytes +
+                                offset, job->dst + offset - AES_BLOCK_SIZE,
+                                job->enc_keys, partial_bytes);
+        else /* 32 */
+                AES_CFB_256_ONE(job->dst + offset,
+                                job->src + job->cipher_start_src_offset_in_bytes +
+                                offset, job->dst + offset - AES_BLOCK_SIZE,
+                                job->enc_keys, partial_bytes);
+
+        return job;
+}
+#endif /* SUBMIT_JOB_AES128_CFB_ENC */
+
+__forceinline
+IMB_JOB *
+submit_aes_cfb_enc_job(IMB_MGR *state, IMB_JOB *job)
+{
+#ifdef SUBMIT_JOB_AES128_CFB_ENC
+        if (job->msg_len_to_cipher_in_bytes >= AES_BLOCK_SIZE) {
+                IMB_JOB *tmp;
+
+                if (16 == job->key_len_in_bytes)
+                        tmp = SUBMIT_JOB_AES128_CFB_ENC(state->aes128_cfb_ooo,
+                                                        job);
+                else /* assume 32 */
+                        tmp = SUBMIT_JOB_AES256_CFB_ENC(state->aes256_cfb_ooo,
+                                                        job);
+
+                return aes_cfb_enc_last_block(tmp);
+        }
+#else
+        (void) state;
+#endif /* SUBMIT_JOB_AES128_CFB_ENC */
+        return submit_aes_cfb_job_by_block(job);
+}
+
+__forceinline
+IMB_JOB *
+flush_aes_cfb_enc_job(IMB_MGR *state, IMB_JOB *job)
+{
+#ifdef FLUSH_JOB_AES128_CFB_ENC
+        IMB_JOB *tmp;
+
+        if (16 == job->key_len_in_bytes)
+                tmp = FLUSH_JOB_AES128_CFB_ENC(state->aes128_cfb_ooo);
+        else /* assume 32 */
+                tmp = FLUSH_JOB_AES256_CFB_ENC(state->aes256_cfb_ooo);
+
+        return aes_cfb_enc_last_block(tmp);
+#else
+        (void) state;
+        (void) job;
+        return NULL;
+#endif /* FLUSH_JOB_AES128_CFB_ENC */
+}
+
+__forceinline
+IMB_JOB *
+submit_aes_cfb_dec_job(IMB_JOB *job)
+{
+#ifdef AES_CFB_DEC_128
+        const uint8_t *src = job->src + job->cipher_start_src_offset_in_bytes;
+        const uint64_t partial_bytes =
+                job->msg_len_to_cipher_in_bytes & (AES_BLOCK_SIZE - 1);
+        const uint64_t offset =
+                job->msg_len_to_cipher_in_bytes & (~(AES_BLOCK_SIZE - 1));
+
+        if (offset == 0)
+                return submit_aes_cfb_job_by_block(job);
+
+        /*
+         * Partial block goes first, as the complete blocks decrypted
+         * in place would overwrite cipher text used as its IV
+         */
+        if (partial_bytes) {
+                if (16 == job->key_len_in_bytes)
+                        AES_CFB_128_ONE(job->dst + offset, src + offset,
+                                        src + offset - AES_BLOCK_SIZE,
+                                        job->enc_keys, partial_bytes);
+                else /* 32 */
+                        AES_CFB_256_ONE(job->dst + offset, src + offset,
+                                        src + offset - AES_BLOCK_SIZE,
+                                        job->enc_keys, partial_bytes);
+        }
+
+        if (16 == job->key_len_in_bytes)
+                AES_CFB_DEC_128(src, job->iv, job->enc_keys, job->dst, offset);
+        else /* 32 */
+                AES_CFB_DEC_256(src, job->iv, job->enc_keys, job->dst, offset);
+
+        job->status |= STS_COMPLETED_AES;
+        return job;
+#else
+        return submit_aes_cfb_job_by_block(job);
+#endif /* AES_CFB_DEC_128 */
+}
+
 /* ========================================================================= */
 /* Custom hash / cipher */
 /* ========================================================================= */
@@ -245,6 +482,75 @@ FLUSH_JOB_CUSTOM_HASH(IMB_JOB *job)
         return JOB_CUSTOM_HASH(job);
 }
 
+#ifdef SUBMIT_JOB_ZUC_EEA3_EIA3
+/*
+ * ZUC EEA3 + EIA3 jobs are sent to the combined manager when
+ * authentication does not start after the cipher offset (e.g. PDCP).
+ * In-place hash-then-cipher jobs are ciphered one 64 byte block behind
+ * the authentication, so the offset difference is limited to 64 bytes.
+ */
+__forceinline
+int
+is_zuc_eea3_eia3_job(const IMB_JOB *job)
+{
+        const uint64_t cipher_off = job->cipher_start_src_offset_in_bytes;
+        const uint64_t hash_off = job->hash_start_src_offset_in_bytes;
+
+        if (job->cipher_mode != IMB_CIPHER_ZUC_EEA3 ||
+            job->hash_alg != IMB_AUTH_ZUC_EIA3_BITLEN ||
+            hash_off > cipher_off)
+                return 0;
+
+        if (job->chain_order == IMB_ORDER_HASH_CIPHER &&
+            job->dst == job->src + cipher_off)
+                return (cipher_off - hash_off) <= 64;
+
+        return 1;
+}
+#endif /* SUBMIT_JOB_ZUC_EEA3_EIA3 */
+
+#ifdef SUBMIT_JOB_AES128_CCM_CTR_MAC
+/*
+ * AES-CCM jobs are ciphered and authenticated in one pass
+ * by the stitched (CTR + CBC-MAC) manager
+ */
+__forceinline
+IMB_JOB *
+submit_aes_ccm_ctr_mac_job(IMB_MGR *state, IMB_JOB *job)
+{
+        if (16 == job->key_len_in_bytes) {
+                MB_MGR_CCM_CTR_MAC_OOO *aes128_ccm_ctr_mac_ooo =
+                        state->aes128_ccm_ctr_mac_ooo;
+
+                return SUBMIT_JOB_AES128_CCM_CTR_MAC(aes128_ccm_ctr_mac_ooo,
+                                                     job);
+        } else { /* assume 32 */
+                MB_MGR_CCM_CTR_MAC_OOO *aes256_ccm_ctr_mac_ooo =
+                        state->aes256_ccm_ctr_mac_ooo;
+
+                return SUBMIT_JOB_AES256_CCM_CTR_MAC(aes256_ccm_ctr_mac_ooo,
+                                                     job);
+        }
+}
+
+__forceinline
+IMB_JOB *
+flush_aes_ccm_ctr_mac_job(IMB_MGR *state, IMB_JOB *job)
+{
+        if (16 == job->key_len_in_bytes) {
+                MB_MGR_CCM_CTR_MAC_OOO *aes128_ccm_ctr_mac_ooo =
+                        state->aes128_ccm_ctr_mac_ooo;
+
+                return FLUSH_JOB_AES128_CCM_CTR_MAC(aes128_ccm_ctr_mac_ooo);
+        } else { /* assume 32 */
+                MB_MGR_CCM_CTR_MAC_OOO *aes256_ccm_ctr_mac_ooo =
+                        state->aes256_ccm_ctr_mac_ooo;
+
+                return FLUSH_JOB_AES256_CCM_CTR_MAC(aes256_ccm_ctr_mac_ooo);
+        }
+}
+#endif /* SUBMIT_JOB_AES128_CCM_CTR_MAC */
+
 __forceinline
 IMB_JOB *
 submit_snow3g_uea2_job(IMB_MGR *state, IMB_JOB *job)
@@ -273,6 +579,58 @@ submit_snow3g_uea2_job(IMB_MGR *state, IMB_JOB *job)
         return job;
 }
 
+/*
+ * SNOW3G UEA2 + UIA2 jobs are ciphered and authenticated in one pass
+ * when the cipher offset and length are in bytes and authentication
+ * starts at or before the cipher (e.g. PDCP header), covering the data
+ * up to the cipher start
+ */
+__forceinline
+int
+is_snow3g_uea2_uia2_job(const IMB_JOB *job)
+{
+        const uint64_t cipher_off = job->cipher_start_src_offset_in_bits;
+        const uint64_t hash_off = job->hash_start_src_offset_in_bytes;
+
+        if (job->cipher_mode != IMB_CIPHER_SNOW3G_UEA2_BITLEN ||
+            job->hash_alg != IMB_AUTH_SNOW3G_UIA2_BITLEN ||
+            (job->msg_len_to_cipher_in_bits & 0x07) != 0 ||
+            (cipher_off & 0x07) != 0 || hash_off > (cipher_off >> 3))
+                return 0;
+
+        return job->msg_len_to_hash_in_bits >=
+                (cipher_off - (hash_off * 8));
+}
+
+__forceinline
+IMB_JOB *
+submit_snow3g_uea2_uia2_job(IMB_JOB *job)
+{
+        const uint64_t offset = job->hash_start_src_offset_in_bytes;
+        /* In-place cipher-then-hash authenticates the cipher output */
+        const int auth_cipher_text =
+                (job->chain_order == IMB_ORDER_CIPHER_HASH &&
+                 job->src == job->dst);
+
+        /* data between hash and cipher start is authenticated only */
+        SNOW3G_F8_F9_1_BUFFER((const snow3g_key_schedule_t *) job->enc_keys,
+                              job->iv,
+                              (const snow3g_key_schedule_t *)
+                              job->u.SNOW3G_UIA2._key,
+                              job->u.SNOW3G_UIA2._iv,
+                              job->src + offset, job->dst + offset,
+                              (const uint32_t)
+                              ((job->cipher_start_src_offset_in_bits >> 3) -
+                               offset),
+                              (const uint32_t)
+                              (job->msg_len_to_cipher_in_bits >> 3),
+                              job->msg_len_to_hash_in_bits,
+                              auth_cipher_text, job->auth_tag_output);
+
+        job->status |= STS_COMPLETED;
+        return job;
+}
+
 __forceinline
 IMB_JOB *
 submit_kasumi_uea1_job(IMB_MGR *state, IMB_JOB *job)
@@ -309,8 +667,13 @@ submit_docsis_enc_job(IMB_MGR *state, IMB_JOB *job)
 {
         if (16 == job->key_len_in_bytes) {
                 if (job->hash_alg == IMB_AUTH_DOCSIS_CRC32) {
+#ifdef SUBMIT_JOB_DOCSIS128_CRC32_X4
+                        MB_MGR_DOCSIS_CRC32_OOO *p_ooo =
+                                state->docsis128_crc32_x4_ooo;
+#else
                         MB_MGR_DOCSIS_AES_OOO *p_ooo =
                                 state->docsis128_crc32_sec_ooo;
+#endif
 
                         return SUBMIT_JOB_DOCSIS128_SEC_CRC_ENC(p_ooo, job);
                 } else {
@@ -321,8 +684,13 @@ submit_docsis_enc_job(IMB_MGR *state, IMB_JOB *job)
                 }
         } else { /* 32 */
                 if (job->hash_alg == IMB_AUTH_DOCSIS_CRC32) {
+#ifdef SUBMIT_JOB_DOCSIS128_CRC32_X4
+                        MB_MGR_DOCSIS_CRC32_OOO *p_ooo =
+                                state->docsis256_crc32_x4_ooo;
+#else
                         MB_MGR_DOCSIS_AES_OOO *p_ooo =
                                 state->docsis256_crc32_sec_ooo;
+#endif
 
                         return SUBMIT_JOB_DOCSIS256_SEC_CRC_ENC(p_ooo, job);
                 } else {
@@ -340,8 +708,13 @@ flush_docsis_enc_job(IMB_MGR *state, IMB_JOB *job)
 {
         if (16 == job->key_len_in_bytes) {
                 if (job->hash_alg == IMB_AUTH_DOCSIS_CRC32) {
+#ifdef SUBMIT_JOB_DOCSIS128_CRC32_X4
+                        MB_MGR_DOCSIS_CRC32_OOO *p_ooo =
+                                state->docsis128_crc32_x4_ooo;
+#else
                         MB_MGR_DOCSIS_AES_OOO *p_ooo =
                                 state->docsis128_crc32_sec_ooo;
+#endif
 
                         return FLUSH_JOB_DOCSIS128_SEC_CRC_ENC(p_ooo);
                 } else {
@@ -352,8 +725,13 @@ flush_docsis_enc_job(IMB_MGR *state, IMB_JOB *job)
                 }
         } else { /* 32 */
                 if (job->hash_alg == IMB_AUTH_DOCSIS_CRC32) {
+#ifdef SUBMIT_JOB_DOCSIS128_CRC32_X4
+                        MB_MGR_DOCSIS_CRC32_OOO *p_ooo =
+                                state->docsis256_crc32_x4_ooo;
+#else
                         MB_MGR_DOCSIS_AES_OOO *p_ooo =
                                 state->docsis256_crc32_sec_ooo;
+#endif
 
                         return FLUSH_JOB_DOCSIS256_SEC_CRC_ENC(p_ooo);
                 } else {
@@ -428,6 +806,10 @@ SUBMIT_JOB_AES_ENC(IMB_MGR *state, IMB_JOB *job)
                 } else { /* assume 32 */
                         return SUBMIT_JOB_AES_ECB_256_ENC(job);
                 }
+        } else if (IMB_CIPHER_CFB == job->cipher_mode) {
+                return submit_aes_cfb_enc_job(state, job);
+        } else if (IMB_CIPHER_XTS == job->cipher_mode) {
+                return submit_aes_xts_job(job);
         } else if (IMB_CIPHER_DOCSIS_SEC_BPI == job->cipher_mode) {
                 return submit_docsis_enc_job(state, job);
         } else if (IMB_CIPHER_PON_AES_CNTR == job->cipher_mode) {
@@ -465,14 +847,29 @@ SUBMIT_JOB_AES_ENC(IMB_MGR *state, IMB_JOB *job)
                 return DES3_CBC_ENC(job);
 #endif
         } else if (IMB_CIPHER_CCM == job->cipher_mode) {
+#ifdef SUBMIT_JOB_AES128_CCM_CTR_MAC
+                if (IMB_AUTH_AES_CCM == job->hash_alg)
+                        return submit_aes_ccm_ctr_mac_job(state, job);
+#endif /* SUBMIT_JOB_AES128_CCM_CTR_MAC */
                 if (16 == job->key_len_in_bytes) {
                         return AES_CNTR_CCM_128(job);
                 } else { /* assume 32 */
                         return AES_CNTR_CCM_256(job);
                 }
         } else if (IMB_CIPHER_ZUC_EEA3 == job->cipher_mode) {
+#ifdef SUBMIT_JOB_ZUC_EEA3_EIA3
+                if (is_zuc_eea3_eia3_job(job)) {
+                        MB_MGR_ZUC_EEA3_EIA3_OOO *zuc_eea3_eia3_ooo =
+                                state->zuc_eea3_eia3_ooo;
+
+                        return SUBMIT_JOB_ZUC_EEA3_EIA3(zuc_eea3_eia3_ooo,
+                                                        job);
+                }
+#endif /* SUBMIT_JOB_ZUC_EEA3_EIA3 */
                 return SUBMIT_JOB_ZUC_EEA3(zuc_eea3_ooo, job);
         } else if (IMB_CIPHER_SNOW3G_UEA2_BITLEN == job->cipher_mode) {
+                if (is_snow3g_uea2_uia2_job(job))
+                        return submit_snow3g_uea2_uia2_job(job);
                 return submit_snow3g_uea2_job(state, job);
         } else if (IMB_CIPHER_KASUMI_UEA1_BITLEN == job->cipher_mode) {
                 return submit_kasumi_uea1_job(state, job);
@@ -501,6 +898,8 @@ FLUSH_JOB_AES_ENC(IMB_MGR *state, IMB_JOB *job)
                 }
         } else if (IMB_CIPHER_GCM == job->cipher_mode) {
                 return FLUSH_JOB_AES_GCM_ENC(state, job);
+        } else if (IMB_CIPHER_CFB == job->cipher_mode) {
+                return flush_aes_cfb_enc_job(state, job);
         } else if (IMB_CIPHER_DOCSIS_SEC_BPI == job->cipher_mode) {
                 return flush_docsis_enc_job(state, job);
 #ifdef FLUSH_JOB_DES_CBC_ENC
@@ -524,9 +923,17 @@ FLUSH_JOB_AES_ENC(IMB_MGR *state, IMB_JOB *job)
         } else if (IMB_CIPHER_CUSTOM == job->cipher_mode) {
                 return FLUSH_JOB_CUSTOM_CIPHER(job);
         } else if (IMB_CIPHER_ZUC_EEA3 == job->cipher_mode) {
+#ifdef FLUSH_JOB_ZUC_EEA3_EIA3
+                if (is_zuc_eea3_eia3_job(job)) {
+                        MB_MGR_ZUC_EEA3_EIA3_OOO *zuc_eea3_eia3_ooo =
+                                state->zuc_eea3_eia3_ooo;
+
+                        return FLUSH_JOB_ZUC_EEA3_EIA3(zuc_eea3_eia3_ooo);
+                }
+#endif /* FLUSH_JOB_ZUC_EEA3_EIA3 */
                 return FLUSH_JOB_ZUC_EEA3(zuc_eea3_ooo);
         /* assume IMB_CIPHER_CNTR/CNTR_BITLEN, IMB_CIPHER_ECB,
-         * IMB_CIPHER_CCM or IMB_CIPHER_NULL */
+         * IMB_CIPHER_XTS, IMB_CIPHER_CCM or IMB_CIPHER_NULL */
         } else {
                 return NULL;
         }
@@ -558,6 +965,10 @@ SUBMIT_JOB_AES_DEC(IMB_MGR *state, IMB_JOB *job)
                 } else { /* assume 32 */
                         return SUBMIT_JOB_AES_ECB_256_DEC(job);
                 }
+        } else if (IMB_CIPHER_CFB == job->cipher_mode) {
+                return submit_aes_cfb_dec_job(job);
+        } else if (IMB_CIPHER_XTS == job->cipher_mode) {
+                return submit_aes_xts_job(job);
         } else if (IMB_CIPHER_DOCSIS_SEC_BPI == job->cipher_mode) {
                 return submit_docsis_dec_job(state, job);
         } else if (IMB_CIPHER_PON_AES_CNTR == job->cipher_mode) {
@@ -596,14 +1007,29 @@ SUBMIT_JOB_AES_DEC(IMB_MGR *state, IMB_JOB *job)
         } else if (IMB_CIPHER_CUSTOM == job->cipher_mode) {
                 return SUBMIT_JOB_CUSTOM_CIPHER(job);
         } else if (IMB_CIPHER_CCM == job->cipher_mode) {
+#ifdef SUBMIT_JOB_AES128_CCM_CTR_MAC
+                if (IMB_AUTH_AES_CCM == job->hash_alg)
+                        return submit_aes_ccm_ctr_mac_job(state, job);
+#endif /* SUBMIT_JOB_AES128_CCM_CTR_MAC */
                 if (16 == job->key_len_in_bytes) {
                         return AES_CNTR_CCM_128(job);
                 } else { /* assume 32 */
                         return AES_CNTR_CCM_256(job);
                 }
         } else if (IMB_CIPHER_ZUC_EEA3 == job->cipher_mode) {
+#ifdef SUBMIT_JOB_ZUC_EEA3_EIA3
+                if (is_zuc_eea3_eia3_job(job)) {
+                        MB_MGR_ZUC_EEA3_EIA3_OOO *zuc_eea3_eia3_ooo =
+                                state->zuc_eea3_eia3_ooo;
+
+                        return SUBMIT_JOB_ZUC_EEA3_EIA3(zuc_eea3_eia3_ooo,
+                                                        job);
+                }
+#endif /* SUBMIT_JOB_ZUC_EEA3_EIA3 */
                 return SUBMIT_JOB_ZUC_EEA3(zuc_eea3_ooo, job);
         } else if (IMB_CIPHER_SNOW3G_UEA2_BITLEN == job->cipher_mode) {
+                if (is_snow3g_uea2_uia2_job(job))
+                        return submit_snow3g_uea2_uia2_job(job);
                 return submit_snow3g_uea2_job(state, job);
         } else if (IMB_CIPHER_KASUMI_UEA1_BITLEN == job->cipher_mode) {
                 return submit_kasumi_uea1_job(state, job);
@@ -640,6 +1066,14 @@ FLUSH_JOB_AES_DEC(IMB_MGR *state, IMB_JOB *job)
         if (IMB_CIPHER_DOCSIS_DES == job->cipher_mode)
                 return FLUSH_JOB_DOCSIS_DES_DEC(docsis_des_dec_ooo);
 #endif /* FLUSH_JOB_DOCSIS_DES_DEC */
+#ifdef FLUSH_JOB_ZUC_EEA3_EIA3
+        if (is_zuc_eea3_eia3_job(job)) {
+                MB_MGR_ZUC_EEA3_EIA3_OOO *zuc_eea3_eia3_ooo =
+                        state->zuc_eea3_eia3_ooo;
+
+                return FLUSH_JOB_ZUC_EEA3_EIA3(zuc_eea3_eia3_ooo);
+        }
+#endif /* FLUSH_JOB_ZUC_EEA3_EIA3 */
         if (IMB_CIPHER_ZUC_EEA3 == job->cipher_mode)
                 return FLUSH_JOB_ZUC_EEA3(zuc_eea3_ooo);
         (void) state;
@@ -732,6 +1166,10 @@ SUBMIT_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
         case IMB_AUTH_CUSTOM:
                 return SUBMIT_JOB_CUSTOM_HASH(job);
         case IMB_AUTH_AES_CCM:
+#ifdef SUBMIT_JOB_AES128_CCM_CTR_MAC
+                if (IMB_CIPHER_CCM == job->cipher_mode)
+                        return submit_aes_ccm_ctr_mac_job(state, job);
+#endif /* SUBMIT_JOB_AES128_CCM_CTR_MAC */
                 if (16 == job->key_len_in_bytes) {
                         return SUBMIT_JOB_AES128_CCM_AUTH(aes_ccm_ooo, job);
                 } else { /* assume 32 */
@@ -782,8 +1220,19 @@ SUBMIT_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
                 job->status |= STS_COMPLETED_HMAC;
                 return job;
         case IMB_AUTH_ZUC_EIA3_BITLEN:
+#ifdef SUBMIT_JOB_ZUC_EEA3_EIA3
+                if (is_zuc_eea3_eia3_job(job)) {
+                        MB_MGR_ZUC_EEA3_EIA3_OOO *zuc_eea3_eia3_ooo =
+                                state->zuc_eea3_eia3_ooo;
+
+                        return SUBMIT_JOB_ZUC_EEA3_EIA3(zuc_eea3_eia3_ooo,
+                                                        job);
+                }
+#endif /* SUBMIT_JOB_ZUC_EEA3_EIA3 */
                 return SUBMIT_JOB_ZUC_EIA3(zuc_eia3_ooo, job);
         case IMB_AUTH_SNOW3G_UIA2_BITLEN:
+                if (is_snow3g_uea2_uia2_job(job))
+                        return submit_snow3g_uea2_uia2_job(job);
                 IMB_SNOW3G_F9_1_BUFFER(state, (const snow3g_key_schedule_t *)
                                job->u.SNOW3G_UIA2._key,
                                job->u.SNOW3G_UIA2._iv,
@@ -865,6 +1314,10 @@ FLUSH_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
         case IMB_AUTH_CUSTOM:
                 return FLUSH_JOB_CUSTOM_HASH(job);
         case IMB_AUTH_AES_CCM:
+#ifdef FLUSH_JOB_AES128_CCM_CTR_MAC
+                if (IMB_CIPHER_CCM == job->cipher_mode)
+                        return flush_aes_ccm_ctr_mac_job(state, job);
+#endif /* FLUSH_JOB_AES128_CCM_CTR_MAC */
                 if (16 == job->key_len_in_bytes) {
                         return FLUSH_JOB_AES128_CCM_AUTH(aes_ccm_ooo);
                 } else { /* assume 32 */
@@ -876,6 +1329,14 @@ FLUSH_JOB_HASH(IMB_MGR *state, IMB_JOB *job)
         case IMB_AUTH_AES_CMAC_256:
                 return FLUSH_JOB_AES256_CMAC_AUTH(aes_cmac_ooo);
         case IMB_AUTH_ZUC_EIA3_BITLEN:
+#ifdef FLUSH_JOB_ZUC_EEA3_EIA3
+                if (is_zuc_eea3_eia3_job(job)) {
+                        MB_MGR_ZUC_EEA3_EIA3_OOO *zuc_eea3_eia3_ooo =
+                                state->zuc_eea3_eia3_ooo;
+
+                        return FLUSH_JOB_ZUC_EEA3_EIA3(zuc_eea3_eia3_ooo);
+                }
+#endif /* FLUSH_JOB_ZUC_EEA3_EIA3 */
                 return FLUSH_JOB_ZUC_EIA3(zuc_eia3_ooo);
         default: /* assume GCM or IMB_AUTH_NULL */
                 if (!(job->status & STS_COMPLETED_HMAC)) {
@@ -968,13 +1429,17 @@ is_job_invalid(const IMB_JOB *job)
          * of XGEM header */
         const uint64_t max_pon_len = (1 << 14) + 8;
 
+        /* SGL job buffers are in the segments, see is_sgl_invalid() */
+        const int src_null = (job->num_sgl_io_segs == 0 && job->src == NULL);
+        const int dst_null = (job->num_sgl_io_segs == 0 && job->dst == NULL);
+
         switch (job->cipher_mode) {
         case IMB_CIPHER_CBC:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->dst == NULL) {
+                if (dst_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
@@ -1012,11 +1477,11 @@ is_job_invalid(const IMB_JOB *job)
                 }
                 break;
         case IMB_CIPHER_ECB:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->dst == NULL) {
+                if (dst_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
@@ -1043,13 +1508,102 @@ is_job_invalid(const IMB_JOB *job)
                         return 1;
                 }
                 break;
+        case IMB_CIPHER_CFB:
+                if (src_null) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (dst_null) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                /* encryption keys are used in both directions */
+                if (job->enc_keys == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->key_len_in_bytes != UINT64_C(16) &&
+                    job->key_len_in_bytes != UINT64_C(32)) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->msg_len_to_cipher_in_bytes == 0) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv_len_in_bytes != UINT64_C(16)) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                break;
+        case IMB_CIPHER_XTS:
+                if (src_null) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (dst_null) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->key_len_in_bytes != UINT64_C(16) &&
+                    job->key_len_in_bytes != UINT64_C(32)) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                /* minimum length is one full block */
+                if (job->msg_len_to_cipher_in_bytes < UINT64_C(16)) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv_len_in_bytes != UINT64_C(16)) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->cipher_direction == IMB_DIR_ENCRYPT) {
+                        const void * const *ks_ptr =
+                                (const void * const *)job->enc_keys;
+
+                        if (ks_ptr == NULL) {
+                                INVALID_PRN("cipher_mode:%d\n",
+                                            job->cipher_mode);
+                                return 1;
+                        }
+                        if (ks_ptr[0] == NULL || ks_ptr[1] == NULL) {
+                                INVALID_PRN("cipher_mode:%d\n",
+                                            job->cipher_mode);
+                                return 1;
+                        }
+                } else {
+                        const void * const *ks_ptr =
+                                (const void * const *)job->dec_keys;
+
+                        if (ks_ptr == NULL) {
+                                INVALID_PRN("cipher_mode:%d\n",
+                                            job->cipher_mode);
+                                return 1;
+                        }
+                        if (ks_ptr[0] == NULL || ks_ptr[1] == NULL) {
+                                INVALID_PRN("cipher_mode:%d\n",
+                                            job->cipher_mode);
+                                return 1;
+                        }
+                }
+                break;
         case IMB_CIPHER_CNTR:
         case IMB_CIPHER_CNTR_BITLEN:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->dst == NULL) {
+                if (dst_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
@@ -1090,11 +1644,11 @@ is_job_invalid(const IMB_JOB *job)
                  */
                 break;
         case IMB_CIPHER_DOCSIS_SEC_BPI:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->dst == NULL) {
+                if (dst_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
@@ -1123,11 +1677,11 @@ is_job_invalid(const IMB_JOB *job)
                 }
                 break;
         case IMB_CIPHER_GCM:
-                if (job->msg_len_to_cipher_in_bytes != 0 && job->src == NULL) {
+                if (job->msg_len_to_cipher_in_bytes != 0 && src_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->msg_len_to_cipher_in_bytes != 0 && job->dst == NULL) {
+                if (job->msg_len_to_cipher_in_bytes != 0 && dst_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
@@ -1169,11 +1723,11 @@ is_job_invalid(const IMB_JOB *job)
                 }
                 break;
         case IMB_CIPHER_DES:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->dst == NULL) {
+                if (dst_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
@@ -1209,11 +1763,11 @@ is_job_invalid(const IMB_JOB *job)
                 }
                 break;
         case IMB_CIPHER_DOCSIS_DES:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->dst == NULL) {
+                if (dst_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
@@ -1246,12 +1800,12 @@ is_job_invalid(const IMB_JOB *job)
                 break;
         case IMB_CIPHER_CCM:
                 if (job->msg_len_to_cipher_in_bytes != 0) {
-                        if (job->src == NULL) {
+                        if (src_null) {
                                 INVALID_PRN("cipher_mode:%d\n",
                                             job->cipher_mode);
                                 return 1;
                         }
-                        if (job->dst == NULL) {
+                        if (dst_null) {
                                 INVALID_PRN("cipher_mode:%d\n",
                                             job->cipher_mode);
                                 return 1;
@@ -1289,11 +1843,11 @@ is_job_invalid(const IMB_JOB *job)
                 }
                 break;
         case IMB_CIPHER_DES3:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->dst == NULL) {
+                if (dst_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
@@ -1361,11 +1915,11 @@ is_job_invalid(const IMB_JOB *job)
                  * - If msg_len_to_cipher_in_bytes is 0, IV and key pointers
                  *   are not required, as encryption is not done
                  */
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->dst == NULL) {
+                if (dst_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
@@ -1415,11 +1969,11 @@ is_job_invalid(const IMB_JOB *job)
                 }
                 break;
         case IMB_CIPHER_ZUC_EEA3:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->dst == NULL) {
+                if (dst_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
@@ -1446,11 +2000,11 @@ is_job_invalid(const IMB_JOB *job)
                 }
                 break;
         case IMB_CIPHER_SNOW3G_UEA2_BITLEN:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->dst == NULL) {
+                if (dst_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
@@ -1477,11 +2031,11 @@ is_job_invalid(const IMB_JOB *job)
                 }
                 break;
         case IMB_CIPHER_KASUMI_UEA1_BITLEN:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->dst == NULL) {
+                if (dst_null) {
                         INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
@@ -1520,7 +2074,7 @@ is_job_invalid(const IMB_JOB *job)
         case IMB_AUTH_HMAC_SHA_256:
         case IMB_AUTH_HMAC_SHA_384:
         case IMB_AUTH_HMAC_SHA_512:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("hash_alg:%d\n", job->hash_alg);
                         return 1;
                 }
@@ -1597,7 +2151,7 @@ is_job_invalid(const IMB_JOB *job)
                         INVALID_PRN("hash_alg:%d\n", job->hash_alg);
                         return 1;
                 }
-                if (job->msg_len_to_hash_in_bytes != 0 && job->src == NULL) {
+                if (job->msg_len_to_hash_in_bytes != 0 && src_null) {
                         INVALID_PRN("hash_alg:%d\n", job->hash_alg);
                         return 1;
                 }
@@ -1609,7 +2163,7 @@ is_job_invalid(const IMB_JOB *job)
                 }
                 break;
         case IMB_AUTH_AES_CCM:
-                if (job->msg_len_to_hash_in_bytes != 0 && job->src == NULL) {
+                if (job->msg_len_to_hash_in_bytes != 0 && src_null) {
                         INVALID_PRN("hash_alg:%d\n", job->hash_alg);
                         return 1;
                 }
@@ -1660,7 +2214,7 @@ is_job_invalid(const IMB_JOB *job)
                  * (unlike "normal" IMB_AUTH_AES_CMAC, where is passed in bytes,
                  * using job->msg_len_to_hash_in_bytes).
                  */
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("hash_alg:%d\n", job->hash_alg);
                         return 1;
                 }
@@ -1693,7 +2247,7 @@ is_job_invalid(const IMB_JOB *job)
                         INVALID_PRN("hash_alg:%d\n", job->hash_alg);
                         return 1;
                 }
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("hash_alg:%d\n", job->hash_alg);
                         return 1;
                 }
@@ -1739,7 +2293,7 @@ is_job_invalid(const IMB_JOB *job)
                 }
                 break;
         case IMB_AUTH_ZUC_EIA3_BITLEN:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("hash_alg:%d\n", job->hash_alg);
                         return 1;
                 }
@@ -1816,7 +2370,7 @@ is_job_invalid(const IMB_JOB *job)
                 }
                 break;
         case IMB_AUTH_SNOW3G_UIA2_BITLEN:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("hash_alg:%d\n", job->hash_alg);
                         return 1;
                 }
@@ -1839,7 +2393,7 @@ is_job_invalid(const IMB_JOB *job)
                 }
                 break;
         case IMB_AUTH_KASUMI_UIA1:
-                if (job->src == NULL) {
+                if (src_null) {
                         INVALID_PRN("hash_alg:%d\n", job->hash_alg);
                         return 1;
                 }
@@ -1908,6 +2462,9 @@ IMB_JOB *RESUBMIT_JOB(IMB_MGR *state, IMB_JOB *job)
 __forceinline
 IMB_JOB *submit_new_job(IMB_MGR *state, IMB_JOB *job)
 {
+        if (job->num_sgl_io_segs != 0)
+                return submit_sgl_job(state, job);
+
 	if (job->chain_order == IMB_ORDER_CIPHER_HASH)
 		job = SUBMIT_JOB_AES(state, job);
 	else
@@ -1920,6 +2477,11 @@ IMB_JOB *submit_new_job(IMB_MGR *state, IMB_JOB *job)
 __forceinline
 void complete_job(IMB_MGR *state, IMB_JOB *job)
 {
+        if (job->num_sgl_io_segs != 0) {
+                complete_sgl_job(state, job);
+                return;
+        }
+
         if (job->chain_order == IMB_ORDER_CIPHER_HASH) {
                 /* while() loop optimized for cipher_hash order */
                 while (job->status < STS_COMPLETED) {
@@ -1943,6 +2505,35 @@ void complete_job(IMB_MGR *state, IMB_JOB *job)
         }
 }
 
+/*
+ * Appends <job> (if not NULL) and the following in-order completed jobs
+ * to the completion callback batch, starting at index <num_jobs>.
+ * Returns the new number of jobs in the batch.
+ */
+__forceinline
+uint32_t collect_completed_jobs(IMB_MGR *state, IMB_JOB *job,
+                                uint32_t num_jobs)
+{
+        IMB_JOB **jobs = state->completion_cb_jobs;
+
+        if (job != NULL)
+                jobs[num_jobs++] = job;
+
+        while (state->earliest_job >= 0 &&
+               state->earliest_job != state->next_job) {
+                job = JOBS(state, state->earliest_job);
+                if (job->status < STS_COMPLETED)
+                        break;
+                jobs[num_jobs++] = job;
+                ADV_JOBS(&state->earliest_job);
+        }
+
+        if (state->earliest_job == state->next_job)
+                state->earliest_job = -1; /* becomes empty */
+
+        return num_jobs;
+}
+
 __forceinline
 IMB_JOB *
 submit_job_and_check(IMB_MGR *state, const int run_check)
@@ -1955,6 +2546,7 @@ submit_job_and_check(IMB_MGR *state, const int run_check)
 #endif
 
         IMB_JOB *job = NULL;
+        uint32_t num_cb_jobs = 0;
 #ifndef LINUX
         DECLARE_ALIGNED(imb_uint128_t xmm_save[10], 16);
 
@@ -1964,7 +2556,8 @@ submit_job_and_check(IMB_MGR *state, const int run_check)
         job = JOBS(state, state->next_job);
 
         if (run_check) {
-                if (is_job_invalid(job)) {
+                if ((job->num_sgl_io_segs != 0 && is_sgl_invalid(job)) ||
+                    is_job_invalid(job)) {
                         job->status = STS_INVALID_ARGS;
                 } else {
                         job->status = STS_BEING_PROCESSED;
@@ -2002,14 +2595,25 @@ submit_job_and_check(IMB_MGR *state, const int run_check)
 
         ADV_JOBS(&state->earliest_job);
 exit:
+        if (state->completion_cb != NULL) {
+                num_cb_jobs = collect_completed_jobs(state, job, 0);
+                job = NULL;
+        }
+
 #ifdef SAFE_DATA
-        CLEAR_SCRATCH_GPS();
-        CLEAR_SCRATCH_SIMD_REGS();
+        if ((state->flags & IMB_FLAG_SAFE_DATA_BURST) == 0) {
+                CLEAR_SCRATCH_GPS();
+                CLEAR_SCRATCH_SIMD_REGS();
+        }
 #endif /* SAFE_DATA */
 
 #ifndef LINUX
         RESTORE_XMMS(xmm_save);
 #endif
+        /* callback runs application code, registers are cleared by now */
+        if (num_cb_jobs != 0)
+                state->completion_cb(state, state->completion_cb_jobs,
+                                     num_cb_jobs, state->completion_cb_arg);
         return job;
 }
 
@@ -2035,6 +2639,7 @@ FLUSH_JOB(IMB_MGR *state)
         }
 #endif
         IMB_JOB *job;
+        uint32_t num_cb_jobs = 0;
 #ifndef LINUX
         DECLARE_ALIGNED(imb_uint128_t xmm_save[10], 16);
 #endif
@@ -2045,6 +2650,19 @@ FLUSH_JOB(IMB_MGR *state)
 #ifndef LINUX
         SAVE_XMMS(xmm_save);
 #endif
+        if (state->completion_cb != NULL) {
+                /* complete all outstanding jobs, passed in one batch */
+                while (state->earliest_job >= 0) {
+                        job = JOBS(state, state->earliest_job);
+                        complete_job(state, job);
+                        ADV_JOBS(&state->earliest_job);
+                        num_cb_jobs = collect_completed_jobs(state, job,
+                                                             num_cb_jobs);
+                }
+                job = NULL;
+                goto exit;
+        }
+
         job = JOBS(state, state->earliest_job);
         complete_job(state, job);
 
@@ -2053,17 +2671,43 @@ FLUSH_JOB(IMB_MGR *state)
         if (state->earliest_job == state->next_job)
                 state->earliest_job = -1; /* becomes empty */
 
+exit:
 #ifdef SAFE_DATA
-        CLEAR_SCRATCH_GPS();
-        CLEAR_SCRATCH_SIMD_REGS();
+        if ((state->flags & IMB_FLAG_SAFE_DATA_BURST) == 0) {
+                CLEAR_SCRATCH_GPS();
+                CLEAR_SCRATCH_SIMD_REGS();
+        }
 #endif /* SAFE_DATA */
 
 #ifndef LINUX
         RESTORE_XMMS(xmm_save);
 #endif
+        if (num_cb_jobs != 0)
+                state->completion_cb(state, state->completion_cb_jobs,
+                                     num_cb_jobs, state->completion_cb_arg);
         return job;
 }
 
+/*
+ * Clears scratch registers left by jobs submitted/flushed since the last
+ * call. Cleared on request, regardless of IMB_FLAG_SAFE_DATA_BURST or
+ * SAFE_DATA build option.
+ */
+void
+CLEAR_SCRATCH(IMB_MGR *state)
+{
+#ifdef SAFE_PARAM
+        if (state == NULL) {
+                DEBUG_PUTS("clear scratch\n");
+                return;
+        }
+#endif
+        (void) state;
+
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+}
+
 /* ========================================================================= */
 /* ========================================================================= */
 
@@ -2120,7 +2764,11 @@ GET_NEXT_JOB(IMB_MGR *state)
                 return NULL;
         }
 #endif
-        return JOBS(state, state->next_job);
+        IMB_JOB *job = JOBS(state, state->next_job);
+
+        /* job slots are reused, SGL has to be requested explicitly */
+        job->num_sgl_io_segs = 0;
+        return job;
 }
 
 #endif /* MB_MGR_CODE_H */
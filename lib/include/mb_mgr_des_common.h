@@ -0,0 +1,625 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer DES, 3DES and DOCSIS DES out-of-order managers for SSE,
+ * AVX and AVX2 architectures.
+ *
+ * The file is included by architecture specific translation units which
+ * need to define:
+ * - AVX2 for 8 lane (YMM) version, otherwise 4 lane (XMM) version is built
+ * - CLEAR_SCRATCH_SIMD_REGS: function to clear scratch SIMD registers
+ * - SUBMIT_JOB_DES_CBC_ENC, FLUSH_JOB_DES_CBC_ENC,
+ *   SUBMIT_JOB_DES_CBC_DEC, FLUSH_JOB_DES_CBC_DEC,
+ *   SUBMIT_JOB_3DES_CBC_ENC, FLUSH_JOB_3DES_CBC_ENC,
+ *   SUBMIT_JOB_3DES_CBC_DEC, FLUSH_JOB_3DES_CBC_DEC,
+ *   SUBMIT_JOB_DOCSIS_DES_ENC, FLUSH_JOB_DOCSIS_DES_ENC,
+ *   SUBMIT_JOB_DOCSIS_DES_DEC, FLUSH_JOB_DOCSIS_DES_DEC: function names
+ *
+ * DES rounds are computed on all lanes in parallel. S-box lookups are done
+ * on tables held in SIMD registers (PSHUFB for XMM and VPERMD for YMM)
+ * which keeps them free of data dependent memory accesses.
+ */
+
+#ifndef MB_MGR_DES_COMMON_H
+#define MB_MGR_DES_COMMON_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef AVX2
+#include <immintrin.h>
+#else
+#include <smmintrin.h>
+#endif
+
+#include "intel-ipsec-mb.h"
+#include "include/ipsec_ooo_mgr.h"
+#include "include/des.h"
+#include "include/clear_regs_mem.h"
+
+#ifdef AVX2
+#define DES_MB_NUM_LANES AVX2_NUM_DES_LANES
+typedef __m256i des_vec_t;
+#define DES_VEC_LOAD(_p)  _mm256_loadu_si256((const __m256i *)(_p))
+#define DES_VEC_STORE(_p, _v) _mm256_storeu_si256((__m256i *)(_p), _v)
+#define DES_VEC_SET1(_x) _mm256_set1_epi32(_x)
+#define DES_VEC_XOR(_a, _b) _mm256_xor_si256(_a, _b)
+#define DES_VEC_AND(_a, _b) _mm256_and_si256(_a, _b)
+#define DES_VEC_OR(_a, _b) _mm256_or_si256(_a, _b)
+#define DES_VEC_SRLI(_a, _n) _mm256_srli_epi32(_a, _n)
+#define DES_VEC_SLLI(_a, _n) _mm256_slli_epi32(_a, _n)
+#else
+#define DES_MB_NUM_LANES SSE_NUM_DES_LANES
+typedef __m128i des_vec_t;
+#define DES_VEC_LOAD(_p)  _mm_loadu_si128((const __m128i *)(_p))
+#define DES_VEC_STORE(_p, _v) _mm_storeu_si128((__m128i *)(_p), _v)
+#define DES_VEC_SET1(_x) _mm_set1_epi32(_x)
+#define DES_VEC_XOR(_a, _b) _mm_xor_si128(_a, _b)
+#define DES_VEC_AND(_a, _b) _mm_and_si128(_a, _b)
+#define DES_VEC_OR(_a, _b) _mm_or_si128(_a, _b)
+#define DES_VEC_SRLI(_a, _n) _mm_srli_epi32(_a, _n)
+#define DES_VEC_SLLI(_a, _n) _mm_slli_epi32(_a, _n)
+#endif
+
+/* DES rounds and 3DES key schedules */
+#define DES_MB_ROUNDS 16
+#define DES_MB_NUM_KS 3
+
+enum des_mb_cipher {
+        DES_MB_DES = 0,
+        DES_MB_3DES,
+        DES_MB_DOCSIS
+};
+
+/* Key schedule of all lanes in SIMD friendly (lane per word) layout */
+struct des_mb_ks {
+        des_vec_t lo[DES_MB_ROUNDS];
+        des_vec_t hi[DES_MB_ROUNDS];
+};
+
+/* ========================================================================= */
+/* DES on all lanes                                                          */
+/* ========================================================================= */
+
+/**
+ * @brief Constant time S-box lookup on all lanes
+ *
+ * @param tab 64 entry S-box table
+ * @param idx 6-bit S-box indexes, one per lane
+ *
+ * @return S-box values, one per lane
+ */
+__forceinline
+des_vec_t des_mb_sbox(const uint32_t *tab, const des_vec_t idx)
+{
+#ifdef AVX2
+        /* VPERMD takes index bits 2:0, bits 5:3 select the result */
+        const __m256 m3 = _mm256_castsi256_ps(_mm256_slli_epi32(idx, 28));
+        const __m256 m4 = _mm256_castsi256_ps(_mm256_slli_epi32(idx, 27));
+        const __m256 m5 = _mm256_castsi256_ps(_mm256_slli_epi32(idx, 26));
+        __m256 r[8];
+        unsigned i;
+
+        for (i = 0; i < 8; i++)
+                r[i] = _mm256_castsi256_ps(
+                        _mm256_permutevar8x32_epi32(
+                                DES_VEC_LOAD(&tab[i * 8]), idx));
+
+        for (i = 0; i < 4; i++)
+                r[i] = _mm256_blendv_ps(r[2 * i], r[2 * i + 1], m3);
+        for (i = 0; i < 2; i++)
+                r[i] = _mm256_blendv_ps(r[2 * i], r[2 * i + 1], m4);
+        return _mm256_castps_si256(_mm256_blendv_ps(r[0], r[1], m5));
+#else
+        /* PSHUFB takes index bits 1:0 (as byte offsets of the word),
+         * bits 5:2 select the result
+         */
+        const __m128i bcast = _mm_setr_epi8(0, 0, 0, 0, 4, 4, 4, 4,
+                                            8, 8, 8, 8, 12, 12, 12, 12);
+        const __m128i bofs = _mm_set1_epi32(0x03020100);
+        const __m128i bidx =
+                _mm_or_si128(_mm_shuffle_epi8(
+                                     _mm_slli_epi32(
+                                             _mm_and_si128(idx,
+                                                           DES_VEC_SET1(3)),
+                                             2), bcast), bofs);
+        const __m128 m2 = _mm_castsi128_ps(_mm_slli_epi32(idx, 29));
+        const __m128 m3 = _mm_castsi128_ps(_mm_slli_epi32(idx, 28));
+        const __m128 m4 = _mm_castsi128_ps(_mm_slli_epi32(idx, 27));
+        const __m128 m5 = _mm_castsi128_ps(_mm_slli_epi32(idx, 26));
+        __m128 r[16];
+        unsigned i;
+
+        for (i = 0; i < 16; i++)
+                r[i] = _mm_castsi128_ps(
+                        _mm_shuffle_epi8(DES_VEC_LOAD(&tab[i * 4]), bidx));
+
+        for (i = 0; i < 8; i++)
+                r[i] = _mm_blendv_ps(r[2 * i], r[2 * i + 1], m2);
+        for (i = 0; i < 4; i++)
+                r[i] = _mm_blendv_ps(r[2 * i], r[2 * i + 1], m3);
+        for (i = 0; i < 2; i++)
+                r[i] = _mm_blendv_ps(r[2 * i], r[2 * i + 1], m4);
+        return _mm_castps_si128(_mm_blendv_ps(r[0], r[1], m5));
+#endif
+}
+
+/**
+ * @brief DES round function on all lanes
+ *
+ * Combined E-phase, key XOR, S-box and P-phase (see fRK() in des_basic.c).
+ * Index of S-box N is expanded bits of R XOR'ed with byte N of the round key.
+ */
+__forceinline
+des_vec_t des_mb_f(const des_vec_t R, const des_vec_t k_lo,
+                   const des_vec_t k_hi)
+{
+        const des_vec_t m = DES_VEC_SET1(0x3f);
+        des_vec_t x, out;
+
+        x = DES_VEC_OR(DES_VEC_SLLI(R, 1), DES_VEC_SRLI(R, 31));
+        out = des_mb_sbox(des_sbox0p, DES_VEC_AND(DES_VEC_XOR(x, k_lo), m));
+
+        x = DES_VEC_XOR(DES_VEC_SRLI(R, 3), DES_VEC_SRLI(k_lo, 8));
+        out = DES_VEC_OR(out, des_mb_sbox(des_sbox1p, DES_VEC_AND(x, m)));
+
+        x = DES_VEC_XOR(DES_VEC_SRLI(R, 7), DES_VEC_SRLI(k_lo, 16));
+        out = DES_VEC_OR(out, des_mb_sbox(des_sbox2p, DES_VEC_AND(x, m)));
+
+        x = DES_VEC_XOR(DES_VEC_SRLI(R, 11), DES_VEC_SRLI(k_lo, 24));
+        out = DES_VEC_OR(out, des_mb_sbox(des_sbox3p, DES_VEC_AND(x, m)));
+
+        x = DES_VEC_XOR(DES_VEC_SRLI(R, 15), k_hi);
+        out = DES_VEC_OR(out, des_mb_sbox(des_sbox4p, DES_VEC_AND(x, m)));
+
+        x = DES_VEC_XOR(DES_VEC_SRLI(R, 19), DES_VEC_SRLI(k_hi, 8));
+        out = DES_VEC_OR(out, des_mb_sbox(des_sbox5p, DES_VEC_AND(x, m)));
+
+        x = DES_VEC_XOR(DES_VEC_SRLI(R, 23), DES_VEC_SRLI(k_hi, 16));
+        out = DES_VEC_OR(out, des_mb_sbox(des_sbox6p, DES_VEC_AND(x, m)));
+
+        x = DES_VEC_OR(DES_VEC_SRLI(R, 27), DES_VEC_SLLI(R, 5));
+        x = DES_VEC_XOR(x, DES_VEC_SRLI(k_hi, 24));
+        out = DES_VEC_OR(out, des_mb_sbox(des_sbox7p, DES_VEC_AND(x, m)));
+
+        return out;
+}
+
+__forceinline
+void des_mb_permute_op(des_vec_t *pa, des_vec_t *pb,
+                       const int n, const uint32_t m)
+{
+        const des_vec_t t =
+                DES_VEC_AND(DES_VEC_XOR(*pb, DES_VEC_SRLI(*pa, n)),
+                            DES_VEC_SET1(m));
+
+        *pb = DES_VEC_XOR(*pb, t);
+        *pa = DES_VEC_XOR(*pa, DES_VEC_SLLI(t, n));
+}
+
+/**
+ * @brief DES block encryption/decryption on all lanes
+ *
+ * Lane data is split into low (\a lo) and high (\a hi) 32-bit words
+ * of the 64-bit block, same as enc_dec_1() in des_basic.c
+ */
+__forceinline
+void des_mb_enc_dec(des_vec_t *lo, des_vec_t *hi,
+                    const struct des_mb_ks *ks, const int enc)
+{
+        des_vec_t r = *lo, l = *hi;
+        int i;
+
+        /* initial permutation */
+        des_mb_permute_op(&l, &r, 4, 0x0f0f0f0f);
+        des_mb_permute_op(&r, &l, 16, 0x0000ffff);
+        des_mb_permute_op(&l, &r, 2, 0x33333333);
+        des_mb_permute_op(&r, &l, 8, 0x00ff00ff);
+        des_mb_permute_op(&l, &r, 1, 0x55555555);
+
+        if (enc) {
+                for (i = 0; i < DES_MB_ROUNDS; i += 2) {
+                        l = DES_VEC_XOR(l, des_mb_f(r, ks->lo[i],
+                                                    ks->hi[i]));
+                        r = DES_VEC_XOR(r, des_mb_f(l, ks->lo[i + 1],
+                                                    ks->hi[i + 1]));
+                }
+        } else {
+                for (i = DES_MB_ROUNDS - 1; i > 0; i -= 2) {
+                        l = DES_VEC_XOR(l, des_mb_f(r, ks->lo[i],
+                                                    ks->hi[i]));
+                        r = DES_VEC_XOR(r, des_mb_f(l, ks->lo[i - 1],
+                                                    ks->hi[i - 1]));
+                }
+        }
+
+        /* final permutation */
+        des_mb_permute_op(&r, &l, 1, 0x55555555);
+        des_mb_permute_op(&l, &r, 8, 0x00ff00ff);
+        des_mb_permute_op(&r, &l, 2, 0x33333333);
+        des_mb_permute_op(&l, &r, 16, 0x0000ffff);
+        des_mb_permute_op(&r, &l, 4, 0x0f0f0f0f);
+
+        *lo = l;
+        *hi = r;
+}
+
+/**
+ * @brief Transposes key schedules of all lanes into SIMD layout
+ */
+__forceinline
+void des_mb_ks_load(struct des_mb_ks *ks,
+                    const uint64_t * const *lane_ks)
+{
+        DECLARE_ALIGNED(uint32_t lo[DES_MB_NUM_LANES], 32);
+        DECLARE_ALIGNED(uint32_t hi[DES_MB_NUM_LANES], 32);
+        unsigned i, lane;
+
+        for (i = 0; i < DES_MB_ROUNDS; i++) {
+                for (lane = 0; lane < DES_MB_NUM_LANES; lane++) {
+                        lo[lane] = (uint32_t) lane_ks[lane][i];
+                        hi[lane] = (uint32_t) (lane_ks[lane][i] >> 32);
+                }
+                ks->lo[i] = DES_VEC_LOAD(lo);
+                ks->hi[i] = DES_VEC_LOAD(hi);
+        }
+#ifdef SAFE_DATA
+        clear_mem(lo, sizeof(lo));
+        clear_mem(hi, sizeof(hi));
+#endif
+}
+
+/**
+ * @brief DES/3DES CBC on all lanes
+ *
+ * Processes \a size bytes (multiple of 8) of each lane.
+ * Input/output pointers and IV's of the lanes get updated.
+ */
+__forceinline
+void des_mb_cbc(DES_ARGS_x16 *args, const uint32_t size,
+                const enum des_mb_cipher cipher, const int enc)
+{
+        struct des_mb_ks ks[DES_MB_NUM_KS];
+        const uint64_t *lane_ks[DES_MB_NUM_LANES];
+        DECLARE_ALIGNED(uint32_t lo[DES_MB_NUM_LANES], 32);
+        DECLARE_ALIGNED(uint32_t hi[DES_MB_NUM_LANES], 32);
+        des_vec_t iv_lo, iv_hi;
+        uint32_t offset;
+        unsigned lane, k;
+
+        if (cipher == DES_MB_3DES) {
+                for (k = 0; k < DES_MB_NUM_KS; k++) {
+                        for (lane = 0; lane < DES_MB_NUM_LANES; lane++) {
+                                const void * const *ks_ptr =
+                                        (const void * const *)
+                                        args->keys[lane];
+
+                                lane_ks[lane] = ks_ptr[k];
+                        }
+                        des_mb_ks_load(&ks[k], lane_ks);
+                }
+        } else {
+                for (lane = 0; lane < DES_MB_NUM_LANES; lane++)
+                        lane_ks[lane] = (const uint64_t *) args->keys[lane];
+                des_mb_ks_load(&ks[0], lane_ks);
+        }
+
+        iv_lo = DES_VEC_LOAD(&args->IV[0]);
+        iv_hi = DES_VEC_LOAD(&args->IV[AVX512_NUM_DES_LANES]);
+
+        for (offset = 0; offset < size; offset += DES_BLOCK_SIZE) {
+                des_vec_t in_lo, in_hi, d_lo, d_hi;
+
+                /* all lanes get loaded before any of them gets stored */
+                for (lane = 0; lane < DES_MB_NUM_LANES; lane++) {
+                        const uint64_t in = *((const uint64_t *)
+                                              &args->in[lane][offset]);
+
+                        lo[lane] = (uint32_t) in;
+                        hi[lane] = (uint32_t) (in >> 32);
+                }
+                in_lo = DES_VEC_LOAD(lo);
+                in_hi = DES_VEC_LOAD(hi);
+
+                if (enc) {
+                        d_lo = DES_VEC_XOR(in_lo, iv_lo);
+                        d_hi = DES_VEC_XOR(in_hi, iv_hi);
+                        if (cipher == DES_MB_3DES) {
+                                des_mb_enc_dec(&d_lo, &d_hi, &ks[0], 1);
+                                des_mb_enc_dec(&d_lo, &d_hi, &ks[1], 0);
+                                des_mb_enc_dec(&d_lo, &d_hi, &ks[2], 1);
+                        } else {
+                                des_mb_enc_dec(&d_lo, &d_hi, &ks[0], 1);
+                        }
+                        iv_lo = d_lo;
+                        iv_hi = d_hi;
+                } else {
+                        d_lo = in_lo;
+                        d_hi = in_hi;
+                        if (cipher == DES_MB_3DES) {
+                                des_mb_enc_dec(&d_lo, &d_hi, &ks[2], 0);
+                                des_mb_enc_dec(&d_lo, &d_hi, &ks[1], 1);
+                                des_mb_enc_dec(&d_lo, &d_hi, &ks[0], 0);
+                        } else {
+                                des_mb_enc_dec(&d_lo, &d_hi, &ks[0], 0);
+                        }
+                        d_lo = DES_VEC_XOR(d_lo, iv_lo);
+                        d_hi = DES_VEC_XOR(d_hi, iv_hi);
+                        iv_lo = in_lo;
+                        iv_hi = in_hi;
+                }
+
+                DES_VEC_STORE(lo, d_lo);
+                DES_VEC_STORE(hi, d_hi);
+                for (lane = 0; lane < DES_MB_NUM_LANES; lane++)
+                        *((uint64_t *) &args->out[lane][offset]) =
+                                ((uint64_t) hi[lane] << 32) | lo[lane];
+        }
+
+        DES_VEC_STORE(&args->IV[0], iv_lo);
+        DES_VEC_STORE(&args->IV[AVX512_NUM_DES_LANES], iv_hi);
+
+        for (lane = 0; lane < DES_MB_NUM_LANES; lane++) {
+                args->in[lane] += size;
+                args->out[lane] += size;
+        }
+
+#ifdef SAFE_DATA
+        clear_mem(ks, sizeof(ks));
+        clear_mem(lo, sizeof(lo));
+        clear_mem(hi, sizeof(hi));
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif
+}
+
+/* ========================================================================= */
+/* Out-of-order scheduler                                                    */
+/* ========================================================================= */
+
+/**
+ * @brief Processes the shortest job across the lanes and returns it
+ *
+ * All lanes need to be populated (flush fills empty lanes with copies
+ * of a valid lane).
+ */
+__forceinline
+IMB_JOB *des_mb_process(MB_MGR_DES_OOO *state,
+                        const enum des_mb_cipher cipher, const int enc)
+{
+        DES_ARGS_x16 *args = &state->args;
+        unsigned lane, min_idx = 0;
+        uint16_t min_len = state->lens[0];
+        IMB_JOB *job;
+
+        for (lane = 1; lane < DES_MB_NUM_LANES; lane++)
+                if (state->lens[lane] < min_len) {
+                        min_len = state->lens[lane];
+                        min_idx = lane;
+                }
+
+        if (min_len != 0) {
+                for (lane = 0; lane < DES_MB_NUM_LANES; lane++)
+                        state->lens[lane] -= min_len;
+                des_mb_cbc(args, min_len, cipher, enc);
+        }
+
+        /* DOCSIS: DES CFB on the partial block,
+         * IV is the last cipher text block (or the job IV)
+         */
+        if (cipher == DES_MB_DOCSIS && args->partial_len[min_idx] != 0) {
+                const uint64_t iv =
+                        ((uint64_t) args->IV[min_idx +
+                                             AVX512_NUM_DES_LANES] << 32) |
+                        args->IV[min_idx];
+
+                docsis_des_enc_basic(args->last_in[min_idx],
+                                     args->last_out[min_idx],
+                                     (int) args->partial_len[min_idx],
+                                     (const uint64_t *) args->keys[min_idx],
+                                     &iv);
+        }
+
+        /* return the job and put the lane back to the free lanes pool */
+        job = state->job_in_lane[min_idx];
+        state->job_in_lane[min_idx] = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | min_idx;
+        state->num_lanes_inuse--;
+        job->status |= STS_COMPLETED_AES;
+
+#ifdef SAFE_DATA
+        args->IV[min_idx] = 0;
+        args->IV[min_idx + AVX512_NUM_DES_LANES] = 0;
+#endif
+        return job;
+}
+
+__forceinline
+IMB_JOB *des_mb_submit(MB_MGR_DES_OOO *state, IMB_JOB *job,
+                       const enum des_mb_cipher cipher, const int enc)
+{
+        DES_ARGS_x16 *args = &state->args;
+        const uint32_t *iv = (const uint32_t *) job->iv;
+        const uint64_t len = job->msg_len_to_cipher_in_bytes &
+                (~(DES_BLOCK_SIZE - 1));
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xf);
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+
+        state->job_in_lane[lane] = job;
+        args->keys[lane] = enc ? job->enc_keys : job->dec_keys;
+        args->IV[lane] = iv[0];
+        args->IV[lane + AVX512_NUM_DES_LANES] = iv[1];
+        args->in[lane] = job->src + job->cipher_start_src_offset_in_bytes;
+        args->out[lane] = job->dst;
+        state->lens[lane] = (uint16_t) len;
+
+        if (cipher == DES_MB_DOCSIS) {
+                args->block_len[lane] = (uint32_t) len;
+                args->last_in[lane] = args->in[lane] + len;
+                args->last_out[lane] = args->out[lane] + len;
+                args->partial_len[lane] = (uint32_t)
+                        (job->msg_len_to_cipher_in_bytes &
+                         (DES_BLOCK_SIZE - 1));
+        }
+
+        if (state->num_lanes_inuse < DES_MB_NUM_LANES)
+                return NULL;
+
+        return des_mb_process(state, cipher, enc);
+}
+
+__forceinline
+IMB_JOB *des_mb_flush(MB_MGR_DES_OOO *state,
+                      const enum des_mb_cipher cipher, const int enc)
+{
+        DES_ARGS_x16 *args = &state->args;
+        unsigned lane, good_lane = 0;
+#ifdef SAFE_DATA
+        unsigned null_lanes = 0;
+#endif
+        IMB_JOB *job;
+
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        for (lane = 0; lane < DES_MB_NUM_LANES; lane++)
+                if (state->job_in_lane[lane] != NULL) {
+                        good_lane = lane;
+                        break;
+                }
+
+        /* copy valid lane data into empty lanes,
+         * these compute the same result as the valid lane
+         */
+        for (lane = 0; lane < DES_MB_NUM_LANES; lane++) {
+                if (state->job_in_lane[lane] != NULL)
+                        continue;
+#ifdef SAFE_DATA
+                null_lanes |= (1 << lane);
+#endif
+                args->in[lane] = args->in[good_lane];
+                args->out[lane] = args->out[good_lane];
+                args->keys[lane] = args->keys[good_lane];
+                args->IV[lane] = args->IV[good_lane];
+                args->IV[lane + AVX512_NUM_DES_LANES] =
+                        args->IV[good_lane + AVX512_NUM_DES_LANES];
+                args->partial_len[lane] = 0;
+                state->lens[lane] = UINT16_MAX;
+        }
+
+        job = des_mb_process(state, cipher, enc);
+
+#ifdef SAFE_DATA
+        for (lane = 0; lane < DES_MB_NUM_LANES; lane++)
+                if (null_lanes & (1 << lane)) {
+                        args->IV[lane] = 0;
+                        args->IV[lane + AVX512_NUM_DES_LANES] = 0;
+                }
+#endif
+        return job;
+}
+
+/* ========================================================================= */
+/* API's                                                                     */
+/* ========================================================================= */
+
+IMB_JOB *SUBMIT_JOB_DES_CBC_ENC(MB_MGR_DES_OOO *state, IMB_JOB *job);
+IMB_JOB *FLUSH_JOB_DES_CBC_ENC(MB_MGR_DES_OOO *state);
+IMB_JOB *SUBMIT_JOB_DES_CBC_DEC(MB_MGR_DES_OOO *state, IMB_JOB *job);
+IMB_JOB *FLUSH_JOB_DES_CBC_DEC(MB_MGR_DES_OOO *state);
+IMB_JOB *SUBMIT_JOB_3DES_CBC_ENC(MB_MGR_DES_OOO *state, IMB_JOB *job);
+IMB_JOB *FLUSH_JOB_3DES_CBC_ENC(MB_MGR_DES_OOO *state);
+IMB_JOB *SUBMIT_JOB_3DES_CBC_DEC(MB_MGR_DES_OOO *state, IMB_JOB *job);
+IMB_JOB *FLUSH_JOB_3DES_CBC_DEC(MB_MGR_DES_OOO *state);
+IMB_JOB *SUBMIT_JOB_DOCSIS_DES_ENC(MB_MGR_DES_OOO *state, IMB_JOB *job);
+IMB_JOB *FLUSH_JOB_DOCSIS_DES_ENC(MB_MGR_DES_OOO *state);
+IMB_JOB *SUBMIT_JOB_DOCSIS_DES_DEC(MB_MGR_DES_OOO *state, IMB_JOB *job);
+IMB_JOB *FLUSH_JOB_DOCSIS_DES_DEC(MB_MGR_DES_OOO *state);
+
+IMB_JOB *SUBMIT_JOB_DES_CBC_ENC(MB_MGR_DES_OOO *state, IMB_JOB *job)
+{
+        return des_mb_submit(state, job, DES_MB_DES, 1);
+}
+
+IMB_JOB *FLUSH_JOB_DES_CBC_ENC(MB_MGR_DES_OOO *state)
+{
+        return des_mb_flush(state, DES_MB_DES, 1);
+}
+
+IMB_JOB *SUBMIT_JOB_DES_CBC_DEC(MB_MGR_DES_OOO *state, IMB_JOB *job)
+{
+        return des_mb_submit(state, job, DES_MB_DES, 0);
+}
+
+IMB_JOB *FLUSH_JOB_DES_CBC_DEC(MB_MGR_DES_OOO *state)
+{
+        return des_mb_flush(state, DES_MB_DES, 0);
+}
+
+IMB_JOB *SUBMIT_JOB_3DES_CBC_ENC(MB_MGR_DES_OOO *state, IMB_JOB *job)
+{
+        return des_mb_submit(state, job, DES_MB_3DES, 1);
+}
+
+IMB_JOB *FLUSH_JOB_3DES_CBC_ENC(MB_MGR_DES_OOO *state)
+{
+        return des_mb_flush(state, DES_MB_3DES, 1);
+}
+
+IMB_JOB *SUBMIT_JOB_3DES_CBC_DEC(MB_MGR_DES_OOO *state, IMB_JOB *job)
+{
+        return des_mb_submit(state, job, DES_MB_3DES, 0);
+}
+
+IMB_JOB *FLUSH_JOB_3DES_CBC_DEC(MB_MGR_DES_OOO *state)
+{
+        return des_mb_flush(state, DES_MB_3DES, 0);
+}
+
+IMB_JOB *SUBMIT_JOB_DOCSIS_DES_ENC(MB_MGR_DES_OOO *state, IMB_JOB *job)
+{
+        return des_mb_submit(state, job, DES_MB_DOCSIS, 1);
+}
+
+IMB_JOB *FLUSH_JOB_DOCSIS_DES_ENC(MB_MGR_DES_OOO *state)
+{
+        return des_mb_flush(state, DES_MB_DOCSIS, 1);
+}
+
+IMB_JOB *SUBMIT_JOB_DOCSIS_DES_DEC(MB_MGR_DES_OOO *state, IMB_JOB *job)
+{
+        return des_mb_submit(state, job, DES_MB_DOCSIS, 0);
+}
+
+IMB_JOB *FLUSH_JOB_DOCSIS_DES_DEC(MB_MGR_DES_OOO *state)
+{
+        return des_mb_flush(state, DES_MB_DOCSIS, 0);
+}
+
+#endif /* MB_MGR_DES_COMMON_H */
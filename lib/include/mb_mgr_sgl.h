@@ -0,0 +1,1104 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*-----------------------------------------------------------------------
+ * Scatter-gather list (SGL) job processing.
+ *
+ * Jobs with num_sgl_io_segs != 0 describe their data with an array of
+ * IMB_SGL_IOV segments instead of src/dst. Offsets and lengths of the
+ * job (cipher_start_src_offset_in_bytes, hash_start_src_offset_in_bytes
+ * etc.) apply to the concatenation of the input segments and output of
+ * each byte is written at the same position in the output segments.
+ *
+ * AES-CBC encryption and AES-CCM are serial within a message, these jobs
+ * go to out-of-order managers (MB_MGR_SGL_OOO) running the multi-lane
+ * CBC encrypt and CBC-MAC routines. Each lane keeps a cursor in the
+ * segment list of its job: the routine runs over whole blocks in place,
+ * up to the end of the shortest run of the lanes. A block crossing
+ * segment boundaries (or the partial last block of CCM) is gathered
+ * into a block of the lane and scattered back after the routine.
+ *
+ * Other jobs are parallel within a message and are processed at
+ * submission: AES-CBC decryption and AES-CTR run over the segments in
+ * place, AES-GCM goes through the single buffer init/update/finalize API
+ * (GCM jobs are processed by the single buffer routines as well).
+ *
+ * Supported:
+ * - IMB_CIPHER_GCM with IMB_AUTH_AES_GMAC
+ * - IMB_CIPHER_CCM with IMB_AUTH_AES_CCM
+ * - IMB_CIPHER_CBC and IMB_CIPHER_CNTR with IMB_AUTH_NULL or
+ *   IMB_AUTH_HMAC_SHA_1/224/256/384/512
+ *
+ * The including file must define:
+ * - AES_ECB_ENC_128, AES_ECB_ENC_192, AES_ECB_ENC_256
+ * - AES_CBC_DEC_128, AES_CBC_DEC_192, AES_CBC_DEC_256
+ * - AES_CBC_ENC_128_X, AES_CBC_ENC_192_X, AES_CBC_ENC_256_X,
+ *   AES128_CBC_MAC, AES256_CBC_MAC (multi-lane routines of the managers,
+ *   the number of lanes is set at manager initialization)
+ * - SHA1_BLOCK_UPDATE, SHA256_BLOCK_UPDATE, SHA512_BLOCK_UPDATE
+ *   (compression of one block into a digest)
+ *-----------------------------------------------------------------------*/
+
+#ifndef MB_MGR_SGL_H
+#define MB_MGR_SGL_H
+
+#include <string.h>
+
+#include "intel-ipsec-mb.h"
+#include "include/ipsec_ooo_mgr.h"
+#include "include/clear_regs_mem.h"
+
+#define SGL_BLOCK_SIZE   16
+#define SGL_CTR_BLOCKS   8 /* keystream blocks generated at a time */
+#define SGL_CCM_MAX_AAD  46
+
+/* Position in the segment list */
+struct sgl_iter {
+        const struct IMB_SGL_IOV *seg;
+        uint64_t offset; /* offset in the current segment */
+};
+
+/* Block cipher operations applied to segment data at submission */
+enum sgl_cipher_op {
+        SGL_OP_CBC_DEC = 0,
+        SGL_OP_CTR
+};
+
+struct sgl_cipher {
+        DECLARE_ALIGNED(uint8_t iv[SGL_BLOCK_SIZE], 16);  /* CBC chaining */
+        DECLARE_ALIGNED(uint8_t ctr[SGL_BLOCK_SIZE], 16); /* counter block */
+        DECLARE_ALIGNED(uint8_t ks[SGL_CTR_BLOCKS * SGL_BLOCK_SIZE], 16);
+        const void *keys;
+        uint64_t key_len;
+        enum sgl_cipher_op op;
+};
+
+struct sgl_hmac {
+        union {
+                uint32_t d32[NUM_SHA_256_DIGEST_WORDS];
+                uint64_t d64[NUM_SHA_512_DIGEST_WORDS];
+        } digest;
+        DECLARE_ALIGNED(uint8_t block[SHA_512_BLOCK_SIZE], 16);
+        uint64_t block_size;
+        uint64_t digest_size; /* inner digest size in bytes */
+        uint64_t fill;        /* bytes buffered in block[] */
+        uint64_t total;       /* bytes hashed, including the ipad block */
+        JOB_HASH_ALG alg;
+};
+
+/* ========================================================================= */
+/* Segment iteration */
+/* ========================================================================= */
+
+__forceinline
+void
+sgl_iter_init(struct sgl_iter *it, const IMB_JOB *job, uint64_t offset)
+{
+        it->seg = job->sgl_io_segs;
+        while (offset >= it->seg->len && offset != 0) {
+                offset -= it->seg->len;
+                it->seg++;
+        }
+        it->offset = offset;
+}
+
+/*
+ * Returns the next contiguous chunk of up to max_len bytes (max_len > 0).
+ * Job checks guarantee the segments cover the requested data.
+ */
+__forceinline
+uint64_t
+sgl_iter_next(struct sgl_iter *it, const uint8_t **in, uint8_t **out,
+              const uint64_t max_len)
+{
+        uint64_t len;
+
+        while (it->offset == it->seg->len) {
+                it->seg++;
+                it->offset = 0;
+        }
+        len = it->seg->len - it->offset;
+        if (len > max_len)
+                len = max_len;
+
+        *in = (const uint8_t *) it->seg->in + it->offset;
+        if (out != NULL)
+                *out = (uint8_t *) it->seg->out + it->offset;
+        it->offset += len;
+        return len;
+}
+
+/* Writes data to the output segments, starting at the iterator position */
+__forceinline
+void
+sgl_scatter(struct sgl_iter *it, const uint8_t *data, uint64_t len)
+{
+        while (len != 0) {
+                const uint8_t *in;
+                uint8_t *out;
+                const uint64_t n = sgl_iter_next(it, &in, &out, len);
+
+                memcpy(out, data, n);
+                data += n;
+                len -= n;
+        }
+}
+
+/* ========================================================================= */
+/* AES block operations */
+/* ========================================================================= */
+
+__forceinline
+void
+sgl_aes_ecb_enc(const struct sgl_cipher *c, const void *in, void *out,
+                const uint64_t len)
+{
+        if (c->key_len == 16)
+                AES_ECB_ENC_128(in, c->keys, out, len);
+        else if (c->key_len == 24)
+                AES_ECB_ENC_192(in, c->keys, out, len);
+        else /* assume 32 */
+                AES_ECB_ENC_256(in, c->keys, out, len);
+}
+
+__forceinline
+void
+sgl_xor_block(uint8_t *out, const uint8_t *a, const uint8_t *b)
+{
+        unsigned i;
+
+        for (i = 0; i < SGL_BLOCK_SIZE; i++)
+                out[i] = a[i] ^ b[i];
+}
+
+/* Increments the 32-bit big endian counter in the last 4 bytes */
+__forceinline
+void
+sgl_ctr_inc(uint8_t *ctr)
+{
+        int i;
+
+        for (i = SGL_BLOCK_SIZE - 1; i >= SGL_BLOCK_SIZE - 4; i--)
+                if (++ctr[i] != 0)
+                        break;
+}
+
+/* XOR's the CTR keystream with num_blocks blocks */
+__forceinline
+void
+sgl_ctr(struct sgl_cipher *c, const uint8_t *in, uint8_t *out,
+        uint64_t num_blocks)
+{
+        while (num_blocks != 0) {
+                const uint64_t n = (num_blocks > SGL_CTR_BLOCKS) ?
+                        SGL_CTR_BLOCKS : num_blocks;
+                uint64_t i;
+
+                for (i = 0; i < n; i++) {
+                        memcpy(&c->ks[i * SGL_BLOCK_SIZE], c->ctr,
+                               SGL_BLOCK_SIZE);
+                        sgl_ctr_inc(c->ctr);
+                }
+                sgl_aes_ecb_enc(c, c->ks, c->ks, n * SGL_BLOCK_SIZE);
+                for (i = 0; i < n * SGL_BLOCK_SIZE; i++)
+                        out[i] = in[i] ^ c->ks[i];
+
+                in += n * SGL_BLOCK_SIZE;
+                out += n * SGL_BLOCK_SIZE;
+                num_blocks -= n;
+        }
+}
+
+/*
+ * Applies the cipher operation to len bytes.
+ * len is a multiple of the block size, except for the last block
+ * of the message which is passed in a zero padded local buffer.
+ */
+__forceinline
+void
+sgl_cipher_blocks(struct sgl_cipher *c, const uint8_t *in, uint8_t *out,
+                  const uint64_t len)
+{
+        const uint64_t num_blocks = (len + SGL_BLOCK_SIZE - 1) /
+                SGL_BLOCK_SIZE;
+
+        if (c->op == SGL_OP_CBC_DEC) {
+                /* last cipher text block is the next IV (in-place) */
+                DECLARE_ALIGNED(uint8_t next_iv[SGL_BLOCK_SIZE], 16);
+
+                memcpy(next_iv, &in[len - SGL_BLOCK_SIZE], SGL_BLOCK_SIZE);
+                if (c->key_len == 16)
+                        AES_CBC_DEC_128(in, c->iv, c->keys, out, len);
+                else if (c->key_len == 24)
+                        AES_CBC_DEC_192(in, c->iv, c->keys, out, len);
+                else /* assume 32 */
+                        AES_CBC_DEC_256(in, c->iv, c->keys, out, len);
+                memcpy(c->iv, next_iv, SGL_BLOCK_SIZE);
+        } else {
+                sgl_ctr(c, in, out, num_blocks);
+        }
+}
+
+/*
+ * Runs the cipher operation over len bytes of the segments at offset.
+ * Runs of whole blocks are processed directly in the segments.
+ */
+__forceinline
+void
+sgl_cipher_process(struct sgl_cipher *c, const IMB_JOB *job,
+                   const uint64_t offset, uint64_t len)
+{
+        DECLARE_ALIGNED(uint8_t block[SGL_BLOCK_SIZE], 16);
+        struct sgl_iter it, block_start;
+        uint64_t fill = 0;
+
+        sgl_iter_init(&it, job, offset);
+        block_start = it;
+
+        while (len != 0) {
+                const uint8_t *in;
+                uint8_t *out;
+                uint64_t n;
+
+                if (fill == 0) {
+                        uint64_t full;
+
+                        n = sgl_iter_next(&it, &in, &out, len);
+                        len -= n;
+                        full = n & ~((uint64_t) SGL_BLOCK_SIZE - 1);
+                        if (full != 0)
+                                sgl_cipher_blocks(c, in, out, full);
+                        n -= full;
+                        if (n == 0)
+                                continue;
+                        /* block crossing a segment boundary (or last) */
+                        block_start = it;
+                        block_start.offset -= n;
+                        memcpy(block, &in[full], n);
+                        fill = n;
+                } else {
+                        const uint64_t max_len =
+                                (len < SGL_BLOCK_SIZE - fill) ?
+                                len : SGL_BLOCK_SIZE - fill;
+
+                        n = sgl_iter_next(&it, &in, NULL, max_len);
+                        len -= n;
+                        memcpy(&block[fill], in, n);
+                        fill += n;
+                }
+
+                if (fill == SGL_BLOCK_SIZE) {
+                        sgl_cipher_blocks(c, block, block, SGL_BLOCK_SIZE);
+                        sgl_scatter(&block_start, block, SGL_BLOCK_SIZE);
+                        fill = 0;
+                }
+        }
+
+        /* partial last block, CBC messages are whole blocks (job checks) */
+        if (fill != 0 && c->op == SGL_OP_CTR) {
+                memset(&block[fill], 0, SGL_BLOCK_SIZE - fill);
+                sgl_cipher_blocks(c, block, block, fill);
+                sgl_scatter(&block_start, block, fill);
+        }
+#ifdef SAFE_DATA
+        clear_mem(block, sizeof(block));
+#endif
+}
+
+/* ========================================================================= */
+/* HMAC-SHA */
+/* ========================================================================= */
+
+__forceinline
+void
+sgl_hmac_block(struct sgl_hmac *h, const void *data)
+{
+        if (h->alg == IMB_AUTH_HMAC_SHA_1)
+                SHA1_BLOCK_UPDATE(data, &h->digest);
+        else if (h->block_size == SHA_256_BLOCK_SIZE) /* SHA224/256 */
+                SHA256_BLOCK_UPDATE(data, &h->digest);
+        else /* SHA384/512 */
+                SHA512_BLOCK_UPDATE(data, &h->digest);
+}
+
+/* Stores the digest as big endian words */
+__forceinline
+void
+sgl_hmac_digest_bytes(const struct sgl_hmac *h, uint8_t *out,
+                      const uint64_t len)
+{
+        uint64_t i;
+
+        if (h->block_size == SHA_256_BLOCK_SIZE)
+                for (i = 0; i < len; i++)
+                        out[i] = (uint8_t) (h->digest.d32[i / 4] >>
+                                            (24 - 8 * (i % 4)));
+        else
+                for (i = 0; i < len; i++)
+                        out[i] = (uint8_t) (h->digest.d64[i / 8] >>
+                                            (56 - 8 * (i % 8)));
+}
+
+/* Starts from the digest after the ipad/opad block */
+__forceinline
+void
+sgl_hmac_init(struct sgl_hmac *h, const JOB_HASH_ALG alg, const void *pad)
+{
+        h->alg = alg;
+        switch (alg) {
+        case IMB_AUTH_HMAC_SHA_1:
+                h->block_size = SHA1_BLOCK_SIZE;
+                h->digest_size = SHA1_DIGEST_SIZE_IN_BYTES;
+                memcpy(&h->digest, pad, SHA1_DIGEST_SIZE_IN_BYTES);
+                break;
+        case IMB_AUTH_HMAC_SHA_224:
+        case IMB_AUTH_HMAC_SHA_256:
+                h->block_size = SHA_256_BLOCK_SIZE;
+                h->digest_size = (alg == IMB_AUTH_HMAC_SHA_224) ?
+                        SHA224_DIGEST_SIZE_IN_BYTES :
+                        SHA256_DIGEST_SIZE_IN_BYTES;
+                memcpy(&h->digest, pad, SHA256_DIGEST_SIZE_IN_BYTES);
+                break;
+        default: /* IMB_AUTH_HMAC_SHA_384 or IMB_AUTH_HMAC_SHA_512 */
+                h->block_size = SHA_512_BLOCK_SIZE;
+                h->digest_size = (alg == IMB_AUTH_HMAC_SHA_384) ?
+                        SHA384_DIGEST_SIZE_IN_BYTES :
+                        SHA512_DIGEST_SIZE_IN_BYTES;
+                memcpy(&h->digest, pad, SHA512_DIGEST_SIZE_IN_BYTES);
+                break;
+        }
+        h->fill = 0;
+        h->total = h->block_size;
+}
+
+__forceinline
+void
+sgl_hmac_update(struct sgl_hmac *h, const uint8_t *data, uint64_t len)
+{
+        h->total += len;
+
+        if (h->fill != 0) {
+                const uint64_t n = (len < h->block_size - h->fill) ?
+                        len : h->block_size - h->fill;
+
+                memcpy(&h->block[h->fill], data, n);
+                h->fill += n;
+                data += n;
+                len -= n;
+                if (h->fill < h->block_size)
+                        return;
+                sgl_hmac_block(h, h->block);
+                h->fill = 0;
+        }
+
+        /* whole blocks straight from the segment */
+        for (; len >= h->block_size; len -= h->block_size) {
+                sgl_hmac_block(h, data);
+                data += h->block_size;
+        }
+
+        memcpy(h->block, data, len);
+        h->fill = len;
+}
+
+/* Pads the message and processes the last block(s) */
+__forceinline
+void
+sgl_hmac_pad(struct sgl_hmac *h)
+{
+        const uint64_t bits = h->total * 8;
+        unsigned i;
+
+        h->block[h->fill++] = 0x80;
+        if (h->fill > h->block_size - (h->block_size / 8)) {
+                /* length field (8 or 16 bytes) goes to the next block */
+                memset(&h->block[h->fill], 0, h->block_size - h->fill);
+                sgl_hmac_block(h, h->block);
+                h->fill = 0;
+        }
+        memset(&h->block[h->fill], 0, h->block_size - h->fill);
+        for (i = 0; i < 8; i++)
+                h->block[h->block_size - 1 - i] = (uint8_t) (bits >> (8 * i));
+        sgl_hmac_block(h, h->block);
+}
+
+__forceinline
+void
+sgl_hmac_final(struct sgl_hmac *h, const IMB_JOB *job)
+{
+        DECLARE_ALIGNED(uint8_t inner[SHA512_DIGEST_SIZE_IN_BYTES], 16);
+        const uint64_t digest_size = h->digest_size;
+
+        sgl_hmac_pad(h);
+        sgl_hmac_digest_bytes(h, inner, digest_size);
+
+        sgl_hmac_init(h, h->alg, job->u.HMAC._hashed_auth_key_xor_opad);
+        sgl_hmac_update(h, inner, digest_size);
+        sgl_hmac_pad(h);
+        sgl_hmac_digest_bytes(h, job->auth_tag_output,
+                              job->auth_tag_output_len_in_bytes);
+#ifdef SAFE_DATA
+        clear_mem(inner, sizeof(inner));
+#endif
+}
+
+/* HMAC over the input segments */
+__forceinline
+void
+sgl_hmac_process(const IMB_JOB *job)
+{
+        struct sgl_hmac h;
+        struct sgl_iter it;
+        uint64_t len = job->msg_len_to_hash_in_bytes;
+
+        sgl_hmac_init(&h, job->hash_alg,
+                      job->u.HMAC._hashed_auth_key_xor_ipad);
+        sgl_iter_init(&it, job, job->hash_start_src_offset_in_bytes);
+        while (len != 0) {
+                const uint8_t *in;
+                const uint64_t n = sgl_iter_next(&it, &in, NULL, len);
+
+                sgl_hmac_update(&h, in, n);
+                len -= n;
+        }
+        sgl_hmac_final(&h, job);
+#ifdef SAFE_DATA
+        clear_mem(&h, sizeof(h));
+#endif
+}
+
+/* ========================================================================= */
+/* Cipher modes */
+/* ========================================================================= */
+
+/* AES-CBC decryption and AES-CTR */
+__forceinline
+void
+sgl_aes_cipher(const IMB_JOB *job)
+{
+        struct sgl_cipher c;
+
+        c.key_len = job->key_len_in_bytes;
+        if (job->cipher_mode == IMB_CIPHER_CNTR) {
+                c.op = SGL_OP_CTR;
+                c.keys = job->enc_keys;
+                if (job->iv_len_in_bytes == 16) {
+                        memcpy(c.ctr, job->iv, 16);
+                } else {
+                        /* 12-byte IV: nonce + IV, block counter 1 */
+                        memcpy(c.ctr, job->iv, 12);
+                        c.ctr[12] = 0;
+                        c.ctr[13] = 0;
+                        c.ctr[14] = 0;
+                        c.ctr[15] = 1;
+                }
+        } else {
+                c.op = SGL_OP_CBC_DEC;
+                c.keys = job->dec_keys;
+                memcpy(c.iv, job->iv, SGL_BLOCK_SIZE);
+        }
+
+        sgl_cipher_process(&c, job, job->cipher_start_src_offset_in_bytes,
+                           job->msg_len_to_cipher_in_bytes);
+#ifdef SAFE_DATA
+        clear_mem(&c, sizeof(c));
+#endif
+}
+
+/*
+ * AES-CCM: B0 and AAD blocks (AAD length | AAD | zero padding).
+ * Returns the number of blocks (up to 4).
+ */
+__forceinline
+uint64_t
+sgl_ccm_b0_aad(uint8_t *b, const IMB_JOB *job)
+{
+        const uint64_t nonce_len = job->iv_len_in_bytes;
+        const uint64_t aad_len = job->u.CCM.aad_len_in_bytes;
+        uint64_t msg_len = job->msg_len_to_cipher_in_bytes;
+        uint64_t num_blocks = 1;
+        unsigned i;
+
+        /* B0: flags | nonce | message length */
+        memset(b, 0, 4 * SGL_BLOCK_SIZE);
+        b[0] = (uint8_t) (((job->auth_tag_output_len_in_bytes - 2) / 2) << 3);
+        b[0] |= (uint8_t) (14 - nonce_len);
+        memcpy(&b[1], job->iv, nonce_len);
+        for (i = SGL_BLOCK_SIZE - 1; i > nonce_len; i--) {
+                b[i] = (uint8_t) msg_len;
+                msg_len >>= 8;
+        }
+
+        if (aad_len != 0) {
+                b[0] |= 0x40;
+                b[SGL_BLOCK_SIZE] = (uint8_t) (aad_len >> 8);
+                b[SGL_BLOCK_SIZE + 1] = (uint8_t) aad_len;
+                memcpy(&b[SGL_BLOCK_SIZE + 2], job->u.CCM.aad, aad_len);
+                num_blocks += (aad_len + 2 + SGL_BLOCK_SIZE - 1) /
+                        SGL_BLOCK_SIZE;
+        }
+
+        return num_blocks;
+}
+
+/* AES-CCM: counter block 0 (flags | nonce | 0) */
+__forceinline
+void
+sgl_ccm_ctr0(uint8_t *ctr, const IMB_JOB *job)
+{
+        const uint64_t nonce_len = job->iv_len_in_bytes;
+
+        memset(ctr, 0, SGL_BLOCK_SIZE);
+        ctr[0] = (uint8_t) (14 - nonce_len);
+        memcpy(&ctr[1], job->iv, nonce_len);
+}
+
+/* AES-CCM: CTR over the message segments, starting with counter block 1 */
+__forceinline
+void
+sgl_ccm_ctr(const IMB_JOB *job)
+{
+        struct sgl_cipher c;
+
+        c.key_len = job->key_len_in_bytes;
+        c.keys = job->enc_keys;
+        c.op = SGL_OP_CTR;
+        sgl_ccm_ctr0(c.ctr, job);
+        sgl_ctr_inc(c.ctr);
+
+        sgl_cipher_process(&c, job, job->cipher_start_src_offset_in_bytes,
+                           job->msg_len_to_cipher_in_bytes);
+#ifdef SAFE_DATA
+        clear_mem(&c, sizeof(c));
+#endif
+}
+
+/* AES-CCM: tag = CBC-MAC ^ E(ctr0) */
+__forceinline
+void
+sgl_ccm_tag(const IMB_JOB *job, const uint8_t *mac)
+{
+        DECLARE_ALIGNED(uint8_t b[SGL_BLOCK_SIZE], 16);
+        struct sgl_cipher c;
+
+        c.key_len = job->key_len_in_bytes;
+        c.keys = job->enc_keys;
+        sgl_ccm_ctr0(b, job);
+        sgl_aes_ecb_enc(&c, b, b, SGL_BLOCK_SIZE);
+        sgl_xor_block(b, b, mac);
+        memcpy(job->auth_tag_output, b, job->auth_tag_output_len_in_bytes);
+#ifdef SAFE_DATA
+        clear_mem(b, sizeof(b));
+#endif
+}
+
+/*
+ * AES-GCM through the direct init/update/finalize API,
+ * the usual 12-byte IV takes the init routine of GCM jobs
+ */
+__forceinline
+void
+sgl_aes_gcm(IMB_MGR *state, const IMB_JOB *job)
+{
+        const struct gcm_key_data *key =
+                (const struct gcm_key_data *)
+                ((job->cipher_direction == IMB_DIR_ENCRYPT) ?
+                 job->enc_keys : job->dec_keys);
+        aes_gcm_init_t init;
+        aes_gcm_init_var_iv_t init_var_iv;
+        aes_gcm_enc_dec_update_t update;
+        aes_gcm_enc_dec_finalize_t finalize;
+        struct gcm_context_data ctx;
+        struct sgl_iter it;
+        uint64_t len = job->msg_len_to_cipher_in_bytes;
+
+        if (job->key_len_in_bytes == 16) {
+                init = state->gcm128_init;
+                init_var_iv = state->gcm128_init_var_iv;
+                update = (job->cipher_direction == IMB_DIR_ENCRYPT) ?
+                        state->gcm128_enc_update : state->gcm128_dec_update;
+                finalize = (job->cipher_direction == IMB_DIR_ENCRYPT) ?
+                        state->gcm128_enc_finalize :
+                        state->gcm128_dec_finalize;
+        } else if (job->key_len_in_bytes == 24) {
+                init = state->gcm192_init;
+                init_var_iv = state->gcm192_init_var_iv;
+                update = (job->cipher_direction == IMB_DIR_ENCRYPT) ?
+                        state->gcm192_enc_update : state->gcm192_dec_update;
+                finalize = (job->cipher_direction == IMB_DIR_ENCRYPT) ?
+                        state->gcm192_enc_finalize :
+                        state->gcm192_dec_finalize;
+        } else { /* assume 32 */
+                init = state->gcm256_init;
+                init_var_iv = state->gcm256_init_var_iv;
+                update = (job->cipher_direction == IMB_DIR_ENCRYPT) ?
+                        state->gcm256_enc_update : state->gcm256_dec_update;
+                finalize = (job->cipher_direction == IMB_DIR_ENCRYPT) ?
+                        state->gcm256_enc_finalize :
+                        state->gcm256_dec_finalize;
+        }
+
+        if (job->iv_len_in_bytes == 12)
+                init(key, &ctx, job->iv, (const uint8_t *) job->u.GCM.aad,
+                     job->u.GCM.aad_len_in_bytes);
+        else
+                init_var_iv(key, &ctx, job->iv, job->iv_len_in_bytes,
+                            (const uint8_t *) job->u.GCM.aad,
+                            job->u.GCM.aad_len_in_bytes);
+
+        sgl_iter_init(&it, job, job->cipher_start_src_offset_in_bytes);
+        while (len != 0) {
+                const uint8_t *in;
+                uint8_t *out;
+                const uint64_t n = sgl_iter_next(&it, &in, &out, len);
+
+                update(key, &ctx, out, in, n);
+                len -= n;
+        }
+
+        finalize(key, &ctx, job->auth_tag_output,
+                 job->auth_tag_output_len_in_bytes);
+#ifdef SAFE_DATA
+        clear_mem(&ctx, sizeof(ctx));
+#endif
+}
+
+/* ========================================================================= */
+/* Out-of-order managers (AES-CBC encryption and AES-CCM) */
+/* ========================================================================= */
+
+/* Multi-lane CBC encrypt or CBC-MAC routine of a manager */
+typedef void (*sgl_lanes_fn_t)(AES_ARGS *args, uint64_t len);
+
+/* B0/AAD blocks and gathered block of a lane */
+__forceinline
+uint8_t *
+sgl_lane_blocks(MB_MGR_SGL_OOO *state, const unsigned lane)
+{
+        return &state->blocks[lane * 4 * SGL_BLOCK_SIZE];
+}
+
+/*
+ * Sets up the next chunk of a lane: whole blocks in place from the
+ * cursor position or one block gathered into the lane block.
+ * CCM decryption authenticates the plain text, read from the output.
+ */
+static inline void
+sgl_lane_next_chunk(MB_MGR_SGL_OOO *state, const unsigned lane)
+{
+        const IMB_JOB *job = state->job_in_lane[lane];
+        const int mac_output = (job->cipher_mode == IMB_CIPHER_CCM &&
+                                job->cipher_direction == IMB_DIR_DECRYPT);
+        const uint64_t remain = state->remain[lane];
+        uint8_t *block = sgl_lane_blocks(state, lane);
+        struct sgl_iter it;
+        const uint8_t *in;
+        uint8_t *out;
+        uint64_t n, fill;
+
+        state->block_len[lane] = 0;
+        if (remain == 0) {
+                state->lens[lane] = 0; /* job done */
+                return;
+        }
+
+        it.seg = state->seg[lane];
+        it.offset = state->seg_offset[lane];
+        n = sgl_iter_next(&it, &in, &out, remain);
+
+        if (n >= SGL_BLOCK_SIZE) {
+                const uint64_t full = n & ~((uint64_t) SGL_BLOCK_SIZE - 1);
+
+                it.offset -= n - full;
+                state->args.in[lane] = mac_output ? out : in;
+                state->args.out[lane] = out;
+                state->lens[lane] = full;
+                state->remain[lane] = remain - full;
+        } else {
+                const uint64_t len = (remain < SGL_BLOCK_SIZE) ?
+                        remain : SGL_BLOCK_SIZE;
+
+                state->block_seg[lane] = it.seg;
+                state->block_offset[lane] = it.offset - n;
+                memset(block, 0, SGL_BLOCK_SIZE);
+                memcpy(block, mac_output ? out : in, n);
+                for (fill = n; fill < len; fill += n) {
+                        n = sgl_iter_next(&it, &in, &out, len - fill);
+                        memcpy(&block[fill], mac_output ? out : in, n);
+                }
+                state->args.in[lane] = block;
+                state->args.out[lane] = block;
+                state->lens[lane] = SGL_BLOCK_SIZE;
+                state->block_len[lane] = len;
+                state->remain[lane] = remain - len;
+        }
+        state->seg[lane] = it.seg;
+        state->seg_offset[lane] = it.offset;
+}
+
+/* Scatters the cipher text of a gathered block (CBC encryption) */
+static inline void
+sgl_lane_chunk_done(MB_MGR_SGL_OOO *state, const unsigned lane)
+{
+        const IMB_JOB *job = state->job_in_lane[lane];
+        struct sgl_iter it;
+
+        if (state->block_len[lane] == 0 || job->cipher_mode != IMB_CIPHER_CBC)
+                return;
+
+        it.seg = state->block_seg[lane];
+        it.offset = state->block_offset[lane];
+        sgl_scatter(&it, sgl_lane_blocks(state, lane),
+                    state->block_len[lane]);
+}
+
+/* Copies arguments of lane src into (empty) lane dst */
+__forceinline
+void
+sgl_copy_lane(AES_ARGS *args, const unsigned dst, const unsigned src)
+{
+        unsigned r;
+
+        args->in[dst] = args->in[src];
+        args->out[dst] = args->out[src];
+        args->keys[dst] = args->keys[src];
+        args->IV[dst] = args->IV[src];
+        for (r = 0; r < 15; r++)
+                args->key_tab[r][dst] = args->key_tab[r][src];
+}
+
+#ifdef SAFE_DATA
+/* Clears keys, IV and blocks of a lane */
+__forceinline
+void
+sgl_clear_lane(MB_MGR_SGL_OOO *state, const unsigned lane)
+{
+        unsigned r;
+
+        clear_mem(&state->args.IV[lane], sizeof(state->args.IV[lane]));
+        for (r = 0; r < 15; r++)
+                clear_mem(&state->args.key_tab[r][lane],
+                          sizeof(state->args.key_tab[r][lane]));
+        clear_mem(sgl_lane_blocks(state, lane), 4 * SGL_BLOCK_SIZE);
+}
+#endif
+
+/* Finishes the job of a lane (CCM CTR and tag, HMAC) and returns it */
+static inline IMB_JOB *
+sgl_return_lane(MB_MGR_SGL_OOO *state, const unsigned lane)
+{
+        IMB_JOB *job = state->job_in_lane[lane];
+
+        if (job->cipher_mode == IMB_CIPHER_CCM) {
+                if (job->cipher_direction == IMB_DIR_ENCRYPT)
+                        sgl_ccm_ctr(job);
+                sgl_ccm_tag(job, (const uint8_t *) &state->args.IV[lane]);
+        } else if (job->hash_alg != IMB_AUTH_NULL &&
+                   job->chain_order == IMB_ORDER_CIPHER_HASH) {
+                sgl_hmac_process(job);
+        }
+#ifdef SAFE_DATA
+        sgl_clear_lane(state, lane);
+#endif
+
+        state->num_lanes_inuse--;
+        state->job_in_lane[lane] = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        job->status |= STS_COMPLETED;
+
+        return job;
+}
+
+/*
+ * Runs the multi-lane routine until one of the jobs is completed.
+ * Lanes with no job are given a copy of a valid lane.
+ */
+static inline IMB_JOB *
+sgl_process_lanes(MB_MGR_SGL_OOO *state, const sgl_lanes_fn_t lanes_fn)
+{
+        const unsigned num_lanes = (unsigned) state->num_lanes;
+        unsigned i, idx;
+
+        while (1) {
+                uint64_t min_len = UINT64_MAX;
+
+                idx = num_lanes;
+                for (i = 0; i < num_lanes; i++) {
+                        if (state->job_in_lane[i] == NULL)
+                                continue;
+                        if (state->lens[i] == 0)
+                                return sgl_return_lane(state, i);
+                        if (state->lens[i] < min_len)
+                                min_len = state->lens[i];
+                        idx = i;
+                }
+
+                for (i = 0; i < num_lanes; i++)
+                        if (state->job_in_lane[i] == NULL)
+                                sgl_copy_lane(&state->args, i, idx);
+
+                lanes_fn(&state->args, min_len);
+
+                for (i = 0; i < num_lanes; i++) {
+                        if (state->job_in_lane[i] == NULL) {
+#ifdef SAFE_DATA
+                                sgl_clear_lane(state, i);
+#endif
+                                continue;
+                        }
+                        state->lens[i] -= min_len;
+                        if (state->lens[i] == 0) {
+                                sgl_lane_chunk_done(state, i);
+                                sgl_lane_next_chunk(state, i);
+                        }
+                }
+        }
+}
+
+static inline IMB_JOB *
+submit_job_sgl_lanes(MB_MGR_SGL_OOO *state, IMB_JOB *job,
+                     const sgl_lanes_fn_t lanes_fn)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+        const imb_uint128_t *keys = (const imb_uint128_t *) job->enc_keys;
+        /* 11, 13 or 15 round keys */
+        const unsigned num_keys = (unsigned) (job->key_len_in_bytes / 4 + 7);
+        struct sgl_iter it;
+        unsigned r;
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+
+        state->args.keys[lane] = (const uint32_t *) job->enc_keys;
+        for (r = 0; r < num_keys; r++)
+                state->args.key_tab[r][lane] = keys[r];
+
+        sgl_iter_init(&it, job, job->cipher_start_src_offset_in_bytes);
+        state->seg[lane] = it.seg;
+        state->seg_offset[lane] = it.offset;
+        state->remain[lane] = job->msg_len_to_cipher_in_bytes;
+
+        if (job->cipher_mode == IMB_CIPHER_CCM) {
+                /* CBC-MAC from zero, B0 and AAD blocks go first */
+                uint8_t *block = sgl_lane_blocks(state, lane);
+
+                memset(&state->args.IV[lane], 0, sizeof(state->args.IV[lane]));
+                state->args.in[lane] = block;
+                state->args.out[lane] = block;
+                state->lens[lane] = sgl_ccm_b0_aad(block, job) *
+                        SGL_BLOCK_SIZE;
+                state->block_len[lane] = 0;
+        } else {
+                memcpy(&state->args.IV[lane], job->iv, SGL_BLOCK_SIZE);
+                sgl_lane_next_chunk(state, lane);
+        }
+
+        if (state->num_lanes_inuse != state->num_lanes)
+                return NULL;
+
+        return sgl_process_lanes(state, lanes_fn);
+}
+
+static inline IMB_JOB *
+flush_job_sgl_lanes(MB_MGR_SGL_OOO *state, const sgl_lanes_fn_t lanes_fn)
+{
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        return sgl_process_lanes(state, lanes_fn);
+}
+
+/* AES-CBC encryption and AES-CCM are serial within a message */
+__forceinline
+int
+sgl_job_uses_lanes(const IMB_JOB *job)
+{
+        return job->cipher_mode == IMB_CIPHER_CCM ||
+                (job->cipher_mode == IMB_CIPHER_CBC &&
+                 job->cipher_direction == IMB_DIR_ENCRYPT);
+}
+
+/* Returns the manager and multi-lane routine of a job using the lanes */
+__forceinline
+MB_MGR_SGL_OOO *
+sgl_job_lanes(IMB_MGR *state, const IMB_JOB *job, sgl_lanes_fn_t *lanes_fn)
+{
+        if (job->cipher_mode == IMB_CIPHER_CCM) {
+                if (job->key_len_in_bytes == 16) {
+                        *lanes_fn = AES128_CBC_MAC;
+                        return state->aes128_ccm_sgl_ooo;
+                }
+                /* assume 32 */
+                *lanes_fn = AES256_CBC_MAC;
+                return state->aes256_ccm_sgl_ooo;
+        }
+
+        if (job->key_len_in_bytes == 16) {
+                *lanes_fn = AES_CBC_ENC_128_X;
+                return state->aes128_cbc_sgl_ooo;
+        } else if (job->key_len_in_bytes == 24) {
+                *lanes_fn = AES_CBC_ENC_192_X;
+                return state->aes192_cbc_sgl_ooo;
+        }
+        /* assume 32 */
+        *lanes_fn = AES_CBC_ENC_256_X;
+        return state->aes256_cbc_sgl_ooo;
+}
+
+/* ========================================================================= */
+/* Job API */
+/* ========================================================================= */
+
+/*
+ * Checks the segment list and that the job uses a supported
+ * cipher/hash combination. Remaining fields are checked separately.
+ *
+ * @return 0 - valid, 1 - invalid
+ */
+__forceinline
+int
+is_sgl_invalid(const IMB_JOB *job)
+{
+        uint64_t total = 0, end;
+        uint64_t i;
+
+        if (job->sgl_io_segs == NULL)
+                return 1;
+
+        for (i = 0; i < job->num_sgl_io_segs; i++) {
+                const struct IMB_SGL_IOV *seg = &job->sgl_io_segs[i];
+
+                if (seg->len != 0 && (seg->in == NULL || seg->out == NULL))
+                        return 1;
+                total += seg->len;
+        }
+
+        switch (job->cipher_mode) {
+        case IMB_CIPHER_GCM:
+                if (job->hash_alg != IMB_AUTH_AES_GMAC)
+                        return 1;
+                break;
+        case IMB_CIPHER_CCM:
+                if (job->hash_alg != IMB_AUTH_AES_CCM)
+                        return 1;
+                if (job->u.CCM.aad_len_in_bytes > SGL_CCM_MAX_AAD)
+                        return 1;
+                break;
+        case IMB_CIPHER_CBC:
+        case IMB_CIPHER_CNTR:
+                switch (job->hash_alg) {
+                case IMB_AUTH_NULL:
+                        break;
+                case IMB_AUTH_HMAC_SHA_1:
+                case IMB_AUTH_HMAC_SHA_224:
+                case IMB_AUTH_HMAC_SHA_256:
+                case IMB_AUTH_HMAC_SHA_384:
+                case IMB_AUTH_HMAC_SHA_512:
+                        end = job->hash_start_src_offset_in_bytes +
+                                job->msg_len_to_hash_in_bytes;
+                        if (end > total)
+                                return 1;
+                        break;
+                default:
+                        return 1;
+                }
+                break;
+        default:
+                return 1;
+        }
+
+        end = job->cipher_start_src_offset_in_bytes +
+                job->msg_len_to_cipher_in_bytes;
+        if (end > total)
+                return 1;
+
+        return 0;
+}
+
+/*
+ * Submits a scatter-gather list job.
+ * Returns a completed job (not necessarily this one) or NULL.
+ */
+__forceinline
+IMB_JOB *
+submit_sgl_job(IMB_MGR *state, IMB_JOB *job)
+{
+        if (sgl_job_uses_lanes(job)) {
+                sgl_lanes_fn_t lanes_fn;
+                MB_MGR_SGL_OOO *ooo = sgl_job_lanes(state, job, &lanes_fn);
+
+                /* the lanes authenticate the plain text */
+                if (job->cipher_mode == IMB_CIPHER_CCM &&
+                    job->cipher_direction == IMB_DIR_DECRYPT)
+                        sgl_ccm_ctr(job);
+                else if (job->cipher_mode == IMB_CIPHER_CBC &&
+                         job->hash_alg != IMB_AUTH_NULL &&
+                         job->chain_order == IMB_ORDER_HASH_CIPHER)
+                        sgl_hmac_process(job);
+
+                return submit_job_sgl_lanes(ooo, job, lanes_fn);
+        }
+
+        switch (job->cipher_mode) {
+        case IMB_CIPHER_GCM:
+                sgl_aes_gcm(state, job);
+                break;
+        case IMB_CIPHER_CBC: /* decryption */
+        case IMB_CIPHER_CNTR:
+                if (job->hash_alg == IMB_AUTH_NULL) {
+                        sgl_aes_cipher(job);
+                } else if (job->chain_order == IMB_ORDER_CIPHER_HASH) {
+                        sgl_aes_cipher(job);
+                        sgl_hmac_process(job);
+                } else {
+                        sgl_hmac_process(job);
+                        sgl_aes_cipher(job);
+                }
+                break;
+        default:
+                job->status = STS_INVALID_ARGS;
+                return job;
+        }
+
+        job->status |= STS_COMPLETED;
+        return job;
+}
+
+/* Runs the lanes until a scatter-gather list job is completed */
+__forceinline
+void
+complete_sgl_job(IMB_MGR *state, IMB_JOB *job)
+{
+        sgl_lanes_fn_t lanes_fn;
+        MB_MGR_SGL_OOO *ooo = sgl_job_lanes(state, job, &lanes_fn);
+
+        while (job->status < STS_COMPLETED)
+                (void) flush_job_sgl_lanes(ooo, lanes_fn);
+}
+
+#endif /* MB_MGR_SGL_H */
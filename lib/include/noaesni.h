@@ -35,6 +35,7 @@ IMB_DLL_EXPORT IMB_JOB *submit_job_sse_no_aesni(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *submit_job_nocheck_sse_no_aesni(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *flush_job_sse_no_aesni(IMB_MGR *state);
 IMB_DLL_EXPORT uint32_t queue_size_sse_no_aesni(IMB_MGR *state);
+IMB_DLL_EXPORT void clear_scratch_sse_no_aesni(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_completed_job_sse_no_aesni(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_next_job_sse_no_aesni(IMB_MGR *state);
 
@@ -57,6 +58,21 @@ aes_keyexp_192_enc_sse_no_aesni(const void *key, void *enc_exp_keys);
 IMB_DLL_EXPORT void
 aes_keyexp_256_enc_sse_no_aesni(const void *key, void *enc_exp_keys);
 IMB_DLL_EXPORT void
+aes_keyexp_128_n_sse_no_aesni(const void * const keys[],
+                              void * const enc_exp_keys[],
+                              void * const dec_exp_keys[],
+                              const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_192_n_sse_no_aesni(const void * const keys[],
+                              void * const enc_exp_keys[],
+                              void * const dec_exp_keys[],
+                              const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_256_n_sse_no_aesni(const void * const keys[],
+                              void * const enc_exp_keys[],
+                              void * const dec_exp_keys[],
+                              const uint32_t num_keys);
+IMB_DLL_EXPORT void
 aes_cmac_subkey_gen_sse_no_aesni(const void *key_exp, void *key1, void *key2);
 IMB_DLL_EXPORT void
 aes_cmac_256_subkey_gen_sse_no_aesni(const void *key_exp,
@@ -64,5 +80,39 @@ aes_cmac_256_subkey_gen_sse_no_aesni(const void *key_exp,
 IMB_DLL_EXPORT void
 aes_cfb_128_one_sse_no_aesni(void *out, const void *in, const void *iv,
                              const void *keys, uint64_t len);
+IMB_DLL_EXPORT void
+aes_xts_128_enc_sse_no_aesni(const void *in, const void *iv, const void *keys,
+                             const void *tweak_keys, void *out,
+                             const uint64_t len);
+IMB_DLL_EXPORT void
+aes_xts_128_dec_sse_no_aesni(const void *in, const void *iv, const void *keys,
+                             const void *tweak_keys, void *out,
+                             const uint64_t len);
+IMB_DLL_EXPORT void
+aes_xts_256_enc_sse_no_aesni(const void *in, const void *iv, const void *keys,
+                             const void *tweak_keys, void *out,
+                             const uint64_t len);
+IMB_DLL_EXPORT void
+aes_xts_256_dec_sse_no_aesni(const void *in, const void *iv, const void *keys,
+                             const void *tweak_keys, void *out,
+                             const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_128_enc_sse_no_aesni(const void *in, const void *keys, void *out,
+                             const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_128_dec_sse_no_aesni(const void *in, const void *keys, void *out,
+                             const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_192_enc_sse_no_aesni(const void *in, const void *keys, void *out,
+                             const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_192_dec_sse_no_aesni(const void *in, const void *keys, void *out,
+                             const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_256_enc_sse_no_aesni(const void *in, const void *keys, void *out,
+                             const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_256_dec_sse_no_aesni(const void *in, const void *keys, void *out,
+                             const uint64_t len);
 
 #endif /* NOAESNI_H */
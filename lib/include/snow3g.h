@@ -141,6 +141,19 @@ snow3g_f9_1_buffer_sse(const snow3g_key_schedule_t *pCtx,
                        const uint64_t lengthInBits,
                        void *pDigest);
 
+IMB_DLL_LOCAL void
+snow3g_f8_f9_1_buffer_sse(const snow3g_key_schedule_t *pCipherCtx,
+                          const void *pCipherIV,
+                          const snow3g_key_schedule_t *pAuthCtx,
+                          const void *pAuthIV,
+                          const void *pBufferIn,
+                          void *pBufferOut,
+                          const uint32_t cipherOffsetInBytes,
+                          const uint32_t cipherLengthInBytes,
+                          const uint64_t authLengthInBits,
+                          const int authCipherText,
+                          void *pDigest);
+
 size_t
 snow3g_key_sched_size_sse(void);
 
@@ -262,6 +275,19 @@ snow3g_f9_1_buffer_sse_no_aesni(const snow3g_key_schedule_t *pCtx,
                                 const uint64_t lengthInBits,
                                 void *pDigest);
 
+IMB_DLL_LOCAL void
+snow3g_f8_f9_1_buffer_sse_no_aesni(const snow3g_key_schedule_t *pCipherCtx,
+                                   const void *pCipherIV,
+                                   const snow3g_key_schedule_t *pAuthCtx,
+                                   const void *pAuthIV,
+                                   const void *pBufferIn,
+                                   void *pBufferOut,
+                                   const uint32_t cipherOffsetInBytes,
+                                   const uint32_t cipherLengthInBytes,
+                                   const uint64_t authLengthInBits,
+                                   const int authCipherText,
+                                   void *pDigest);
+
 size_t
 snow3g_key_sched_size_sse_no_aesni(void);
 
@@ -382,6 +408,19 @@ snow3g_f9_1_buffer_avx(const snow3g_key_schedule_t *pCtx,
                        const uint64_t lengthInBits,
                        void *pDigest);
 
+IMB_DLL_LOCAL void
+snow3g_f8_f9_1_buffer_avx(const snow3g_key_schedule_t *pCipherCtx,
+                          const void *pCipherIV,
+                          const snow3g_key_schedule_t *pAuthCtx,
+                          const void *pAuthIV,
+                          const void *pBufferIn,
+                          void *pBufferOut,
+                          const uint32_t cipherOffsetInBytes,
+                          const uint32_t cipherLengthInBytes,
+                          const uint64_t authLengthInBits,
+                          const int authCipherText,
+                          void *pDigest);
+
 size_t
 snow3g_key_sched_size_avx(void);
 
@@ -502,6 +541,19 @@ snow3g_f9_1_buffer_avx2(const snow3g_key_schedule_t *pCtx,
                         const uint64_t lengthInBits,
                         void *pDigest);
 
+IMB_DLL_LOCAL void
+snow3g_f8_f9_1_buffer_avx2(const snow3g_key_schedule_t *pCipherCtx,
+                           const void *pCipherIV,
+                           const snow3g_key_schedule_t *pAuthCtx,
+                           const void *pAuthIV,
+                           const void *pBufferIn,
+                           void *pBufferOut,
+                           const uint32_t cipherOffsetInBytes,
+                           const uint32_t cipherLengthInBytes,
+                           const uint64_t authLengthInBits,
+                           const int authCipherText,
+                           void *pDigest);
+
 size_t
 snow3g_key_sched_size_avx2(void);
 
@@ -2667,6 +2667,92 @@ static inline void f8_snow3g(snow3gKeyState1_t *pCtx,
 #endif
 }
 
+/**
+ * @brief Core SNOW3G F9 evaluation of the message blocks
+ *
+ * Adds lengthInBits of the message to the running digest E,
+ * using multiplier P. Multiplication by Q and the final
+ * key stream word are left to the caller.
+ *
+ * @param[in] E             running digest
+ * @param[in] P             multiplier P (first 2 F9 key stream words)
+ * @param[in] pIn           input buffer (64-bit block aligned to E)
+ * @param[in] lengthInBits  length in bits of the data to authenticate
+ * @return updated digest
+ */
+static inline uint64_t f9_snow3g_update(uint64_t E, const uint64_t P,
+                                        const uint64_t *pIn,
+                                        const uint64_t lengthInBits)
+{
+        const uint64_t lengthInQwords = lengthInBits / 64;
+        const uint64_t rem_bits = lengthInBits % 64;
+        uint64_t i, V;
+
+        /* all blocks except the last one */
+        for (i = 0; i < lengthInQwords; i++) {
+                V = BSWAP64(pIn[i]);
+                E = multiply_and_reduce64(E ^ V, P);
+        }
+
+        /* last bits of last block if any left */
+        if (rem_bits) {
+                /* last bytes, do not go past end of buffer */
+                memcpy(&V, &pIn[i], (rem_bits + 7) / 8);
+                V = BSWAP64(V);
+                V &= (((uint64_t)-1) << (64 - rem_bits)); /* mask extra bits */
+                E = multiply_and_reduce64(E ^ V, P);
+        }
+#ifdef SAFE_DATA
+        CLEAR_VAR(&V, sizeof(V));
+#endif
+        return E;
+}
+
+/**
+ * @brief Adds carried bytes and the data following them to a F9 digest
+ *
+ * Used when F9 blocks are not aligned to the data in memory:
+ * the carryBytes bytes preceding pIn are held in a register.
+ *
+ * @param[in] E             running digest
+ * @param[in] P             multiplier P (first 2 F9 key stream words)
+ * @param[in] carry         carried bytes (low carryBytes bytes)
+ * @param[in] carryBytes    number of carried bytes (0 to 7)
+ * @param[in] pIn           data following the carried bytes
+ * @param[in] lengthInBits  length in bits, carried bytes included
+ * @return updated digest
+ */
+static inline uint64_t f9_snow3g_update_carry(uint64_t E, const uint64_t P,
+                                              const uint64_t carry,
+                                              const uint32_t carryBytes,
+                                              const uint8_t *pIn,
+                                              const uint64_t lengthInBits)
+{
+        uint64_t block, blockBits, blockBytes;
+
+        if (carryBytes == 0 || lengthInBits == 0)
+                return f9_snow3g_update(E, P, (const uint64_t *)pIn,
+                                        lengthInBits);
+
+        /* first block: carried bytes followed by the data */
+        blockBits = (lengthInBits < 64) ? lengthInBits : 64;
+        blockBytes = (blockBits + 7) / 8;
+        block = BSWAP64(carry << (64 - (carryBytes * 8)));
+        if (blockBytes > carryBytes)
+                memcpy((uint8_t *)&block + carryBytes, pIn,
+                       blockBytes - carryBytes);
+        E = f9_snow3g_update(E, P, &block, blockBits);
+
+        if (lengthInBits > 64)
+                E = f9_snow3g_update(E, P, (const uint64_t *)
+                                     &pIn[SNOW3G_8_BYTES - carryBytes],
+                                     lengthInBits - 64);
+#ifdef SAFE_DATA
+        CLEAR_VAR(&block, sizeof(block));
+#endif
+        return E;
+}
+
 #ifdef AVX2
 /**
  * @brief Extracts one state from a 8 buffer state structure.
@@ -3910,8 +3996,7 @@ void SNOW3G_F9_1_BUFFER(const snow3g_key_schedule_t *pHandle,
 
         snow3gKeyState1_t ctx;
         uint32_t z[5];
-        uint64_t lengthInQwords, E, V, P;
-        uint64_t i, rem_bits;
+        uint64_t E, P;
         const uint64_t *inputBuffer;
 
         inputBuffer = (const uint64_t *)pBufferIn;
@@ -3924,27 +4009,159 @@ void SNOW3G_F9_1_BUFFER(const snow3g_key_schedule_t *pHandle,
 
         P = ((uint64_t)z[0] << 32) | ((uint64_t)z[1]);
 
-        lengthInQwords = lengthInBits / 64;
+        E = f9_snow3g_update(0, P, inputBuffer, lengthInBits);
 
-        E = 0;
-        /* all blocks except the last one */
-        for (i = 0; i < lengthInQwords; i++) {
-                V = BSWAP64(inputBuffer[i]);
-                E = multiply_and_reduce64(E ^ V, P);
+        /* Multiply by Q */
+        E = multiply_and_reduce64(E ^ lengthInBits,
+                                  (((uint64_t)z[2] << 32) | ((uint64_t)z[3])));
+
+        /* Final MAC */
+        *(uint32_t *)pDigest =
+                (uint32_t)BSWAP64(E ^ ((uint64_t)z[4] << 32));
+#ifdef SAFE_DATA
+        CLEAR_VAR(&E, sizeof(E));
+        CLEAR_VAR(&P, sizeof(P));
+        CLEAR_MEM(&z, sizeof(z));
+        CLEAR_MEM(&ctx, sizeof(ctx));
+        CLEAR_SCRATCH_GPS();
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
+}
+
+/**
+ * @brief Single buffer F8 and F9 in one pass over the data
+ *
+ * The digest starts at the beginning of the buffer and the cipher
+ * cipherOffsetInBytes later (e.g. a PDCP header that is authenticated
+ * but not ciphered). Header blocks are added to the digest first;
+ * after that each 64-bit block is ciphered and added to the digest
+ * while it is held in registers. When the header is not a multiple
+ * of 8 bytes, each F9 block is formed from the end of the previous
+ * block and the start of the current one.
+ * The digest is computed over the plain input, unless authCipherText
+ * is set (in-place cipher-then-hash), in which case it covers the output.
+ *
+ * @param[in] pCipherHandle       pointer to precomputed F8 key schedule
+ * @param[in] pCipherIV           pointer to F8 IV
+ * @param[in] pAuthHandle         pointer to precomputed F9 key schedule
+ * @param[in] pAuthIV             pointer to F9 IV
+ * @param[in] pBufferIn           pointer to an input buffer
+ * @param[out] pBufferOut         pointer to an output buffer
+ * @param[in] cipherOffsetInBytes F8 start relative to the F9 start
+ * @param[in] cipherLengthInBytes F8 message length in bytes
+ * @param[in] authLengthInBits    F9 message length in bits
+ *                                (at least cipherOffsetInBytes * 8)
+ * @param[in] authCipherText      digest the output instead of the input
+ * @param[out] pDigest            pointer to store the F9 digest
+ */
+void SNOW3G_F8_F9_1_BUFFER(const snow3g_key_schedule_t *pCipherHandle,
+                           const void *pCipherIV,
+                           const snow3g_key_schedule_t *pAuthHandle,
+                           const void *pAuthIV,
+                           const void *pBufferIn,
+                           void *pBufferOut,
+                           const uint32_t cipherOffsetInBytes,
+                           const uint32_t cipherLengthInBytes,
+                           const uint64_t authLengthInBits,
+                           const int authCipherText,
+                           void *pDigest)
+{
+#ifdef SAFE_PARAM
+        if ((pCipherHandle == NULL) || (pCipherIV == NULL) ||
+            (pAuthHandle == NULL) || (pAuthIV == NULL) ||
+            (pBufferIn == NULL) || (pBufferOut == NULL) ||
+            (pDigest == NULL) ||
+            (cipherLengthInBytes == 0) ||
+            (cipherLengthInBytes > SNOW3G_MAX_BYTELEN) ||
+            (authLengthInBits == 0) || (authLengthInBits > SNOW3G_MAX_BITLEN) ||
+            (authLengthInBits < ((uint64_t) cipherOffsetInBytes * 8)))
+                return;
+#endif
+#ifdef SAFE_DATA
+        CLEAR_SCRATCH_SIMD_REGS();
+#endif /* SAFE_DATA */
+
+        snow3gKeyState1_t cipherCtx;
+        snow3gKeyState1_t authCtx;
+        uint32_t z[5];
+        uint64_t E, P, V, C, A;
+        uint64_t i, lengthInQwords, remBits;
+        const uint8_t *pIn8 = (const uint8_t *)pBufferIn;
+        uint8_t *pOut8 = (uint8_t *)pBufferOut;
+        const uint64_t *pIn64 =
+                (const uint64_t *)&pIn8[cipherOffsetInBytes];
+        uint64_t *pOut64 = (uint64_t *)&pOut8[cipherOffsetInBytes];
+        /* header: whole F9 blocks and bytes left over (carried) */
+        const uint32_t headQwords = cipherOffsetInBytes / SNOW3G_8_BYTES;
+        const uint32_t headBytes = cipherOffsetInBytes % SNOW3G_8_BYTES;
+        const uint32_t shift = headBytes * 8;
+        uint64_t carry = 0;
+
+        /* Initialize the F8 schedule from the IV */
+        snow3gStateInitialize_1(&cipherCtx, pCipherHandle, pCipherIV);
+
+        /* Clock FSM and LFSR once, ignore the key stream */
+        (void) snow3g_keystream_1_4(&cipherCtx);
+
+        /* Initialize the F9 schedule and generate 5 key stream words */
+        snow3gStateInitialize_1(&authCtx, pAuthHandle, pAuthIV);
+        snow3g_f9_keystream_words(&authCtx, &z[0]);
+
+        P = ((uint64_t)z[0] << 32) | ((uint64_t)z[1]);
+
+        /* Header blocks are authenticated only */
+        E = f9_snow3g_update(0, P, (const uint64_t *)pIn8,
+                             (uint64_t) headQwords * 64);
+        if (headBytes) {
+                memcpy(&carry, &pIn8[headQwords * SNOW3G_8_BYTES],
+                       headBytes);
+                carry = BSWAP64(carry) >> (64 - shift);
         }
 
-        /* last bits of last block if any left */
-        rem_bits = lengthInBits % 64;
-        if (rem_bits) {
-                /* last bytes, do not go past end of buffer */
-                memcpy(&V, &inputBuffer[i], (rem_bits + 7) / 8);
-                V = BSWAP64(V);
-                V &= (((uint64_t)-1) << (64 - rem_bits)); /* mask extra bits */
-                E = multiply_and_reduce64(E ^ V, P);
+        /* 64-bit blocks common to F8 and F9 */
+        lengthInQwords = cipherLengthInBytes / SNOW3G_8_BYTES;
+        if (((authLengthInBits / 64) - headQwords) < lengthInQwords)
+                lengthInQwords = (authLengthInBits / 64) - headQwords;
+
+        for (i = 0; i < lengthInQwords; i++) {
+                V = BSWAP64(pIn64[i]);
+                C = V ^ snow3g_keystream_1_8(&cipherCtx);
+                pOut64[i] = BSWAP64(C);
+                A = authCipherText ? C : V;
+                if (headBytes) {
+                        /* F9 block: carried bytes | first bytes of A */
+                        V = (carry << (64 - shift)) | (A >> shift);
+                        carry = A & ((1ULL << shift) - 1);
+                        A = V;
+                }
+                E = multiply_and_reduce64(E ^ A, P);
         }
 
+        /*
+         * Remaining data is processed separately; digest the input
+         * before it gets overwritten when the operation is in-place.
+         * Carried bytes are taken from the register, as they may have
+         * been overwritten already.
+         */
+        remBits = authLengthInBits - ((headQwords + i) * 64);
+
+        if (!authCipherText)
+                E = f9_snow3g_update_carry(E, P, carry, headBytes,
+                                           (const uint8_t *)&pIn64[i],
+                                           remBits);
+
+        if (cipherLengthInBytes > (i * SNOW3G_8_BYTES))
+                f8_snow3g(&cipherCtx, &pIn64[i], &pOut64[i],
+                          cipherLengthInBytes -
+                          (uint32_t) (i * SNOW3G_8_BYTES));
+
+        if (authCipherText)
+                E = f9_snow3g_update_carry(E, P, carry, headBytes,
+                                           (const uint8_t *)&pOut64[i],
+                                           remBits);
+
         /* Multiply by Q */
-        E = multiply_and_reduce64(E ^ lengthInBits,
+        E = multiply_and_reduce64(E ^ authLengthInBits,
                                   (((uint64_t)z[2] << 32) | ((uint64_t)z[3])));
 
         /* Final MAC */
@@ -3953,9 +4170,13 @@ void SNOW3G_F9_1_BUFFER(const snow3g_key_schedule_t *pHandle,
 #ifdef SAFE_DATA
         CLEAR_VAR(&E, sizeof(E));
         CLEAR_VAR(&V, sizeof(V));
+        CLEAR_VAR(&C, sizeof(C));
+        CLEAR_VAR(&A, sizeof(A));
+        CLEAR_VAR(&carry, sizeof(carry));
         CLEAR_VAR(&P, sizeof(P));
         CLEAR_MEM(&z, sizeof(z));
-        CLEAR_MEM(&ctx, sizeof(ctx));
+        CLEAR_MEM(&cipherCtx, sizeof(cipherCtx));
+        CLEAR_MEM(&authCtx, sizeof(authCtx));
         CLEAR_SCRATCH_GPS();
         CLEAR_SCRATCH_SIMD_REGS();
 #endif /* SAFE_DATA */
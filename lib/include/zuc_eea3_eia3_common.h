@@ -0,0 +1,471 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*-----------------------------------------------------------------------
+ * Combined ZUC EEA3 + EIA3 out-of-order manager.
+ *
+ * Jobs with both IMB_CIPHER_ZUC_EEA3 and IMB_AUTH_ZUC_EIA3_BITLEN
+ * are scheduled in one manager. Each job takes a pair of ZUC lanes:
+ * lane i generates the EEA3 keystream and lane i + NUM_JOBS the EIA3
+ * keystream, so a single multi-lane initialization and a single
+ * multi-lane keystream generation per 64 byte block serve both the
+ * cipher and the authentication of all jobs. Each block is then XOR'ed
+ * and authenticated back to back, while it is still in cache.
+ *
+ * Authentication may start before the cipher offset (e.g. PDCP, where
+ * the header is authenticated but not ciphered):
+ * - in-place cipher-then-hash jobs authenticate each block
+ *   after it has been ciphered
+ * - in-place hash-then-cipher jobs cipher each block one block behind
+ *   the authentication, so the cipher output does not overwrite data
+ *   still to be authenticated (requires cipher offset - hash offset
+ *   to be up to 64 bytes)
+ *
+ * The including file must define:
+ * - ZUC_EEA3_EIA3_NUM_LANES - number of ZUC lanes (4, 8 or 16)
+ * - ZUC_STATE_N             - multi-lane ZUC state type
+ * - ZUC_INIT_N              - multi-lane init (state, keys, ivs)
+ * - ZUC_KEYGEN64B_N         - multi-lane 64 byte keystream (state, ks)
+ * - ZUC_KEYGEN64B, ZUC_KEYGEN8B, ZUC_KEYGEN - single lane keystream
+ * - ZUC_XOR_KEYSTREAM64B    - single lane 64 byte XOR
+ * - EIA3_ROUND64B, EIA3_REMAINDER - single lane EIA3 update
+ * - SUBMIT_JOB_ZUC_EEA3_EIA3, FLUSH_JOB_ZUC_EEA3_EIA3
+ *-----------------------------------------------------------------------*/
+
+#ifndef ZUC_EEA3_EIA3_COMMON_H
+#define ZUC_EEA3_EIA3_COMMON_H
+
+#include <string.h>
+
+#include "intel-ipsec-mb.h"
+#include "include/ipsec_ooo_mgr.h"
+#include "include/zuc_internal.h"
+#include "include/wireless_common.h"
+#include "include/clear_regs_mem.h"
+
+#define NUM_LANES ZUC_EEA3_EIA3_NUM_LANES
+/* Number of jobs processed in parallel (one pair of lanes per job) */
+#define NUM_JOBS  (NUM_LANES / 2)
+
+IMB_DLL_LOCAL IMB_JOB *
+SUBMIT_JOB_ZUC_EEA3_EIA3(MB_MGR_ZUC_EEA3_EIA3_OOO *state, IMB_JOB *job);
+
+IMB_DLL_LOCAL IMB_JOB *
+FLUSH_JOB_ZUC_EEA3_EIA3(MB_MGR_ZUC_EEA3_EIA3_OOO *state);
+
+static inline uint64_t rotate_left(uint64_t u, size_t r)
+{
+        return (((u) << (r)) | ((u) >> (64 - (r))));
+}
+
+static inline uint64_t load_uint64(const void *ptr)
+{
+        return *((const uint64_t *)ptr);
+}
+
+static inline void
+zuc_get_lane_state(ZucState_t *dst, const ZUC_STATE_N *src,
+                   const unsigned lane)
+{
+        unsigned i;
+
+        for (i = 0; i < 16; i++)
+                dst->lfsrState[i] = src->lfsrState[i][lane];
+
+        dst->fR1 = src->fR1[lane];
+        dst->fR2 = src->fR2[lane];
+
+        dst->bX0 = src->bX0[lane];
+        dst->bX1 = src->bX1[lane];
+        dst->bX2 = src->bX2[lane];
+        dst->bX3 = src->bX3[lane];
+}
+
+/*
+ * Ciphers the remaining bytes of a lane, past the blocks
+ * processed by the multi-lane code.
+ * keyStr32[0-15] has to contain the keystream for the current block.
+ */
+static inline void
+zuc_eea3_lane_tail(ZucState_t *state, uint32_t *keyStr32, const uint8_t *in,
+                   uint8_t *out, uint32_t length)
+{
+        while (length >= ZUC_KEYSTR_LEN) {
+                ZUC_XOR_KEYSTREAM64B(in, out, keyStr32);
+                in += ZUC_KEYSTR_LEN;
+                out += ZUC_KEYSTR_LEN;
+                length -= ZUC_KEYSTR_LEN;
+
+                /* Generate the next key stream 64 bytes or less */
+                if (length >= ZUC_KEYSTR_LEN)
+                        ZUC_KEYGEN64B(keyStr32, state);
+                else if (length)
+                        ZUC_KEYGEN(keyStr32, state, ((length - 1) / 4) + 1);
+        }
+
+        /* Check for remaining 0 to 63 bytes */
+        if (length) {
+                DECLARE_ALIGNED(uint8_t tempSrc[64], 64);
+                DECLARE_ALIGNED(uint8_t tempDst[64], 64);
+
+                memcpy(tempSrc, in, length);
+                memset(&tempSrc[length], 0, 64 - length);
+                ZUC_XOR_KEYSTREAM64B(tempSrc, tempDst, keyStr32);
+                memcpy(out, tempDst, length);
+#ifdef SAFE_DATA
+                clear_mem(tempSrc, sizeof(tempSrc));
+                clear_mem(tempDst, sizeof(tempDst));
+#endif
+        }
+}
+
+/*
+ * Authenticates the remaining bits of a lane and writes the MAC-I.
+ * keyStr32[0-15] has to contain the keystream for the current block.
+ */
+static inline void
+zuc_eia3_lane_tail(ZucState_t *state, uint32_t *keyStr32, const uint8_t *in,
+                   uint32_t remainBits, uint32_t T, uint32_t *pMacI)
+{
+        const uint32_t keyStreamLengthInBits = ZUC_KEYSTR_LEN * 8;
+        uint32_t L = (remainBits + (2 * ZUC_WORD) + 31) / ZUC_WORD;
+        uint32_t keyBlock;
+
+        while (remainBits >= keyStreamLengthInBits) {
+                remainBits -= keyStreamLengthInBits;
+                L -= (keyStreamLengthInBits / 32);
+
+                /* Generate the next key stream 8 bytes or 64 bytes */
+                if (!remainBits)
+                        ZUC_KEYGEN8B(&keyStr32[16], state);
+                else
+                        ZUC_KEYGEN64B(&keyStr32[16], state);
+                T = EIA3_ROUND64B(T, &keyStr32[0], in);
+                /* Copy the last keystream generated
+                 * to the first 64 bytes */
+                memcpy(keyStr32, &keyStr32[16], 64);
+                in = &in[ZUC_KEYSTR_LEN];
+        }
+
+        /*
+         * If remaining bits has more than 14 ZUC WORDS (double words),
+         * keystream needs to have up to another 2 ZUC WORDS (8B)
+         */
+        if (remainBits > (14 * 32))
+                ZUC_KEYGEN8B(&keyStr32[16], state);
+
+        keyBlock = keyStr32[L - 1];
+
+        T ^= EIA3_REMAINDER(keyStr32, in, remainBits);
+        T ^= rotate_left(load_uint64(&keyStr32[remainBits / 32]),
+                         remainBits % 32);
+
+        /* save the final MAC-I result */
+        *pMacI = bswap4(T ^ keyBlock);
+}
+
+/*
+ * Ciphers and authenticates all jobs of the manager.
+ * Empty job slots have to point to valid data (copy of a valid job).
+ */
+static void
+zuc_eea3_eia3_n_buffer(MB_MGR_ZUC_EEA3_EIA3_OOO *state)
+{
+        DECLARE_ALIGNED(ZUC_STATE_N zucState, 64);
+        DECLARE_ALIGNED(ZucState_t singlePktState, 64);
+        /* EEA3 keystreams in lanes 0 to NUM_JOBS - 1,
+         * EIA3 keystreams in lanes NUM_JOBS to NUM_LANES - 1 */
+        DECLARE_ALIGNED(uint8_t keyStr[NUM_LANES][2*64], 64);
+        /* EEA3 keystream of the previous block, for lagging lanes */
+        DECLARE_ALIGNED(uint8_t prevKeyStr[NUM_JOBS][64], 64);
+        uint32_t *pKeyStrArr0[NUM_LANES];
+        uint32_t *pKeyStrArr64[NUM_LANES];
+        const void *keys[NUM_LANES];
+        const void *ivs[NUM_LANES];
+        uint32_t T[NUM_JOBS] = {0};
+        const uint64_t after_mask = state->auth_after_cipher;
+        const uint64_t lag_mask = state->cipher_lag;
+        uint32_t numBlocks = UINT32_MAX;
+        uint64_t bufOffset = 0;
+        unsigned i;
+
+        for (i = 0; i < NUM_JOBS; i++) {
+                const uint32_t cipherBlocks = state->lens[i] / ZUC_KEYSTR_LEN;
+                const uint32_t authBlocks = state->auth_lens[i] /
+                                                (ZUC_KEYSTR_LEN * 8);
+
+                /* Find the number of blocks common to all jobs,
+                 * for both cipher and authentication */
+                if (cipherBlocks < numBlocks)
+                        numBlocks = cipherBlocks;
+                if (authBlocks < numBlocks)
+                        numBlocks = authBlocks;
+
+                keys[i] = state->args.keys[i];
+                ivs[i] = state->args.iv[i];
+                keys[i + NUM_JOBS] = state->args.auth_keys[i];
+                ivs[i + NUM_JOBS] = state->args.auth_iv[i];
+        }
+
+        for (i = 0; i < NUM_LANES; i++) {
+                pKeyStrArr0[i] = (uint32_t *) &keyStr[i][0];
+                pKeyStrArr64[i] = (uint32_t *) &keyStr[i][64];
+        }
+
+        /* Need to set the LFSR state to zero */
+        memset(&zucState, 0, sizeof(zucState));
+
+        ZUC_INIT_N(&zucState, (const void * const *) keys,
+                   (const void * const *) ivs);
+
+        /* First 64 bytes of EEA3 and EIA3 keystreams */
+        ZUC_KEYGEN64B_N(&zucState, pKeyStrArr0);
+
+        while (numBlocks--) {
+                /* Next 64 bytes of EEA3 and EIA3 keystreams for all lanes */
+                ZUC_KEYGEN64B_N(&zucState, pKeyStrArr64);
+
+                for (i = 0; i < NUM_JOBS; i++) {
+                        const uint64_t mask = 1ULL << i;
+                        const uint8_t *in = &state->args.in[i][bufOffset];
+                        uint8_t *out = &state->args.out[i][bufOffset];
+                        const uint8_t *auth_in =
+                                &state->args.auth_in[i][bufOffset];
+                        uint8_t *eia3KeyStr = keyStr[i + NUM_JOBS];
+
+                        if (state->job_in_lane[i] == NULL)
+                                continue;
+
+                        if (after_mask & mask) {
+                                /* Authenticate the output of the block */
+                                ZUC_XOR_KEYSTREAM64B(in, out, keyStr[i]);
+                                T[i] = EIA3_ROUND64B(T[i], eia3KeyStr,
+                                                     auth_in);
+                        } else if (lag_mask & mask) {
+                                /* Cipher the previous block, now that
+                                 * it has been fully authenticated */
+                                T[i] = EIA3_ROUND64B(T[i], eia3KeyStr,
+                                                     auth_in);
+                                if (bufOffset != 0)
+                                        ZUC_XOR_KEYSTREAM64B(
+                                                in - ZUC_KEYSTR_LEN,
+                                                out - ZUC_KEYSTR_LEN,
+                                                prevKeyStr[i]);
+                                memcpy(prevKeyStr[i], keyStr[i], 64);
+                        } else {
+                                T[i] = EIA3_ROUND64B(T[i], eia3KeyStr,
+                                                     auth_in);
+                                ZUC_XOR_KEYSTREAM64B(in, out, keyStr[i]);
+                        }
+
+                        /* Copy the last keystreams generated
+                         * to the first 64 bytes */
+                        memcpy(&keyStr[i][0], &keyStr[i][64], 64);
+                        memcpy(&eia3KeyStr[0], &eia3KeyStr[64], 64);
+                }
+                bufOffset += ZUC_KEYSTR_LEN;
+        }
+
+        /* Process each job separately for the remaining data */
+        for (i = 0; i < NUM_JOBS; i++) {
+                const uint64_t mask = 1ULL << i;
+                const uint8_t *auth_in = &state->args.auth_in[i][bufOffset];
+                const uint8_t *in = &state->args.in[i][bufOffset];
+                uint8_t *out = &state->args.out[i][bufOffset];
+                const uint32_t remainBits = state->auth_lens[i] -
+                                                (uint32_t) (bufOffset * 8);
+
+                if (state->job_in_lane[i] == NULL)
+                        continue;
+
+                if (!(after_mask & mask)) {
+                        zuc_get_lane_state(&singlePktState, &zucState,
+                                           i + NUM_JOBS);
+                        zuc_eia3_lane_tail(&singlePktState,
+                                           (uint32_t *) keyStr[i + NUM_JOBS],
+                                           auth_in, remainBits, T[i],
+                                           state->args.auth_tag[i]);
+                }
+
+                /* Cipher the block pending from the multi-lane loop */
+                if ((lag_mask & mask) && bufOffset != 0)
+                        ZUC_XOR_KEYSTREAM64B(in - ZUC_KEYSTR_LEN,
+                                             out - ZUC_KEYSTR_LEN,
+                                             prevKeyStr[i]);
+
+                zuc_get_lane_state(&singlePktState, &zucState, i);
+                zuc_eea3_lane_tail(&singlePktState, (uint32_t *) keyStr[i],
+                                   in, out,
+                                   state->lens[i] - (uint32_t) bufOffset);
+
+                if (after_mask & mask) {
+                        zuc_get_lane_state(&singlePktState, &zucState,
+                                           i + NUM_JOBS);
+                        zuc_eia3_lane_tail(&singlePktState,
+                                           (uint32_t *) keyStr[i + NUM_JOBS],
+                                           auth_in, remainBits, T[i],
+                                           state->args.auth_tag[i]);
+                }
+        }
+
+#ifdef SAFE_DATA
+        /* Clear sensitive data in stack */
+        clear_mem(keyStr, sizeof(keyStr));
+        clear_mem(prevKeyStr, sizeof(prevKeyStr));
+        clear_mem(&singlePktState, sizeof(singlePktState));
+        clear_mem(&zucState, sizeof(zucState));
+#endif
+}
+
+static IMB_JOB *
+zuc_eea3_eia3_return_lane(MB_MGR_ZUC_EEA3_EIA3_OOO *state,
+                          const unsigned lane)
+{
+        IMB_JOB *job = state->job_in_lane[lane];
+
+        state->num_lanes_inuse--;
+        state->job_in_lane[lane] = NULL;
+        state->lens[lane] = 0xFFFF;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        job->status |= STS_COMPLETED;
+
+        return job;
+}
+
+/* Returns lane with a completed job (zero length) or NUM_JOBS if none */
+static unsigned
+zuc_eea3_eia3_find_completed(const MB_MGR_ZUC_EEA3_EIA3_OOO *state)
+{
+        unsigned i;
+
+        for (i = 0; i < NUM_JOBS; i++)
+                if (state->job_in_lane[i] != NULL && state->lens[i] == 0)
+                        break;
+
+        return i;
+}
+
+IMB_JOB *
+SUBMIT_JOB_ZUC_EEA3_EIA3(MB_MGR_ZUC_EEA3_EIA3_OOO *state, IMB_JOB *job)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 0xF);
+        const uint64_t cipher_off = job->cipher_start_src_offset_in_bytes;
+        const uint64_t hash_off = job->hash_start_src_offset_in_bytes;
+        const int in_place = (job->dst == job->src + cipher_off);
+        unsigned idx;
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        state->job_in_lane[lane] = job;
+
+        state->args.in[lane] = job->src + cipher_off;
+        state->args.out[lane] = job->dst;
+        state->args.keys[lane] = job->enc_keys;
+        state->args.iv[lane] = job->iv;
+        state->lens[lane] = (uint16_t) job->msg_len_to_cipher_in_bytes;
+
+        state->args.auth_in[lane] = job->src + hash_off;
+        state->args.auth_keys[lane] = job->u.ZUC_EIA3._key;
+        state->args.auth_iv[lane] = job->u.ZUC_EIA3._iv;
+        state->args.auth_tag[lane] = (uint32_t *) job->auth_tag_output;
+        state->auth_lens[lane] = (uint16_t) job->msg_len_to_hash_in_bits;
+
+        /*
+         * In-place cipher-then-hash authenticates the cipher output.
+         * In-place hash-then-cipher with authentication starting before
+         * the cipher offset has to cipher behind the authentication,
+         * otherwise the data read by EIA3 is not modified by EEA3.
+         */
+        state->auth_after_cipher &= ~(1ULL << lane);
+        state->cipher_lag &= ~(1ULL << lane);
+        if (in_place && job->chain_order == IMB_ORDER_CIPHER_HASH)
+                state->auth_after_cipher |= (1ULL << lane);
+        else if (in_place && hash_off < cipher_off)
+                state->cipher_lag |= (1ULL << lane);
+
+        if (state->num_lanes_inuse != NUM_JOBS)
+                return NULL;
+
+        /*
+         * If a job has been completed in a previous flush,
+         * return it without processing the rest of the lanes
+         */
+        idx = zuc_eea3_eia3_find_completed(state);
+        if (idx == NUM_JOBS) {
+                zuc_eea3_eia3_n_buffer(state);
+
+                /* All lanes have been processed */
+                memset(state->lens, 0, sizeof(state->lens));
+                idx = 0;
+        }
+
+        return zuc_eea3_eia3_return_lane(state, idx);
+}
+
+IMB_JOB *
+FLUSH_JOB_ZUC_EEA3_EIA3(MB_MGR_ZUC_EEA3_EIA3_OOO *state)
+{
+        unsigned i, idx;
+
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        idx = zuc_eea3_eia3_find_completed(state);
+        if (idx != NUM_JOBS)
+                return zuc_eea3_eia3_return_lane(state, idx);
+
+        /* Find a lane with a job */
+        for (idx = 0; idx < NUM_JOBS; idx++)
+                if (state->job_in_lane[idx] != NULL)
+                        break;
+
+        /* Copy good lane data into empty lanes */
+        for (i = 0; i < NUM_JOBS; i++) {
+                if (state->job_in_lane[i] != NULL)
+                        continue;
+
+                state->args.in[i] = state->args.in[idx];
+                state->args.out[i] = state->args.out[idx];
+                state->args.keys[i] = state->args.keys[idx];
+                state->args.iv[i] = state->args.iv[idx];
+                state->args.auth_in[i] = state->args.auth_in[idx];
+                state->args.auth_keys[i] = state->args.auth_keys[idx];
+                state->args.auth_iv[i] = state->args.auth_iv[idx];
+                state->lens[i] = state->lens[idx];
+                state->auth_lens[i] = state->auth_lens[idx];
+        }
+
+        zuc_eea3_eia3_n_buffer(state);
+
+        /* Clear lengths of processed jobs, empty lanes get 0xFFFF */
+        for (i = 0; i < NUM_JOBS; i++)
+                state->lens[i] = (state->job_in_lane[i] != NULL) ? 0 : 0xFFFF;
+
+        return zuc_eea3_eia3_return_lane(state, idx);
+}
+
+#endif /* ZUC_EEA3_EIA3_COMMON_H */
@@ -218,7 +218,9 @@ typedef enum {
         IMB_CIPHER_CNTR_BITLEN,       /* 128-EEA2/NEA2 (3GPP) */
         IMB_CIPHER_ZUC_EEA3,          /* 128-EEA3/NEA3 (3GPP) */
         IMB_CIPHER_SNOW3G_UEA2_BITLEN,/* 128-UEA2 (3GPP) */
-        IMB_CIPHER_KASUMI_UEA1_BITLEN /* 128-UEA1 (3GPP) */
+        IMB_CIPHER_KASUMI_UEA1_BITLEN,/* 128-UEA1 (3GPP) */
+        IMB_CIPHER_CFB,               /* AES-CFB128 (full message) */
+        IMB_CIPHER_XTS                /* AES-XTS (IEEE 1619) */
 } JOB_CIPHER_MODE;
 
 typedef enum {
@@ -267,6 +269,17 @@ typedef enum {
         IMB_KEY_AES_256_BYTES = 32
 } AES_KEY_SIZE_BYTES;
 
+/*
+ * Scatter-gather list segment.
+ * Output of each input byte is written at the same position of the
+ * corresponding output segment (in == out for in-place operation).
+ */
+struct IMB_SGL_IOV {
+        const void *in;
+        void *out;
+        uint64_t len;
+};
+
 typedef struct IMB_JOB {
         /*
          * For AES, enc_keys and dec_keys are
@@ -283,6 +296,13 @@ typedef struct IMB_JOB {
          * expected to point to an array of 3 pointers for
          * the corresponding 3 key schedules.
          * - same key schedule used for enc and dec operations
+         *
+         * For AES-XTS, enc_keys and dec_keys are
+         * expected to point to an array of 2 pointers:
+         * - [0] data key (key1) expanded keys, encrypt schedule
+         *   in enc_keys and decrypt schedule in dec_keys
+         * - [1] tweak key (key2) expanded encrypt keys
+         * - iv is the 16-byte tweak (data unit sequence number)
          */
         const void *enc_keys;  /* 16-byte aligned pointer. */
         const void *dec_keys;
@@ -396,6 +416,24 @@ typedef struct IMB_JOB {
          */
         int (*cipher_func)(struct IMB_JOB *);
         int (*hash_func)(struct IMB_JOB *);
+
+        /*
+         * Scatter-gather list of input/output segments.
+         * If num_sgl_io_segs is not 0, src and dst are ignored and
+         * cipher/hash offsets and lengths refer to the concatenated
+         * segment data. Supported for:
+         * - IMB_CIPHER_GCM with IMB_AUTH_AES_GMAC
+         * - IMB_CIPHER_CCM with IMB_AUTH_AES_CCM
+         * - IMB_CIPHER_CBC and IMB_CIPHER_CNTR with IMB_AUTH_NULL
+         *   or IMB_AUTH_HMAC_SHA_1/224/256/384/512
+         * Like other jobs, SGL jobs may be returned by a later
+         * submit/flush call: CBC encryption and CCM jobs are processed
+         * in multi-buffer lanes, each lane advancing through its own
+         * segment list.
+         * get_next_job() resets num_sgl_io_segs to 0.
+         */
+        const struct IMB_SGL_IOV *sgl_io_segs;
+        uint64_t num_sgl_io_segs;
 } IMB_JOB;
 
 
@@ -508,6 +546,26 @@ __attribute__((aligned(64)));
 ;
 #endif
 
+/* Number of hash key powers in compact GCM key data */
+#define GCM_COMPACT_NUM_HKEYS 8
+
+/**
+ * @brief holds compact GCM key data
+ *
+ * gcm_key_data_compact holds round keys and the lowest hash key powers only,
+ * for large key tables (368 bytes instead of 1KB of gcm_key_data).
+ * Its layout matches the start of gcm_key_data for the 8 hash key power
+ * kernels, so AVX2 and AVX512 managers encrypt/decrypt with it directly.
+ */
+struct gcm_key_data_compact {
+        uint8_t expanded_keys[GCM_ENC_KEY_LEN * GCM_KEY_SETS];
+        /*
+         * (HashKey^8<<1 mod poly), (HashKey^7<<1 mod poly), ...,
+         * (HashKey<<1 mod poly)
+         */
+        uint8_t shifted_hkey[GCM_ENC_KEY_LEN * GCM_COMPACT_NUM_HKEYS];
+};
+
 /* ========================================================================== */
 /* API data type definitions */
 struct IMB_MGR;
@@ -518,7 +576,12 @@ typedef IMB_JOB *(*submit_job_t)(struct IMB_MGR *);
 typedef IMB_JOB *(*get_completed_job_t)(struct IMB_MGR *);
 typedef IMB_JOB *(*flush_job_t)(struct IMB_MGR *);
 typedef uint32_t (*queue_size_t)(struct IMB_MGR *);
+typedef void (*clear_scratch_t)(struct IMB_MGR *);
+typedef void (*imb_completion_cb_t)(struct IMB_MGR *, IMB_JOB **,
+                                    const uint32_t, void *);
 typedef void (*keyexp_t)(const void *, void *, void *);
+typedef void (*keyexp_n_t)(const void * const *, void * const *,
+                           void * const *, const uint32_t);
 typedef void (*cmac_subkey_gen_t)(const void *, void *, void *);
 typedef void (*hash_one_block_t)(const void *, void *);
 typedef void (*hash_fn_t)(const void *, const uint64_t, void *);
@@ -526,6 +589,10 @@ typedef void (*xcbc_keyexp_t)(const void *, void *, void *, void *);
 typedef int (*des_keysched_t)(uint64_t *, const void *);
 typedef void (*aes_cfb_t)(void *, const void *, const void *, const void *,
                           uint64_t);
+typedef void (*aes_xts_t)(const void *, const void *, const void *,
+                          const void *, void *, const uint64_t);
+typedef void (*aes_ecb_t)(const void *, const void *, void *,
+                          const uint64_t);
 typedef void (*aes_gcm_enc_dec_t)(const struct gcm_key_data *,
                                   struct gcm_context_data *,
                                   uint8_t *, uint8_t const *, uint64_t,
@@ -552,6 +619,25 @@ typedef void (*aes_gcm_enc_dec_finalize_t)(const struct gcm_key_data *,
                                            uint8_t *, uint64_t);
 typedef void (*aes_gcm_precomp_t)(struct gcm_key_data *);
 typedef void (*aes_gcm_pre_t)(const void *, struct gcm_key_data *);
+typedef void (*aes_gcm_pre_n_t)(const void * const *,
+                                struct gcm_key_data * const *,
+                                const uint32_t);
+typedef void (*aes_gcm_enc_dec_n_t)(const struct gcm_key_data * const *,
+                                    struct gcm_context_data * const *,
+                                    uint8_t * const *, const uint8_t * const *,
+                                    const uint64_t *, const uint8_t * const *,
+                                    const uint8_t * const *, const uint64_t *,
+                                    uint8_t * const *, const uint64_t,
+                                    const uint32_t);
+typedef void (*aes_gcm_pre_compact_t)(const void *,
+                                      struct gcm_key_data_compact *);
+typedef void (*aes_gcm_expand_compact_t)(const struct gcm_key_data_compact *,
+                                         struct gcm_key_data *);
+typedef void (*aes_gcm_enc_dec_compact_t)(const struct gcm_key_data_compact *,
+                                          struct gcm_context_data *,
+                                          uint8_t *, uint8_t const *, uint64_t,
+                                          const uint8_t *, uint8_t const *,
+                                          uint64_t, uint8_t *, uint64_t);
 
 typedef void (*aes_gmac_init_t)(const struct gcm_key_data *,
                                 struct gcm_context_data *,
@@ -704,11 +790,19 @@ typedef size_t (*snow3g_key_sched_size_t)(void);
 typedef uint32_t (*hec_32_t)(const uint8_t *);
 typedef uint64_t (*hec_64_t)(const uint8_t *);
 
+typedef uint32_t (*crc32_fn_t)(const void *, const uint64_t);
+
 /* ========================================================================== */
 /* Multi-buffer manager flags passed to alloc_mb_mgr() */
 
 #define IMB_FLAG_SHANI_OFF (1ULL << 0) /* disable use of SHANI extension */
 #define IMB_FLAG_AESNI_OFF (1ULL << 1) /* disable use of AESNI extension */
+/*
+ * SAFE_DATA: don't clear scratch registers at the end of each
+ * submit_job()/flush_job() call, application calls IMB_CLEAR_SCRATCH()
+ * at the end of a burst of jobs instead (no effect without SAFE_DATA)
+ */
+#define IMB_FLAG_SAFE_DATA_BURST (1ULL << 2)
 
 /* ========================================================================== */
 /* Multi-buffer manager detected features
@@ -754,7 +848,14 @@ typedef struct IMB_MGR {
         /*
          * Reserved for the future
          */
-        uint64_t reserved[6];
+        uint64_t reserved[4];
+
+        /*
+         * Job completion callback and its argument,
+         * set with imb_set_completion_cb()
+         */
+        imb_completion_cb_t completion_cb;
+        void *completion_cb_arg;
 
         /*
          * ARCH handlers / API
@@ -865,11 +966,64 @@ typedef struct IMB_MGR {
 
         cmac_subkey_gen_t       cmac_subkey_gen_256;
 
+        aes_xts_t               aes128_xts_enc;
+        aes_xts_t               aes128_xts_dec;
+        aes_xts_t               aes256_xts_enc;
+        aes_xts_t               aes256_xts_dec;
+
+        aes_ecb_t               aes128_ecb_enc;
+        aes_ecb_t               aes128_ecb_dec;
+        aes_ecb_t               aes192_ecb_enc;
+        aes_ecb_t               aes192_ecb_dec;
+        aes_ecb_t               aes256_ecb_enc;
+        aes_ecb_t               aes256_ecb_dec;
+
+        keyexp_n_t              keyexp_128_n;
+        keyexp_n_t              keyexp_192_n;
+        keyexp_n_t              keyexp_256_n;
+        aes_gcm_pre_n_t         gcm128_pre_n;
+        aes_gcm_pre_n_t         gcm192_pre_n;
+        aes_gcm_pre_n_t         gcm256_pre_n;
+        aes_gcm_enc_dec_n_t     gcm128_enc_n;
+        aes_gcm_enc_dec_n_t     gcm192_enc_n;
+        aes_gcm_enc_dec_n_t     gcm256_enc_n;
+        aes_gcm_enc_dec_n_t     gcm128_dec_n;
+        aes_gcm_enc_dec_n_t     gcm192_dec_n;
+        aes_gcm_enc_dec_n_t     gcm256_dec_n;
+        aes_gcm_pre_compact_t   gcm128_pre_compact;
+        aes_gcm_pre_compact_t   gcm192_pre_compact;
+        aes_gcm_pre_compact_t   gcm256_pre_compact;
+        aes_gcm_expand_compact_t gcm128_expand_compact;
+        aes_gcm_expand_compact_t gcm192_expand_compact;
+        aes_gcm_expand_compact_t gcm256_expand_compact;
+        aes_gcm_enc_dec_compact_t gcm128_enc_compact;
+        aes_gcm_enc_dec_compact_t gcm192_enc_compact;
+        aes_gcm_enc_dec_compact_t gcm256_enc_compact;
+        aes_gcm_enc_dec_compact_t gcm128_dec_compact;
+        aes_gcm_enc_dec_compact_t gcm192_dec_compact;
+        aes_gcm_enc_dec_compact_t gcm256_dec_compact;
+
+        crc32_fn_t              crc32_ethernet_fcs;
+        crc32_fn_t              crc32_sctp;
+        crc32_fn_t              crc16_x25;
+        crc32_fn_t              crc24_lte_a;
+        crc32_fn_t              crc24_lte_b;
+        crc32_fn_t              crc16_fp_data;
+        crc32_fn_t              crc11_fp_header;
+        crc32_fn_t              crc7_fp_header;
+        crc32_fn_t              crc10_iuup_data;
+        crc32_fn_t              crc6_iuup_header;
+
+        clear_scratch_t         clear_scratch;
+
         /* in-order scheduler fields */
         int              earliest_job; /* byte offset, -1 if none */
         int              next_job;     /* byte offset */
         IMB_JOB     jobs[MAX_JOBS];
 
+        /* batch of completed jobs passed to completion_cb */
+        IMB_JOB     *completion_cb_jobs[MAX_JOBS];
+
         /* out of order managers */
         void *aes128_ooo;
         void *aes192_ooo;
@@ -896,6 +1050,22 @@ typedef struct IMB_MGR {
         void *aes_cmac_ooo;
         void *zuc_eea3_ooo;
         void *zuc_eia3_ooo;
+        void *zuc_eea3_eia3_ooo;
+        void *aes128_cfb_ooo;
+        void *aes256_cfb_ooo;
+        void *aes128_ccm_ctr_mac_ooo;
+        void *aes256_ccm_ctr_mac_ooo;
+
+        /* DOCSIS SEC BPI + CRC32 stitched managers */
+        void *docsis128_crc32_x4_ooo;
+        void *docsis256_crc32_x4_ooo;
+
+        /* Scatter-gather list CBC encrypt and CCM managers */
+        void *aes128_cbc_sgl_ooo;
+        void *aes192_cbc_sgl_ooo;
+        void *aes256_cbc_sgl_ooo;
+        void *aes128_ccm_sgl_ooo;
+        void *aes256_ccm_sgl_ooo;
 } IMB_MGR;
 
 /* ========================================================================== */
@@ -929,11 +1099,27 @@ IMB_DLL_EXPORT unsigned imb_get_version(void);
 IMB_DLL_EXPORT IMB_MGR *alloc_mb_mgr(uint64_t flags);
 IMB_DLL_EXPORT void free_mb_mgr(IMB_MGR *state);
 
+/*
+ * With a completion callback set, submit_job and flush_job pass completed
+ * jobs to the callback, in order and in batches (array of jobs and number
+ * of jobs), and always return NULL. Jobs with errors are passed too, with
+ * their status set accordingly. flush_job completes all outstanding jobs
+ * and passes them in a single callback. The callback is made on return
+ * from submit_job/flush_job, after scratch registers are cleared
+ * (SAFE_DATA) and restored. Passed jobs cease to be usable when the callback
+ * returns, and the callback must not submit or flush jobs on the same
+ * manager. init_mb_mgr_xxx() removes the callback.
+ */
+IMB_DLL_EXPORT void imb_set_completion_cb(IMB_MGR *state,
+                                          imb_completion_cb_t cb,
+                                          void *cb_arg);
+
 IMB_DLL_EXPORT void init_mb_mgr_avx(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *submit_job_avx(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *submit_job_nocheck_avx(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *flush_job_avx(IMB_MGR *state);
 IMB_DLL_EXPORT uint32_t queue_size_avx(IMB_MGR *state);
+IMB_DLL_EXPORT void clear_scratch_avx(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_completed_job_avx(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_next_job_avx(IMB_MGR *state);
 
@@ -942,6 +1128,7 @@ IMB_DLL_EXPORT IMB_JOB *submit_job_avx2(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *submit_job_nocheck_avx2(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *flush_job_avx2(IMB_MGR *state);
 IMB_DLL_EXPORT uint32_t queue_size_avx2(IMB_MGR *state);
+IMB_DLL_EXPORT void clear_scratch_avx2(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_completed_job_avx2(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_next_job_avx2(IMB_MGR *state);
 
@@ -950,6 +1137,7 @@ IMB_DLL_EXPORT IMB_JOB *submit_job_avx512(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *submit_job_nocheck_avx512(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *flush_job_avx512(IMB_MGR *state);
 IMB_DLL_EXPORT uint32_t queue_size_avx512(IMB_MGR *state);
+IMB_DLL_EXPORT void clear_scratch_avx512(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_completed_job_avx512(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_next_job_avx512(IMB_MGR *state);
 
@@ -958,9 +1146,40 @@ IMB_DLL_EXPORT IMB_JOB *submit_job_sse(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *submit_job_nocheck_sse(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *flush_job_sse(IMB_MGR *state);
 IMB_DLL_EXPORT uint32_t queue_size_sse(IMB_MGR *state);
+IMB_DLL_EXPORT void clear_scratch_sse(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_completed_job_sse(IMB_MGR *state);
 IMB_DLL_EXPORT IMB_JOB *get_next_job_sse(IMB_MGR *state);
 
+/*
+ * Worker pool API
+ *
+ * Pool of worker threads, each owning a multi-buffer manager set up
+ * with given init function (e.g. init_mb_mgr_avx512). Jobs are queued
+ * to the worker selected by a flow hint and workers with empty queues
+ * take queued jobs from other workers. Completed jobs are returned
+ * through a single completion queue.
+ *
+ * Jobs are allocated by the application, filled in the same way as jobs
+ * from get_next_job() and have to stay valid until returned by
+ * imb_pool_get_completed_job(). Jobs of one flow may complete out of
+ * order. Queues are lock free, submit and get completed job can be
+ * called from any thread. Workers busy poll their queues and flush
+ * their managers only after their input has been idle for a while,
+ * so the last jobs of a burst complete with a short delay.
+ */
+typedef struct IMB_POOL IMB_POOL;
+
+IMB_DLL_EXPORT IMB_POOL *imb_pool_alloc(const uint32_t num_workers,
+                                        const uint64_t flags,
+                                        init_mb_mgr_t init_mgr,
+                                        const uint32_t queue_size);
+IMB_DLL_EXPORT void imb_pool_free(IMB_POOL *pool);
+IMB_DLL_EXPORT int imb_pool_submit_job(IMB_POOL *pool, IMB_JOB *job,
+                                       const uint32_t flow_hint);
+IMB_DLL_EXPORT IMB_JOB *imb_pool_get_completed_job(IMB_POOL *pool);
+IMB_DLL_EXPORT uint64_t imb_pool_stolen_jobs(IMB_POOL *pool,
+                                             const uint32_t worker);
+
 /*
  * Wrapper macros to call arch API's set up
  * at init phase of multi-buffer manager.
@@ -973,6 +1192,7 @@ IMB_DLL_EXPORT IMB_JOB *get_next_job_sse(IMB_MGR *state);
  *   mgr.get_completed_job will point to get_completed_job_sse(),
  *   mgr.flush_job will point to flush_job_sse(),
  *   mgr.queue_size will point to queue_size_sse()
+ *   mgr.clear_scratch will point to clear_scratch_sse()
  *   mgr.keyexp_128 will point to aes_keyexp_128_sse()
  *   mgr.keyexp_192 will point to aes_keyexp_192_sse()
  *   mgr.keyexp_256 will point to aes_keyexp_256_sse()
@@ -989,6 +1209,12 @@ IMB_DLL_EXPORT IMB_JOB *get_next_job_sse(IMB_MGR *state);
 #define IMB_GET_COMPLETED_JOB(_mgr)  ((_mgr)->get_completed_job((_mgr)))
 #define IMB_FLUSH_JOB(_mgr)          ((_mgr)->flush_job((_mgr)))
 #define IMB_QUEUE_SIZE(_mgr)         ((_mgr)->queue_size((_mgr)))
+/*
+ * Clears scratch GP and SIMD registers, to be called at the end of
+ * a burst of jobs on managers allocated with IMB_FLAG_SAFE_DATA_BURST.
+ * Until then registers may contain keys or data of jobs from the burst.
+ */
+#define IMB_CLEAR_SCRATCH(_mgr)      ((_mgr)->clear_scratch((_mgr)))
 
 /* Key expansion and generation API's */
 #define IMB_AES_KEYEXP_128(_mgr, _raw, _enc, _dec)      \
@@ -998,6 +1224,20 @@ IMB_DLL_EXPORT IMB_JOB *get_next_job_sse(IMB_MGR *state);
 #define IMB_AES_KEYEXP_256(_mgr, _raw, _enc, _dec)      \
         ((_mgr)->keyexp_256((_raw), (_enc), (_dec)))
 
+/*
+ * Multiple key expansion API's
+ * - _raw: array of _n pointers to keys
+ * - _enc: array of _n pointers to expanded encrypt keys
+ * - _dec: array of _n pointers to expanded decrypt keys
+ *   (NULL to expand encrypt keys only)
+ */
+#define IMB_AES_KEYEXP_128_N(_mgr, _raw, _enc, _dec, _n)        \
+        ((_mgr)->keyexp_128_n((_raw), (_enc), (_dec), (_n)))
+#define IMB_AES_KEYEXP_192_N(_mgr, _raw, _enc, _dec, _n)        \
+        ((_mgr)->keyexp_192_n((_raw), (_enc), (_dec), (_n)))
+#define IMB_AES_KEYEXP_256_N(_mgr, _raw, _enc, _dec, _n)        \
+        ((_mgr)->keyexp_256_n((_raw), (_enc), (_dec), (_n)))
+
 #define IMB_AES_CMAC_SUBKEY_GEN_128(_mgr, _key_exp, _k1, _k2)   \
         ((_mgr)->cmac_subkey_gen_128((_key_exp), (_k1), (_k2)))
 
@@ -1038,6 +1278,45 @@ IMB_DLL_EXPORT IMB_JOB *get_next_job_sse(IMB_MGR *state);
 #define IMB_AES128_CFB_ONE(_mgr, _out, _in, _iv, _enc, _len)            \
         ((_mgr)->aes128_cfb_one((_out), (_in), (_iv), (_enc), (_len)))
 
+/*
+ * AES-XTS API
+ * - _keys: data key (key1) expanded keys (encrypt or decrypt schedule)
+ * - _tweak_keys: tweak key (key2) expanded encrypt keys
+ * - _iv: 16-byte tweak (data unit sequence number)
+ * - _len: message length in bytes (minimum 16 bytes, partial last block
+ *   is processed with ciphertext stealing)
+ */
+#define IMB_AES128_XTS_ENC(_mgr, _in, _iv, _keys, _tweak_keys, _out, _len) \
+        ((_mgr)->aes128_xts_enc((_in), (_iv), (_keys), (_tweak_keys),   \
+                                (_out), (_len)))
+#define IMB_AES128_XTS_DEC(_mgr, _in, _iv, _keys, _tweak_keys, _out, _len) \
+        ((_mgr)->aes128_xts_dec((_in), (_iv), (_keys), (_tweak_keys),   \
+                                (_out), (_len)))
+#define IMB_AES256_XTS_ENC(_mgr, _in, _iv, _keys, _tweak_keys, _out, _len) \
+        ((_mgr)->aes256_xts_enc((_in), (_iv), (_keys), (_tweak_keys),   \
+                                (_out), (_len)))
+#define IMB_AES256_XTS_DEC(_mgr, _in, _iv, _keys, _tweak_keys, _out, _len) \
+        ((_mgr)->aes256_xts_dec((_in), (_iv), (_keys), (_tweak_keys),   \
+                                (_out), (_len)))
+
+/*
+ * AES-ECB API
+ * - _keys: expanded keys (encrypt schedule for ENC, decrypt schedule for DEC)
+ * - _len: message length in bytes (only complete 16-byte blocks are processed)
+ */
+#define IMB_AES128_ECB_ENC(_mgr, _in, _keys, _out, _len)        \
+        ((_mgr)->aes128_ecb_enc((_in), (_keys), (_out), (_len)))
+#define IMB_AES128_ECB_DEC(_mgr, _in, _keys, _out, _len)        \
+        ((_mgr)->aes128_ecb_dec((_in), (_keys), (_out), (_len)))
+#define IMB_AES192_ECB_ENC(_mgr, _in, _keys, _out, _len)        \
+        ((_mgr)->aes192_ecb_enc((_in), (_keys), (_out), (_len)))
+#define IMB_AES192_ECB_DEC(_mgr, _in, _keys, _out, _len)        \
+        ((_mgr)->aes192_ecb_dec((_in), (_keys), (_out), (_len)))
+#define IMB_AES256_ECB_ENC(_mgr, _in, _keys, _out, _len)        \
+        ((_mgr)->aes256_ecb_enc((_in), (_keys), (_out), (_len)))
+#define IMB_AES256_ECB_DEC(_mgr, _in, _keys, _out, _len)        \
+        ((_mgr)->aes256_ecb_dec((_in), (_keys), (_out), (_len)))
+
 /* AES-GCM API's */
 #define IMB_AES128_GCM_ENC(_mgr, _key, _ctx, _out, _in, _len, _iv, _aad, _aadl,\
                            _tag, _tagl)                                 \
@@ -1145,6 +1424,100 @@ IMB_DLL_EXPORT IMB_JOB *get_next_job_sse(IMB_MGR *state);
 #define IMB_AES256_GCM_PRE(_mgr, _key_in, _key_exp)     \
         ((_mgr)->gcm256_pre((_key_in), (_key_exp)))
 
+/*
+ * GCM key pre-processing of multiple keys
+ * - _key_in: array of _n pointers to keys
+ * - _key_exp: array of _n pointers to GCM key data structures
+ */
+#define IMB_AES128_GCM_PRE_N(_mgr, _key_in, _key_exp, _n)       \
+        ((_mgr)->gcm128_pre_n((_key_in), (_key_exp), (_n)))
+#define IMB_AES192_GCM_PRE_N(_mgr, _key_in, _key_exp, _n)       \
+        ((_mgr)->gcm192_pre_n((_key_in), (_key_exp), (_n)))
+#define IMB_AES256_GCM_PRE_N(_mgr, _key_in, _key_exp, _n)       \
+        ((_mgr)->gcm256_pre_n((_key_in), (_key_exp), (_n)))
+
+/*
+ * AES-GCM encrypt/decrypt of multiple messages
+ * - all arguments, except _tagl and _n, are arrays of _n elements
+ * - IV length is 12 bytes
+ */
+#define IMB_AES128_GCM_ENC_N(_mgr, _key, _ctx, _out, _in, _len, _iv, \
+                            _aad, _aadl, _tag, _tagl, _n)        \
+        ((_mgr)->gcm128_enc_n((_key), (_ctx), (_out), (_in), (_len), (_iv), \
+                              (_aad), (_aadl), (_tag), (_tagl), (_n)))
+#define IMB_AES192_GCM_ENC_N(_mgr, _key, _ctx, _out, _in, _len, _iv, \
+                            _aad, _aadl, _tag, _tagl, _n)        \
+        ((_mgr)->gcm192_enc_n((_key), (_ctx), (_out), (_in), (_len), (_iv), \
+                              (_aad), (_aadl), (_tag), (_tagl), (_n)))
+#define IMB_AES256_GCM_ENC_N(_mgr, _key, _ctx, _out, _in, _len, _iv, \
+                            _aad, _aadl, _tag, _tagl, _n)        \
+        ((_mgr)->gcm256_enc_n((_key), (_ctx), (_out), (_in), (_len), (_iv), \
+                              (_aad), (_aadl), (_tag), (_tagl), (_n)))
+#define IMB_AES128_GCM_DEC_N(_mgr, _key, _ctx, _out, _in, _len, _iv, \
+                            _aad, _aadl, _tag, _tagl, _n)        \
+        ((_mgr)->gcm128_dec_n((_key), (_ctx), (_out), (_in), (_len), (_iv), \
+                              (_aad), (_aadl), (_tag), (_tagl), (_n)))
+#define IMB_AES192_GCM_DEC_N(_mgr, _key, _ctx, _out, _in, _len, _iv, \
+                            _aad, _aadl, _tag, _tagl, _n)        \
+        ((_mgr)->gcm192_dec_n((_key), (_ctx), (_out), (_in), (_len), (_iv), \
+                              (_aad), (_aadl), (_tag), (_tagl), (_n)))
+#define IMB_AES256_GCM_DEC_N(_mgr, _key, _ctx, _out, _in, _len, _iv, \
+                            _aad, _aadl, _tag, _tagl, _n)        \
+        ((_mgr)->gcm256_dec_n((_key), (_ctx), (_out), (_in), (_len), (_iv), \
+                              (_aad), (_aadl), (_tag), (_tagl), (_n)))
+
+/*
+ * AES-GCM with compact key data (struct gcm_key_data_compact)
+ * - IMB_AESxxx_GCM_PRE_COMPACT() prepares compact key data from a key
+ * - IMB_AESxxx_GCM_EXPAND_COMPACT() derives full key data from
+ *   compact key data into a caller provided buffer (e.g. for the job API,
+ *   the buffer has to stay valid until the job completes)
+ * - IMB_AESxxx_GCM_ENC/DEC_COMPACT() are IMB_AESxxx_GCM_ENC/DEC()
+ *   on compact key data, no full key data is derived on AVX2 and AVX512
+ */
+#define IMB_AES128_GCM_PRE_COMPACT(_mgr, _key_in, _key_compact)         \
+        ((_mgr)->gcm128_pre_compact((_key_in), (_key_compact)))
+#define IMB_AES192_GCM_PRE_COMPACT(_mgr, _key_in, _key_compact)         \
+        ((_mgr)->gcm192_pre_compact((_key_in), (_key_compact)))
+#define IMB_AES256_GCM_PRE_COMPACT(_mgr, _key_in, _key_compact)         \
+        ((_mgr)->gcm256_pre_compact((_key_in), (_key_compact)))
+#define IMB_AES128_GCM_EXPAND_COMPACT(_mgr, _key_compact, _key_exp)     \
+        ((_mgr)->gcm128_expand_compact((_key_compact), (_key_exp)))
+#define IMB_AES192_GCM_EXPAND_COMPACT(_mgr, _key_compact, _key_exp)     \
+        ((_mgr)->gcm192_expand_compact((_key_compact), (_key_exp)))
+#define IMB_AES256_GCM_EXPAND_COMPACT(_mgr, _key_compact, _key_exp)     \
+        ((_mgr)->gcm256_expand_compact((_key_compact), (_key_exp)))
+#define IMB_AES128_GCM_ENC_COMPACT(_mgr, _key_compact, _ctx, _out, _in, \
+                                   _len, _iv, _aad, _aadl, _tag, _tagl) \
+        ((_mgr)->gcm128_enc_compact((_key_compact), (_ctx), (_out), (_in),  \
+                                  (_len), (_iv), (_aad), (_aadl),       \
+                                  (_tag), (_tagl)))
+#define IMB_AES192_GCM_ENC_COMPACT(_mgr, _key_compact, _ctx, _out, _in, \
+                                   _len, _iv, _aad, _aadl, _tag, _tagl) \
+        ((_mgr)->gcm192_enc_compact((_key_compact), (_ctx), (_out), (_in),  \
+                                  (_len), (_iv), (_aad), (_aadl),       \
+                                  (_tag), (_tagl)))
+#define IMB_AES256_GCM_ENC_COMPACT(_mgr, _key_compact, _ctx, _out, _in, \
+                                   _len, _iv, _aad, _aadl, _tag, _tagl) \
+        ((_mgr)->gcm256_enc_compact((_key_compact), (_ctx), (_out), (_in),  \
+                                  (_len), (_iv), (_aad), (_aadl),       \
+                                  (_tag), (_tagl)))
+#define IMB_AES128_GCM_DEC_COMPACT(_mgr, _key_compact, _ctx, _out, _in, \
+                                   _len, _iv, _aad, _aadl, _tag, _tagl) \
+        ((_mgr)->gcm128_dec_compact((_key_compact), (_ctx), (_out), (_in),  \
+                                  (_len), (_iv), (_aad), (_aadl),       \
+                                  (_tag), (_tagl)))
+#define IMB_AES192_GCM_DEC_COMPACT(_mgr, _key_compact, _ctx, _out, _in, \
+                                   _len, _iv, _aad, _aadl, _tag, _tagl) \
+        ((_mgr)->gcm192_dec_compact((_key_compact), (_ctx), (_out), (_in),  \
+                                  (_len), (_iv), (_aad), (_aadl),       \
+                                  (_tag), (_tagl)))
+#define IMB_AES256_GCM_DEC_COMPACT(_mgr, _key_compact, _ctx, _out, _in, \
+                                   _len, _iv, _aad, _aadl, _tag, _tagl) \
+        ((_mgr)->gcm256_dec_compact((_key_compact), (_ctx), (_out), (_in),  \
+                                  (_len), (_iv), (_aad), (_aadl),       \
+                                  (_tag), (_tagl)))
+
 #define IMB_GHASH(_mgr, _key, _in, _in_len, _out, _out_len) \
         ((_mgr)->ghash((_key), (_in), (_in_len), (_out), (_out_len)))
 
@@ -1641,6 +2014,55 @@ IMB_DLL_EXPORT IMB_JOB *get_next_job_sse(IMB_MGR *state);
 #define IMB_HEC_32(_mgr, _in)((_mgr)->hec_32(_in))
 #define IMB_HEC_64(_mgr, _in)((_mgr)->hec_64(_in))
 
+/**
+ *******************************************************************************
+ * CRC compute functions
+ *
+ * All functions take a message pointer and a message length in bytes
+ * and return the CRC value in the least significant bits of the result.
+ *
+ * - IMB_CRC32_ETHERNET_FCS: Ethernet FCS CRC32 (IEEE 802.3),
+ *                           polynomial 0x04C11DB7, reflected
+ * - IMB_CRC32_SCTP: SCTP CRC32C (RFC 3309), polynomial 0x1EDC6F41, reflected
+ * - IMB_CRC16_X25: CRC16 CCITT / X.25, polynomial 0x1021, reflected
+ * - IMB_CRC24_LTE_A: LTE/5G CRC24A (3GPP TS 36.212), polynomial 0x864CFB
+ * - IMB_CRC24_LTE_B: LTE/5G CRC24B (3GPP TS 36.212), polynomial 0x800063
+ * - IMB_CRC16_FP_DATA: Framing Protocol data CRC16 (3GPP TS 25.435),
+ *                      polynomial 0x8005
+ * - IMB_CRC11_FP_HEADER: Framing Protocol header CRC11 (3GPP TS 25.435),
+ *                        polynomial 0x307
+ * - IMB_CRC7_FP_HEADER: Framing Protocol header CRC7 (3GPP TS 25.435),
+ *                       polynomial 0x45
+ * - IMB_CRC10_IUUP_DATA: IuUP data CRC10 (3GPP TS 25.415), polynomial 0x233
+ * - IMB_CRC6_IUUP_HEADER: IuUP header CRC6 (3GPP TS 25.415), polynomial 0x2F
+ *
+ * @param[in] _mgr      Pointer to multi-buffer structure
+ * @param[in] _in       Pointer to input message
+ * @param[in] _len      Message length in bytes
+ *
+ * @return CRC value
+ ******************************************************************************/
+#define IMB_CRC32_ETHERNET_FCS(_mgr, _in, _len)         \
+        ((_mgr)->crc32_ethernet_fcs(_in, _len))
+#define IMB_CRC32_SCTP(_mgr, _in, _len)                 \
+        ((_mgr)->crc32_sctp(_in, _len))
+#define IMB_CRC16_X25(_mgr, _in, _len)                  \
+        ((_mgr)->crc16_x25(_in, _len))
+#define IMB_CRC24_LTE_A(_mgr, _in, _len)                \
+        ((_mgr)->crc24_lte_a(_in, _len))
+#define IMB_CRC24_LTE_B(_mgr, _in, _len)                \
+        ((_mgr)->crc24_lte_b(_in, _len))
+#define IMB_CRC16_FP_DATA(_mgr, _in, _len)              \
+        ((_mgr)->crc16_fp_data(_in, _len))
+#define IMB_CRC11_FP_HEADER(_mgr, _in, _len)            \
+        ((_mgr)->crc11_fp_header(_in, _len))
+#define IMB_CRC7_FP_HEADER(_mgr, _in, _len)             \
+        ((_mgr)->crc7_fp_header(_in, _len))
+#define IMB_CRC10_IUUP_DATA(_mgr, _in, _len)            \
+        ((_mgr)->crc10_iuup_data(_in, _len))
+#define IMB_CRC6_IUUP_HEADER(_mgr, _in, _len)           \
+        ((_mgr)->crc6_iuup_header(_in, _len))
+
 /* Auxiliary functions */
 
 /**
@@ -1689,11 +2111,54 @@ IMB_DLL_EXPORT void aes_keyexp_192_enc_sse(const void *key,
                                            void *enc_exp_keys);
 IMB_DLL_EXPORT void aes_keyexp_256_enc_sse(const void *key,
                                            void *enc_exp_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_128_n_sse(const void * const keys[],
+                     void * const enc_exp_keys[],
+                     void * const dec_exp_keys[],
+                     const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_192_n_sse(const void * const keys[],
+                     void * const enc_exp_keys[],
+                     void * const dec_exp_keys[],
+                     const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_256_n_sse(const void * const keys[],
+                     void * const enc_exp_keys[],
+                     void * const dec_exp_keys[],
+                     const uint32_t num_keys);
 IMB_DLL_EXPORT void aes_cmac_subkey_gen_sse(const void *key_exp, void *key1,
                                             void *key2);
 IMB_DLL_EXPORT void aes_cfb_128_one_sse(void *out, const void *in,
                                         const void *iv, const void *keys,
                                         uint64_t len);
+IMB_DLL_EXPORT void aes_xts_128_enc_sse(const void *in, const void *iv,
+                                        const void *keys,
+                                        const void *tweak_keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_xts_128_dec_sse(const void *in, const void *iv,
+                                        const void *keys,
+                                        const void *tweak_keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_xts_256_enc_sse(const void *in, const void *iv,
+                                        const void *keys,
+                                        const void *tweak_keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_xts_256_dec_sse(const void *in, const void *iv,
+                                        const void *keys,
+                                        const void *tweak_keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_ecb_128_enc_sse(const void *in, const void *keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_ecb_128_dec_sse(const void *in, const void *keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_ecb_192_enc_sse(const void *in, const void *keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_ecb_192_dec_sse(const void *in, const void *keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_ecb_256_enc_sse(const void *in, const void *keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_ecb_256_dec_sse(const void *in, const void *keys,
+                                        void *out, const uint64_t len);
 /* AVX */
 IMB_DLL_EXPORT void sha1_avx(const void *data, const uint64_t length,
                              void *digest);
@@ -1725,11 +2190,54 @@ IMB_DLL_EXPORT void aes_keyexp_192_enc_avx(const void *key,
                                            void *enc_exp_keys);
 IMB_DLL_EXPORT void aes_keyexp_256_enc_avx(const void *key,
                                            void *enc_exp_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_128_n_avx(const void * const keys[],
+                     void * const enc_exp_keys[],
+                     void * const dec_exp_keys[],
+                     const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_192_n_avx(const void * const keys[],
+                     void * const enc_exp_keys[],
+                     void * const dec_exp_keys[],
+                     const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_256_n_avx(const void * const keys[],
+                     void * const enc_exp_keys[],
+                     void * const dec_exp_keys[],
+                     const uint32_t num_keys);
 IMB_DLL_EXPORT void aes_cmac_subkey_gen_avx(const void *key_exp, void *key1,
                                             void *key2);
 IMB_DLL_EXPORT void aes_cfb_128_one_avx(void *out, const void *in,
                                         const void *iv, const void *keys,
                                         uint64_t len);
+IMB_DLL_EXPORT void aes_xts_128_enc_avx(const void *in, const void *iv,
+                                        const void *keys,
+                                        const void *tweak_keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_xts_128_dec_avx(const void *in, const void *iv,
+                                        const void *keys,
+                                        const void *tweak_keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_xts_256_enc_avx(const void *in, const void *iv,
+                                        const void *keys,
+                                        const void *tweak_keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_xts_256_dec_avx(const void *in, const void *iv,
+                                        const void *keys,
+                                        const void *tweak_keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_ecb_128_enc_avx(const void *in, const void *keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_ecb_128_dec_avx(const void *in, const void *keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_ecb_192_enc_avx(const void *in, const void *keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_ecb_192_dec_avx(const void *in, const void *keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_ecb_256_enc_avx(const void *in, const void *keys,
+                                        void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_ecb_256_dec_avx(const void *in, const void *keys,
+                                        void *out, const uint64_t len);
 /* AVX2 */
 IMB_DLL_EXPORT void sha1_avx2(const void *data, const uint64_t length,
                               void *digest);
@@ -1761,6 +2269,21 @@ IMB_DLL_EXPORT void aes_keyexp_192_enc_avx2(const void *key,
                                             void *enc_exp_keys);
 IMB_DLL_EXPORT void aes_keyexp_256_enc_avx2(const void *key,
                                             void *enc_exp_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_128_n_avx2(const void * const keys[],
+                      void * const enc_exp_keys[],
+                      void * const dec_exp_keys[],
+                      const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_192_n_avx2(const void * const keys[],
+                      void * const enc_exp_keys[],
+                      void * const dec_exp_keys[],
+                      const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_256_n_avx2(const void * const keys[],
+                      void * const enc_exp_keys[],
+                      void * const dec_exp_keys[],
+                      const uint32_t num_keys);
 IMB_DLL_EXPORT void aes_cmac_subkey_gen_avx2(const void *key_exp, void *key1,
                                              void *key2);
 IMB_DLL_EXPORT void aes_cfb_128_one_avx2(void *out, const void *in,
@@ -1798,11 +2321,78 @@ IMB_DLL_EXPORT void aes_keyexp_192_enc_avx512(const void *key,
                                               void *enc_exp_keys);
 IMB_DLL_EXPORT void aes_keyexp_256_enc_avx512(const void *key,
                                               void *enc_exp_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_128_n_avx512(const void * const keys[],
+                        void * const enc_exp_keys[],
+                        void * const dec_exp_keys[],
+                        const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_192_n_avx512(const void * const keys[],
+                        void * const enc_exp_keys[],
+                        void * const dec_exp_keys[],
+                        const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_256_n_avx512(const void * const keys[],
+                        void * const enc_exp_keys[],
+                        void * const dec_exp_keys[],
+                        const uint32_t num_keys);
 IMB_DLL_EXPORT void aes_cmac_subkey_gen_avx512(const void *key_exp, void *key1,
                                                void *key2);
 IMB_DLL_EXPORT void aes_cfb_128_one_avx512(void *out, const void *in,
                                            const void *iv, const void *keys,
                                            uint64_t len);
+IMB_DLL_EXPORT void aes_xts_128_enc_avx512(const void *in, const void *iv,
+                                           const void *keys,
+                                           const void *tweak_keys,
+                                           void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_xts_128_dec_avx512(const void *in, const void *iv,
+                                           const void *keys,
+                                           const void *tweak_keys,
+                                           void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_xts_256_enc_avx512(const void *in, const void *iv,
+                                           const void *keys,
+                                           const void *tweak_keys,
+                                           void *out, const uint64_t len);
+IMB_DLL_EXPORT void aes_xts_256_dec_avx512(const void *in, const void *iv,
+                                           const void *keys,
+                                           const void *tweak_keys,
+                                           void *out, const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_128_enc_avx512(const void *in, const void *keys, void *out,
+                       const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_128_dec_avx512(const void *in, const void *keys, void *out,
+                       const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_192_enc_avx512(const void *in, const void *keys, void *out,
+                       const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_192_dec_avx512(const void *in, const void *keys, void *out,
+                       const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_256_enc_avx512(const void *in, const void *keys, void *out,
+                       const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_256_dec_avx512(const void *in, const void *keys, void *out,
+                       const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_128_enc_vaes_avx512(const void *in, const void *keys, void *out,
+                            const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_128_dec_vaes_avx512(const void *in, const void *keys, void *out,
+                            const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_192_enc_vaes_avx512(const void *in, const void *keys, void *out,
+                            const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_192_dec_vaes_avx512(const void *in, const void *keys, void *out,
+                            const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_256_enc_vaes_avx512(const void *in, const void *keys, void *out,
+                            const uint64_t len);
+IMB_DLL_EXPORT void
+aes_ecb_256_dec_vaes_avx512(const void *in, const void *keys, void *out,
+                            const uint64_t len);
 
 /*
  * Direct GCM API.
@@ -2268,6 +2858,418 @@ IMB_DLL_EXPORT void aes_gcm_pre_256_avx_gen2(const void *key,
 IMB_DLL_EXPORT void aes_gcm_pre_256_avx_gen4(const void *key,
                                              struct gcm_key_data *key_data);
 
+/**
+ * @brief Pre-processes GCM key data of multiple keys
+ *
+ * Round keys of up to 4 keys are expanded at a time,
+ * hash keys are computed for each key separately.
+ *
+ * @param keys     array of pointers to keys
+ * @param key_data array of pointers to GCM expanded key data
+ * @param num_keys number of keys
+ */
+IMB_DLL_EXPORT void
+aes_gcm_pre_128_n_sse(const void * const keys[],
+                      struct gcm_key_data * const key_data[],
+                      const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_128_n_avx_gen2(const void * const keys[],
+                           struct gcm_key_data * const key_data[],
+                           const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_128_n_avx_gen4(const void * const keys[],
+                           struct gcm_key_data * const key_data[],
+                           const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_192_n_sse(const void * const keys[],
+                      struct gcm_key_data * const key_data[],
+                      const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_192_n_avx_gen2(const void * const keys[],
+                           struct gcm_key_data * const key_data[],
+                           const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_192_n_avx_gen4(const void * const keys[],
+                           struct gcm_key_data * const key_data[],
+                           const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_256_n_sse(const void * const keys[],
+                      struct gcm_key_data * const key_data[],
+                      const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_256_n_avx_gen2(const void * const keys[],
+                           struct gcm_key_data * const key_data[],
+                           const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_256_n_avx_gen4(const void * const keys[],
+                           struct gcm_key_data * const key_data[],
+                           const uint32_t num_keys);
+
+/**
+ * @brief AES-GCM encrypt/decrypt of multiple messages
+ *
+ * Each message uses its own key, context, 12-byte IV and AAD.
+ * Messages are processed in groups of 4 with AES rounds and GHASH
+ * interleaved across the messages.
+ *
+ * @param key_data array of pointers to GCM expanded key data
+ * @param ctx      array of pointers to GCM context data
+ * @param out      array of pointers to output buffers
+ * @param in       array of pointers to input buffers
+ * @param len      array of message lengths in bytes
+ * @param iv       array of pointers to 12-byte IVs
+ * @param aad      array of pointers to AAD
+ * @param aad_len  array of AAD lengths in bytes
+ * @param tag      array of pointers to authentication tag outputs
+ * @param tag_len  authentication tag length in bytes (1 to 16)
+ * @param num_msgs number of messages
+ */
+IMB_DLL_EXPORT void
+aes_gcm_enc_128_n_sse(const struct gcm_key_data * const key_data[],
+                      struct gcm_context_data * const ctx[],
+                      uint8_t * const out[], const uint8_t * const in[],
+                      const uint64_t len[], const uint8_t * const iv[],
+                      const uint8_t * const aad[], const uint64_t aad_len[],
+                      uint8_t * const tag[], const uint64_t tag_len,
+                      const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_enc_128_n_avx_gen2(const struct gcm_key_data * const key_data[],
+                           struct gcm_context_data * const ctx[],
+                           uint8_t * const out[], const uint8_t * const in[],
+                           const uint64_t len[], const uint8_t * const iv[],
+                           const uint8_t * const aad[],
+                           const uint64_t aad_len[], uint8_t * const tag[],
+                           const uint64_t tag_len, const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_enc_128_n_avx_gen4(const struct gcm_key_data * const key_data[],
+                           struct gcm_context_data * const ctx[],
+                           uint8_t * const out[], const uint8_t * const in[],
+                           const uint64_t len[], const uint8_t * const iv[],
+                           const uint8_t * const aad[],
+                           const uint64_t aad_len[], uint8_t * const tag[],
+                           const uint64_t tag_len, const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_128_n_sse(const struct gcm_key_data * const key_data[],
+                      struct gcm_context_data * const ctx[],
+                      uint8_t * const out[], const uint8_t * const in[],
+                      const uint64_t len[], const uint8_t * const iv[],
+                      const uint8_t * const aad[], const uint64_t aad_len[],
+                      uint8_t * const tag[], const uint64_t tag_len,
+                      const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_128_n_avx_gen2(const struct gcm_key_data * const key_data[],
+                           struct gcm_context_data * const ctx[],
+                           uint8_t * const out[], const uint8_t * const in[],
+                           const uint64_t len[], const uint8_t * const iv[],
+                           const uint8_t * const aad[],
+                           const uint64_t aad_len[], uint8_t * const tag[],
+                           const uint64_t tag_len, const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_128_n_avx_gen4(const struct gcm_key_data * const key_data[],
+                           struct gcm_context_data * const ctx[],
+                           uint8_t * const out[], const uint8_t * const in[],
+                           const uint64_t len[], const uint8_t * const iv[],
+                           const uint8_t * const aad[],
+                           const uint64_t aad_len[], uint8_t * const tag[],
+                           const uint64_t tag_len, const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_enc_192_n_sse(const struct gcm_key_data * const key_data[],
+                      struct gcm_context_data * const ctx[],
+                      uint8_t * const out[], const uint8_t * const in[],
+                      const uint64_t len[], const uint8_t * const iv[],
+                      const uint8_t * const aad[], const uint64_t aad_len[],
+                      uint8_t * const tag[], const uint64_t tag_len,
+                      const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_enc_192_n_avx_gen2(const struct gcm_key_data * const key_data[],
+                           struct gcm_context_data * const ctx[],
+                           uint8_t * const out[], const uint8_t * const in[],
+                           const uint64_t len[], const uint8_t * const iv[],
+                           const uint8_t * const aad[],
+                           const uint64_t aad_len[], uint8_t * const tag[],
+                           const uint64_t tag_len, const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_enc_192_n_avx_gen4(const struct gcm_key_data * const key_data[],
+                           struct gcm_context_data * const ctx[],
+                           uint8_t * const out[], const uint8_t * const in[],
+                           const uint64_t len[], const uint8_t * const iv[],
+                           const uint8_t * const aad[],
+                           const uint64_t aad_len[], uint8_t * const tag[],
+                           const uint64_t tag_len, const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_192_n_sse(const struct gcm_key_data * const key_data[],
+                      struct gcm_context_data * const ctx[],
+                      uint8_t * const out[], const uint8_t * const in[],
+                      const uint64_t len[], const uint8_t * const iv[],
+                      const uint8_t * const aad[], const uint64_t aad_len[],
+                      uint8_t * const tag[], const uint64_t tag_len,
+                      const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_192_n_avx_gen2(const struct gcm_key_data * const key_data[],
+                           struct gcm_context_data * const ctx[],
+                           uint8_t * const out[], const uint8_t * const in[],
+                           const uint64_t len[], const uint8_t * const iv[],
+                           const uint8_t * const aad[],
+                           const uint64_t aad_len[], uint8_t * const tag[],
+                           const uint64_t tag_len, const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_192_n_avx_gen4(const struct gcm_key_data * const key_data[],
+                           struct gcm_context_data * const ctx[],
+                           uint8_t * const out[], const uint8_t * const in[],
+                           const uint64_t len[], const uint8_t * const iv[],
+                           const uint8_t * const aad[],
+                           const uint64_t aad_len[], uint8_t * const tag[],
+                           const uint64_t tag_len, const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_enc_256_n_sse(const struct gcm_key_data * const key_data[],
+                      struct gcm_context_data * const ctx[],
+                      uint8_t * const out[], const uint8_t * const in[],
+                      const uint64_t len[], const uint8_t * const iv[],
+                      const uint8_t * const aad[], const uint64_t aad_len[],
+                      uint8_t * const tag[], const uint64_t tag_len,
+                      const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_enc_256_n_avx_gen2(const struct gcm_key_data * const key_data[],
+                           struct gcm_context_data * const ctx[],
+                           uint8_t * const out[], const uint8_t * const in[],
+                           const uint64_t len[], const uint8_t * const iv[],
+                           const uint8_t * const aad[],
+                           const uint64_t aad_len[], uint8_t * const tag[],
+                           const uint64_t tag_len, const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_enc_256_n_avx_gen4(const struct gcm_key_data * const key_data[],
+                           struct gcm_context_data * const ctx[],
+                           uint8_t * const out[], const uint8_t * const in[],
+                           const uint64_t len[], const uint8_t * const iv[],
+                           const uint8_t * const aad[],
+                           const uint64_t aad_len[], uint8_t * const tag[],
+                           const uint64_t tag_len, const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_256_n_sse(const struct gcm_key_data * const key_data[],
+                      struct gcm_context_data * const ctx[],
+                      uint8_t * const out[], const uint8_t * const in[],
+                      const uint64_t len[], const uint8_t * const iv[],
+                      const uint8_t * const aad[], const uint64_t aad_len[],
+                      uint8_t * const tag[], const uint64_t tag_len,
+                      const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_256_n_avx_gen2(const struct gcm_key_data * const key_data[],
+                           struct gcm_context_data * const ctx[],
+                           uint8_t * const out[], const uint8_t * const in[],
+                           const uint64_t len[], const uint8_t * const iv[],
+                           const uint8_t * const aad[],
+                           const uint64_t aad_len[], uint8_t * const tag[],
+                           const uint64_t tag_len, const uint32_t num_msgs);
+IMB_DLL_EXPORT void
+aes_gcm_dec_256_n_avx_gen4(const struct gcm_key_data * const key_data[],
+                           struct gcm_context_data * const ctx[],
+                           uint8_t * const out[], const uint8_t * const in[],
+                           const uint64_t len[], const uint8_t * const iv[],
+                           const uint8_t * const aad[],
+                           const uint64_t aad_len[], uint8_t * const tag[],
+                           const uint64_t tag_len, const uint32_t num_msgs);
+
+/**
+ * @brief Prepares compact GCM key data (round keys and hash key powers)
+ *
+ * @param key      pointer to key
+ * @param key_data pointer to compact GCM key data
+ */
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_128_sse(const void *key,
+                            struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_128_avx_gen2(const void *key,
+                                 struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_128_avx_gen4(const void *key,
+                                 struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_192_sse(const void *key,
+                            struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_192_avx_gen2(const void *key,
+                                 struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_192_avx_gen4(const void *key,
+                                 struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_256_sse(const void *key,
+                            struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_256_avx_gen2(const void *key,
+                                 struct gcm_key_data_compact *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_compact_256_avx_gen4(const void *key,
+                                 struct gcm_key_data_compact *key_data);
+
+/**
+ * @brief Derives full GCM key data from compact GCM key data
+ *
+ * @param key      pointer to compact GCM key data
+ * @param key_data pointer to full GCM key data (output)
+ */
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_128_sse(const struct gcm_key_data_compact *key,
+                               struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_128_avx_gen2(const struct gcm_key_data_compact *key,
+                                    struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_128_avx_gen4(const struct gcm_key_data_compact *key,
+                                    struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_192_sse(const struct gcm_key_data_compact *key,
+                               struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_192_avx_gen2(const struct gcm_key_data_compact *key,
+                                    struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_192_avx_gen4(const struct gcm_key_data_compact *key,
+                                    struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_256_sse(const struct gcm_key_data_compact *key,
+                               struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_256_avx_gen2(const struct gcm_key_data_compact *key,
+                                    struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_expand_compact_256_avx_gen4(const struct gcm_key_data_compact *key,
+                                    struct gcm_key_data *key_data);
+
+/**
+ * @brief AES-GCM encrypt/decrypt with compact GCM key data
+ *
+ * Parameters as of aes_gcm_enc_128_sse() and aes_gcm_dec_128_sse(),
+ * with key pointing to compact GCM key data.
+ */
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_128_sse(const struct gcm_key_data_compact *key,
+                            struct gcm_context_data *context_data,
+                            uint8_t *out, uint8_t const *in, uint64_t len,
+                            const uint8_t *iv, uint8_t const *aad,
+                            uint64_t aad_len, uint8_t *auth_tag,
+                            uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_128_avx_gen2(const struct gcm_key_data_compact *key,
+                                 struct gcm_context_data *context_data,
+                                 uint8_t *out, uint8_t const *in, uint64_t len,
+                                 const uint8_t *iv, uint8_t const *aad,
+                                 uint64_t aad_len, uint8_t *auth_tag,
+                                 uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_128_avx_gen4(const struct gcm_key_data_compact *key,
+                                 struct gcm_context_data *context_data,
+                                 uint8_t *out, uint8_t const *in, uint64_t len,
+                                 const uint8_t *iv, uint8_t const *aad,
+                                 uint64_t aad_len, uint8_t *auth_tag,
+                                 uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_192_sse(const struct gcm_key_data_compact *key,
+                            struct gcm_context_data *context_data,
+                            uint8_t *out, uint8_t const *in, uint64_t len,
+                            const uint8_t *iv, uint8_t const *aad,
+                            uint64_t aad_len, uint8_t *auth_tag,
+                            uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_192_avx_gen2(const struct gcm_key_data_compact *key,
+                                 struct gcm_context_data *context_data,
+                                 uint8_t *out, uint8_t const *in, uint64_t len,
+                                 const uint8_t *iv, uint8_t const *aad,
+                                 uint64_t aad_len, uint8_t *auth_tag,
+                                 uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_192_avx_gen4(const struct gcm_key_data_compact *key,
+                                 struct gcm_context_data *context_data,
+                                 uint8_t *out, uint8_t const *in, uint64_t len,
+                                 const uint8_t *iv, uint8_t const *aad,
+                                 uint64_t aad_len, uint8_t *auth_tag,
+                                 uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_256_sse(const struct gcm_key_data_compact *key,
+                            struct gcm_context_data *context_data,
+                            uint8_t *out, uint8_t const *in, uint64_t len,
+                            const uint8_t *iv, uint8_t const *aad,
+                            uint64_t aad_len, uint8_t *auth_tag,
+                            uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_256_avx_gen2(const struct gcm_key_data_compact *key,
+                                 struct gcm_context_data *context_data,
+                                 uint8_t *out, uint8_t const *in, uint64_t len,
+                                 const uint8_t *iv, uint8_t const *aad,
+                                 uint64_t aad_len, uint8_t *auth_tag,
+                                 uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_enc_compact_256_avx_gen4(const struct gcm_key_data_compact *key,
+                                 struct gcm_context_data *context_data,
+                                 uint8_t *out, uint8_t const *in, uint64_t len,
+                                 const uint8_t *iv, uint8_t const *aad,
+                                 uint64_t aad_len, uint8_t *auth_tag,
+                                 uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_128_sse(const struct gcm_key_data_compact *key,
+                            struct gcm_context_data *context_data,
+                            uint8_t *out, uint8_t const *in, uint64_t len,
+                            const uint8_t *iv, uint8_t const *aad,
+                            uint64_t aad_len, uint8_t *auth_tag,
+                            uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_128_avx_gen2(const struct gcm_key_data_compact *key,
+                                 struct gcm_context_data *context_data,
+                                 uint8_t *out, uint8_t const *in, uint64_t len,
+                                 const uint8_t *iv, uint8_t const *aad,
+                                 uint64_t aad_len, uint8_t *auth_tag,
+                                 uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_128_avx_gen4(const struct gcm_key_data_compact *key,
+                                 struct gcm_context_data *context_data,
+                                 uint8_t *out, uint8_t const *in, uint64_t len,
+                                 const uint8_t *iv, uint8_t const *aad,
+                                 uint64_t aad_len, uint8_t *auth_tag,
+                                 uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_192_sse(const struct gcm_key_data_compact *key,
+                            struct gcm_context_data *context_data,
+                            uint8_t *out, uint8_t const *in, uint64_t len,
+                            const uint8_t *iv, uint8_t const *aad,
+                            uint64_t aad_len, uint8_t *auth_tag,
+                            uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_192_avx_gen2(const struct gcm_key_data_compact *key,
+                                 struct gcm_context_data *context_data,
+                                 uint8_t *out, uint8_t const *in, uint64_t len,
+                                 const uint8_t *iv, uint8_t const *aad,
+                                 uint64_t aad_len, uint8_t *auth_tag,
+                                 uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_192_avx_gen4(const struct gcm_key_data_compact *key,
+                                 struct gcm_context_data *context_data,
+                                 uint8_t *out, uint8_t const *in, uint64_t len,
+                                 const uint8_t *iv, uint8_t const *aad,
+                                 uint64_t aad_len, uint8_t *auth_tag,
+                                 uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_256_sse(const struct gcm_key_data_compact *key,
+                            struct gcm_context_data *context_data,
+                            uint8_t *out, uint8_t const *in, uint64_t len,
+                            const uint8_t *iv, uint8_t const *aad,
+                            uint64_t aad_len, uint8_t *auth_tag,
+                            uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_256_avx_gen2(const struct gcm_key_data_compact *key,
+                                 struct gcm_context_data *context_data,
+                                 uint8_t *out, uint8_t const *in, uint64_t len,
+                                 const uint8_t *iv, uint8_t const *aad,
+                                 uint64_t aad_len, uint8_t *auth_tag,
+                                 uint64_t auth_tag_len);
+IMB_DLL_EXPORT void
+aes_gcm_dec_compact_256_avx_gen4(const struct gcm_key_data_compact *key,
+                                 struct gcm_context_data *context_data,
+                                 uint8_t *out, uint8_t const *in, uint64_t len,
+                                 const uint8_t *iv, uint8_t const *aad,
+                                 uint64_t aad_len, uint8_t *auth_tag,
+                                 uint64_t auth_tag_len);
+
 /**
  * @brief Generation of ZUC Initialization Vectors (for EEA3 and EIA3)
  *
@@ -0,0 +1,521 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#ifdef LINUX
+#include <stdlib.h> /* posix_memalign() and free() */
+#include <pthread.h>
+#include <sched.h>
+#else
+#include <malloc.h> /* _aligned_malloc() and aligned_free() */
+#include <windows.h>
+#endif
+#include <immintrin.h> /* _mm_pause() */
+
+#include "intel-ipsec-mb.h"
+
+#define POOL_MAX_WORKERS  64
+#define POOL_CACHE_LINE   64
+#define POOL_FLUSH_SPINS  256  /* idle loops before flushing the manager */
+#define POOL_IDLE_SPINS   1024 /* idle loops before yielding the CPU */
+#define POOL_MAX_RING     (1ULL << 32) /* max number of ring entries */
+
+/*
+ * Bounded multi-producer/multi-consumer ring (D. Vyukov's algorithm).
+ * Each cell has a sequence number telling whether it is free for
+ * the producer at given position or holds a job for the consumer.
+ */
+struct pool_cell {
+        volatile uint64_t seq;
+        IMB_JOB *job;
+};
+
+struct pool_ring {
+        volatile uint64_t enq_pos;
+        uint8_t pad0[POOL_CACHE_LINE - sizeof(uint64_t)];
+        volatile uint64_t deq_pos;
+        uint8_t pad1[POOL_CACHE_LINE - sizeof(uint64_t)];
+        uint64_t mask;
+        struct pool_cell *cells;
+};
+
+struct pool_worker {
+        struct pool_ring in;            /* jobs queued to this worker */
+        struct IMB_POOL *pool;
+        IMB_MGR *mgr;
+        IMB_JOB *app_jobs[MAX_JOBS];    /* application job of mgr job slot */
+        uint32_t id;
+        volatile uint64_t stolen;       /* jobs taken from other workers */
+#ifdef LINUX
+        pthread_t thread;
+#else
+        HANDLE thread;
+#endif
+        int started;
+};
+
+struct IMB_POOL {
+        struct pool_ring done;          /* completed jobs */
+        volatile uint64_t stop;
+        uint32_t num_workers;
+        struct pool_worker *workers[POOL_MAX_WORKERS];
+};
+
+static void *
+pool_mem_alloc(const size_t size)
+{
+        void *ptr;
+
+#ifdef LINUX
+        if (posix_memalign((void **)&ptr, POOL_CACHE_LINE, size))
+                return NULL;
+#else
+        ptr = _aligned_malloc(size, POOL_CACHE_LINE);
+        if (ptr == NULL)
+                return NULL;
+#endif
+        memset(ptr, 0, size);
+        return ptr;
+}
+
+static void
+pool_mem_free(void *ptr)
+{
+#ifdef LINUX
+        free(ptr);
+#else
+        _aligned_free(ptr);
+#endif
+}
+
+static uint64_t
+pool_load(const volatile uint64_t *ptr)
+{
+#ifdef LINUX
+        return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#else
+        /* volatile reads have acquire semantics on x64 */
+        return *ptr;
+#endif
+}
+
+static void
+pool_store(volatile uint64_t *ptr, const uint64_t val)
+{
+#ifdef LINUX
+        __atomic_store_n(ptr, val, __ATOMIC_RELEASE);
+#else
+        /* volatile writes have release semantics on x64 */
+        *ptr = val;
+#endif
+}
+
+/* Returns 1 and sets *ptr to <val> if it is equal to <old> */
+static int
+pool_cas(volatile uint64_t *ptr, const uint64_t old, const uint64_t val)
+{
+#ifdef LINUX
+        return __sync_bool_compare_and_swap(ptr, old, val);
+#else
+        return (uint64_t) InterlockedCompareExchange64((volatile LONG64 *) ptr,
+                                                       (LONG64) val,
+                                                       (LONG64) old) == old;
+#endif
+}
+
+static void
+pool_yield(void)
+{
+#ifdef LINUX
+        sched_yield();
+#else
+        SwitchToThread();
+#endif
+}
+
+/* Returns 0 on success or -1 if size is above POOL_MAX_RING or on error */
+static int
+pool_ring_init(struct pool_ring *ring, const uint64_t size)
+{
+        uint64_t i, num = 1;
+
+        if (size > POOL_MAX_RING)
+                return -1;
+        while (num < size)
+                num <<= 1;
+
+        ring->cells = pool_mem_alloc(num * sizeof(struct pool_cell));
+        if (ring->cells == NULL)
+                return -1;
+        for (i = 0; i < num; i++)
+                ring->cells[i].seq = i;
+        ring->mask = num - 1;
+        ring->enq_pos = 0;
+        ring->deq_pos = 0;
+
+        return 0;
+}
+
+/* Returns 0 on success or -1 if the ring is full */
+static int
+pool_ring_push(struct pool_ring *ring, IMB_JOB *job)
+{
+        struct pool_cell *cell;
+        uint64_t pos = pool_load(&ring->enq_pos);
+
+        for (;;) {
+                int64_t diff;
+
+                cell = &ring->cells[pos & ring->mask];
+                diff = (int64_t) pool_load(&cell->seq) - (int64_t) pos;
+                if (diff == 0) {
+                        if (pool_cas(&ring->enq_pos, pos, pos + 1))
+                                break;
+                } else if (diff < 0) {
+                        return -1;
+                }
+                pos = pool_load(&ring->enq_pos);
+        }
+        cell->job = job;
+        pool_store(&cell->seq, pos + 1);
+
+        return 0;
+}
+
+/* Returns next job or NULL if the ring is empty */
+static IMB_JOB *
+pool_ring_pop(struct pool_ring *ring)
+{
+        struct pool_cell *cell;
+        uint64_t pos = pool_load(&ring->deq_pos);
+        IMB_JOB *job;
+
+        for (;;) {
+                int64_t diff;
+
+                cell = &ring->cells[pos & ring->mask];
+                diff = (int64_t) pool_load(&cell->seq) - (int64_t) (pos + 1);
+                if (diff == 0) {
+                        if (pool_cas(&ring->deq_pos, pos, pos + 1))
+                                break;
+                } else if (diff < 0) {
+                        return NULL;
+                }
+                pos = pool_load(&ring->deq_pos);
+        }
+        job = cell->job;
+        pool_store(&cell->seq, pos + ring->mask + 1);
+
+        return job;
+}
+
+/* Hands completed manager job back to the application */
+static void
+pool_complete(struct pool_worker *worker, const IMB_JOB *job)
+{
+        struct IMB_POOL *pool = worker->pool;
+        IMB_JOB *app_job = worker->app_jobs[job - worker->mgr->jobs];
+
+        app_job->status = job->status;
+        /* wait for the application to make room, unless stopping */
+        while (pool_ring_push(&pool->done, app_job) != 0) {
+                if (pool_load(&pool->stop))
+                        return;
+                _mm_pause();
+        }
+}
+
+/* Takes a queued job from another worker */
+static IMB_JOB *
+pool_steal(struct pool_worker *worker)
+{
+        const struct IMB_POOL *pool = worker->pool;
+        uint32_t i;
+
+        for (i = 1; i < pool->num_workers; i++) {
+                struct pool_worker *victim =
+                        pool->workers[(worker->id + i) % pool->num_workers];
+                IMB_JOB *job = pool_ring_pop(&victim->in);
+
+                if (job != NULL) {
+                        /* single writer, atomic for imb_pool_stolen_jobs() */
+                        pool_store(&worker->stolen,
+                                   pool_load(&worker->stolen) + 1);
+                        return job;
+                }
+        }
+
+        return NULL;
+}
+
+static void
+pool_worker_run(struct pool_worker *worker)
+{
+        const struct IMB_POOL *pool = worker->pool;
+        IMB_MGR *mgr = worker->mgr;
+        uint32_t idle = 0;
+        IMB_JOB *job;
+
+        while (!pool_load(&pool->stop)) {
+                IMB_JOB *app_job = pool_ring_pop(&worker->in);
+
+                if (app_job == NULL)
+                        app_job = pool_steal(worker);
+
+                if (app_job == NULL) {
+                        /*
+                         * Complete jobs held by the manager only once
+                         * input has been idle for a while, a flush on
+                         * every empty poll would process partially
+                         * filled lanes under steady load.
+                         */
+                        if (idle >= POOL_FLUSH_SPINS) {
+                                job = IMB_FLUSH_JOB(mgr);
+                                if (job != NULL) {
+                                        pool_complete(worker, job);
+                                        continue;
+                                }
+                        }
+                        if (++idle < POOL_IDLE_SPINS) {
+                                _mm_pause();
+                        } else {
+                                pool_yield();
+                                idle = POOL_FLUSH_SPINS;
+                        }
+                        continue;
+                }
+                idle = 0;
+
+                job = IMB_GET_NEXT_JOB(mgr);
+                worker->app_jobs[job - mgr->jobs] = app_job;
+                *job = *app_job;
+                job = IMB_SUBMIT_JOB(mgr);
+                while (job != NULL) {
+                        pool_complete(worker, job);
+                        job = IMB_GET_COMPLETED_JOB(mgr);
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mgr)) != NULL)
+                pool_complete(worker, job);
+}
+
+#ifdef LINUX
+static void *
+pool_worker_thread(void *arg)
+{
+        pool_worker_run((struct pool_worker *) arg);
+        return NULL;
+}
+#else
+static DWORD WINAPI
+pool_worker_thread(LPVOID arg)
+{
+        pool_worker_run((struct pool_worker *) arg);
+        return 0;
+}
+#endif
+
+/**
+ * @brief Frees worker pool, stopping its workers
+ *
+ * Jobs still queued or in progress are not returned to the application.
+ *
+ * @param pool pointer to worker pool
+ */
+void imb_pool_free(IMB_POOL *pool)
+{
+        uint32_t i;
+
+        if (pool == NULL)
+                return;
+
+        pool_store(&pool->stop, 1);
+        for (i = 0; i < pool->num_workers; i++) {
+                struct pool_worker *worker = pool->workers[i];
+
+                if (worker == NULL || !worker->started)
+                        continue;
+#ifdef LINUX
+                pthread_join(worker->thread, NULL);
+#else
+                WaitForSingleObject(worker->thread, INFINITE);
+                CloseHandle(worker->thread);
+#endif
+        }
+
+        /* workers steal from each other, free them once all stopped */
+        for (i = 0; i < pool->num_workers; i++) {
+                struct pool_worker *worker = pool->workers[i];
+
+                if (worker == NULL)
+                        continue;
+                if (worker->mgr != NULL)
+                        free_mb_mgr(worker->mgr);
+                pool_mem_free(worker->in.cells);
+                pool_mem_free(worker);
+        }
+        pool_mem_free(pool->done.cells);
+        pool_mem_free(pool);
+}
+
+/**
+ * @brief Allocates worker pool and starts its workers
+ *
+ * @param num_workers number of worker threads (max 64), each owning
+ *                    a multi-buffer manager
+ * @param flags multi-buffer manager flags (see alloc_mb_mgr())
+ * @param init_mgr manager init function, e.g. init_mb_mgr_avx512
+ * @param queue_size number of jobs that can be queued to each worker
+ *                   (rounded up to power of 2), completion queue holds
+ *                   jobs of all workers (queue_size * num_workers,
+ *                   up to 2^32)
+ *
+ * @return Pointer to worker pool
+ * @retval NULL on invalid parameters, allocation or thread creation error
+ */
+IMB_POOL *imb_pool_alloc(const uint32_t num_workers, const uint64_t flags,
+                         init_mb_mgr_t init_mgr, const uint32_t queue_size)
+{
+        IMB_POOL *pool;
+        uint32_t i;
+
+        if (num_workers == 0 || num_workers > POOL_MAX_WORKERS ||
+            init_mgr == NULL || queue_size == 0)
+                return NULL;
+
+        pool = pool_mem_alloc(sizeof(*pool));
+        if (pool == NULL)
+                return NULL;
+        pool->num_workers = num_workers;
+        if (pool_ring_init(&pool->done,
+                           (uint64_t) queue_size * num_workers) != 0)
+                goto exit_fail;
+
+        /* all workers have to exist before any of them can steal */
+        for (i = 0; i < num_workers; i++) {
+                struct pool_worker *worker = pool_mem_alloc(sizeof(*worker));
+
+                if (worker == NULL)
+                        goto exit_fail;
+                pool->workers[i] = worker;
+                worker->pool = pool;
+                worker->id = i;
+                if (pool_ring_init(&worker->in, queue_size) != 0)
+                        goto exit_fail;
+                worker->mgr = alloc_mb_mgr(flags);
+                if (worker->mgr == NULL)
+                        goto exit_fail;
+                init_mgr(worker->mgr);
+        }
+
+        for (i = 0; i < num_workers; i++) {
+                struct pool_worker *worker = pool->workers[i];
+
+#ifdef LINUX
+                if (pthread_create(&worker->thread, NULL, pool_worker_thread,
+                                   worker) != 0)
+                        goto exit_fail;
+#else
+                worker->thread = CreateThread(NULL, 0, pool_worker_thread,
+                                              worker, 0, NULL);
+                if (worker->thread == NULL)
+                        goto exit_fail;
+#endif
+                worker->started = 1;
+        }
+
+        return pool;
+
+exit_fail:
+        imb_pool_free(pool);
+        return NULL;
+}
+
+/**
+ * @brief Queues job to the worker selected by flow hint
+ *
+ * Job (and all data it points to) has to stay valid until it is
+ * returned by imb_pool_get_completed_job(). Idle workers can take
+ * queued jobs of other workers, so jobs of one flow can complete
+ * out of order.
+ *
+ * @param pool pointer to worker pool
+ * @param job job to process, filled like a job from IMB_GET_NEXT_JOB()
+ * @param flow_hint selects the worker (modulo number of workers)
+ *
+ * @return Operation status
+ * @retval 0 job queued
+ * @retval -1 worker queue full (get completed jobs and retry) or
+ *            invalid parameters
+ */
+int imb_pool_submit_job(IMB_POOL *pool, IMB_JOB *job, const uint32_t flow_hint)
+{
+#ifdef SAFE_PARAM
+        if (pool == NULL || job == NULL)
+                return -1;
+#endif
+        job->status = STS_BEING_PROCESSED;
+        return pool_ring_push(&pool->workers[flow_hint %
+                                             pool->num_workers]->in, job);
+}
+
+/**
+ * @brief Returns next completed job
+ *
+ * Job status is set by the worker (STS_COMPLETED on success).
+ *
+ * @param pool pointer to worker pool
+ *
+ * @return Pointer to job passed to imb_pool_submit_job()
+ * @retval NULL if no job has completed
+ */
+IMB_JOB *imb_pool_get_completed_job(IMB_POOL *pool)
+{
+#ifdef SAFE_PARAM
+        if (pool == NULL)
+                return NULL;
+#endif
+        return pool_ring_pop(&pool->done);
+}
+
+/**
+ * @brief Returns number of jobs a worker took from other workers' queues
+ *
+ * @param pool pointer to worker pool
+ * @param worker worker number
+ *
+ * @return Number of stolen jobs, 0 on invalid parameters
+ */
+uint64_t imb_pool_stolen_jobs(IMB_POOL *pool, const uint32_t worker)
+{
+        if (pool == NULL || worker >= pool->num_workers)
+                return 0;
+
+        return pool_load(&pool->workers[worker]->stolen);
+}
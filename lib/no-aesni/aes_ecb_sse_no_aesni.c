@@ -0,0 +1,45 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#define AES_ECB_128_ENC         aes_ecb_128_enc_sse_no_aesni
+#define AES_ECB_128_DEC         aes_ecb_128_dec_sse_no_aesni
+#define AES_ECB_192_ENC         aes_ecb_192_enc_sse_no_aesni
+#define AES_ECB_192_DEC         aes_ecb_192_dec_sse_no_aesni
+#define AES_ECB_256_ENC         aes_ecb_256_enc_sse_no_aesni
+#define AES_ECB_256_DEC         aes_ecb_256_dec_sse_no_aesni
+#define AES_ECB_ENC_128         aes_ecb_enc_128_sse_no_aesni
+#define AES_ECB_DEC_128         aes_ecb_dec_128_sse_no_aesni
+#define AES_ECB_ENC_192         aes_ecb_enc_192_sse_no_aesni
+#define AES_ECB_DEC_192         aes_ecb_dec_192_sse_no_aesni
+#define AES_ECB_ENC_256         aes_ecb_enc_256_sse_no_aesni
+#define AES_ECB_DEC_256         aes_ecb_dec_256_sse_no_aesni
+#define SAVE_XMMS               save_xmms
+#define RESTORE_XMMS            restore_xmms
+#define CLEAR_SCRATCH_SIMD_REGS clear_scratch_xmms_sse
+
+#include "include/noaesni.h"
+#include "include/aes_ecb_common.h"
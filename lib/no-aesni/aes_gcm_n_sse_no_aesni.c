@@ -0,0 +1,204 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include "intel-ipsec-mb.h"
+#include "include/gcm.h"
+
+/*
+ * No AESNI: messages are processed one at a time
+ * with the single message GCM implementation
+ */
+
+#ifdef SAFE_PARAM
+/**
+ * @brief Checks parameters of all messages
+ *
+ * @return 0 - invalid parameters, 1 - parameters are valid
+ */
+static int
+aes_gcm_n_check(const struct gcm_key_data * const key_data[],
+                struct gcm_context_data * const ctx[],
+                uint8_t * const out[], const uint8_t * const in[],
+                const uint64_t len[], const uint8_t * const iv[],
+                const uint8_t * const aad[], const uint64_t aad_len[],
+                uint8_t * const tag[])
+{
+        return !(key_data == NULL || ctx == NULL || out == NULL ||
+                 in == NULL || len == NULL || iv == NULL || aad == NULL ||
+                 aad_len == NULL || tag == NULL);
+}
+#endif
+
+void
+aes_gcm_enc_128_n_sse_no_aesni(const struct gcm_key_data * const key_data[],
+                               struct gcm_context_data * const ctx[],
+                               uint8_t * const out[],
+                               const uint8_t * const in[],
+                               const uint64_t len[],
+                               const uint8_t * const iv[],
+                               const uint8_t * const aad[],
+                               const uint64_t aad_len[],
+                               uint8_t * const tag[], const uint64_t tag_len,
+                               const uint32_t num_msgs)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (!aes_gcm_n_check(key_data, ctx, out, in, len, iv, aad, aad_len,
+                             tag))
+                return;
+#endif
+        for (i = 0; i < num_msgs; i++)
+                aes_gcm_enc_128_sse_no_aesni(key_data[i], ctx[i], out[i],
+                                             in[i], len[i], iv[i], aad[i],
+                                             aad_len[i], tag[i], tag_len);
+}
+
+void
+aes_gcm_dec_128_n_sse_no_aesni(const struct gcm_key_data * const key_data[],
+                               struct gcm_context_data * const ctx[],
+                               uint8_t * const out[],
+                               const uint8_t * const in[],
+                               const uint64_t len[],
+                               const uint8_t * const iv[],
+                               const uint8_t * const aad[],
+                               const uint64_t aad_len[],
+                               uint8_t * const tag[], const uint64_t tag_len,
+                               const uint32_t num_msgs)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (!aes_gcm_n_check(key_data, ctx, out, in, len, iv, aad, aad_len,
+                             tag))
+                return;
+#endif
+        for (i = 0; i < num_msgs; i++)
+                aes_gcm_dec_128_sse_no_aesni(key_data[i], ctx[i], out[i],
+                                             in[i], len[i], iv[i], aad[i],
+                                             aad_len[i], tag[i], tag_len);
+}
+
+void
+aes_gcm_enc_192_n_sse_no_aesni(const struct gcm_key_data * const key_data[],
+                               struct gcm_context_data * const ctx[],
+                               uint8_t * const out[],
+                               const uint8_t * const in[],
+                               const uint64_t len[],
+                               const uint8_t * const iv[],
+                               const uint8_t * const aad[],
+                               const uint64_t aad_len[],
+                               uint8_t * const tag[], const uint64_t tag_len,
+                               const uint32_t num_msgs)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (!aes_gcm_n_check(key_data, ctx, out, in, len, iv, aad, aad_len,
+                             tag))
+                return;
+#endif
+        for (i = 0; i < num_msgs; i++)
+                aes_gcm_enc_192_sse_no_aesni(key_data[i], ctx[i], out[i],
+                                             in[i], len[i], iv[i], aad[i],
+                                             aad_len[i], tag[i], tag_len);
+}
+
+void
+aes_gcm_dec_192_n_sse_no_aesni(const struct gcm_key_data * const key_data[],
+                               struct gcm_context_data * const ctx[],
+                               uint8_t * const out[],
+                               const uint8_t * const in[],
+                               const uint64_t len[],
+                               const uint8_t * const iv[],
+                               const uint8_t * const aad[],
+                               const uint64_t aad_len[],
+                               uint8_t * const tag[], const uint64_t tag_len,
+                               const uint32_t num_msgs)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (!aes_gcm_n_check(key_data, ctx, out, in, len, iv, aad, aad_len,
+                             tag))
+                return;
+#endif
+        for (i = 0; i < num_msgs; i++)
+                aes_gcm_dec_192_sse_no_aesni(key_data[i], ctx[i], out[i],
+                                             in[i], len[i], iv[i], aad[i],
+                                             aad_len[i], tag[i], tag_len);
+}
+
+void
+aes_gcm_enc_256_n_sse_no_aesni(const struct gcm_key_data * const key_data[],
+                               struct gcm_context_data * const ctx[],
+                               uint8_t * const out[],
+                               const uint8_t * const in[],
+                               const uint64_t len[],
+                               const uint8_t * const iv[],
+                               const uint8_t * const aad[],
+                               const uint64_t aad_len[],
+                               uint8_t * const tag[], const uint64_t tag_len,
+                               const uint32_t num_msgs)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (!aes_gcm_n_check(key_data, ctx, out, in, len, iv, aad, aad_len,
+                             tag))
+                return;
+#endif
+        for (i = 0; i < num_msgs; i++)
+                aes_gcm_enc_256_sse_no_aesni(key_data[i], ctx[i], out[i],
+                                             in[i], len[i], iv[i], aad[i],
+                                             aad_len[i], tag[i], tag_len);
+}
+
+void
+aes_gcm_dec_256_n_sse_no_aesni(const struct gcm_key_data * const key_data[],
+                               struct gcm_context_data * const ctx[],
+                               uint8_t * const out[],
+                               const uint8_t * const in[],
+                               const uint64_t len[],
+                               const uint8_t * const iv[],
+                               const uint8_t * const aad[],
+                               const uint64_t aad_len[],
+                               uint8_t * const tag[], const uint64_t tag_len,
+                               const uint32_t num_msgs)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (!aes_gcm_n_check(key_data, ctx, out, in, len, iv, aad, aad_len,
+                             tag))
+                return;
+#endif
+        for (i = 0; i < num_msgs; i++)
+                aes_gcm_dec_256_sse_no_aesni(key_data[i], ctx[i], out[i],
+                                             in[i], len[i], iv[i], aad[i],
+                                             aad_len[i], tag[i], tag_len);
+}
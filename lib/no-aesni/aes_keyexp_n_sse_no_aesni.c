@@ -0,0 +1,146 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include "intel-ipsec-mb.h"
+#include "include/gcm.h"
+#include "include/noaesni.h"
+
+/*
+ * No AESNI: keys are expanded one at a time with
+ * the emulated AESKEYGENASSIST implementation
+ */
+
+void
+aes_keyexp_128_n_sse_no_aesni(const void * const keys[],
+                              void * const enc_exp_keys[],
+                              void * const dec_exp_keys[],
+                              const uint32_t num_keys)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (keys == NULL || enc_exp_keys == NULL)
+                return;
+#endif
+        for (i = 0; i < num_keys; i++) {
+                if (dec_exp_keys != NULL)
+                        aes_keyexp_128_sse_no_aesni(keys[i], enc_exp_keys[i],
+                                                    dec_exp_keys[i]);
+                else
+                        aes_keyexp_128_enc_sse_no_aesni(keys[i],
+                                                        enc_exp_keys[i]);
+        }
+}
+
+void
+aes_keyexp_192_n_sse_no_aesni(const void * const keys[],
+                              void * const enc_exp_keys[],
+                              void * const dec_exp_keys[],
+                              const uint32_t num_keys)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (keys == NULL || enc_exp_keys == NULL)
+                return;
+#endif
+        for (i = 0; i < num_keys; i++) {
+                if (dec_exp_keys != NULL)
+                        aes_keyexp_192_sse_no_aesni(keys[i], enc_exp_keys[i],
+                                                    dec_exp_keys[i]);
+                else
+                        aes_keyexp_192_enc_sse_no_aesni(keys[i],
+                                                        enc_exp_keys[i]);
+        }
+}
+
+void
+aes_keyexp_256_n_sse_no_aesni(const void * const keys[],
+                              void * const enc_exp_keys[],
+                              void * const dec_exp_keys[],
+                              const uint32_t num_keys)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (keys == NULL || enc_exp_keys == NULL)
+                return;
+#endif
+        for (i = 0; i < num_keys; i++) {
+                if (dec_exp_keys != NULL)
+                        aes_keyexp_256_sse_no_aesni(keys[i], enc_exp_keys[i],
+                                                    dec_exp_keys[i]);
+                else
+                        aes_keyexp_256_enc_sse_no_aesni(keys[i],
+                                                        enc_exp_keys[i]);
+        }
+}
+
+void
+aes_gcm_pre_128_n_sse_no_aesni(const void * const keys[],
+                               struct gcm_key_data * const key_data[],
+                               const uint32_t num_keys)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (keys == NULL || key_data == NULL)
+                return;
+#endif
+        for (i = 0; i < num_keys; i++)
+                aes_gcm_pre_128_sse_no_aesni(keys[i], key_data[i]);
+}
+
+void
+aes_gcm_pre_192_n_sse_no_aesni(const void * const keys[],
+                               struct gcm_key_data * const key_data[],
+                               const uint32_t num_keys)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (keys == NULL || key_data == NULL)
+                return;
+#endif
+        for (i = 0; i < num_keys; i++)
+                aes_gcm_pre_192_sse_no_aesni(keys[i], key_data[i]);
+}
+
+void
+aes_gcm_pre_256_n_sse_no_aesni(const void * const keys[],
+                               struct gcm_key_data * const key_data[],
+                               const uint32_t num_keys)
+{
+        uint32_t i;
+
+#ifdef SAFE_PARAM
+        if (keys == NULL || key_data == NULL)
+                return;
+#endif
+        for (i = 0; i < num_keys; i++)
+                aes_gcm_pre_256_sse_no_aesni(keys[i], key_data[i]);
+}
@@ -36,6 +36,7 @@
 #include "include/kasumi_internal.h"
 #include "include/zuc_internal.h"
 #include "include/snow3g.h"
+#include "include/crc.h"
 
 #include "save_xmms.h"
 #include "asm.h"
@@ -165,6 +166,8 @@ uint64_t hec_64_sse_no_aesni(const uint8_t *in);
 #define SUBMIT_JOB_ZUC_EIA3   submit_job_zuc_eia3_sse_no_aesni
 #define FLUSH_JOB_ZUC_EIA3    flush_job_zuc_eia3_sse_no_aesni
 
+#define SNOW3G_F8_F9_1_BUFFER snow3g_f8_f9_1_buffer_sse_no_aesni
+
 #define AES_CBC_DEC_128       aes_cbc_dec_128_sse_no_aesni
 #define AES_CBC_DEC_192       aes_cbc_dec_192_sse_no_aesni
 #define AES_CBC_DEC_256       aes_cbc_dec_256_sse_no_aesni
@@ -183,6 +186,15 @@ uint64_t hec_64_sse_no_aesni(const uint8_t *in);
 #define AES_ECB_DEC_192       aes_ecb_dec_192_sse_no_aesni
 #define AES_ECB_DEC_256       aes_ecb_dec_256_sse_no_aesni
 
+#define SHA1_BLOCK_UPDATE     sha1_block_sse
+#define SHA256_BLOCK_UPDATE   sha256_block_sse
+#define SHA512_BLOCK_UPDATE   sha512_block_sse
+
+#define AES_XTS_128_ENC       aes_xts_128_enc_sse_no_aesni
+#define AES_XTS_128_DEC       aes_xts_128_dec_sse_no_aesni
+#define AES_XTS_256_ENC       aes_xts_256_enc_sse_no_aesni
+#define AES_XTS_256_DEC       aes_xts_256_dec_sse_no_aesni
+
 #define SUBMIT_JOB_PON_ENC        submit_job_pon_enc_sse_no_aesni
 #define SUBMIT_JOB_PON_DEC        submit_job_pon_dec_sse_no_aesni
 #define SUBMIT_JOB_PON_ENC_NO_CTR submit_job_pon_enc_no_ctr_sse_no_aesni
@@ -219,6 +231,7 @@ uint64_t hec_64_sse_no_aesni(const uint8_t *in);
 #define SUBMIT_JOB_AES192_DEC submit_job_aes192_dec_sse_no_aesni
 #define SUBMIT_JOB_AES256_DEC submit_job_aes256_dec_sse_no_aesni
 #define QUEUE_SIZE queue_size_sse_no_aesni
+#define CLEAR_SCRATCH clear_scratch_sse_no_aesni
 
 /* ====================================================================== */
 
@@ -234,8 +247,17 @@ uint64_t hec_64_sse_no_aesni(const uint8_t *in);
 #define AES_CFB_256_ONE    aes_cfb_256_one_sse_no_aesni
 
 void aes128_cbc_mac_x4_no_aesni(AES_ARGS *args, uint64_t len);
+void aes256_cbc_mac_x4_no_aesni(AES_ARGS *args, uint64_t len);
+void aes_cbc_enc_128_x4_no_aesni(AES_ARGS *args, uint64_t len);
+void aes_cbc_enc_192_x4_no_aesni(AES_ARGS *args, uint64_t len);
+void aes_cbc_enc_256_x4_no_aesni(AES_ARGS *args, uint64_t len);
 
 #define AES128_CBC_MAC     aes128_cbc_mac_x4_no_aesni
+#define AES256_CBC_MAC     aes256_cbc_mac_x4_no_aesni
+
+#define AES_CBC_ENC_128_X  aes_cbc_enc_128_x4_no_aesni
+#define AES_CBC_ENC_192_X  aes_cbc_enc_192_x4_no_aesni
+#define AES_CBC_ENC_256_X  aes_cbc_enc_256_x4_no_aesni
 
 #define FLUSH_JOB_AES128_CCM_AUTH     flush_job_aes128_ccm_auth_sse_no_aesni
 #define SUBMIT_JOB_AES128_CCM_AUTH    submit_job_aes128_ccm_auth_sse_no_aesni
@@ -455,6 +477,11 @@ init_mb_mgr_sse_no_aesni(IMB_MGR *state)
         MB_MGR_CMAC_OOO *aes_cmac_ooo = state->aes_cmac_ooo;
         MB_MGR_ZUC_OOO *zuc_eea3_ooo = state->zuc_eea3_ooo;
         MB_MGR_ZUC_OOO *zuc_eia3_ooo = state->zuc_eia3_ooo;
+        MB_MGR_SGL_OOO *aes128_cbc_sgl_ooo = state->aes128_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes192_cbc_sgl_ooo = state->aes192_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes256_cbc_sgl_ooo = state->aes256_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes128_ccm_sgl_ooo = state->aes128_ccm_sgl_ooo;
+        MB_MGR_SGL_OOO *aes256_ccm_sgl_ooo = state->aes256_ccm_sgl_ooo;
 
         /* Init AES out-of-order fields */
         memset(aes128_ooo->lens, 0xFF,
@@ -761,9 +788,42 @@ init_mb_mgr_sse_no_aesni(IMB_MGR *state)
         aes_cmac_ooo->unused_lanes = 0xF3210;
         aes_cmac_ooo->num_lanes_inuse = 0;
 
+        /* Init SGL AES-CBC encrypt and AES-CCM out-of-order fields */
+        memset(aes128_cbc_sgl_ooo->job_in_lane, 0,
+               sizeof(aes128_cbc_sgl_ooo->job_in_lane));
+        aes128_cbc_sgl_ooo->unused_lanes = 0xF3210;
+        aes128_cbc_sgl_ooo->num_lanes = 4;
+        aes128_cbc_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes192_cbc_sgl_ooo->job_in_lane, 0,
+               sizeof(aes192_cbc_sgl_ooo->job_in_lane));
+        aes192_cbc_sgl_ooo->unused_lanes = 0xF3210;
+        aes192_cbc_sgl_ooo->num_lanes = 4;
+        aes192_cbc_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes256_cbc_sgl_ooo->job_in_lane, 0,
+               sizeof(aes256_cbc_sgl_ooo->job_in_lane));
+        aes256_cbc_sgl_ooo->unused_lanes = 0xF3210;
+        aes256_cbc_sgl_ooo->num_lanes = 4;
+        aes256_cbc_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes128_ccm_sgl_ooo->job_in_lane, 0,
+               sizeof(aes128_ccm_sgl_ooo->job_in_lane));
+        aes128_ccm_sgl_ooo->unused_lanes = 0xF3210;
+        aes128_ccm_sgl_ooo->num_lanes = 4;
+        aes128_ccm_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes256_ccm_sgl_ooo->job_in_lane, 0,
+               sizeof(aes256_ccm_sgl_ooo->job_in_lane));
+        aes256_ccm_sgl_ooo->unused_lanes = 0xF3210;
+        aes256_ccm_sgl_ooo->num_lanes = 4;
+        aes256_ccm_sgl_ooo->num_lanes_inuse = 0;
+
         /* Init "in order" components */
         state->next_job = 0;
         state->earliest_job = -1;
+        state->completion_cb = NULL;
+        state->completion_cb_arg = NULL;
 
         /* set SSE NO AESNI handlers */
         state->get_next_job        = get_next_job_sse_no_aesni;
@@ -772,6 +832,7 @@ init_mb_mgr_sse_no_aesni(IMB_MGR *state)
         state->get_completed_job   = get_completed_job_sse_no_aesni;
         state->flush_job           = flush_job_sse_no_aesni;
         state->queue_size          = queue_size_sse_no_aesni;
+        state->clear_scratch       = clear_scratch_sse_no_aesni;
         state->keyexp_128          = aes_keyexp_128_sse_no_aesni;
         state->keyexp_192          = aes_keyexp_192_sse_no_aesni;
         state->keyexp_256          = aes_keyexp_256_sse_no_aesni;
@@ -791,6 +852,19 @@ init_mb_mgr_sse_no_aesni(IMB_MGR *state)
         state->sha512              = sha512_sse;
         state->md5_one_block       = md5_one_block_sse;
         state->aes128_cfb_one      = aes_cfb_128_one_sse_no_aesni;
+        state->aes128_xts_enc      = aes_xts_128_enc_sse_no_aesni;
+        state->aes128_xts_dec      = aes_xts_128_dec_sse_no_aesni;
+        state->aes256_xts_enc      = aes_xts_256_enc_sse_no_aesni;
+        state->aes256_xts_dec      = aes_xts_256_dec_sse_no_aesni;
+        state->aes128_ecb_enc      = aes_ecb_128_enc_sse_no_aesni;
+        state->aes128_ecb_dec      = aes_ecb_128_dec_sse_no_aesni;
+        state->aes192_ecb_enc      = aes_ecb_192_enc_sse_no_aesni;
+        state->aes192_ecb_dec      = aes_ecb_192_dec_sse_no_aesni;
+        state->aes256_ecb_enc      = aes_ecb_256_enc_sse_no_aesni;
+        state->aes256_ecb_dec      = aes_ecb_256_dec_sse_no_aesni;
+        state->keyexp_128_n        = aes_keyexp_128_n_sse_no_aesni;
+        state->keyexp_192_n        = aes_keyexp_192_n_sse_no_aesni;
+        state->keyexp_256_n        = aes_keyexp_256_n_sse_no_aesni;
 
         state->eea3_1_buffer       = zuc_eea3_1_buffer_sse_no_aesni;
         state->eea3_4_buffer       = zuc_eea3_4_buffer_sse_no_aesni;
@@ -854,6 +928,36 @@ init_mb_mgr_sse_no_aesni(IMB_MGR *state)
         state->gcm128_pre          = aes_gcm_pre_128_sse_no_aesni;
         state->gcm192_pre          = aes_gcm_pre_192_sse_no_aesni;
         state->gcm256_pre          = aes_gcm_pre_256_sse_no_aesni;
+        state->gcm128_pre_n        = aes_gcm_pre_128_n_sse_no_aesni;
+        state->gcm192_pre_n        = aes_gcm_pre_192_n_sse_no_aesni;
+        state->gcm256_pre_n        = aes_gcm_pre_256_n_sse_no_aesni;
+        state->gcm128_enc_n        = aes_gcm_enc_128_n_sse_no_aesni;
+        state->gcm192_enc_n        = aes_gcm_enc_192_n_sse_no_aesni;
+        state->gcm256_enc_n        = aes_gcm_enc_256_n_sse_no_aesni;
+        state->gcm128_dec_n        = aes_gcm_dec_128_n_sse_no_aesni;
+        state->gcm192_dec_n        = aes_gcm_dec_192_n_sse_no_aesni;
+        state->gcm256_dec_n        = aes_gcm_dec_256_n_sse_no_aesni;
+        state->gcm128_pre_compact = aes_gcm_pre_compact_128_sse_no_aesni;
+        state->gcm192_pre_compact = aes_gcm_pre_compact_192_sse_no_aesni;
+        state->gcm256_pre_compact = aes_gcm_pre_compact_256_sse_no_aesni;
+        state->gcm128_expand_compact =
+                aes_gcm_expand_compact_128_sse_no_aesni;
+        state->gcm192_expand_compact =
+                aes_gcm_expand_compact_192_sse_no_aesni;
+        state->gcm256_expand_compact =
+                aes_gcm_expand_compact_256_sse_no_aesni;
+        state->gcm128_enc_compact =
+                aes_gcm_enc_compact_128_sse_no_aesni;
+        state->gcm192_enc_compact =
+                aes_gcm_enc_compact_192_sse_no_aesni;
+        state->gcm256_enc_compact =
+                aes_gcm_enc_compact_256_sse_no_aesni;
+        state->gcm128_dec_compact =
+                aes_gcm_dec_compact_128_sse_no_aesni;
+        state->gcm192_dec_compact =
+                aes_gcm_dec_compact_192_sse_no_aesni;
+        state->gcm256_dec_compact =
+                aes_gcm_dec_compact_256_sse_no_aesni;
         state->ghash               = ghash_sse_no_aesni;
 
         state->gmac128_init        = imb_aes_gmac_init_128_sse_no_aesni;
@@ -868,6 +972,17 @@ init_mb_mgr_sse_no_aesni(IMB_MGR *state)
 
         state->hec_32              = hec_32_sse_no_aesni;
         state->hec_64              = hec_64_sse_no_aesni;
+
+        state->crc32_ethernet_fcs = crc32_ethernet_fcs_sse_no_aesni;
+        state->crc32_sctp         = crc32_sctp_sse_no_aesni;
+        state->crc16_x25          = crc16_x25_sse_no_aesni;
+        state->crc24_lte_a        = crc24_lte_a_sse_no_aesni;
+        state->crc24_lte_b        = crc24_lte_b_sse_no_aesni;
+        state->crc16_fp_data      = crc16_fp_data_sse_no_aesni;
+        state->crc11_fp_header    = crc11_fp_header_sse_no_aesni;
+        state->crc7_fp_header     = crc7_fp_header_sse_no_aesni;
+        state->crc10_iuup_data    = crc10_iuup_data_sse_no_aesni;
+        state->crc6_iuup_header   = crc6_iuup_header_sse_no_aesni;
 }
 
 #include "mb_mgr_code.h"
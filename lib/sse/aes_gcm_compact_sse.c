@@ -0,0 +1,51 @@
+/*******************************************************************************
+  Copyright (c) 2020, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#define AES_GCM_PRE_COMPACT_128    aes_gcm_pre_compact_128_sse
+#define AES_GCM_PRE_COMPACT_192    aes_gcm_pre_compact_192_sse
+#define AES_GCM_PRE_COMPACT_256    aes_gcm_pre_compact_256_sse
+#define AES_GCM_EXPAND_COMPACT_128 aes_gcm_expand_compact_128_sse
+#define AES_GCM_EXPAND_COMPACT_192 aes_gcm_expand_compact_192_sse
+#define AES_GCM_EXPAND_COMPACT_256 aes_gcm_expand_compact_256_sse
+#define AES_GCM_ENC_COMPACT_128    aes_gcm_enc_compact_128_sse
+#define AES_GCM_ENC_COMPACT_192    aes_gcm_enc_compact_192_sse
+#define AES_GCM_ENC_COMPACT_256    aes_gcm_enc_compact_256_sse
+#define AES_GCM_DEC_COMPACT_128    aes_gcm_dec_compact_128_sse
+#define AES_GCM_DEC_COMPACT_192    aes_gcm_dec_compact_192_sse
+#define AES_GCM_DEC_COMPACT_256    aes_gcm_dec_compact_256_sse
+#define GCM_PRE_128                aes_gcm_pre_128_sse
+#define GCM_PRE_192                aes_gcm_pre_192_sse
+#define GCM_PRE_256                aes_gcm_pre_256_sse
+#define GCM_ENC_128                aes_gcm_enc_128_sse
+#define GCM_ENC_192                aes_gcm_enc_192_sse
+#define GCM_ENC_256                aes_gcm_enc_256_sse
+#define GCM_DEC_128                aes_gcm_dec_128_sse
+#define GCM_DEC_192                aes_gcm_dec_192_sse
+#define GCM_DEC_256                aes_gcm_dec_256_sse
+#define GCM_KEYS_SSE_AVX
+
+#include "include/aes_gcm_compact_common.h"
@@ -37,6 +37,7 @@
 #include "include/zuc_internal.h"
 #include "include/snow3g.h"
 #include "include/gcm.h"
+#include "include/crc.h"
 
 #include "save_xmms.h"
 #include "asm.h"
@@ -68,6 +69,19 @@ IMB_JOB *submit_job_aes256_enc_x8_sse(MB_MGR_AES_OOO *state,
                                            IMB_JOB *job);
 IMB_JOB *flush_job_aes256_enc_x8_sse(MB_MGR_AES_OOO *state);
 
+IMB_JOB *submit_job_aes128_cfb_enc_sse(MB_MGR_AES_OOO *state,
+                                      IMB_JOB *job);
+IMB_JOB *flush_job_aes128_cfb_enc_sse(MB_MGR_AES_OOO *state);
+
+IMB_JOB *submit_job_aes256_cfb_enc_sse(MB_MGR_AES_OOO *state,
+                                      IMB_JOB *job);
+IMB_JOB *flush_job_aes256_cfb_enc_sse(MB_MGR_AES_OOO *state);
+
+void aes_cfb_dec_128_by8_sse(const void *in, const uint8_t *IV,
+                             const void *keys, void *out, uint64_t len_bytes);
+void aes_cfb_dec_256_by8_sse(const void *in, const uint8_t *IV,
+                             const void *keys, void *out, uint64_t len_bytes);
+
 IMB_JOB *submit_job_hmac_sse(MB_MGR_HMAC_SHA_1_OOO *state,
                                   IMB_JOB *job);
 IMB_JOB *flush_job_hmac_sse(MB_MGR_HMAC_SHA_1_OOO *state);
@@ -139,6 +153,30 @@ IMB_JOB *flush_job_aes128_ccm_auth_sse(MB_MGR_CCM_OOO *state);
 
 IMB_JOB *flush_job_aes256_ccm_auth_sse(MB_MGR_CCM_OOO *state);
 
+IMB_JOB *submit_job_aes128_ccm_ctr_mac_sse(MB_MGR_CCM_CTR_MAC_OOO *state,
+                                           IMB_JOB *job);
+
+IMB_JOB *flush_job_aes128_ccm_ctr_mac_sse(MB_MGR_CCM_CTR_MAC_OOO *state);
+
+IMB_JOB *submit_job_aes256_ccm_ctr_mac_sse(MB_MGR_CCM_CTR_MAC_OOO *state,
+                                           IMB_JOB *job);
+
+IMB_JOB *flush_job_aes256_ccm_ctr_mac_sse(MB_MGR_CCM_CTR_MAC_OOO *state);
+
+IMB_JOB *submit_job_docsis128_crc32_x4_sse(MB_MGR_DOCSIS_CRC32_OOO *state,
+                                           IMB_JOB *job);
+
+IMB_JOB *flush_job_docsis128_crc32_x4_sse(MB_MGR_DOCSIS_CRC32_OOO *state);
+
+IMB_JOB *submit_job_docsis256_crc32_x4_sse(MB_MGR_DOCSIS_CRC32_OOO *state,
+                                           IMB_JOB *job);
+
+IMB_JOB *flush_job_docsis256_crc32_x4_sse(MB_MGR_DOCSIS_CRC32_OOO *state);
+
+IMB_JOB *docsis128_crc32_dec_sse(IMB_JOB *job);
+
+IMB_JOB *docsis256_crc32_dec_sse(IMB_JOB *job);
+
 IMB_JOB *submit_job_aes128_ccm_auth_x8_sse(MB_MGR_CCM_OOO *state,
                                            IMB_JOB *job);
 
@@ -169,8 +207,40 @@ IMB_JOB *submit_job_zuc_eia3_gfni_sse(MB_MGR_ZUC_OOO *state,
                                         IMB_JOB *job);
 IMB_JOB *flush_job_zuc_eia3_gfni_sse(MB_MGR_ZUC_OOO *state);
 
+IMB_JOB *submit_job_zuc_eea3_eia3_no_gfni_sse(MB_MGR_ZUC_EEA3_EIA3_OOO *state,
+                                              IMB_JOB *job);
+IMB_JOB *flush_job_zuc_eea3_eia3_no_gfni_sse(MB_MGR_ZUC_EEA3_EIA3_OOO *state);
+
+IMB_JOB *submit_job_zuc_eea3_eia3_gfni_sse(MB_MGR_ZUC_EEA3_EIA3_OOO *state,
+                                           IMB_JOB *job);
+IMB_JOB *flush_job_zuc_eea3_eia3_gfni_sse(MB_MGR_ZUC_EEA3_EIA3_OOO *state);
+
 void aes_cmac_256_subkey_gen_sse(const void *key_exp,
                                  void *key1, void *key2);
+IMB_JOB *submit_job_des_cbc_enc_sse(MB_MGR_DES_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_des_cbc_enc_sse(MB_MGR_DES_OOO *state);
+
+IMB_JOB *submit_job_des_cbc_dec_sse(MB_MGR_DES_OOO *state,
+                                    IMB_JOB *job);
+IMB_JOB *flush_job_des_cbc_dec_sse(MB_MGR_DES_OOO *state);
+
+IMB_JOB *submit_job_3des_cbc_enc_sse(MB_MGR_DES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_3des_cbc_enc_sse(MB_MGR_DES_OOO *state);
+
+IMB_JOB *submit_job_3des_cbc_dec_sse(MB_MGR_DES_OOO *state,
+                                     IMB_JOB *job);
+IMB_JOB *flush_job_3des_cbc_dec_sse(MB_MGR_DES_OOO *state);
+
+IMB_JOB *submit_job_docsis_des_enc_sse(MB_MGR_DES_OOO *state,
+                                       IMB_JOB *job);
+IMB_JOB *flush_job_docsis_des_enc_sse(MB_MGR_DES_OOO *state);
+
+IMB_JOB *submit_job_docsis_des_dec_sse(MB_MGR_DES_OOO *state,
+                                       IMB_JOB *job);
+IMB_JOB *flush_job_docsis_des_dec_sse(MB_MGR_DES_OOO *state);
+
 uint32_t hec_32_sse(const uint8_t *in);
 uint64_t hec_64_sse(const uint8_t *in);
 
@@ -186,6 +256,10 @@ uint64_t hec_64_sse(const uint8_t *in);
 #define SUBMIT_JOB_AES256_ENC submit_job_aes256_enc_ptr
 #define SUBMIT_JOB_AES256_DEC submit_job_aes256_dec_sse
 #define FLUSH_JOB_AES256_ENC  flush_job_aes256_enc_ptr
+#define SUBMIT_JOB_AES128_CFB_ENC submit_job_aes128_cfb_enc_sse
+#define FLUSH_JOB_AES128_CFB_ENC  flush_job_aes128_cfb_enc_sse
+#define SUBMIT_JOB_AES256_CFB_ENC submit_job_aes256_cfb_enc_sse
+#define FLUSH_JOB_AES256_CFB_ENC  flush_job_aes256_cfb_enc_sse
 #define SUBMIT_JOB_AES_ECB_128_ENC submit_job_aes_ecb_128_enc_sse
 #define SUBMIT_JOB_AES_ECB_128_DEC submit_job_aes_ecb_128_dec_sse
 #define SUBMIT_JOB_AES_ECB_192_ENC submit_job_aes_ecb_192_enc_sse
@@ -213,6 +287,24 @@ uint64_t hec_64_sse(const uint8_t *in);
 #define SUBMIT_JOB_AES_XCBC   submit_job_aes_xcbc_sse
 #define FLUSH_JOB_AES_XCBC    flush_job_aes_xcbc_sse
 
+#define SUBMIT_JOB_DES_CBC_ENC submit_job_des_cbc_enc_sse
+#define FLUSH_JOB_DES_CBC_ENC  flush_job_des_cbc_enc_sse
+
+#define SUBMIT_JOB_DES_CBC_DEC submit_job_des_cbc_dec_sse
+#define FLUSH_JOB_DES_CBC_DEC  flush_job_des_cbc_dec_sse
+
+#define SUBMIT_JOB_3DES_CBC_ENC submit_job_3des_cbc_enc_sse
+#define FLUSH_JOB_3DES_CBC_ENC  flush_job_3des_cbc_enc_sse
+
+#define SUBMIT_JOB_3DES_CBC_DEC submit_job_3des_cbc_dec_sse
+#define FLUSH_JOB_3DES_CBC_DEC  flush_job_3des_cbc_dec_sse
+
+#define SUBMIT_JOB_DOCSIS_DES_ENC submit_job_docsis_des_enc_sse
+#define FLUSH_JOB_DOCSIS_DES_ENC  flush_job_docsis_des_enc_sse
+
+#define SUBMIT_JOB_DOCSIS_DES_DEC submit_job_docsis_des_dec_sse
+#define FLUSH_JOB_DOCSIS_DES_DEC  flush_job_docsis_des_dec_sse
+
 #define SUBMIT_JOB_AES_CNTR   submit_job_aes_cntr_sse
 #define SUBMIT_JOB_AES_CNTR_BIT   submit_job_aes_cntr_bit_sse
 
@@ -220,10 +312,16 @@ uint64_t hec_64_sse(const uint8_t *in);
 #define FLUSH_JOB_ZUC_EEA3    flush_job_zuc_eea3_sse
 #define SUBMIT_JOB_ZUC_EIA3   submit_job_zuc_eia3_sse
 #define FLUSH_JOB_ZUC_EIA3    flush_job_zuc_eia3_sse
+#define SUBMIT_JOB_ZUC_EEA3_EIA3 submit_job_zuc_eea3_eia3_sse
+#define FLUSH_JOB_ZUC_EEA3_EIA3  flush_job_zuc_eea3_eia3_sse
+
+#define SNOW3G_F8_F9_1_BUFFER snow3g_f8_f9_1_buffer_sse
 
 #define AES_CBC_DEC_128       aes128_cbc_dec_ptr
 #define AES_CBC_DEC_192       aes192_cbc_dec_ptr
 #define AES_CBC_DEC_256       aes256_cbc_dec_ptr
+#define AES_CFB_DEC_128       aes_cfb_dec_128_by8_sse
+#define AES_CFB_DEC_256       aes_cfb_dec_256_by8_sse
 
 #define AES_CNTR_128       aes_cntr_128_sse
 #define AES_CNTR_192       aes_cntr_192_sse
@@ -239,6 +337,21 @@ uint64_t hec_64_sse(const uint8_t *in);
 #define AES_ECB_DEC_192       aes_ecb_dec_192_sse
 #define AES_ECB_DEC_256       aes_ecb_dec_256_sse
 
+#define AES_CBC_ENC_128_X     aes_cbc_enc_128_x_ptr
+#define AES_CBC_ENC_192_X     aes_cbc_enc_192_x_ptr
+#define AES_CBC_ENC_256_X     aes_cbc_enc_256_x_ptr
+#define AES128_CBC_MAC        aes128_cbc_mac_x_ptr
+#define AES256_CBC_MAC        aes256_cbc_mac_x_ptr
+
+#define SHA1_BLOCK_UPDATE     sha1_block_sse
+#define SHA256_BLOCK_UPDATE   sha256_block_sse
+#define SHA512_BLOCK_UPDATE   sha512_block_sse
+
+#define AES_XTS_128_ENC       aes_xts_128_enc_sse
+#define AES_XTS_128_DEC       aes_xts_128_dec_sse
+#define AES_XTS_256_ENC       aes_xts_256_enc_sse
+#define AES_XTS_256_DEC       aes_xts_256_dec_sse
+
 #define SUBMIT_JOB_PON_ENC        submit_job_pon_enc_sse
 #define SUBMIT_JOB_PON_DEC        submit_job_pon_dec_sse
 #define SUBMIT_JOB_PON_ENC_NO_CTR submit_job_pon_enc_no_ctr_sse
@@ -275,6 +388,7 @@ uint64_t hec_64_sse(const uint8_t *in);
 #define SUBMIT_JOB_AES192_DEC submit_job_aes192_dec_sse
 #define SUBMIT_JOB_AES256_DEC submit_job_aes256_dec_sse
 #define QUEUE_SIZE queue_size_sse
+#define CLEAR_SCRATCH clear_scratch_sse
 
 /* ====================================================================== */
 
@@ -295,6 +409,19 @@ uint64_t hec_64_sse(const uint8_t *in);
 #define FLUSH_JOB_AES256_CCM_AUTH     flush_job_aes256_ccm_auth_ptr
 #define SUBMIT_JOB_AES256_CCM_AUTH    submit_job_aes256_ccm_auth_ptr
 
+#define FLUSH_JOB_AES128_CCM_CTR_MAC  flush_job_aes128_ccm_ctr_mac_sse
+#define SUBMIT_JOB_AES128_CCM_CTR_MAC submit_job_aes128_ccm_ctr_mac_sse
+
+#define FLUSH_JOB_AES256_CCM_CTR_MAC  flush_job_aes256_ccm_ctr_mac_sse
+#define SUBMIT_JOB_AES256_CCM_CTR_MAC submit_job_aes256_ccm_ctr_mac_sse
+
+#define SUBMIT_JOB_DOCSIS128_CRC32_X4 submit_job_docsis128_crc32_x4_sse
+#define FLUSH_JOB_DOCSIS128_CRC32_X4  flush_job_docsis128_crc32_x4_sse
+#define SUBMIT_JOB_DOCSIS256_CRC32_X4 submit_job_docsis256_crc32_x4_sse
+#define FLUSH_JOB_DOCSIS256_CRC32_X4  flush_job_docsis256_crc32_x4_sse
+#define DOCSIS128_CRC32_DEC           docsis128_crc32_dec_sse
+#define DOCSIS256_CRC32_DEC           docsis256_crc32_dec_sse
+
 #define FLUSH_JOB_AES128_CMAC_AUTH    flush_job_aes128_cmac_auth_ptr
 #define SUBMIT_JOB_AES128_CMAC_AUTH   submit_job_aes128_cmac_auth_ptr
 
@@ -348,6 +475,29 @@ static aes_flush_job_t flush_job_aes128_enc_ptr = flush_job_aes128_enc_sse;
 static aes_flush_job_t flush_job_aes192_enc_ptr = flush_job_aes192_enc_sse;
 static aes_flush_job_t flush_job_aes256_enc_ptr = flush_job_aes256_enc_sse;
 
+/*
+ * Multi-lane CBC encrypt and CBC-MAC function pointers (SGL managers)
+ */
+
+void aes_cbc_enc_128_x4(AES_ARGS *args, uint64_t len);
+void aes_cbc_enc_192_x4(AES_ARGS *args, uint64_t len);
+void aes_cbc_enc_256_x4(AES_ARGS *args, uint64_t len);
+void aes128_cbc_mac_x4(AES_ARGS *args, uint64_t len);
+void aes256_cbc_mac_x4(AES_ARGS *args, uint64_t len);
+void aes_cbc_enc_128_x8_sse(AES_ARGS *args, uint64_t len);
+void aes_cbc_enc_192_x8_sse(AES_ARGS *args, uint64_t len);
+void aes_cbc_enc_256_x8_sse(AES_ARGS *args, uint64_t len);
+void aes128_cbc_mac_x8_sse(AES_ARGS *args, uint64_t len);
+void aes256_cbc_mac_x8_sse(AES_ARGS *args, uint64_t len);
+
+typedef void (*aes_cbc_x_fn_t)(AES_ARGS *, uint64_t);
+
+static aes_cbc_x_fn_t aes_cbc_enc_128_x_ptr = aes_cbc_enc_128_x4;
+static aes_cbc_x_fn_t aes_cbc_enc_192_x_ptr = aes_cbc_enc_192_x4;
+static aes_cbc_x_fn_t aes_cbc_enc_256_x_ptr = aes_cbc_enc_256_x4;
+static aes_cbc_x_fn_t aes128_cbc_mac_x_ptr = aes128_cbc_mac_x4;
+static aes_cbc_x_fn_t aes256_cbc_mac_x_ptr = aes256_cbc_mac_x4;
+
 /* ====================================================================== */
 
 /*
@@ -577,6 +727,15 @@ static IMB_JOB *
 (*flush_job_zuc_eia3_sse)
         (MB_MGR_ZUC_OOO *state) = flush_job_zuc_eia3_no_gfni_sse;
 
+static IMB_JOB *
+(*submit_job_zuc_eea3_eia3_sse)
+        (MB_MGR_ZUC_EEA3_EIA3_OOO *state, IMB_JOB *job) =
+                        submit_job_zuc_eea3_eia3_no_gfni_sse;
+
+static IMB_JOB *
+(*flush_job_zuc_eea3_eia3_sse)
+        (MB_MGR_ZUC_EEA3_EIA3_OOO *state) = flush_job_zuc_eea3_eia3_no_gfni_sse;
+
 void
 init_mb_mgr_sse(IMB_MGR *state)
 {
@@ -586,6 +745,8 @@ init_mb_mgr_sse(IMB_MGR *state)
         MB_MGR_AES_OOO *aes128_ooo = state->aes128_ooo;
         MB_MGR_AES_OOO *aes192_ooo = state->aes192_ooo;
         MB_MGR_AES_OOO *aes256_ooo = state->aes256_ooo;
+        MB_MGR_AES_OOO *aes128_cfb_ooo = state->aes128_cfb_ooo;
+        MB_MGR_AES_OOO *aes256_cfb_ooo = state->aes256_cfb_ooo;
         MB_MGR_DOCSIS_AES_OOO *docsis128_sec_ooo = state->docsis128_sec_ooo;
         MB_MGR_DOCSIS_AES_OOO *docsis128_crc32_sec_ooo =
                                                 state->docsis128_crc32_sec_ooo;
@@ -600,9 +761,32 @@ init_mb_mgr_sse(IMB_MGR *state)
         MB_MGR_HMAC_MD5_OOO *hmac_md5_ooo = state->hmac_md5_ooo;
         MB_MGR_AES_XCBC_OOO *aes_xcbc_ooo = state->aes_xcbc_ooo;
         MB_MGR_CCM_OOO *aes_ccm_ooo = state->aes_ccm_ooo;
+        MB_MGR_CCM_CTR_MAC_OOO *aes128_ccm_ctr_mac_ooo =
+                state->aes128_ccm_ctr_mac_ooo;
+        MB_MGR_CCM_CTR_MAC_OOO *aes256_ccm_ctr_mac_ooo =
+                state->aes256_ccm_ctr_mac_ooo;
+        MB_MGR_DOCSIS_CRC32_OOO *docsis128_crc32_x4_ooo =
+                state->docsis128_crc32_x4_ooo;
+        MB_MGR_DOCSIS_CRC32_OOO *docsis256_crc32_x4_ooo =
+                state->docsis256_crc32_x4_ooo;
         MB_MGR_CMAC_OOO *aes_cmac_ooo = state->aes_cmac_ooo;
+        MB_MGR_DES_OOO *des_enc_ooo = state->des_enc_ooo;
+        MB_MGR_DES_OOO *des_dec_ooo = state->des_dec_ooo;
+        MB_MGR_DES_OOO *des3_enc_ooo = state->des3_enc_ooo;
+        MB_MGR_DES_OOO *des3_dec_ooo = state->des3_dec_ooo;
+        MB_MGR_DES_OOO *docsis_des_enc_ooo = state->docsis_des_enc_ooo;
+        MB_MGR_DES_OOO *docsis_des_dec_ooo = state->docsis_des_dec_ooo;
         MB_MGR_ZUC_OOO *zuc_eea3_ooo = state->zuc_eea3_ooo;
         MB_MGR_ZUC_OOO *zuc_eia3_ooo = state->zuc_eia3_ooo;
+        MB_MGR_ZUC_EEA3_EIA3_OOO *zuc_eea3_eia3_ooo =
+                state->zuc_eea3_eia3_ooo;
+        MB_MGR_SGL_OOO *aes128_cbc_sgl_ooo = state->aes128_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes192_cbc_sgl_ooo = state->aes192_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes256_cbc_sgl_ooo = state->aes256_cbc_sgl_ooo;
+        MB_MGR_SGL_OOO *aes128_ccm_sgl_ooo = state->aes128_ccm_sgl_ooo;
+        MB_MGR_SGL_OOO *aes256_ccm_sgl_ooo = state->aes256_ccm_sgl_ooo;
+        uint64_t sgl_unused_lanes = 0xF3210;
+        uint64_t sgl_num_lanes = 4;
 
         state->features = cpu_feature_adjust(state->flags,
                                              cpu_feature_detect());
@@ -617,6 +801,10 @@ init_mb_mgr_sse(IMB_MGR *state)
                 flush_job_zuc_eea3_sse = flush_job_zuc_eea3_gfni_sse;
                 submit_job_zuc_eia3_sse = submit_job_zuc_eia3_gfni_sse;
                 flush_job_zuc_eia3_sse = flush_job_zuc_eia3_gfni_sse;
+                submit_job_zuc_eea3_eia3_sse =
+                        submit_job_zuc_eea3_eia3_gfni_sse;
+                flush_job_zuc_eea3_eia3_sse =
+                        flush_job_zuc_eea3_eia3_gfni_sse;
         }
 
         /* Init AES out-of-order fields */
@@ -656,6 +844,17 @@ init_mb_mgr_sse(IMB_MGR *state)
                 aes256_ooo->unused_lanes = 0xF3210;
         }
 
+        /* AES-CFB encryption uses 4 lanes */
+        memset(aes128_cfb_ooo->job_in_lane, 0,
+               sizeof(aes128_cfb_ooo->job_in_lane));
+        aes128_cfb_ooo->unused_lanes = 0xF3210;
+        aes128_cfb_ooo->num_lanes_inuse = 0;
+
+        memset(aes256_cfb_ooo->job_in_lane, 0,
+               sizeof(aes256_cfb_ooo->job_in_lane));
+        aes256_cfb_ooo->unused_lanes = 0xF3210;
+        aes256_cfb_ooo->num_lanes_inuse = 0;
+
         if (state->features & IMB_FEATURE_GFNI) {
                 /* change AES-CBC decrypt implementation */
                 aes128_cbc_dec_ptr = aes_cbc_dec_128_by8_sse;
@@ -704,6 +903,61 @@ init_mb_mgr_sse(IMB_MGR *state)
         else
                 docsis256_crc32_sec_ooo->unused_lanes = 0xF3210;
 
+        /* DES, 3DES and DOCSIS DES (DES CBC + DES CFB for partial block) */
+        /* - separate DES OOO for encryption */
+        for (j = 0; j < SSE_NUM_DES_LANES; j++) {
+                des_enc_ooo->lens[j] = 0;
+                des_enc_ooo->job_in_lane[j] = NULL;
+        }
+        des_enc_ooo->unused_lanes = 0xF3210;
+        des_enc_ooo->num_lanes_inuse = 0;
+        memset(&des_enc_ooo->args, 0, sizeof(des_enc_ooo->args));
+
+        /* - separate DES OOO for decryption */
+        for (j = 0; j < SSE_NUM_DES_LANES; j++) {
+                des_dec_ooo->lens[j] = 0;
+                des_dec_ooo->job_in_lane[j] = NULL;
+        }
+        des_dec_ooo->unused_lanes = 0xF3210;
+        des_dec_ooo->num_lanes_inuse = 0;
+        memset(&des_dec_ooo->args, 0, sizeof(des_dec_ooo->args));
+
+        /* - separate 3DES OOO for encryption */
+        for (j = 0; j < SSE_NUM_DES_LANES; j++) {
+                des3_enc_ooo->lens[j] = 0;
+                des3_enc_ooo->job_in_lane[j] = NULL;
+        }
+        des3_enc_ooo->unused_lanes = 0xF3210;
+        des3_enc_ooo->num_lanes_inuse = 0;
+        memset(&des3_enc_ooo->args, 0, sizeof(des3_enc_ooo->args));
+
+        /* - separate 3DES OOO for decryption */
+        for (j = 0; j < SSE_NUM_DES_LANES; j++) {
+                des3_dec_ooo->lens[j] = 0;
+                des3_dec_ooo->job_in_lane[j] = NULL;
+        }
+        des3_dec_ooo->unused_lanes = 0xF3210;
+        des3_dec_ooo->num_lanes_inuse = 0;
+        memset(&des3_dec_ooo->args, 0, sizeof(des3_dec_ooo->args));
+
+        /* - separate DOCSIS DES OOO for encryption */
+        for (j = 0; j < SSE_NUM_DES_LANES; j++) {
+                docsis_des_enc_ooo->lens[j] = 0;
+                docsis_des_enc_ooo->job_in_lane[j] = NULL;
+        }
+        docsis_des_enc_ooo->unused_lanes = 0xF3210;
+        docsis_des_enc_ooo->num_lanes_inuse = 0;
+        memset(&docsis_des_enc_ooo->args, 0, sizeof(docsis_des_enc_ooo->args));
+
+        /* - separate DOCSIS DES OOO for decryption */
+        for (j = 0; j < SSE_NUM_DES_LANES; j++) {
+                docsis_des_dec_ooo->lens[j] = 0;
+                docsis_des_dec_ooo->job_in_lane[j] = NULL;
+        }
+        docsis_des_dec_ooo->unused_lanes = 0xF3210;
+        docsis_des_dec_ooo->num_lanes_inuse = 0;
+        memset(&docsis_des_dec_ooo->args, 0, sizeof(docsis_des_dec_ooo->args));
+
         /* Init ZUC out-of-order fields */
         memset(zuc_eea3_ooo->lens, 0xFF,
                sizeof(zuc_eea3_ooo->lens));
@@ -719,6 +973,17 @@ init_mb_mgr_sse(IMB_MGR *state)
         zuc_eia3_ooo->unused_lanes = 0xFF03020100;
         zuc_eia3_ooo->num_lanes_inuse = 0;
 
+        memset(zuc_eea3_eia3_ooo->lens, 0xFF,
+               sizeof(zuc_eea3_eia3_ooo->lens));
+        memset(zuc_eea3_eia3_ooo->auth_lens, 0xFF,
+               sizeof(zuc_eea3_eia3_ooo->auth_lens));
+        memset(zuc_eea3_eia3_ooo->job_in_lane, 0,
+               sizeof(zuc_eea3_eia3_ooo->job_in_lane));
+        zuc_eea3_eia3_ooo->unused_lanes = 0xF10;
+        zuc_eea3_eia3_ooo->num_lanes_inuse = 0;
+        zuc_eea3_eia3_ooo->auth_after_cipher = 0;
+        zuc_eea3_eia3_ooo->cipher_lag = 0;
+
         /* Init HMAC/SHA1 out-of-order fields */
         hmac_sha_1_ooo->lens[0] = 0;
         hmac_sha_1_ooo->lens[1] = 0;
@@ -982,6 +1247,36 @@ init_mb_mgr_sse(IMB_MGR *state)
         }
         aes_ccm_ooo->num_lanes_inuse = 0;
 
+        /* Init AES-CCM stitched (CTR + CBC-MAC) out-of-order fields */
+        memset(aes128_ccm_ctr_mac_ooo->lens, 0xFF,
+               sizeof(aes128_ccm_ctr_mac_ooo->lens));
+        memset(aes128_ccm_ctr_mac_ooo->job_in_lane, 0,
+               sizeof(aes128_ccm_ctr_mac_ooo->job_in_lane));
+        aes128_ccm_ctr_mac_ooo->unused_lanes = 0xF3210;
+        aes128_ccm_ctr_mac_ooo->num_lanes_inuse = 0;
+
+        memset(aes256_ccm_ctr_mac_ooo->lens, 0xFF,
+               sizeof(aes256_ccm_ctr_mac_ooo->lens));
+        memset(aes256_ccm_ctr_mac_ooo->job_in_lane, 0,
+               sizeof(aes256_ccm_ctr_mac_ooo->job_in_lane));
+        aes256_ccm_ctr_mac_ooo->unused_lanes = 0xF3210;
+        aes256_ccm_ctr_mac_ooo->num_lanes_inuse = 0;
+
+        /* Init DOCSIS SEC BPI + CRC32 stitched out-of-order fields */
+        memset(docsis128_crc32_x4_ooo->lens, 0xFF,
+               sizeof(docsis128_crc32_x4_ooo->lens));
+        memset(docsis128_crc32_x4_ooo->job_in_lane, 0,
+               sizeof(docsis128_crc32_x4_ooo->job_in_lane));
+        docsis128_crc32_x4_ooo->unused_lanes = 0xF3210;
+        docsis128_crc32_x4_ooo->num_lanes_inuse = 0;
+
+        memset(docsis256_crc32_x4_ooo->lens, 0xFF,
+               sizeof(docsis256_crc32_x4_ooo->lens));
+        memset(docsis256_crc32_x4_ooo->job_in_lane, 0,
+               sizeof(docsis256_crc32_x4_ooo->job_in_lane));
+        docsis256_crc32_x4_ooo->unused_lanes = 0xF3210;
+        docsis256_crc32_x4_ooo->num_lanes_inuse = 0;
+
         /* Init AES-CMAC auth out-of-order fields */
         memset(aes_cmac_ooo->init_done, 0,
                sizeof(aes_cmac_ooo->init_done));
@@ -1005,9 +1300,52 @@ init_mb_mgr_sse(IMB_MGR *state)
                 aes_cmac_ooo->unused_lanes = 0xF3210;
         }
 
+        /* Init SGL AES-CBC encrypt and AES-CCM out-of-order fields */
+        if (state->features & IMB_FEATURE_GFNI) {
+                aes_cbc_enc_128_x_ptr = aes_cbc_enc_128_x8_sse;
+                aes_cbc_enc_192_x_ptr = aes_cbc_enc_192_x8_sse;
+                aes_cbc_enc_256_x_ptr = aes_cbc_enc_256_x8_sse;
+                aes128_cbc_mac_x_ptr = aes128_cbc_mac_x8_sse;
+                aes256_cbc_mac_x_ptr = aes256_cbc_mac_x8_sse;
+                sgl_unused_lanes = 0xF76543210;
+                sgl_num_lanes = 8;
+        }
+
+        memset(aes128_cbc_sgl_ooo->job_in_lane, 0,
+               sizeof(aes128_cbc_sgl_ooo->job_in_lane));
+        aes128_cbc_sgl_ooo->unused_lanes = sgl_unused_lanes;
+        aes128_cbc_sgl_ooo->num_lanes = sgl_num_lanes;
+        aes128_cbc_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes192_cbc_sgl_ooo->job_in_lane, 0,
+               sizeof(aes192_cbc_sgl_ooo->job_in_lane));
+        aes192_cbc_sgl_ooo->unused_lanes = sgl_unused_lanes;
+        aes192_cbc_sgl_ooo->num_lanes = sgl_num_lanes;
+        aes192_cbc_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes256_cbc_sgl_ooo->job_in_lane, 0,
+               sizeof(aes256_cbc_sgl_ooo->job_in_lane));
+        aes256_cbc_sgl_ooo->unused_lanes = sgl_unused_lanes;
+        aes256_cbc_sgl_ooo->num_lanes = sgl_num_lanes;
+        aes256_cbc_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes128_ccm_sgl_ooo->job_in_lane, 0,
+               sizeof(aes128_ccm_sgl_ooo->job_in_lane));
+        aes128_ccm_sgl_ooo->unused_lanes = sgl_unused_lanes;
+        aes128_ccm_sgl_ooo->num_lanes = sgl_num_lanes;
+        aes128_ccm_sgl_ooo->num_lanes_inuse = 0;
+
+        memset(aes256_ccm_sgl_ooo->job_in_lane, 0,
+               sizeof(aes256_ccm_sgl_ooo->job_in_lane));
+        aes256_ccm_sgl_ooo->unused_lanes = sgl_unused_lanes;
+        aes256_ccm_sgl_ooo->num_lanes = sgl_num_lanes;
+        aes256_ccm_sgl_ooo->num_lanes_inuse = 0;
+
         /* Init "in order" components */
         state->next_job = 0;
         state->earliest_job = -1;
+        state->completion_cb = NULL;
+        state->completion_cb_arg = NULL;
 
         /* set SSE handlers */
         state->get_next_job        = get_next_job_sse;
@@ -1016,6 +1354,7 @@ init_mb_mgr_sse(IMB_MGR *state)
         state->get_completed_job   = get_completed_job_sse;
         state->flush_job           = flush_job_sse;
         state->queue_size          = queue_size_sse;
+        state->clear_scratch       = clear_scratch_sse;
         state->keyexp_128          = aes_keyexp_128_sse;
         state->keyexp_192          = aes_keyexp_192_sse;
         state->keyexp_256          = aes_keyexp_256_sse;
@@ -1035,6 +1374,19 @@ init_mb_mgr_sse(IMB_MGR *state)
         state->sha512              = sha512_sse;
         state->md5_one_block       = md5_one_block_sse;
         state->aes128_cfb_one      = aes_cfb_128_one_sse;
+        state->aes128_xts_enc      = aes_xts_128_enc_sse;
+        state->aes128_xts_dec      = aes_xts_128_dec_sse;
+        state->aes256_xts_enc      = aes_xts_256_enc_sse;
+        state->aes256_xts_dec      = aes_xts_256_dec_sse;
+        state->aes128_ecb_enc      = aes_ecb_128_enc_sse;
+        state->aes128_ecb_dec      = aes_ecb_128_dec_sse;
+        state->aes192_ecb_enc      = aes_ecb_192_enc_sse;
+        state->aes192_ecb_dec      = aes_ecb_192_dec_sse;
+        state->aes256_ecb_enc      = aes_ecb_256_enc_sse;
+        state->aes256_ecb_dec      = aes_ecb_256_dec_sse;
+        state->keyexp_128_n        = aes_keyexp_128_n_sse;
+        state->keyexp_192_n        = aes_keyexp_192_n_sse;
+        state->keyexp_256_n        = aes_keyexp_256_n_sse;
 
         state->eea3_1_buffer       = zuc_eea3_1_buffer_sse;
         if (state->features & IMB_FEATURE_GFNI) {
@@ -1103,6 +1455,36 @@ init_mb_mgr_sse(IMB_MGR *state)
         state->gcm128_pre          = aes_gcm_pre_128_sse;
         state->gcm192_pre          = aes_gcm_pre_192_sse;
         state->gcm256_pre          = aes_gcm_pre_256_sse;
+        state->gcm128_pre_n        = aes_gcm_pre_128_n_sse;
+        state->gcm192_pre_n        = aes_gcm_pre_192_n_sse;
+        state->gcm256_pre_n        = aes_gcm_pre_256_n_sse;
+        state->gcm128_enc_n        = aes_gcm_enc_128_n_sse;
+        state->gcm192_enc_n        = aes_gcm_enc_192_n_sse;
+        state->gcm256_enc_n        = aes_gcm_enc_256_n_sse;
+        state->gcm128_dec_n        = aes_gcm_dec_128_n_sse;
+        state->gcm192_dec_n        = aes_gcm_dec_192_n_sse;
+        state->gcm256_dec_n        = aes_gcm_dec_256_n_sse;
+        state->gcm128_pre_compact = aes_gcm_pre_compact_128_sse;
+        state->gcm192_pre_compact = aes_gcm_pre_compact_192_sse;
+        state->gcm256_pre_compact = aes_gcm_pre_compact_256_sse;
+        state->gcm128_expand_compact =
+                aes_gcm_expand_compact_128_sse;
+        state->gcm192_expand_compact =
+                aes_gcm_expand_compact_192_sse;
+        state->gcm256_expand_compact =
+                aes_gcm_expand_compact_256_sse;
+        state->gcm128_enc_compact =
+                aes_gcm_enc_compact_128_sse;
+        state->gcm192_enc_compact =
+                aes_gcm_enc_compact_192_sse;
+        state->gcm256_enc_compact =
+                aes_gcm_enc_compact_256_sse;
+        state->gcm128_dec_compact =
+                aes_gcm_dec_compact_128_sse;
+        state->gcm192_dec_compact =
+                aes_gcm_dec_compact_192_sse;
+        state->gcm256_dec_compact =
+                aes_gcm_dec_compact_256_sse;
         state->ghash               = ghash_sse;
 
         state->gmac128_init        = imb_aes_gmac_init_128_sse;
@@ -1117,6 +1499,17 @@ init_mb_mgr_sse(IMB_MGR *state)
 
         state->hec_32              = hec_32_sse;
         state->hec_64              = hec_64_sse;
+
+        state->crc32_ethernet_fcs = crc32_ethernet_fcs_sse;
+        state->crc32_sctp         = crc32_sctp_sse;
+        state->crc16_x25          = crc16_x25_sse;
+        state->crc24_lte_a        = crc24_lte_a_sse;
+        state->crc24_lte_b        = crc24_lte_b_sse;
+        state->crc16_fp_data      = crc16_fp_data_sse;
+        state->crc11_fp_header    = crc11_fp_header_sse;
+        state->crc7_fp_header     = crc7_fp_header_sse;
+        state->crc10_iuup_data    = crc10_iuup_data_sse;
+        state->crc6_iuup_header   = crc6_iuup_header_sse;
 }
 
 #include "mb_mgr_code.h"
@@ -155,6 +155,49 @@ lib_objs1 = \
 	$(OBJ_DIR)\aes_cfb_sse.obj \
 	$(OBJ_DIR)\aes_cfb_sse_no_aesni.obj \
 	$(OBJ_DIR)\aes_cfb_avx.obj \
+	$(OBJ_DIR)\aes_xts_sse.obj \
+	$(OBJ_DIR)\aes_xts_sse_no_aesni.obj \
+	$(OBJ_DIR)\aes_xts_avx.obj \
+	$(OBJ_DIR)\aes_xts_avx512.obj \
+	$(OBJ_DIR)\aes_xts_vaes_avx512.obj \
+	$(OBJ_DIR)\aes_ccm_ctr_mac_sse.obj \
+	$(OBJ_DIR)\aes_ccm_ctr_mac_avx.obj \
+	$(OBJ_DIR)\aes_docsis_crc32_sse.obj \
+	$(OBJ_DIR)\aes_docsis_crc32_avx.obj \
+	$(OBJ_DIR)\aes_cfb_x4_sse.obj \
+	$(OBJ_DIR)\aes_cfb_x8_avx.obj \
+	$(OBJ_DIR)\aes_cfb_dec_vaes_avx512.obj \
+	$(OBJ_DIR)\crc32_const.obj \
+	$(OBJ_DIR)\crc_sse.obj \
+	$(OBJ_DIR)\crc_sse_no_aesni.obj \
+	$(OBJ_DIR)\crc_avx.obj \
+	$(OBJ_DIR)\crc_avx512.obj \
+	$(OBJ_DIR)\crc_vaes_avx512.obj \
+	$(OBJ_DIR)\pon_vaes_avx512.obj \
+	$(OBJ_DIR)\mb_mgr_des_sse.obj \
+	$(OBJ_DIR)\mb_mgr_des_avx.obj \
+	$(OBJ_DIR)\mb_mgr_des_avx2.obj \
+	$(OBJ_DIR)\aes_ecb_sse.obj \
+	$(OBJ_DIR)\aes_ecb_sse_no_aesni.obj \
+	$(OBJ_DIR)\aes_ecb_avx.obj \
+	$(OBJ_DIR)\aes_ecb_avx512.obj \
+	$(OBJ_DIR)\aes_ecb_vaes_avx512.obj \
+	$(OBJ_DIR)\aes_keyexp_n_sse.obj \
+	$(OBJ_DIR)\aes_keyexp_n_sse_no_aesni.obj \
+	$(OBJ_DIR)\aes_keyexp_n_avx.obj \
+	$(OBJ_DIR)\aes_keyexp_n_avx2.obj \
+	$(OBJ_DIR)\aes_keyexp_n_avx512.obj \
+	$(OBJ_DIR)\aes_gcm_pre_n_vaes_avx512.obj \
+	$(OBJ_DIR)\aes_gcm_n_sse.obj \
+	$(OBJ_DIR)\aes_gcm_n_sse_no_aesni.obj \
+	$(OBJ_DIR)\aes_gcm_n_avx_gen2.obj \
+	$(OBJ_DIR)\aes_gcm_n_avx_gen4.obj \
+	$(OBJ_DIR)\aes_gcm_n_avx512.obj \
+	$(OBJ_DIR)\aes_gcm_compact_sse.obj \
+	$(OBJ_DIR)\aes_gcm_compact_sse_no_aesni.obj \
+	$(OBJ_DIR)\aes_gcm_compact_avx_gen2.obj \
+	$(OBJ_DIR)\aes_gcm_compact_avx_gen4.obj \
+	$(OBJ_DIR)\aes_gcm_compact_avx512.obj \
 	$(OBJ_DIR)\aes_docsis_dec_avx512.obj \
 	$(OBJ_DIR)\aes_docsis_enc_avx512.obj \
 	$(OBJ_DIR)\aes128_cbc_mac_x4.obj \
@@ -222,6 +265,12 @@ lib_objs1 = \
 	$(OBJ_DIR)\zuc_avx_top.obj \
 	$(OBJ_DIR)\zuc_avx2_top.obj \
 	$(OBJ_DIR)\zuc_avx512_top.obj \
+	$(OBJ_DIR)\zuc_eea3_eia3_sse.obj \
+	$(OBJ_DIR)\zuc_eea3_eia3_gfni_sse.obj \
+	$(OBJ_DIR)\zuc_eea3_eia3_avx.obj \
+	$(OBJ_DIR)\zuc_eea3_eia3_avx2.obj \
+	$(OBJ_DIR)\zuc_eea3_eia3_avx512.obj \
+	$(OBJ_DIR)\zuc_eea3_eia3_gfni_avx512.obj \
 	$(OBJ_DIR)\zuc_sse.obj \
 	$(OBJ_DIR)\zuc_sse_gfni.obj \
 	$(OBJ_DIR)\zuc_sse_no_aesni.obj \
@@ -376,6 +425,7 @@ lib_objs2 = \
 	$(OBJ_DIR)\mb_mgr_sse.obj \
 	$(OBJ_DIR)\mb_mgr_sse_no_aesni.obj \
 	$(OBJ_DIR)\alloc.obj \
+	$(OBJ_DIR)\mb_pool.obj \
 	$(OBJ_DIR)\version.obj \
 	$(OBJ_DIR)\cpu_feature.obj \
 	$(OBJ_DIR)\aesni_emu.obj
@@ -32,11 +32,32 @@
 """
 
 import sys
+import json
+import math
+import argparse
 
 # Number of parameters (ARCH, CIPHER_MODE, DIR, HASH_ALG, KEY_SIZE)
 PAR_NUM = 5
 COL_MAX = 13
 
+# Two-sided Student's t critical values for 1..30 degrees of freedom
+T_TABLE = {
+    90: [6.314, 2.920, 2.353, 2.132, 2.015, 1.943, 1.895, 1.860, 1.833,
+         1.812, 1.796, 1.782, 1.771, 1.761, 1.753, 1.746, 1.740, 1.734,
+         1.729, 1.725, 1.721, 1.717, 1.714, 1.711, 1.708, 1.706, 1.703,
+         1.701, 1.699, 1.697],
+    95: [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+         2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101,
+         2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052,
+         2.048, 2.045, 2.042],
+    99: [63.657, 9.925, 5.841, 4.604, 4.032, 3.707, 3.499, 3.355, 3.250,
+         3.169, 3.106, 3.055, 3.012, 2.977, 2.947, 2.921, 2.898, 2.878,
+         2.861, 2.845, 2.831, 2.819, 2.807, 2.797, 2.787, 2.779, 2.771,
+         2.763, 2.756, 2.750]
+}
+# Normal distribution critical values (more than 30 degrees of freedom)
+Z_TABLE = {90: 1.645, 95: 1.960, 99: 2.576}
+
 class Variant(object):
     """
     Class representing one test including chosen parameters and
@@ -183,12 +204,82 @@ class Parser(object):
         result = [int(i) for i in result]   # Converting str to int
         return result
 
+    @staticmethod
+    def read_records(fname):
+        """
+        Reads JSON or CSV output of ipsec_perf and returns list of
+        records (dictionaries) with the run statistics, one for each
+        test variant and buffer size. Returns None for text output.
+        """
+        try:
+            f = open(fname, 'r')
+        except IOError:
+            print("Error reading {} file.".format(fname))
+            exit(1)
+        with f:
+            data = f.read()
+
+        if data.lstrip().startswith('{'):
+            return json.loads(data)['results']
+
+        lines = [l for l in data.splitlines() if l and not l.startswith('#')]
+        if not lines or not lines[0].startswith('arch,'):
+            return None
+
+        header = lines[0].split(',')
+        records = []
+        for line in lines[1:]:
+            rec = dict(zip(header, line.split(',')))
+            for key in ('key_size', 'runs', 'min', 'max', 'cycles'):
+                rec[key] = int(rec[key])
+            for key in ('mean', 'variance'):
+                rec[key] = float(rec[key])
+            records.append(rec)
+        return records
+
+    @staticmethod
+    def record_params(rec):
+        """
+        Returns test variant parameters of JSON/CSV record,
+        in the same format as in the text output
+        """
+        return (rec['arch'], rec['cipher'], rec['dir'], rec['hash'],
+                "AES-{}".format(rec['key_size']))
+
+    def load_records(self, records):
+        """
+        Stores JSON/CSV records in objects for further comparision
+        of performance
+        """
+        v_list = VarList()
+        sizes = []
+        for rec in records:
+            params = self.record_params(rec)
+            size = int(rec['size'])
+            obj = v_list.find_obj(params)
+            if obj is None:
+                v_list.append(Variant(arch=params[0], cipher=params[1],
+                                      dir=params[2], alg=params[3],
+                                      keysize=params[4]))
+                obj = v_list[-1]
+            obj.avg_times.append(rec['cycles'])
+            if size not in sizes:
+                sizes.append(size)
+
+        for obj in v_list:
+            obj.lin_reg(sizes)
+        return v_list, sizes
+
     def load(self):
         """
         Reads a text file by columns, stores data in objects
         for further comparision of performance
         """
 
+        records = self.read_records(self.fname)
+        if records is not None:
+            return self.load_records(records)
+
         v_list = VarList()
         # Reading by columns, results in list of tuples
         # Each tuple is representing a column from a text file
@@ -199,7 +290,15 @@ class Parser(object):
             exit(1)
         else:
             with f:
-                cols = list(zip(*(line.strip().split('\t') for line in f)))
+                rows = [line.strip().split('\t') for line in f]
+
+        # Skipping extra result blocks (e.g. LATENCY_*, PMU_*) that
+        # follow the averaged cycles, they start with a non-numeric row
+        for i in range(PAR_NUM, len(rows)):
+            if not rows[i][0].isdigit():
+                rows = rows[:i]
+                break
+        cols = list(zip(*rows))
 
         # Reading first column with payload sizes, ommiting first 5 rows
         sizes = self.convert2int(cols[0][PAR_NUM:])
@@ -233,6 +332,163 @@ class Parser(object):
                 print("============\n")
         return v_list, sizes
 
+class Stats(object):
+    """
+    Class storing number of samples, mean and sum of squared
+    differences from the mean of run results
+    """
+
+    def __init__(self):
+        self.num = 0
+        self.mean = 0.0
+        self.m2 = 0.0
+
+    def add(self, num, mean, variance):
+        """
+        Merges statistics of another set of samples
+        """
+        if num == 0:
+            return
+        total = self.num + num
+        delta = mean - self.mean
+        self.m2 += variance * (num - 1) + \
+                   delta * delta * self.num * num / float(total)
+        self.mean += delta * num / float(total)
+        self.num = total
+
+    def add_samples(self, samples):
+        """
+        Merges set of samples
+        """
+        num = len(samples)
+        mean = sum(samples) / float(num)
+        variance = 0.0
+        if num > 1:
+            variance = sum([pow(x - mean, 2) for x in samples]) / (num - 1)
+        self.add(num, mean, variance)
+
+    def variance(self):
+        """
+        Returns sample variance
+        """
+        if self.num < 2:
+            return 0.0
+        return self.m2 / (self.num - 1)
+
+class Gate(object):
+    """
+    Class comparing repeated runs of two builds and failing on
+    statistically significant performance regressions
+    """
+
+    def __init__(self, confidence, threshold):
+        self.confidence = confidence
+        self.threshold = threshold
+
+    @staticmethod
+    def load(fnames):
+        """
+        Reads results of repeated runs. JSON files contribute all run
+        samples, CSV files their statistics and text files one sample
+        (averaged cycles) per file, for each test variant and size.
+        """
+        results = {}
+        order = []
+        for fname in fnames:
+            records = Parser.read_records(fname)
+            if records is None:
+                v_list, sizes = Parser(fname, False).load()
+                records = []
+                for obj in v_list:
+                    arch, cipher, c_dir, alg, keysize = obj.get_params()
+                    for size, cycles in zip(sizes, obj.avg_times):
+                        records.append({'arch': arch, 'cipher': cipher,
+                                        'dir': c_dir, 'hash': alg,
+                                        'key_size': keysize[4:],
+                                        'size': size, 'samples': [cycles]})
+            for rec in records:
+                key = Parser.record_params(rec) + (str(rec['size']),)
+                if key not in results:
+                    results[key] = Stats()
+                    order.append(key)
+                if 'samples' in rec:
+                    results[key].add_samples(rec['samples'])
+                else:
+                    results[key].add(rec['runs'], rec['mean'],
+                                     rec['variance'])
+        return results, order
+
+    def t_value(self, dof):
+        """
+        Returns two-sided critical value for given degrees of freedom
+        """
+        if dof > len(T_TABLE[self.confidence]):
+            return Z_TABLE[self.confidence]
+        return T_TABLE[self.confidence][max(int(dof), 1) - 1]
+
+    def diff_interval(self, st_a, st_b):
+        """
+        Returns difference of means (B - A) and its confidence interval
+        (Welch's t-test), as percentages of mean A
+        """
+        diff = st_b.mean - st_a.mean
+        low = high = diff
+        if st_a.num > 1 and st_b.num > 1:
+            va = st_a.variance() / st_a.num
+            vb = st_b.variance() / st_b.num
+            err = math.sqrt(va + vb)
+            if err > 0.0:
+                dof = pow(va + vb, 2) / \
+                      (pow(va, 2) / (st_a.num - 1) +
+                       pow(vb, 2) / (st_b.num - 1))
+                low = diff - self.t_value(dof) * err
+                high = diff + self.t_value(dof) * err
+        if st_a.mean == 0.0:
+            return 0.0, 0.0, 0.0
+        return (100.0 * diff / st_a.mean, 100.0 * low / st_a.mean,
+                100.0 * high / st_a.mean)
+
+    def run(self, fnames_a, fnames_b):
+        """
+        Compares all test variants and sizes available in both sets
+        of runs. Returns True if any of them regressed.
+        """
+        results_a, order = self.load(fnames_a)
+        results_b, _ = self.load(fnames_b)
+
+        print("THRESHOLD: {:.2f}%, CONFIDENCE: {}%".format(self.threshold,
+                                                         self.confidence))
+        headings = ["ARCH", "CIPHER", "DIR", "HASH", "KEYSZ", "SIZE",
+                    "MEAN A", "MEAN B", "DIFF %", "CI LOW %", "CI HIGH %",
+                    "RESULT"]
+        print("".join(j.ljust(COL_MAX) for j in headings))
+
+        num_fail = 0
+        num_pass = 0
+        for key in order:
+            if key not in results_b:
+                continue
+            st_a = results_a[key]
+            st_b = results_b[key]
+            diff, low, high = self.diff_interval(st_a, st_b)
+
+            # regression must exceed threshold and be significant
+            if diff > self.threshold and low > 0.0:
+                result = "FAIL"
+                num_fail += 1
+            else:
+                result = "PASS"
+                num_pass += 1
+
+            data = [str(j) for j in key]
+            data += ["{:.1f}".format(st_a.mean), "{:.1f}".format(st_b.mean),
+                     "{:.2f}".format(diff), "{:.2f}".format(low),
+                     "{:.2f}".format(high), result]
+            print("".join(j.ljust(COL_MAX) for j in data))
+
+        print("PASSED: {}, FAILED: {}".format(num_pass, num_fail))
+        return num_fail != 0
+
 class DiffTool(object):
     """
     Main class
@@ -244,6 +500,7 @@ class DiffTool(object):
         self.tolerance = None
         self.verbose = False
         self.analyze = False
+        self.gate = None
 
     @staticmethod
     def usage():
@@ -252,15 +509,24 @@ class DiffTool(object):
         """
         print("This tool compares file_b against file_a printing out differences.")
         print("Usage:")
-        print("\tipsec_diff_tool.py [-v] [-a] file_a file_b [tol]\n")
+        print("\tipsec_diff_tool.py [-v] [-a] file_a file_b [tol]")
+        print("\tipsec_diff_tool.py -g [-t tol] [-c conf] -A file_a ... "
+              "-B file_b ...\n")
         print("\t-v - verbose")
         print("\t-a - takes only one argument: name of the file to analyze")
         print("\tfile_a, file_b - text files containing output from ipsec_perf tool")
-        print("\ttol - tolerance [%], must be >= 0, default 5\n")
+        print("\ttol - tolerance [%], must be >= 0, default 5")
+        print("\t-g - gate mode: compares repeated runs of build A (-A)\n"
+              "\t     and build B (-B), fails (exit code 2) on regressions\n"
+              "\t     above tolerance if significant at given confidence\n"
+              "\t     [%] (-c 90, 95 or 99, default 95)\n"
+              "\t     Files can be text, JSON or CSV output of ipsec_perf\n")
         print("Examples:")
         print("\tipsec_diff_tool.py file01.txt file02.txt 10")
         print("\tipsec_diff_tool.py -a file02.txt")
         print("\tipsec_diff_tool.py -v -a file01.txt")
+        print("\tipsec_diff_tool.py -g -t 3 -A a1.json a2.json "
+              "-B b1.json b2.json")
 
 
     def parse_args(self):
@@ -270,6 +536,19 @@ class DiffTool(object):
         if len(sys.argv) < 3 or sys.argv[1] == "-h":
             self.usage()
             exit(1)
+        if sys.argv[1] == "-g":
+            parser = argparse.ArgumentParser(add_help=False)
+            parser.add_argument('-g', action='store_true')
+            parser.add_argument('-t', type=float, default=5.0)
+            parser.add_argument('-c', type=int, default=95,
+                                choices=sorted(T_TABLE.keys()))
+            parser.add_argument('-A', nargs='+', required=True)
+            parser.add_argument('-B', nargs='+', required=True)
+            self.gate = parser.parse_args()
+            if self.gate.t < 0.0:
+                print("Bad argument: Tolerance must not be less than 0%")
+                exit(1)
+            return
         if sys.argv[1] == "-a":
             self.analyze = True
             self.fname_a = sys.argv[2]
@@ -297,6 +576,11 @@ class DiffTool(object):
         """
         self.parse_args()
 
+        if self.gate is not None:
+            if Gate(self.gate.c, self.gate.t).run(self.gate.A, self.gate.B):
+                exit(2)
+            return
+
         parser_a = Parser(self.fname_a, self.verbose)
         list_a, sizes_a = parser_a.load()
 
@@ -46,11 +46,17 @@
 #include <unistd.h>
 #include <pthread.h>
 #include <sched.h>
+#include <time.h>
+#include <sys/syscall.h>
+#endif
+#ifdef HAVE_LIBNUMA
+#include <numa.h>
 #endif
 
 #include <intel-ipsec-mb.h>
 
 #include "msr.h"
+#include "pmu.h"
 
 /* memory size for test buffers */
 #define BUFSIZE (512 * 1024 * 1024)
@@ -84,6 +90,15 @@
 #define ITER_SCALE_SHORT 200000
 #define ITER_SCALE_LONG  2000000
 
+#define IMIX_MAX_SIZES 16
+#define IMIX_LIST_SIZE 1024 /* must be a power of 2 */
+
+/* Latency histogram: 32 sub-buckets per power of 2 (~3% precision) */
+#define LAT_SUB_BUCKET_BITS 5
+#define LAT_NUM_BUCKETS ((64 - LAT_SUB_BUCKET_BITS + 1) << LAT_SUB_BUCKET_BITS)
+#define NUM_LAT_PCTS 4 /* P50, P90, P99, P99.9 */
+#define PMU_SCALE 100 /* PMU counters are stored per job, in 1/100 units */
+
 #define BITS(x) (sizeof(x) * 8)
 #define DIM(x) (sizeof(x)/sizeof(x[0]))
 
@@ -210,6 +225,8 @@ enum test_cipher_mode_e {
         TEST_ZUC_EEA3,
         TEST_SNOW3G_UEA2,
         TEST_KASUMI_UEA1,
+        TEST_CFB,
+        TEST_XTS,
         TEST_NUM_CIPHER_TESTS
 };
 
@@ -253,6 +270,13 @@ struct params_s {
         uint32_t		num_sizes;
         uint32_t		num_variants;
         uint32_t                core;
+        struct latency_hist_s   *lat_hist; /* used with --latency only */
+};
+
+/* HDR style histogram of job latencies in cycles */
+struct latency_hist_s {
+        uint64_t counts[LAT_NUM_BUCKETS];
+        uint64_t total;
 };
 
 struct custom_job_params {
@@ -483,6 +507,34 @@ struct str_value_mapping cipher_algo_str_map[] = {
                         .aes_key_size = 16
                 }
         },
+        {
+                .name = "aes-cfb-128",
+                .values.job_params = {
+                        .cipher_mode = TEST_CFB,
+                        .aes_key_size = IMB_KEY_AES_128_BYTES
+                }
+        },
+        {
+                .name = "aes-cfb-256",
+                .values.job_params = {
+                        .cipher_mode = TEST_CFB,
+                        .aes_key_size = IMB_KEY_AES_256_BYTES
+                }
+        },
+        {
+                .name = "aes-xts-128",
+                .values.job_params = {
+                        .cipher_mode = TEST_XTS,
+                        .aes_key_size = IMB_KEY_AES_128_BYTES
+                }
+        },
+        {
+                .name = "aes-xts-256",
+                .values.job_params = {
+                        .cipher_mode = TEST_XTS,
+                        .aes_key_size = IMB_KEY_AES_256_BYTES
+                }
+        },
         {
                 .name = "null",
                 .values.job_params = {
@@ -672,6 +724,8 @@ struct variant_s {
         uint32_t arch;
         struct params_s params;
         uint64_t *avg_times;
+        uint64_t *lat_pcts; /* latency percentiles (--latency only) */
+        uint64_t *pmu_ctrs; /* PMU counters per job (--pmu only) */
 };
 
 /* Struct storing information to be passed to threads */
@@ -749,6 +803,7 @@ uint8_t archs[NUM_ARCHS] = {1, 1, 1, 1}; /* uses all function sets */
 uint8_t test_types[NUM_TTYPES] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0 };
 
 int use_gcm_job_api = 0;
+int stitch = 0; /* lay out 3GPP cipher and hash jobs as PDUs */
 int use_unhalted_cycles = 0; /* read unhalted cycles instead of tsc */
 uint64_t rd_cycles_cost = 0; /* cost of reading unhalted cycles */
 uint64_t core_mask = 0; /* bitmap of selected cores */
@@ -756,6 +811,43 @@ uint64_t core_mask = 0; /* bitmap of selected cores */
 uint64_t flags = 0; /* flags passed to alloc_mb_mgr() */
 
 uint32_t iter_scale = ITER_SCALE_LONG;
+int keyexp_test = 0; /* run key expansion rate test only */
+uint32_t gcm_sa_num = 0; /* number of SA's for GCM SA working set test */
+uint32_t num_sessions = 0; /* number of sessions for SA working set test */
+int sessions_zipf = 0; /* pick sessions with Zipf distribution */
+uint32_t scaling_cores = 0; /* max number of cores for scaling test */
+uint32_t pool_workers = 0; /* max number of workers for pool test */
+int direct_api_test = 0; /* run direct API test only */
+
+/* IMIX packet size distribution (--imix), not used if imix_num_sizes == 0 */
+struct imix_size_s {
+        uint32_t size;
+        uint32_t weight;
+};
+
+struct imix_size_s imix_sizes[IMIX_MAX_SIZES];
+uint32_t imix_num_sizes = 0;
+uint32_t imix_list[IMIX_LIST_SIZE]; /* index to imix_sizes for each job */
+double imix_avg_size = 0; /* average job size in bytes */
+double tsc_freq = 0; /* TSC cycles per second (to report packets/s) */
+
+int latency_test = 0; /* measure per job latency (--latency) */
+uint32_t latency_load = 0; /* jobs submitted between flushes (0 = no flush) */
+const uint32_t lat_pcts_permille[NUM_LAT_PCTS] = { 500, 900, 990, 999 };
+
+int pmu_test = 0; /* collect hardware counters (--pmu) */
+
+uint32_t safe_burst = 0; /* jobs between IMB_CLEAR_SCRATCH() (--safe-burst) */
+int completion_cb = 0; /* use completion callback (--completion-cb) */
+
+enum output_format_e {
+        OUTPUT_TEXT = 0,
+        OUTPUT_JSON,
+        OUTPUT_CSV
+};
+
+enum output_format_e output_format = OUTPUT_TEXT;
+uint64_t mgr_features = 0; /* features detected by the library */
 
 #define PB_INIT_SIZE 50
 #define PB_INIT_IDX  2 /* after \r and [ */
@@ -1054,6 +1146,15 @@ static uint32_t get_next_index(uint32_t index)
         return index;
 }
 
+/* Returns size of the job number <job>, picked from IMIX list if set */
+static uint32_t get_job_size(const uint32_t job, const uint32_t size)
+{
+        if (imix_num_sizes == 0)
+                return size;
+
+        return imix_sizes[imix_list[job & (IMIX_LIST_SIZE - 1)]].size;
+}
+
 static void init_buf(void *pb, const size_t length)
 {
         const size_t n = length / sizeof(uint64_t);
@@ -1222,21 +1323,26 @@ translate_cipher_mode(const enum test_cipher_mode_e test_mode)
         case TEST_KASUMI_UEA1:
                 c_mode = IMB_CIPHER_KASUMI_UEA1_BITLEN;
                 break;
+        case TEST_CFB:
+                c_mode = IMB_CIPHER_CFB;
+                break;
+        case TEST_XTS:
+                c_mode = IMB_CIPHER_XTS;
+                break;
         default:
                 break;
         }
         return c_mode;
 }
 
-/* Performs test using AES_HMAC or DOCSIS */
-static uint64_t
-do_test(IMB_MGR *mb_mgr, struct params_s *params,
-        const uint32_t num_iter, uint8_t *p_buffer, imb_uint128_t *p_keys)
+/*
+ * Prepares job template for given test parameters
+ * (and XGEM header for PON jobs)
+ */
+static void
+init_job_template(IMB_MGR *mb_mgr, const struct params_s *params,
+                  IMB_JOB *job_template, uint64_t *xgem_hdr)
 {
-        IMB_JOB *job;
-        IMB_JOB job_template;
-        uint32_t i;
-        static uint32_t index = 0;
         static DECLARE_ALIGNED(imb_uint128_t iv, 16);
         static DECLARE_ALIGNED(imb_uint128_t auth_iv, 16);
         static uint32_t ipad[5], opad[5], digest[3];
@@ -1244,12 +1350,11 @@ do_test(IMB_MGR *mb_mgr, struct params_s *params,
         static DECLARE_ALIGNED(uint8_t	k2[16], 16);
         static DECLARE_ALIGNED(uint8_t	k3[16], 16);
         static DECLARE_ALIGNED(struct gcm_key_data gdata_key, 512);
-        uint64_t xgem_hdr = 0;
         uint32_t size_aes;
-        uint64_t time = 0;
-        uint32_t aux;
         uint8_t gcm_key[32];
 
+        *xgem_hdr = 0;
+
         if ((params->cipher_mode == TEST_AESDOCSIS8) ||
             (params->cipher_mode == TEST_CNTR8))
                 size_aes = params->size_aes + 8;
@@ -1259,147 +1364,149 @@ do_test(IMB_MGR *mb_mgr, struct params_s *params,
                 size_aes = params->size_aes;
 
         if (params->cipher_mode == TEST_CNTR_BITLEN)
-                job_template.msg_len_to_cipher_in_bits = size_aes * 8;
+                job_template->msg_len_to_cipher_in_bits = size_aes * 8;
         else if (params->cipher_mode == TEST_CNTR_BITLEN4)
-                job_template.msg_len_to_cipher_in_bits = size_aes * 8 - 4;
+                job_template->msg_len_to_cipher_in_bits = size_aes * 8 - 4;
         else
-                job_template.msg_len_to_cipher_in_bytes = size_aes;
+                job_template->msg_len_to_cipher_in_bytes = size_aes;
 
-        job_template.msg_len_to_hash_in_bytes = size_aes + sha_size_incr;
-        job_template.hash_start_src_offset_in_bytes = 0;
-        job_template.cipher_start_src_offset_in_bytes = sha_size_incr;
-        job_template.iv = (uint8_t *) &iv;
-        job_template.iv_len_in_bytes = 16;
+        job_template->msg_len_to_hash_in_bytes = size_aes + sha_size_incr;
+        job_template->hash_start_src_offset_in_bytes = 0;
+        job_template->cipher_start_src_offset_in_bytes = sha_size_incr;
+        job_template->iv = (uint8_t *) &iv;
+        job_template->iv_len_in_bytes = 16;
 
-        job_template.auth_tag_output = (uint8_t *) digest;
+        job_template->auth_tag_output = (uint8_t *) digest;
 
         switch (params->hash_alg) {
         case TEST_XCBC:
-                job_template.u.XCBC._k1_expanded = k1_expanded;
-                job_template.u.XCBC._k2 = k2;
-                job_template.u.XCBC._k3 = k3;
-                job_template.hash_alg = IMB_AUTH_AES_XCBC;
+                job_template->u.XCBC._k1_expanded = k1_expanded;
+                job_template->u.XCBC._k2 = k2;
+                job_template->u.XCBC._k3 = k3;
+                job_template->hash_alg = IMB_AUTH_AES_XCBC;
                 break;
         case TEST_HASH_CCM:
-                job_template.hash_alg = IMB_AUTH_AES_CCM;
+                job_template->hash_alg = IMB_AUTH_AES_CCM;
                 break;
         case TEST_HASH_GCM:
-                job_template.hash_alg = IMB_AUTH_AES_GMAC;
+                job_template->hash_alg = IMB_AUTH_AES_GMAC;
                 break;
         case TEST_DOCSIS_CRC32:
-                job_template.hash_alg = IMB_AUTH_DOCSIS_CRC32;
+                job_template->hash_alg = IMB_AUTH_DOCSIS_CRC32;
                 break;
         case TEST_NULL_HASH:
-                job_template.hash_alg = IMB_AUTH_NULL;
+                job_template->hash_alg = IMB_AUTH_NULL;
                 break;
         case TEST_HASH_CMAC:
-                job_template.u.CMAC._key_expanded = k1_expanded;
-                job_template.u.CMAC._skey1 = k2;
-                job_template.u.CMAC._skey2 = k3;
-                job_template.hash_alg = IMB_AUTH_AES_CMAC;
+                job_template->u.CMAC._key_expanded = k1_expanded;
+                job_template->u.CMAC._skey1 = k2;
+                job_template->u.CMAC._skey2 = k3;
+                job_template->hash_alg = IMB_AUTH_AES_CMAC;
                 break;
         case TEST_HASH_CMAC_BITLEN:
-                job_template.u.CMAC._key_expanded = k1_expanded;
-                job_template.u.CMAC._skey1 = k2;
-                job_template.u.CMAC._skey2 = k3;
+                job_template->u.CMAC._key_expanded = k1_expanded;
+                job_template->u.CMAC._skey1 = k2;
+                job_template->u.CMAC._skey2 = k3;
                 /*
                  * CMAC bit level version is done in bits (length is
                  * converted to bits and it is decreased by 4 bits,
                  * to force the CMAC bitlen path)
                  */
-                job_template.msg_len_to_hash_in_bits =
-                        (job_template.msg_len_to_hash_in_bytes * 8) - 4;
-                job_template.hash_alg = IMB_AUTH_AES_CMAC_BITLEN;
+                job_template->msg_len_to_hash_in_bits =
+                        (job_template->msg_len_to_hash_in_bytes * 8) - 4;
+                job_template->hash_alg = IMB_AUTH_AES_CMAC_BITLEN;
                 break;
         case TEST_HASH_CMAC_256:
-                job_template.u.CMAC._key_expanded = k1_expanded;
-                job_template.u.CMAC._skey1 = k2;
-                job_template.u.CMAC._skey2 = k3;
-                job_template.hash_alg = IMB_AUTH_AES_CMAC_256;
+                job_template->u.CMAC._key_expanded = k1_expanded;
+                job_template->u.CMAC._skey1 = k2;
+                job_template->u.CMAC._skey2 = k3;
+                job_template->hash_alg = IMB_AUTH_AES_CMAC_256;
                 break;
         case TEST_PON_CRC_BIP:
-                job_template.hash_alg = IMB_AUTH_PON_CRC_BIP;
-                job_template.msg_len_to_hash_in_bytes = size_aes + 8;
-                job_template.cipher_start_src_offset_in_bytes = 8;
+                job_template->hash_alg = IMB_AUTH_PON_CRC_BIP;
+                job_template->msg_len_to_hash_in_bytes = size_aes + 8;
+                job_template->cipher_start_src_offset_in_bytes = 8;
                 if (params->cipher_mode == TEST_PON_NO_CNTR)
-                        job_template.msg_len_to_cipher_in_bytes = 0;
+                        job_template->msg_len_to_cipher_in_bytes = 0;
                 break;
         case TEST_ZUC_EIA3:
-                job_template.hash_alg = IMB_AUTH_ZUC_EIA3_BITLEN;
-                job_template.msg_len_to_hash_in_bits =
-                        (job_template.msg_len_to_hash_in_bytes * 8);
-                job_template.u.ZUC_EIA3._key = k3;
-                job_template.u.ZUC_EIA3._iv = (uint8_t *) &auth_iv;
+                job_template->hash_alg = IMB_AUTH_ZUC_EIA3_BITLEN;
+                job_template->msg_len_to_hash_in_bits =
+                        (job_template->msg_len_to_hash_in_bytes * 8);
+                job_template->u.ZUC_EIA3._key = k3;
+                job_template->u.ZUC_EIA3._iv = (uint8_t *) &auth_iv;
                 break;
         case TEST_SNOW3G_UIA2:
-                job_template.hash_alg = IMB_AUTH_SNOW3G_UIA2_BITLEN;
-                job_template.msg_len_to_hash_in_bits =
-                        (job_template.msg_len_to_hash_in_bytes * 8);
-                job_template.u.SNOW3G_UIA2._key = k3;
-                job_template.u.SNOW3G_UIA2._iv = (uint8_t *)&auth_iv;
+                job_template->hash_alg = IMB_AUTH_SNOW3G_UIA2_BITLEN;
+                job_template->msg_len_to_hash_in_bits =
+                        (job_template->msg_len_to_hash_in_bytes * 8);
+                job_template->u.SNOW3G_UIA2._key = k3;
+                job_template->u.SNOW3G_UIA2._iv = (uint8_t *)&auth_iv;
                 break;
         case TEST_KASUMI_UIA1:
-                job_template.hash_alg = IMB_AUTH_KASUMI_UIA1;
-                job_template.msg_len_to_hash_in_bytes =
-                        job_template.msg_len_to_hash_in_bytes;
-                job_template.u.KASUMI_UIA1._key = k3;
+                job_template->hash_alg = IMB_AUTH_KASUMI_UIA1;
+                job_template->msg_len_to_hash_in_bytes =
+                        job_template->msg_len_to_hash_in_bytes;
+                job_template->u.KASUMI_UIA1._key = k3;
                 break;
         case TEST_AES_GMAC_128:
-                job_template.hash_alg = IMB_AUTH_AES_GMAC_128;
+                job_template->hash_alg = IMB_AUTH_AES_GMAC_128;
                 IMB_AES128_GCM_PRE(mb_mgr, gcm_key, &gdata_key);
-                job_template.u.GMAC._key = &gdata_key;
-                job_template.u.GMAC._iv = (uint8_t *) &auth_iv;
-                job_template.u.GMAC.iv_len_in_bytes = 12;
+                job_template->u.GMAC._key = &gdata_key;
+                job_template->u.GMAC._iv = (uint8_t *) &auth_iv;
+                job_template->u.GMAC.iv_len_in_bytes = 12;
                 break;
         case TEST_AES_GMAC_192:
-                job_template.hash_alg = IMB_AUTH_AES_GMAC_192;
+                job_template->hash_alg = IMB_AUTH_AES_GMAC_192;
                 IMB_AES192_GCM_PRE(mb_mgr, gcm_key, &gdata_key);
-                job_template.u.GMAC._key = &gdata_key;
-                job_template.u.GMAC._iv = (uint8_t *) &auth_iv;
-                job_template.u.GMAC.iv_len_in_bytes = 12;
+                job_template->u.GMAC._key = &gdata_key;
+                job_template->u.GMAC._iv = (uint8_t *) &auth_iv;
+                job_template->u.GMAC.iv_len_in_bytes = 12;
                 break;
         case TEST_AES_GMAC_256:
-                job_template.hash_alg = IMB_AUTH_AES_GMAC_256;
+                job_template->hash_alg = IMB_AUTH_AES_GMAC_256;
                 IMB_AES256_GCM_PRE(mb_mgr, gcm_key, &gdata_key);
-                job_template.u.GMAC._key = &gdata_key;
-                job_template.u.GMAC._iv = (uint8_t *) &auth_iv;
-                job_template.u.GMAC.iv_len_in_bytes = 12;
+                job_template->u.GMAC._key = &gdata_key;
+                job_template->u.GMAC._iv = (uint8_t *) &auth_iv;
+                job_template->u.GMAC.iv_len_in_bytes = 12;
                 break;
         default:
                 /* HMAC hash alg is SHA1 or MD5 */
-                job_template.u.HMAC._hashed_auth_key_xor_ipad =
+                job_template->u.HMAC._hashed_auth_key_xor_ipad =
                         (uint8_t *) ipad;
-                job_template.u.HMAC._hashed_auth_key_xor_opad =
+                job_template->u.HMAC._hashed_auth_key_xor_opad =
                         (uint8_t *) opad;
-                job_template.hash_alg = (JOB_HASH_ALG) params->hash_alg;
+                job_template->hash_alg = (JOB_HASH_ALG) params->hash_alg;
                 break;
         }
-        job_template.auth_tag_output_len_in_bytes =
-                (uint64_t) auth_tag_length_bytes[job_template.hash_alg - 1];
+        job_template->auth_tag_output_len_in_bytes =
+                (uint64_t) auth_tag_length_bytes[job_template->hash_alg - 1];
 
-        job_template.cipher_direction = params->cipher_dir;
+        job_template->cipher_direction = params->cipher_dir;
+        job_template->sgl_io_segs = NULL;
+        job_template->num_sgl_io_segs = 0;
 
         if (params->cipher_mode == TEST_NULL_CIPHER) {
-                job_template.chain_order = IMB_ORDER_HASH_CIPHER;
+                job_template->chain_order = IMB_ORDER_HASH_CIPHER;
         } else if (params->cipher_mode == TEST_CCM ||
                    ((params->cipher_mode == TEST_AESDOCSIS ||
                      params->cipher_mode == TEST_AESDOCSIS8) &&
                     params->hash_alg == TEST_DOCSIS_CRC32)) {
-                if (job_template.cipher_direction == IMB_DIR_ENCRYPT)
-                        job_template.chain_order = IMB_ORDER_HASH_CIPHER;
+                if (job_template->cipher_direction == IMB_DIR_ENCRYPT)
+                        job_template->chain_order = IMB_ORDER_HASH_CIPHER;
                 else
-                        job_template.chain_order = IMB_ORDER_CIPHER_HASH;
+                        job_template->chain_order = IMB_ORDER_CIPHER_HASH;
         } else {
-                if (job_template.cipher_direction == IMB_DIR_ENCRYPT)
-                        job_template.chain_order = IMB_ORDER_CIPHER_HASH;
+                if (job_template->cipher_direction == IMB_DIR_ENCRYPT)
+                        job_template->chain_order = IMB_ORDER_CIPHER_HASH;
                 else
-                        job_template.chain_order = IMB_ORDER_HASH_CIPHER;
+                        job_template->chain_order = IMB_ORDER_HASH_CIPHER;
         }
 
         /* Translating enum to the API's one */
-        job_template.cipher_mode = translate_cipher_mode(params->cipher_mode);
-        job_template.key_len_in_bytes = params->aes_key_size;
-        if (job_template.cipher_mode == IMB_CIPHER_GCM) {
+        job_template->cipher_mode = translate_cipher_mode(params->cipher_mode);
+        job_template->key_len_in_bytes = params->aes_key_size;
+        if (job_template->cipher_mode == IMB_CIPHER_GCM) {
                 switch (params->aes_key_size) {
                 case IMB_KEY_AES_128_BYTES:
                         IMB_AES128_GCM_PRE(mb_mgr, gcm_key, &gdata_key);
@@ -1412,61 +1519,204 @@ do_test(IMB_MGR *mb_mgr, struct params_s *params,
                         IMB_AES256_GCM_PRE(mb_mgr, gcm_key, &gdata_key);
                         break;
                 }
-                job_template.enc_keys = &gdata_key;
-                job_template.dec_keys = &gdata_key;
-                job_template.u.GCM.aad_len_in_bytes = params->aad_size;
-                job_template.iv_len_in_bytes = 12;
-        } else if (job_template.cipher_mode == IMB_CIPHER_CCM) {
-                job_template.msg_len_to_cipher_in_bytes = size_aes;
-                job_template.msg_len_to_hash_in_bytes = size_aes;
-                job_template.hash_start_src_offset_in_bytes = 0;
-                job_template.cipher_start_src_offset_in_bytes = 0;
-                job_template.u.CCM.aad_len_in_bytes = params->aad_size;
-                job_template.iv_len_in_bytes = 13;
-        } else if (job_template.cipher_mode == IMB_CIPHER_DES ||
-                   job_template.cipher_mode == IMB_CIPHER_DOCSIS_DES) {
-                job_template.key_len_in_bytes = 8;
-                job_template.iv_len_in_bytes = 8;
-        } else if (job_template.cipher_mode == IMB_CIPHER_DES3) {
-                job_template.key_len_in_bytes = 24;
-                job_template.iv_len_in_bytes = 8;
-        } else if (job_template.cipher_mode == IMB_CIPHER_ZUC_EEA3) {
-                job_template.key_len_in_bytes = 16;
-                job_template.iv_len_in_bytes = 16;
-        } else if (job_template.cipher_mode == IMB_CIPHER_DOCSIS_SEC_BPI &&
-                   job_template.hash_alg == IMB_AUTH_DOCSIS_CRC32) {
+                job_template->enc_keys = &gdata_key;
+                job_template->dec_keys = &gdata_key;
+                job_template->u.GCM.aad_len_in_bytes = params->aad_size;
+                job_template->iv_len_in_bytes = 12;
+        } else if (job_template->cipher_mode == IMB_CIPHER_CCM) {
+                job_template->msg_len_to_cipher_in_bytes = size_aes;
+                job_template->msg_len_to_hash_in_bytes = size_aes;
+                job_template->hash_start_src_offset_in_bytes = 0;
+                job_template->cipher_start_src_offset_in_bytes = 0;
+                job_template->u.CCM.aad_len_in_bytes = params->aad_size;
+                job_template->iv_len_in_bytes = 13;
+        } else if (job_template->cipher_mode == IMB_CIPHER_DES ||
+                   job_template->cipher_mode == IMB_CIPHER_DOCSIS_DES) {
+                job_template->key_len_in_bytes = 8;
+                job_template->iv_len_in_bytes = 8;
+        } else if (job_template->cipher_mode == IMB_CIPHER_DES3) {
+                job_template->key_len_in_bytes = 24;
+                job_template->iv_len_in_bytes = 8;
+        } else if (job_template->cipher_mode == IMB_CIPHER_ZUC_EEA3) {
+                job_template->key_len_in_bytes = 16;
+                job_template->iv_len_in_bytes = 16;
+        } else if (job_template->cipher_mode == IMB_CIPHER_DOCSIS_SEC_BPI &&
+                   job_template->hash_alg == IMB_AUTH_DOCSIS_CRC32) {
                 const uint64_t ciph_adjust = /* SA + DA */
                         DOCSIS_CRC32_MIN_ETH_PDU_SIZE - 2 /* ETH TYPE */;
 
-                job_template.cipher_start_src_offset_in_bytes = ciph_adjust;
-                job_template.msg_len_to_cipher_in_bytes =
+                job_template->cipher_start_src_offset_in_bytes = ciph_adjust;
+                job_template->msg_len_to_cipher_in_bytes =
                         size_aes - ciph_adjust;
-                job_template.hash_start_src_offset_in_bytes = 0;
-                job_template.msg_len_to_hash_in_bytes =
+                job_template->hash_start_src_offset_in_bytes = 0;
+                job_template->msg_len_to_hash_in_bytes =
                         size_aes - DOCSIS_CRC32_TAG_SIZE;
-        } else if (job_template.cipher_mode == IMB_CIPHER_SNOW3G_UEA2_BITLEN) {
-                job_template.msg_len_to_cipher_in_bits =
-                        (job_template.msg_len_to_cipher_in_bytes * 8);
-                job_template.cipher_start_src_offset_in_bits = 0;
-                job_template.key_len_in_bytes = 16;
-                job_template.iv_len_in_bytes = 16;
-        } else if (job_template.cipher_mode == IMB_CIPHER_KASUMI_UEA1_BITLEN) {
-                job_template.msg_len_to_cipher_in_bits =
-                        (job_template.msg_len_to_cipher_in_bytes * 8);
-                job_template.cipher_start_src_offset_in_bits = 0;
-                job_template.key_len_in_bytes = 16;
-                job_template.iv_len_in_bytes = 8;
-        } else if (job_template.cipher_mode == IMB_CIPHER_ECB)
-                job_template.iv_len_in_bytes = 0;
-
-        if (job_template.hash_alg == IMB_AUTH_PON_CRC_BIP) {
+        } else if (job_template->cipher_mode ==
+                   IMB_CIPHER_SNOW3G_UEA2_BITLEN) {
+                job_template->msg_len_to_cipher_in_bits =
+                        (job_template->msg_len_to_cipher_in_bytes * 8);
+                job_template->cipher_start_src_offset_in_bits = 0;
+                job_template->key_len_in_bytes = 16;
+                job_template->iv_len_in_bytes = 16;
+        } else if (job_template->cipher_mode ==
+                   IMB_CIPHER_KASUMI_UEA1_BITLEN) {
+                job_template->msg_len_to_cipher_in_bits =
+                        (job_template->msg_len_to_cipher_in_bytes * 8);
+                job_template->cipher_start_src_offset_in_bits = 0;
+                job_template->key_len_in_bytes = 16;
+                job_template->iv_len_in_bytes = 8;
+        } else if (job_template->cipher_mode == IMB_CIPHER_ECB)
+                job_template->iv_len_in_bytes = 0;
+
+        /*
+         * With --stitch, ZUC and SNOW3G cipher + hash jobs are laid out
+         * as 3GPP PDUs: authentication covers a sha_size_incr byte
+         * header and the ciphered payload, so the combined ZUC and
+         * single pass SNOW3G paths are measured.
+         */
+        if (stitch &&
+            ((job_template->cipher_mode == IMB_CIPHER_ZUC_EEA3 &&
+              job_template->hash_alg == IMB_AUTH_ZUC_EIA3_BITLEN) ||
+             (job_template->cipher_mode == IMB_CIPHER_SNOW3G_UEA2_BITLEN &&
+              job_template->hash_alg == IMB_AUTH_SNOW3G_UIA2_BITLEN))) {
+                if (job_template->cipher_mode == IMB_CIPHER_ZUC_EEA3)
+                        job_template->cipher_start_src_offset_in_bytes =
+                                sha_size_incr;
+                else
+                        job_template->cipher_start_src_offset_in_bits =
+                                sha_size_incr * 8;
+
+                job_template->hash_start_src_offset_in_bytes = 0;
+                job_template->msg_len_to_hash_in_bits =
+                        (size_aes + sha_size_incr) * 8;
+        }
+
+        if (job_template->hash_alg == IMB_AUTH_PON_CRC_BIP) {
                 /* create XGEM header template */
                 const uint64_t pli =
-                        (job_template.msg_len_to_cipher_in_bytes << 2) & 0xffff;
+                        (job_template->msg_len_to_cipher_in_bytes << 2) &
+                        0xffff;
+
+                *xgem_hdr = ((pli >> 8) & 0xff) | ((pli & 0xff) << 8);
+        }
+}
+
+/* Fills job from template, with buffers and keys at given index */
+__forceinline void
+fill_job(IMB_JOB *job, const IMB_JOB *job_template, const uint64_t xgem_hdr,
+         const uint32_t index, uint8_t *p_buffer, imb_uint128_t *p_keys)
+{
+        *job = *job_template;
+
+        if (job->hash_alg == IMB_AUTH_PON_CRC_BIP) {
+                uint64_t *p_src = (uint64_t *) get_src_buffer(index, p_buffer);
 
-                xgem_hdr = ((pli >> 8) & 0xff) | ((pli & 0xff) << 8);
+                job->src = (const uint8_t *)p_src;
+                p_src[0] = xgem_hdr;
+        } else {
+                job->src = get_src_buffer(index, p_buffer);
+        }
+        job->dst = get_dst_buffer(index, p_buffer);
+        if (job->cipher_mode == IMB_CIPHER_GCM) {
+                job->u.GCM.aad = job->src;
+        } else if (job->cipher_mode == IMB_CIPHER_CCM) {
+                job->u.CCM.aad = job->src;
+                job->enc_keys = job->dec_keys =
+                        (const uint32_t *) get_key_pointer(index, p_keys);
+        } else if (job->cipher_mode == IMB_CIPHER_DES3) {
+                static const void *ks_ptr[3];
+
+                ks_ptr[0] = ks_ptr[1] = ks_ptr[2] =
+                        get_key_pointer(index, p_keys);
+                job->enc_keys = job->dec_keys = ks_ptr;
+        } else if (job->cipher_mode == IMB_CIPHER_XTS) {
+                /* same schedule used for data and tweak keys */
+                static const void *xts_ks_ptr[2];
+
+                xts_ks_ptr[0] = xts_ks_ptr[1] =
+                        get_key_pointer(index, p_keys);
+                job->enc_keys = job->dec_keys = xts_ks_ptr;
+        } else {
+                job->enc_keys = job->dec_keys =
+                        (const uint32_t *) get_key_pointer(index, p_keys);
+        }
+}
+
+/* Returns latency histogram bucket index for <val> cycles */
+__forceinline uint32_t lat_hist_idx(const uint64_t val)
+{
+        uint32_t msb, shift;
+
+        if (val < (1ULL << LAT_SUB_BUCKET_BITS))
+                return (uint32_t) val;
+
+#ifdef _WIN32
+        {
+                unsigned long idx;
+
+                _BitScanReverse64(&idx, val);
+                msb = (uint32_t) idx;
+        }
+#else
+        msb = 63 - (uint32_t) __builtin_clzll(val);
+#endif
+        shift = msb - LAT_SUB_BUCKET_BITS;
+
+        return ((shift + 1) << LAT_SUB_BUCKET_BITS) +
+                (uint32_t) ((val >> shift) &
+                            ((1ULL << LAT_SUB_BUCKET_BITS) - 1));
+}
+
+/* Returns highest value (in cycles) counted in histogram bucket <idx> */
+static uint64_t lat_hist_value(const uint32_t idx)
+{
+        const uint64_t sub_mask = (1ULL << LAT_SUB_BUCKET_BITS) - 1;
+        uint32_t shift;
+
+        if (idx < (1UL << LAT_SUB_BUCKET_BITS))
+                return idx;
+
+        shift = (idx >> LAT_SUB_BUCKET_BITS) - 1;
+        return ((((idx & sub_mask) | (sub_mask + 1)) + 1) << shift) - 1;
+}
+
+/* Returns latency (in cycles) at <permille> / 1000 percentile */
+static uint64_t
+lat_hist_percentile(const struct latency_hist_s *hist, const uint32_t permille)
+{
+        const uint64_t target = ((hist->total * permille) + 999) / 1000;
+        uint64_t count = 0;
+        uint32_t i;
+
+        for (i = 0; i < LAT_NUM_BUCKETS; i++) {
+                count += hist->counts[i];
+                if (count >= target && count != 0)
+                        return lat_hist_value(i);
         }
 
+        return 0;
+}
+
+/*
+ * Performs test timestamping each job at submission (in user_data)
+ * and adding the number of cycles until it gets returned by the manager
+ * to the latency histogram. The manager is flushed every <latency_load>
+ * jobs, unless it is 0.
+ */
+static uint64_t
+do_test_latency(IMB_MGR *mb_mgr, struct params_s *params,
+                const IMB_JOB *job_templates, const uint64_t *xgem_hdrs,
+                const uint32_t num_iter, uint32_t *p_index,
+                uint8_t *p_buffer, imb_uint128_t *p_keys)
+{
+        struct latency_hist_s *hist = params->lat_hist;
+        uint32_t index = *p_index;
+        uint32_t i, aux, load = 0;
+        uint64_t time, now;
+        IMB_JOB *job;
+
+        memset(hist, 0, sizeof(*hist));
+
 #ifndef _WIN32
         if (use_unhalted_cycles)
                 time = read_cycles(params->core);
@@ -1475,39 +1725,151 @@ do_test(IMB_MGR *mb_mgr, struct params_s *params,
                 time = __rdtscp(&aux);
 
         for (i = 0; i < num_iter; i++) {
+                const uint32_t t = (imix_num_sizes != 0) ?
+                        imix_list[i & (IMIX_LIST_SIZE - 1)] : 0;
+
                 job = IMB_GET_NEXT_JOB(mb_mgr);
-                *job = job_template;
+                fill_job(job, &job_templates[t], xgem_hdrs[t], index,
+                         p_buffer, p_keys);
+                index = get_next_index(index);
+
+                job->user_data = (void *) (uintptr_t) __rdtsc();
+#ifdef DEBUG
+                job = IMB_SUBMIT_JOB(mb_mgr);
+#else
+                job = IMB_SUBMIT_JOB_NOCHECK(mb_mgr);
+#endif
+                now = __rdtsc();
+                while (job) {
+                        hist->counts[lat_hist_idx(now -
+                                     (uint64_t)(uintptr_t) job->user_data)]++;
+                        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+                }
 
-                if (job->hash_alg == IMB_AUTH_PON_CRC_BIP) {
-                        uint64_t *p_src =
-                                (uint64_t *) get_src_buffer(index, p_buffer);
+                if (latency_load == 0 || ++load < latency_load)
+                        continue;
 
-                        job->src = (const uint8_t *)p_src;
-                        p_src[0] = xgem_hdr;
-                } else {
-                        job->src = get_src_buffer(index, p_buffer);
+                load = 0;
+                while ((job = IMB_FLUSH_JOB(mb_mgr))) {
+                        now = __rdtsc();
+                        hist->counts[lat_hist_idx(now -
+                                     (uint64_t)(uintptr_t) job->user_data)]++;
                 }
-                job->dst = get_dst_buffer(index, p_buffer);
-                if (job->cipher_mode == IMB_CIPHER_GCM) {
-                        job->u.GCM.aad = job->src;
-                } else if (job->cipher_mode == IMB_CIPHER_CCM) {
-                        job->u.CCM.aad = job->src;
-                        job->enc_keys = job->dec_keys =
-                                (const uint32_t *) get_key_pointer(index,
-                                                                   p_keys);
-                } else if (job->cipher_mode == IMB_CIPHER_DES3) {
-                        static const void *ks_ptr[3];
-
-                        ks_ptr[0] = ks_ptr[1] = ks_ptr[2] =
-                                get_key_pointer(index, p_keys);
-                        job->enc_keys =
-                                job->dec_keys = ks_ptr;
-                } else {
-                        job->enc_keys = job->dec_keys =
-                                (const uint32_t *) get_key_pointer(index,
-                                                                   p_keys);
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr))) {
+                now = __rdtsc();
+                hist->counts[lat_hist_idx(now -
+                             (uint64_t)(uintptr_t) job->user_data)]++;
+        }
+
+#ifndef _WIN32
+        if (use_unhalted_cycles)
+                time = (read_cycles(params->core) - rd_cycles_cost) - time;
+        else
+#endif
+                time = __rdtscp(&aux) - time;
+
+        hist->total = num_iter;
+        *p_index = index;
+
+        return time / num_iter;
+}
+
+/* State of completion callback (--completion-cb) */
+struct perf_cb_ctx_s {
+        struct latency_hist_s *hist; /* NULL if not latency test */
+        int errors;
+};
+
+/*
+ * Receives completed jobs instead of IMB_GET_COMPLETED_JOB()/
+ * IMB_FLUSH_JOB() loops (which then get no jobs)
+ */
+static void
+perf_completed_jobs(IMB_MGR *mb_mgr, IMB_JOB **jobs, const uint32_t num_jobs,
+                    void *cb_arg)
+{
+        struct perf_cb_ctx_s *ctx = (struct perf_cb_ctx_s *) cb_arg;
+        uint32_t i;
+
+        (void) mb_mgr;
+        if (ctx->hist != NULL) {
+                const uint64_t now = __rdtsc();
+
+                for (i = 0; i < num_jobs; i++)
+                        ctx->hist->counts[lat_hist_idx(now -
+                                (uint64_t)(uintptr_t) jobs[i]->user_data)]++;
+        }
+#ifdef DEBUG
+        for (i = 0; i < num_jobs; i++)
+                if (jobs[i]->status != STS_COMPLETED) {
+                        fprintf(stderr, "failed job, status:%d\n",
+                                jobs[i]->status);
+                        ctx->errors++;
                 }
+#endif
+}
+
+/* Performs test using AES_HMAC or DOCSIS */
+static uint64_t
+do_test(IMB_MGR *mb_mgr, struct params_s *params,
+        const uint32_t num_iter, uint8_t *p_buffer, imb_uint128_t *p_keys)
+{
+        IMB_JOB *job;
+        IMB_JOB job_templates[IMIX_MAX_SIZES];
+        uint64_t xgem_hdrs[IMIX_MAX_SIZES];
+        const uint32_t num_templates =
+                (imix_num_sizes != 0) ? imix_num_sizes : 1;
+        uint32_t i, burst = 0;
+        static uint32_t index = 0;
+        uint64_t time = 0;
+        uint32_t aux;
+        struct perf_cb_ctx_s cb_ctx;
+
+        /*
+         * With --imix, one template is prepared for each size
+         * of the distribution and jobs pick them from imix_list
+         */
+        for (i = 0; i < num_templates; i++) {
+                struct params_s tparams = *params;
+
+                if (imix_num_sizes != 0)
+                        tparams.size_aes = imix_sizes[i].size;
+
+                init_job_template(mb_mgr, &tparams, &job_templates[i],
+                                  &xgem_hdrs[i]);
+        }
+
+        if (completion_cb) {
+                cb_ctx.hist = latency_test ? params->lat_hist : NULL;
+                cb_ctx.errors = 0;
+                imb_set_completion_cb(mb_mgr, perf_completed_jobs, &cb_ctx);
+        }
+
+        if (latency_test) {
+                time = do_test_latency(mb_mgr, params, job_templates,
+                                       xgem_hdrs, num_iter, &index,
+                                       p_buffer, p_keys);
+                if (completion_cb)
+                        imb_set_completion_cb(mb_mgr, NULL, NULL);
+                return time;
+        }
+
+#ifndef _WIN32
+        if (use_unhalted_cycles)
+                time = read_cycles(params->core);
+        else
+#endif
+                time = __rdtscp(&aux);
 
+        for (i = 0; i < num_iter; i++) {
+                const uint32_t t = (imix_num_sizes != 0) ?
+                        imix_list[i & (IMIX_LIST_SIZE - 1)] : 0;
+
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                fill_job(job, &job_templates[t], xgem_hdrs[t], index,
+                         p_buffer, p_keys);
                 index = get_next_index(index);
 #ifdef DEBUG
                 job = IMB_SUBMIT_JOB(mb_mgr);
@@ -1524,6 +1886,11 @@ do_test(IMB_MGR *mb_mgr, struct params_s *params,
 #endif
                         job = IMB_GET_COMPLETED_JOB(mb_mgr);
                 }
+                /* with --safe-burst, registers are cleared once per burst */
+                if (safe_burst != 0 && ++burst == safe_burst) {
+                        IMB_CLEAR_SCRATCH(mb_mgr);
+                        burst = 0;
+                }
         }
 
         while ((job = IMB_FLUSH_JOB(mb_mgr))) {
@@ -1534,6 +1901,8 @@ do_test(IMB_MGR *mb_mgr, struct params_s *params,
                 }
 #endif
         }
+        if (safe_burst != 0)
+                IMB_CLEAR_SCRATCH(mb_mgr);
 
 #ifndef _WIN32
         if (use_unhalted_cycles)
@@ -1542,6 +1911,14 @@ do_test(IMB_MGR *mb_mgr, struct params_s *params,
 #endif
                 time = __rdtscp(&aux) - time;
 
+        if (completion_cb) {
+                imb_set_completion_cb(mb_mgr, NULL, NULL);
+#ifdef DEBUG
+                if (cb_ctx.errors != 0)
+                        return 1;
+#endif
+        }
+
         return time / num_iter;
 }
 
@@ -1607,7 +1984,9 @@ do_test_gcm(struct params_s *params,
                                                    &gdata_ctx,
                                                    pb,
                                                    pb,
-                                                   size_aes, iv,
+                                                   get_job_size(i,
+                                                                size_aes),
+                                                   iv,
                                                    aad, params->aad_size,
                                                    auth_tag, sizeof(auth_tag));
                                 index = get_next_index(index);
@@ -1620,7 +1999,9 @@ do_test_gcm(struct params_s *params,
                                                    &gdata_ctx,
                                                    pb,
                                                    pb,
-                                                   size_aes, iv,
+                                                   get_job_size(i,
+                                                                size_aes),
+                                                   iv,
                                                    aad, params->aad_size,
                                                    auth_tag, sizeof(auth_tag));
                                 index = get_next_index(index);
@@ -1633,7 +2014,9 @@ do_test_gcm(struct params_s *params,
                                                    &gdata_ctx,
                                                    pb,
                                                    pb,
-                                                   size_aes, iv,
+                                                   get_job_size(i,
+                                                                size_aes),
+                                                   iv,
                                                    aad, params->aad_size,
                                                    auth_tag, sizeof(auth_tag));
                                 index = get_next_index(index);
@@ -1662,7 +2045,9 @@ do_test_gcm(struct params_s *params,
                                                    &gdata_ctx,
                                                    pb,
                                                    pb,
-                                                   size_aes, iv,
+                                                   get_job_size(i,
+                                                                size_aes),
+                                                   iv,
                                                    aad, params->aad_size,
                                                    auth_tag, sizeof(auth_tag));
                                 index = get_next_index(index);
@@ -1675,7 +2060,9 @@ do_test_gcm(struct params_s *params,
                                                    &gdata_ctx,
                                                    pb,
                                                    pb,
-                                                   size_aes, iv,
+                                                   get_job_size(i,
+                                                                size_aes),
+                                                   iv,
                                                    aad, params->aad_size,
                                                    auth_tag, sizeof(auth_tag));
                                 index = get_next_index(index);
@@ -1688,7 +2075,9 @@ do_test_gcm(struct params_s *params,
                                                    &gdata_ctx,
                                                    pb,
                                                    pb,
-                                                   size_aes, iv,
+                                                   get_job_size(i,
+                                                                size_aes),
+                                                   iv,
                                                    aad, params->aad_size,
                                                    auth_tag, sizeof(auth_tag));
                                 index = get_next_index(index);
@@ -1753,11 +2142,17 @@ process_variant(IMB_MGR *mgr, const uint32_t arch, struct params_s *params,
 {
         const uint32_t sizes = params->num_sizes;
         uint64_t *times = &variant_ptr->avg_times[run];
+        uint64_t *lat_pcts =
+                latency_test ? &variant_ptr->lat_pcts[run] : NULL;
+        uint64_t *pmu_ctrs = (variant_ptr->pmu_ctrs != NULL) ?
+                &variant_ptr->pmu_ctrs[run] : NULL;
         uint32_t sz;
 
         for (sz = 0; sz < sizes; sz++) {
-                const uint32_t size_aes = job_sizes[RANGE_MIN] +
-                                        (sz * job_sizes[RANGE_STEP]);
+                /* IMIX runs use average size to set number of iterations */
+                const uint32_t size_aes = (imix_num_sizes != 0) ?
+                        (uint32_t) imix_avg_size :
+                        job_sizes[RANGE_MIN] + (sz * job_sizes[RANGE_STEP]);
                 uint32_t num_iter;
 
                 params->aad_size = 0;
@@ -1781,23 +2176,42 @@ process_variant(IMB_MGR *mgr, const uint32_t arch, struct params_s *params,
                 else
                         num_iter = iter_scale;
 
+                if (job_iter != 0)
+                        num_iter = job_iter;
+                else if (params->cipher_mode == TEST_GCM && !use_gcm_job_api)
+                        num_iter *= 2;
+
                 params->size_aes = size_aes;
-                if (params->cipher_mode == TEST_GCM && (!use_gcm_job_api)) {
-                        if (job_iter == 0)
-                                *times = do_test_gcm(params, 2 * num_iter, mgr,
-                                                     p_buffer, p_keys);
-                        else
-                                *times = do_test_gcm(params, job_iter, mgr,
-                                                     p_buffer, p_keys);
-                } else {
-                        if (job_iter == 0)
-                                *times = do_test(mgr, params, num_iter,
-                                                 p_buffer, p_keys);
-                        else
-                                *times = do_test(mgr, params, job_iter,
-                                                 p_buffer, p_keys);
-                }
+                if (pmu_ctrs != NULL)
+                        pmu_start();
+                if (params->cipher_mode == TEST_GCM && (!use_gcm_job_api))
+                        *times = do_test_gcm(params, num_iter, mgr,
+                                             p_buffer, p_keys);
+                else
+                        *times = do_test(mgr, params, num_iter,
+                                         p_buffer, p_keys);
                 times += NUM_RUNS;
+
+                if (pmu_ctrs != NULL) {
+                        uint64_t ctrs[PMU_NUM_CTRS];
+                        uint32_t ctr;
+
+                        pmu_stop(ctrs);
+                        for (ctr = 0; ctr < PMU_NUM_CTRS; ctr++)
+                                pmu_ctrs[ctr * sizes * NUM_RUNS] =
+                                        (ctrs[ctr] * PMU_SCALE) / num_iter;
+                        pmu_ctrs += NUM_RUNS;
+                }
+
+                if (latency_test) {
+                        uint32_t pct;
+
+                        for (pct = 0; pct < NUM_LAT_PCTS; pct++)
+                                lat_pcts[pct * sizes * NUM_RUNS] =
+                                        lat_hist_percentile(params->lat_hist,
+                                                lat_pcts_permille[pct]);
+                        lat_pcts += NUM_RUNS;
+                }
         }
 
         variant_ptr->params = *params;
@@ -1995,94 +2409,562 @@ run_dir_test(IMB_MGR *mgr, const uint32_t arch, struct params_s *params,
         }
 }
 
-/* Generates output containing averaged times for each test variant */
+/*
+ * Generates output for IMIX runs: cycles per packet, cycles per byte
+ * and packets per second for each test variant
+ */
 static void
-print_times(struct variant_s *variant_list, struct params_s *params,
-            const uint32_t total_variants, uint8_t *p_buffer,
-            imb_uint128_t *p_keys)
+print_imix_times(struct variant_s *variant_list, const uint32_t total_variants,
+                 uint8_t *p_buffer, imb_uint128_t *p_keys)
 {
-        const uint32_t sizes = params->num_sizes;
-        uint32_t col;
-        uint32_t sz;
-
-        /* Temporary variables */
-        struct params_s par;
-        uint8_t	c_mode;
-        uint8_t c_dir;
-        uint8_t h_alg;
-        const char *func_names[4] = {
-                "SSE", "AVX", "AVX2", "AVX512"
+        const char *row_names[3] = {
+                "IMIX", "CYCLES/BYTE", "PKTS/SEC"
         };
-        const char *c_mode_names[TEST_NUM_CIPHER_TESTS - 1] = {
-                "CBC", "CNTR", "CNTR+8", "CNTR_BITLEN", "CNTR_BITLEN4", "ECB",
-                "NULL_CIPHER", "DOCAES", "DOCAES+8", "DOCDES", "DOCDES+4",
-                "GCM", "CCM", "DES", "3DES", "PON", "PON_NO_CTR", "ZUC_EEA3",
-                "SNOW3G_UEA2_BITLEN", "KASUMI_UEA1_BITLEN"
-        };
-        const char *c_dir_names[2] = {
-                "ENCRYPT", "DECRYPT"
-        };
-        const char *h_alg_names[TEST_NUM_HASH_TESTS - 1] = {
-                "SHA1", "SHA_224", "SHA_256", "SHA_384", "SHA_512", "XCBC",
-                "MD5", "CMAC", "CMAC_BITLEN", "NULL_HASH", "CRC32",
-                "GCM", "CUSTOM", "CCM", "BIP-CRC32", "ZUC_EIA3_BITLEN",
-                "SNOW3G_UIA2_BITLEN", "KASUMI_UIA1", "CMAC_256"
-        };
-        printf("ARCH");
-        for (col = 0; col < total_variants; col++)
-                printf("\t%s", func_names[variant_list[col].arch]);
-        printf("\n");
-        printf("CIPHER");
-        for (col = 0; col < total_variants; col++) {
-                par = variant_list[col].params;
-                c_mode = par.cipher_mode - TEST_CBC;
-                printf("\t%s", c_mode_names[c_mode]);
-        }
-        printf("\n");
-        printf("DIR");
-        for (col = 0; col < total_variants; col++) {
-                par = variant_list[col].params;
-                c_dir = par.cipher_dir - IMB_DIR_ENCRYPT;
-                printf("\t%s", c_dir_names[c_dir]);
-        }
-        printf("\n");
-        printf("HASH_ALG");
-        for (col = 0; col < total_variants; col++) {
-                par = variant_list[col].params;
-                h_alg = par.hash_alg - TEST_SHA1;
-                printf("\t%s", h_alg_names[h_alg]);
-        }
-        printf("\n");
-        printf("KEY_SIZE");
-        for (col = 0; col < total_variants; col++) {
-                par = variant_list[col].params;
-                printf("\tAES-%u", par.aes_key_size * 8);
-        }
-        printf("\n");
-        for (sz = 0; sz < sizes; sz++) {
-                printf("%d", job_sizes[RANGE_MIN] +
-                             (sz * job_sizes[RANGE_STEP]));
-                for (col = 0; col < total_variants; col++) {
-                        uint64_t *time_ptr =
-                                &variant_list[col].avg_times[sz * NUM_RUNS];
-                        const unsigned long long val =
-                                mean_median(time_ptr, NUM_RUNS,
-                                            p_buffer, p_keys);
+        uint32_t row, col;
 
-                        printf("\t%llu", val);
+        for (row = 0; row < DIM(row_names); row++) {
+                printf("%s", row_names[row]);
+                for (col = 0; col < total_variants; col++) {
+                        const uint64_t val =
+                                mean_median(variant_list[col].avg_times,
+                                            NUM_RUNS, p_buffer, p_keys);
+
+                        if (row == 0)
+                                printf("\t%"PRIu64, val);
+                        else if (row == 1)
+                                printf("\t%.2f",
+                                       (double) val / imix_avg_size);
+                        else
+                                printf("\t%.0f", (val != 0) ?
+                                       tsc_freq / (double) val : 0.0);
                 }
                 printf("\n");
         }
 }
 
-/* Prepares data structure for test variants storage, sets test configuration */
-#ifdef _WIN32
-static void
-#else
-static void *
-#endif
-run_tests(void *arg)
-{
+/* Names used in the output for test variant parameters */
+static const char *func_names[4] = {
+        "SSE", "AVX", "AVX2", "AVX512"
+};
+static const char *c_mode_names[TEST_NUM_CIPHER_TESTS - 1] = {
+        "CBC", "CNTR", "CNTR+8", "CNTR_BITLEN", "CNTR_BITLEN4", "ECB",
+        "NULL_CIPHER", "DOCAES", "DOCAES+8", "DOCDES", "DOCDES+4",
+        "GCM", "CCM", "DES", "3DES", "PON", "PON_NO_CTR", "ZUC_EEA3",
+        "SNOW3G_UEA2_BITLEN", "KASUMI_UEA1_BITLEN", "CFB",
+        "XTS"
+};
+static const char *c_dir_names[2] = {
+        "ENCRYPT", "DECRYPT"
+};
+static const char *h_alg_names[TEST_NUM_HASH_TESTS - 1] = {
+        "SHA1", "SHA_224", "SHA_256", "SHA_384", "SHA_512", "XCBC",
+        "MD5", "CMAC", "CMAC_BITLEN", "NULL_HASH", "CRC32",
+        "GCM", "CUSTOM", "CCM", "BIP-CRC32", "ZUC_EIA3_BITLEN",
+        "SNOW3G_UIA2_BITLEN", "KASUMI_UIA1", "CMAC_256"
+};
+/*
+ * PMU counter names for text output and for JSON/CSV output,
+ * last entry is IPC derived from instructions and cycles
+ */
+#define PMU_IPC PMU_NUM_CTRS
+
+static const char *pmu_ctr_names[PMU_NUM_CTRS + 1] = {
+        "CYCLES", "INSTRUCTIONS", "REF_CYCLES", "L1D_MISSES", "LLC_MISSES",
+        "BRANCH_MISSES", "IPC"
+};
+
+static const char *pmu_ctr_keys[PMU_NUM_CTRS + 1] = {
+        "cycles", "instructions", "ref_cycles", "l1d_misses", "llc_misses",
+        "branch_misses", "ipc"
+};
+
+static const char *lat_pct_names[NUM_LAT_PCTS] = {
+        "P50", "P90", "P99", "P99.9"
+};
+
+static const struct {
+        const char *name;
+        uint64_t feature;
+} feature_names[] = {
+        { "SHANI", IMB_FEATURE_SHANI },
+        { "AESNI", IMB_FEATURE_AESNI },
+        { "PCLMULQDQ", IMB_FEATURE_PCLMULQDQ },
+        { "CMOV", IMB_FEATURE_CMOV },
+        { "SSE4_2", IMB_FEATURE_SSE4_2 },
+        { "AVX", IMB_FEATURE_AVX },
+        { "AVX2", IMB_FEATURE_AVX2 },
+        { "AVX512F", IMB_FEATURE_AVX512F },
+        { "AVX512DQ", IMB_FEATURE_AVX512DQ },
+        { "AVX512CD", IMB_FEATURE_AVX512CD },
+        { "AVX512BW", IMB_FEATURE_AVX512BW },
+        { "AVX512VL", IMB_FEATURE_AVX512VL },
+        { "VAES", IMB_FEATURE_VAES },
+        { "VPCLMULQDQ", IMB_FEATURE_VPCLMULQDQ },
+        { "SAFE_DATA", IMB_FEATURE_SAFE_DATA },
+        { "SAFE_PARAM", IMB_FEATURE_SAFE_PARAM },
+        { "GFNI", IMB_FEATURE_GFNI }
+};
+
+/* Statistics of the per run samples of one variant and job size */
+struct run_stats_s {
+        uint64_t min;
+        uint64_t max;
+        double mean;
+        double variance; /* sample variance */
+};
+
+static void
+get_run_stats(const uint64_t *samples, const uint32_t num,
+              struct run_stats_s *stats)
+{
+        double sum = 0.0, sq_sum = 0.0;
+        uint32_t i;
+
+        stats->min = samples[0];
+        stats->max = samples[0];
+        for (i = 0; i < num; i++) {
+                if (samples[i] < stats->min)
+                        stats->min = samples[i];
+                if (samples[i] > stats->max)
+                        stats->max = samples[i];
+                sum += (double) samples[i];
+        }
+        stats->mean = sum / num;
+
+        for (i = 0; i < num; i++) {
+                const double diff = (double) samples[i] - stats->mean;
+
+                sq_sum += diff * diff;
+        }
+        stats->variance = (num > 1) ? (sq_sum / (num - 1)) : 0.0;
+}
+
+/* Checks if PMU counter <ctr> (or PMU_IPC) was collected */
+static int
+pmu_ctr_valid(const uint32_t ctr)
+{
+        if (ctr == PMU_IPC)
+                return pmu_available(PMU_CYCLES) &&
+                        pmu_available(PMU_INSTRUCTIONS);
+
+        return pmu_available((enum pmu_ctr) ctr);
+}
+
+/* Returns per job value of PMU counter <ctr> (or PMU_IPC) for job size <sz> */
+static double
+get_pmu_value(struct variant_s *variant, const uint32_t sizes,
+              const uint32_t ctr, const uint32_t sz, uint8_t *p_buffer,
+              imb_uint128_t *p_keys)
+{
+        double cycles;
+
+        if (ctr != PMU_IPC)
+                return (double) mean_median(&variant->pmu_ctrs[
+                                                    ((ctr * sizes) + sz) *
+                                                    NUM_RUNS],
+                                            NUM_RUNS, p_buffer, p_keys) /
+                        PMU_SCALE;
+
+        cycles = get_pmu_value(variant, sizes, PMU_CYCLES, sz,
+                               p_buffer, p_keys);
+        if (cycles == 0.0)
+                return 0.0;
+
+        return get_pmu_value(variant, sizes, PMU_INSTRUCTIONS, sz,
+                             p_buffer, p_keys) / cycles;
+}
+
+/* Returns job size label of size number <sz> ("IMIX" for IMIX runs) */
+static const char *get_size_str(const uint32_t sz, char *buf,
+                                const size_t buf_size)
+{
+        if (imix_num_sizes != 0)
+                return "IMIX";
+
+        snprintf(buf, buf_size, "%u", job_sizes[RANGE_MIN] +
+                 (sz * job_sizes[RANGE_STEP]));
+        return buf;
+}
+
+/* Prints run configuration as "<prefix><name><sep><value><suffix>" lines */
+static void
+print_metadata(const char *prefix, const char *sep, const char *suffix,
+               const int json)
+{
+        const char *q = json ? "\"" : "";
+        const char *list_sep = "";
+        uint32_t i;
+
+        printf("%stool%s%sipsec_perf%s%s\n", prefix, sep, q, q, suffix);
+        printf("%slibrary_version%s%s%s%s%s\n", prefix, sep, q,
+               imb_get_version_str(), q, suffix);
+        printf("%sfeatures%s%s", prefix, sep, json ? "[" : "");
+        for (i = 0; i < DIM(feature_names); i++) {
+                if ((mgr_features & feature_names[i].feature) == 0)
+                        continue;
+                printf("%s%s%s%s", list_sep, q, feature_names[i].name, q);
+                list_sep = json ? ", " : " ";
+        }
+        printf("%s%s\n", json ? "]" : "", suffix);
+        printf("%sflags%s%s0x%"PRIx64"%s%s\n", prefix, sep, q, flags, q,
+               suffix);
+        printf("%scache%s%s%s%s%s\n", prefix, sep, q,
+               (cache_type == WARM) ? "warm" : "cold", q, suffix);
+        printf("%ssha_size_incr%s%u%s\n", prefix, sep, sha_size_incr,
+               suffix);
+        printf("%sgcm_aad_size%s%"PRIu64"%s\n", prefix, sep, gcm_aad_size,
+               suffix);
+        printf("%sccm_aad_size%s%"PRIu64"%s\n", prefix, sep, ccm_aad_size,
+               suffix);
+        printf("%sgcm_job_api%s%d%s\n", prefix, sep, use_gcm_job_api, suffix);
+        printf("%sstitch%s%d%s\n", prefix, sep, stitch, suffix);
+        printf("%sunhalted_cycles%s%d%s\n", prefix, sep, use_unhalted_cycles,
+               suffix);
+        printf("%siter_scale%s%u%s\n", prefix, sep, iter_scale, suffix);
+        printf("%sjob_iter%s%u%s\n", prefix, sep, job_iter, suffix);
+        printf("%sruns%s%u%s\n", prefix, sep, NUM_RUNS, suffix);
+        if (imix_num_sizes != 0) {
+                printf("%simix%s%s", prefix, sep, q);
+                for (i = 0; i < imix_num_sizes; i++)
+                        printf("%s%u:%u", (i == 0) ? "" : ",",
+                               imix_sizes[i].size, imix_sizes[i].weight);
+                printf("%s%s\n", q, suffix);
+                printf("%simix_avg_size%s%.1f%s\n", prefix, sep,
+                       imix_avg_size, suffix);
+        }
+        if (latency_test)
+                printf("%slatency_load%s%u%s\n", prefix, sep, latency_load,
+                       suffix);
+        if (pmu_test)
+                printf("%spmu%s1%s\n", prefix, sep, suffix);
+        if (safe_burst != 0)
+                printf("%ssafe_burst%s%u%s\n", prefix, sep, safe_burst,
+                       suffix);
+        if (completion_cb)
+                printf("%scompletion_cb%s1%s\n", prefix, sep, suffix);
+}
+
+/*
+ * Generates JSON output with run configuration and, for each test
+ * variant and job size, all run samples and their statistics
+ */
+static void
+print_times_json(struct variant_s *variant_list, const uint32_t sizes,
+                 const uint32_t total_variants, uint8_t *p_buffer,
+                 imb_uint128_t *p_keys)
+{
+        uint32_t col, sz, run, pct, ctr;
+        int first = 1;
+
+        printf("{\n");
+        print_metadata("  \"", "\": ", ",", 1);
+        printf("  \"results\": [");
+        for (col = 0; col < total_variants; col++) {
+                const struct params_s *par = &variant_list[col].params;
+
+                for (sz = 0; sz < sizes; sz++) {
+                        uint64_t *time_ptr =
+                                &variant_list[col].avg_times[sz * NUM_RUNS];
+                        struct run_stats_s stats;
+                        char size_buf[16];
+
+                        get_run_stats(time_ptr, NUM_RUNS, &stats);
+
+                        printf("%s\n    {\"arch\": \"%s\", "
+                               "\"cipher\": \"%s\", \"dir\": \"%s\", "
+                               "\"hash\": \"%s\", \"key_size\": %u, "
+                               "\"size\": %s%s%s,\n",
+                               first ? "" : ",",
+                               func_names[variant_list[col].arch],
+                               c_mode_names[par->cipher_mode - TEST_CBC],
+                               c_dir_names[par->cipher_dir - IMB_DIR_ENCRYPT],
+                               h_alg_names[par->hash_alg - TEST_SHA1],
+                               par->aes_key_size * 8,
+                               (imix_num_sizes != 0) ? "\"" : "",
+                               get_size_str(sz, size_buf, sizeof(size_buf)),
+                               (imix_num_sizes != 0) ? "\"" : "");
+                        first = 0;
+                        printf("     \"samples\": [");
+                        for (run = 0; run < NUM_RUNS; run++)
+                                printf("%s%"PRIu64, (run == 0) ? "" : ", ",
+                                       time_ptr[run]);
+                        printf("],\n");
+                        printf("     \"min\": %"PRIu64", \"max\": %"PRIu64
+                               ", \"mean\": %.2f, \"variance\": %.2f, "
+                               "\"cycles\": %"PRIu64,
+                               stats.min, stats.max, stats.mean,
+                               stats.variance,
+                               mean_median(time_ptr, NUM_RUNS, p_buffer,
+                                           p_keys));
+                        if (latency_test) {
+                                printf(",\n     \"latency\": {");
+                                for (pct = 0; pct < NUM_LAT_PCTS; pct++) {
+                                        uint64_t *lat_ptr =
+                                                &variant_list[col].lat_pcts[
+                                                        ((pct * sizes) + sz) *
+                                                        NUM_RUNS];
+
+                                        printf("%s\"%s\": %"PRIu64,
+                                               (pct == 0) ? "" : ", ",
+                                               lat_pct_names[pct],
+                                               mean_median(lat_ptr, NUM_RUNS,
+                                                           p_buffer, p_keys));
+                                }
+                                printf("}");
+                        }
+                        if (pmu_test) {
+                                const char *pmu_sep = "";
+
+                                printf(",\n     \"pmu\": {");
+                                for (ctr = 0; ctr <= PMU_IPC; ctr++) {
+                                        if (!pmu_ctr_valid(ctr))
+                                                continue;
+                                        printf("%s\"%s\": %.2f", pmu_sep,
+                                               pmu_ctr_keys[ctr],
+                                               get_pmu_value(
+                                                       &variant_list[col],
+                                                       sizes, ctr, sz,
+                                                       p_buffer, p_keys));
+                                        pmu_sep = ", ";
+                                }
+                                printf("}");
+                        }
+                        printf("}");
+                }
+        }
+        printf("\n  ]\n}\n");
+}
+
+/*
+ * Generates CSV output, one line for each test variant and job size,
+ * preceded by run configuration in "# name=value" comment lines
+ */
+static void
+print_times_csv(struct variant_s *variant_list, const uint32_t sizes,
+                const uint32_t total_variants, uint8_t *p_buffer,
+                imb_uint128_t *p_keys)
+{
+        uint32_t col, sz, pct, ctr;
+
+        print_metadata("# ", "=", "", 0);
+        printf("arch,cipher,dir,hash,key_size,size,runs,min,max,mean,"
+               "variance,cycles");
+        if (latency_test)
+                for (pct = 0; pct < NUM_LAT_PCTS; pct++)
+                        printf(",latency_%s", lat_pct_names[pct]);
+        if (pmu_test)
+                for (ctr = 0; ctr <= PMU_IPC; ctr++)
+                        if (pmu_ctr_valid(ctr))
+                                printf(",pmu_%s", pmu_ctr_keys[ctr]);
+        printf("\n");
+
+        for (col = 0; col < total_variants; col++) {
+                const struct params_s *par = &variant_list[col].params;
+
+                for (sz = 0; sz < sizes; sz++) {
+                        uint64_t *time_ptr =
+                                &variant_list[col].avg_times[sz * NUM_RUNS];
+                        struct run_stats_s stats;
+                        char size_buf[16];
+
+                        get_run_stats(time_ptr, NUM_RUNS, &stats);
+                        printf("%s,%s,%s,%s,%u,%s,%u,%"PRIu64",%"PRIu64
+                               ",%.2f,%.2f,%"PRIu64,
+                               func_names[variant_list[col].arch],
+                               c_mode_names[par->cipher_mode - TEST_CBC],
+                               c_dir_names[par->cipher_dir - IMB_DIR_ENCRYPT],
+                               h_alg_names[par->hash_alg - TEST_SHA1],
+                               par->aes_key_size * 8,
+                               get_size_str(sz, size_buf, sizeof(size_buf)),
+                               NUM_RUNS, stats.min, stats.max, stats.mean,
+                               stats.variance,
+                               mean_median(time_ptr, NUM_RUNS, p_buffer,
+                                           p_keys));
+                        if (latency_test)
+                                for (pct = 0; pct < NUM_LAT_PCTS; pct++) {
+                                        uint64_t *lat_ptr =
+                                                &variant_list[col].lat_pcts[
+                                                        ((pct * sizes) + sz) *
+                                                        NUM_RUNS];
+
+                                        printf(",%"PRIu64,
+                                               mean_median(lat_ptr, NUM_RUNS,
+                                                           p_buffer, p_keys));
+                                }
+                        if (pmu_test)
+                                for (ctr = 0; ctr <= PMU_IPC; ctr++)
+                                        if (pmu_ctr_valid(ctr))
+                                                printf(",%.2f",
+                                                       get_pmu_value(
+                                                       &variant_list[col],
+                                                       sizes, ctr, sz,
+                                                       p_buffer, p_keys));
+                        printf("\n");
+                }
+        }
+}
+
+/*
+ * Generates output containing latency percentiles (in cycles)
+ * for each test variant and job size
+ */
+static void
+print_latency_times(struct variant_s *variant_list, const uint32_t sizes,
+                    const uint32_t total_variants, uint8_t *p_buffer,
+                    imb_uint128_t *p_keys)
+{
+        uint32_t pct, col, sz;
+
+        for (pct = 0; pct < NUM_LAT_PCTS; pct++) {
+                printf("LATENCY_%s\n", lat_pct_names[pct]);
+                for (sz = 0; sz < sizes; sz++) {
+                        if (imix_num_sizes != 0)
+                                printf("IMIX");
+                        else
+                                printf("%d", job_sizes[RANGE_MIN] +
+                                             (sz * job_sizes[RANGE_STEP]));
+                        for (col = 0; col < total_variants; col++) {
+                                uint64_t *lat_ptr =
+                                        &variant_list[col].lat_pcts[
+                                                ((pct * sizes) + sz) *
+                                                NUM_RUNS];
+                                const unsigned long long val =
+                                        mean_median(lat_ptr, NUM_RUNS,
+                                                    p_buffer, p_keys);
+
+                                printf("\t%llu", val);
+                        }
+                        printf("\n");
+                }
+        }
+}
+
+/*
+ * Generates output containing hardware counter values per job
+ * for each test variant and job size
+ */
+static void
+print_pmu_times(struct variant_s *variant_list, const uint32_t sizes,
+                const uint32_t total_variants, uint8_t *p_buffer,
+                imb_uint128_t *p_keys)
+{
+        uint32_t ctr, col, sz;
+
+        for (ctr = 0; ctr <= PMU_IPC; ctr++) {
+                if (!pmu_ctr_valid(ctr))
+                        continue;
+                printf("PMU_%s\n", pmu_ctr_names[ctr]);
+                for (sz = 0; sz < sizes; sz++) {
+                        if (imix_num_sizes != 0)
+                                printf("IMIX");
+                        else
+                                printf("%d", job_sizes[RANGE_MIN] +
+                                             (sz * job_sizes[RANGE_STEP]));
+                        for (col = 0; col < total_variants; col++)
+                                printf("\t%.2f",
+                                       get_pmu_value(&variant_list[col],
+                                                     sizes, ctr, sz,
+                                                     p_buffer, p_keys));
+                        printf("\n");
+                }
+        }
+}
+
+/* Generates output containing averaged times for each test variant */
+static void
+print_times(struct variant_s *variant_list, struct params_s *params,
+            const uint32_t total_variants, uint8_t *p_buffer,
+            imb_uint128_t *p_keys)
+{
+        const uint32_t sizes = params->num_sizes;
+        uint32_t col;
+        uint32_t sz;
+
+        /* Temporary variables */
+        struct params_s par;
+        uint8_t	c_mode;
+        uint8_t c_dir;
+        uint8_t h_alg;
+
+        if (output_format == OUTPUT_JSON) {
+                print_times_json(variant_list, sizes, total_variants,
+                                 p_buffer, p_keys);
+                return;
+        }
+        if (output_format == OUTPUT_CSV) {
+                print_times_csv(variant_list, sizes, total_variants,
+                                p_buffer, p_keys);
+                return;
+        }
+
+        printf("ARCH");
+        for (col = 0; col < total_variants; col++)
+                printf("\t%s", func_names[variant_list[col].arch]);
+        printf("\n");
+        printf("CIPHER");
+        for (col = 0; col < total_variants; col++) {
+                par = variant_list[col].params;
+                c_mode = par.cipher_mode - TEST_CBC;
+                printf("\t%s", c_mode_names[c_mode]);
+        }
+        printf("\n");
+        printf("DIR");
+        for (col = 0; col < total_variants; col++) {
+                par = variant_list[col].params;
+                c_dir = par.cipher_dir - IMB_DIR_ENCRYPT;
+                printf("\t%s", c_dir_names[c_dir]);
+        }
+        printf("\n");
+        printf("HASH_ALG");
+        for (col = 0; col < total_variants; col++) {
+                par = variant_list[col].params;
+                h_alg = par.hash_alg - TEST_SHA1;
+                printf("\t%s", h_alg_names[h_alg]);
+        }
+        printf("\n");
+        printf("KEY_SIZE");
+        for (col = 0; col < total_variants; col++) {
+                par = variant_list[col].params;
+                printf("\tAES-%u", par.aes_key_size * 8);
+        }
+        printf("\n");
+        if (imix_num_sizes != 0) {
+                print_imix_times(variant_list, total_variants, p_buffer,
+                                 p_keys);
+        } else {
+                for (sz = 0; sz < sizes; sz++) {
+                        printf("%d", job_sizes[RANGE_MIN] +
+                                     (sz * job_sizes[RANGE_STEP]));
+                        for (col = 0; col < total_variants; col++) {
+                                uint64_t *time_ptr =
+                                        &variant_list[col].avg_times[sz *
+                                                                NUM_RUNS];
+                                const unsigned long long val =
+                                        mean_median(time_ptr, NUM_RUNS,
+                                                    p_buffer, p_keys);
+
+                                printf("\t%llu", val);
+                        }
+                        printf("\n");
+                }
+        }
+
+        if (latency_test)
+                print_latency_times(variant_list, sizes, total_variants,
+                                    p_buffer, p_keys);
+        if (pmu_test)
+                print_pmu_times(variant_list, sizes, total_variants,
+                                p_buffer, p_keys);
+}
+
+/* Prepares data structure for test variants storage, sets test configuration */
+#ifdef _WIN32
+static void
+#else
+static void *
+#endif
+run_tests(void *arg)
+{
         uint32_t i;
         struct thread_info *info = (struct thread_info *)arg;
         IMB_MGR *p_mgr = NULL;
@@ -2102,9 +2984,13 @@ run_tests(void *arg)
 
         p_mgr = info->p_mgr;
 
-        params.num_sizes = ((max_size - min_size) / step_size) + 1;
+        if (imix_num_sizes != 0)
+                params.num_sizes = 1;
+        else
+                params.num_sizes = ((max_size - min_size) / step_size) + 1;
 
         params.core = (uint32_t)info->core;
+        params.lat_hist = NULL;
 
         /* if cores selected then set affinity */
         if (core_mask)
@@ -2138,6 +3024,15 @@ run_tests(void *arg)
                                 (unsigned long)rd_cycles_cost);
         }
 
+        if (pmu_test && info->print_info) {
+                if (pmu_init() != PMU_RETVAL_OK) {
+                        fprintf(stderr, "Failed to open hardware "
+                                "counters, check "
+                                "/proc/sys/kernel/perf_event_paranoid\n");
+                        goto exit_failure;
+                }
+        }
+
         init_mem(&buf, &keys);
 
         for (type = TTYPE_AES_HMAC; type < NUM_TTYPES; type++) {
@@ -2200,105 +3095,2360 @@ run_tests(void *arg)
                         break;
                 }
 
-                /* Calculating number of all variants */
-                for (arch = 0; arch < max_arch; arch++) {
-                        if (archs[arch] == 0)
-                                continue;
-                        num_variants[type] += variants_per_arch;
-                }
-                total_variants += num_variants[type];
-        }
+                /* Calculating number of all variants */
+                for (arch = 0; arch < max_arch; arch++) {
+                        if (archs[arch] == 0)
+                                continue;
+                        num_variants[type] += variants_per_arch;
+                }
+                total_variants += num_variants[type];
+        }
+
+        if (total_variants == 0) {
+                fprintf(stderr, "No tests to be run\n");
+                goto exit;
+        }
+
+        if (info->print_info && !silent_progress_bar)
+                fprintf(stderr, "Total number of combinations (algos, "
+                        "key sizes, cipher directions) to test = %u\n",
+                        total_variants);
+
+        variant_list = (struct variant_s *)
+                calloc(total_variants, sizeof(struct variant_s));
+        if (variant_list == NULL) {
+                fprintf(stderr, "Cannot allocate memory\n");
+                goto exit_failure;
+        }
+
+        if (latency_test) {
+                params.lat_hist = (struct latency_hist_s *)
+                        malloc(sizeof(struct latency_hist_s));
+                if (params.lat_hist == NULL) {
+                        fprintf(stderr, "Cannot allocate memory\n");
+                        goto exit_failure;
+                }
+        }
+
+        at_size = NUM_RUNS * params.num_sizes * sizeof(uint64_t);
+        for (variant = 0, variant_ptr = variant_list;
+             variant < total_variants;
+             variant++, variant_ptr++) {
+                variant_ptr->avg_times = (uint64_t *) malloc(at_size);
+                if (!variant_ptr->avg_times) {
+                        fprintf(stderr, "Cannot allocate memory\n");
+                        goto exit_failure;
+                }
+                if (latency_test) {
+                        variant_ptr->lat_pcts =
+                                (uint64_t *) malloc(at_size * NUM_LAT_PCTS);
+                        if (!variant_ptr->lat_pcts) {
+                                fprintf(stderr, "Cannot allocate memory\n");
+                                goto exit_failure;
+                        }
+                }
+                /* counters are collected by the primary thread only */
+                if (pmu_test && info->print_info) {
+                        variant_ptr->pmu_ctrs =
+                                (uint64_t *) malloc(at_size * PMU_NUM_CTRS);
+                        if (!variant_ptr->pmu_ctrs) {
+                                fprintf(stderr, "Cannot allocate memory\n");
+                                goto exit_failure;
+                        }
+                }
+        }
+
+        for (run = 0; run < NUM_RUNS; run++) {
+                if (info->print_info)
+                        fprintf(stderr, "\nStarting run %d of %d%c",
+                                run+1, NUM_RUNS,
+                                silent_progress_bar ? '\r' : '\n' );
+
+                variant = 0;
+                variant_ptr = variant_list;
+
+                if (iter_scale == ITER_SCALE_SMOKE && run != 0)
+                        continue;
+
+                if (info->print_info)
+                        prog_bar_init(total_variants);
+
+                for (type = TTYPE_AES_HMAC; type < NUM_TTYPES; type++) {
+                        if (test_types[type] == 0)
+                                continue;
+
+                        max_arch = NUM_ARCHS;
+
+                        params.num_variants = num_variants[type];
+                        params.test_type = type;
+                        /* Performing tests for each selected architecture */
+                        for (arch = 0; arch < max_arch; arch++) {
+                                if (archs[arch] == 0)
+                                        continue;
+                                run_dir_test(p_mgr, arch, &params, run,
+                                             &variant_ptr, &variant, buf,
+                                             keys, info->print_info);
+                        }
+                } /* end for type */
+                if (info->print_info)
+                        prog_bar_fini();
+
+        } /* end for run */
+        if (info->print_info == 1 && iter_scale != ITER_SCALE_SMOKE) {
+                fprintf(stderr, "\n");
+                print_times(variant_list, &params, total_variants, buf, keys);
+        }
+
+exit:
+        if (variant_list != NULL) {
+                /* Freeing variants list */
+                for (i = 0; i < total_variants; i++) {
+                        free(variant_list[i].avg_times);
+                        free(variant_list[i].lat_pcts);
+                        free(variant_list[i].pmu_ctrs);
+                }
+                free(variant_list);
+        }
+        free(params.lat_hist);
+        free_mem(&buf, &keys);
+        free_mb_mgr(p_mgr);
+        if (pmu_test && info->print_info)
+                pmu_fini();
+#ifndef _WIN32
+        return NULL;
+
+#else
+        return;
+#endif
+exit_failure:
+        if (variant_list != NULL)
+                free(variant_list);
+        free_mem(&buf, &keys);
+        free_mb_mgr(p_mgr);
+        if (pmu_test && info->print_info)
+                pmu_fini();
+        exit(EXIT_FAILURE);
+}
+
+/* Key expansion rate test (--keyexp) */
+#define KEYEXP_MAX_BATCH 64
+
+static const uint32_t keyexp_batch_sizes[] = { 1, 4, 16, KEYEXP_MAX_BATCH };
+
+static uint8_t keyexp_raw_keys[KEYEXP_MAX_BATCH][IMB_KEY_AES_256_BYTES];
+static DECLARE_ALIGNED(uint32_t keyexp_enc_keys[KEYEXP_MAX_BATCH][15 * 4], 16);
+static DECLARE_ALIGNED(uint32_t keyexp_dec_keys[KEYEXP_MAX_BATCH][15 * 4], 16);
+static struct gcm_key_data keyexp_gcm_keys[KEYEXP_MAX_BATCH];
+static snow3g_key_schedule_t keyexp_snow3g_ks[KEYEXP_MAX_BATCH];
+static kasumi_key_sched_t keyexp_kasumi_ks[KEYEXP_MAX_BATCH];
+
+/* Returns monotonic time in nanoseconds */
+static uint64_t get_time_ns(void)
+{
+#ifdef _WIN32
+        LARGE_INTEGER freq, count;
+
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&count);
+        return (uint64_t) ((double) count.QuadPart * 1e9 /
+                           (double) freq.QuadPart);
+#else
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ((uint64_t) ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+#endif
+}
+
+/* Measures TSC frequency over 100ms (used to report packets/s) */
+static void measure_tsc_freq(void)
+{
+        uint64_t ns, cycles;
+        unsigned int aux;
+
+        if (tsc_freq != 0)
+                return;
+
+        ns = get_time_ns();
+        cycles = __rdtscp(&aux);
+        while ((get_time_ns() - ns) < 100000000ULL)
+                ;
+        cycles = __rdtscp(&aux) - cycles;
+        ns = get_time_ns() - ns;
+        tsc_freq = (double) cycles * 1e9 / (double) ns;
+}
+
+/*
+ * Expands keys in batches of <batch> keys (single key API for batch 1)
+ * and returns the number of keys expanded
+ */
+static uint64_t
+keyexp_run(IMB_MGR *mgr, const uint32_t key_size, const int gcm_pre,
+           const uint32_t batch, const uint32_t num_calls)
+{
+        const void *raw_ptrs[KEYEXP_MAX_BATCH];
+        void *enc_ptrs[KEYEXP_MAX_BATCH];
+        void *dec_ptrs[KEYEXP_MAX_BATCH];
+        struct gcm_key_data *gcm_ptrs[KEYEXP_MAX_BATCH];
+        uint32_t i;
+
+        for (i = 0; i < KEYEXP_MAX_BATCH; i++) {
+                raw_ptrs[i] = keyexp_raw_keys[i];
+                enc_ptrs[i] = keyexp_enc_keys[i];
+                dec_ptrs[i] = keyexp_dec_keys[i];
+                gcm_ptrs[i] = &keyexp_gcm_keys[i];
+        }
+
+        for (i = 0; i < num_calls; i++) {
+                const uint32_t idx = (i * batch) % KEYEXP_MAX_BATCH;
+
+                if (batch == 1 && gcm_pre == 0) {
+                        if (key_size == IMB_KEY_AES_128_BYTES)
+                                IMB_AES_KEYEXP_128(mgr, raw_ptrs[idx],
+                                                   enc_ptrs[idx],
+                                                   dec_ptrs[idx]);
+                        else if (key_size == IMB_KEY_AES_192_BYTES)
+                                IMB_AES_KEYEXP_192(mgr, raw_ptrs[idx],
+                                                   enc_ptrs[idx],
+                                                   dec_ptrs[idx]);
+                        else
+                                IMB_AES_KEYEXP_256(mgr, raw_ptrs[idx],
+                                                   enc_ptrs[idx],
+                                                   dec_ptrs[idx]);
+                } else if (batch == 1) {
+                        if (key_size == IMB_KEY_AES_128_BYTES)
+                                IMB_AES128_GCM_PRE(mgr, raw_ptrs[idx],
+                                                   gcm_ptrs[idx]);
+                        else if (key_size == IMB_KEY_AES_192_BYTES)
+                                IMB_AES192_GCM_PRE(mgr, raw_ptrs[idx],
+                                                   gcm_ptrs[idx]);
+                        else
+                                IMB_AES256_GCM_PRE(mgr, raw_ptrs[idx],
+                                                   gcm_ptrs[idx]);
+                } else if (gcm_pre == 0) {
+                        if (key_size == IMB_KEY_AES_128_BYTES)
+                                IMB_AES_KEYEXP_128_N(mgr, raw_ptrs, enc_ptrs,
+                                                     dec_ptrs, batch);
+                        else if (key_size == IMB_KEY_AES_192_BYTES)
+                                IMB_AES_KEYEXP_192_N(mgr, raw_ptrs, enc_ptrs,
+                                                     dec_ptrs, batch);
+                        else
+                                IMB_AES_KEYEXP_256_N(mgr, raw_ptrs, enc_ptrs,
+                                                     dec_ptrs, batch);
+                } else {
+                        if (key_size == IMB_KEY_AES_128_BYTES)
+                                IMB_AES128_GCM_PRE_N(mgr, raw_ptrs, gcm_ptrs,
+                                                     batch);
+                        else if (key_size == IMB_KEY_AES_192_BYTES)
+                                IMB_AES192_GCM_PRE_N(mgr, raw_ptrs, gcm_ptrs,
+                                                     batch);
+                        else
+                                IMB_AES256_GCM_PRE_N(mgr, raw_ptrs, gcm_ptrs,
+                                                     batch);
+                }
+        }
+
+        return (uint64_t) num_calls * batch;
+}
+
+/* Measures and prints key expansion rate for given batch size */
+static void
+keyexp_measure(IMB_MGR *mgr, const uint32_t arch, const uint32_t key_size,
+               const int gcm_pre, const uint32_t batch)
+{
+        const uint32_t num_calls = ((iter_scale / 4) + batch - 1) / batch;
+        uint64_t num_keys, cycles, ns;
+        unsigned int aux;
+
+        /* warm up */
+        keyexp_run(mgr, key_size, gcm_pre, batch, KEYEXP_MAX_BATCH / batch);
+
+        ns = get_time_ns();
+        cycles = __rdtscp(&aux);
+        num_keys = keyexp_run(mgr, key_size, gcm_pre, batch, num_calls);
+        cycles = __rdtscp(&aux) - cycles;
+        ns = get_time_ns() - ns;
+        if (ns == 0)
+                ns = 1;
+
+        if (iter_scale == ITER_SCALE_SMOKE)
+                return;
+
+        printf("%s\taes-%u-%s\t%u\t%"PRIu64"\t%.0f\n",
+               arch_str_map[arch].name, key_size * 8,
+               gcm_pre ? "gcm-pre" : "keyexp", batch, cycles / num_keys,
+               (double) num_keys * 1e9 / (double) ns);
+}
+
+/*
+ * Key setup of other algorithms, one key per call.
+ * Expanded AES keys from the key expansion test are used as input
+ * of CMAC subkey generation.
+ */
+static void keysetup_cmac_128(IMB_MGR *mgr, const uint32_t idx)
+{
+        IMB_AES_CMAC_SUBKEY_GEN_128(mgr, keyexp_enc_keys[idx],
+                                    &keyexp_dec_keys[idx][0],
+                                    &keyexp_dec_keys[idx][4]);
+}
+
+static void keysetup_cmac_256(IMB_MGR *mgr, const uint32_t idx)
+{
+        IMB_AES_CMAC_SUBKEY_GEN_256(mgr, keyexp_enc_keys[idx],
+                                    &keyexp_dec_keys[idx][0],
+                                    &keyexp_dec_keys[idx][4]);
+}
+
+static void keysetup_xcbc(IMB_MGR *mgr, const uint32_t idx)
+{
+        IMB_AES_XCBC_KEYEXP(mgr, keyexp_raw_keys[idx], keyexp_enc_keys[idx],
+                            &keyexp_dec_keys[idx][0],
+                            &keyexp_dec_keys[idx][4]);
+}
+
+static void keysetup_des(IMB_MGR *mgr, const uint32_t idx)
+{
+        IMB_DES_KEYSCHED(mgr, (uint64_t *) keyexp_enc_keys[idx],
+                         keyexp_raw_keys[idx]);
+}
+
+static void keysetup_snow3g(IMB_MGR *mgr, const uint32_t idx)
+{
+        IMB_SNOW3G_INIT_KEY_SCHED(mgr, keyexp_raw_keys[idx],
+                                  &keyexp_snow3g_ks[idx]);
+}
+
+static void keysetup_kasumi_f8(IMB_MGR *mgr, const uint32_t idx)
+{
+        IMB_KASUMI_INIT_F8_KEY_SCHED(mgr, keyexp_raw_keys[idx],
+                                     &keyexp_kasumi_ks[idx]);
+}
+
+static void keysetup_kasumi_f9(IMB_MGR *mgr, const uint32_t idx)
+{
+        IMB_KASUMI_INIT_F9_KEY_SCHED(mgr, keyexp_raw_keys[idx],
+                                     &keyexp_kasumi_ks[idx]);
+}
+
+/* Prepares HMAC ipad/opad block from 16 byte key */
+static void
+keysetup_hmac_block(uint8_t *block, const size_t block_size,
+                    const uint8_t *key, const uint8_t pad)
+{
+        size_t i;
+
+        memset(block, pad, block_size);
+        for (i = 0; i < IMB_KEY_AES_128_BYTES; i++)
+                block[i] ^= key[i];
+}
+
+static void keysetup_hmac_md5(IMB_MGR *mgr, const uint32_t idx)
+{
+        uint8_t block[SHA1_BLOCK_SIZE];
+
+        keysetup_hmac_block(block, sizeof(block), keyexp_raw_keys[idx], 0x36);
+        IMB_MD5_ONE_BLOCK(mgr, block, keyexp_enc_keys[idx]);
+        keysetup_hmac_block(block, sizeof(block), keyexp_raw_keys[idx], 0x5c);
+        IMB_MD5_ONE_BLOCK(mgr, block, keyexp_dec_keys[idx]);
+}
+
+static void keysetup_hmac_sha1(IMB_MGR *mgr, const uint32_t idx)
+{
+        uint8_t block[SHA1_BLOCK_SIZE];
+
+        keysetup_hmac_block(block, sizeof(block), keyexp_raw_keys[idx], 0x36);
+        IMB_SHA1_ONE_BLOCK(mgr, block, keyexp_enc_keys[idx]);
+        keysetup_hmac_block(block, sizeof(block), keyexp_raw_keys[idx], 0x5c);
+        IMB_SHA1_ONE_BLOCK(mgr, block, keyexp_dec_keys[idx]);
+}
+
+static void keysetup_hmac_sha224(IMB_MGR *mgr, const uint32_t idx)
+{
+        uint8_t block[SHA_256_BLOCK_SIZE];
+
+        keysetup_hmac_block(block, sizeof(block), keyexp_raw_keys[idx], 0x36);
+        IMB_SHA224_ONE_BLOCK(mgr, block, keyexp_enc_keys[idx]);
+        keysetup_hmac_block(block, sizeof(block), keyexp_raw_keys[idx], 0x5c);
+        IMB_SHA224_ONE_BLOCK(mgr, block, keyexp_dec_keys[idx]);
+}
+
+static void keysetup_hmac_sha256(IMB_MGR *mgr, const uint32_t idx)
+{
+        uint8_t block[SHA_256_BLOCK_SIZE];
+
+        keysetup_hmac_block(block, sizeof(block), keyexp_raw_keys[idx], 0x36);
+        IMB_SHA256_ONE_BLOCK(mgr, block, keyexp_enc_keys[idx]);
+        keysetup_hmac_block(block, sizeof(block), keyexp_raw_keys[idx], 0x5c);
+        IMB_SHA256_ONE_BLOCK(mgr, block, keyexp_dec_keys[idx]);
+}
+
+static void keysetup_hmac_sha384(IMB_MGR *mgr, const uint32_t idx)
+{
+        uint8_t block[SHA_384_BLOCK_SIZE];
+
+        keysetup_hmac_block(block, sizeof(block), keyexp_raw_keys[idx], 0x36);
+        IMB_SHA384_ONE_BLOCK(mgr, block, keyexp_enc_keys[idx]);
+        keysetup_hmac_block(block, sizeof(block), keyexp_raw_keys[idx], 0x5c);
+        IMB_SHA384_ONE_BLOCK(mgr, block, keyexp_dec_keys[idx]);
+}
+
+static void keysetup_hmac_sha512(IMB_MGR *mgr, const uint32_t idx)
+{
+        uint8_t block[SHA_512_BLOCK_SIZE];
+
+        keysetup_hmac_block(block, sizeof(block), keyexp_raw_keys[idx], 0x36);
+        IMB_SHA512_ONE_BLOCK(mgr, block, keyexp_enc_keys[idx]);
+        keysetup_hmac_block(block, sizeof(block), keyexp_raw_keys[idx], 0x5c);
+        IMB_SHA512_ONE_BLOCK(mgr, block, keyexp_dec_keys[idx]);
+}
+
+static const struct {
+        const char *name;
+        void (*run)(IMB_MGR *mgr, const uint32_t idx);
+} keysetup_funcs[] = {
+        { "aes-128-cmac-subkey", keysetup_cmac_128 },
+        { "aes-256-cmac-subkey", keysetup_cmac_256 },
+        { "aes-xcbc-keyexp", keysetup_xcbc },
+        { "des-keysched", keysetup_des },
+        { "snow3g-key-sched", keysetup_snow3g },
+        { "kasumi-f8-key-sched", keysetup_kasumi_f8 },
+        { "kasumi-f9-key-sched", keysetup_kasumi_f9 },
+        { "hmac-md5-ipad-opad", keysetup_hmac_md5 },
+        { "hmac-sha1-ipad-opad", keysetup_hmac_sha1 },
+        { "hmac-sha224-ipad-opad", keysetup_hmac_sha224 },
+        { "hmac-sha256-ipad-opad", keysetup_hmac_sha256 },
+        { "hmac-sha384-ipad-opad", keysetup_hmac_sha384 },
+        { "hmac-sha512-ipad-opad", keysetup_hmac_sha512 },
+};
+
+/* Measures and prints key setup rate of keysetup_funcs[<func>] */
+static void
+keysetup_measure(IMB_MGR *mgr, const uint32_t arch, const uint32_t func)
+{
+        const uint32_t num_keys = iter_scale / 4;
+        uint64_t cycles, ns;
+        unsigned int aux;
+        uint32_t i;
+
+        /* warm up */
+        for (i = 0; i < KEYEXP_MAX_BATCH; i++)
+                keysetup_funcs[func].run(mgr, i);
+
+        ns = get_time_ns();
+        cycles = __rdtscp(&aux);
+        for (i = 0; i < num_keys; i++)
+                keysetup_funcs[func].run(mgr, i % KEYEXP_MAX_BATCH);
+        cycles = __rdtscp(&aux) - cycles;
+        ns = get_time_ns() - ns;
+        if (ns == 0)
+                ns = 1;
+
+        if (iter_scale == ITER_SCALE_SMOKE)
+                return;
+
+        printf("%s\t%s\t1\t%"PRIu64"\t%.0f\n",
+               arch_str_map[arch].name, keysetup_funcs[func].name,
+               cycles / num_keys, (double) num_keys * 1e9 / (double) ns);
+}
+
+/*
+ * Measures key expansion and GCM key pre-processing rate
+ * of single and multiple key API's, and key setup rate of other
+ * algorithms (including HMAC ipad/opad derivation)
+ * for all selected architectures
+ */
+static int
+run_keyexp_tests(void)
+{
+        IMB_MGR *mgr = alloc_mb_mgr(flags);
+        uint32_t arch, k, b, i;
+        int gcm_pre;
+
+        if (mgr == NULL) {
+                fprintf(stderr, "Error allocating MB_MGR structure!\n");
+                return -1;
+        }
+
+        for (i = 0; i < KEYEXP_MAX_BATCH; i++) {
+                uint32_t j;
+
+                for (j = 0; j < IMB_KEY_AES_256_BYTES; j++)
+                        keyexp_raw_keys[i][j] = (uint8_t) rand();
+        }
+
+        /* SAFE_DATA key/register clearing adds to key setup cost */
+        printf("SAFE_DATA: %s\n",
+               (mgr->features & IMB_FEATURE_SAFE_DATA) ? "on" : "off");
+        printf("ARCH\tALGO\tKEYS PER CALL\tCYCLES PER KEY\tKEYS PER SEC\n");
+        for (arch = 0; arch < NUM_ARCHS; arch++) {
+                if (archs[arch] == 0)
+                        continue;
+
+                switch (arch) {
+                case ARCH_SSE:
+                        init_mb_mgr_sse(mgr);
+                        break;
+                case ARCH_AVX:
+                        init_mb_mgr_avx(mgr);
+                        break;
+                case ARCH_AVX2:
+                        init_mb_mgr_avx2(mgr);
+                        break;
+                default:
+                case ARCH_AVX512:
+                        init_mb_mgr_avx512(mgr);
+                        break;
+                }
+
+                for (gcm_pre = 0; gcm_pre <= 1; gcm_pre++)
+                        for (k = IMB_KEY_AES_128_BYTES;
+                             k <= IMB_KEY_AES_256_BYTES; k += 8)
+                                for (b = 0; b < DIM(keyexp_batch_sizes); b++)
+                                        keyexp_measure(mgr, arch, k, gcm_pre,
+                                                       keyexp_batch_sizes[b]);
+
+                for (i = 0; i < DIM(keysetup_funcs); i++)
+                        keysetup_measure(mgr, arch, i);
+        }
+
+        free_mb_mgr(mgr);
+        return 0;
+}
+
+/* GCM SA working set test (--gcm-sa) */
+#define GCM_SA_NUM_PKTS 4096
+#define GCM_SA_MAX_PKT_SIZE 1500
+#define GCM_SA_IV_SIZE 12
+#define GCM_SA_TAG_SIZE 16
+
+static const uint32_t gcm_sa_pkt_sizes[] = { 64, 512, GCM_SA_MAX_PKT_SIZE };
+
+/*
+ * Encrypts GCM_SA_NUM_PKTS packets, each one with an SA picked at random
+ * from the SA table, using either full or compact key data
+ */
+static void
+gcm_sa_run(IMB_MGR *mgr, const uint32_t key_size,
+           const struct gcm_key_data *keys,
+           const struct gcm_key_data_compact *keys_compact,
+           const uint32_t *sa_idx, uint8_t *buf, const uint32_t pkt_size)
+{
+        struct gcm_context_data ctx;
+        uint8_t iv[GCM_SA_IV_SIZE] = {0};
+        uint8_t aad[16] = {0};
+        uint8_t tag[GCM_SA_TAG_SIZE];
+        uint32_t i;
+
+        for (i = 0; i < GCM_SA_NUM_PKTS; i++) {
+                const uint32_t idx = sa_idx[i];
+
+                if (keys_compact == NULL) {
+                        if (key_size == IMB_KEY_AES_128_BYTES)
+                                IMB_AES128_GCM_ENC(mgr, &keys[idx], &ctx,
+                                                   buf, buf, pkt_size, iv,
+                                                   aad, sizeof(aad), tag,
+                                                   sizeof(tag));
+                        else if (key_size == IMB_KEY_AES_192_BYTES)
+                                IMB_AES192_GCM_ENC(mgr, &keys[idx], &ctx,
+                                                   buf, buf, pkt_size, iv,
+                                                   aad, sizeof(aad), tag,
+                                                   sizeof(tag));
+                        else
+                                IMB_AES256_GCM_ENC(mgr, &keys[idx], &ctx,
+                                                   buf, buf, pkt_size, iv,
+                                                   aad, sizeof(aad), tag,
+                                                   sizeof(tag));
+                } else {
+                        if (key_size == IMB_KEY_AES_128_BYTES)
+                                IMB_AES128_GCM_ENC_COMPACT(mgr,
+                                                           &keys_compact[idx],
+                                                           &ctx, buf, buf,
+                                                           pkt_size, iv, aad,
+                                                           sizeof(aad), tag,
+                                                           sizeof(tag));
+                        else if (key_size == IMB_KEY_AES_192_BYTES)
+                                IMB_AES192_GCM_ENC_COMPACT(mgr,
+                                                           &keys_compact[idx],
+                                                           &ctx, buf, buf,
+                                                           pkt_size, iv, aad,
+                                                           sizeof(aad), tag,
+                                                           sizeof(tag));
+                        else
+                                IMB_AES256_GCM_ENC_COMPACT(mgr,
+                                                           &keys_compact[idx],
+                                                           &ctx, buf, buf,
+                                                           pkt_size, iv, aad,
+                                                           sizeof(aad), tag,
+                                                           sizeof(tag));
+                }
+        }
+}
+
+/* Returns average number of cycles per packet */
+static uint64_t
+gcm_sa_measure(IMB_MGR *mgr, const uint32_t key_size,
+               const struct gcm_key_data *keys,
+               const struct gcm_key_data_compact *keys_compact,
+               const uint32_t *sa_idx, uint8_t *buf, const uint32_t pkt_size)
+{
+        const uint32_t num_runs =
+                (iter_scale + GCM_SA_NUM_PKTS - 1) / GCM_SA_NUM_PKTS;
+        uint64_t cycles;
+        unsigned int aux;
+        uint32_t i;
+
+        /* warm up */
+        gcm_sa_run(mgr, key_size, keys, keys_compact, sa_idx, buf, pkt_size);
+
+        cycles = __rdtscp(&aux);
+        for (i = 0; i < num_runs; i++)
+                gcm_sa_run(mgr, key_size, keys, keys_compact, sa_idx, buf,
+                           pkt_size);
+        cycles = __rdtscp(&aux) - cycles;
+
+        return cycles / ((uint64_t) num_runs * GCM_SA_NUM_PKTS);
+}
+
+/*
+ * Measures AES-GCM encryption rate with full and compact key data
+ * for a random SA working set of <gcm_sa_num> SA's
+ */
+static int
+run_gcm_sa_tests(void)
+{
+        IMB_MGR *mgr = alloc_mb_mgr(flags);
+        struct gcm_key_data *keys = NULL;
+        struct gcm_key_data_compact *keys_compact = NULL;
+        static uint32_t sa_idx[GCM_SA_NUM_PKTS];
+        static uint8_t buf[GCM_SA_MAX_PKT_SIZE];
+        uint8_t raw_key[IMB_KEY_AES_256_BYTES];
+        uint32_t arch, k, sz, i, j;
+        int ret = -1;
+
+        if (mgr == NULL) {
+                fprintf(stderr, "Error allocating MB_MGR structure!\n");
+                return -1;
+        }
+
+#ifdef LINUX
+        keys = (struct gcm_key_data *)
+                memalign(64, gcm_sa_num * sizeof(*keys));
+#else
+        keys = (struct gcm_key_data *)
+                _aligned_malloc(gcm_sa_num * sizeof(*keys), 64);
+#endif
+        keys_compact = (struct gcm_key_data_compact *)
+                malloc(gcm_sa_num * sizeof(*keys_compact));
+        if (keys == NULL || keys_compact == NULL) {
+                fprintf(stderr, "Could not allocate memory for SA's!\n");
+                goto exit;
+        }
+
+        for (i = 0; i < GCM_SA_NUM_PKTS; i++)
+                sa_idx[i] = (uint32_t) rand() % gcm_sa_num;
+
+        printf("SA key data size: full %u bytes, compact %u bytes\n",
+               (unsigned) sizeof(*keys), (unsigned) sizeof(*keys_compact));
+        printf("ARCH\tALGO\tSAS\tPKT SIZE\tCYCLES FULL\tCYCLES COMPACT\n");
+        for (arch = 0; arch < NUM_ARCHS; arch++) {
+                if (archs[arch] == 0)
+                        continue;
+
+                switch (arch) {
+                case ARCH_SSE:
+                        init_mb_mgr_sse(mgr);
+                        break;
+                case ARCH_AVX:
+                        init_mb_mgr_avx(mgr);
+                        break;
+                case ARCH_AVX2:
+                        init_mb_mgr_avx2(mgr);
+                        break;
+                default:
+                case ARCH_AVX512:
+                        init_mb_mgr_avx512(mgr);
+                        break;
+                }
+
+                for (k = IMB_KEY_AES_128_BYTES;
+                     k <= IMB_KEY_AES_256_BYTES; k += 8) {
+                        for (i = 0; i < gcm_sa_num; i++) {
+                                for (j = 0; j < sizeof(raw_key); j++)
+                                        raw_key[j] = (uint8_t) rand();
+                                if (k == IMB_KEY_AES_128_BYTES) {
+                                        IMB_AES128_GCM_PRE(mgr, raw_key,
+                                                           &keys[i]);
+                                        IMB_AES128_GCM_PRE_COMPACT(mgr,
+                                                        raw_key,
+                                                        &keys_compact[i]);
+                                } else if (k == IMB_KEY_AES_192_BYTES) {
+                                        IMB_AES192_GCM_PRE(mgr, raw_key,
+                                                           &keys[i]);
+                                        IMB_AES192_GCM_PRE_COMPACT(mgr,
+                                                        raw_key,
+                                                        &keys_compact[i]);
+                                } else {
+                                        IMB_AES256_GCM_PRE(mgr, raw_key,
+                                                           &keys[i]);
+                                        IMB_AES256_GCM_PRE_COMPACT(mgr,
+                                                        raw_key,
+                                                        &keys_compact[i]);
+                                }
+                        }
+
+                        for (sz = 0; sz < DIM(gcm_sa_pkt_sizes); sz++) {
+                                const uint32_t pkt_size = gcm_sa_pkt_sizes[sz];
+                                const uint64_t full =
+                                        gcm_sa_measure(mgr, k, keys, NULL,
+                                                       sa_idx, buf, pkt_size);
+                                const uint64_t compact =
+                                        gcm_sa_measure(mgr, k, keys,
+                                                       keys_compact, sa_idx,
+                                                       buf, pkt_size);
+
+                                if (iter_scale == ITER_SCALE_SMOKE)
+                                        continue;
+
+                                printf("%s\taes-%u-gcm\t%u\t%u\t%"PRIu64
+                                       "\t%"PRIu64"\n",
+                                       arch_str_map[arch].name, k * 8,
+                                       gcm_sa_num, pkt_size, full, compact);
+                        }
+                }
+        }
+        ret = 0;
+
+exit:
+        free(keys_compact);
+#ifdef LINUX
+        free(keys);
+#else
+        _aligned_free(keys);
+#endif
+        free_mb_mgr(mgr);
+        return ret;
+}
+
+/* Large SA working set test (--num-sessions) */
+#define SESSIONS_MAX (4 * 1024 * 1024)
+#define SESSIONS_MIN_JOBS (64 * 1024)
+#define SESSIONS_MAX_JOBS (16 * 1024 * 1024)
+#define SESSIONS_MAX_PKT_SIZE 1024
+
+static const uint32_t sessions_pkt_sizes[] = {
+        64, 512, SESSIONS_MAX_PKT_SIZE
+};
+
+/* Per session AES-128 key schedules and HMAC-SHA1 ipad/opad digests */
+struct session_keys_s {
+        DECLARE_ALIGNED(uint32_t enc_keys[11 * 4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[11 * 4], 16);
+        uint32_t ipad[5];
+        uint32_t opad[5];
+};
+
+/* xorshift64 generator (rand() range is too small for large SA tables) */
+static uint64_t sessions_rand_state = 0x9e3779b97f4a7c15ULL;
+
+static uint32_t sessions_rand(void)
+{
+        uint64_t x = sessions_rand_state;
+
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        sessions_rand_state = x;
+        return (uint32_t) (x >> 32);
+}
+
+/* Returns random number in [0, 1) range */
+static double sessions_rand_double(void)
+{
+        return (double) sessions_rand() / 4294967296.0;
+}
+
+/*
+ * Fills list of session indexes (one per job) for <num> sessions.
+ * Zipf (s = 1) distribution is used if <zipf_cdf> is not NULL,
+ * uniform distribution otherwise.
+ */
+static void
+sessions_fill_list(uint32_t *list, const uint32_t list_len, const uint32_t num,
+                   double *zipf_cdf, uint32_t *zipf_map)
+{
+        uint32_t i;
+
+        if (zipf_cdf == NULL) {
+                for (i = 0; i < list_len; i++)
+                        list[i] = sessions_rand() % num;
+                return;
+        }
+
+        /* CDF of ranks 1..num, with rank k drawn with probability ~ 1/k */
+        zipf_cdf[0] = 1.0;
+        for (i = 1; i < num; i++)
+                zipf_cdf[i] = zipf_cdf[i - 1] + (1.0 / (double) (i + 1));
+        for (i = 0; i < num; i++)
+                zipf_cdf[i] /= zipf_cdf[num - 1];
+
+        /* popular sessions are scattered across the SA table */
+        for (i = 0; i < num; i++)
+                zipf_map[i] = i;
+        for (i = num - 1; i > 0; i--) {
+                const uint32_t j = sessions_rand() % (i + 1);
+                const uint32_t tmp = zipf_map[i];
+
+                zipf_map[i] = zipf_map[j];
+                zipf_map[j] = tmp;
+        }
+
+        for (i = 0; i < list_len; i++) {
+                const double r = sessions_rand_double();
+                uint32_t lo = 0, hi = num - 1;
+
+                while (lo < hi) {
+                        const uint32_t mid = lo + ((hi - lo) / 2);
+
+                        if (zipf_cdf[mid] < r)
+                                lo = mid + 1;
+                        else
+                                hi = mid;
+                }
+                list[i] = zipf_map[lo];
+        }
+}
+
+/*
+ * Submits <list_len> jobs, each one using key material of the session
+ * picked from <list>, and returns number of cycles taken
+ */
+static uint64_t
+sessions_run(IMB_MGR *mgr, const IMB_JOB *job_template,
+             const struct session_keys_s *keys,
+             const struct gcm_key_data *gcm_keys,
+             const uint32_t *list, const uint32_t list_len)
+{
+        IMB_JOB *job;
+        uint64_t cycles;
+        unsigned int aux;
+        uint32_t i;
+
+        cycles = __rdtscp(&aux);
+        for (i = 0; i < list_len; i++) {
+                const uint32_t s = list[i];
+
+                job = IMB_GET_NEXT_JOB(mgr);
+                *job = *job_template;
+                if (job->cipher_mode == IMB_CIPHER_GCM) {
+                        job->enc_keys = job->dec_keys = &gcm_keys[s];
+                } else {
+                        job->enc_keys = keys[s].enc_keys;
+                        job->dec_keys = keys[s].dec_keys;
+                        job->u.HMAC._hashed_auth_key_xor_ipad =
+                                (const uint8_t *) keys[s].ipad;
+                        job->u.HMAC._hashed_auth_key_xor_opad =
+                                (const uint8_t *) keys[s].opad;
+                }
+#ifdef DEBUG
+                job = IMB_SUBMIT_JOB(mgr);
+#else
+                job = IMB_SUBMIT_JOB_NOCHECK(mgr);
+#endif
+                while (job)
+                        job = IMB_GET_COMPLETED_JOB(mgr);
+        }
+        while (IMB_FLUSH_JOB(mgr) != NULL)
+                ;
+
+        return __rdtscp(&aux) - cycles;
+}
+
+/* Expands independent keys for each of <num> sessions */
+static void
+sessions_init_keys(IMB_MGR *mgr, struct session_keys_s *keys,
+                   struct gcm_key_data *gcm_keys, const uint32_t num)
+{
+        uint8_t raw_key[IMB_KEY_AES_128_BYTES];
+        uint8_t hmac_block[SHA1_BLOCK_SIZE];
+        uint32_t i, j;
+
+        for (i = 0; i < num; i++) {
+                for (j = 0; j < sizeof(raw_key); j++)
+                        raw_key[j] = (uint8_t) sessions_rand();
+                IMB_AES_KEYEXP_128(mgr, raw_key, keys[i].enc_keys,
+                                   keys[i].dec_keys);
+                IMB_AES128_GCM_PRE(mgr, raw_key, &gcm_keys[i]);
+
+                memset(hmac_block, 0x36, sizeof(hmac_block));
+                for (j = 0; j < sizeof(raw_key); j++)
+                        hmac_block[j] ^= raw_key[j];
+                IMB_SHA1_ONE_BLOCK(mgr, hmac_block, keys[i].ipad);
+
+                memset(hmac_block, 0x5c, sizeof(hmac_block));
+                for (j = 0; j < sizeof(raw_key); j++)
+                        hmac_block[j] ^= raw_key[j];
+                IMB_SHA1_ONE_BLOCK(mgr, hmac_block, keys[i].opad);
+        }
+}
+
+/* L2 and last level cache sizes in bytes (0 if unknown) */
+static uint64_t sessions_l2_size = 0;
+static uint64_t sessions_llc_size = 0;
+
+static void sessions_get_cache_sizes(void)
+{
+#if defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+        const long l2_size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        const long llc_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+
+        if (l2_size > 0)
+                sessions_l2_size = (uint64_t) l2_size;
+        if (llc_size > 0)
+                sessions_llc_size = (uint64_t) llc_size;
+#endif
+}
+
+/* Returns name of the smallest cache level fitting <ws_size> bytes */
+static const char *sessions_ws_level(const uint64_t ws_size)
+{
+        if (sessions_l2_size == 0 && sessions_llc_size == 0)
+                return "N/A";
+        if (ws_size <= sessions_l2_size)
+                return "L2";
+        if (ws_size <= sessions_llc_size)
+                return "LLC";
+        return "DRAM";
+}
+
+/* Prepares job template for AES-CBC + HMAC-SHA1 (algo 0) or GCM (algo 1) */
+static void
+sessions_init_job_template(IMB_JOB *job, const uint32_t algo,
+                           const uint32_t pkt_size)
+{
+        static DECLARE_ALIGNED(uint8_t buf[SESSIONS_MAX_PKT_SIZE], 64);
+        static DECLARE_ALIGNED(uint8_t iv[16], 16);
+        static DECLARE_ALIGNED(uint8_t aad[16], 16);
+        static DECLARE_ALIGNED(uint8_t tag[16], 16);
+
+        memset(job, 0, sizeof(*job));
+        job->src = buf;
+        job->dst = buf;
+        job->iv = iv;
+        job->cipher_direction = IMB_DIR_ENCRYPT;
+        job->chain_order = IMB_ORDER_CIPHER_HASH;
+        job->key_len_in_bytes = IMB_KEY_AES_128_BYTES;
+        job->msg_len_to_cipher_in_bytes = pkt_size;
+        job->msg_len_to_hash_in_bytes = pkt_size;
+        job->auth_tag_output = tag;
+
+        if (algo == 0) {
+                job->cipher_mode = IMB_CIPHER_CBC;
+                job->iv_len_in_bytes = 16;
+                job->hash_alg = IMB_AUTH_HMAC_SHA_1;
+                job->auth_tag_output_len_in_bytes = 12;
+        } else {
+                job->cipher_mode = IMB_CIPHER_GCM;
+                job->iv_len_in_bytes = 12;
+                job->hash_alg = IMB_AUTH_AES_GMAC;
+                job->auth_tag_output_len_in_bytes = 16;
+                job->u.GCM.aad = aad;
+                job->u.GCM.aad_len_in_bytes = 8;
+        }
+}
+
+/*
+ * Measures AES-128-CBC + HMAC-SHA1 and AES-128-GCM job throughput
+ * with a growing number of sessions (SA's) up to <num_sessions>,
+ * each one with independently expanded key material
+ */
+static int
+run_sessions_tests(void)
+{
+        const char *algo_names[2] = {
+                "aes-128-cbc-hmac-sha1", "aes-128-gcm"
+        };
+        IMB_MGR *mgr = alloc_mb_mgr(flags);
+        struct session_keys_s *keys = NULL;
+        struct gcm_key_data *gcm_keys = NULL;
+        uint32_t *list = NULL, *zipf_map = NULL;
+        double *zipf_cdf = NULL;
+        uint32_t list_len = SESSIONS_MIN_JOBS;
+        uint32_t arch, algo, sz, num;
+        int ret = -1;
+
+        if (mgr == NULL) {
+                fprintf(stderr, "Error allocating MB_MGR structure!\n");
+                return -1;
+        }
+
+        /* each session is picked ~4 times per run, at least */
+        while (list_len < SESSIONS_MAX_JOBS && list_len < (4 * num_sessions))
+                list_len *= 2;
+        if (iter_scale == ITER_SCALE_SMOKE)
+                list_len = ITER_SCALE_SMOKE;
+
+#ifdef LINUX
+        keys = (struct session_keys_s *)
+                memalign(64, num_sessions * sizeof(*keys));
+        gcm_keys = (struct gcm_key_data *)
+                memalign(64, num_sessions * sizeof(*gcm_keys));
+#else
+        keys = (struct session_keys_s *)
+                _aligned_malloc(num_sessions * sizeof(*keys), 64);
+        gcm_keys = (struct gcm_key_data *)
+                _aligned_malloc(num_sessions * sizeof(*gcm_keys), 64);
+#endif
+        list = (uint32_t *) malloc(list_len * sizeof(*list));
+        if (keys == NULL || gcm_keys == NULL || list == NULL) {
+                fprintf(stderr, "Could not allocate memory for sessions!\n");
+                goto exit;
+        }
+        if (sessions_zipf) {
+                zipf_cdf = (double *) malloc(num_sessions * sizeof(*zipf_cdf));
+                zipf_map = (uint32_t *) malloc(num_sessions *
+                                               sizeof(*zipf_map));
+                if (zipf_cdf == NULL || zipf_map == NULL) {
+                        fprintf(stderr, "Could not allocate memory for "
+                                "session distribution!\n");
+                        goto exit;
+                }
+        }
+
+        measure_tsc_freq();
+        sessions_get_cache_sizes();
+        printf("Session key data size: AES+HMAC %u bytes, GCM %u bytes\n",
+               (unsigned) sizeof(*keys), (unsigned) sizeof(*gcm_keys));
+        printf("L2 size %"PRIu64" KB, LLC size %"PRIu64" KB, "
+               "%s session distribution\n",
+               sessions_l2_size / 1024, sessions_llc_size / 1024,
+               sessions_zipf ? "zipf" : "uniform");
+        printf("ARCH\tALGO\tPKT SIZE\tSESSIONS\tWORKING SET KB\tFITS IN\t"
+               "CYCLES PER PKT\tPKTS PER SEC\n");
+        for (arch = 0; arch < NUM_ARCHS; arch++) {
+                if (archs[arch] == 0)
+                        continue;
+
+                switch (arch) {
+                case ARCH_SSE:
+                        init_mb_mgr_sse(mgr);
+                        break;
+                case ARCH_AVX:
+                        init_mb_mgr_avx(mgr);
+                        break;
+                case ARCH_AVX2:
+                        init_mb_mgr_avx2(mgr);
+                        break;
+                default:
+                case ARCH_AVX512:
+                        init_mb_mgr_avx512(mgr);
+                        break;
+                }
+
+                /* GCM key data layout is architecture specific */
+                sessions_init_keys(mgr, keys, gcm_keys, num_sessions);
+
+                for (algo = 0; algo < DIM(algo_names); algo++)
+                        for (sz = 0; sz < DIM(sessions_pkt_sizes); sz++) {
+                                const uint32_t pkt_size =
+                                        sessions_pkt_sizes[sz];
+                                const uint64_t key_size = (algo == 0) ?
+                                        sizeof(*keys) : sizeof(*gcm_keys);
+                                IMB_JOB job_template;
+
+                                sessions_init_job_template(&job_template,
+                                                           algo, pkt_size);
+
+                                /* 1, 4, 16, ... sessions, up to the max */
+                                for (num = 1; ; num *= 4) {
+                                        uint64_t cycles;
+
+                                        if (num > num_sessions)
+                                                num = num_sessions;
+
+                                        sessions_fill_list(list, list_len,
+                                                           num, zipf_cdf,
+                                                           zipf_map);
+                                        /* warm up */
+                                        sessions_run(mgr, &job_template,
+                                                     keys, gcm_keys, list,
+                                                     list_len / 16);
+                                        cycles = sessions_run(mgr,
+                                                              &job_template,
+                                                              keys, gcm_keys,
+                                                              list, list_len);
+                                        cycles /= list_len;
+
+                                        if (iter_scale != ITER_SCALE_SMOKE)
+                                                printf("%s\t%s\t%u\t%u\t"
+                                                       "%"PRIu64"\t%s\t"
+                                                       "%"PRIu64"\t%.0f\n",
+                                                       arch_str_map[arch].name,
+                                                       algo_names[algo],
+                                                       pkt_size, num,
+                                                       (num * key_size) / 1024,
+                                                       sessions_ws_level(num *
+                                                                 key_size),
+                                                       cycles,
+                                                       (cycles != 0) ?
+                                                       tsc_freq /
+                                                       (double) cycles : 0.0);
+
+                                        if (num == num_sessions)
+                                                break;
+                                }
+                        }
+        }
+        ret = 0;
+
+exit:
+        free(zipf_map);
+        free(zipf_cdf);
+        free(list);
+#ifdef LINUX
+        free(gcm_keys);
+        free(keys);
+#else
+        _aligned_free(gcm_keys);
+        _aligned_free(keys);
+#endif
+        free_mb_mgr(mgr);
+        return ret;
+}
+
+/* Multi-core scaling test (--scaling) */
+#define SCALING_NUM_BUFS 64
+#define SCALING_FREQ_LOOPS (256 * 1024)
+
+/* Per core key material and buffers, allocated on the core's NUMA node */
+struct scaling_mem_s {
+        struct session_keys_s keys;
+        struct gcm_key_data gcm_keys;
+        DECLARE_ALIGNED(uint8_t iv[16], 16);
+        DECLARE_ALIGNED(uint8_t aad[16], 16);
+        DECLARE_ALIGNED(uint8_t tag[16], 16);
+        DECLARE_ALIGNED(uint8_t bufs[SCALING_NUM_BUFS]
+                        [SESSIONS_MAX_PKT_SIZE], 64);
+};
+
+struct scaling_worker_s {
+        int core;
+        int node;
+        int error;
+        uint32_t arch;
+        uint32_t algo;
+        uint32_t pkt_size;
+        uint32_t num_jobs;
+        uint64_t start; /* TSC at start of the timed section */
+        uint64_t end; /* TSC at end of the timed section */
+        uint64_t freq_ticks; /* TSC ticks of the frequency probe loop */
+};
+
+static struct scaling_worker_s scaling_workers[MAX_NUM_THREADS];
+/* key material expanded once per architecture, copied by each worker */
+static struct session_keys_s scaling_keys;
+static struct gcm_key_data scaling_gcm_keys;
+static uint32_t scaling_num_workers = 0;
+static volatile uint32_t scaling_ready = 0;
+static volatile uint32_t scaling_go = 0;
+static volatile uint32_t scaling_done = 0;
+
+static void scaling_atomic_inc(volatile uint32_t *val)
+{
+#ifdef _WIN32
+        InterlockedIncrement((volatile LONG *) val);
+#else
+        __sync_fetch_and_add(val, 1);
+#endif
+}
+
+/* Returns NUMA node of <core> or -1 if unknown */
+static int scaling_node_of_core(const int core)
+{
+#ifdef HAVE_LIBNUMA
+        if (numa_available() >= 0)
+                return numa_node_of_cpu(core);
+#endif
+#ifdef LINUX
+        {
+                unsigned cpu, node;
+
+                /* called on <core> after setting affinity */
+                if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0 &&
+                    (int) cpu == core)
+                        return (int) node;
+        }
+#else
+        (void) core;
+#endif
+        return -1;
+}
+
+static void *scaling_alloc(const size_t size)
+{
+#ifdef HAVE_LIBNUMA
+        if (numa_available() >= 0)
+                return numa_alloc_local(size);
+#endif
+#ifdef LINUX
+        return memalign(64, size);
+#else
+        return _aligned_malloc(size, 64);
+#endif
+}
+
+static void scaling_free(void *ptr, const size_t size)
+{
+        if (ptr == NULL)
+                return;
+#ifdef HAVE_LIBNUMA
+        if (numa_available() >= 0) {
+                numa_free(ptr, size);
+                return;
+        }
+#endif
+        (void) size;
+#ifdef LINUX
+        free(ptr);
+#else
+        _aligned_free(ptr);
+#endif
+}
+
+/*
+ * Runs a fixed chain of dependent scalar operations and returns
+ * the number of TSC ticks taken. The chain takes a constant number
+ * of core cycles, so the result is inversely proportional to
+ * the current core frequency.
+ */
+static uint64_t scaling_freq_loop(void)
+{
+        volatile uint64_t seed = 1;
+        uint64_t x = seed, ticks;
+        unsigned int aux;
+        uint32_t i;
+
+        ticks = __rdtscp(&aux);
+        for (i = 0; i < SCALING_FREQ_LOOPS; i++)
+                x = (x ^ (x >> 7)) * 0x9e3779b97f4a7c15ULL;
+        ticks = __rdtscp(&aux) - ticks;
+        seed = x;
+
+        return ticks;
+}
+
+static void
+scaling_run(IMB_MGR *mgr, const IMB_JOB *job_template,
+            struct scaling_mem_s *mem, const uint32_t num_jobs)
+{
+        IMB_JOB *job;
+        uint32_t i;
+
+        for (i = 0; i < num_jobs; i++) {
+                job = IMB_GET_NEXT_JOB(mgr);
+                *job = *job_template;
+                job->src = mem->bufs[i & (SCALING_NUM_BUFS - 1)];
+                job->dst = mem->bufs[i & (SCALING_NUM_BUFS - 1)];
+#ifdef DEBUG
+                job = IMB_SUBMIT_JOB(mgr);
+#else
+                job = IMB_SUBMIT_JOB_NOCHECK(mgr);
+#endif
+                while (job)
+                        job = IMB_GET_COMPLETED_JOB(mgr);
+        }
+        while (IMB_FLUSH_JOB(mgr) != NULL)
+                ;
+}
+
+/*
+ * Scaling test worker: pins itself to its core, allocates the manager,
+ * keys and buffers there (so they are local to the core's NUMA node),
+ * waits for all workers to get ready and runs the timed section
+ */
+#ifdef _WIN32
+static void
+#else
+static void *
+#endif
+run_scaling_worker(void *arg)
+{
+        struct scaling_worker_s *w = (struct scaling_worker_s *) arg;
+        struct scaling_mem_s *mem = NULL;
+        IMB_MGR *mgr = NULL;
+        IMB_JOB job_template;
+        unsigned int aux;
+
+        if (set_affinity(w->core) != 0) {
+                fprintf(stderr, "Failed to set cpu affinity on core %d\n",
+                        w->core);
+                w->error = 1;
+        }
+#ifdef HAVE_LIBNUMA
+        if (numa_available() >= 0)
+                numa_set_localalloc();
+#endif
+        w->node = scaling_node_of_core(w->core);
+
+        if (!w->error) {
+                mgr = alloc_mb_mgr(flags);
+                mem = (struct scaling_mem_s *) scaling_alloc(sizeof(*mem));
+                if (mgr == NULL || mem == NULL) {
+                        fprintf(stderr, "Could not allocate memory for "
+                                "core %d!\n", w->core);
+                        w->error = 1;
+                }
+        }
+
+        if (!w->error) {
+                switch (w->arch) {
+                case ARCH_SSE:
+                        init_mb_mgr_sse(mgr);
+                        break;
+                case ARCH_AVX:
+                        init_mb_mgr_avx(mgr);
+                        break;
+                case ARCH_AVX2:
+                        init_mb_mgr_avx2(mgr);
+                        break;
+                default:
+                case ARCH_AVX512:
+                        init_mb_mgr_avx512(mgr);
+                        break;
+                }
+
+                /* first touch of all the memory from this core */
+                memset(mem, 0xa5, sizeof(*mem));
+                mem->keys = scaling_keys;
+                mem->gcm_keys = scaling_gcm_keys;
+
+                sessions_init_job_template(&job_template, w->algo,
+                                           w->pkt_size);
+                job_template.iv = mem->iv;
+                job_template.auth_tag_output = mem->tag;
+                if (job_template.cipher_mode == IMB_CIPHER_GCM) {
+                        job_template.u.GCM.aad = mem->aad;
+                        job_template.enc_keys = &mem->gcm_keys;
+                        job_template.dec_keys = &mem->gcm_keys;
+                } else {
+                        job_template.enc_keys = mem->keys.enc_keys;
+                        job_template.dec_keys = mem->keys.dec_keys;
+                        job_template.u.HMAC._hashed_auth_key_xor_ipad =
+                                (const uint8_t *) mem->keys.ipad;
+                        job_template.u.HMAC._hashed_auth_key_xor_opad =
+                                (const uint8_t *) mem->keys.opad;
+                }
+
+                /* warm up */
+                scaling_run(mgr, &job_template, mem, w->num_jobs / 16);
+        }
+
+        /* first worker releases all workers once they are ready */
+        scaling_atomic_inc(&scaling_ready);
+        if (w == &scaling_workers[0]) {
+                while (scaling_ready != scaling_num_workers)
+                        _mm_pause();
+                scaling_go = 1;
+        } else {
+                while (scaling_go == 0)
+                        _mm_pause();
+        }
+
+        if (!w->error) {
+                w->start = __rdtscp(&aux);
+                scaling_run(mgr, &job_template, mem, w->num_jobs);
+                w->end = __rdtscp(&aux);
+                /* probe frequency right after the workload */
+                w->freq_ticks = scaling_freq_loop();
+        }
+
+        scaling_free(mem, sizeof(*mem));
+        if (mgr != NULL)
+                free_mb_mgr(mgr);
+        scaling_atomic_inc(&scaling_done);
+#ifndef _WIN32
+        return NULL;
+#endif
+}
+
+/* Runs scaling test workers on first <num> cores, returns 0 on success */
+static int
+scaling_run_workers(const int *cores, const uint32_t num,
+                    const uint32_t arch, const uint32_t algo,
+                    const uint32_t pkt_size)
+{
+#ifndef _WIN32
+        pthread_t tids[MAX_NUM_THREADS];
+#endif
+        uint32_t n;
+
+        scaling_num_workers = num;
+        scaling_ready = 0;
+        scaling_go = 0;
+        scaling_done = 0;
+
+        for (n = 0; n < num; n++) {
+                struct scaling_worker_s *w = &scaling_workers[n];
+
+                memset(w, 0, sizeof(*w));
+                w->core = cores[n];
+                w->arch = arch;
+                w->algo = algo;
+                w->pkt_size = pkt_size;
+                w->num_jobs = iter_scale / 4;
+        }
+
+        for (n = 1; n < num; n++) {
+#ifdef _WIN32
+                _beginthread(&run_scaling_worker, 0,
+                             (void *) &scaling_workers[n]);
+#else
+                pthread_attr_t attr;
+
+                pthread_attr_init(&attr);
+                pthread_create(&tids[n], &attr, run_scaling_worker,
+                               (void *) &scaling_workers[n]);
+#endif
+        }
+
+        /* main thread is the first worker */
+        run_scaling_worker((void *) &scaling_workers[0]);
+
+        while (scaling_done != num)
+                _mm_pause();
+#ifndef _WIN32
+        for (n = 1; n < num; n++)
+                pthread_join(tids[n], NULL);
+#endif
+        for (n = 0; n < num; n++)
+                if (scaling_workers[n].error)
+                        return -1;
+
+        return 0;
+}
+
+/*
+ * Prints aggregate throughput of <num> scaling test workers,
+ * efficiency against single core throughput (<gbps_one>, set if <num>
+ * is 1) and average frequency against <base_ticks> frequency baseline
+ */
+static void
+scaling_print(const uint32_t arch, const char *algo_name,
+              const uint32_t pkt_size, const uint32_t num,
+              const uint64_t base_ticks, double *gbps_one)
+{
+        uint64_t start = UINT64_MAX, end = 0;
+        uint64_t bytes = 0, nodes = 0;
+        double gbps = 0.0, freq = 0.0;
+        char nodes_str[64] = "n/a";
+        size_t len = 0;
+        uint32_t i;
+
+        for (i = 0; i < num; i++) {
+                const struct scaling_worker_s *w = &scaling_workers[i];
+
+                if (w->start < start)
+                        start = w->start;
+                if (w->end > end)
+                        end = w->end;
+                bytes += (uint64_t) w->num_jobs * w->pkt_size;
+                freq += (double) base_ticks / (double) w->freq_ticks;
+                if (w->node >= 0 && w->node < 64)
+                        nodes |= 1ULL << w->node;
+        }
+
+        /* list of NUMA nodes in use */
+        for (i = 0; i < 64 && len < sizeof(nodes_str); i++)
+                if (nodes & (1ULL << i))
+                        len += snprintf(nodes_str + len,
+                                        sizeof(nodes_str) - len, "%s%u",
+                                        len ? "," : "", i);
+
+        if (end > start)
+                gbps = ((double) bytes * 8.0 * tsc_freq /
+                        (double) (end - start)) / 1e9;
+        if (num == 1)
+                *gbps_one = gbps;
+
+        if (iter_scale == ITER_SCALE_SMOKE)
+                return;
+
+        printf("%s\t%s\t%u\t%u\t%s\t%.2f\t%.2f\t%.1f\t%.1f\n",
+               arch_str_map[arch].name, algo_name, pkt_size, num, nodes_str,
+               gbps, gbps / num,
+               (*gbps_one > 0.0) ? 100.0 * gbps / (*gbps_one * num) : 0.0,
+               100.0 * freq / num);
+}
+
+/*
+ * Runs the same AES-CBC + HMAC-SHA1 and AES-GCM workload on 1, 2, ...
+ * up to <scaling_cores> cores at the same time and reports aggregate
+ * throughput, scaling efficiency against a single core and core
+ * frequency, relative to a scalar loop run before the test
+ */
+static int
+run_scaling_tests(void)
+{
+        const char *algo_names[2] = {
+                "aes-128-cbc-hmac-sha1", "aes-128-gcm"
+        };
+        IMB_MGR *mgr = alloc_mb_mgr(flags);
+        int cores[MAX_NUM_THREADS];
+        uint64_t base_ticks = UINT64_MAX;
+        uint32_t arch, algo, sz, n;
+        int core = 0, ret = -1;
+
+        if (mgr == NULL) {
+                fprintf(stderr, "Error allocating MB_MGR structure!\n");
+                return -1;
+        }
+
+        for (n = 0; n < scaling_cores; n++) {
+                if (core_mask) {
+                        core = next_core(core_mask, core);
+                        cores[n] = core++;
+                } else
+                        cores[n] = (int) n;
+        }
+
+        /* frequency baseline: scalar code on the first core */
+        if (set_affinity(cores[0]) != 0) {
+                fprintf(stderr, "Failed to set cpu affinity on core %d\n",
+                        cores[0]);
+                goto exit;
+        }
+        for (n = 0; n < 3; n++) {
+                const uint64_t ticks = scaling_freq_loop();
+
+                if (ticks < base_ticks)
+                        base_ticks = ticks;
+        }
+        measure_tsc_freq();
+
+        printf("ARCH\tALGO\tPKT SIZE\tCORES\tNUMA NODES\tGBPS\t"
+               "GBPS PER CORE\tEFFICIENCY %%\tFREQ %%\n");
+        for (arch = 0; arch < NUM_ARCHS; arch++) {
+                if (archs[arch] == 0)
+                        continue;
+
+                switch (arch) {
+                case ARCH_SSE:
+                        init_mb_mgr_sse(mgr);
+                        break;
+                case ARCH_AVX:
+                        init_mb_mgr_avx(mgr);
+                        break;
+                case ARCH_AVX2:
+                        init_mb_mgr_avx2(mgr);
+                        break;
+                default:
+                case ARCH_AVX512:
+                        init_mb_mgr_avx512(mgr);
+                        break;
+                }
+
+                /* GCM key data layout is architecture specific */
+                sessions_init_keys(mgr, &scaling_keys, &scaling_gcm_keys, 1);
+
+                for (algo = 0; algo < DIM(algo_names); algo++)
+                        for (sz = 0; sz < DIM(sessions_pkt_sizes); sz++) {
+                                const uint32_t pkt_size =
+                                        sessions_pkt_sizes[sz];
+                                double gbps_one = 0.0;
+
+                                for (n = 1; n <= scaling_cores; n++) {
+                                        if (scaling_run_workers(cores, n,
+                                                                arch, algo,
+                                                                pkt_size) != 0)
+                                                goto exit;
+                                        scaling_print(arch, algo_names[algo],
+                                                      pkt_size, n, base_ticks,
+                                                      &gbps_one);
+                                }
+                        }
+        }
+        ret = 0;
+
+exit:
+        free_mb_mgr(mgr);
+        return ret;
+}
+
+/* Worker pool test (--pool) */
+#define POOL_BENCH_JOBS 256 /* jobs in flight */
+#define POOL_BENCH_QUEUE 64 /* job queue size of each worker */
+
+static IMB_JOB pool_bench_jobs[POOL_BENCH_JOBS];
+static DECLARE_ALIGNED(uint8_t pool_bench_bufs[POOL_BENCH_JOBS]
+                       [SESSIONS_MAX_PKT_SIZE], 64);
+static DECLARE_ALIGNED(uint8_t pool_bench_tags[POOL_BENCH_JOBS][16], 16);
+static struct session_keys_s pool_bench_keys;
+static struct gcm_key_data pool_bench_gcm_keys;
+
+/* Prepares all application jobs, each with its own buffer and tag */
+static void
+pool_bench_init_jobs(const uint32_t algo, const uint32_t pkt_size)
+{
+        uint32_t i;
+
+        for (i = 0; i < POOL_BENCH_JOBS; i++) {
+                IMB_JOB *job = &pool_bench_jobs[i];
+
+                sessions_init_job_template(job, algo, pkt_size);
+                job->src = pool_bench_bufs[i];
+                job->dst = pool_bench_bufs[i];
+                job->auth_tag_output = pool_bench_tags[i];
+                if (job->cipher_mode == IMB_CIPHER_GCM) {
+                        job->enc_keys = &pool_bench_gcm_keys;
+                        job->dec_keys = &pool_bench_gcm_keys;
+                } else {
+                        job->enc_keys = pool_bench_keys.enc_keys;
+                        job->dec_keys = pool_bench_keys.dec_keys;
+                        job->u.HMAC._hashed_auth_key_xor_ipad =
+                                (const uint8_t *) pool_bench_keys.ipad;
+                        job->u.HMAC._hashed_auth_key_xor_opad =
+                                (const uint8_t *) pool_bench_keys.opad;
+                }
+        }
+}
+
+/*
+ * Submits <num_jobs> jobs to <pool>, recycling completed jobs, with one
+ * flow per job or all jobs in a single flow. Returns TSC ticks taken.
+ */
+static uint64_t
+pool_bench_run(IMB_POOL *pool, const uint32_t num_jobs,
+               const int single_flow)
+{
+        IMB_JOB *free_jobs[POOL_BENCH_JOBS];
+        uint32_t num_free = POOL_BENCH_JOBS;
+        uint32_t submitted = 0, completed = 0, i;
+        unsigned int aux;
+        uint64_t start;
+        IMB_JOB *job;
+
+        for (i = 0; i < POOL_BENCH_JOBS; i++)
+                free_jobs[i] = &pool_bench_jobs[i];
+
+        start = __rdtscp(&aux);
+        while (completed < num_jobs) {
+                while (num_free != 0 && submitted < num_jobs) {
+                        job = free_jobs[num_free - 1];
+                        if (imb_pool_submit_job(pool, job,
+                                                single_flow ?
+                                                0 : submitted) != 0)
+                                break;
+                        num_free--;
+                        submitted++;
+                }
+                while ((job = imb_pool_get_completed_job(pool)) != NULL) {
+#ifdef DEBUG
+                        if (job->status != STS_COMPLETED) {
+                                fprintf(stderr, "failed job, status:%d\n",
+                                        job->status);
+                                return 0;
+                        }
+#endif
+                        free_jobs[num_free++] = job;
+                        completed++;
+                }
+        }
+
+        return __rdtscp(&aux) - start;
+}
+
+/*
+ * Runs AES-CBC + HMAC-SHA1 and AES-GCM jobs through worker pools of
+ * 1, 2, ... up to <pool_workers> workers, with jobs spread over all
+ * workers and with a single flow queued to one worker (other workers
+ * can only steal its jobs), and reports throughput and stolen jobs
+ */
+static int
+run_pool_tests(void)
+{
+        const char *algo_names[2] = {
+                "aes-128-cbc-hmac-sha1", "aes-128-gcm"
+        };
+        const char *flow_names[2] = { "all", "single" };
+        const uint32_t num_jobs = iter_scale / 4;
+        IMB_MGR *mgr = alloc_mb_mgr(flags);
+        uint32_t arch, algo, sz, n, single;
+        init_mb_mgr_t init_mgr;
+        int ret = -1;
+
+        if (mgr == NULL) {
+                fprintf(stderr, "Error allocating MB_MGR structure!\n");
+                return -1;
+        }
+        measure_tsc_freq();
+
+        if (iter_scale != ITER_SCALE_SMOKE)
+                printf("ARCH\tALGO\tPKT SIZE\tWORKERS\tFLOWS\tGBPS\t"
+                       "STOLEN %%\n");
+        for (arch = 0; arch < NUM_ARCHS; arch++) {
+                if (archs[arch] == 0)
+                        continue;
+
+                switch (arch) {
+                case ARCH_SSE:
+                        init_mgr = init_mb_mgr_sse;
+                        break;
+                case ARCH_AVX:
+                        init_mgr = init_mb_mgr_avx;
+                        break;
+                case ARCH_AVX2:
+                        init_mgr = init_mb_mgr_avx2;
+                        break;
+                default:
+                case ARCH_AVX512:
+                        init_mgr = init_mb_mgr_avx512;
+                        break;
+                }
+                init_mgr(mgr);
+
+                /* GCM key data layout is architecture specific */
+                sessions_init_keys(mgr, &pool_bench_keys,
+                                   &pool_bench_gcm_keys, 1);
+
+                for (algo = 0; algo < DIM(algo_names); algo++)
+                for (sz = 0; sz < DIM(sessions_pkt_sizes); sz++)
+                for (n = 1; n <= pool_workers; n++)
+                for (single = 0; single < DIM(flow_names); single++) {
+                        const uint32_t pkt_size = sessions_pkt_sizes[sz];
+                        IMB_POOL *pool = imb_pool_alloc(n, flags, init_mgr,
+                                                        POOL_BENCH_QUEUE);
+                        uint64_t ticks, stolen = 0;
+                        uint32_t w;
+
+                        if (pool == NULL) {
+                                fprintf(stderr, "Error allocating worker "
+                                        "pool!\n");
+                                goto exit;
+                        }
+                        pool_bench_init_jobs(algo, pkt_size);
+                        /* warm up */
+                        pool_bench_run(pool, num_jobs / 16, single);
+                        for (w = 0; w < n; w++)
+                                stolen -= imb_pool_stolen_jobs(pool, w);
+
+                        ticks = pool_bench_run(pool, num_jobs, single);
+                        for (w = 0; w < n; w++)
+                                stolen += imb_pool_stolen_jobs(pool, w);
+                        imb_pool_free(pool);
+                        if (ticks == 0)
+                                goto exit;
+
+                        if (iter_scale == ITER_SCALE_SMOKE)
+                                continue;
+                        printf("%s\t%s\t%u\t%u\t%s\t%.2f\t%.1f\n",
+                               arch_str_map[arch].name, algo_names[algo],
+                               pkt_size, n, flow_names[single],
+                               ((double) num_jobs * pkt_size * 8.0 *
+                                tsc_freq / (double) ticks) / 1e9,
+                               100.0 * (double) stolen / num_jobs);
+                }
+        }
+        ret = 0;
+
+exit:
+        free_mb_mgr(mgr);
+        return ret;
+}
+
+/* Direct API test (--direct-api) */
+#define DIRECT_MAX_BUFS 16
+#define DIRECT_MAX_SIZE 2048
+
+static const uint32_t direct_sizes[] = {
+        64, 128, 256, 512, 1024, 1500, DIRECT_MAX_SIZE
+};
+
+static const uint32_t direct_num_bufs[] = { 1, 2, 4, 8, DIRECT_MAX_BUFS };
+
+static DECLARE_ALIGNED(uint8_t direct_bufs[DIRECT_MAX_BUFS]
+                       [DIRECT_MAX_SIZE], 64);
+static DECLARE_ALIGNED(uint8_t direct_keys[DIRECT_MAX_BUFS][16], 16);
+static DECLARE_ALIGNED(uint8_t direct_ivs[DIRECT_MAX_BUFS][16], 16);
+static DECLARE_ALIGNED(uint8_t direct_tags[DIRECT_MAX_BUFS][64], 16);
+static uint64_t direct_kasumi_ivs[DIRECT_MAX_BUFS];
+static snow3g_key_schedule_t direct_snow3g_ks[DIRECT_MAX_BUFS];
+static kasumi_key_sched_t direct_kasumi_f8_ks;
+static kasumi_key_sched_t direct_kasumi_f9_ks;
+static DECLARE_ALIGNED(struct gcm_key_data direct_gcm_key, 64);
+static struct gcm_context_data direct_gcm_ctx;
+
+/* argument arrays of the N buffer functions */
+static const void *direct_key_ptrs[DIRECT_MAX_BUFS];
+static const void *direct_iv_ptrs[DIRECT_MAX_BUFS];
+static const void *direct_src_ptrs[DIRECT_MAX_BUFS];
+static void *direct_dst_ptrs[DIRECT_MAX_BUFS];
+static uint32_t *direct_tag_ptrs[DIRECT_MAX_BUFS];
+static const snow3g_key_schedule_t *direct_snow3g_ks_ptrs[DIRECT_MAX_BUFS];
+static uint32_t direct_lens[DIRECT_MAX_BUFS];
+static uint32_t direct_bit_lens[DIRECT_MAX_BUFS];
+
+/*
+ * Direct API function: <run> processes <num> buffers of <size> bytes
+ * and <init_job> sets up job template for the same algorithm
+ * (NULL if there is no job API equivalent)
+ */
+struct direct_func_s {
+        const char *name;
+        uint32_t min_bufs; /* min number of buffers passed in one call */
+        uint32_t max_bufs; /* max number of buffers passed in one call */
+        uint32_t fixed_size; /* input size for fixed size functions */
+        void (*run)(IMB_MGR *mgr, const uint32_t size, const uint32_t num);
+        void (*init_job)(IMB_JOB *job, const uint32_t size);
+};
+
+static void
+direct_zuc_eea3_1(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        for (i = 0; i < num; i++)
+                IMB_ZUC_EEA3_1_BUFFER(mgr, direct_keys[i], direct_ivs[i],
+                                      direct_bufs[i], direct_bufs[i], size);
+}
+
+static void
+direct_zuc_eea3_n(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        (void) size;
+        IMB_ZUC_EEA3_N_BUFFER(mgr, direct_key_ptrs, direct_iv_ptrs,
+                              direct_src_ptrs, direct_dst_ptrs, direct_lens,
+                              num);
+}
+
+static void
+direct_zuc_eia3_1(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        for (i = 0; i < num; i++)
+                IMB_ZUC_EIA3_1_BUFFER(mgr, direct_keys[i], direct_ivs[i],
+                                      direct_bufs[i], size * 8,
+                                      direct_tag_ptrs[i]);
+}
+
+static void
+direct_zuc_eia3_n(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        (void) size;
+        IMB_ZUC_EIA3_N_BUFFER(mgr, direct_key_ptrs, direct_iv_ptrs,
+                              direct_src_ptrs, direct_bit_lens,
+                              direct_tag_ptrs, num);
+}
+
+static void
+direct_snow3g_uea2_1(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        for (i = 0; i < num; i++)
+                IMB_SNOW3G_F8_1_BUFFER(mgr, &direct_snow3g_ks[i],
+                                       direct_ivs[i], direct_bufs[i],
+                                       direct_bufs[i], size);
+}
+
+static void
+direct_snow3g_uea2_8(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        (void) size;
+        (void) num;
+        IMB_SNOW3G_F8_8_BUFFER_MULTIKEY(mgr, direct_snow3g_ks_ptrs,
+                                        direct_iv_ptrs, direct_src_ptrs,
+                                        direct_dst_ptrs, direct_lens);
+}
+
+static void
+direct_snow3g_uea2_n(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        (void) size;
+        IMB_SNOW3G_F8_N_BUFFER_MULTIKEY(mgr, direct_snow3g_ks_ptrs,
+                                        direct_iv_ptrs, direct_src_ptrs,
+                                        direct_dst_ptrs, direct_lens, num);
+}
+
+static void
+direct_snow3g_uia2(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        for (i = 0; i < num; i++)
+                IMB_SNOW3G_F9_1_BUFFER(mgr, &direct_snow3g_ks[i],
+                                       direct_ivs[i], direct_bufs[i],
+                                       size * 8, direct_tags[i]);
+}
+
+static void
+direct_kasumi_uea1_1(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        for (i = 0; i < num; i++)
+                IMB_KASUMI_F8_1_BUFFER(mgr, &direct_kasumi_f8_ks,
+                                       direct_kasumi_ivs[i], direct_bufs[i],
+                                       direct_bufs[i], size);
+}
+
+static void
+direct_kasumi_uea1_n(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        (void) size;
+        IMB_KASUMI_F8_N_BUFFER(mgr, &direct_kasumi_f8_ks, direct_kasumi_ivs,
+                               direct_src_ptrs, direct_dst_ptrs, direct_lens,
+                               num);
+}
+
+static void
+direct_kasumi_uia1(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        for (i = 0; i < num; i++)
+                IMB_KASUMI_F9_1_BUFFER(mgr, &direct_kasumi_f9_ks,
+                                       direct_bufs[i], size, direct_tags[i]);
+}
+
+static void
+direct_ghash(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        for (i = 0; i < num; i++)
+                IMB_GHASH(mgr, &direct_gcm_key, direct_bufs[i], size,
+                          direct_tags[i], 16);
+}
+
+static void
+direct_gmac(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        for (i = 0; i < num; i++) {
+                IMB_AES128_GMAC_INIT(mgr, &direct_gcm_key, &direct_gcm_ctx,
+                                     direct_ivs[i], 12);
+                IMB_AES128_GMAC_UPDATE(mgr, &direct_gcm_key, &direct_gcm_ctx,
+                                       direct_bufs[i], size);
+                IMB_AES128_GMAC_FINALIZE(mgr, &direct_gcm_key,
+                                         &direct_gcm_ctx, direct_tags[i], 16);
+        }
+}
+
+static void
+direct_sha1(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        for (i = 0; i < num; i++)
+                IMB_SHA1(mgr, direct_bufs[i], size, direct_tags[i]);
+}
+
+static void
+direct_sha224(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        for (i = 0; i < num; i++)
+                IMB_SHA224(mgr, direct_bufs[i], size, direct_tags[i]);
+}
+
+static void
+direct_sha256(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        for (i = 0; i < num; i++)
+                IMB_SHA256(mgr, direct_bufs[i], size, direct_tags[i]);
+}
+
+static void
+direct_sha384(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        for (i = 0; i < num; i++)
+                IMB_SHA384(mgr, direct_bufs[i], size, direct_tags[i]);
+}
+
+static void
+direct_sha512(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        for (i = 0; i < num; i++)
+                IMB_SHA512(mgr, direct_bufs[i], size, direct_tags[i]);
+}
+
+static void
+direct_hec_32(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        (void) size;
+        for (i = 0; i < num; i++)
+                direct_tag_ptrs[i][0] = IMB_HEC_32(mgr, direct_bufs[i]);
+}
+
+static void
+direct_hec_64(IMB_MGR *mgr, const uint32_t size, const uint32_t num)
+{
+        uint32_t i;
+
+        (void) size;
+        for (i = 0; i < num; i++)
+                *((uint64_t *) direct_tags[i]) =
+                        IMB_HEC_64(mgr, direct_bufs[i]);
+}
+
+static void direct_init_job(IMB_JOB *job, const uint32_t size)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_mode = IMB_CIPHER_NULL;
+        job->hash_alg = IMB_AUTH_NULL;
+        job->cipher_direction = IMB_DIR_ENCRYPT;
+        job->chain_order = IMB_ORDER_CIPHER_HASH;
+        job->msg_len_to_cipher_in_bytes = size;
+        job->msg_len_to_hash_in_bytes = size;
+}
+
+static void direct_job_zuc_eea3(IMB_JOB *job, const uint32_t size)
+{
+        direct_init_job(job, size);
+        job->cipher_mode = IMB_CIPHER_ZUC_EEA3;
+        job->key_len_in_bytes = 16;
+        job->iv_len_in_bytes = 16;
+}
+
+static void direct_job_zuc_eia3(IMB_JOB *job, const uint32_t size)
+{
+        direct_init_job(job, size);
+        job->hash_alg = IMB_AUTH_ZUC_EIA3_BITLEN;
+        job->msg_len_to_hash_in_bits = size * 8;
+        job->auth_tag_output_len_in_bytes = 4;
+}
+
+static void direct_job_snow3g_uea2(IMB_JOB *job, const uint32_t size)
+{
+        direct_init_job(job, size);
+        job->cipher_mode = IMB_CIPHER_SNOW3G_UEA2_BITLEN;
+        job->msg_len_to_cipher_in_bits = size * 8;
+        job->key_len_in_bytes = 16;
+        job->iv_len_in_bytes = 16;
+}
+
+static void direct_job_snow3g_uia2(IMB_JOB *job, const uint32_t size)
+{
+        direct_init_job(job, size);
+        job->hash_alg = IMB_AUTH_SNOW3G_UIA2_BITLEN;
+        job->msg_len_to_hash_in_bits = size * 8;
+        job->auth_tag_output_len_in_bytes = 4;
+}
+
+static void direct_job_kasumi_uea1(IMB_JOB *job, const uint32_t size)
+{
+        direct_init_job(job, size);
+        job->cipher_mode = IMB_CIPHER_KASUMI_UEA1_BITLEN;
+        job->msg_len_to_cipher_in_bits = size * 8;
+        job->enc_keys = &direct_kasumi_f8_ks;
+        job->key_len_in_bytes = 16;
+        job->iv_len_in_bytes = 8;
+}
+
+static void direct_job_kasumi_uia1(IMB_JOB *job, const uint32_t size)
+{
+        direct_init_job(job, size);
+        job->hash_alg = IMB_AUTH_KASUMI_UIA1;
+        job->u.KASUMI_UIA1._key = &direct_kasumi_f9_ks;
+        job->auth_tag_output_len_in_bytes = 4;
+}
 
-        if (total_variants == 0) {
-                fprintf(stderr, "No tests to be run\n");
-                goto exit;
-        }
+static void direct_job_gmac(IMB_JOB *job, const uint32_t size)
+{
+        direct_init_job(job, size);
+        job->hash_alg = IMB_AUTH_AES_GMAC_128;
+        job->u.GMAC._key = &direct_gcm_key;
+        job->u.GMAC.iv_len_in_bytes = 12;
+        job->auth_tag_output_len_in_bytes = 16;
+}
 
-        if (info->print_info && !silent_progress_bar)
-                fprintf(stderr, "Total number of combinations (algos, "
-                        "key sizes, cipher directions) to test = %u\n",
-                        total_variants);
+static void direct_job_sha1(IMB_JOB *job, const uint32_t size)
+{
+        direct_init_job(job, size);
+        job->hash_alg = IMB_AUTH_SHA_1;
+        job->auth_tag_output_len_in_bytes = 20;
+}
 
-        variant_list = (struct variant_s *)
-                malloc(total_variants * sizeof(struct variant_s));
-        if (variant_list == NULL) {
-                fprintf(stderr, "Cannot allocate memory\n");
-                goto exit_failure;
-        }
+static void direct_job_sha224(IMB_JOB *job, const uint32_t size)
+{
+        direct_init_job(job, size);
+        job->hash_alg = IMB_AUTH_SHA_224;
+        job->auth_tag_output_len_in_bytes = 28;
+}
 
-        at_size = NUM_RUNS * params.num_sizes * sizeof(uint64_t);
-        for (variant = 0, variant_ptr = variant_list;
-             variant < total_variants;
-             variant++, variant_ptr++) {
-                variant_ptr->avg_times = (uint64_t *) malloc(at_size);
-                if (!variant_ptr->avg_times) {
-                        fprintf(stderr, "Cannot allocate memory\n");
-                        goto exit_failure;
+static void direct_job_sha256(IMB_JOB *job, const uint32_t size)
+{
+        direct_init_job(job, size);
+        job->hash_alg = IMB_AUTH_SHA_256;
+        job->auth_tag_output_len_in_bytes = 32;
+}
+
+static void direct_job_sha384(IMB_JOB *job, const uint32_t size)
+{
+        direct_init_job(job, size);
+        job->hash_alg = IMB_AUTH_SHA_384;
+        job->auth_tag_output_len_in_bytes = 48;
+}
+
+static void direct_job_sha512(IMB_JOB *job, const uint32_t size)
+{
+        direct_init_job(job, size);
+        job->hash_alg = IMB_AUTH_SHA_512;
+        job->auth_tag_output_len_in_bytes = 64;
+}
+
+static const struct direct_func_s direct_funcs[] = {
+        { "zuc-eea3-1-buffer", 1, 1, 0, direct_zuc_eea3_1,
+          direct_job_zuc_eea3 },
+        { "zuc-eea3-n-buffer", 1, DIRECT_MAX_BUFS, 0, direct_zuc_eea3_n,
+          direct_job_zuc_eea3 },
+        { "zuc-eia3-1-buffer", 1, 1, 0, direct_zuc_eia3_1,
+          direct_job_zuc_eia3 },
+        { "zuc-eia3-n-buffer", 1, DIRECT_MAX_BUFS, 0, direct_zuc_eia3_n,
+          direct_job_zuc_eia3 },
+        { "snow3g-uea2-1-buffer", 1, 1, 0, direct_snow3g_uea2_1,
+          direct_job_snow3g_uea2 },
+        { "snow3g-uea2-8-buffer-multikey", 8, 8, 0, direct_snow3g_uea2_8,
+          direct_job_snow3g_uea2 },
+        { "snow3g-uea2-n-buffer-multikey", 1, DIRECT_MAX_BUFS, 0,
+          direct_snow3g_uea2_n, direct_job_snow3g_uea2 },
+        { "snow3g-uia2-1-buffer", 1, 1, 0, direct_snow3g_uia2,
+          direct_job_snow3g_uia2 },
+        { "kasumi-uea1-1-buffer", 1, 1, 0, direct_kasumi_uea1_1,
+          direct_job_kasumi_uea1 },
+        { "kasumi-uea1-n-buffer", 1, DIRECT_MAX_BUFS, 0,
+          direct_kasumi_uea1_n, direct_job_kasumi_uea1 },
+        { "kasumi-uia1-1-buffer", 1, 1, 0, direct_kasumi_uia1,
+          direct_job_kasumi_uia1 },
+        { "ghash", 1, 1, 0, direct_ghash, NULL },
+        { "aes-128-gmac", 1, 1, 0, direct_gmac, direct_job_gmac },
+        { "sha1", 1, 1, 0, direct_sha1, direct_job_sha1 },
+        { "sha224", 1, 1, 0, direct_sha224, direct_job_sha224 },
+        { "sha256", 1, 1, 0, direct_sha256, direct_job_sha256 },
+        { "sha384", 1, 1, 0, direct_sha384, direct_job_sha384 },
+        { "sha512", 1, 1, 0, direct_sha512, direct_job_sha512 },
+        { "hec-32", 1, 1, 4, direct_hec_32, NULL },
+        { "hec-64", 1, 1, 8, direct_hec_64, NULL },
+};
+
+/* Submits <num> jobs (one per buffer) and flushes, <num_calls> times */
+static uint64_t
+direct_run_jobs(IMB_MGR *mgr, const IMB_JOB *job_template,
+                const uint32_t num, const uint32_t num_calls)
+{
+        IMB_JOB *job;
+        uint64_t cycles;
+        unsigned int aux;
+        uint32_t i, j;
+
+        cycles = __rdtscp(&aux);
+        for (i = 0; i < num_calls; i++) {
+                for (j = 0; j < num; j++) {
+                        job = IMB_GET_NEXT_JOB(mgr);
+                        *job = *job_template;
+                        job->src = direct_bufs[j];
+                        job->dst = direct_bufs[j];
+                        job->auth_tag_output = direct_tags[j];
+                        if (job->cipher_mode == IMB_CIPHER_ZUC_EEA3) {
+                                job->enc_keys = direct_keys[j];
+                                job->iv = direct_ivs[j];
+                        } else if (job->cipher_mode ==
+                                   IMB_CIPHER_SNOW3G_UEA2_BITLEN) {
+                                job->enc_keys = &direct_snow3g_ks[j];
+                                job->iv = direct_ivs[j];
+                        } else if (job->cipher_mode ==
+                                   IMB_CIPHER_KASUMI_UEA1_BITLEN) {
+                                job->iv = (const uint8_t *)
+                                        &direct_kasumi_ivs[j];
+                        }
+                        if (job->hash_alg == IMB_AUTH_ZUC_EIA3_BITLEN) {
+                                job->u.ZUC_EIA3._key = direct_keys[j];
+                                job->u.ZUC_EIA3._iv = direct_ivs[j];
+                        } else if (job->hash_alg ==
+                                   IMB_AUTH_SNOW3G_UIA2_BITLEN) {
+                                job->u.SNOW3G_UIA2._key =
+                                        &direct_snow3g_ks[j];
+                                job->u.SNOW3G_UIA2._iv = direct_ivs[j];
+                        } else if (job->hash_alg == IMB_AUTH_AES_GMAC_128) {
+                                job->u.GMAC._iv = direct_ivs[j];
+                        }
+#ifdef DEBUG
+                        job = IMB_SUBMIT_JOB(mgr);
+#else
+                        job = IMB_SUBMIT_JOB_NOCHECK(mgr);
+#endif
+                        while (job)
+                                job = IMB_GET_COMPLETED_JOB(mgr);
                 }
+                while (IMB_FLUSH_JOB(mgr) != NULL)
+                        ;
         }
 
-        for (run = 0; run < NUM_RUNS; run++) {
-                if (info->print_info)
-                        fprintf(stderr, "\nStarting run %d of %d%c",
-                                run+1, NUM_RUNS,
-                                silent_progress_bar ? '\r' : '\n' );
+        return __rdtscp(&aux) - cycles;
+}
 
-                variant = 0;
-                variant_ptr = variant_list;
+static uint64_t
+direct_run(IMB_MGR *mgr, const struct direct_func_s *func,
+           const uint32_t size, const uint32_t num, const uint32_t num_calls)
+{
+        uint64_t cycles;
+        unsigned int aux;
+        uint32_t i;
 
-                if (iter_scale == ITER_SCALE_SMOKE && run != 0)
-                        continue;
+        cycles = __rdtscp(&aux);
+        for (i = 0; i < num_calls; i++)
+                func->run(mgr, size, num);
 
-                if (info->print_info)
-                        prog_bar_init(total_variants);
+        return __rdtscp(&aux) - cycles;
+}
 
-                for (type = TTYPE_AES_HMAC; type < NUM_TTYPES; type++) {
-                        if (test_types[type] == 0)
-                                continue;
+/* Sets up keys and argument arrays of the N buffer functions */
+static void direct_init(IMB_MGR *mgr, const uint32_t size)
+{
+        uint8_t gcm_key[16];
+        uint32_t i;
 
-                        max_arch = NUM_ARCHS;
+        for (i = 0; i < DIRECT_MAX_BUFS; i++) {
+                IMB_SNOW3G_INIT_KEY_SCHED(mgr, direct_keys[i],
+                                          &direct_snow3g_ks[i]);
+                direct_key_ptrs[i] = direct_keys[i];
+                direct_iv_ptrs[i] = direct_ivs[i];
+                direct_src_ptrs[i] = direct_bufs[i];
+                direct_dst_ptrs[i] = direct_bufs[i];
+                direct_tag_ptrs[i] = (uint32_t *) direct_tags[i];
+                direct_snow3g_ks_ptrs[i] = &direct_snow3g_ks[i];
+                direct_lens[i] = size;
+                direct_bit_lens[i] = size * 8;
+        }
+        IMB_KASUMI_INIT_F8_KEY_SCHED(mgr, direct_keys[0],
+                                     &direct_kasumi_f8_ks);
+        IMB_KASUMI_INIT_F9_KEY_SCHED(mgr, direct_keys[0],
+                                     &direct_kasumi_f9_ks);
+        memcpy(gcm_key, direct_keys[0], sizeof(gcm_key));
+        IMB_AES128_GCM_PRE(mgr, gcm_key, &direct_gcm_key);
+}
 
-                        params.num_variants = num_variants[type];
-                        params.test_type = type;
-                        /* Performing tests for each selected architecture */
-                        for (arch = 0; arch < max_arch; arch++) {
-                                if (archs[arch] == 0)
-                                        continue;
-                                run_dir_test(p_mgr, arch, &params, run,
-                                             &variant_ptr, &variant, buf,
-                                             keys, info->print_info);
-                        }
-                } /* end for type */
-                if (info->print_info)
-                        prog_bar_fini();
+/*
+ * Measures <func> processing <num> buffers of <size> bytes,
+ * and the job API processing the same buffers, if available
+ */
+static void
+direct_measure(IMB_MGR *mgr, const uint32_t arch,
+               const struct direct_func_s *func, const uint32_t size,
+               const uint32_t num)
+{
+        uint32_t num_calls = (iter_scale * 16) / (size * num);
+        uint64_t cycles, job_cycles;
+        char job_str[32] = "-";
+
+        if (num_calls == 0)
+                num_calls = 1;
+
+        /* warm up */
+        direct_run(mgr, func, size, num, (num_calls / 16) + 1);
+        cycles = direct_run(mgr, func, size, num, num_calls);
+        cycles /= (uint64_t) num_calls * num;
+
+        if (func->init_job != NULL) {
+                IMB_JOB job_template;
+
+                func->init_job(&job_template, size);
+                direct_run_jobs(mgr, &job_template, num,
+                                (num_calls / 16) + 1);
+                job_cycles = direct_run_jobs(mgr, &job_template, num,
+                                             num_calls);
+                job_cycles /= (uint64_t) num_calls * num;
+                snprintf(job_str, sizeof(job_str), "%"PRIu64, job_cycles);
+        }
 
-        } /* end for run */
-        if (info->print_info == 1 && iter_scale != ITER_SCALE_SMOKE) {
-                fprintf(stderr, "\n");
-                print_times(variant_list, &params, total_variants, buf, keys);
+        if (iter_scale == ITER_SCALE_SMOKE)
+                return;
+
+        printf("%s\t%s\t%u\t%u\t%"PRIu64"\t%.2f\t%s\n",
+               arch_str_map[arch].name, func->name, size, num, cycles,
+               (double) cycles / size, job_str);
+}
+
+/*
+ * Measures direct API functions (3GPP N buffer API's, GHASH, GMAC,
+ * SHA, HEC) over a range of buffer sizes and buffer counts,
+ * next to the job API processing the same buffers
+ */
+static int
+run_direct_api_tests(void)
+{
+        IMB_MGR *mgr = alloc_mb_mgr(flags);
+        uint32_t arch, f, sz, nb;
+
+        if (mgr == NULL) {
+                fprintf(stderr, "Error allocating MB_MGR structure!\n");
+                return -1;
         }
 
-exit:
-        if (variant_list != NULL) {
-                /* Freeing variants list */
-                for (i = 0; i < total_variants; i++)
-                        free(variant_list[i].avg_times);
-                free(variant_list);
+        init_buf(direct_bufs, sizeof(direct_bufs));
+        init_buf(direct_keys, sizeof(direct_keys));
+        init_buf(direct_ivs, sizeof(direct_ivs));
+        for (f = 0; f < DIRECT_MAX_BUFS; f++)
+                direct_kasumi_ivs[f] = (uint64_t) rand();
+
+        printf("ARCH\tFUNCTION\tSIZE\tBUFFERS\tCYCLES PER BUF\t"
+               "CYCLES PER BYTE\tJOB API CYCLES PER BUF\n");
+        for (arch = 0; arch < NUM_ARCHS; arch++) {
+                if (archs[arch] == 0)
+                        continue;
+
+                switch (arch) {
+                case ARCH_SSE:
+                        init_mb_mgr_sse(mgr);
+                        break;
+                case ARCH_AVX:
+                        init_mb_mgr_avx(mgr);
+                        break;
+                case ARCH_AVX2:
+                        init_mb_mgr_avx2(mgr);
+                        break;
+                default:
+                case ARCH_AVX512:
+                        init_mb_mgr_avx512(mgr);
+                        break;
+                }
+
+                for (f = 0; f < DIM(direct_funcs); f++) {
+                        const struct direct_func_s *func = &direct_funcs[f];
+
+                        for (sz = 0; sz < DIM(direct_sizes); sz++) {
+                                const uint32_t size = func->fixed_size ?
+                                        func->fixed_size : direct_sizes[sz];
+
+                                direct_init(mgr, size);
+                                for (nb = 0; nb < DIM(direct_num_bufs); nb++)
+                                        if (direct_num_bufs[nb] >=
+                                            func->min_bufs &&
+                                            direct_num_bufs[nb] <=
+                                            func->max_bufs)
+                                                direct_measure(mgr, arch, func,
+                                                        size,
+                                                        direct_num_bufs[nb]);
+
+                                /* fixed size functions run one size only */
+                                if (func->fixed_size)
+                                        break;
+                        }
+                }
         }
-        free_mem(&buf, &keys);
-        free_mb_mgr(p_mgr);
-#ifndef _WIN32
-        return NULL;
 
-#else
-        return;
-#endif
-exit_failure:
-        if (variant_list != NULL)
-                free(variant_list);
-        free_mem(&buf, &keys);
-        free_mb_mgr(p_mgr);
-        exit(EXIT_FAILURE);
+        free_mb_mgr(mgr);
+        return 0;
 }
 
 static void usage(void)
@@ -2333,6 +5483,8 @@ static void usage(void)
                 "--no-kasumi: do not run KASUMI perf tests\n"
                 "--gcm-job-api: use JOB API for GCM perf tests"
                 " (raw GCM API is default)\n"
+                "--stitch: lay out ZUC/SNOW3G cipher and hash jobs as "
+                "PDUs (header + payload)\n"
                 "--threads num: <num> for the number of threads to run"
                 " Max: %d\n"
                 "--cores mask: <mask> CPU's to run threads\n"
@@ -2347,9 +5499,79 @@ static void usage(void)
                 "            - range: test multiple sizes with following format"
                 " min:step:max (e.g. 16:16:256)\n"
                 "            (-o still applies for MAC)\n"
+                "--imix dist: mixed job sizes picked at random for each "
+                "job,\n"
+                "             overrides --job-size. <dist> can be:\n"
+                "            - std: 64, 576 and 1500 bytes in 7:4:1 "
+                "proportion\n"
+                "            - list of size:weight pairs (e.g. "
+                "64:7,576:4,1500:1)\n"
+                "            Sizes are rounded up to a multiple of 16 bytes.\n"
+                "            Reports cycles per packet and per byte and "
+                "packets/s\n"
                 "--aad-size: size of AAD for AEAD algorithms\n"
                 "--job-iter: number of tests iterations for each job size\n"
-                "--no-progress-bar: Don't display progress bar\n",
+                "--no-progress-bar: Don't display progress bar\n"
+                "--keyexp: measure AES key expansion and GCM key "
+                "pre-processing rate\n"
+                "          (single and multiple key API's), key setup rate\n"
+                "          of CMAC, XCBC, DES, SNOW3G, KASUMI and HMAC "
+                "ipad/opad\n"
+                "          derivation, and exit\n"
+                "--gcm-sa num: measure AES-GCM encryption with <num> SA's,\n"
+                "              picked at random for each packet, using full\n"
+                "              and compact key data and exit\n"
+                "--output-format fmt: text (default), json or csv. JSON "
+                "and CSV\n"
+                "           include run configuration, all run samples "
+                "(JSON)\n"
+                "           and their min/max/mean/variance\n"
+                "--latency: measure cycles between submission and "
+                "completion\n"
+                "           of each job and report P50/P90/P99/P99.9\n"
+                "           latency (RDTSC based), GCM uses JOB API\n"
+                "--latency-load num: flush the manager after every <num> "
+                "jobs\n"
+                "           (offered load), implies --latency. "
+                "Default: no flush\n"
+                "--pmu: collect cycles, instructions, IPC, ref cycles, L1D "
+                "and LLC\n"
+                "           misses and branch misses per job with "
+                "perf_event_open\n"
+                "           (Linux only, no root required if "
+                "perf_event_paranoid <= 2)\n"
+                "--safe-burst num: SAFE_DATA library only, clear scratch "
+                "registers\n"
+                "           with IMB_CLEAR_SCRATCH() after every <num> jobs "
+                "instead\n"
+                "           of every job submit/flush "
+                "(IMB_FLAG_SAFE_DATA_BURST)\n"
+                "--completion-cb: receive completed jobs with a completion "
+                "callback\n"
+                "           (imb_set_completion_cb()) instead of "
+                "IMB_GET_COMPLETED_JOB()\n"
+                "--num-sessions num: measure AES-CBC + HMAC-SHA1 and AES-GCM\n"
+                "              job throughput with 1, 4, 16, ... up to <num>\n"
+                "              sessions, each with its own key material,\n"
+                "              picked at random for each job, and exit\n"
+                "--session-dist dist: session selection for --num-sessions,\n"
+                "              uniform (default) or zipf\n"
+                "--scaling num: run AES-CBC + HMAC-SHA1 and AES-GCM on 1, 2,\n"
+                "              ... up to <num> cores (from --cores mask if\n"
+                "              given), report aggregate throughput, scaling\n"
+                "              efficiency and core frequency, and exit\n"
+                "--pool num: run AES-CBC + HMAC-SHA1 and AES-GCM through "
+                "worker pools\n"
+                "              of 1, 2, ... up to <num> workers, with jobs "
+                "spread over\n"
+                "              all workers and in a single flow, report "
+                "throughput\n"
+                "              and jobs stolen by idle workers, and exit\n"
+                "--direct-api: measure direct API's (ZUC/SNOW3G/KASUMI 1 and "
+                "N buffer,\n"
+                "              GHASH, GMAC, SHA, HEC) over a range of buffer\n"
+                "              sizes and buffer counts, next to the job API\n"
+                "              on the same buffers, and exit\n",
                 MAX_NUM_THREADS + 1);
 }
 
@@ -2430,6 +5652,8 @@ detect_arch(unsigned int arch_support[NUM_ARCHS])
                 return -1;
         }
 
+        mgr_features = p_mgr->features;
+
         if ((p_mgr->features & detect_avx512) != detect_avx512)
                 arch_support[ARCH_AVX512] = 0;
 
@@ -2549,6 +5773,141 @@ end_range:
 
 }
 
+/*
+ * Parses IMIX packet size distribution: "std" for the standard 7:4:1
+ * distribution of 64, 576 and 1500 byte packets, or a list of
+ * <size>:<weight> pairs separated by commas (e.g. 64:7,576:4,1500:1).
+ * Sizes are rounded up to a multiple of 16 bytes (cipher block size).
+ */
+static int
+parse_imix(const char * const *argv, const int index, const int argc)
+{
+        const char *std_imix = "64:7,576:4,1500:1";
+        const char *arg;
+        char *copy_arg, *token;
+
+        if (argv == NULL || index < 0 || argc < 0) {
+                fprintf(stderr, "%s() internal error!\n", __func__);
+                exit(EXIT_FAILURE);
+        }
+
+        if (index >= (argc - 1)) {
+                fprintf(stderr, "'%s' requires an argument!\n", argv[index]);
+                exit(EXIT_FAILURE);
+        }
+
+        arg = argv[index + 1];
+        if (strcmp(arg, "std") == 0)
+                arg = std_imix;
+
+        copy_arg = strdup(arg);
+        if (copy_arg == NULL) {
+                fprintf(stderr, "%s() internal error!\n", __func__);
+                exit(EXIT_FAILURE);
+        }
+
+        imix_num_sizes = 0;
+        for (token = strtok(copy_arg, ","); token != NULL;
+             token = strtok(NULL, ",")) {
+                char *endptr = NULL;
+                unsigned long size, weight;
+
+                if (imix_num_sizes == IMIX_MAX_SIZES) {
+                        fprintf(stderr, "Too many IMIX sizes (max %u)\n",
+                                IMIX_MAX_SIZES);
+                        exit(EXIT_FAILURE);
+                }
+
+                size = strtoul(token, &endptr, 10);
+                if (endptr == token || *endptr != ':')
+                        goto invalid;
+                token = endptr + 1;
+                weight = strtoul(token, &endptr, 10);
+                if (endptr == token || *endptr != '\0')
+                        goto invalid;
+
+                size = (size + 15) & ~15UL;
+                if (size == 0 || size > JOB_SIZE_TOP || weight == 0 ||
+                    weight > IMIX_LIST_SIZE) {
+                        fprintf(stderr, "Invalid IMIX size/weight %lu:%lu "
+                                "(max size %u, max weight %u)\n",
+                                size, weight, JOB_SIZE_TOP, IMIX_LIST_SIZE);
+                        exit(EXIT_FAILURE);
+                }
+
+                imix_sizes[imix_num_sizes].size = (uint32_t) size;
+                imix_sizes[imix_num_sizes].weight = (uint32_t) weight;
+                imix_num_sizes++;
+        }
+
+        if (imix_num_sizes == 0)
+                goto invalid;
+
+        free(copy_arg);
+        return (index + 1);
+
+invalid:
+        fprintf(stderr, "Invalid IMIX distribution '%s'\n", argv[index + 1]);
+        free(copy_arg);
+        exit(EXIT_FAILURE);
+}
+
+/*
+ * Builds shuffled list of job sizes following IMIX weights
+ * and measures TSC frequency to report packets per second
+ */
+static void
+init_imix(void)
+{
+        uint32_t total_weight = 0, max_weight_idx = 0;
+        uint64_t total_bytes = 0;
+        uint32_t i, n = 0;
+
+        for (i = 0; i < imix_num_sizes; i++) {
+                total_weight += imix_sizes[i].weight;
+                if (imix_sizes[i].weight > imix_sizes[max_weight_idx].weight)
+                        max_weight_idx = i;
+        }
+
+        for (i = 0; i < imix_num_sizes; i++) {
+                uint32_t cnt = (uint32_t)
+                        (((uint64_t) imix_sizes[i].weight * IMIX_LIST_SIZE) /
+                         total_weight);
+
+                if (cnt == 0)
+                        cnt = 1;
+
+                for (; cnt != 0 && n < IMIX_LIST_SIZE; cnt--)
+                        imix_list[n++] = i;
+        }
+
+        /* slots left by rounding go to the most frequent size */
+        while (n < IMIX_LIST_SIZE)
+                imix_list[n++] = max_weight_idx;
+
+        /* shuffle, so that lanes get sizes in random order */
+        for (i = IMIX_LIST_SIZE - 1; i > 0; i--) {
+                const uint32_t j = (uint32_t) rand() % (i + 1);
+                const uint32_t tmp = imix_list[i];
+
+                imix_list[i] = imix_list[j];
+                imix_list[j] = tmp;
+        }
+
+        for (i = 0; i < IMIX_LIST_SIZE; i++)
+                total_bytes += imix_sizes[imix_list[i]].size;
+        imix_avg_size = (double) total_bytes / IMIX_LIST_SIZE;
+
+        measure_tsc_freq();
+
+        fprintf(stderr, "IMIX sizes =");
+        for (i = 0; i < imix_num_sizes; i++)
+                fprintf(stderr, " %u:%u", imix_sizes[i].size,
+                        imix_sizes[i].weight);
+        fprintf(stderr, ", average size = %.1f bytes\n", imix_avg_size);
+        fprintf(stderr, "TSC frequency = %.0f MHz\n", tsc_freq / 1e6);
+}
+
 int main(int argc, char *argv[])
 {
         uint32_t num_t = 0;
@@ -2616,6 +5975,8 @@ int main(int argc, char *argv[])
                         test_types[TTYPE_KASUMI] = 0;
                 } else if (strcmp(argv[i], "--gcm-job-api") == 0) {
                         use_gcm_job_api = 1;
+                } else if (strcmp(argv[i], "--stitch") == 0) {
+                        stitch = 1;
                 } else if (strcmp(argv[i], "--quick") == 0) {
                         iter_scale = ITER_SCALE_SHORT;
                 } else if (strcmp(argv[i], "--smoke") == 0) {
@@ -2702,6 +6063,8 @@ int main(int argc, char *argv[])
                                        JOB_SIZE_TOP);
                                 return EXIT_FAILURE;
                         }
+                } else if (strcmp(argv[i], "--imix") == 0) {
+                        i = parse_imix((const char * const *)argv, i, argc);
                 } else if (strcmp(argv[i], "--aad-size") == 0) {
                         /* Get AAD size for both GCM and CCM */
                         i = get_next_num_arg((const char * const *)argv, i,
@@ -2733,6 +6096,106 @@ int main(int argc, char *argv[])
                         use_unhalted_cycles = 1;
                 } else if (strcmp(argv[i], "--no-progress-bar") == 0) {
                         silent_progress_bar = 1;
+                } else if (strcmp(argv[i], "--keyexp") == 0) {
+                        keyexp_test = 1;
+                } else if (strcmp(argv[i], "--gcm-sa") == 0) {
+                        i = get_next_num_arg((const char * const *)argv, i,
+                                             argc, &gcm_sa_num,
+                                             sizeof(gcm_sa_num));
+                        if (gcm_sa_num == 0) {
+                                fprintf(stderr, "Invalid number of SA's!\n");
+                                return EXIT_FAILURE;
+                        }
+                } else if (strcmp(argv[i], "--output-format") == 0) {
+                        if (i >= (argc - 1)) {
+                                fprintf(stderr, "'%s' requires an argument!\n",
+                                        argv[i]);
+                                return EXIT_FAILURE;
+                        }
+                        if (strcmp(argv[i + 1], "text") == 0) {
+                                output_format = OUTPUT_TEXT;
+                        } else if (strcmp(argv[i + 1], "json") == 0) {
+                                output_format = OUTPUT_JSON;
+                        } else if (strcmp(argv[i + 1], "csv") == 0) {
+                                output_format = OUTPUT_CSV;
+                        } else {
+                                fprintf(stderr, "Invalid output format "
+                                        "'%s'!\n", argv[i + 1]);
+                                return EXIT_FAILURE;
+                        }
+                        i++;
+                } else if (strcmp(argv[i], "--latency") == 0) {
+                        latency_test = 1;
+                } else if (strcmp(argv[i], "--latency-load") == 0) {
+                        i = get_next_num_arg((const char * const *)argv, i,
+                                             argc, &latency_load,
+                                             sizeof(latency_load));
+                        latency_test = 1;
+                } else if (strcmp(argv[i], "--pmu") == 0) {
+#ifdef _WIN32
+                        fprintf(stderr, "--pmu is only supported on Linux!\n");
+                        return EXIT_FAILURE;
+#else
+                        pmu_test = 1;
+#endif
+                } else if (strcmp(argv[i], "--safe-burst") == 0) {
+                        i = get_next_num_arg((const char * const *)argv, i,
+                                             argc, &safe_burst,
+                                             sizeof(safe_burst));
+                        if (safe_burst == 0) {
+                                fprintf(stderr, "Invalid burst size!\n");
+                                return EXIT_FAILURE;
+                        }
+                        flags |= IMB_FLAG_SAFE_DATA_BURST;
+                } else if (strcmp(argv[i], "--completion-cb") == 0) {
+                        completion_cb = 1;
+                } else if (strcmp(argv[i], "--num-sessions") == 0) {
+                        i = get_next_num_arg((const char * const *)argv, i,
+                                             argc, &num_sessions,
+                                             sizeof(num_sessions));
+                        if (num_sessions == 0 || num_sessions > SESSIONS_MAX) {
+                                fprintf(stderr, "Invalid number of sessions "
+                                        "(max %u)!\n", SESSIONS_MAX);
+                                return EXIT_FAILURE;
+                        }
+                } else if (strcmp(argv[i], "--direct-api") == 0) {
+                        direct_api_test = 1;
+                } else if (strcmp(argv[i], "--scaling") == 0) {
+                        i = get_next_num_arg((const char * const *)argv, i,
+                                             argc, &scaling_cores,
+                                             sizeof(scaling_cores));
+                        if (scaling_cores == 0 ||
+                            scaling_cores > MAX_NUM_THREADS) {
+                                fprintf(stderr, "Invalid number of cores "
+                                        "(max %u)!\n", MAX_NUM_THREADS);
+                                return EXIT_FAILURE;
+                        }
+                } else if (strcmp(argv[i], "--pool") == 0) {
+                        i = get_next_num_arg((const char * const *)argv, i,
+                                             argc, &pool_workers,
+                                             sizeof(pool_workers));
+                        if (pool_workers == 0 ||
+                            pool_workers > MAX_NUM_THREADS) {
+                                fprintf(stderr, "Invalid number of workers "
+                                        "(max %u)!\n", MAX_NUM_THREADS);
+                                return EXIT_FAILURE;
+                        }
+                } else if (strcmp(argv[i], "--session-dist") == 0) {
+                        if (i >= (argc - 1)) {
+                                fprintf(stderr, "'%s' requires an argument!\n",
+                                        argv[i]);
+                                return EXIT_FAILURE;
+                        }
+                        if (strcmp(argv[i + 1], "uniform") == 0) {
+                                sessions_zipf = 0;
+                        } else if (strcmp(argv[i + 1], "zipf") == 0) {
+                                sessions_zipf = 1;
+                        } else {
+                                fprintf(stderr, "Invalid session "
+                                        "distribution '%s'!\n", argv[i + 1]);
+                                return EXIT_FAILURE;
+                        }
+                        i++;
                 } else {
                         usage();
                         return EXIT_FAILURE;
@@ -2785,6 +6248,13 @@ int main(int argc, char *argv[])
                 return EXIT_FAILURE;
         }
 
+        if (core_mask != 0 && scaling_cores > bitcount(core_mask)) {
+                fprintf(stderr, "Insufficient number of cores in "
+                        "core mask (0x%lx) to scale up to %u cores!\n",
+                        (unsigned long) core_mask, scaling_cores);
+                return EXIT_FAILURE;
+        }
+
         /* if cycles selected then init MSR module */
         if (use_unhalted_cycles) {
                 if (core_mask == 0) {
@@ -2842,6 +6312,50 @@ int main(int argc, char *argv[])
 
         srand(ITER_SCALE_LONG + ITER_SCALE_SHORT + ITER_SCALE_SMOKE);
 
+        if (imix_num_sizes != 0)
+                init_imix();
+
+        if (latency_test && use_gcm_job_api == 0) {
+                fprintf(stderr, "Latency measured with JOB API for GCM\n");
+                use_gcm_job_api = 1;
+        }
+
+        if (keyexp_test) {
+                if (run_keyexp_tests() != 0)
+                        return EXIT_FAILURE;
+                return EXIT_SUCCESS;
+        }
+
+        if (gcm_sa_num != 0) {
+                if (run_gcm_sa_tests() != 0)
+                        return EXIT_FAILURE;
+                return EXIT_SUCCESS;
+        }
+
+        if (num_sessions != 0) {
+                if (run_sessions_tests() != 0)
+                        return EXIT_FAILURE;
+                return EXIT_SUCCESS;
+        }
+
+        if (direct_api_test) {
+                if (run_direct_api_tests() != 0)
+                        return EXIT_FAILURE;
+                return EXIT_SUCCESS;
+        }
+
+        if (scaling_cores != 0) {
+                if (run_scaling_tests() != 0)
+                        return EXIT_FAILURE;
+                return EXIT_SUCCESS;
+        }
+
+        if (pool_workers != 0) {
+                if (run_pool_tests() != 0)
+                        return EXIT_FAILURE;
+                return EXIT_SUCCESS;
+        }
+
         if (num_t > 1) {
                 uint32_t n;
 
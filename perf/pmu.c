@@ -0,0 +1,193 @@
+/**********************************************************************
+  Copyright(c) 2020 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+/**
+ * @brief Provides access to hardware performance counters
+ *        through Linux perf_event_open() system call
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "pmu.h"
+
+#ifndef _WIN32
+/** Counter definitions, in enum pmu_ctr order */
+static const struct {
+        uint32_t type;
+        uint64_t config;
+} m_events[PMU_NUM_CTRS] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_REF_CPU_CYCLES },
+        { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+          (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+static int m_fd[PMU_NUM_CTRS];          /**< counter file descriptors */
+static int m_leader = -1;               /**< group leader descriptor */
+static unsigned m_num_open = 0;         /**< number of open counters */
+static enum pmu_ctr m_order[PMU_NUM_CTRS]; /**< counters in group order */
+
+static int
+perf_event_open(struct perf_event_attr *attr, const int group_fd)
+{
+        /* calling thread, any CPU */
+        return (int) syscall(__NR_perf_event_open, attr, 0, -1, group_fd, 0);
+}
+#endif /* _WIN32 */
+
+int pmu_init(void)
+{
+#ifdef _WIN32
+        return PMU_RETVAL_ERROR;
+#else
+        unsigned i;
+
+        if (m_leader >= 0)
+                return PMU_RETVAL_OK;
+
+        for (i = 0; i < PMU_NUM_CTRS; i++) {
+                struct perf_event_attr attr;
+
+                memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = m_events[i].type;
+                attr.config = m_events[i].config;
+                attr.disabled = (m_leader < 0);
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP |
+                        PERF_FORMAT_TOTAL_TIME_ENABLED |
+                        PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                m_fd[i] = perf_event_open(&attr, m_leader);
+                if (m_fd[i] < 0)
+                        continue;
+                if (m_leader < 0)
+                        m_leader = m_fd[i];
+                m_order[m_num_open++] = (enum pmu_ctr) i;
+        }
+
+        return (m_leader >= 0) ? PMU_RETVAL_OK : PMU_RETVAL_ERROR;
+#endif
+}
+
+int pmu_fini(void)
+{
+#ifndef _WIN32
+        unsigned i;
+
+        for (i = 0; i < m_num_open; i++)
+                close(m_fd[m_order[i]]);
+        m_num_open = 0;
+        m_leader = -1;
+#endif
+        return PMU_RETVAL_OK;
+}
+
+int pmu_available(const enum pmu_ctr ctr)
+{
+#ifndef _WIN32
+        unsigned i;
+
+        for (i = 0; i < m_num_open; i++)
+                if (m_order[i] == ctr)
+                        return 1;
+#else
+        (void) ctr;
+#endif
+        return 0;
+}
+
+int pmu_start(void)
+{
+#ifdef _WIN32
+        return PMU_RETVAL_ERROR;
+#else
+        if (m_leader < 0)
+                return PMU_RETVAL_ERROR;
+
+        if (ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) != 0)
+                return PMU_RETVAL_ERROR;
+        if (ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) != 0)
+                return PMU_RETVAL_ERROR;
+
+        return PMU_RETVAL_OK;
+#endif
+}
+
+int pmu_stop(uint64_t values[PMU_NUM_CTRS])
+{
+#ifdef _WIN32
+        (void) values;
+        return PMU_RETVAL_ERROR;
+#else
+        /* nr, time enabled, time running, values */
+        uint64_t buf[3 + PMU_NUM_CTRS];
+        unsigned i;
+
+        memset(values, 0, PMU_NUM_CTRS * sizeof(values[0]));
+        if (m_leader < 0)
+                return PMU_RETVAL_ERROR;
+
+        if (ioctl(m_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP) != 0)
+                return PMU_RETVAL_ERROR;
+        if (read(m_leader, buf, sizeof(buf)) <
+            (ssize_t) ((3 + m_num_open) * sizeof(uint64_t)))
+                return PMU_RETVAL_ERROR;
+
+        /* group was not scheduled at all */
+        if (buf[2] == 0)
+                return PMU_RETVAL_ERROR;
+
+        for (i = 0; i < m_num_open && i < buf[0]; i++) {
+                uint64_t val = buf[3 + i];
+
+                /* scale up if the group was multiplexed */
+                if (buf[2] < buf[1])
+                        val = (uint64_t) ((double) val * (double) buf[1] /
+                                          (double) buf[2]);
+                values[m_order[i]] = val;
+        }
+
+        return PMU_RETVAL_OK;
+#endif
+}
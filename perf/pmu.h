@@ -0,0 +1,111 @@
+/**********************************************************************
+  Copyright(c) 2020 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+/**
+ * @brief Provides access to hardware performance counters
+ *        through Linux perf_event_open() system call
+ */
+
+#ifndef __PMU_H__
+#define __PMU_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PMU_RETVAL_OK               0         /**< everything OK */
+#define PMU_RETVAL_ERROR            1         /**< generic error */
+
+/**
+ * @brief Counters collected by PMU module
+ */
+enum pmu_ctr {
+        PMU_CYCLES = 0,         /**< core cycles */
+        PMU_INSTRUCTIONS,       /**< retired instructions */
+        PMU_REF_CYCLES,         /**< reference (TSC rate) cycles */
+        PMU_L1D_MISSES,         /**< L1 data cache read misses */
+        PMU_LLC_MISSES,         /**< last level cache misses */
+        PMU_BRANCH_MISSES,      /**< mispredicted branches */
+        PMU_NUM_CTRS
+};
+
+/**
+ * @brief Opens counters for the calling thread (user space only,
+ *        so that no root privileges are needed)
+ *
+ * Counters not supported by the platform are left out.
+ *
+ * @return Operation status
+ * @retval PMU_RETVAL_OK if at least one counter was opened
+ */
+int pmu_init(void);
+
+/**
+ * @brief Closes all counters
+ *
+ * @return Operation status
+ * @retval PMU_RETVAL_OK on success
+ */
+int pmu_fini(void);
+
+/**
+ * @brief Checks if \a ctr counter is collected
+ *
+ * @param [in] ctr counter
+ *
+ * @return 1 if the counter is collected, 0 otherwise
+ */
+int pmu_available(const enum pmu_ctr ctr);
+
+/**
+ * @brief Resets and starts all counters
+ *
+ * @return Operation status
+ * @retval PMU_RETVAL_OK on success
+ */
+int pmu_start(void);
+
+/**
+ * @brief Stops all counters and reads their values, scaled up
+ *        if counters had to be multiplexed
+ *
+ * @param [out] values counter values (0 for counters not collected)
+ *
+ * @return Operation status
+ * @retval PMU_RETVAL_OK on success
+ */
+int pmu_stop(uint64_t values[PMU_NUM_CTRS]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PMU_H__ */
@@ -65,8 +65,8 @@ LFLAGS = /out:$(APP).exe $(DLFLAGS)
 
 all: $(APP).exe
 
-$(APP).exe: ipsec_perf.obj msr.obj $(IPSECLIB)
-        $(LNK) $(LFLAGS) ipsec_perf.obj msr.obj $(IPSECLIB)
+$(APP).exe: ipsec_perf.obj msr.obj pmu.obj $(IPSECLIB)
+        $(LNK) $(LFLAGS) ipsec_perf.obj msr.obj pmu.obj $(IPSECLIB)
 
 ipsec_perf.obj: ipsec_perf.c
         $(CC) /c $(CFLAGS) ipsec_perf.c
@@ -74,5 +74,8 @@ ipsec_perf.obj: ipsec_perf.c
 msr.obj: msr.c
         $(CC) /c $(CFLAGS) msr.c
 
+pmu.obj: pmu.c
+        $(CC) /c $(CFLAGS) pmu.c
+
 clean:
-	del /q ipsec_perf.obj msr.obj $(APP).exe $(APP).pdb $(APP).ilk
+	del /q ipsec_perf.obj msr.obj pmu.obj $(APP).exe $(APP).pdb $(APP).ilk
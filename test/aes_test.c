@@ -2266,6 +2266,119 @@ test_docrc_vectors(struct IMB_MGR *mb_mgr, const int vec_cnt,
 	return errors;
 }
 
+/*
+ * Frames of different lengths are encrypted together, so that lanes of
+ * the multi-buffer manager go through CRC and cipher stages at different
+ * times, then decrypted and compared with the original frames.
+ */
+#define DOCRC_MIXED_MAX_FRAME 1518
+
+static int
+test_docrc_mixed(struct IMB_MGR *mb_mgr)
+{
+        static const unsigned frame_lens[] = {
+                17, 18, 28, 29, 40, 64, 65, 79, 80, 127, 128, 130, 200,
+                511, 512, 1024, 1500, 1518
+        };
+        const unsigned num_jobs = DIM(frame_lens);
+        static uint8_t frames[DIM(frame_lens)][DOCRC_MIXED_MAX_FRAME];
+        static uint8_t ref[DIM(frame_lens)][DOCRC_MIXED_MAX_FRAME];
+        uint32_t enc_crc[DIM(frame_lens)], dec_crc[DIM(frame_lens)];
+        DECLARE_ALIGNED(uint32_t enc_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15*4], 16);
+        uint8_t key[32], iv[16];
+        unsigned key_len, i, j;
+        int errors = 0;
+
+        printf("AES-DOCSIS+CRC32 mixed frame lengths:\n");
+        for (i = 0; i < sizeof(key); i++)
+                key[i] = (uint8_t) rand();
+        for (i = 0; i < sizeof(iv); i++)
+                iv[i] = (uint8_t) rand();
+
+        for (key_len = 16; key_len <= 32; key_len += 16) {
+                struct IMB_JOB *job;
+
+                if (key_len == 16)
+                        IMB_AES_KEYEXP_128(mb_mgr, key, enc_keys, dec_keys);
+                else
+                        IMB_AES_KEYEXP_256(mb_mgr, key, enc_keys, dec_keys);
+
+                for (i = 0; i < num_jobs; i++) {
+                        for (j = 0; j < frame_lens[i]; j++)
+                                ref[i][j] = (uint8_t) rand();
+                        memcpy(frames[i], ref[i], frame_lens[i]);
+                }
+
+                while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                        ;
+
+                for (j = 0; j < 2; j++) {
+                        const JOB_CIPHER_DIRECTION dir =
+                                (j == 0) ? IMB_DIR_ENCRYPT : IMB_DIR_DECRYPT;
+                        uint32_t *crc = (j == 0) ? enc_crc : dec_crc;
+
+                        for (i = 0; i < num_jobs; i++) {
+                                job = IMB_GET_NEXT_JOB(mb_mgr);
+                                job->cipher_direction = dir;
+                                job->chain_order = (dir == IMB_DIR_ENCRYPT) ?
+                                        IMB_ORDER_HASH_CIPHER :
+                                        IMB_ORDER_CIPHER_HASH;
+                                job->src = frames[i];
+                                job->dst = frames[i] + 12;
+                                job->cipher_mode = IMB_CIPHER_DOCSIS_SEC_BPI;
+                                job->enc_keys = enc_keys;
+                                job->dec_keys = dec_keys;
+                                job->key_len_in_bytes = key_len;
+                                job->iv = iv;
+                                job->iv_len_in_bytes = 16;
+                                job->cipher_start_src_offset_in_bytes = 12;
+                                job->msg_len_to_cipher_in_bytes =
+                                        frame_lens[i] - 12;
+                                job->hash_alg = IMB_AUTH_DOCSIS_CRC32;
+                                job->hash_start_src_offset_in_bytes = 0;
+                                job->msg_len_to_hash_in_bytes =
+                                        frame_lens[i] - 4;
+                                job->auth_tag_output = (uint8_t *) &crc[i];
+                                job->auth_tag_output_len_in_bytes = 4;
+                                job = IMB_SUBMIT_JOB(mb_mgr);
+                                if (job != NULL &&
+                                    job->status != STS_COMPLETED) {
+                                        printf("job status error\n");
+                                        errors++;
+                                }
+                        }
+
+                        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                                if (job->status != STS_COMPLETED) {
+                                        printf("job status error\n");
+                                        errors++;
+                                }
+                }
+
+                for (i = 0; i < num_jobs; i++) {
+                        const unsigned hash_len = frame_lens[i] - 4;
+
+                        /* CRC is only computed for frames of 14+ bytes */
+                        if (hash_len >= 14 &&
+                            (enc_crc[i] != dec_crc[i] ||
+                             memcmp(&enc_crc[i], &frames[i][hash_len],
+                                    sizeof(enc_crc[i])))) {
+                                printf("AES-%u frame len %u CRC mismatch\n",
+                                       key_len * 8, frame_lens[i]);
+                                errors++;
+                        }
+                        if (memcmp(frames[i], ref[i], hash_len)) {
+                                printf("AES-%u frame len %u mismatch\n",
+                                       key_len * 8, frame_lens[i]);
+                                errors++;
+                        }
+                }
+        }
+        printf("\n");
+        return errors;
+}
+
 static int
 cfb128_validate_ok(const uint8_t *output, const uint8_t *in_text,
                    const size_t plen, const unsigned i, const unsigned is_enc,
@@ -2347,6 +2460,103 @@ cfb128_validate(struct IMB_MGR *mb_mgr)
         return 1;
 }
 
+/*
+ * Checks multiple key expansion against single key expansion
+ * for all key sizes and number of keys from 1 to MAX_KEYEXP_N
+ */
+#define MAX_KEYEXP_N 17
+
+static int
+test_aes_keyexp_n(struct IMB_MGR *mb_mgr)
+{
+        DECLARE_ALIGNED(uint32_t enc_keys[MAX_KEYEXP_N][15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[MAX_KEYEXP_N][15*4], 16);
+        DECLARE_ALIGNED(uint32_t ref_enc_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t ref_dec_keys[15*4], 16);
+        uint8_t keys[MAX_KEYEXP_N][32];
+        const void *key_ptrs[MAX_KEYEXP_N];
+        void *enc_ptrs[MAX_KEYEXP_N];
+        void *dec_ptrs[MAX_KEYEXP_N];
+        unsigned key_len, n, i, with_dec;
+        int errors = 0;
+
+        printf("AES key expansion of multiple keys:\n");
+        for (i = 0; i < MAX_KEYEXP_N; i++) {
+                unsigned j;
+
+                for (j = 0; j < sizeof(keys[i]); j++)
+                        keys[i][j] = (uint8_t) rand();
+                key_ptrs[i] = keys[i];
+                enc_ptrs[i] = enc_keys[i];
+                dec_ptrs[i] = dec_keys[i];
+        }
+
+        for (key_len = 16; key_len <= 32; key_len += 8) {
+                const size_t sched_len = (key_len / 4 + 7) * 16;
+
+                for (with_dec = 0; with_dec <= 1; with_dec++) {
+                        for (n = 1; n <= MAX_KEYEXP_N; n++) {
+                                void * const *dec = with_dec ? dec_ptrs : NULL;
+
+                                printf(".");
+                                memset(enc_keys, 0, sizeof(enc_keys));
+                                memset(dec_keys, 0, sizeof(dec_keys));
+
+                                if (key_len == 16)
+                                        IMB_AES_KEYEXP_128_N(mb_mgr, key_ptrs,
+                                                             enc_ptrs, dec, n);
+                                else if (key_len == 24)
+                                        IMB_AES_KEYEXP_192_N(mb_mgr, key_ptrs,
+                                                             enc_ptrs, dec, n);
+                                else
+                                        IMB_AES_KEYEXP_256_N(mb_mgr, key_ptrs,
+                                                             enc_ptrs, dec, n);
+
+                                for (i = 0; i < n; i++) {
+                                        if (key_len == 16)
+                                                IMB_AES_KEYEXP_128(mb_mgr,
+                                                                   keys[i],
+                                                                   ref_enc_keys,
+                                                                   ref_dec_keys);
+                                        else if (key_len == 24)
+                                                IMB_AES_KEYEXP_192(mb_mgr,
+                                                                   keys[i],
+                                                                   ref_enc_keys,
+                                                                   ref_dec_keys);
+                                        else
+                                                IMB_AES_KEYEXP_256(mb_mgr,
+                                                                   keys[i],
+                                                                   ref_enc_keys,
+                                                                   ref_dec_keys);
+
+                                        if (memcmp(enc_keys[i], ref_enc_keys,
+                                                   sched_len) ||
+                                            (with_dec &&
+                                             memcmp(dec_keys[i], ref_dec_keys,
+                                                    sched_len))) {
+                                                printf("AES-%u keyexp N=%u "
+                                                       "key #%u mismatch\n",
+                                                       key_len * 8, n, i);
+                                                errors++;
+                                        }
+                                }
+                                /* keys past N must be untouched */
+                                for (i = n; i < MAX_KEYEXP_N; i++)
+                                        if (enc_keys[i][0] != 0 ||
+                                            dec_keys[i][0] != 0) {
+                                                printf("AES-%u keyexp N=%u "
+                                                       "overwrite\n",
+                                                       key_len * 8, n);
+                                                errors++;
+                                                break;
+                                        }
+                        }
+                }
+        }
+        printf("\n");
+        return errors;
+}
+
 int
 aes_test(struct IMB_MGR *mb_mgr)
 {
@@ -2378,6 +2588,9 @@ aes_test(struct IMB_MGR *mb_mgr)
                                            docsis_crc_tab,
                                            "AES-DOCSIS+CRC32 vectors",
                                            num_jobs_tab[i]);
+        errors += test_docrc_mixed(mb_mgr);
+
+        errors += test_aes_keyexp_n(mb_mgr);
 
 	if (0 == errors)
 		printf("...Pass\n");
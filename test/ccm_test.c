@@ -2535,6 +2535,204 @@ test_ccm_256_std_vectors(struct IMB_MGR *mb_mgr, const int num_jobs)
 	return errors;
 }
 
+/* Finds the vector a job was built from by its nonce */
+static const struct ccm_rfc3610_vector *
+ccm_job_vec(const struct IMB_JOB *job,
+            const struct ccm_rfc3610_vector *vecs, const int num_vecs)
+{
+        int i;
+
+        for (i = 0; i < num_vecs; i++)
+                if (job->iv == vecs[i].nonce)
+                        return &vecs[i];
+        return &vecs[0];
+}
+
+/*
+ * Submits jobs cycling through all vectors of \a vecs, so that lanes
+ * carry different keys, nonces, AAD and message lengths at the same time
+ */
+static int
+test_ccm_mixed(struct IMB_MGR *mb_mgr,
+               const struct ccm_rfc3610_vector *vecs, const int num_vecs,
+               const int dir, const int in_place, const int num_jobs,
+               const uint64_t key_length)
+{
+        DECLARE_ALIGNED(uint32_t dust[4*15], 16);
+        struct IMB_JOB *job;
+        uint8_t padding[16];
+        uint32_t *expkeys = malloc(num_vecs * sizeof(dust));
+        uint8_t **targets = malloc(num_jobs * sizeof(void *));
+        uint8_t **auths = malloc(num_jobs * sizeof(void *));
+        int i = 0, jobs_rx = 0, ret = -1;
+        const int order = (dir == IMB_DIR_ENCRYPT) ?
+                           IMB_ORDER_HASH_CIPHER : IMB_ORDER_CIPHER_HASH;
+
+        if (expkeys == NULL || targets == NULL || auths == NULL) {
+                fprintf(stderr, "Can't allocate buffer memory\n");
+                goto end2;
+        }
+
+        memset(padding, -1, sizeof(padding));
+        memset(targets, 0, num_jobs * sizeof(void *));
+        memset(auths, 0, num_jobs * sizeof(void *));
+
+        for (i = 0; i < num_vecs; i++) {
+                uint32_t *expkey = &expkeys[i * DIM(dust)];
+
+                if (key_length == 16)
+                        IMB_AES_KEYEXP_128(mb_mgr, vecs[i].keys, expkey,
+                                           dust);
+                else
+                        IMB_AES_KEYEXP_256(mb_mgr, vecs[i].keys, expkey,
+                                           dust);
+        }
+
+        for (i = 0; i < num_jobs; i++) {
+                const struct ccm_rfc3610_vector *vec = &vecs[i % num_vecs];
+
+                targets[i] = malloc(vec->packet_len + (sizeof(padding) * 2));
+                auths[i] = malloc(16 + (sizeof(padding) * 2));
+                if (targets[i] == NULL || auths[i] == NULL) {
+                        fprintf(stderr, "Can't allocate buffer memory\n");
+                        goto end;
+                }
+
+                memset(targets[i], -1, vec->packet_len + (sizeof(padding) * 2));
+                memset(auths[i], -1, 16 + (sizeof(padding) * 2));
+
+                if (in_place)
+                        memcpy(targets[i] + sizeof(padding),
+                               (dir == IMB_DIR_ENCRYPT) ?
+                               vec->packet_in : vec->packet_out,
+                               vec->packet_len);
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < num_jobs; i++) {
+                const struct ccm_rfc3610_vector *vec = &vecs[i % num_vecs];
+
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                job->cipher_direction = dir;
+                job->chain_order = order;
+                job->dst = targets[i] + sizeof(padding);
+                if (in_place) {
+                        job->dst += vec->clear_len;
+                        job->src = targets[i] + sizeof(padding);
+                } else {
+                        job->src = (dir == IMB_DIR_ENCRYPT) ?
+                                vec->packet_in : vec->packet_out;
+                }
+                job->cipher_mode = IMB_CIPHER_CCM;
+                job->enc_keys = &expkeys[(i % num_vecs) * DIM(dust)];
+                job->dec_keys = job->enc_keys;
+                job->key_len_in_bytes = key_length;
+                job->iv = vec->nonce;
+                job->iv_len_in_bytes = vec->nonce_len;
+                job->cipher_start_src_offset_in_bytes = vec->clear_len;
+                job->msg_len_to_cipher_in_bytes =
+                        vec->packet_len - vec->clear_len;
+
+                job->hash_alg = IMB_AUTH_AES_CCM;
+                job->hash_start_src_offset_in_bytes = vec->clear_len;
+                job->msg_len_to_hash_in_bytes =
+                        vec->packet_len - vec->clear_len;
+                job->auth_tag_output = auths[i] + sizeof(padding);
+                job->auth_tag_output_len_in_bytes = vec->auth_len;
+
+                job->u.CCM.aad_len_in_bytes = vec->clear_len;
+                job->u.CCM.aad = job->src;
+
+                job->user_data = targets[i];
+                job->user_data2 = auths[i];
+
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                while (job != NULL) {
+                        jobs_rx++;
+                        if (!ccm_job_ok(ccm_job_vec(job, vecs, num_vecs),
+                                        job, job->user_data, padding,
+                                        job->user_data2, sizeof(padding),
+                                        dir, in_place))
+                                goto end;
+                        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                jobs_rx++;
+                if (!ccm_job_ok(ccm_job_vec(job, vecs, num_vecs), job,
+                                job->user_data, padding, job->user_data2,
+                                sizeof(padding), dir, in_place))
+                        goto end;
+        }
+
+        if (jobs_rx != num_jobs) {
+                printf("Expected %d jobs, received %d\n", num_jobs, jobs_rx);
+                goto end;
+        }
+        ret = 0;
+
+ end:
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < num_jobs; i++) {
+                if (targets[i] != NULL)
+                        free(targets[i]);
+                if (auths[i] != NULL)
+                        free(auths[i]);
+        }
+
+ end2:
+        if (expkeys != NULL)
+                free(expkeys);
+        if (targets != NULL)
+                free(targets);
+        if (auths != NULL)
+                free(auths);
+
+        return ret;
+}
+
+static int
+test_ccm_mixed_vectors(struct IMB_MGR *mb_mgr, const int num_jobs)
+{
+        int errors = 0;
+        int in_place;
+
+        printf("AES-CCM mixed test vectors (N jobs = %d):\n", num_jobs);
+        for (in_place = 0; in_place <= 1; in_place++) {
+                if (test_ccm_mixed(mb_mgr, ccm_vectors, DIM(ccm_vectors),
+                                   IMB_DIR_ENCRYPT, in_place, num_jobs, 16)) {
+                        printf("error AES-CCM-128 encrypt, in-place %d\n",
+                               in_place);
+                        errors++;
+                }
+                if (test_ccm_mixed(mb_mgr, ccm_vectors, DIM(ccm_vectors),
+                                   IMB_DIR_DECRYPT, in_place, num_jobs, 16)) {
+                        printf("error AES-CCM-128 decrypt, in-place %d\n",
+                               in_place);
+                        errors++;
+                }
+                if (test_ccm_mixed(mb_mgr, ccm_256_vectors,
+                                   DIM(ccm_256_vectors), IMB_DIR_ENCRYPT,
+                                   in_place, num_jobs, 32)) {
+                        printf("error AES-CCM-256 encrypt, in-place %d\n",
+                               in_place);
+                        errors++;
+                }
+                if (test_ccm_mixed(mb_mgr, ccm_256_vectors,
+                                   DIM(ccm_256_vectors), IMB_DIR_DECRYPT,
+                                   in_place, num_jobs, 32)) {
+                        printf("error AES-CCM-256 decrypt, in-place %d\n",
+                               in_place);
+                        errors++;
+                }
+        }
+        return errors;
+}
 
 int
 ccm_test(struct IMB_MGR *mb_mgr)
@@ -2573,6 +2771,10 @@ ccm_test(struct IMB_MGR *mb_mgr)
         errors += test_ccm_256_std_vectors(mb_mgr, 18);
         errors += test_ccm_256_std_vectors(mb_mgr, 19);
 
+        /* Different vectors in flight at the same time */
+        errors += test_ccm_mixed_vectors(mb_mgr, 7);
+        errors += test_ccm_mixed_vectors(mb_mgr, 64);
+
 	if (0 == errors)
 		printf("...Pass\n");
 	else
@@ -0,0 +1,604 @@
+/*****************************************************************************
+ Copyright (c) 2020, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "utils.h"
+
+int cfb_test(struct IMB_MGR *mb_mgr);
+
+struct cfb_vector {
+	const uint8_t *K;          /* key */
+	const uint8_t *IV;         /* initialization vector */
+	const uint8_t *P;          /* plain text */
+	const uint8_t *C;          /* cipher text - same length as plain text */
+	uint64_t       Klen;       /* key length */
+	uint64_t       Plen;       /* text length */
+};
+
+/*
+ * NIST SP800-38A F.3.13 CFB128-AES128.Encrypt
+ */
+static const uint8_t K1[] = {
+        0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+        0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+static const uint8_t IV1[] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+static const uint8_t P1[] = {
+        0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+        0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+        0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11,
+        0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17,
+        0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+};
+static const uint8_t C1[] = {
+        0x3b, 0x3f, 0xd9, 0x2e, 0xb7, 0x2d, 0xad, 0x20,
+        0x33, 0x34, 0x49, 0xf8, 0xe8, 0x3c, 0xfb, 0x4a,
+        0xc8, 0xa6, 0x45, 0x37, 0xa0, 0xb3, 0xa9, 0x3f,
+        0xcd, 0xe3, 0xcd, 0xad, 0x9f, 0x1c, 0xe5, 0x8b,
+        0x26, 0x75, 0x1f, 0x67, 0xa3, 0xcb, 0xb1, 0x40,
+        0xb1, 0x80, 0x8c, 0xf1, 0x87, 0xa4, 0xf4, 0xdf,
+        0xc0, 0x4b, 0x05, 0x35, 0x7c, 0x5d, 0x1c, 0x0e,
+        0xea, 0xc4, 0xc6, 0x6f, 0x9f, 0xf7, 0xf2, 0xe6
+};
+
+/*
+ * NIST SP800-38A F.3.17 CFB128-AES256.Encrypt
+ */
+static const uint8_t K2[] = {
+        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+        0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+        0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+};
+static const uint8_t C2[] = {
+        0xdc, 0x7e, 0x84, 0xbf, 0xda, 0x79, 0x16, 0x4b,
+        0x7e, 0xcd, 0x84, 0x86, 0x98, 0x5d, 0x38, 0x60,
+        0x39, 0xff, 0xed, 0x14, 0x3b, 0x28, 0xb1, 0xc8,
+        0x32, 0x11, 0x3c, 0x63, 0x31, 0xe5, 0x40, 0x7b,
+        0xdf, 0x10, 0x13, 0x24, 0x15, 0xe5, 0x4b, 0x92,
+        0xa1, 0x3e, 0xd0, 0xa8, 0x26, 0x7a, 0xe2, 0xf9,
+        0x75, 0xa3, 0x85, 0x74, 0x1a, 0xb9, 0xce, 0xf8,
+        0x20, 0x31, 0x62, 0x3d, 0x55, 0xb1, 0xe4, 0x71
+};
+
+/*
+ * Long messages (18 complete blocks and a partial one) to exercise
+ * by8 and by16 decryption. Plain text is (i * 7 + 3) & 0xff.
+ */
+static const uint8_t IV3[] = {
+        0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+        0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+};
+static const uint8_t P3[] = {
+        0x03, 0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34,
+        0x3b, 0x42, 0x49, 0x50, 0x57, 0x5e, 0x65, 0x6c,
+        0x73, 0x7a, 0x81, 0x88, 0x8f, 0x96, 0x9d, 0xa4,
+        0xab, 0xb2, 0xb9, 0xc0, 0xc7, 0xce, 0xd5, 0xdc,
+        0xe3, 0xea, 0xf1, 0xf8, 0xff, 0x06, 0x0d, 0x14,
+        0x1b, 0x22, 0x29, 0x30, 0x37, 0x3e, 0x45, 0x4c,
+        0x53, 0x5a, 0x61, 0x68, 0x6f, 0x76, 0x7d, 0x84,
+        0x8b, 0x92, 0x99, 0xa0, 0xa7, 0xae, 0xb5, 0xbc,
+        0xc3, 0xca, 0xd1, 0xd8, 0xdf, 0xe6, 0xed, 0xf4,
+        0xfb, 0x02, 0x09, 0x10, 0x17, 0x1e, 0x25, 0x2c,
+        0x33, 0x3a, 0x41, 0x48, 0x4f, 0x56, 0x5d, 0x64,
+        0x6b, 0x72, 0x79, 0x80, 0x87, 0x8e, 0x95, 0x9c,
+        0xa3, 0xaa, 0xb1, 0xb8, 0xbf, 0xc6, 0xcd, 0xd4,
+        0xdb, 0xe2, 0xe9, 0xf0, 0xf7, 0xfe, 0x05, 0x0c,
+        0x13, 0x1a, 0x21, 0x28, 0x2f, 0x36, 0x3d, 0x44,
+        0x4b, 0x52, 0x59, 0x60, 0x67, 0x6e, 0x75, 0x7c,
+        0x83, 0x8a, 0x91, 0x98, 0x9f, 0xa6, 0xad, 0xb4,
+        0xbb, 0xc2, 0xc9, 0xd0, 0xd7, 0xde, 0xe5, 0xec,
+        0xf3, 0xfa, 0x01, 0x08, 0x0f, 0x16, 0x1d, 0x24,
+        0x2b, 0x32, 0x39, 0x40, 0x47, 0x4e, 0x55, 0x5c,
+        0x63, 0x6a, 0x71, 0x78, 0x7f, 0x86, 0x8d, 0x94,
+        0x9b, 0xa2, 0xa9, 0xb0, 0xb7, 0xbe, 0xc5, 0xcc,
+        0xd3, 0xda, 0xe1, 0xe8, 0xef, 0xf6, 0xfd, 0x04,
+        0x0b, 0x12, 0x19, 0x20, 0x27, 0x2e, 0x35, 0x3c,
+        0x43, 0x4a, 0x51, 0x58, 0x5f, 0x66, 0x6d, 0x74,
+        0x7b, 0x82, 0x89, 0x90, 0x97, 0x9e, 0xa5, 0xac,
+        0xb3, 0xba, 0xc1, 0xc8, 0xcf, 0xd6, 0xdd, 0xe4,
+        0xeb, 0xf2, 0xf9, 0x00, 0x07, 0x0e, 0x15, 0x1c,
+        0x23, 0x2a, 0x31, 0x38, 0x3f, 0x46, 0x4d, 0x54,
+        0x5b, 0x62, 0x69, 0x70, 0x77, 0x7e, 0x85, 0x8c,
+        0x93, 0x9a, 0xa1, 0xa8, 0xaf, 0xb6, 0xbd, 0xc4,
+        0xcb, 0xd2, 0xd9, 0xe0, 0xe7, 0xee, 0xf5, 0xfc,
+        0x03, 0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34,
+        0x3b, 0x42, 0x49, 0x50, 0x57, 0x5e, 0x65, 0x6c,
+        0x73, 0x7a, 0x81, 0x88, 0x8f, 0x96, 0x9d, 0xa4,
+        0xab, 0xb2, 0xb9, 0xc0, 0xc7, 0xce, 0xd5, 0xdc,
+        0xe3, 0xea, 0xf1, 0xf8, 0xff, 0x06, 0x0d, 0x14,
+        0x1b, 0x22, 0x29, 0x30,
+};
+static const uint8_t C3[] = {
+        0xef, 0x86, 0xce, 0x6b, 0x87, 0x46, 0x51, 0x84,
+        0xc9, 0x90, 0x5f, 0x25, 0xbd, 0xc0, 0xc4, 0x88,
+        0xc5, 0xa7, 0x2e, 0xa6, 0xf0, 0xde, 0xf5, 0x60,
+        0xf2, 0xab, 0x2c, 0xac, 0x55, 0x0f, 0x7f, 0xd5,
+        0x2a, 0xb2, 0x7c, 0x4e, 0x9c, 0x2a, 0xa6, 0x70,
+        0x1b, 0x1d, 0xec, 0x81, 0xe4, 0x07, 0x9a, 0xe0,
+        0x18, 0xa8, 0xa8, 0x2c, 0x08, 0x63, 0x71, 0xb6,
+        0xa7, 0xc0, 0xa7, 0x82, 0x93, 0x99, 0xef, 0x0b,
+        0x42, 0xf7, 0x3f, 0xca, 0xee, 0x40, 0xb4, 0x6b,
+        0xbe, 0x51, 0xa7, 0x19, 0x4a, 0x4d, 0x22, 0xa1,
+        0xa6, 0x75, 0x5c, 0x4f, 0x19, 0x06, 0x38, 0xe5,
+        0xfb, 0xc1, 0xe7, 0xbc, 0xce, 0x79, 0xf5, 0x29,
+        0xde, 0x2a, 0x73, 0x59, 0xd4, 0x99, 0xaa, 0xfb,
+        0x37, 0x1b, 0xe5, 0x89, 0xc2, 0xdf, 0xb5, 0x4e,
+        0x3d, 0x8b, 0x42, 0x41, 0xf9, 0xa3, 0x1b, 0xf7,
+        0x57, 0x6b, 0xb5, 0x87, 0xe9, 0x2f, 0xf9, 0xa4,
+        0x00, 0x9e, 0x16, 0xee, 0xd5, 0xe6, 0x3c, 0x93,
+        0x66, 0x7d, 0x5a, 0xed, 0x65, 0xac, 0x64, 0xd7,
+        0x1a, 0x93, 0xda, 0xf2, 0xc1, 0x74, 0xc9, 0x7f,
+        0xb5, 0x21, 0x12, 0xf8, 0x39, 0x4d, 0x8e, 0x5d,
+        0x84, 0x40, 0xc5, 0x91, 0xfa, 0xc1, 0x49, 0x05,
+        0x28, 0xa5, 0xf3, 0x4c, 0x24, 0x76, 0x8a, 0x21,
+        0x80, 0x6e, 0x50, 0xe0, 0xa5, 0x7c, 0x43, 0xd3,
+        0xe5, 0xf5, 0x22, 0xc6, 0xde, 0xbc, 0x0c, 0x4d,
+        0xee, 0xd8, 0xb2, 0x6d, 0x53, 0xf2, 0x6c, 0x22,
+        0xe6, 0x51, 0xdd, 0x14, 0xcb, 0x40, 0xe0, 0x27,
+        0xae, 0x99, 0x81, 0x5f, 0xcc, 0x57, 0xcd, 0x78,
+        0x3f, 0xfe, 0x77, 0x54, 0x6e, 0x95, 0x5f, 0xb6,
+        0xdd, 0x89, 0xc6, 0xd2, 0x44, 0xff, 0x18, 0x19,
+        0x45, 0xbe, 0xda, 0xaf, 0x6b, 0xb2, 0xaf, 0x37,
+        0xbd, 0x83, 0x75, 0xda, 0xd1, 0x5a, 0x0f, 0x4f,
+        0x7f, 0xa5, 0xad, 0x3e, 0xb4, 0x5f, 0xa5, 0x4c,
+        0x29, 0xdc, 0x9e, 0x1a, 0x91, 0xe3, 0x4e, 0x34,
+        0x49, 0x91, 0x25, 0x18, 0x48, 0x0a, 0x11, 0x42,
+        0xfd, 0xcc, 0x55, 0x2a, 0x3d, 0xaa, 0xbd, 0x0a,
+        0x2f, 0x9d, 0x11, 0x28, 0x6e, 0x24, 0xa5, 0xb8,
+        0x6c, 0x81, 0x6b, 0x94, 0x0e, 0x50, 0x83, 0x61,
+        0x60, 0x2d, 0xa8, 0x1d,
+};
+static const uint8_t C4[] = {
+        0x08, 0xd5, 0x6c, 0xe9, 0x46, 0x31, 0x3b, 0x07,
+        0x65, 0xd8, 0xc2, 0x45, 0x9f, 0x3e, 0xa0, 0x6e,
+        0x75, 0xb9, 0x55, 0x16, 0x0f, 0x51, 0xb0, 0xcc,
+        0xac, 0x0d, 0xd7, 0xbc, 0x93, 0x98, 0xae, 0xd0,
+        0x85, 0x07, 0xbc, 0x43, 0x73, 0xa8, 0xb8, 0xdd,
+        0xd1, 0xbb, 0x99, 0x2a, 0x59, 0xc7, 0xa7, 0x24,
+        0x2c, 0x33, 0xf9, 0xac, 0xd6, 0xfc, 0xcd, 0x47,
+        0xba, 0x7a, 0xfa, 0x2f, 0xc6, 0xa3, 0xd8, 0x90,
+        0xd7, 0xf4, 0x27, 0x59, 0x78, 0xdb, 0xd7, 0x89,
+        0x77, 0x24, 0x75, 0xe7, 0xed, 0x56, 0x5e, 0x01,
+        0x01, 0x77, 0x3c, 0x5d, 0xf3, 0x43, 0x57, 0x1d,
+        0x0a, 0x4b, 0xb0, 0x09, 0xed, 0x0f, 0xd0, 0x51,
+        0xe1, 0xa0, 0x18, 0x41, 0x75, 0x04, 0xd3, 0x7b,
+        0x3e, 0x24, 0xeb, 0x89, 0x59, 0xf0, 0x20, 0x8d,
+        0x6d, 0xfb, 0x0a, 0x9c, 0xb3, 0xf4, 0xf3, 0x3e,
+        0x9d, 0xf1, 0xbf, 0xb9, 0xba, 0xa0, 0xb3, 0x5e,
+        0xf1, 0x24, 0xef, 0x8b, 0x51, 0x46, 0xbe, 0x8d,
+        0xf3, 0xd8, 0x9f, 0x74, 0x50, 0xda, 0xda, 0x2b,
+        0x8c, 0x5f, 0xd5, 0x3b, 0x5c, 0xb3, 0x1c, 0xfb,
+        0x1d, 0x25, 0xea, 0xeb, 0x43, 0x8e, 0x44, 0x28,
+        0x7e, 0xab, 0xb7, 0x8f, 0x55, 0x56, 0x98, 0x80,
+        0x7c, 0xcd, 0x5a, 0x9c, 0xa2, 0xc1, 0x0d, 0x15,
+        0xec, 0x55, 0x06, 0xbb, 0x58, 0x9c, 0x1a, 0x9a,
+        0x31, 0x1e, 0x0d, 0x0e, 0x20, 0x39, 0xe5, 0x4c,
+        0xf9, 0xe0, 0xf3, 0x4f, 0x69, 0x61, 0x88, 0x6c,
+        0xd1, 0x22, 0xf6, 0xda, 0x96, 0x4f, 0xa0, 0xad,
+        0xb3, 0xb7, 0x00, 0xf1, 0x6a, 0xc0, 0xc0, 0xce,
+        0x69, 0x08, 0x9b, 0x9a, 0x1a, 0x64, 0x64, 0x6b,
+        0x39, 0xdc, 0xa1, 0x11, 0xb9, 0x48, 0x38, 0xb6,
+        0xb6, 0x30, 0x5f, 0x47, 0x79, 0xc6, 0xee, 0x64,
+        0x76, 0xfb, 0xfd, 0x21, 0x0b, 0xc2, 0x15, 0x7b,
+        0x05, 0xc9, 0x19, 0x1f, 0xfa, 0x9d, 0xb1, 0x22,
+        0xe9, 0xd8, 0xfc, 0xa3, 0xd0, 0x98, 0xd2, 0xd0,
+        0x63, 0xd6, 0xac, 0x78, 0x4e, 0x42, 0xdc, 0xf7,
+        0x0e, 0x8a, 0x93, 0x53, 0xeb, 0x2c, 0x6a, 0xac,
+        0xc1, 0x0b, 0x6f, 0x1d, 0x3e, 0x0e, 0x64, 0x0c,
+        0x76, 0xc1, 0x5e, 0x5d, 0x4f, 0xef, 0x84, 0xf3,
+        0x67, 0xab, 0xcb, 0x85,
+};
+
+static const struct cfb_vector cfb_vectors[] = {
+        {K1, IV1, P1, C1, sizeof(K1), sizeof(P1)},
+        {K2, IV1, P1, C2, sizeof(K2), sizeof(P1)},
+        {K1, IV3, P3, C3, sizeof(K1), sizeof(P3)},
+        {K2, IV3, P3, C4, sizeof(K2), sizeof(P3)},
+};
+
+static int
+cfb_job_ok(const struct IMB_JOB *job,
+           const uint8_t *out_text,
+           const uint8_t *target,
+           const uint8_t *padding,
+           const size_t sizeof_padding,
+           const unsigned text_len)
+{
+        const int num = (const int)((uint64_t)job->user_data2);
+
+        if (job->status != STS_COMPLETED) {
+                printf("%d error status:%d, job %d",
+                       __LINE__, job->status, num);
+                return 0;
+        }
+        if (memcmp(out_text, target + sizeof_padding,
+                   text_len)) {
+                printf("%d mismatched\n", num);
+                return 0;
+        }
+        if (memcmp(padding, target, sizeof_padding)) {
+                printf("%d overwrite head\n", num);
+                return 0;
+        }
+        if (memcmp(padding,
+                   target + sizeof_padding + text_len,
+                   sizeof_padding)) {
+                printf("%d overwrite tail\n", num);
+                return 0;
+        }
+        return 1;
+}
+
+static int
+test_cfb_many(struct IMB_MGR *mb_mgr,
+              void *enc_keys,
+              const void *iv,
+              const uint8_t *in_text,
+              const uint8_t *out_text,
+              unsigned text_len,
+              int dir,
+              int order,
+              const int in_place,
+              const int key_len,
+              const int num_jobs)
+{
+        struct IMB_JOB *job;
+        uint8_t padding[16];
+        uint8_t **targets = malloc(num_jobs * sizeof(void *));
+        int i, jobs_rx = 0, ret = -1;
+
+        assert(targets != NULL);
+
+        memset(padding, -1, sizeof(padding));
+
+        for (i = 0; i < num_jobs; i++) {
+                targets[i] = malloc(text_len + (sizeof(padding) * 2));
+                memset(targets[i], -1, text_len + (sizeof(padding) * 2));
+                if (in_place) {
+                        /* copy input text to the allocated buffer */
+                        memcpy(targets[i] + sizeof(padding), in_text, text_len);
+                }
+        }
+
+        /* flush the scheduler */
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < num_jobs; i++) {
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                job->cipher_direction = dir;
+                job->chain_order = order;
+                job->dst = targets[i] + sizeof(padding);
+                if (!in_place)
+                        job->src = in_text;
+                else
+                        job->src = targets[i] + sizeof(padding);
+                job->cipher_mode = IMB_CIPHER_CFB;
+                job->enc_keys = enc_keys;
+                job->dec_keys = NULL;
+                job->key_len_in_bytes = key_len;
+
+                job->iv = iv;
+                job->iv_len_in_bytes = 16;
+                job->cipher_start_src_offset_in_bytes = 0;
+                job->msg_len_to_cipher_in_bytes = text_len;
+                job->user_data = targets[i];
+                job->user_data2 = (void *)((uint64_t)i);
+
+                job->hash_alg = IMB_AUTH_NULL;
+
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                if (job != NULL) {
+                        jobs_rx++;
+                        if (!cfb_job_ok(job, out_text, job->user_data, padding,
+                                        sizeof(padding), text_len))
+                                goto end;
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                jobs_rx++;
+                if (!cfb_job_ok(job, out_text, job->user_data, padding,
+                                sizeof(padding), text_len))
+                        goto end;
+        }
+
+        if (jobs_rx != num_jobs) {
+                printf("Expected %d jobs, received %d\n", num_jobs, jobs_rx);
+                goto end;
+        }
+        ret = 0;
+
+ end:
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < num_jobs; i++)
+                free(targets[i]);
+        free(targets);
+        return ret;
+}
+
+static int
+test_cfb_vectors(struct IMB_MGR *mb_mgr, const int vec_cnt,
+                 const struct cfb_vector *vec_tab, const char *banner,
+                 const int num_jobs)
+{
+	int vect, errors = 0;
+        DECLARE_ALIGNED(uint32_t enc_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15*4], 16);
+
+	printf("%s (N jobs = %d):\n", banner, num_jobs);
+	for (vect = 0; vect < vec_cnt; vect++) {
+                unsigned len;
+
+#ifdef DEBUG
+		printf("[%d/%d] Standard vector key_len:%d\n",
+                       vect + 1, vec_cnt,
+                       (int) vec_tab[vect].Klen);
+#else
+		printf(".");
+#endif
+                if (vec_tab[vect].Klen == 16)
+                        IMB_AES_KEYEXP_128(mb_mgr, vec_tab[vect].K, enc_keys,
+                                           dec_keys);
+                else
+                        IMB_AES_KEYEXP_256(mb_mgr, vec_tab[vect].K, enc_keys,
+                                           dec_keys);
+
+                /*
+                 * CFB doesn't need padding, so any prefix of the vector
+                 * is a valid vector too
+                 */
+                for (len = 1; len <= vec_tab[vect].Plen; len++) {
+                        if (len > 64 && len != vec_tab[vect].Plen &&
+                            (len % 16) != 0 && (len % 16) != 1)
+                                continue;
+
+                        if (test_cfb_many(mb_mgr, enc_keys, vec_tab[vect].IV,
+                                          vec_tab[vect].P, vec_tab[vect].C,
+                                          len, IMB_DIR_ENCRYPT,
+                                          IMB_ORDER_CIPHER_HASH, 0,
+                                          (int) vec_tab[vect].Klen,
+                                          num_jobs)) {
+                                printf("error #%d encrypt, len %u\n",
+                                       vect + 1, len);
+                                errors++;
+                        }
+
+                        if (test_cfb_many(mb_mgr, enc_keys, vec_tab[vect].IV,
+                                          vec_tab[vect].C, vec_tab[vect].P,
+                                          len, IMB_DIR_DECRYPT,
+                                          IMB_ORDER_HASH_CIPHER, 0,
+                                          (int) vec_tab[vect].Klen,
+                                          num_jobs)) {
+                                printf("error #%d decrypt, len %u\n",
+                                       vect + 1, len);
+                                errors++;
+                        }
+
+                        if (test_cfb_many(mb_mgr, enc_keys, vec_tab[vect].IV,
+                                          vec_tab[vect].P, vec_tab[vect].C,
+                                          len, IMB_DIR_ENCRYPT,
+                                          IMB_ORDER_CIPHER_HASH, 1,
+                                          (int) vec_tab[vect].Klen,
+                                          num_jobs)) {
+                                printf("error #%d encrypt in-place, len %u\n",
+                                       vect + 1, len);
+                                errors++;
+                        }
+
+                        if (test_cfb_many(mb_mgr, enc_keys, vec_tab[vect].IV,
+                                          vec_tab[vect].C, vec_tab[vect].P,
+                                          len, IMB_DIR_DECRYPT,
+                                          IMB_ORDER_HASH_CIPHER, 1,
+                                          (int) vec_tab[vect].Klen,
+                                          num_jobs)) {
+                                printf("error #%d decrypt in-place, len %u\n",
+                                       vect + 1, len);
+                                errors++;
+                        }
+                }
+	}
+	printf("\n");
+	return errors;
+}
+
+/*
+ * Jobs of different vectors (keys) and lengths in flight at the same time,
+ * so that lanes of the multi-buffer manager complete in different order
+ */
+static int
+test_cfb_mixed(struct IMB_MGR *mb_mgr, const int dir, const int in_place,
+               const int num_jobs)
+{
+        DECLARE_ALIGNED(uint32_t enc_keys[DIM(cfb_vectors)][15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15*4], 16);
+        struct IMB_JOB *job;
+        uint8_t padding[16];
+        uint8_t **targets = malloc(num_jobs * sizeof(void *));
+        unsigned *lens = malloc(num_jobs * sizeof(unsigned));
+        int i, jobs_rx = 0, ret = -1;
+
+        assert(targets != NULL);
+        assert(lens != NULL);
+
+        memset(padding, -1, sizeof(padding));
+
+        for (i = 0; i < (int) DIM(cfb_vectors); i++)
+                if (cfb_vectors[i].Klen == 16)
+                        IMB_AES_KEYEXP_128(mb_mgr, cfb_vectors[i].K,
+                                           enc_keys[i], dec_keys);
+                else
+                        IMB_AES_KEYEXP_256(mb_mgr, cfb_vectors[i].K,
+                                           enc_keys[i], dec_keys);
+
+        for (i = 0; i < num_jobs; i++) {
+                const struct cfb_vector *v =
+                        &cfb_vectors[i % DIM(cfb_vectors)];
+                const uint8_t *in_text =
+                        (dir == IMB_DIR_ENCRYPT) ? v->P : v->C;
+
+                lens[i] = (unsigned) (v->Plen - ((i * 23) % v->Plen));
+                targets[i] = malloc(lens[i] + (sizeof(padding) * 2));
+                assert(targets[i] != NULL);
+                memset(targets[i], -1, lens[i] + (sizeof(padding) * 2));
+                if (in_place)
+                        memcpy(targets[i] + sizeof(padding), in_text, lens[i]);
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < num_jobs; i++) {
+                const struct cfb_vector *v =
+                        &cfb_vectors[i % DIM(cfb_vectors)];
+
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                job->cipher_direction = dir;
+                job->chain_order = (dir == IMB_DIR_ENCRYPT) ?
+                        IMB_ORDER_CIPHER_HASH : IMB_ORDER_HASH_CIPHER;
+                job->dst = targets[i] + sizeof(padding);
+                if (in_place)
+                        job->src = targets[i] + sizeof(padding);
+                else
+                        job->src = (dir == IMB_DIR_ENCRYPT) ? v->P : v->C;
+                job->cipher_mode = IMB_CIPHER_CFB;
+                job->enc_keys = enc_keys[i % DIM(cfb_vectors)];
+                job->dec_keys = NULL;
+                job->key_len_in_bytes = v->Klen;
+                job->iv = v->IV;
+                job->iv_len_in_bytes = 16;
+                job->cipher_start_src_offset_in_bytes = 0;
+                job->msg_len_to_cipher_in_bytes = lens[i];
+                job->user_data = targets[i];
+                job->user_data2 = (void *)((uint64_t)i);
+                job->hash_alg = IMB_AUTH_NULL;
+
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                while (job != NULL) {
+                        const int n = (int)((uint64_t)job->user_data2);
+                        const struct cfb_vector *jv =
+                                &cfb_vectors[n % DIM(cfb_vectors)];
+
+                        jobs_rx++;
+                        if (!cfb_job_ok(job, (dir == IMB_DIR_ENCRYPT) ?
+                                        jv->C : jv->P, job->user_data,
+                                        padding, sizeof(padding), lens[n]))
+                                goto end;
+                        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                const int n = (int)((uint64_t)job->user_data2);
+                const struct cfb_vector *jv =
+                        &cfb_vectors[n % DIM(cfb_vectors)];
+
+                jobs_rx++;
+                if (!cfb_job_ok(job, (dir == IMB_DIR_ENCRYPT) ? jv->C : jv->P,
+                                job->user_data, padding, sizeof(padding),
+                                lens[n]))
+                        goto end;
+        }
+
+        if (jobs_rx != num_jobs) {
+                printf("Expected %d jobs, received %d\n", num_jobs, jobs_rx);
+                goto end;
+        }
+        ret = 0;
+
+ end:
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < num_jobs; i++)
+                free(targets[i]);
+        free(targets);
+        free(lens);
+        return ret;
+}
+
+int
+cfb_test(struct IMB_MGR *mb_mgr)
+{
+        const int num_jobs_tab[] = {
+                1, 3, 4, 5, 7, 8, 9, 15, 16, 17
+        };
+        unsigned i;
+        int errors = 0;
+
+        for (i = 0; i < DIM(num_jobs_tab); i++)
+                errors += test_cfb_vectors(mb_mgr, DIM(cfb_vectors),
+                                           cfb_vectors,
+                                           "AES-CFB standard test vectors",
+                                           num_jobs_tab[i]);
+
+        printf("AES-CFB mixed keys and lengths:\n");
+        for (i = 0; i < DIM(num_jobs_tab); i++) {
+                const int n = num_jobs_tab[i] * 3;
+
+                if (test_cfb_mixed(mb_mgr, IMB_DIR_ENCRYPT, 0, n)) {
+                        printf("error mixed encrypt, N jobs = %d\n", n);
+                        errors++;
+                }
+                if (test_cfb_mixed(mb_mgr, IMB_DIR_DECRYPT, 0, n)) {
+                        printf("error mixed decrypt, N jobs = %d\n", n);
+                        errors++;
+                }
+                if (test_cfb_mixed(mb_mgr, IMB_DIR_ENCRYPT, 1, n)) {
+                        printf("error mixed encrypt in-place, N jobs = %d\n",
+                               n);
+                        errors++;
+                }
+                if (test_cfb_mixed(mb_mgr, IMB_DIR_DECRYPT, 1, n)) {
+                        printf("error mixed decrypt in-place, N jobs = %d\n",
+                               n);
+                        errors++;
+                }
+        }
+	if (0 == errors)
+		printf("...Pass\n");
+	else
+		printf("...Fail\n");
+
+	return errors;
+}
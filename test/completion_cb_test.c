@@ -0,0 +1,300 @@
+/*****************************************************************************
+ Copyright (c) 2020, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "gcm_ctr_vectors_test.h"
+#include "utils.h"
+
+#define CB_NUM_JOBS      100
+#define CB_FEW_JOBS      3  /* fewer than lanes of any AES-CBC manager */
+#define CB_INVALID_EVERY 37 /* every N-th job has invalid key length */
+#define CB_BUF_SIZE      64
+
+int completion_cb_test(struct IMB_MGR *mb_mgr);
+
+/* State checked and updated by the completion callback */
+struct cb_test_ctx {
+        const unsigned *idx;    /* base of job indexes (user_data) */
+        unsigned next_idx;      /* index of the next expected job */
+        unsigned num_calls;
+        unsigned last_batch;
+        unsigned max_batch;
+        int errors;
+};
+
+struct cb_test_data {
+        DECLARE_ALIGNED(uint32_t enc_keys[11 * 4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[11 * 4], 16);
+        uint8_t iv[16];
+        uint8_t buf[CB_NUM_JOBS][CB_BUF_SIZE];
+        unsigned idx[CB_NUM_JOBS];
+};
+
+static int
+cb_job_invalid(const unsigned i)
+{
+        return (i % CB_INVALID_EVERY) == (CB_INVALID_EVERY - 1);
+}
+
+/*
+ * Checks that jobs are passed in submission order, with expected status,
+ * and records batch sizes
+ */
+static void
+cb_completed(struct IMB_MGR *mb_mgr, IMB_JOB **jobs, const uint32_t num_jobs,
+             void *cb_arg)
+{
+        struct cb_test_ctx *ctx = (struct cb_test_ctx *) cb_arg;
+        uint32_t i;
+
+        (void) mb_mgr;
+        ctx->num_calls++;
+        ctx->last_batch = num_jobs;
+        if (num_jobs > ctx->max_batch)
+                ctx->max_batch = num_jobs;
+
+        if (num_jobs == 0 || num_jobs > MAX_JOBS) {
+                printf("Invalid number of completed jobs %u\n", num_jobs);
+                ctx->errors++;
+                return;
+        }
+
+        for (i = 0; i < num_jobs; i++) {
+                const unsigned idx = (unsigned)
+                        ((const unsigned *) jobs[i]->user_data - ctx->idx);
+                const JOB_STS exp_status = cb_job_invalid(idx) ?
+                        STS_INVALID_ARGS : STS_COMPLETED;
+
+                if (idx != ctx->next_idx) {
+                        printf("Completed job %u out of order "
+                               "(expected %u)\n", idx, ctx->next_idx);
+                        ctx->errors++;
+                        return;
+                }
+                if (jobs[i]->status != exp_status) {
+                        printf("Completed job %u status %d\n", idx,
+                               (int) jobs[i]->status);
+                        ctx->errors++;
+                }
+                ctx->next_idx++;
+        }
+}
+
+/* Submits AES-128-CBC encryption job <i>, same length for all jobs */
+static IMB_JOB *
+cb_submit(struct IMB_MGR *mb_mgr, struct cb_test_data *data, const unsigned i)
+{
+        IMB_JOB *job = IMB_GET_NEXT_JOB(mb_mgr);
+
+        job->chain_order = IMB_ORDER_CIPHER_HASH;
+        job->cipher_direction = IMB_DIR_ENCRYPT;
+        job->cipher_mode = IMB_CIPHER_CBC;
+        job->hash_alg = IMB_AUTH_NULL;
+        job->src = data->buf[i];
+        job->dst = data->buf[i];
+        job->enc_keys = data->enc_keys;
+        job->dec_keys = data->dec_keys;
+        job->key_len_in_bytes = cb_job_invalid(i) ? 7 : 16;
+        job->iv = data->iv;
+        job->iv_len_in_bytes = sizeof(data->iv);
+        job->cipher_start_src_offset_in_bytes = 0;
+        job->msg_len_to_cipher_in_bytes = CB_BUF_SIZE;
+        job->user_data = &data->idx[i];
+
+        return IMB_SUBMIT_JOB(mb_mgr);
+}
+
+static void
+cb_ctx_init(struct cb_test_ctx *ctx, const struct cb_test_data *data)
+{
+        memset(ctx, 0, sizeof(*ctx));
+        ctx->idx = data->idx;
+}
+
+/* Flush of an empty manager makes no callback */
+static int
+test_cb_empty(struct IMB_MGR *mb_mgr, struct cb_test_data *data)
+{
+        struct cb_test_ctx ctx;
+
+        cb_ctx_init(&ctx, data);
+        imb_set_completion_cb(mb_mgr, cb_completed, &ctx);
+
+        if (IMB_FLUSH_JOB(mb_mgr) != NULL || ctx.num_calls != 0) {
+                printf("Flush of empty manager returned or passed a job\n");
+                ctx.errors++;
+        }
+
+        imb_set_completion_cb(mb_mgr, NULL, NULL);
+        return ctx.errors != 0;
+}
+
+/*
+ * Jobs held in lanes are not passed until flush,
+ * which passes all of them in a single callback
+ */
+static int
+test_cb_flush(struct IMB_MGR *mb_mgr, struct cb_test_data *data)
+{
+        struct cb_test_ctx ctx;
+        unsigned i;
+
+        cb_ctx_init(&ctx, data);
+        imb_set_completion_cb(mb_mgr, cb_completed, &ctx);
+
+        for (i = 0; i < CB_FEW_JOBS; i++)
+                if (cb_submit(mb_mgr, data, i) != NULL) {
+                        printf("Submit returned job with callback set\n");
+                        ctx.errors++;
+                }
+        if (ctx.num_calls != 0) {
+                printf("Callback made before lanes are full\n");
+                ctx.errors++;
+        }
+
+        if (IMB_FLUSH_JOB(mb_mgr) != NULL) {
+                printf("Flush returned job with callback set\n");
+                ctx.errors++;
+        }
+        if (ctx.num_calls != 1 || ctx.last_batch != CB_FEW_JOBS) {
+                printf("Flush made %u callbacks, last with %u of %u jobs\n",
+                       ctx.num_calls, ctx.last_batch, CB_FEW_JOBS);
+                ctx.errors++;
+        }
+
+        imb_set_completion_cb(mb_mgr, NULL, NULL);
+        return ctx.errors != 0;
+}
+
+/*
+ * Jobs (including invalid ones) are passed in submission order and
+ * jobs completed by one submit are passed in a single callback
+ */
+static int
+test_cb_order(struct IMB_MGR *mb_mgr, struct cb_test_data *data)
+{
+        struct cb_test_ctx ctx;
+        unsigned i, num_calls;
+
+        cb_ctx_init(&ctx, data);
+        imb_set_completion_cb(mb_mgr, cb_completed, &ctx);
+
+        for (i = 0; i < CB_NUM_JOBS; i++)
+                if (cb_submit(mb_mgr, data, i) != NULL) {
+                        printf("Submit returned job with callback set\n");
+                        ctx.errors++;
+                }
+
+        /* equal length jobs leave the lanes together */
+        if (ctx.max_batch < 2) {
+                printf("Submit passed jobs one at a time\n");
+                ctx.errors++;
+        }
+
+        num_calls = ctx.num_calls;
+        if (IMB_FLUSH_JOB(mb_mgr) != NULL) {
+                printf("Flush returned job with callback set\n");
+                ctx.errors++;
+        }
+        if (ctx.next_idx != CB_NUM_JOBS || IMB_QUEUE_SIZE(mb_mgr) != 0 ||
+            ctx.num_calls > num_calls + 1) {
+                printf("Flush passed %u of %u jobs in %u callbacks\n",
+                       ctx.next_idx, CB_NUM_JOBS, ctx.num_calls - num_calls);
+                ctx.errors++;
+        }
+
+        imb_set_completion_cb(mb_mgr, NULL, NULL);
+        return ctx.errors != 0;
+}
+
+/* With the callback removed, jobs are returned by submit and flush again */
+static int
+test_cb_removed(struct IMB_MGR *mb_mgr, struct cb_test_data *data)
+{
+        struct cb_test_ctx ctx;
+        unsigned num_jobs = 0;
+        IMB_JOB *job;
+
+        cb_ctx_init(&ctx, data);
+        imb_set_completion_cb(mb_mgr, cb_completed, &ctx);
+        imb_set_completion_cb(mb_mgr, NULL, NULL);
+
+        job = cb_submit(mb_mgr, data, 0);
+        while (job != NULL) {
+                num_jobs++;
+                job = IMB_GET_COMPLETED_JOB(mb_mgr);
+        }
+        while (IMB_FLUSH_JOB(mb_mgr) != NULL)
+                num_jobs++;
+
+        if (num_jobs != 1 || ctx.num_calls != 0) {
+                printf("Removed callback: %u jobs returned, %u callbacks\n",
+                       num_jobs, ctx.num_calls);
+                return 1;
+        }
+        return 0;
+}
+
+int
+completion_cb_test(struct IMB_MGR *mb_mgr)
+{
+        struct cb_test_data data;
+        int errors = 0;
+        unsigned i;
+
+        printf("Completion callback test:\n");
+
+        memset(&data, 0, sizeof(data));
+        IMB_AES_KEYEXP_128(mb_mgr, data.buf[0], data.enc_keys, data.dec_keys);
+        for (i = 0; i < CB_NUM_JOBS; i++)
+                data.idx[i] = i;
+
+        while (IMB_FLUSH_JOB(mb_mgr) != NULL)
+                ;
+
+        errors += test_cb_empty(mb_mgr, &data);
+        printf(".");
+        errors += test_cb_flush(mb_mgr, &data);
+        printf(".");
+        errors += test_cb_order(mb_mgr, &data);
+        printf(".");
+        errors += test_cb_removed(mb_mgr, &data);
+        printf(".");
+
+        if (0 == errors)
+                printf("...Pass\n");
+        else
+                printf("...Fail\n");
+
+        return errors;
+}
@@ -0,0 +1,263 @@
+/*****************************************************************************
+ Copyright (c) 2020, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <intel-ipsec-mb.h>
+
+#define DIM(x) (sizeof(x)/sizeof(x[0]))
+
+#define MAX_BUF_SIZE 2048
+
+int crc_test(struct IMB_MGR *mb_mgr);
+
+typedef uint32_t (*crc_api_fn_t)(IMB_MGR *, const void *, const uint64_t);
+
+struct crc_param {
+        const char *name;
+        crc_api_fn_t fn;
+        unsigned width;
+        uint32_t poly;
+        uint32_t init;
+        int refl;
+        uint32_t xor_out;
+        uint32_t check;  /* CRC of "123456789" */
+};
+
+static uint32_t
+api_crc32_ethernet_fcs(IMB_MGR *mgr, const void *msg, const uint64_t len)
+{
+        return IMB_CRC32_ETHERNET_FCS(mgr, msg, len);
+}
+
+static uint32_t
+api_crc32_sctp(IMB_MGR *mgr, const void *msg, const uint64_t len)
+{
+        return IMB_CRC32_SCTP(mgr, msg, len);
+}
+
+static uint32_t
+api_crc16_x25(IMB_MGR *mgr, const void *msg, const uint64_t len)
+{
+        return IMB_CRC16_X25(mgr, msg, len);
+}
+
+static uint32_t
+api_crc24_lte_a(IMB_MGR *mgr, const void *msg, const uint64_t len)
+{
+        return IMB_CRC24_LTE_A(mgr, msg, len);
+}
+
+static uint32_t
+api_crc24_lte_b(IMB_MGR *mgr, const void *msg, const uint64_t len)
+{
+        return IMB_CRC24_LTE_B(mgr, msg, len);
+}
+
+static uint32_t
+api_crc16_fp_data(IMB_MGR *mgr, const void *msg, const uint64_t len)
+{
+        return IMB_CRC16_FP_DATA(mgr, msg, len);
+}
+
+static uint32_t
+api_crc11_fp_header(IMB_MGR *mgr, const void *msg, const uint64_t len)
+{
+        return IMB_CRC11_FP_HEADER(mgr, msg, len);
+}
+
+static uint32_t
+api_crc7_fp_header(IMB_MGR *mgr, const void *msg, const uint64_t len)
+{
+        return IMB_CRC7_FP_HEADER(mgr, msg, len);
+}
+
+static uint32_t
+api_crc10_iuup_data(IMB_MGR *mgr, const void *msg, const uint64_t len)
+{
+        return IMB_CRC10_IUUP_DATA(mgr, msg, len);
+}
+
+static uint32_t
+api_crc6_iuup_header(IMB_MGR *mgr, const void *msg, const uint64_t len)
+{
+        return IMB_CRC6_IUUP_HEADER(mgr, msg, len);
+}
+
+static const struct crc_param crc_params[] = {
+        { "CRC32 Ethernet FCS", api_crc32_ethernet_fcs,
+          32, 0x04C11DB7, 0xFFFFFFFF, 1, 0xFFFFFFFF, 0xCBF43926 },
+        { "CRC32 SCTP", api_crc32_sctp,
+          32, 0x1EDC6F41, 0xFFFFFFFF, 1, 0xFFFFFFFF, 0xE3069283 },
+        { "CRC16 X25", api_crc16_x25,
+          16, 0x1021, 0xFFFF, 1, 0xFFFF, 0x906E },
+        { "CRC24 LTE A", api_crc24_lte_a,
+          24, 0x864CFB, 0, 0, 0, 0xCDE703 },
+        { "CRC24 LTE B", api_crc24_lte_b,
+          24, 0x800063, 0, 0, 0, 0x23EF52 },
+        { "CRC16 FP DATA", api_crc16_fp_data,
+          16, 0x8005, 0, 0, 0, 0xFEE8 },
+        { "CRC11 FP HEADER", api_crc11_fp_header,
+          11, 0x307, 0, 0, 0, 0x061 },
+        { "CRC7 FP HEADER", api_crc7_fp_header,
+          7, 0x45, 0, 0, 0, 0x61 },
+        { "CRC10 IUUP DATA", api_crc10_iuup_data,
+          10, 0x233, 0, 0, 0, 0x199 },
+        { "CRC6 IUUP HEADER", api_crc6_iuup_header,
+          6, 0x2F, 0, 0, 0, 0x2C },
+};
+
+/* Bit-by-bit reference implementation */
+static uint32_t
+crc_reference(const struct crc_param *p, const uint8_t *msg,
+              const uint64_t len)
+{
+        const uint32_t mask = (uint32_t) ((1ULL << p->width) - 1);
+        uint32_t crc = p->init;
+        uint64_t i;
+        unsigned j;
+
+        for (i = 0; i < len; i++) {
+                for (j = 0; j < 8; j++) {
+                        const unsigned bit = p->refl ?
+                                (msg[i] >> j) & 1 : (msg[i] >> (7 - j)) & 1;
+                        unsigned fb;
+
+                        if (p->refl) {
+                                /* LSB first - CRC kept bit reflected */
+                                fb = (crc & 1) ^ bit;
+                                crc >>= 1;
+                                if (fb) {
+                                        unsigned k;
+                                        uint32_t poly_r = 0;
+
+                                        for (k = 0; k < p->width; k++)
+                                                if (p->poly & (1UL << k))
+                                                        poly_r |= 1UL <<
+                                                          (p->width - 1 - k);
+                                        crc ^= poly_r;
+                                }
+                        } else {
+                                fb = ((crc >> (p->width - 1)) & 1) ^ bit;
+                                crc = (crc << 1) & mask;
+                                if (fb)
+                                        crc ^= p->poly;
+                        }
+                }
+        }
+
+        return (crc ^ p->xor_out) & mask;
+}
+
+static int
+test_crc_check_value(IMB_MGR *mgr, const struct crc_param *p)
+{
+        static const char check_str[] = "123456789";
+        const uint32_t crc = p->fn(mgr, check_str, strlen(check_str));
+
+        if (crc != p->check) {
+                printf("\t%s check value mismatch! 0x%08lx != 0x%08lx\n",
+                       p->name, (unsigned long) crc,
+                       (unsigned long) p->check);
+                return 1;
+        }
+        return 0;
+}
+
+static int
+test_crc_lengths(IMB_MGR *mgr, const struct crc_param *p,
+                 const uint8_t *buf)
+{
+        uint64_t len;
+        unsigned offset;
+
+        /* exercise all code paths: partial blocks, by4, bulk folding */
+        for (offset = 0; offset < 3; offset++)
+                for (len = 0; len <= (MAX_BUF_SIZE - offset); len++) {
+                        const uint32_t crc = p->fn(mgr, &buf[offset], len);
+                        const uint32_t ref =
+                                crc_reference(p, &buf[offset], len);
+
+                        if (crc != ref) {
+                                printf("\t%s mismatch! offset %u, "
+                                       "length %lu: 0x%08lx != 0x%08lx\n",
+                                       p->name, offset,
+                                       (unsigned long) len,
+                                       (unsigned long) crc,
+                                       (unsigned long) ref);
+                                return 1;
+                        }
+                        /* shorten test time for longer messages */
+                        if (len >= 512)
+                                len += 13;
+                }
+        return 0;
+}
+
+int
+crc_test(struct IMB_MGR *mb_mgr)
+{
+        uint8_t *buf = malloc(MAX_BUF_SIZE);
+        unsigned i;
+        int errors = 0;
+
+        printf("CRC test:\n");
+
+        if (buf == NULL) {
+                fprintf(stderr, "Can't allocate buffer memory\n");
+                return 1;
+        }
+
+        for (i = 0; i < MAX_BUF_SIZE; i++)
+                buf[i] = (uint8_t) rand();
+
+        for (i = 0; i < DIM(crc_params); i++) {
+                int err = test_crc_check_value(mb_mgr, &crc_params[i]);
+
+                err += test_crc_lengths(mb_mgr, &crc_params[i], buf);
+                errors += err;
+#ifdef DEBUG
+                printf("\t%s - %s\n", crc_params[i].name,
+                       err ? "Fail" : "Pass");
+#else
+                printf(".");
+#endif
+        }
+
+        free(buf);
+
+        if (errors == 0)
+                printf("\nPass\n");
+        else
+                printf("\nFail\n");
+
+        return errors;
+}
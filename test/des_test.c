@@ -486,7 +486,7 @@ test_des_one(struct IMB_MGR *mb_mgr,
 
         job->hash_alg = IMB_AUTH_NULL;
 
-        if (arch == ARCH_AVX512) {
+        if (arch != ARCH_NO_AESNI) {
                 job = IMB_SUBMIT_JOB(mb_mgr);
                 if (job) {
                         printf("%d Unexpected return from submit_job\n",
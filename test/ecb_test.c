@@ -778,6 +778,160 @@ test_ecb_vectors(struct IMB_MGR *mb_mgr, const int vec_cnt,
 	return errors;
 }
 
+static int
+test_ecb_direct_api(struct IMB_MGR *mb_mgr, const int vec_cnt,
+                    const struct ecb_vector *vec_tab)
+{
+        int vect, errors = 0;
+        DECLARE_ALIGNED(uint32_t enc_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15*4], 16);
+
+        printf("AES-ECB direct API test vectors:\n");
+        for (vect = 0; vect < vec_cnt; vect++) {
+                const uint64_t len = vec_tab[vect].Plen;
+                uint8_t *out = malloc(len);
+
+                if (out == NULL) {
+                        fprintf(stderr, "Can't allocate buffer memory\n");
+                        return errors + 1;
+                }
+                printf(".");
+
+                switch (vec_tab[vect].Klen) {
+                case 16:
+                        IMB_AES_KEYEXP_128(mb_mgr, vec_tab[vect].K, enc_keys,
+                                           dec_keys);
+                        IMB_AES128_ECB_ENC(mb_mgr, vec_tab[vect].P, enc_keys,
+                                           out, len);
+                        break;
+                case 24:
+                        IMB_AES_KEYEXP_192(mb_mgr, vec_tab[vect].K, enc_keys,
+                                           dec_keys);
+                        IMB_AES192_ECB_ENC(mb_mgr, vec_tab[vect].P, enc_keys,
+                                           out, len);
+                        break;
+                case 32:
+                default:
+                        IMB_AES_KEYEXP_256(mb_mgr, vec_tab[vect].K, enc_keys,
+                                           dec_keys);
+                        IMB_AES256_ECB_ENC(mb_mgr, vec_tab[vect].P, enc_keys,
+                                           out, len);
+                        break;
+                }
+                if (memcmp(out, vec_tab[vect].C, len)) {
+                        printf("error #%d direct API encrypt\n", vect + 1);
+                        hexdump(stderr, "Received", out, len);
+                        hexdump(stderr, "Expected", vec_tab[vect].C, len);
+                        errors++;
+                }
+
+                /* decrypt in-place */
+                switch (vec_tab[vect].Klen) {
+                case 16:
+                        IMB_AES128_ECB_DEC(mb_mgr, out, dec_keys, out, len);
+                        break;
+                case 24:
+                        IMB_AES192_ECB_DEC(mb_mgr, out, dec_keys, out, len);
+                        break;
+                case 32:
+                default:
+                        IMB_AES256_ECB_DEC(mb_mgr, out, dec_keys, out, len);
+                        break;
+                }
+                if (memcmp(out, vec_tab[vect].P, len)) {
+                        printf("error #%d direct API decrypt\n", vect + 1);
+                        hexdump(stderr, "Received", out, len);
+                        hexdump(stderr, "Expected", vec_tab[vect].P, len);
+                        errors++;
+                }
+                free(out);
+        }
+        printf("\n");
+        return errors;
+}
+
+/*
+ * Checks the direct API on 1 to ECB_MAX_BLOCKS blocks against block by block
+ * encryption, so that all block counts of the multi-block paths are covered.
+ * Trailing partial block must be left untouched.
+ */
+#define ECB_MAX_BLOCKS 40
+
+static int
+test_ecb_direct_api_lengths(struct IMB_MGR *mb_mgr)
+{
+        DECLARE_ALIGNED(uint32_t enc_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15*4], 16);
+        uint8_t key[32];
+        uint8_t in[ECB_MAX_BLOCKS * 16 + 15];
+        uint8_t out[ECB_MAX_BLOCKS * 16 + 15];
+        uint8_t ref[ECB_MAX_BLOCKS * 16];
+        const int key_len_tab[] = { 16, 24, 32 };
+        unsigned i, k, n;
+        int errors = 0;
+
+        printf("AES-ECB direct API lengths:\n");
+        for (i = 0; i < sizeof(key); i++)
+                key[i] = (uint8_t) (i * 7 + 1);
+        for (i = 0; i < sizeof(in); i++)
+                in[i] = (uint8_t) (i * 13 + 5);
+
+        for (k = 0; k < DIM(key_len_tab); k++) {
+                aes_ecb_t enc, dec;
+
+                switch (key_len_tab[k]) {
+                case 16:
+                        IMB_AES_KEYEXP_128(mb_mgr, key, enc_keys, dec_keys);
+                        enc = mb_mgr->aes128_ecb_enc;
+                        dec = mb_mgr->aes128_ecb_dec;
+                        break;
+                case 24:
+                        IMB_AES_KEYEXP_192(mb_mgr, key, enc_keys, dec_keys);
+                        enc = mb_mgr->aes192_ecb_enc;
+                        dec = mb_mgr->aes192_ecb_dec;
+                        break;
+                case 32:
+                default:
+                        IMB_AES_KEYEXP_256(mb_mgr, key, enc_keys, dec_keys);
+                        enc = mb_mgr->aes256_ecb_enc;
+                        dec = mb_mgr->aes256_ecb_dec;
+                        break;
+                }
+
+                for (i = 0; i < ECB_MAX_BLOCKS; i++)
+                        enc(&in[i * 16], enc_keys, &ref[i * 16], 16);
+
+                for (n = 1; n <= ECB_MAX_BLOCKS; n++) {
+                        const uint64_t len = n * 16;
+
+                        printf(".");
+                        memset(out, 0xaa, sizeof(out));
+                        enc(in, enc_keys, out, len + 15);
+                        if (memcmp(out, ref, len) != 0) {
+                                printf("error key_len:%d %u blocks "
+                                       "encrypt\n", key_len_tab[k], n);
+                                errors++;
+                        }
+                        if (out[len] != 0xaa || out[len + 14] != 0xaa) {
+                                printf("error key_len:%d %u blocks "
+                                       "partial block written\n",
+                                       key_len_tab[k], n);
+                                errors++;
+                        }
+
+                        /* decrypt in-place */
+                        dec(out, dec_keys, out, len);
+                        if (memcmp(out, in, len) != 0) {
+                                printf("error key_len:%d %u blocks "
+                                       "decrypt\n", key_len_tab[k], n);
+                                errors++;
+                        }
+                }
+        }
+        printf("\n");
+        return errors;
+}
+
 int
 ecb_test(struct IMB_MGR *mb_mgr)
 {
@@ -793,6 +947,10 @@ ecb_test(struct IMB_MGR *mb_mgr)
                                            "AES-ECB standard test vectors",
                                            IMB_CIPHER_ECB,
                                            num_jobs_tab[i]);
+
+        errors += test_ecb_direct_api(mb_mgr, DIM(ecb_vectors), ecb_vectors);
+        errors += test_ecb_direct_api_lengths(mb_mgr);
+
 	if (0 == errors)
 		printf("...Pass\n");
 	else
@@ -2031,6 +2031,426 @@ static int test_gmac(void)
 	return is_error;
 }
 
+/*
+ * Checks GCM key pre-processing of multiple keys
+ * against the single key API
+ */
+#define MAX_GCM_PRE_N 9
+
+static int test_gcm_pre_n(void)
+{
+        struct gcm_key_data key_data[MAX_GCM_PRE_N];
+        struct gcm_key_data ref_key_data;
+        struct gcm_key_data *key_data_ptrs[MAX_GCM_PRE_N];
+        const void *key_ptrs[MAX_GCM_PRE_N];
+        uint8_t keys[MAX_GCM_PRE_N][32];
+        unsigned key_len, n, i, j;
+        int is_error = 0;
+
+        printf("AES-GCM key pre-processing of multiple keys:\n");
+
+        for (i = 0; i < MAX_GCM_PRE_N; i++) {
+                for (j = 0; j < sizeof(keys[i]); j++)
+                        keys[i][j] = (uint8_t) rand();
+                key_ptrs[i] = keys[i];
+                key_data_ptrs[i] = &key_data[i];
+        }
+
+        for (key_len = BITS_128; key_len <= BITS_256; key_len += 8) {
+                for (n = 1; n <= MAX_GCM_PRE_N; n++) {
+                        printf(".");
+                        memset(key_data, 0, sizeof(key_data));
+                        if (key_len == BITS_128)
+                                IMB_AES128_GCM_PRE_N(p_gcm_mgr, key_ptrs,
+                                                     key_data_ptrs, n);
+                        else if (key_len == BITS_192)
+                                IMB_AES192_GCM_PRE_N(p_gcm_mgr, key_ptrs,
+                                                     key_data_ptrs, n);
+                        else
+                                IMB_AES256_GCM_PRE_N(p_gcm_mgr, key_ptrs,
+                                                     key_data_ptrs, n);
+
+                        for (i = 0; i < n; i++) {
+                                memset(&ref_key_data, 0, sizeof(ref_key_data));
+                                if (key_len == BITS_128)
+                                        IMB_AES128_GCM_PRE(p_gcm_mgr, keys[i],
+                                                           &ref_key_data);
+                                else if (key_len == BITS_192)
+                                        IMB_AES192_GCM_PRE(p_gcm_mgr, keys[i],
+                                                           &ref_key_data);
+                                else
+                                        IMB_AES256_GCM_PRE(p_gcm_mgr, keys[i],
+                                                           &ref_key_data);
+
+                                if (memcmp(&key_data[i], &ref_key_data,
+                                           sizeof(ref_key_data))) {
+                                        printf("AES-GCM-%u pre N=%u key #%u "
+                                               "mismatch\n", key_len * 8,
+                                               n, i);
+                                        is_error = 1;
+                                }
+                        }
+                }
+        }
+        printf("\n");
+        return is_error;
+}
+
+/*
+ * Checks GCM encrypt/decrypt of multiple messages
+ * against the single message API
+ */
+#define MAX_GCM_N 9
+#define MAX_GCM_N_MSG_LEN 200
+#define MAX_GCM_N_AAD_LEN 40
+#define GCM_N_IV_LEN 12
+#define GCM_N_TAG_LEN 16
+
+static void
+gcm_n_ref_enc(const unsigned key_len, const struct gcm_key_data *key,
+              struct gcm_context_data *ctx, uint8_t *out, const uint8_t *in,
+              const uint64_t len, const uint8_t *iv, const uint8_t *aad,
+              const uint64_t aad_len, uint8_t *tag)
+{
+        if (key_len == BITS_128)
+                IMB_AES128_GCM_ENC(p_gcm_mgr, key, ctx, out, in, len, iv,
+                                   aad, aad_len, tag, GCM_N_TAG_LEN);
+        else if (key_len == BITS_192)
+                IMB_AES192_GCM_ENC(p_gcm_mgr, key, ctx, out, in, len, iv,
+                                   aad, aad_len, tag, GCM_N_TAG_LEN);
+        else
+                IMB_AES256_GCM_ENC(p_gcm_mgr, key, ctx, out, in, len, iv,
+                                   aad, aad_len, tag, GCM_N_TAG_LEN);
+}
+
+static int test_gcm_enc_dec_n(void)
+{
+        static uint8_t keys[MAX_GCM_N][32];
+        static uint8_t ivs[MAX_GCM_N][GCM_N_IV_LEN];
+        static uint8_t aads[MAX_GCM_N][MAX_GCM_N_AAD_LEN];
+        static uint8_t pts[MAX_GCM_N][MAX_GCM_N_MSG_LEN];
+        static uint8_t cts[MAX_GCM_N][MAX_GCM_N_MSG_LEN];
+        static uint8_t outs[MAX_GCM_N][MAX_GCM_N_MSG_LEN];
+        static uint8_t tags[MAX_GCM_N][GCM_N_TAG_LEN];
+        static uint8_t ref_tags[MAX_GCM_N][GCM_N_TAG_LEN];
+        struct gcm_key_data key_data[MAX_GCM_N];
+        struct gcm_context_data ctx[MAX_GCM_N];
+        const struct gcm_key_data *key_ptrs[MAX_GCM_N];
+        struct gcm_context_data *ctx_ptrs[MAX_GCM_N];
+        const uint8_t *iv_ptrs[MAX_GCM_N], *aad_ptrs[MAX_GCM_N];
+        const uint8_t *pt_ptrs[MAX_GCM_N], *ct_ptrs[MAX_GCM_N];
+        uint8_t *out_ptrs[MAX_GCM_N], *tag_ptrs[MAX_GCM_N];
+        uint64_t lens[MAX_GCM_N], aad_lens[MAX_GCM_N];
+        unsigned key_len, n, i, j;
+        int is_error = 0;
+
+        printf("AES-GCM encrypt/decrypt of multiple messages:\n");
+
+        for (i = 0; i < MAX_GCM_N; i++) {
+                for (j = 0; j < sizeof(keys[i]); j++)
+                        keys[i][j] = (uint8_t) rand();
+                for (j = 0; j < sizeof(ivs[i]); j++)
+                        ivs[i][j] = (uint8_t) rand();
+                for (j = 0; j < sizeof(aads[i]); j++)
+                        aads[i][j] = (uint8_t) rand();
+                for (j = 0; j < sizeof(pts[i]); j++)
+                        pts[i][j] = (uint8_t) rand();
+                key_ptrs[i] = &key_data[i];
+                ctx_ptrs[i] = &ctx[i];
+                iv_ptrs[i] = ivs[i];
+                aad_ptrs[i] = aads[i];
+                pt_ptrs[i] = pts[i];
+                ct_ptrs[i] = cts[i];
+                out_ptrs[i] = outs[i];
+                tag_ptrs[i] = tags[i];
+        }
+
+        for (key_len = BITS_128; key_len <= BITS_256; key_len += 8) {
+                for (i = 0; i < MAX_GCM_N; i++) {
+                        if (key_len == BITS_128)
+                                IMB_AES128_GCM_PRE(p_gcm_mgr, keys[i],
+                                                   &key_data[i]);
+                        else if (key_len == BITS_192)
+                                IMB_AES192_GCM_PRE(p_gcm_mgr, keys[i],
+                                                   &key_data[i]);
+                        else
+                                IMB_AES256_GCM_PRE(p_gcm_mgr, keys[i],
+                                                   &key_data[i]);
+                }
+
+                for (n = 1; n <= MAX_GCM_N; n++) {
+                        printf(".");
+                        /* mix of empty, partial and full block lengths */
+                        for (i = 0; i < n; i++) {
+                                lens[i] = (n * 37 + i * 53) %
+                                        MAX_GCM_N_MSG_LEN;
+                                aad_lens[i] = (n + i * 7) %
+                                        MAX_GCM_N_AAD_LEN;
+                                gcm_n_ref_enc(key_len, &key_data[i], &ctx[i],
+                                              cts[i], pts[i], lens[i], ivs[i],
+                                              aads[i], aad_lens[i],
+                                              ref_tags[i]);
+                        }
+
+                        memset(outs, 0, sizeof(outs));
+                        memset(tags, 0, sizeof(tags));
+                        if (key_len == BITS_128)
+                                IMB_AES128_GCM_ENC_N(p_gcm_mgr, key_ptrs,
+                                                     ctx_ptrs, out_ptrs,
+                                                     pt_ptrs, lens, iv_ptrs,
+                                                     aad_ptrs, aad_lens,
+                                                     tag_ptrs, GCM_N_TAG_LEN,
+                                                     n);
+                        else if (key_len == BITS_192)
+                                IMB_AES192_GCM_ENC_N(p_gcm_mgr, key_ptrs,
+                                                     ctx_ptrs, out_ptrs,
+                                                     pt_ptrs, lens, iv_ptrs,
+                                                     aad_ptrs, aad_lens,
+                                                     tag_ptrs, GCM_N_TAG_LEN,
+                                                     n);
+                        else
+                                IMB_AES256_GCM_ENC_N(p_gcm_mgr, key_ptrs,
+                                                     ctx_ptrs, out_ptrs,
+                                                     pt_ptrs, lens, iv_ptrs,
+                                                     aad_ptrs, aad_lens,
+                                                     tag_ptrs, GCM_N_TAG_LEN,
+                                                     n);
+
+                        for (i = 0; i < n; i++) {
+                                if (memcmp(outs[i], cts[i], lens[i]) ||
+                                    memcmp(tags[i], ref_tags[i],
+                                           GCM_N_TAG_LEN)) {
+                                        printf("AES-GCM-%u enc N=%u msg #%u "
+                                               "mismatch\n", key_len * 8,
+                                               n, i);
+                                        is_error = 1;
+                                }
+                        }
+
+                        memset(outs, 0, sizeof(outs));
+                        memset(tags, 0, sizeof(tags));
+                        if (key_len == BITS_128)
+                                IMB_AES128_GCM_DEC_N(p_gcm_mgr, key_ptrs,
+                                                     ctx_ptrs, out_ptrs,
+                                                     ct_ptrs, lens, iv_ptrs,
+                                                     aad_ptrs, aad_lens,
+                                                     tag_ptrs, GCM_N_TAG_LEN,
+                                                     n);
+                        else if (key_len == BITS_192)
+                                IMB_AES192_GCM_DEC_N(p_gcm_mgr, key_ptrs,
+                                                     ctx_ptrs, out_ptrs,
+                                                     ct_ptrs, lens, iv_ptrs,
+                                                     aad_ptrs, aad_lens,
+                                                     tag_ptrs, GCM_N_TAG_LEN,
+                                                     n);
+                        else
+                                IMB_AES256_GCM_DEC_N(p_gcm_mgr, key_ptrs,
+                                                     ctx_ptrs, out_ptrs,
+                                                     ct_ptrs, lens, iv_ptrs,
+                                                     aad_ptrs, aad_lens,
+                                                     tag_ptrs, GCM_N_TAG_LEN,
+                                                     n);
+
+                        for (i = 0; i < n; i++) {
+                                if (memcmp(outs[i], pts[i], lens[i]) ||
+                                    memcmp(tags[i], ref_tags[i],
+                                           GCM_N_TAG_LEN)) {
+                                        printf("AES-GCM-%u dec N=%u msg #%u "
+                                               "mismatch\n", key_len * 8,
+                                               n, i);
+                                        is_error = 1;
+                                }
+                        }
+                }
+        }
+        printf("\n");
+        return is_error;
+}
+
+/*
+ * Checks GCM encrypt/decrypt with compact key data
+ * and full key data expanded from it against the full key data API.
+ */
+#define MAX_GCM_COMPACT_KEYS 11
+#define GCM_COMPACT_ROUNDS 5
+
+static void
+gcm_compact_enc_dec(const unsigned key_len,
+                    const struct gcm_key_data_compact *key,
+                    struct gcm_context_data *ctx, uint8_t *out,
+                    const uint8_t *in, const uint64_t len, const uint8_t *iv,
+                    const uint8_t *aad, const uint64_t aad_len, uint8_t *tag,
+                    const int encrypt)
+{
+        if (key_len == BITS_128) {
+                if (encrypt)
+                        IMB_AES128_GCM_ENC_COMPACT(p_gcm_mgr, key, ctx, out,
+                                                   in, len, iv, aad, aad_len,
+                                                   tag, GCM_N_TAG_LEN);
+                else
+                        IMB_AES128_GCM_DEC_COMPACT(p_gcm_mgr, key, ctx, out,
+                                                   in, len, iv, aad, aad_len,
+                                                   tag, GCM_N_TAG_LEN);
+        } else if (key_len == BITS_192) {
+                if (encrypt)
+                        IMB_AES192_GCM_ENC_COMPACT(p_gcm_mgr, key, ctx, out,
+                                                   in, len, iv, aad, aad_len,
+                                                   tag, GCM_N_TAG_LEN);
+                else
+                        IMB_AES192_GCM_DEC_COMPACT(p_gcm_mgr, key, ctx, out,
+                                                   in, len, iv, aad, aad_len,
+                                                   tag, GCM_N_TAG_LEN);
+        } else {
+                if (encrypt)
+                        IMB_AES256_GCM_ENC_COMPACT(p_gcm_mgr, key, ctx, out,
+                                                   in, len, iv, aad, aad_len,
+                                                   tag, GCM_N_TAG_LEN);
+                else
+                        IMB_AES256_GCM_DEC_COMPACT(p_gcm_mgr, key, ctx, out,
+                                                   in, len, iv, aad, aad_len,
+                                                   tag, GCM_N_TAG_LEN);
+        }
+}
+
+static void
+gcm_compact_expand(const unsigned key_len,
+                   const struct gcm_key_data_compact *key,
+                   struct gcm_key_data *key_exp)
+{
+        if (key_len == BITS_128)
+                IMB_AES128_GCM_EXPAND_COMPACT(p_gcm_mgr, key, key_exp);
+        else if (key_len == BITS_192)
+                IMB_AES192_GCM_EXPAND_COMPACT(p_gcm_mgr, key, key_exp);
+        else
+                IMB_AES256_GCM_EXPAND_COMPACT(p_gcm_mgr, key, key_exp);
+}
+
+static int test_gcm_compact(void)
+{
+        static uint8_t keys[MAX_GCM_COMPACT_KEYS][32];
+        static uint8_t iv[GCM_N_IV_LEN];
+        static uint8_t aad[MAX_GCM_N_AAD_LEN];
+        static uint8_t pt[MAX_GCM_N_MSG_LEN];
+        static uint8_t ct[MAX_GCM_N_MSG_LEN];
+        static uint8_t out[MAX_GCM_N_MSG_LEN];
+        uint8_t tag[GCM_N_TAG_LEN], ref_tag[GCM_N_TAG_LEN];
+        struct gcm_key_data key_data[MAX_GCM_COMPACT_KEYS];
+        struct gcm_key_data key_exp;
+        struct gcm_key_data_compact key_compact[MAX_GCM_COMPACT_KEYS];
+        struct gcm_context_data ctx;
+        unsigned key_len, round, i, j;
+        int is_error = 0;
+
+        printf("AES-GCM encrypt/decrypt with compact key data:\n");
+
+        for (i = 0; i < MAX_GCM_COMPACT_KEYS; i++)
+                for (j = 0; j < sizeof(keys[i]); j++)
+                        keys[i][j] = (uint8_t) rand();
+        for (j = 0; j < sizeof(iv); j++)
+                iv[j] = (uint8_t) rand();
+        for (j = 0; j < sizeof(aad); j++)
+                aad[j] = (uint8_t) rand();
+        for (j = 0; j < sizeof(pt); j++)
+                pt[j] = (uint8_t) rand();
+
+        for (key_len = BITS_128; key_len <= BITS_256; key_len += 8) {
+                printf(".");
+                for (i = 0; i < MAX_GCM_COMPACT_KEYS; i++) {
+                        if (key_len == BITS_128) {
+                                IMB_AES128_GCM_PRE(p_gcm_mgr, keys[i],
+                                                   &key_data[i]);
+                                IMB_AES128_GCM_PRE_COMPACT(p_gcm_mgr, keys[i],
+                                                           &key_compact[i]);
+                        } else if (key_len == BITS_192) {
+                                IMB_AES192_GCM_PRE(p_gcm_mgr, keys[i],
+                                                   &key_data[i]);
+                                IMB_AES192_GCM_PRE_COMPACT(p_gcm_mgr, keys[i],
+                                                           &key_compact[i]);
+                        } else {
+                                IMB_AES256_GCM_PRE(p_gcm_mgr, keys[i],
+                                                   &key_data[i]);
+                                IMB_AES256_GCM_PRE_COMPACT(p_gcm_mgr, keys[i],
+                                                           &key_compact[i]);
+                        }
+                }
+
+                /* visit the keys in a scattered order */
+                for (round = 0; round < GCM_COMPACT_ROUNDS; round++) {
+                        for (j = 0; j < MAX_GCM_COMPACT_KEYS; j++) {
+                                const uint64_t len =
+                                        (round * 61 + j * 29) %
+                                        MAX_GCM_N_MSG_LEN;
+
+                                i = (j * 7 + round) % MAX_GCM_COMPACT_KEYS;
+
+                                gcm_n_ref_enc(key_len, &key_data[i], &ctx,
+                                              ct, pt, len, iv, aad,
+                                              sizeof(aad), ref_tag);
+
+                                memset(out, 0, sizeof(out));
+                                memset(tag, 0, sizeof(tag));
+                                gcm_compact_enc_dec(key_len, &key_compact[i],
+                                                    &ctx, out, pt, len, iv,
+                                                    aad, sizeof(aad), tag, 1);
+                                if (memcmp(out, ct, len) ||
+                                    memcmp(tag, ref_tag, sizeof(tag))) {
+                                        printf("AES-GCM-%u compact enc "
+                                               "key #%u mismatch\n",
+                                               key_len * 8, i);
+                                        is_error = 1;
+                                }
+
+                                memset(out, 0, sizeof(out));
+                                memset(tag, 0, sizeof(tag));
+                                gcm_compact_enc_dec(key_len, &key_compact[i],
+                                                    &ctx, out, ct, len, iv,
+                                                    aad, sizeof(aad), tag, 0);
+                                if (memcmp(out, pt, len) ||
+                                    memcmp(tag, ref_tag, sizeof(tag))) {
+                                        printf("AES-GCM-%u compact dec "
+                                               "key #%u mismatch\n",
+                                               key_len * 8, i);
+                                        is_error = 1;
+                                }
+
+                                memset(&key_exp, 0, sizeof(key_exp));
+                                gcm_compact_expand(key_len, &key_compact[i],
+                                                   &key_exp);
+                                memset(out, 0, sizeof(out));
+                                memset(tag, 0, sizeof(tag));
+                                gcm_n_ref_enc(key_len, &key_exp, &ctx, out,
+                                              pt, len, iv, aad, sizeof(aad),
+                                              tag);
+                                if (memcmp(out, ct, len) ||
+                                    memcmp(tag, ref_tag, sizeof(tag))) {
+                                        printf("AES-GCM-%u expanded compact "
+                                               "key #%u mismatch\n",
+                                               key_len * 8, i);
+                                        is_error = 1;
+                                }
+                        }
+                }
+
+                /* rewrite compact key in place (same address) */
+                memcpy(&key_compact[0], &key_compact[1],
+                       sizeof(key_compact[0]));
+                gcm_n_ref_enc(key_len, &key_data[1], &ctx, ct, pt,
+                              MAX_GCM_N_MSG_LEN, iv, aad, sizeof(aad),
+                              ref_tag);
+                gcm_compact_enc_dec(key_len, &key_compact[0], &ctx, out, pt,
+                                    MAX_GCM_N_MSG_LEN, iv, aad, sizeof(aad),
+                                    tag, 1);
+                if (memcmp(out, ct, MAX_GCM_N_MSG_LEN) ||
+                    memcmp(tag, ref_tag, sizeof(tag))) {
+                        printf("AES-GCM-%u compact key rewrite mismatch\n",
+                               key_len * 8);
+                        is_error = 1;
+                }
+        }
+        printf("\n");
+        return is_error;
+}
+
 int gcm_test(IMB_MGR *p_mgr)
 {
 	int errors = 0;
@@ -2043,6 +2463,12 @@ int gcm_test(IMB_MGR *p_mgr)
 
         errors += test_ghash();
 
+        errors += test_gcm_pre_n();
+
+        errors += test_gcm_enc_dec_n();
+
+        errors += test_gcm_compact();
+
 	if (0 == errors)
 		printf("...Pass\n");
 	else
@@ -1568,6 +1568,10 @@ do_test(IMB_MGR *enc_mb_mgr, const enum arch_type_e enc_arch,
                         goto exit;
                 }
 
+                /* Registers are cleared explicitly in burst mode */
+                if (safe_check && (flags & IMB_FLAG_SAFE_DATA_BURST))
+                        IMB_CLEAR_SCRATCH(enc_mb_mgr);
+
                 /* Check that the registers, stack and MB_MGR do not contain any
                  * sensitive information after job is returned */
                 if (safe_check)
@@ -1613,6 +1617,10 @@ do_test(IMB_MGR *enc_mb_mgr, const enum arch_type_e enc_arch,
                 if (!job)
                         job = IMB_FLUSH_JOB(dec_mb_mgr);
 
+                /* Registers are cleared explicitly in burst mode */
+                if (safe_check && (flags & IMB_FLAG_SAFE_DATA_BURST))
+                        IMB_CLEAR_SCRATCH(dec_mb_mgr);
+
                 /* Check that the registers, stack and MB_MGR do not contain any
                  * sensitive information after job is returned */
                 if (safe_check)
@@ -1987,7 +1995,10 @@ static void usage(void)
                 "--job-iter: number of tests iterations for each job size\n"
                 "--safe-check: check if keys, IVs, plaintext or tags "
                 "get cleared from IMB_MGR upon job completion (off by default; "
-                "requires library compiled with SAFE_DATA)\n");
+                "requires library compiled with SAFE_DATA)\n"
+                "--safe-burst: same as --safe-check, with registers "
+                "cleared by IMB_CLEAR_SCRATCH()\n"
+                "              (IMB_FLAG_SAFE_DATA_BURST manager flag)\n");
 }
 
 static int
@@ -2310,6 +2321,9 @@ int main(int argc, char *argv[])
                                              argc, &job_iter, sizeof(job_iter));
                 } else if (strcmp(argv[i], "--safe-check") == 0) {
                         safe_check = 1;
+                } else if (strcmp(argv[i], "--safe-burst") == 0) {
+                        safe_check = 1;
+                        flags |= IMB_FLAG_SAFE_DATA_BURST;
                 } else {
                         usage();
                         return EXIT_FAILURE;
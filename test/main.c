@@ -43,6 +43,9 @@ extern int hmac_sha256_sha512_test(struct IMB_MGR *mb_mgr);
 extern int hmac_md5_test(struct IMB_MGR *mb_mgr);
 extern int aes_test(struct IMB_MGR *mb_mgr);
 extern int ecb_test(struct IMB_MGR *mb_mgr);
+extern int cfb_test(struct IMB_MGR *mb_mgr);
+extern int xts_test(struct IMB_MGR *mb_mgr);
+extern int sgl_test(struct IMB_MGR *mb_mgr);
 extern int sha_test(struct IMB_MGR *mb_mgr);
 extern int chained_test(struct IMB_MGR *mb_mgr);
 extern int api_test(struct IMB_MGR *mb_mgr);
@@ -53,6 +56,9 @@ extern int snow3g_test(struct IMB_MGR *mb_mgr);
 extern int direct_api_test(struct IMB_MGR *mb_mgr);
 extern int clear_mem_test(struct IMB_MGR *mb_mgr);
 extern int hec_test(struct IMB_MGR *mb_mgr);
+extern int crc_test(struct IMB_MGR *mb_mgr);
+extern int pool_test(const enum arch_type arch, struct IMB_MGR *mb_mgr);
+extern int completion_cb_test(struct IMB_MGR *mb_mgr);
 
 #include "do_test.h"
 
@@ -298,12 +304,18 @@ main(int argc, char **argv)
                 errors += hmac_md5_test(p_mgr);
                 errors += aes_test(p_mgr);
                 errors += ecb_test(p_mgr);
+                errors += cfb_test(p_mgr);
+                errors += xts_test(p_mgr);
+                errors += sgl_test(p_mgr);
                 errors += sha_test(p_mgr);
                 errors += chained_test(p_mgr);
                 errors += hec_test(p_mgr);
+                errors += crc_test(p_mgr);
                 errors += api_test(p_mgr);
                 errors += direct_api_test(p_mgr);
                 errors += clear_mem_test(p_mgr);
+                errors += pool_test(atype, p_mgr);
+                errors += completion_cb_test(p_mgr);
                 free_mb_mgr(p_mgr);
         }
 
@@ -678,10 +678,189 @@ test_pon_std_vectors(struct IMB_MGR *mb_mgr)
 	return errors;
 }
 
+/* XGEM payload lengths (PLI) for the long message test */
+static const uint16_t pon_pli_tab[] = {
+        5, 17, 63, 64, 68, 69, 76, 127, 255, 259, 260, 264, 300,
+        515, 1024, 1518, 2047, 4100, 9000, 16383
+};
+
+/* counter blocks: IV with 128-bit increments */
+static void
+pon_ctr_blocks(uint8_t *ctr, const uint8_t *iv, const size_t num_blocks)
+{
+        size_t i;
+        int j;
+
+        memcpy(ctr, iv, 16);
+        for (i = 1; i < num_blocks; i++) {
+                memcpy(&ctr[i * 16], &ctr[(i - 1) * 16], 16);
+                for (j = 15; j >= 0; j--)
+                        if (++ctr[i * 16 + j] != 0)
+                                break;
+        }
+}
+
+static int
+test_pon_len(struct IMB_MGR *mb_mgr, const void *expkey, const uint8_t *iv,
+             const uint16_t pli, const int dir)
+{
+        const size_t len_ciph = (pli + 3) & ~3;
+        const size_t len_bip = len_ciph + 8;
+        const size_t num_blocks = (len_ciph + 15) / 16;
+        uint8_t *plain = malloc(len_bip);
+        uint8_t *ref = malloc(len_bip);
+        uint8_t *target = malloc(len_bip + 8);
+        uint8_t *ks = malloc(num_blocks * 16);
+        struct IMB_JOB *job;
+        uint64_t tag_output = 0;
+        uint32_t fcs, bip = 0, word;
+        size_t i;
+        int ret = -1;
+
+        if (plain == NULL || ref == NULL || target == NULL || ks == NULL) {
+                fprintf(stderr, "Can't allocate buffer memory\n");
+                goto end;
+        }
+
+        /* XGEM header with PLI, frame, Ethernet FCS and padding */
+        for (i = 0; i < len_bip; i++)
+                plain[i] = (uint8_t) (i * 7 + pli);
+        plain[0] = (uint8_t) (pli >> 6);
+        plain[1] = (uint8_t) ((pli << 2) | (plain[1] & 3));
+        fcs = IMB_CRC32_ETHERNET_FCS(mb_mgr, &plain[8], pli - 4);
+        memcpy(&plain[8 + pli - 4], &fcs, sizeof(fcs));
+
+        /* reference cipher text */
+        memcpy(ref, plain, len_bip);
+        if (iv != NULL) {
+                pon_ctr_blocks(ks, iv, num_blocks);
+                IMB_AES128_ECB_ENC(mb_mgr, ks, expkey, ks, num_blocks * 16);
+                for (i = 0; i < len_ciph; i++)
+                        ref[8 + i] ^= ks[i];
+        }
+
+        if (dir == IMB_DIR_ENCRYPT) {
+                memcpy(target, plain, len_bip);
+                /* corrupt FCS to check it gets updated */
+                target[8 + pli - 1] ^= 0xff;
+        } else {
+                memcpy(target, ref, len_bip);
+        }
+        memset(target + len_bip, 0xaa, 8);
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        job = IMB_GET_NEXT_JOB(mb_mgr);
+        job->cipher_direction = dir;
+        job->chain_order = (dir == IMB_DIR_ENCRYPT) ?
+                IMB_ORDER_HASH_CIPHER : IMB_ORDER_CIPHER_HASH;
+        job->src = target;
+        job->dst = target + 8;
+        job->cipher_mode = IMB_CIPHER_PON_AES_CNTR;
+        job->cipher_start_src_offset_in_bytes = 8;
+        job->enc_keys = (iv != NULL) ? expkey : NULL;
+        job->dec_keys = job->enc_keys;
+        job->key_len_in_bytes = (iv != NULL) ? IMB_KEY_AES_128_BYTES : 0;
+        job->iv = iv;
+        job->iv_len_in_bytes = (iv != NULL) ? 16 : 0;
+        job->msg_len_to_cipher_in_bytes = (iv != NULL) ? len_ciph : 0;
+        job->hash_alg = IMB_AUTH_PON_CRC_BIP;
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bytes = len_bip;
+        job->auth_tag_output = (void *) &tag_output;
+        job->auth_tag_output_len_in_bytes = (uint64_t) sizeof(tag_output);
+        job = IMB_SUBMIT_JOB(mb_mgr);
+
+        if (job == NULL || job->status != STS_COMPLETED) {
+                printf("%d job not completed\n", __LINE__);
+                goto end;
+        }
+
+        /* BIP: XOR of 32-bit words of the header (HEC updated on encrypt)
+         * and the cipher text */
+        memcpy(ref, target, 8);
+        for (i = 0; i < len_bip; i += 4) {
+                memcpy(&word, &ref[i], sizeof(word));
+                bip ^= word;
+        }
+
+        if (memcmp(target + 8, (dir == IMB_DIR_ENCRYPT) ? ref + 8 : plain + 8,
+                   len_ciph) != 0) {
+                printf("output mismatch\n");
+                goto end;
+        }
+        if ((uint32_t) tag_output != bip) {
+                printf("BIP mismatch! expected 0x%08x, received 0x%08x\n",
+                       bip, (uint32_t) tag_output);
+                goto end;
+        }
+        if ((uint32_t) (tag_output >> 32) != fcs) {
+                printf("CRC mismatch! expected 0x%08x, received 0x%08x\n",
+                       fcs, (uint32_t) (tag_output >> 32));
+                goto end;
+        }
+        for (i = len_bip; i < (len_bip + 8); i++)
+                if (target[i] != 0xaa) {
+                        printf("overwrite tail\n");
+                        goto end;
+                }
+
+        ret = 0;
+ end:
+        free(plain);
+        free(ref);
+        free(target);
+        free(ks);
+        return ret;
+}
+
+static int
+test_pon_lengths(struct IMB_MGR *mb_mgr)
+{
+        /* low 64 bits of the counter wrap after 2 blocks */
+        static const uint8_t iv_wrap[16] = {
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe
+        };
+        const uint8_t *iv_tab[] = { IV1_PON, iv_wrap, NULL };
+        const int num_pli = sizeof(pon_pli_tab) / sizeof(pon_pli_tab[0]);
+        DECLARE_ALIGNED(uint32_t expkey[4*15], 16);
+        DECLARE_ALIGNED(uint32_t dust[4*15], 16);
+        int errors = 0;
+        unsigned i;
+        int n;
+
+        printf("PON (AES128-CTR/CRC/BIP) message length test:\n");
+
+        IMB_AES_KEYEXP_128(mb_mgr, KEY1_PON, expkey, dust);
+
+        for (i = 0; i < (sizeof(iv_tab) / sizeof(iv_tab[0])); i++)
+                for (n = 0; n < num_pli; n++) {
+                        printf(".");
+                        if (test_pon_len(mb_mgr, expkey, iv_tab[i],
+                                         pon_pli_tab[n], IMB_DIR_ENCRYPT)) {
+                                printf("error PLI %d encrypt\n",
+                                       (int) pon_pli_tab[n]);
+                                errors++;
+                        }
+                        if (test_pon_len(mb_mgr, expkey, iv_tab[i],
+                                         pon_pli_tab[n], IMB_DIR_DECRYPT)) {
+                                printf("error PLI %d decrypt\n",
+                                       (int) pon_pli_tab[n]);
+                                errors++;
+                        }
+                }
+        printf("\n");
+        return errors;
+}
+
 int pon_test(struct IMB_MGR *mb_mgr)
 {
         int errors = test_pon_std_vectors(mb_mgr);
 
+        errors += test_pon_lengths(mb_mgr);
+
 	if (0 == errors)
 		printf("...Pass\n");
 	else
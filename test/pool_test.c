@@ -0,0 +1,290 @@
+/*****************************************************************************
+ Copyright (c) 2020, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "gcm_ctr_vectors_test.h"
+#include "utils.h"
+
+#define POOL_NUM_JOBS    256
+#define POOL_MAX_LEN     1024
+#define POOL_NUM_WORKERS 4
+#define POOL_QUEUE_SIZE  32
+#define POOL_TAG_LEN     12
+#define POOL_TIMEOUT_SEC 10 /* max time without any job completing */
+
+int pool_test(const enum arch_type arch, struct IMB_MGR *mb_mgr);
+
+struct pool_test_data {
+        DECLARE_ALIGNED(uint32_t enc_keys[11 * 4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[11 * 4], 16);
+        DECLARE_ALIGNED(uint8_t ipad_hash[SHA1_DIGEST_SIZE_IN_BYTES], 16);
+        DECLARE_ALIGNED(uint8_t opad_hash[SHA1_DIGEST_SIZE_IN_BYTES], 16);
+        uint8_t iv[16];
+        uint8_t src[POOL_NUM_JOBS][POOL_MAX_LEN];
+        uint8_t ref_dst[POOL_NUM_JOBS][POOL_MAX_LEN];
+        uint8_t ref_tag[POOL_NUM_JOBS][POOL_TAG_LEN];
+        uint8_t dst[POOL_NUM_JOBS][POOL_MAX_LEN];
+        uint8_t tag[POOL_NUM_JOBS][POOL_TAG_LEN];
+        IMB_JOB jobs[POOL_NUM_JOBS];
+};
+
+static void
+pool_generate_random(uint8_t *buf, const size_t len)
+{
+        size_t i;
+
+        for (i = 0; i < len; i++)
+                buf[i] = (uint8_t) rand();
+}
+
+static uint64_t
+pool_job_len(const unsigned i)
+{
+        return ((i % (POOL_MAX_LEN / 16)) + 1) * 16;
+}
+
+static void
+pool_prepare_keys(struct IMB_MGR *mb_mgr, struct pool_test_data *data)
+{
+        uint8_t key[16];
+        uint8_t hmac_key[SHA1_BLOCK_SIZE];
+        uint8_t buf[SHA1_BLOCK_SIZE];
+        unsigned i;
+
+        pool_generate_random(key, sizeof(key));
+        pool_generate_random(data->iv, sizeof(data->iv));
+        IMB_AES_KEYEXP_128(mb_mgr, key, data->enc_keys, data->dec_keys);
+
+        pool_generate_random(hmac_key, sizeof(hmac_key));
+        for (i = 0; i < SHA1_BLOCK_SIZE; i++)
+                buf[i] = hmac_key[i] ^ 0x36;
+        IMB_SHA1_ONE_BLOCK(mb_mgr, buf, data->ipad_hash);
+        for (i = 0; i < SHA1_BLOCK_SIZE; i++)
+                buf[i] = hmac_key[i] ^ 0x5c;
+        IMB_SHA1_ONE_BLOCK(mb_mgr, buf, data->opad_hash);
+}
+
+static void
+pool_fill_job(IMB_JOB *job, struct pool_test_data *data, const unsigned i,
+              uint8_t *dst, uint8_t *tag)
+{
+        job->chain_order = IMB_ORDER_CIPHER_HASH;
+        job->cipher_direction = IMB_DIR_ENCRYPT;
+        job->cipher_mode = IMB_CIPHER_CBC;
+        job->hash_alg = IMB_AUTH_HMAC_SHA_1;
+        job->src = data->src[i];
+        job->dst = dst;
+        job->enc_keys = data->enc_keys;
+        job->dec_keys = data->dec_keys;
+        job->key_len_in_bytes = 16;
+        job->iv = data->iv;
+        job->iv_len_in_bytes = sizeof(data->iv);
+        job->cipher_start_src_offset_in_bytes = 0;
+        job->msg_len_to_cipher_in_bytes = pool_job_len(i);
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bytes = pool_job_len(i);
+        job->u.HMAC._hashed_auth_key_xor_ipad = data->ipad_hash;
+        job->u.HMAC._hashed_auth_key_xor_opad = data->opad_hash;
+        job->auth_tag_output = tag;
+        job->auth_tag_output_len_in_bytes = POOL_TAG_LEN;
+        job->num_sgl_io_segs = 0;
+        job->user_data = NULL;
+}
+
+/* Generates reference output with the manager under test */
+static int
+pool_reference(struct IMB_MGR *mb_mgr, struct pool_test_data *data)
+{
+        IMB_JOB *job;
+        unsigned i;
+
+        for (i = 0; i < POOL_NUM_JOBS; i++) {
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                pool_fill_job(job, data, i, data->ref_dst[i],
+                              data->ref_tag[i]);
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                while (job != NULL) {
+                        if (job->status != STS_COMPLETED)
+                                return 1;
+                        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+                }
+        }
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                if (job->status != STS_COMPLETED)
+                        return 1;
+
+        return 0;
+}
+
+/*
+ * Runs all jobs through worker pool, with <num_flows> flow hints,
+ * and compares the output against the reference
+ */
+static int
+pool_run(IMB_POOL *pool, struct pool_test_data *data,
+         const unsigned num_flows)
+{
+        unsigned submitted = 0, completed = 0, i;
+        uint8_t seen[POOL_NUM_JOBS];
+        time_t last_progress = time(NULL);
+        IMB_JOB *job;
+
+        memset(seen, 0, sizeof(seen));
+        memset(data->dst, 0, sizeof(data->dst));
+        memset(data->tag, 0, sizeof(data->tag));
+        for (i = 0; i < POOL_NUM_JOBS; i++)
+                pool_fill_job(&data->jobs[i], data, i, data->dst[i],
+                              data->tag[i]);
+
+        while (completed < POOL_NUM_JOBS) {
+                /* queue as many jobs as possible, then collect */
+                while (submitted < POOL_NUM_JOBS &&
+                       imb_pool_submit_job(pool, &data->jobs[submitted],
+                                           submitted % num_flows) == 0)
+                        submitted++;
+
+                while ((job = imb_pool_get_completed_job(pool)) != NULL) {
+                        const unsigned idx = (unsigned) (job - data->jobs);
+
+                        if (idx >= POOL_NUM_JOBS || seen[idx]) {
+                                printf("Pool returned invalid job\n");
+                                return 1;
+                        }
+                        if (job->status != STS_COMPLETED) {
+                                printf("Pool job %u status %d\n", idx,
+                                       (int) job->status);
+                                return 1;
+                        }
+                        seen[idx] = 1;
+                        completed++;
+                        last_progress = time(NULL);
+                }
+
+                if (completed < POOL_NUM_JOBS &&
+                    difftime(time(NULL), last_progress) > POOL_TIMEOUT_SEC) {
+                        printf("Pool timed out, %u of %u jobs not "
+                               "completed (%u not submitted)\n",
+                               POOL_NUM_JOBS - completed, POOL_NUM_JOBS,
+                               POOL_NUM_JOBS - submitted);
+                        return 1;
+                }
+        }
+
+        for (i = 0; i < POOL_NUM_JOBS; i++) {
+                if (memcmp(data->dst[i], data->ref_dst[i],
+                           (size_t) pool_job_len(i)) != 0) {
+                        printf("Pool job %u ciphertext mismatch\n", i);
+                        return 1;
+                }
+                if (memcmp(data->tag[i], data->ref_tag[i],
+                           POOL_TAG_LEN) != 0) {
+                        printf("Pool job %u tag mismatch\n", i);
+                        return 1;
+                }
+        }
+
+        return 0;
+}
+
+int
+pool_test(const enum arch_type arch, struct IMB_MGR *mb_mgr)
+{
+        struct pool_test_data *data;
+        init_mb_mgr_t init_mgr;
+        uint64_t flags = mb_mgr->flags;
+        IMB_POOL *pool;
+        int errors = 0;
+        unsigned i;
+
+        printf("Worker pool test:\n");
+
+        switch (arch) {
+        case ARCH_AVX:
+                init_mgr = init_mb_mgr_avx;
+                break;
+        case ARCH_AVX2:
+                init_mgr = init_mb_mgr_avx2;
+                break;
+        case ARCH_AVX512:
+                init_mgr = init_mb_mgr_avx512;
+                break;
+        case ARCH_NO_AESNI:
+                flags |= IMB_FLAG_AESNI_OFF;
+                init_mgr = init_mb_mgr_sse;
+                break;
+        default:
+                init_mgr = init_mb_mgr_sse;
+                break;
+        }
+
+        data = malloc(sizeof(*data));
+        if (data == NULL) {
+                printf("Could not allocate memory\n");
+                return 1;
+        }
+        pool_prepare_keys(mb_mgr, data);
+        for (i = 0; i < POOL_NUM_JOBS; i++)
+                pool_generate_random(data->src[i], POOL_MAX_LEN);
+
+        if (pool_reference(mb_mgr, data) != 0) {
+                printf("Reference job failed\n");
+                free(data);
+                return 1;
+        }
+
+        pool = imb_pool_alloc(POOL_NUM_WORKERS, flags, init_mgr,
+                              POOL_QUEUE_SIZE);
+        if (pool == NULL) {
+                printf("Could not allocate worker pool\n");
+                free(data);
+                return 1;
+        }
+
+        /* jobs spread over all workers */
+        errors += pool_run(pool, data, POOL_NUM_WORKERS * 2);
+        printf(".");
+        /* single flow, other workers can only steal */
+        errors += pool_run(pool, data, 1);
+        printf(".");
+
+        imb_pool_free(pool);
+        free(data);
+
+        if (0 == errors)
+                printf("...Pass\n");
+        else
+                printf("...Fail\n");
+
+        return errors;
+}
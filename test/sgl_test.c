@@ -0,0 +1,558 @@
+/*****************************************************************************
+ Copyright (c) 2020, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "utils.h"
+
+#define SGL_MAX_LEN    1100
+#define SGL_MAX_SEGS   (SGL_MAX_LEN + 2)
+#define SGL_PAD        0xA5
+#define SGL_AAD_LEN    20
+#define SGL_NONCE_LEN  13
+#define SGL_BURST_JOBS 20 /* more than lanes of the out-of-order managers */
+
+int sgl_test(struct IMB_MGR *mb_mgr);
+
+struct sgl_test_cfg {
+        JOB_CIPHER_MODE cipher_mode;
+        JOB_HASH_ALG hash_alg;
+        uint64_t key_len;
+        uint64_t iv_len;
+        uint64_t tag_len;
+        const char *name;
+};
+
+static const struct sgl_test_cfg sgl_cfgs[] = {
+        { IMB_CIPHER_GCM, IMB_AUTH_AES_GMAC, 16, 12, 16, "AES-GCM-128" },
+        { IMB_CIPHER_GCM, IMB_AUTH_AES_GMAC, 24, 12, 12, "AES-GCM-192" },
+        { IMB_CIPHER_GCM, IMB_AUTH_AES_GMAC, 32, 12, 16, "AES-GCM-256" },
+        { IMB_CIPHER_CCM, IMB_AUTH_AES_CCM, 16, SGL_NONCE_LEN, 16,
+          "AES-CCM-128" },
+        { IMB_CIPHER_CCM, IMB_AUTH_AES_CCM, 32, SGL_NONCE_LEN, 8,
+          "AES-CCM-256" },
+        { IMB_CIPHER_CBC, IMB_AUTH_NULL, 16, 16, 0, "AES-CBC-128" },
+        { IMB_CIPHER_CBC, IMB_AUTH_HMAC_SHA_1, 16, 16, 12,
+          "AES-CBC-128 + HMAC-SHA1" },
+        { IMB_CIPHER_CBC, IMB_AUTH_HMAC_SHA_256, 32, 16, 16,
+          "AES-CBC-256 + HMAC-SHA256" },
+        { IMB_CIPHER_CBC, IMB_AUTH_HMAC_SHA_512, 24, 16, 32,
+          "AES-CBC-192 + HMAC-SHA512" },
+        { IMB_CIPHER_CNTR, IMB_AUTH_NULL, 24, 16, 0, "AES-CTR-192" },
+        { IMB_CIPHER_CNTR, IMB_AUTH_HMAC_SHA_224, 16, 12, 14,
+          "AES-CTR-128 + HMAC-SHA224" },
+        { IMB_CIPHER_CNTR, IMB_AUTH_HMAC_SHA_384, 32, 16, 24,
+          "AES-CTR-256 + HMAC-SHA384" },
+};
+
+static const uint64_t sgl_msg_lens[] = {
+        1, 15, 16, 17, 63, 64, 65, 129, 250, 512, 1025
+};
+
+/* 0 - single segment holding whole message */
+static const uint64_t sgl_seg_sizes[] = { 0, 1, 7, 16, 33, 100 };
+
+struct sgl_test_keys {
+        DECLARE_ALIGNED(uint32_t enc_keys[15 * 4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15 * 4], 16);
+        DECLARE_ALIGNED(struct gcm_key_data gcm_key, 64);
+        DECLARE_ALIGNED(uint8_t ipad_hash[SHA512_DIGEST_SIZE_IN_BYTES], 16);
+        DECLARE_ALIGNED(uint8_t opad_hash[SHA512_DIGEST_SIZE_IN_BYTES], 16);
+        uint8_t iv[16];
+        uint8_t aad[SGL_AAD_LEN];
+};
+
+static void
+sgl_generate_random(uint8_t *buf, const uint64_t len)
+{
+        uint64_t i;
+
+        for (i = 0; i < len; i++)
+                buf[i] = (uint8_t) rand();
+}
+
+static void
+sgl_hmac_pad_hash(struct IMB_MGR *mb_mgr, const JOB_HASH_ALG hash_alg,
+                  const uint8_t *key, const uint8_t pad, uint8_t *hash)
+{
+        uint8_t buf[SHA_512_BLOCK_SIZE];
+        unsigned i;
+
+        memset(buf, pad, sizeof(buf));
+        for (i = 0; i < 16; i++)
+                buf[i] ^= key[i];
+
+        switch (hash_alg) {
+        case IMB_AUTH_HMAC_SHA_1:
+                IMB_SHA1_ONE_BLOCK(mb_mgr, buf, hash);
+                break;
+        case IMB_AUTH_HMAC_SHA_224:
+                IMB_SHA224_ONE_BLOCK(mb_mgr, buf, hash);
+                break;
+        case IMB_AUTH_HMAC_SHA_256:
+                IMB_SHA256_ONE_BLOCK(mb_mgr, buf, hash);
+                break;
+        case IMB_AUTH_HMAC_SHA_384:
+                IMB_SHA384_ONE_BLOCK(mb_mgr, buf, hash);
+                break;
+        default:
+                IMB_SHA512_ONE_BLOCK(mb_mgr, buf, hash);
+                break;
+        }
+}
+
+static void
+sgl_prepare_keys(struct IMB_MGR *mb_mgr, const struct sgl_test_cfg *cfg,
+                 struct sgl_test_keys *keys)
+{
+        uint8_t key[32];
+        uint8_t hmac_key[16];
+
+        sgl_generate_random(key, sizeof(key));
+        sgl_generate_random(hmac_key, sizeof(hmac_key));
+        sgl_generate_random(keys->iv, sizeof(keys->iv));
+        sgl_generate_random(keys->aad, sizeof(keys->aad));
+
+        if (cfg->cipher_mode == IMB_CIPHER_GCM) {
+                if (cfg->key_len == 16)
+                        IMB_AES128_GCM_PRE(mb_mgr, key, &keys->gcm_key);
+                else if (cfg->key_len == 24)
+                        IMB_AES192_GCM_PRE(mb_mgr, key, &keys->gcm_key);
+                else
+                        IMB_AES256_GCM_PRE(mb_mgr, key, &keys->gcm_key);
+                return;
+        }
+
+        if (cfg->key_len == 16)
+                IMB_AES_KEYEXP_128(mb_mgr, key, keys->enc_keys,
+                                   keys->dec_keys);
+        else if (cfg->key_len == 24)
+                IMB_AES_KEYEXP_192(mb_mgr, key, keys->enc_keys,
+                                   keys->dec_keys);
+        else
+                IMB_AES_KEYEXP_256(mb_mgr, key, keys->enc_keys,
+                                   keys->dec_keys);
+
+        if (cfg->hash_alg != IMB_AUTH_NULL) {
+                sgl_hmac_pad_hash(mb_mgr, cfg->hash_alg, hmac_key, 0x36,
+                                  keys->ipad_hash);
+                sgl_hmac_pad_hash(mb_mgr, cfg->hash_alg, hmac_key, 0x5c,
+                                  keys->opad_hash);
+        }
+}
+
+/*
+ * Fills job fields common to the contiguous and SGL jobs.
+ * Cipher/hash regions are relative to the start of the message.
+ *
+ * @return 0 - job prepared, 1 - message length not applicable
+ */
+static int
+sgl_fill_job(IMB_JOB *job, const struct sgl_test_cfg *cfg,
+             const struct sgl_test_keys *keys, const uint64_t len,
+             const JOB_CIPHER_DIRECTION dir, uint8_t *tag)
+{
+        uint64_t cipher_offset = 0;
+        uint64_t cipher_len = len;
+
+        /* cipher+hash: header before cipher text is authenticated only */
+        if (cfg->hash_alg != IMB_AUTH_NULL && len > 32)
+                cipher_offset = 16;
+        cipher_len = len - cipher_offset;
+        if (cfg->cipher_mode == IMB_CIPHER_CBC)
+                cipher_len &= ~UINT64_C(15);
+        if (cipher_len == 0)
+                return 1;
+
+        job->cipher_mode = cfg->cipher_mode;
+        job->hash_alg = cfg->hash_alg;
+        job->cipher_direction = dir;
+        job->chain_order = (dir == IMB_DIR_ENCRYPT) ?
+                IMB_ORDER_CIPHER_HASH : IMB_ORDER_HASH_CIPHER;
+        job->key_len_in_bytes = cfg->key_len;
+        job->iv = keys->iv;
+        job->iv_len_in_bytes = cfg->iv_len;
+        job->cipher_start_src_offset_in_bytes = cipher_offset;
+        job->msg_len_to_cipher_in_bytes = cipher_len;
+        job->hash_start_src_offset_in_bytes = cipher_offset;
+        job->msg_len_to_hash_in_bytes = cipher_len;
+        job->auth_tag_output = tag;
+        job->auth_tag_output_len_in_bytes = cfg->tag_len;
+
+        switch (cfg->cipher_mode) {
+        case IMB_CIPHER_GCM:
+                job->enc_keys = &keys->gcm_key;
+                job->dec_keys = &keys->gcm_key;
+                job->u.GCM.aad = keys->aad;
+                job->u.GCM.aad_len_in_bytes = SGL_AAD_LEN;
+                break;
+        case IMB_CIPHER_CCM:
+                job->enc_keys = keys->enc_keys;
+                job->dec_keys = keys->enc_keys;
+                job->u.CCM.aad = keys->aad;
+                job->u.CCM.aad_len_in_bytes = SGL_AAD_LEN;
+                break;
+        default:
+                job->enc_keys = keys->enc_keys;
+                job->dec_keys = keys->dec_keys;
+                job->hash_start_src_offset_in_bytes = 0;
+                job->msg_len_to_hash_in_bytes = cipher_offset + cipher_len;
+                job->u.HMAC._hashed_auth_key_xor_ipad = keys->ipad_hash;
+                job->u.HMAC._hashed_auth_key_xor_opad = keys->opad_hash;
+                break;
+        }
+        return 0;
+}
+
+static IMB_JOB *
+sgl_submit_and_flush(struct IMB_MGR *mb_mgr)
+{
+        IMB_JOB *job, *ret = NULL;
+
+        job = IMB_SUBMIT_JOB(mb_mgr);
+        if (job != NULL)
+                ret = job;
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ret = job;
+        return ret;
+}
+
+/*
+ * Splits a message into segments of seg_size bytes (0 - one segment),
+ * with an empty segment first.
+ *
+ * @return number of segments
+ */
+static uint64_t
+sgl_build_segs(struct IMB_SGL_IOV *segs, uint8_t *in, uint8_t *out,
+               const uint64_t len, const uint64_t seg_size)
+{
+        uint64_t num_segs = 0, offset = 0;
+
+        segs[num_segs].in = in;
+        segs[num_segs].out = out;
+        segs[num_segs++].len = 0;
+        while (offset < len) {
+                uint64_t seg_len = (seg_size == 0) ? len : seg_size;
+
+                if (seg_len > len - offset)
+                        seg_len = len - offset;
+                segs[num_segs].in = in + offset;
+                segs[num_segs].out = out + offset;
+                segs[num_segs++].len = seg_len;
+                offset += seg_len;
+        }
+        return num_segs;
+}
+
+/*
+ * Runs the same operation on a contiguous buffer and
+ * on a segmented one and compares output and tags.
+ */
+static int
+test_sgl(struct IMB_MGR *mb_mgr, const struct sgl_test_cfg *cfg,
+         const struct sgl_test_keys *keys, const uint8_t *msg,
+         const uint64_t len, const JOB_CIPHER_DIRECTION dir,
+         const uint64_t seg_size, const int in_place)
+{
+        static uint8_t ref_out[SGL_MAX_LEN];
+        static uint8_t sgl_in[SGL_MAX_LEN];
+        static uint8_t sgl_out[SGL_MAX_LEN];
+        static struct IMB_SGL_IOV segs[SGL_MAX_SEGS];
+        uint8_t ref_tag[SHA512_DIGEST_SIZE_IN_BYTES];
+        uint8_t sgl_tag[SHA512_DIGEST_SIZE_IN_BYTES];
+        uint8_t *out = in_place ? sgl_in : sgl_out;
+        uint64_t num_segs, start;
+        IMB_JOB *job;
+
+        /* contiguous job */
+        memset(ref_out, SGL_PAD, sizeof(ref_out));
+        job = IMB_GET_NEXT_JOB(mb_mgr);
+        memset(job, 0, sizeof(*job));
+        if (sgl_fill_job(job, cfg, keys, len, dir, ref_tag))
+                return 0;
+        start = job->cipher_start_src_offset_in_bytes;
+        job->src = msg;
+        job->dst = ref_out + start;
+        job = sgl_submit_and_flush(mb_mgr);
+        if (job == NULL || job->status != STS_COMPLETED) {
+                printf("%s: contiguous job failed\n", cfg->name);
+                return 1;
+        }
+
+        /* SGL job, empty segment first */
+        memcpy(sgl_in, msg, len);
+        memset(sgl_out, SGL_PAD, sizeof(sgl_out));
+        num_segs = sgl_build_segs(segs, sgl_in, out, len, seg_size);
+
+        job = IMB_GET_NEXT_JOB(mb_mgr);
+        memset(job, 0, sizeof(*job));
+        (void) sgl_fill_job(job, cfg, keys, len, dir, sgl_tag);
+        job->sgl_io_segs = segs;
+        job->num_sgl_io_segs = num_segs;
+        job = sgl_submit_and_flush(mb_mgr);
+        if (job == NULL || job->status != STS_COMPLETED) {
+                printf("%s: SGL job failed, status %d\n", cfg->name,
+                       job == NULL ? -1 : (int) job->status);
+                return 1;
+        }
+
+        if (memcmp(out + start, ref_out + start, len - start)) {
+                printf("%s: SGL output mismatch\n", cfg->name);
+                hexdump(stdout, "Expected", ref_out + start, len - start);
+                hexdump(stdout, "Received", out + start, len - start);
+                return 1;
+        }
+        if (cfg->tag_len != 0 && memcmp(sgl_tag, ref_tag, cfg->tag_len)) {
+                printf("%s: SGL tag mismatch\n", cfg->name);
+                hexdump(stdout, "Expected", ref_tag, cfg->tag_len);
+                hexdump(stdout, "Received", sgl_tag, cfg->tag_len);
+                return 1;
+        }
+        return 0;
+}
+
+/*
+ * Submits a burst of SGL jobs of different lengths and segment sizes,
+ * so that several jobs are in the lanes at the same time and complete
+ * out of order, and compares them with contiguous jobs.
+ */
+static int
+test_sgl_burst(struct IMB_MGR *mb_mgr, const struct sgl_test_cfg *cfg,
+               const struct sgl_test_keys *keys, const uint8_t *msg,
+               const JOB_CIPHER_DIRECTION dir)
+{
+        static uint8_t ref_out[SGL_BURST_JOBS][SGL_MAX_LEN];
+        static uint8_t sgl_in[SGL_BURST_JOBS][SGL_MAX_LEN];
+        static uint8_t sgl_out[SGL_BURST_JOBS][SGL_MAX_LEN];
+        static struct IMB_SGL_IOV segs[SGL_BURST_JOBS][SGL_MAX_SEGS];
+        uint8_t ref_tag[SGL_BURST_JOBS][SHA512_DIGEST_SIZE_IN_BYTES];
+        uint8_t sgl_tag[SGL_BURST_JOBS][SHA512_DIGEST_SIZE_IN_BYTES];
+        uint64_t start[SGL_BURST_JOBS];
+        int skip[SGL_BURST_JOBS];
+        unsigned i, completed = 0, expected = 0;
+        int errors = 0;
+        IMB_JOB *job;
+
+        /* contiguous jobs */
+        for (i = 0; i < SGL_BURST_JOBS; i++) {
+                const uint64_t len = sgl_msg_lens[i % DIM(sgl_msg_lens)];
+
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                memset(job, 0, sizeof(*job));
+                skip[i] = sgl_fill_job(job, cfg, keys, len, dir, ref_tag[i]);
+                if (skip[i])
+                        continue;
+                start[i] = job->cipher_start_src_offset_in_bytes;
+                job->src = msg;
+                job->dst = ref_out[i] + start[i];
+                job = sgl_submit_and_flush(mb_mgr);
+                if (job == NULL || job->status != STS_COMPLETED) {
+                        printf("%s: contiguous job failed\n", cfg->name);
+                        return 1;
+                }
+        }
+
+        /* SGL jobs, in place for odd ones */
+        for (i = 0; i < SGL_BURST_JOBS; i++) {
+                const uint64_t len = sgl_msg_lens[i % DIM(sgl_msg_lens)];
+                const uint64_t seg_size =
+                        sgl_seg_sizes[i % DIM(sgl_seg_sizes)];
+                uint8_t *out = (i & 1) ? sgl_in[i] : sgl_out[i];
+
+                if (skip[i])
+                        continue;
+                memcpy(sgl_in[i], msg, len);
+                memset(sgl_out[i], SGL_PAD, sizeof(sgl_out[i]));
+
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                memset(job, 0, sizeof(*job));
+                (void) sgl_fill_job(job, cfg, keys, len, dir, sgl_tag[i]);
+                job->sgl_io_segs = segs[i];
+                job->num_sgl_io_segs = sgl_build_segs(segs[i], sgl_in[i],
+                                                      out, len, seg_size);
+                expected++;
+
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                while (job != NULL) {
+                        if (job->status != STS_COMPLETED)
+                                errors++;
+                        completed++;
+                        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+                }
+        }
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                if (job->status != STS_COMPLETED)
+                        errors++;
+                completed++;
+        }
+        if (errors != 0 || completed != expected) {
+                printf("%s: SGL burst failed, %u of %u jobs completed\n",
+                       cfg->name, completed, expected);
+                return 1;
+        }
+
+        for (i = 0; i < SGL_BURST_JOBS; i++) {
+                const uint64_t len = sgl_msg_lens[i % DIM(sgl_msg_lens)];
+                const uint8_t *out = (i & 1) ? sgl_in[i] : sgl_out[i];
+
+                if (skip[i])
+                        continue;
+                if (memcmp(out + start[i], ref_out[i] + start[i],
+                           len - start[i])) {
+                        printf("%s: SGL burst output mismatch, job %u\n",
+                               cfg->name, i);
+                        errors++;
+                }
+                if (cfg->tag_len != 0 &&
+                    memcmp(sgl_tag[i], ref_tag[i], cfg->tag_len)) {
+                        printf("%s: SGL burst tag mismatch, job %u\n",
+                               cfg->name, i);
+                        errors++;
+                }
+        }
+        return errors;
+}
+
+static int
+test_sgl_invalid_job(struct IMB_MGR *mb_mgr, const struct IMB_SGL_IOV *segs,
+                     const uint64_t num_segs,
+                     const JOB_CIPHER_MODE cipher_mode, const uint64_t len)
+{
+        DECLARE_ALIGNED(uint32_t keys[15 * 4], 16);
+        uint8_t iv[16];
+        uint8_t tag[16];
+        IMB_JOB *job;
+
+        memset(keys, 0, sizeof(keys));
+        memset(iv, 0, sizeof(iv));
+
+        job = IMB_GET_NEXT_JOB(mb_mgr);
+        memset(job, 0, sizeof(*job));
+        job->cipher_mode = cipher_mode;
+        job->hash_alg = IMB_AUTH_NULL;
+        job->chain_order = IMB_ORDER_CIPHER_HASH;
+        job->cipher_direction = IMB_DIR_ENCRYPT;
+        job->enc_keys = keys;
+        job->dec_keys = keys;
+        job->key_len_in_bytes = 16;
+        job->iv = iv;
+        job->iv_len_in_bytes = 16;
+        job->msg_len_to_cipher_in_bytes = len;
+        job->auth_tag_output = tag;
+        job->sgl_io_segs = segs;
+        job->num_sgl_io_segs = num_segs;
+
+        job = sgl_submit_and_flush(mb_mgr);
+        return job == NULL || job->status != STS_INVALID_ARGS;
+}
+
+static int
+test_sgl_invalid(struct IMB_MGR *mb_mgr)
+{
+        static uint8_t buf[64];
+        const struct IMB_SGL_IOV segs[2] = {
+                { buf, buf, 32 }, { NULL, NULL, 32 }
+        };
+        int errors = 0;
+
+        if (test_sgl_invalid_job(mb_mgr, NULL, 1, IMB_CIPHER_CNTR, 32)) {
+                printf("SGL: NULL segment list accepted\n");
+                errors++;
+        }
+        if (test_sgl_invalid_job(mb_mgr, segs, 1, IMB_CIPHER_CNTR, 33)) {
+                printf("SGL: message longer than segments accepted\n");
+                errors++;
+        }
+        if (test_sgl_invalid_job(mb_mgr, segs, 2, IMB_CIPHER_CNTR, 64)) {
+                printf("SGL: NULL segment buffer accepted\n");
+                errors++;
+        }
+        if (test_sgl_invalid_job(mb_mgr, segs, 1, IMB_CIPHER_ECB, 32)) {
+                printf("SGL: unsupported cipher mode accepted\n");
+                errors++;
+        }
+        return errors;
+}
+
+int
+sgl_test(struct IMB_MGR *mb_mgr)
+{
+        static uint8_t msg[SGL_MAX_LEN];
+        struct sgl_test_keys keys;
+        unsigned c, l, s;
+        int errors = 0;
+
+        printf("Scatter-gather list test:\n");
+
+        for (c = 0; c < DIM(sgl_cfgs); c++) {
+                const struct sgl_test_cfg *cfg = &sgl_cfgs[c];
+
+                sgl_prepare_keys(mb_mgr, cfg, &keys);
+                for (l = 0; l < DIM(sgl_msg_lens); l++) {
+                        const uint64_t len = sgl_msg_lens[l];
+
+                        sgl_generate_random(msg, len);
+                        for (s = 0; s < DIM(sgl_seg_sizes); s++) {
+                                const uint64_t seg = sgl_seg_sizes[s];
+
+                                errors += test_sgl(mb_mgr, cfg, &keys, msg,
+                                                   len, IMB_DIR_ENCRYPT,
+                                                   seg, 0);
+                                errors += test_sgl(mb_mgr, cfg, &keys, msg,
+                                                   len, IMB_DIR_DECRYPT,
+                                                   seg, 0);
+                                errors += test_sgl(mb_mgr, cfg, &keys, msg,
+                                                   len, IMB_DIR_ENCRYPT,
+                                                   seg, 1);
+                                errors += test_sgl(mb_mgr, cfg, &keys, msg,
+                                                   len, IMB_DIR_DECRYPT,
+                                                   seg, 1);
+                        }
+                }
+                sgl_generate_random(msg, SGL_MAX_LEN);
+                errors += test_sgl_burst(mb_mgr, cfg, &keys, msg,
+                                         IMB_DIR_ENCRYPT);
+                errors += test_sgl_burst(mb_mgr, cfg, &keys, msg,
+                                         IMB_DIR_DECRYPT);
+                printf(".");
+        }
+
+        errors += test_sgl_invalid(mb_mgr);
+
+        if (0 == errors)
+                printf("...Pass\n");
+        else
+                printf("...Fail\n");
+
+        return errors;
+}
@@ -62,6 +62,8 @@ int validate_snow3g_f8_n_blocks_multi(struct IMB_MGR *mb_mgr,
 static
 int validate_snow3g_f9(struct IMB_MGR *mb_mgr, uint32_t job_api);
 static
+int validate_snow3g_f8_f9(struct IMB_MGR *mb_mgr, uint32_t job_api);
+static
 int membitcmp(const uint8_t *input, const uint8_t *output,
               const uint32_t bitlength, const uint32_t offset);
 
@@ -87,7 +89,9 @@ struct {
         {validate_snow3g_f8_n_blocks_multi,
          "validate_snow3g_f8_n_blocks_multi"},
         {validate_snow3g_f9,
-         "validate_snow3g_f9"}
+         "validate_snow3g_f9"},
+        {validate_snow3g_f8_f9,
+         "validate_snow3g_f8_f9"}
 };
 
 /******************************************************************************
@@ -2197,6 +2201,205 @@ snow3g_f9_1_buffer_exit:
         return ret;
 }
 
+static inline int
+submit_uea2_uia2_job(struct IMB_MGR *mb_mgr, uint8_t *cipher_key,
+                     uint8_t *cipher_iv, uint8_t *auth_key, uint8_t *auth_iv,
+                     uint8_t *src, uint8_t *dst, uint8_t *tag,
+                     const uint32_t cipher_offset,
+                     const uint32_t cipher_bitlen, const uint32_t auth_bitlen,
+                     const JOB_CHAIN_ORDER order)
+{
+        IMB_JOB *job;
+
+        job = IMB_GET_NEXT_JOB(mb_mgr);
+        job->cipher_direction = IMB_DIR_ENCRYPT;
+        job->chain_order = order;
+        job->cipher_mode = IMB_CIPHER_SNOW3G_UEA2_BITLEN;
+        job->src = src;
+        job->dst = dst;
+        job->iv = cipher_iv;
+        job->iv_len_in_bytes = 16;
+        job->enc_keys = cipher_key;
+        job->key_len_in_bytes = 16;
+        job->cipher_start_src_offset_in_bits = cipher_offset * 8;
+        job->msg_len_to_cipher_in_bits = cipher_bitlen;
+
+        job->hash_alg = IMB_AUTH_SNOW3G_UIA2_BITLEN;
+        job->u.SNOW3G_UIA2._iv = auth_iv;
+        job->u.SNOW3G_UIA2._key = auth_key;
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bits = auth_bitlen;
+        job->auth_tag_output = tag;
+        job->auth_tag_output_len_in_bytes = 4;
+
+        job = IMB_SUBMIT_JOB(mb_mgr);
+        if (job != NULL) {
+                if (job->status != STS_COMPLETED) {
+                        printf("%d error status:%d",
+                               __LINE__, job->status);
+                        return -1;
+                }
+        } else {
+                printf("Expected returned job, but got nothing\n");
+                return -1;
+        }
+
+        return 0;
+}
+
+/*
+ * Cipher and authenticate in a single job (UEA2 + UIA2 chained),
+ * checking the result against the F8 and F9 single buffer APIs.
+ * The first hdrLen bytes (e.g. PDCP header) are authenticated only.
+ */
+static int validate_snow3g_f8_f9(struct IMB_MGR *mb_mgr, uint32_t job_api)
+{
+        int numVectors, i, inputLen;
+        unsigned h;
+        size_t size = 0;
+        /* header lengths in bytes, aligned and not aligned to F9 blocks */
+        const uint32_t hdrLens[] = { 0, 1, 3, 8, 13 };
+        hash_test_vector_t *testVectors = snow3g_hash_test_vectors[2];
+        /* snow3g f9 test vectors are located at index 2 */
+        numVectors = numSnow3gHashTestVectors[2];
+
+        snow3g_key_schedule_t *pKeySched = NULL;
+        snow3g_key_schedule_t *pCipherKeySched = NULL;
+        uint8_t cipherKey[MAX_KEY_LEN];
+        uint8_t cipherIV[SNOW3G_IV_LEN_IN_BYTES];
+        uint8_t srcBuff[MAX_DATA_LEN];
+        uint8_t dstBuff[MAX_DATA_LEN];
+        uint8_t refBuff[MAX_DATA_LEN];
+        uint8_t digest[DIGEST_LEN];
+        uint8_t refDigest[DIGEST_LEN];
+        int ret = 1;
+
+        /* stitched cipher + hash is only available through the job API */
+        if (!job_api)
+                return 0;
+
+        printf("Testing SNOW3G UEA2 + UIA2 chained: (Job API):\n");
+
+        if (!numVectors) {
+                printf("No Snow3G test vectors found !\n");
+                return ret;
+        }
+
+        size = IMB_SNOW3G_KEY_SCHED_SIZE(mb_mgr);
+        if (!size)
+                return ret;
+
+        pKeySched = malloc(size);
+        pCipherKeySched = malloc(size);
+        if (!pKeySched || !pCipherKeySched) {
+                printf("malloc(IMB_SNOW3G_KEY_SCHED_SIZE(mb_mgr)): "
+                       "failed !\n");
+                goto snow3g_f8_f9_exit;
+        }
+
+        for (i = 0; i < (int) sizeof(cipherKey); i++)
+                cipherKey[i] = (uint8_t) (i * 7 + 1);
+        for (i = 0; i < (int) sizeof(cipherIV); i++)
+                cipherIV[i] = (uint8_t) (0xA5 ^ i);
+
+        if (IMB_SNOW3G_INIT_KEY_SCHED(mb_mgr, cipherKey, pCipherKeySched)) {
+                printf("IMB_SNOW3G_INIT_KEY_SCHED() error\n");
+                goto snow3g_f8_f9_exit;
+        }
+
+        for (i = 0; i < numVectors; i++) {
+                const uint32_t authLen = testVectors[i].lengthInBits;
+
+                inputLen = (authLen + 7) / 8;
+
+                if (IMB_SNOW3G_INIT_KEY_SCHED(mb_mgr, testVectors[i].key,
+                                              pKeySched)) {
+                        printf("IMB_SNOW3G_INIT_KEY_SCHED() error\n");
+                        goto snow3g_f8_f9_exit;
+                }
+
+                for (h = 0; h < DIM(hdrLens); h++) {
+                        const uint32_t hdrLen = hdrLens[h];
+                        const uint32_t cipherLen = inputLen - hdrLen;
+
+                        /* header must be authenticated, cipher non-empty */
+                        if ((hdrLen * 8) > authLen ||
+                            (int) hdrLen >= inputLen)
+                                continue;
+
+                        /* Hash (plaintext) then cipher, out-of-place */
+                        memcpy(srcBuff, testVectors[i].input, inputLen);
+                        IMB_SNOW3G_F8_1_BUFFER(mb_mgr, pCipherKeySched,
+                                               cipherIV, &srcBuff[hdrLen],
+                                               &refBuff[hdrLen], cipherLen);
+                        if (submit_uea2_uia2_job(mb_mgr,
+                                                 (uint8_t *)pCipherKeySched,
+                                                 cipherIV,
+                                                 (uint8_t *)pKeySched,
+                                                 testVectors[i].iv,
+                                                 srcBuff, dstBuff, digest,
+                                                 hdrLen, cipherLen * 8,
+                                                 authLen,
+                                                 IMB_ORDER_HASH_CIPHER))
+                                goto snow3g_f8_f9_exit;
+
+                        if (memcmp(&dstBuff[hdrLen], &refBuff[hdrLen],
+                                   cipherLen) != 0 ||
+                            memcmp(digest, testVectors[i].exp_out,
+                                   DIGEST_LEN) != 0) {
+                                printf("SNOW3G UEA2 + UIA2 hash-cipher "
+                                       "vector num:%d header:%u\n",
+                                       i, hdrLen);
+                                snow3g_hexdump("Actual:", digest,
+                                               DIGEST_LEN);
+                                snow3g_hexdump("Expected:",
+                                               testVectors[i].exp_out,
+                                               DIGEST_LEN);
+                                goto snow3g_f8_f9_exit;
+                        }
+
+                        /* Cipher then hash (ciphertext), in-place */
+                        memcpy(refBuff, srcBuff, hdrLen);
+                        IMB_SNOW3G_F9_1_BUFFER(mb_mgr, pKeySched,
+                                               testVectors[i].iv, refBuff,
+                                               authLen, refDigest);
+                        memcpy(dstBuff, srcBuff, inputLen);
+                        if (submit_uea2_uia2_job(mb_mgr,
+                                                 (uint8_t *)pCipherKeySched,
+                                                 cipherIV,
+                                                 (uint8_t *)pKeySched,
+                                                 testVectors[i].iv,
+                                                 dstBuff, dstBuff, digest,
+                                                 hdrLen, cipherLen * 8,
+                                                 authLen,
+                                                 IMB_ORDER_CIPHER_HASH))
+                                goto snow3g_f8_f9_exit;
+
+                        if (memcmp(dstBuff, refBuff, inputLen) != 0 ||
+                            memcmp(digest, refDigest, DIGEST_LEN) != 0) {
+                                printf("SNOW3G UEA2 + UIA2 cipher-hash "
+                                       "vector num:%d header:%u\n",
+                                       i, hdrLen);
+                                snow3g_hexdump("Actual:", digest,
+                                               DIGEST_LEN);
+                                snow3g_hexdump("Expected:", refDigest,
+                                               DIGEST_LEN);
+                                goto snow3g_f8_f9_exit;
+                        }
+                }
+                printf(".");
+        }
+        /* no errors detected */
+        ret = 0;
+
+snow3g_f8_f9_exit:
+        free(pKeySched);
+        free(pCipherKeySched);
+        printf("\n");
+
+        return ret;
+}
+
 static int validate_f8_iv_gen(void)
 {
         uint32_t i;
@@ -63,7 +63,7 @@ XVALID_LFLAGS = /out:$(XVALID_APP).exe $(DLFLAGS)
 AS = nasm
 AFLAGS = -fwin64 -Xvc -DWIN_ABI
 
-TEST_OBJS = main.obj gcm_test.obj ctr_test.obj customop_test.obj des_test.obj ccm_test.obj cmac_test.obj hmac_sha1_test.obj hmac_sha256_sha512_test.obj utils.obj hmac_md5_test.obj aes_test.obj sha_test.obj chained_test.obj api_test.obj pon_test.obj ecb_test.obj zuc_test.obj kasumi_test.obj snow3g_test.obj direct_api_test.obj clear_mem_test.obj hec_test.obj
+TEST_OBJS = main.obj gcm_test.obj ctr_test.obj customop_test.obj des_test.obj ccm_test.obj cmac_test.obj hmac_sha1_test.obj hmac_sha256_sha512_test.obj utils.obj hmac_md5_test.obj aes_test.obj sha_test.obj chained_test.obj api_test.obj pon_test.obj ecb_test.obj zuc_test.obj kasumi_test.obj snow3g_test.obj direct_api_test.obj clear_mem_test.obj hec_test.obj cfb_test.obj xts_test.obj sgl_test.obj crc_test.obj pool_test.obj completion_cb_test.obj
 
 XVALID_OBJS = ipsec_xvalid.obj misc.obj
 
@@ -117,6 +117,24 @@ aes_test.obj: aes_test.c utils.h
 ecb_test.obj: ecb_test.c utils.h
         $(CC) /c $(CFLAGS) ecb_test.c
 
+cfb_test.obj: cfb_test.c utils.h
+        $(CC) /c $(CFLAGS) cfb_test.c
+
+xts_test.obj: xts_test.c utils.h
+        $(CC) /c $(CFLAGS) xts_test.c
+
+sgl_test.obj: sgl_test.c utils.h
+        $(CC) /c $(CFLAGS) sgl_test.c
+
+crc_test.obj: crc_test.c
+        $(CC) /c $(CFLAGS) crc_test.c
+
+pool_test.obj: pool_test.c gcm_ctr_vectors_test.h utils.h
+        $(CC) /c $(CFLAGS) pool_test.c
+
+completion_cb_test.obj: completion_cb_test.c gcm_ctr_vectors_test.h utils.h
+        $(CC) /c $(CFLAGS) completion_cb_test.c
+
 utils.obj: utils.c
         $(CC) /c $(CFLAGS) utils.c
 
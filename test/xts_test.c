@@ -0,0 +1,781 @@
+/*****************************************************************************
+ Copyright (c) 2020, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "utils.h"
+
+int xts_test(struct IMB_MGR *mb_mgr);
+
+struct xts_vector {
+	const uint8_t *K;          /* key1 || key2 */
+	const uint8_t *T;          /* tweak (data unit sequence number) */
+	const uint8_t *P;          /* plain text */
+	const uint8_t *C;          /* cipher text - same length as plain text */
+	uint64_t       Klen;       /* key length (key1 only) */
+	uint64_t       Plen;       /* text length */
+};
+
+/*
+ * IEEE 1619-2007 XTS-AES-128 Vector 1
+ */
+static const uint8_t K1[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t T1[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t P1[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t C1[] = {
+        0x91, 0x7c, 0xf6, 0x9e, 0xbd, 0x68, 0xb2, 0xec,
+        0x9b, 0x9f, 0xe9, 0xa3, 0xea, 0xdd, 0xa6, 0x92,
+        0xcd, 0x43, 0xd2, 0xf5, 0x95, 0x98, 0xed, 0x85,
+        0x8c, 0x02, 0xc2, 0x65, 0x2f, 0xbf, 0x92, 0x2e
+};
+
+/*
+ * IEEE 1619-2007 XTS-AES-128 Vector 2
+ */
+static const uint8_t K2[] = {
+        0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+        0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22
+};
+static const uint8_t T2[] = {
+        0x33, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t P2[] = {
+        0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+        0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+        0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+        0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44
+};
+static const uint8_t C2[] = {
+        0xc4, 0x54, 0x18, 0x5e, 0x6a, 0x16, 0x93, 0x6e,
+        0x39, 0x33, 0x40, 0x38, 0xac, 0xef, 0x83, 0x8b,
+        0xfb, 0x18, 0x6f, 0xff, 0x74, 0x80, 0xad, 0xc4,
+        0x28, 0x93, 0x82, 0xec, 0xd6, 0xd3, 0x94, 0xf0
+};
+
+/*
+ * IEEE 1619-2007 XTS-AES-128 Vector 15 (ciphertext stealing)
+ */
+static const uint8_t K3[] = {
+        0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8,
+        0xf7, 0xf6, 0xf5, 0xf4, 0xf3, 0xf2, 0xf1, 0xf0,
+        0xbf, 0xbe, 0xbd, 0xbc, 0xbb, 0xba, 0xb9, 0xb8,
+        0xb7, 0xb6, 0xb5, 0xb4, 0xb3, 0xb2, 0xb1, 0xb0
+};
+static const uint8_t T3[] = {
+        0x9a, 0x78, 0x56, 0x34, 0x12, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t P3[] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10
+};
+static const uint8_t C3[] = {
+        0x6c, 0x16, 0x25, 0xdb, 0x46, 0x71, 0x52, 0x2d,
+        0x3d, 0x75, 0x99, 0x60, 0x1d, 0xe7, 0xca, 0x09,
+        0xed
+};
+
+/*
+ * XTS-AES-128, 512 byte data unit
+ */
+static const uint8_t K4[] = {
+        0x13, 0x1a, 0x21, 0x28, 0x2f, 0x36, 0x3d, 0x44,
+        0x4b, 0x52, 0x59, 0x60, 0x67, 0x6e, 0x75, 0x7c,
+        0x83, 0x8a, 0x91, 0x98, 0x9f, 0xa6, 0xad, 0xb4,
+        0xbb, 0xc2, 0xc9, 0xd0, 0xd7, 0xde, 0xe5, 0xec
+};
+static const uint8_t T4[] = {
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t P4[] = {
+        0x01, 0x36, 0x6b, 0xa0, 0xd5, 0x0a, 0x3f, 0x74,
+        0xa9, 0xde, 0x13, 0x48, 0x7d, 0xb2, 0xe7, 0x1c,
+        0x51, 0x86, 0xbb, 0xf0, 0x25, 0x5a, 0x8f, 0xc4,
+        0xf9, 0x2e, 0x63, 0x98, 0xcd, 0x02, 0x37, 0x6c,
+        0xa1, 0xd6, 0x0b, 0x40, 0x75, 0xaa, 0xdf, 0x14,
+        0x49, 0x7e, 0xb3, 0xe8, 0x1d, 0x52, 0x87, 0xbc,
+        0xf1, 0x26, 0x5b, 0x90, 0xc5, 0xfa, 0x2f, 0x64,
+        0x99, 0xce, 0x03, 0x38, 0x6d, 0xa2, 0xd7, 0x0c,
+        0x41, 0x76, 0xab, 0xe0, 0x15, 0x4a, 0x7f, 0xb4,
+        0xe9, 0x1e, 0x53, 0x88, 0xbd, 0xf2, 0x27, 0x5c,
+        0x91, 0xc6, 0xfb, 0x30, 0x65, 0x9a, 0xcf, 0x04,
+        0x39, 0x6e, 0xa3, 0xd8, 0x0d, 0x42, 0x77, 0xac,
+        0xe1, 0x16, 0x4b, 0x80, 0xb5, 0xea, 0x1f, 0x54,
+        0x89, 0xbe, 0xf3, 0x28, 0x5d, 0x92, 0xc7, 0xfc,
+        0x31, 0x66, 0x9b, 0xd0, 0x05, 0x3a, 0x6f, 0xa4,
+        0xd9, 0x0e, 0x43, 0x78, 0xad, 0xe2, 0x17, 0x4c,
+        0x81, 0xb6, 0xeb, 0x20, 0x55, 0x8a, 0xbf, 0xf4,
+        0x29, 0x5e, 0x93, 0xc8, 0xfd, 0x32, 0x67, 0x9c,
+        0xd1, 0x06, 0x3b, 0x70, 0xa5, 0xda, 0x0f, 0x44,
+        0x79, 0xae, 0xe3, 0x18, 0x4d, 0x82, 0xb7, 0xec,
+        0x21, 0x56, 0x8b, 0xc0, 0xf5, 0x2a, 0x5f, 0x94,
+        0xc9, 0xfe, 0x33, 0x68, 0x9d, 0xd2, 0x07, 0x3c,
+        0x71, 0xa6, 0xdb, 0x10, 0x45, 0x7a, 0xaf, 0xe4,
+        0x19, 0x4e, 0x83, 0xb8, 0xed, 0x22, 0x57, 0x8c,
+        0xc1, 0xf6, 0x2b, 0x60, 0x95, 0xca, 0xff, 0x34,
+        0x69, 0x9e, 0xd3, 0x08, 0x3d, 0x72, 0xa7, 0xdc,
+        0x11, 0x46, 0x7b, 0xb0, 0xe5, 0x1a, 0x4f, 0x84,
+        0xb9, 0xee, 0x23, 0x58, 0x8d, 0xc2, 0xf7, 0x2c,
+        0x61, 0x96, 0xcb, 0x00, 0x35, 0x6a, 0x9f, 0xd4,
+        0x09, 0x3e, 0x73, 0xa8, 0xdd, 0x12, 0x47, 0x7c,
+        0xb1, 0xe6, 0x1b, 0x50, 0x85, 0xba, 0xef, 0x24,
+        0x59, 0x8e, 0xc3, 0xf8, 0x2d, 0x62, 0x97, 0xcc,
+        0x01, 0x36, 0x6b, 0xa0, 0xd5, 0x0a, 0x3f, 0x74,
+        0xa9, 0xde, 0x13, 0x48, 0x7d, 0xb2, 0xe7, 0x1c,
+        0x51, 0x86, 0xbb, 0xf0, 0x25, 0x5a, 0x8f, 0xc4,
+        0xf9, 0x2e, 0x63, 0x98, 0xcd, 0x02, 0x37, 0x6c,
+        0xa1, 0xd6, 0x0b, 0x40, 0x75, 0xaa, 0xdf, 0x14,
+        0x49, 0x7e, 0xb3, 0xe8, 0x1d, 0x52, 0x87, 0xbc,
+        0xf1, 0x26, 0x5b, 0x90, 0xc5, 0xfa, 0x2f, 0x64,
+        0x99, 0xce, 0x03, 0x38, 0x6d, 0xa2, 0xd7, 0x0c,
+        0x41, 0x76, 0xab, 0xe0, 0x15, 0x4a, 0x7f, 0xb4,
+        0xe9, 0x1e, 0x53, 0x88, 0xbd, 0xf2, 0x27, 0x5c,
+        0x91, 0xc6, 0xfb, 0x30, 0x65, 0x9a, 0xcf, 0x04,
+        0x39, 0x6e, 0xa3, 0xd8, 0x0d, 0x42, 0x77, 0xac,
+        0xe1, 0x16, 0x4b, 0x80, 0xb5, 0xea, 0x1f, 0x54,
+        0x89, 0xbe, 0xf3, 0x28, 0x5d, 0x92, 0xc7, 0xfc,
+        0x31, 0x66, 0x9b, 0xd0, 0x05, 0x3a, 0x6f, 0xa4,
+        0xd9, 0x0e, 0x43, 0x78, 0xad, 0xe2, 0x17, 0x4c,
+        0x81, 0xb6, 0xeb, 0x20, 0x55, 0x8a, 0xbf, 0xf4,
+        0x29, 0x5e, 0x93, 0xc8, 0xfd, 0x32, 0x67, 0x9c,
+        0xd1, 0x06, 0x3b, 0x70, 0xa5, 0xda, 0x0f, 0x44,
+        0x79, 0xae, 0xe3, 0x18, 0x4d, 0x82, 0xb7, 0xec,
+        0x21, 0x56, 0x8b, 0xc0, 0xf5, 0x2a, 0x5f, 0x94,
+        0xc9, 0xfe, 0x33, 0x68, 0x9d, 0xd2, 0x07, 0x3c,
+        0x71, 0xa6, 0xdb, 0x10, 0x45, 0x7a, 0xaf, 0xe4,
+        0x19, 0x4e, 0x83, 0xb8, 0xed, 0x22, 0x57, 0x8c,
+        0xc1, 0xf6, 0x2b, 0x60, 0x95, 0xca, 0xff, 0x34,
+        0x69, 0x9e, 0xd3, 0x08, 0x3d, 0x72, 0xa7, 0xdc,
+        0x11, 0x46, 0x7b, 0xb0, 0xe5, 0x1a, 0x4f, 0x84,
+        0xb9, 0xee, 0x23, 0x58, 0x8d, 0xc2, 0xf7, 0x2c,
+        0x61, 0x96, 0xcb, 0x00, 0x35, 0x6a, 0x9f, 0xd4,
+        0x09, 0x3e, 0x73, 0xa8, 0xdd, 0x12, 0x47, 0x7c,
+        0xb1, 0xe6, 0x1b, 0x50, 0x85, 0xba, 0xef, 0x24,
+        0x59, 0x8e, 0xc3, 0xf8, 0x2d, 0x62, 0x97, 0xcc
+};
+static const uint8_t C4[] = {
+        0x57, 0x70, 0x66, 0x0a, 0xe3, 0x3f, 0x42, 0xda,
+        0xb9, 0x34, 0xbd, 0xa8, 0x8a, 0x1d, 0x36, 0x82,
+        0xea, 0x9f, 0x6e, 0x89, 0xfc, 0xab, 0xc4, 0x2b,
+        0xff, 0x35, 0xf4, 0x9f, 0x90, 0x73, 0x46, 0xc6,
+        0xac, 0xa9, 0x9e, 0x95, 0x13, 0x57, 0x2d, 0xee,
+        0x5e, 0x53, 0x25, 0xe7, 0xb3, 0x4c, 0xc1, 0x11,
+        0x3d, 0xd9, 0x4d, 0xfa, 0x4c, 0x06, 0xba, 0x4b,
+        0xcb, 0x97, 0xdc, 0xbf, 0x1b, 0x9e, 0x2e, 0x8d,
+        0x37, 0x8a, 0xad, 0x3a, 0x7d, 0x34, 0x75, 0xd8,
+        0xac, 0x6e, 0xdd, 0xa7, 0xed, 0x72, 0x03, 0x5c,
+        0x34, 0x2f, 0xf1, 0x5e, 0xd7, 0x45, 0xe9, 0x4b,
+        0xf1, 0xb9, 0x73, 0x58, 0xf8, 0xc0, 0x3a, 0x80,
+        0xdb, 0x4f, 0x84, 0x55, 0x72, 0xba, 0x37, 0x1f,
+        0xbf, 0xfd, 0x9c, 0x6b, 0xb6, 0x35, 0xd3, 0x4d,
+        0xa2, 0x67, 0x8e, 0x33, 0x46, 0xa4, 0x23, 0xff,
+        0x4b, 0x2f, 0x44, 0x2c, 0xc8, 0xdc, 0xd0, 0x1c,
+        0x04, 0x86, 0x19, 0x34, 0xd5, 0xa6, 0xb2, 0x8f,
+        0xc6, 0x48, 0xf9, 0x36, 0xc2, 0x7e, 0x85, 0xa5,
+        0xa1, 0xa0, 0xe8, 0x84, 0x99, 0xc8, 0xd2, 0x36,
+        0xae, 0x64, 0x9f, 0x2a, 0x54, 0x2c, 0xc3, 0x0f,
+        0xbf, 0xd4, 0x33, 0xbb, 0xd8, 0xf9, 0x01, 0xfa,
+        0x91, 0x85, 0x96, 0x41, 0xf9, 0x61, 0x6b, 0xde,
+        0x17, 0x6a, 0x3e, 0x45, 0xa9, 0x00, 0xe5, 0x85,
+        0x00, 0x9f, 0xda, 0xfa, 0xdf, 0xaa, 0xf3, 0xd3,
+        0x39, 0x56, 0x2f, 0x7c, 0xfe, 0xaa, 0xd6, 0xcd,
+        0x49, 0x7c, 0x98, 0x71, 0x65, 0x4d, 0xda, 0x06,
+        0xa6, 0x38, 0xcc, 0x2f, 0xec, 0xd7, 0xdc, 0xac,
+        0xcd, 0x63, 0x5b, 0x30, 0xba, 0x54, 0x70, 0x97,
+        0x43, 0x2c, 0xbd, 0xe9, 0x28, 0x4d, 0x6b, 0x94,
+        0xbd, 0x41, 0x96, 0x6e, 0x22, 0xf6, 0xfd, 0x99,
+        0x2c, 0x31, 0x13, 0x32, 0x6d, 0xc8, 0xb8, 0x93,
+        0x8e, 0x2b, 0x43, 0x3c, 0x7a, 0xea, 0xfe, 0xa9,
+        0x18, 0x2e, 0xea, 0x2b, 0x4f, 0x38, 0xe0, 0x9b,
+        0x12, 0xfc, 0x3b, 0x64, 0x82, 0xcd, 0x51, 0xee,
+        0x36, 0x5d, 0xdd, 0x51, 0x89, 0x46, 0x68, 0xd8,
+        0x6b, 0xbf, 0x30, 0x95, 0x9c, 0x63, 0xf1, 0x31,
+        0x27, 0xce, 0x5d, 0x6b, 0x2f, 0x62, 0x56, 0x3a,
+        0x5b, 0x6b, 0x49, 0x58, 0x77, 0xa3, 0x02, 0x59,
+        0xb1, 0x58, 0x70, 0x80, 0xcb, 0xe9, 0x72, 0x79,
+        0xc9, 0x10, 0x0c, 0x82, 0x33, 0x81, 0x7a, 0xe6,
+        0xc5, 0xae, 0x7c, 0x1e, 0xca, 0xd3, 0x21, 0x22,
+        0x8d, 0xed, 0x0c, 0xfa, 0xbf, 0x7c, 0xbb, 0xff,
+        0x4a, 0xb2, 0xa2, 0xca, 0xa0, 0x7a, 0x8c, 0x81,
+        0x4c, 0x75, 0x7c, 0xaf, 0x1f, 0x0e, 0x3a, 0xce,
+        0x60, 0x1c, 0x97, 0x45, 0x21, 0xc4, 0x15, 0x71,
+        0xb1, 0xa5, 0x9c, 0xe2, 0xf0, 0xfa, 0x39, 0x2c,
+        0x42, 0x13, 0x05, 0xc8, 0xe8, 0x5a, 0x59, 0x4c,
+        0x2c, 0xe6, 0xb4, 0xcf, 0xa3, 0x68, 0x5f, 0xda,
+        0x66, 0x4f, 0x2c, 0xd9, 0xa9, 0x00, 0xe7, 0x89,
+        0x2a, 0xca, 0x23, 0x12, 0x14, 0x15, 0x14, 0xf1,
+        0x83, 0x01, 0x3e, 0x65, 0x51, 0xed, 0x5d, 0xb1,
+        0x08, 0xdd, 0xb7, 0xc1, 0x40, 0x8f, 0xac, 0x9c,
+        0xb8, 0xd3, 0xdc, 0x99, 0xe1, 0x37, 0x07, 0x33,
+        0xa1, 0xa1, 0xfc, 0x18, 0xe2, 0x76, 0x89, 0x63,
+        0x55, 0x63, 0x58, 0x85, 0xf9, 0xce, 0xf7, 0xa2,
+        0x50, 0x58, 0xc5, 0x59, 0x82, 0x6a, 0x0b, 0xf4,
+        0x96, 0x4c, 0xdb, 0x73, 0xc5, 0x6f, 0x45, 0x3a,
+        0xb6, 0x6e, 0x28, 0x55, 0x46, 0x5c, 0x6f, 0xeb,
+        0xff, 0x99, 0xc1, 0xa4, 0x59, 0xa8, 0x19, 0x8a,
+        0x3c, 0x09, 0xe8, 0x98, 0x45, 0xea, 0x1f, 0x69,
+        0x2d, 0x27, 0x37, 0xbf, 0x0e, 0x8d, 0x73, 0xa2,
+        0x86, 0xd2, 0x08, 0x86, 0x0f, 0x16, 0x72, 0x82,
+        0x8e, 0x06, 0xc5, 0xd4, 0xc3, 0x04, 0xce, 0x3d,
+        0x49, 0xfc, 0x62, 0x5e, 0x8e, 0x09, 0x68, 0xfb
+};
+
+/*
+ * XTS-AES-256, 512 byte data unit (plain text P4)
+ */
+static const uint8_t K5[] = {
+        0x5a, 0x65, 0x70, 0x7b, 0x86, 0x91, 0x9c, 0xa7,
+        0xb2, 0xbd, 0xc8, 0xd3, 0xde, 0xe9, 0xf4, 0xff,
+        0x0a, 0x15, 0x20, 0x2b, 0x36, 0x41, 0x4c, 0x57,
+        0x62, 0x6d, 0x78, 0x83, 0x8e, 0x99, 0xa4, 0xaf,
+        0xba, 0xc5, 0xd0, 0xdb, 0xe6, 0xf1, 0xfc, 0x07,
+        0x12, 0x1d, 0x28, 0x33, 0x3e, 0x49, 0x54, 0x5f,
+        0x6a, 0x75, 0x80, 0x8b, 0x96, 0xa1, 0xac, 0xb7,
+        0xc2, 0xcd, 0xd8, 0xe3, 0xee, 0xf9, 0x04, 0x0f
+};
+static const uint8_t T5[] = {
+        0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t C5[] = {
+        0x47, 0x58, 0xca, 0x8c, 0x61, 0x01, 0xf1, 0xdc,
+        0x4f, 0xcf, 0x71, 0x48, 0x42, 0x8d, 0xcd, 0xc5,
+        0x2e, 0x54, 0x63, 0xae, 0x16, 0x57, 0x8f, 0x39,
+        0x71, 0x6c, 0xa6, 0x8c, 0x06, 0x83, 0xf3, 0x07,
+        0xb0, 0x57, 0x1e, 0x22, 0xb4, 0x5a, 0x26, 0x57,
+        0x38, 0x59, 0x8f, 0xbd, 0x02, 0x9e, 0x25, 0x3f,
+        0x76, 0x4b, 0xde, 0xb2, 0x56, 0x5b, 0xaa, 0x12,
+        0x9c, 0xe8, 0xca, 0x8a, 0xd2, 0x98, 0x74, 0x32,
+        0x4d, 0x07, 0x46, 0x6a, 0xfb, 0xd4, 0x15, 0x6d,
+        0xe1, 0x07, 0xdd, 0x77, 0x23, 0x86, 0xc4, 0xd1,
+        0x30, 0xb0, 0xd5, 0x7d, 0x4d, 0x98, 0x86, 0xf5,
+        0x66, 0x54, 0xb0, 0x5d, 0x1e, 0x8f, 0x5c, 0x74,
+        0xfc, 0x76, 0x58, 0xdb, 0x96, 0x7f, 0xe1, 0xc5,
+        0x11, 0xbc, 0xc0, 0x1d, 0x9b, 0xbe, 0x3f, 0x0c,
+        0xc9, 0x33, 0x21, 0x40, 0xd7, 0x9b, 0x8c, 0xce,
+        0x14, 0x15, 0x23, 0x67, 0x06, 0x7b, 0xf0, 0x97,
+        0x38, 0x40, 0x4c, 0xd5, 0x4b, 0x58, 0xa7, 0x1c,
+        0x6b, 0x76, 0x80, 0x45, 0xaa, 0xff, 0xba, 0x55,
+        0xc1, 0xbe, 0xc4, 0x7a, 0x9c, 0xec, 0x7f, 0x4b,
+        0x1a, 0x62, 0x9e, 0xda, 0x2c, 0x5f, 0x04, 0x67,
+        0x76, 0x4b, 0xe9, 0x92, 0xe0, 0x63, 0xef, 0xce,
+        0x74, 0x9e, 0x76, 0x7f, 0xae, 0xb1, 0xf9, 0x66,
+        0x0c, 0x4d, 0x29, 0x0b, 0xe5, 0xc0, 0x4d, 0xed,
+        0x92, 0x70, 0x40, 0x39, 0x10, 0xae, 0x5f, 0x76,
+        0x5e, 0x28, 0xc5, 0x18, 0xd5, 0x29, 0x59, 0xb5,
+        0x4f, 0xa3, 0x30, 0x19, 0x40, 0x53, 0xa9, 0xe9,
+        0x64, 0xa4, 0x93, 0xc2, 0x7f, 0xe4, 0xe8, 0x5d,
+        0x5b, 0xb1, 0x55, 0x24, 0xe5, 0xdb, 0xbb, 0x5b,
+        0x7a, 0x19, 0x33, 0x19, 0x2c, 0xe6, 0x31, 0x58,
+        0x4b, 0xd8, 0xd5, 0xdd, 0xb6, 0xe6, 0x1d, 0x15,
+        0x10, 0x90, 0x08, 0x6c, 0x8b, 0xb4, 0xec, 0x8a,
+        0xd4, 0x0a, 0x58, 0x33, 0xad, 0x78, 0x95, 0xf9,
+        0x37, 0x3e, 0x41, 0xfa, 0x4a, 0x5a, 0xdc, 0x15,
+        0xd9, 0x75, 0x7d, 0xde, 0x64, 0xc0, 0x82, 0x20,
+        0x32, 0xed, 0x10, 0x5a, 0x89, 0xea, 0xf6, 0x76,
+        0x6a, 0x29, 0x38, 0x61, 0x8d, 0x89, 0x7c, 0x4c,
+        0xaf, 0xf4, 0x05, 0x65, 0x05, 0x13, 0x14, 0x6f,
+        0x79, 0x58, 0xf3, 0x39, 0xeb, 0xb1, 0xf5, 0xdc,
+        0x73, 0x14, 0x73, 0x32, 0x9e, 0xa6, 0x26, 0x6d,
+        0x53, 0x9d, 0x8c, 0xa6, 0x19, 0xd5, 0xb2, 0xf7,
+        0x31, 0xa6, 0x35, 0x83, 0xdf, 0x19, 0xac, 0x5a,
+        0xb5, 0xa5, 0xc7, 0x93, 0x5d, 0x98, 0x67, 0x7d,
+        0xdc, 0x05, 0x1d, 0x00, 0xa2, 0x87, 0x3a, 0x7c,
+        0xce, 0x38, 0xb8, 0x22, 0xfc, 0xaf, 0x6d, 0xef,
+        0xad, 0x81, 0x41, 0x73, 0xd8, 0xcc, 0xcf, 0x50,
+        0x50, 0xda, 0x50, 0x26, 0xde, 0x08, 0x40, 0x10,
+        0x2f, 0x78, 0x15, 0xc4, 0x8c, 0xc1, 0xe6, 0xea,
+        0xca, 0x3b, 0xcf, 0x18, 0x8f, 0x0a, 0x4c, 0xc6,
+        0x8b, 0x13, 0xbd, 0x45, 0xda, 0x38, 0xbc, 0x6b,
+        0x94, 0x9b, 0x2d, 0xf6, 0x9c, 0xb6, 0x3b, 0x59,
+        0x55, 0xe1, 0xf5, 0x7f, 0xa5, 0xab, 0xf2, 0x29,
+        0xf8, 0xdc, 0x5f, 0x11, 0x3a, 0x8f, 0x17, 0x3a,
+        0x32, 0x4f, 0x1f, 0x1c, 0xeb, 0x81, 0xe5, 0x31,
+        0xe8, 0x63, 0x35, 0xf7, 0xc5, 0x73, 0xdf, 0xd9,
+        0x50, 0xbb, 0xf4, 0x11, 0x33, 0x68, 0x51, 0x3b,
+        0xd7, 0xf4, 0x7d, 0x6d, 0xd8, 0xc8, 0x1b, 0x40,
+        0x42, 0x34, 0xb5, 0x74, 0x63, 0x4d, 0x89, 0xc4,
+        0xc9, 0x23, 0xdf, 0x92, 0xa2, 0x43, 0x6e, 0xfb,
+        0x5f, 0x45, 0xdf, 0x58, 0x78, 0x45, 0xd0, 0xbb,
+        0xa3, 0xeb, 0x90, 0x1e, 0x7c, 0x07, 0x42, 0x7b,
+        0x32, 0x6b, 0xee, 0xda, 0x65, 0xd8, 0xca, 0x6e,
+        0x9a, 0x97, 0x1d, 0x44, 0x46, 0x0a, 0x5f, 0x3b,
+        0xe5, 0x9d, 0x98, 0x73, 0x55, 0x28, 0xca, 0x6b,
+        0x37, 0xd7, 0xa1, 0x69, 0x3f, 0x4f, 0xc4, 0xf5
+};
+
+/*
+ * XTS-AES-128, 255 byte data unit (K4, T4 and first 255 bytes of P4)
+ */
+static const uint8_t C6[] = {
+        0x57, 0x70, 0x66, 0x0a, 0xe3, 0x3f, 0x42, 0xda,
+        0xb9, 0x34, 0xbd, 0xa8, 0x8a, 0x1d, 0x36, 0x82,
+        0xea, 0x9f, 0x6e, 0x89, 0xfc, 0xab, 0xc4, 0x2b,
+        0xff, 0x35, 0xf4, 0x9f, 0x90, 0x73, 0x46, 0xc6,
+        0xac, 0xa9, 0x9e, 0x95, 0x13, 0x57, 0x2d, 0xee,
+        0x5e, 0x53, 0x25, 0xe7, 0xb3, 0x4c, 0xc1, 0x11,
+        0x3d, 0xd9, 0x4d, 0xfa, 0x4c, 0x06, 0xba, 0x4b,
+        0xcb, 0x97, 0xdc, 0xbf, 0x1b, 0x9e, 0x2e, 0x8d,
+        0x37, 0x8a, 0xad, 0x3a, 0x7d, 0x34, 0x75, 0xd8,
+        0xac, 0x6e, 0xdd, 0xa7, 0xed, 0x72, 0x03, 0x5c,
+        0x34, 0x2f, 0xf1, 0x5e, 0xd7, 0x45, 0xe9, 0x4b,
+        0xf1, 0xb9, 0x73, 0x58, 0xf8, 0xc0, 0x3a, 0x80,
+        0xdb, 0x4f, 0x84, 0x55, 0x72, 0xba, 0x37, 0x1f,
+        0xbf, 0xfd, 0x9c, 0x6b, 0xb6, 0x35, 0xd3, 0x4d,
+        0xa2, 0x67, 0x8e, 0x33, 0x46, 0xa4, 0x23, 0xff,
+        0x4b, 0x2f, 0x44, 0x2c, 0xc8, 0xdc, 0xd0, 0x1c,
+        0x04, 0x86, 0x19, 0x34, 0xd5, 0xa6, 0xb2, 0x8f,
+        0xc6, 0x48, 0xf9, 0x36, 0xc2, 0x7e, 0x85, 0xa5,
+        0xa1, 0xa0, 0xe8, 0x84, 0x99, 0xc8, 0xd2, 0x36,
+        0xae, 0x64, 0x9f, 0x2a, 0x54, 0x2c, 0xc3, 0x0f,
+        0xbf, 0xd4, 0x33, 0xbb, 0xd8, 0xf9, 0x01, 0xfa,
+        0x91, 0x85, 0x96, 0x41, 0xf9, 0x61, 0x6b, 0xde,
+        0x17, 0x6a, 0x3e, 0x45, 0xa9, 0x00, 0xe5, 0x85,
+        0x00, 0x9f, 0xda, 0xfa, 0xdf, 0xaa, 0xf3, 0xd3,
+        0x39, 0x56, 0x2f, 0x7c, 0xfe, 0xaa, 0xd6, 0xcd,
+        0x49, 0x7c, 0x98, 0x71, 0x65, 0x4d, 0xda, 0x06,
+        0xa6, 0x38, 0xcc, 0x2f, 0xec, 0xd7, 0xdc, 0xac,
+        0xcd, 0x63, 0x5b, 0x30, 0xba, 0x54, 0x70, 0x97,
+        0x01, 0x04, 0x2f, 0x99, 0x5c, 0x54, 0x3e, 0x5b,
+        0x4c, 0xda, 0x1c, 0xee, 0xc3, 0xe8, 0xc9, 0x5c,
+        0x43, 0x2c, 0xbd, 0xe9, 0x28, 0x4d, 0x6b, 0x94,
+        0xbd, 0x41, 0x96, 0x6e, 0x22, 0xf6, 0xfd
+};
+
+/*
+ * XTS-AES-256, 47 byte data unit (K5, T5 and first 47 bytes of P4)
+ */
+static const uint8_t C7[] = {
+        0x47, 0x58, 0xca, 0x8c, 0x61, 0x01, 0xf1, 0xdc,
+        0x4f, 0xcf, 0x71, 0x48, 0x42, 0x8d, 0xcd, 0xc5,
+        0xf2, 0x98, 0x7d, 0x66, 0x26, 0x47, 0xba, 0x55,
+        0x2d, 0xdd, 0x08, 0xd0, 0x92, 0x11, 0x17, 0xa9,
+        0x2e, 0x54, 0x63, 0xae, 0x16, 0x57, 0x8f, 0x39,
+        0x71, 0x6c, 0xa6, 0x8c, 0x06, 0x83, 0xf3
+};
+
+static const struct xts_vector xts_vectors[] = {
+        {K1, T1, P1, C1, 16, sizeof(P1)},
+        {K2, T2, P2, C2, 16, sizeof(P2)},
+        {K3, T3, P3, C3, 16, sizeof(P3)},
+        {K4, T4, P4, C4, 16, sizeof(C4)},
+        {K5, T5, P4, C5, 32, sizeof(C5)},
+        {K4, T4, P4, C6, 16, sizeof(C6)},
+        {K5, T5, P4, C7, 32, sizeof(C7)},
+};
+
+static int
+xts_job_ok(const struct IMB_JOB *job,
+           const uint8_t *out_text,
+           const uint8_t *target,
+           const uint8_t *padding,
+           const size_t sizeof_padding,
+           const unsigned text_len)
+{
+        const int num = (const int)((uint64_t)job->user_data2);
+
+        if (job->status != STS_COMPLETED) {
+                printf("%d error status:%d, job %d",
+                       __LINE__, job->status, num);
+                return 0;
+        }
+        if (memcmp(out_text, target + sizeof_padding,
+                   text_len)) {
+                printf("%d mismatched\n", num);
+                return 0;
+        }
+        if (memcmp(padding, target, sizeof_padding)) {
+                printf("%d overwrite head\n", num);
+                return 0;
+        }
+        if (memcmp(padding,
+                   target + sizeof_padding + text_len,
+                   sizeof_padding)) {
+                printf("%d overwrite tail\n", num);
+                return 0;
+        }
+        return 1;
+}
+
+static int
+test_xts_many(struct IMB_MGR *mb_mgr,
+              const void * const *enc_keys,
+              const void * const *dec_keys,
+              const void *iv,
+              const uint8_t *in_text,
+              const uint8_t *out_text,
+              unsigned text_len,
+              int dir,
+              int order,
+              const int in_place,
+              const int key_len,
+              const int num_jobs)
+{
+        struct IMB_JOB *job;
+        uint8_t padding[16];
+        uint8_t **targets = malloc(num_jobs * sizeof(void *));
+        int i, jobs_rx = 0, ret = -1;
+
+        assert(targets != NULL);
+
+        memset(padding, -1, sizeof(padding));
+
+        for (i = 0; i < num_jobs; i++) {
+                targets[i] = malloc(text_len + (sizeof(padding) * 2));
+                memset(targets[i], -1, text_len + (sizeof(padding) * 2));
+                if (in_place) {
+                        /* copy input text to the allocated buffer */
+                        memcpy(targets[i] + sizeof(padding), in_text, text_len);
+                }
+        }
+
+        /* flush the scheduler */
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < num_jobs; i++) {
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                job->cipher_direction = dir;
+                job->chain_order = order;
+                job->dst = targets[i] + sizeof(padding);
+                if (!in_place)
+                        job->src = in_text;
+                else
+                        job->src = targets[i] + sizeof(padding);
+                job->cipher_mode = IMB_CIPHER_XTS;
+                job->enc_keys = enc_keys;
+                job->dec_keys = dec_keys;
+                job->key_len_in_bytes = key_len;
+
+                job->iv = iv;
+                job->iv_len_in_bytes = 16;
+                job->cipher_start_src_offset_in_bytes = 0;
+                job->msg_len_to_cipher_in_bytes = text_len;
+                job->user_data = targets[i];
+                job->user_data2 = (void *)((uint64_t)i);
+
+                job->hash_alg = IMB_AUTH_NULL;
+
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                if (job != NULL) {
+                        jobs_rx++;
+                        if (!xts_job_ok(job, out_text, job->user_data, padding,
+                                        sizeof(padding), text_len))
+                                goto end;
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                jobs_rx++;
+                if (!xts_job_ok(job, out_text, job->user_data, padding,
+                                sizeof(padding), text_len))
+                        goto end;
+        }
+
+        if (jobs_rx != num_jobs) {
+                printf("Expected %d jobs, received %d\n", num_jobs, jobs_rx);
+                goto end;
+        }
+        ret = 0;
+
+ end:
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < num_jobs; i++)
+                free(targets[i]);
+        free(targets);
+        return ret;
+}
+
+static int
+test_xts_direct(struct IMB_MGR *mb_mgr,
+                const void *keys,
+                const void *tweak_keys,
+                const void *iv,
+                const uint8_t *in_text,
+                const uint8_t *out_text,
+                const unsigned text_len,
+                const int dir,
+                const int in_place,
+                const int key_len)
+{
+        uint8_t padding[16];
+        uint8_t *target = malloc(text_len + (sizeof(padding) * 2));
+        const uint8_t *src;
+        uint8_t *dst;
+        int ret = -1;
+
+        assert(target != NULL);
+
+        memset(padding, -1, sizeof(padding));
+        memset(target, -1, text_len + (sizeof(padding) * 2));
+
+        dst = target + sizeof(padding);
+        if (in_place) {
+                memcpy(dst, in_text, text_len);
+                src = dst;
+        } else {
+                src = in_text;
+        }
+
+        if (dir == IMB_DIR_ENCRYPT) {
+                if (key_len == 16)
+                        IMB_AES128_XTS_ENC(mb_mgr, src, iv, keys, tweak_keys,
+                                           dst, text_len);
+                else
+                        IMB_AES256_XTS_ENC(mb_mgr, src, iv, keys, tweak_keys,
+                                           dst, text_len);
+        } else {
+                if (key_len == 16)
+                        IMB_AES128_XTS_DEC(mb_mgr, src, iv, keys, tweak_keys,
+                                           dst, text_len);
+                else
+                        IMB_AES256_XTS_DEC(mb_mgr, src, iv, keys, tweak_keys,
+                                           dst, text_len);
+        }
+
+        if (memcmp(out_text, dst, text_len)) {
+                printf("mismatched\n");
+                goto end;
+        }
+        if (memcmp(padding, target, sizeof(padding))) {
+                printf("overwrite head\n");
+                goto end;
+        }
+        if (memcmp(padding, dst + text_len, sizeof(padding))) {
+                printf("overwrite tail\n");
+                goto end;
+        }
+        ret = 0;
+
+ end:
+        free(target);
+        return ret;
+}
+
+static int
+test_xts_vectors(struct IMB_MGR *mb_mgr, const int vec_cnt,
+                 const struct xts_vector *vec_tab, const char *banner,
+                 const int num_jobs)
+{
+	int vect, errors = 0;
+        DECLARE_ALIGNED(uint32_t enc_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t tweak_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t tmp_keys[15*4], 16);
+        const void *enc_ks[2] = { enc_keys, tweak_keys };
+        const void *dec_ks[2] = { dec_keys, tweak_keys };
+
+	printf("%s (N jobs = %d):\n", banner, num_jobs);
+	for (vect = 0; vect < vec_cnt; vect++) {
+                const unsigned klen = (unsigned) vec_tab[vect].Klen;
+                const unsigned plen = (unsigned) vec_tab[vect].Plen;
+                unsigned len;
+
+#ifdef DEBUG
+		printf("[%d/%d] Standard vector key_len:%d\n",
+                       vect + 1, vec_cnt, (int) klen);
+#else
+		printf(".");
+#endif
+                if (klen == 16) {
+                        IMB_AES_KEYEXP_128(mb_mgr, vec_tab[vect].K, enc_keys,
+                                           dec_keys);
+                        IMB_AES_KEYEXP_128(mb_mgr, vec_tab[vect].K + klen,
+                                           tweak_keys, tmp_keys);
+                } else {
+                        IMB_AES_KEYEXP_256(mb_mgr, vec_tab[vect].K, enc_keys,
+                                           dec_keys);
+                        IMB_AES_KEYEXP_256(mb_mgr, vec_tab[vect].K + klen,
+                                           tweak_keys, tmp_keys);
+                }
+
+                /*
+                 * Without ciphertext stealing, XTS blocks are independent,
+                 * so any full block prefix of the vector is a valid
+                 * vector too
+                 */
+                for (len = 16; len <= plen; len += 16) {
+                        if ((plen % 16) != 0 && (len + 16) > plen)
+                                len = plen;
+
+                        if (test_xts_many(mb_mgr, enc_ks, dec_ks,
+                                          vec_tab[vect].T,
+                                          vec_tab[vect].P, vec_tab[vect].C,
+                                          len, IMB_DIR_ENCRYPT,
+                                          IMB_ORDER_CIPHER_HASH, 0,
+                                          (int) klen, num_jobs)) {
+                                printf("error #%d encrypt, len %u\n",
+                                       vect + 1, len);
+                                errors++;
+                        }
+
+                        if (test_xts_many(mb_mgr, enc_ks, dec_ks,
+                                          vec_tab[vect].T,
+                                          vec_tab[vect].C, vec_tab[vect].P,
+                                          len, IMB_DIR_DECRYPT,
+                                          IMB_ORDER_HASH_CIPHER, 0,
+                                          (int) klen, num_jobs)) {
+                                printf("error #%d decrypt, len %u\n",
+                                       vect + 1, len);
+                                errors++;
+                        }
+
+                        if (test_xts_many(mb_mgr, enc_ks, dec_ks,
+                                          vec_tab[vect].T,
+                                          vec_tab[vect].P, vec_tab[vect].C,
+                                          len, IMB_DIR_ENCRYPT,
+                                          IMB_ORDER_CIPHER_HASH, 1,
+                                          (int) klen, num_jobs)) {
+                                printf("error #%d encrypt in-place, len %u\n",
+                                       vect + 1, len);
+                                errors++;
+                        }
+
+                        if (test_xts_many(mb_mgr, enc_ks, dec_ks,
+                                          vec_tab[vect].T,
+                                          vec_tab[vect].C, vec_tab[vect].P,
+                                          len, IMB_DIR_DECRYPT,
+                                          IMB_ORDER_HASH_CIPHER, 1,
+                                          (int) klen, num_jobs)) {
+                                printf("error #%d decrypt in-place, len %u\n",
+                                       vect + 1, len);
+                                errors++;
+                        }
+                }
+	}
+	printf("\n");
+	return errors;
+}
+
+static int
+test_xts_direct_vectors(struct IMB_MGR *mb_mgr, const int vec_cnt,
+                        const struct xts_vector *vec_tab, const char *banner)
+{
+	int vect, errors = 0;
+        DECLARE_ALIGNED(uint32_t enc_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t tweak_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t tmp_keys[15*4], 16);
+
+	printf("%s:\n", banner);
+	for (vect = 0; vect < vec_cnt; vect++) {
+                const int klen = (int) vec_tab[vect].Klen;
+                const unsigned len = (unsigned) vec_tab[vect].Plen;
+                int in_place;
+
+#ifdef DEBUG
+		printf("[%d/%d] Standard vector key_len:%d\n",
+                       vect + 1, vec_cnt, klen);
+#else
+		printf(".");
+#endif
+                if (klen == 16) {
+                        IMB_AES_KEYEXP_128(mb_mgr, vec_tab[vect].K, enc_keys,
+                                           dec_keys);
+                        IMB_AES_KEYEXP_128(mb_mgr, vec_tab[vect].K + klen,
+                                           tweak_keys, tmp_keys);
+                } else {
+                        IMB_AES_KEYEXP_256(mb_mgr, vec_tab[vect].K, enc_keys,
+                                           dec_keys);
+                        IMB_AES_KEYEXP_256(mb_mgr, vec_tab[vect].K + klen,
+                                           tweak_keys, tmp_keys);
+                }
+
+                for (in_place = 0; in_place <= 1; in_place++) {
+                        if (test_xts_direct(mb_mgr, enc_keys, tweak_keys,
+                                            vec_tab[vect].T, vec_tab[vect].P,
+                                            vec_tab[vect].C, len,
+                                            IMB_DIR_ENCRYPT, in_place, klen)) {
+                                printf("error #%d encrypt, in-place %d\n",
+                                       vect + 1, in_place);
+                                errors++;
+                        }
+                        if (test_xts_direct(mb_mgr, dec_keys, tweak_keys,
+                                            vec_tab[vect].T, vec_tab[vect].C,
+                                            vec_tab[vect].P, len,
+                                            IMB_DIR_DECRYPT, in_place, klen)) {
+                                printf("error #%d decrypt, in-place %d\n",
+                                       vect + 1, in_place);
+                                errors++;
+                        }
+                }
+	}
+	printf("\n");
+	return errors;
+}
+
+int
+xts_test(struct IMB_MGR *mb_mgr)
+{
+        const int num_jobs_tab[] = {
+                1, 3, 4, 5, 7, 8, 9, 15, 16, 17
+        };
+        unsigned i;
+        int errors = 0;
+
+        for (i = 0; i < DIM(num_jobs_tab); i++)
+                errors += test_xts_vectors(mb_mgr, DIM(xts_vectors),
+                                           xts_vectors,
+                                           "AES-XTS standard test vectors",
+                                           num_jobs_tab[i]);
+
+        errors += test_xts_direct_vectors(mb_mgr, DIM(xts_vectors),
+                                          xts_vectors,
+                                          "AES-XTS direct API test vectors");
+	if (0 == errors)
+		printf("...Pass\n");
+	else
+		printf("...Fail\n");
+
+	return errors;
+}
@@ -76,6 +76,10 @@ int validate_zuc_EIA_n_block(struct IMB_MGR *mb_mgr, uint8_t **pSrcData,
                              const unsigned int job_api);
 
 static void byte_hexdump(const char *message, const uint8_t *ptr, int len);
+static int
+validate_zuc_EEA_EIA_n_block(struct IMB_MGR *mb_mgr, uint8_t **pSrcData,
+                             uint8_t **pDstData, uint8_t **pKeys,
+                             uint8_t **pIV, uint32_t numBuffs);
 
 /******************************************************************************
  * @ingroup zuc_functionalTest_app
@@ -295,6 +299,15 @@ int zuc_test(struct IMB_MGR *mb_mgr)
                                "(job API): PASS\n", numBuffs[i]);
         }
 
+        for (i = 0; i < DIM(numBuffs); i++) {
+                if (validate_zuc_EEA_EIA_n_block(mb_mgr, pSrcData, pDstData,
+                                                 pKeys, pIV, numBuffs[i]))
+                        status = 1;
+                else
+                        printf("validate ZUC EEA+EIA N buffers (%u) "
+                               "(job API): PASS\n", numBuffs[i]);
+        }
+
         freePtrArray(pKeys, MAXBUFS);    /*Free the key buffers*/
         freePtrArray(pIV, MAXBUFS);      /*Free the vector buffers*/
         freePtrArray(pSrcData, MAXBUFS); /*Free the source buffers*/
@@ -817,6 +830,234 @@ int validate_zuc_EIA_n_block(struct IMB_MGR *mb_mgr, uint8_t **pSrcData,
         return ret;
 };
 
+static inline int
+submit_eea3_eia3_jobs(struct IMB_MGR *mb_mgr, uint8_t **keys,
+                      uint8_t **auth_keys, uint8_t **ivs, uint8_t **auth_ivs,
+                      uint8_t **src, uint8_t **dst, uint32_t *tags,
+                      const uint32_t *bitlens, const uint32_t cipher_offset,
+                      const JOB_CHAIN_ORDER order,
+                      const unsigned int num_jobs)
+{
+        IMB_JOB *job;
+        unsigned int i;
+        unsigned int jobs_rx = 0;
+
+        for (i = 0; i < num_jobs; i++) {
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                job->cipher_direction = IMB_DIR_ENCRYPT;
+                job->chain_order = order;
+                job->cipher_mode = IMB_CIPHER_ZUC_EEA3;
+                job->src = src[i];
+                job->dst = dst[i];
+                job->iv = ivs[i];
+                job->iv_len_in_bytes = 16;
+                job->enc_keys = keys[i];
+                job->key_len_in_bytes = 16;
+
+                job->cipher_start_src_offset_in_bytes = cipher_offset;
+                job->msg_len_to_cipher_in_bytes = (bitlens[i] + 7) / 8;
+
+                /* Authentication covers the header and the message */
+                job->hash_alg = IMB_AUTH_ZUC_EIA3_BITLEN;
+                job->u.ZUC_EIA3._iv = auth_ivs[i];
+                job->u.ZUC_EIA3._key = auth_keys[i];
+                job->hash_start_src_offset_in_bytes = 0;
+                job->msg_len_to_hash_in_bits = cipher_offset * 8 + bitlens[i];
+                job->auth_tag_output = (uint8_t *) &tags[i];
+                job->auth_tag_output_len_in_bytes = 4;
+
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                if (job != NULL) {
+                        jobs_rx++;
+                        if (job->status != STS_COMPLETED) {
+                                printf("%d error status:%d, job %d",
+                                       __LINE__, job->status, i);
+                                return -1;
+                        }
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                jobs_rx++;
+                if (job->status != STS_COMPLETED) {
+                        printf("%d error status:%d, job %d",
+                               __LINE__, job->status, i);
+                        return -1;
+                }
+        }
+
+        if (jobs_rx != num_jobs) {
+                printf("Expected %d jobs, received %d\n", num_jobs, jobs_rx);
+                return -1;
+        }
+
+        return 0;
+}
+
+/* Header authenticated but not ciphered, in front of the message */
+#define ZUC_EEA_EIA_MAX_HDR 100
+
+static const struct {
+        const char *name;
+        JOB_CHAIN_ORDER order;
+        int in_place;
+        uint32_t hdr_len;
+} zuc_eea_eia_layouts[] = {
+        {"hash-cipher out-of-place", IMB_ORDER_HASH_CIPHER, 0, 0},
+        {"hash-cipher out-of-place", IMB_ORDER_HASH_CIPHER, 0, 3},
+        {"hash-cipher out-of-place", IMB_ORDER_HASH_CIPHER, 0, 100},
+        {"hash-cipher in-place", IMB_ORDER_HASH_CIPHER, 1, 0},
+        {"hash-cipher in-place", IMB_ORDER_HASH_CIPHER, 1, 1},
+        {"hash-cipher in-place", IMB_ORDER_HASH_CIPHER, 1, 3},
+        {"hash-cipher in-place", IMB_ORDER_HASH_CIPHER, 1, 17},
+        {"hash-cipher in-place", IMB_ORDER_HASH_CIPHER, 1, 64},
+        {"hash-cipher in-place", IMB_ORDER_HASH_CIPHER, 1, 65},
+        {"cipher-hash out-of-place", IMB_ORDER_CIPHER_HASH, 0, 17},
+        {"cipher-hash in-place", IMB_ORDER_CIPHER_HASH, 1, 0},
+        {"cipher-hash in-place", IMB_ORDER_CIPHER_HASH, 1, 17},
+        {"cipher-hash in-place", IMB_ORDER_CIPHER_HASH, 1, 100},
+};
+
+/*
+ * Cipher and authenticate N buffers in one job (EEA3 + EIA3 chained)
+ * and check the result against the separate EEA3 and EIA3 N buffer APIs.
+ * Authentication starts at the beginning of a header, cipher after it,
+ * and each buffer uses different keys for EEA3 and EIA3.
+ * Hash-then-cipher and out-of-place jobs authenticate the plaintext,
+ * while in-place cipher-then-hash jobs authenticate the ciphertext.
+ */
+static int
+validate_zuc_EEA_EIA_n_block(struct IMB_MGR *mb_mgr, uint8_t **pSrcData,
+                             uint8_t **pDstData, uint8_t **pKeys,
+                             uint8_t **pIV, uint32_t numBuffs)
+{
+        uint32_t i, j, k;
+        int ret = 0;
+        uint32_t byteLength[MAXBUFS];
+        uint32_t bitLength[MAXBUFS];
+        uint32_t hashBitLength[MAXBUFS];
+        uint32_t tags[MAXBUFS];
+        uint32_t ref_tags[MAXBUFS];
+        uint32_t *pRefTags[MAXBUFS];
+        uint8_t *pRefData[MAXBUFS];
+        uint8_t *pRefHashData[MAXBUFS];
+        uint8_t *pHdrData[MAXBUFS];
+        uint8_t *pJobSrc[MAXBUFS];
+        uint8_t *pJobDst[MAXBUFS];
+        uint8_t authKeys[MAXBUFS][ZUC_KEY_LEN_IN_BYTES];
+        uint8_t *pAuthKeys[MAXBUFS];
+        uint8_t authIV[MAXBUFS][ZUC_IV_LEN_IN_BYTES];
+        uint8_t *pAuthIV[MAXBUFS];
+        struct test128EIA3_vectors_t vector;
+
+        assert(numBuffs > 0 && numBuffs <= MAXBUFS);
+
+        if (createData(pRefData, numBuffs)) {
+                printf("createData() error\n");
+                return -1;
+        }
+
+        for (i = 0; i < numBuffs; i++) {
+                pHdrData[i] = malloc(MAX_BUFFER_LENGTH_IN_BYTES +
+                                     ZUC_EEA_EIA_MAX_HDR);
+                pRefHashData[i] = malloc(MAX_BUFFER_LENGTH_IN_BYTES +
+                                         ZUC_EEA_EIA_MAX_HDR);
+                if (pHdrData[i] == NULL || pRefHashData[i] == NULL) {
+                        printf("malloc() error\n");
+                        free(pHdrData[i]);
+                        free(pRefHashData[i]);
+                        freePtrArray(pHdrData, i);
+                        freePtrArray(pRefHashData, i);
+                        freePtrArray(pRefData, numBuffs);
+                        return -1;
+                }
+        }
+
+        for (i = 0; i < numBuffs; i++) {
+                vector = testEIA3_vectors[i % NUM_ZUC_EIA3_TESTS];
+                memcpy(pKeys[i], vector.CK, ZUC_KEY_LEN_IN_BYTES);
+                /* Authenticate with the key of the next vector */
+                memcpy(authKeys[i],
+                       testEIA3_vectors[(i + 1) % NUM_ZUC_EIA3_TESTS].CK,
+                       ZUC_KEY_LEN_IN_BYTES);
+                pAuthKeys[i] = authKeys[i];
+                zuc_eea3_iv_gen(vector.count, vector.Bearer,
+                                vector.Direction, pIV[i]);
+                zuc_eia3_iv_gen(vector.count, vector.Bearer,
+                                vector.Direction, authIV[i]);
+                pAuthIV[i] = authIV[i];
+                pRefTags[i] = &ref_tags[i];
+                bitLength[i] = vector.length_in_bits;
+                byteLength[i] = (bitLength[i] + 7) / 8;
+                memcpy(pSrcData[i], vector.message, byteLength[i]);
+        }
+
+        /* Reference ciphertext */
+        IMB_ZUC_EEA3_N_BUFFER(mb_mgr, (const void * const *)pKeys,
+                              (const void * const *)pIV,
+                              (const void * const *)pSrcData,
+                              (void **)pRefData, byteLength, numBuffs);
+
+        for (j = 0; j < DIM(zuc_eea_eia_layouts) && ret == 0; j++) {
+                const uint32_t hdr = zuc_eea_eia_layouts[j].hdr_len;
+                const JOB_CHAIN_ORDER order = zuc_eea_eia_layouts[j].order;
+                const int in_place = zuc_eea_eia_layouts[j].in_place;
+                const int auth_cipher_text =
+                        in_place && order == IMB_ORDER_CIPHER_HASH;
+
+                for (i = 0; i < numBuffs; i++) {
+                        /* Header followed by the plaintext */
+                        for (k = 0; k < hdr; k++)
+                                pHdrData[i][k] = (uint8_t) (i + k * 7);
+                        memcpy(&pHdrData[i][hdr], pSrcData[i], byteLength[i]);
+
+                        /* Reference data to authenticate */
+                        memcpy(pRefHashData[i], pHdrData[i], hdr);
+                        memcpy(&pRefHashData[i][hdr],
+                               auth_cipher_text ? pRefData[i] : pSrcData[i],
+                               byteLength[i]);
+                        hashBitLength[i] = hdr * 8 + bitLength[i];
+
+                        pJobSrc[i] = pHdrData[i];
+                        pJobDst[i] = in_place ? &pHdrData[i][hdr] :
+                                                pDstData[i];
+                }
+
+                IMB_ZUC_EIA3_N_BUFFER(mb_mgr, (const void * const *)pAuthKeys,
+                                      (const void * const *)pAuthIV,
+                                      (const void * const *)pRefHashData,
+                                      hashBitLength, pRefTags, numBuffs);
+
+                if (submit_eea3_eia3_jobs(mb_mgr, pKeys, pAuthKeys, pIV,
+                                          pAuthIV, pJobSrc, pJobDst, tags,
+                                          bitLength, hdr, order, numBuffs))
+                        ret = -1;
+
+                for (i = 0; i < numBuffs && ret == 0; i++) {
+                        if (test_output(pJobDst[i], pRefData[i],
+                                        byteLength[i], byteLength[i] * 8,
+                                        "Validate ZUC EEA+EIA (Enc)"))
+                                ret = -1;
+                        if (tags[i] != ref_tags[i]) {
+                                printf("Validate ZUC EEA+EIA %s test, "
+                                       "header %u, index %u (Int): FAIL\n",
+                                       zuc_eea_eia_layouts[j].name, hdr, i);
+                                byte_hexdump("Expected",
+                                             (uint8_t *) &ref_tags[i],
+                                             ZUC_DIGEST_LEN);
+                                byte_hexdump("Found", (uint8_t *) &tags[i],
+                                             ZUC_DIGEST_LEN);
+                                ret = -1;
+                        }
+                }
+        }
+
+        freePtrArray(pHdrData, numBuffs);
+        freePtrArray(pRefHashData, numBuffs);
+        freePtrArray(pRefData, numBuffs);
+        return ret;
+}
+
 int validate_zuc_algorithm(struct IMB_MGR *mb_mgr, uint8_t *pSrcData,
                            uint8_t *pDstData, uint8_t *pKeys, uint8_t *pIV)
 {